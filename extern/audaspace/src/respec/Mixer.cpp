@@ -92,16 +92,30 @@ void Mixer::mix(sample_t* buffer, int start, int length, float volume)
 
 void Mixer::mix(sample_t* buffer, int start, int length, float volume_to, float volume_from)
 {
-	sample_t* out = m_buffer.getBuffer();
+	// most sounds don't change their volume, they are mixed with the faster loop above
+	if(volume_to == volume_from)
+	{
+		mix(buffer, start, length, volume_to);
+		return;
+	}
+
+	const int channels = m_specs.channels;
+	sample_t* out = m_buffer.getBuffer() + start * channels;
 
 	length = (std::min(m_length, length + start) - start);
 
+	// avoid the divisions per sample, the interpolation is the same up to rounding
+	const float volume_step = (volume_to - volume_from) / float(length);
+
 	for(int i = 0; i < length; i++)
 	{
-		float volume = volume_from * (1.0f - i / float(length)) + volume_to * (i / float(length));
+		const float volume = volume_from + volume_step * i;
+
+		sample_t* out_sample = out + i * channels;
+		const sample_t* in_sample = buffer + i * channels;
 
-		for(int c = 0; c < m_specs.channels; c++)
-			out[(i + start) * m_specs.channels + c] += buffer[i * m_specs.channels + c] * volume;
+		for(int c = 0; c < channels; c++)
+			out_sample[c] += in_sample[c] * volume;
 	}
 }
 
@@ -109,8 +123,11 @@ void Mixer::read(data_t* buffer, float volume)
 {
 	sample_t* out = m_buffer.getBuffer();
 
-	for(int i = 0; i < m_length * m_specs.channels; i++)
-		out[i] *= volume;
+	if(volume != 1.0f)
+	{
+		for(int i = 0; i < m_length * m_specs.channels; i++)
+			out[i] *= volume;
+	}
 
 	m_convert(buffer, (data_t*) out, m_length * m_specs.channels);
 }
@@ -33,6 +33,7 @@
 #  include "openvdb/points/PointCount.h"
 #  include "openvdb/tools/Clip.h"
 #  include "openvdb/tools/Dense.h"
+#  include "openvdb/tree/LeafManager.h"
 #endif
 
 #define POSITION_NAME "P"
@@ -53,15 +54,46 @@ template<class GridType, class T> void importVDB(typename GridType::Ptr from, Gr
 {
   using ValueT = typename GridType::ValueType;
 
+  using TreeT = typename GridType::TreeType;
+
   // Check if current grid is to be read as a sparse grid, active voxels (only) will be copied
   if (to->saveSparse()) {
     to->clear();  // Ensure that destination grid is empty before writing
-    for (typename GridType::ValueOnCIter iter = from->cbeginValueOn(); iter.test(); ++iter) {
-      ValueT vdbValue = *iter;
-      openvdb::Coord coord = iter.getCoord();
+
+    // Leaf nodes never share voxels, so they can be copied in parallel
+    openvdb::tree::LeafManager<const TreeT> leafManager(from->tree());
+    leafManager.foreach([&](const typename TreeT::LeafNodeType &leaf, size_t /*idx*/) {
+      for (typename TreeT::LeafNodeType::ValueOnCIter iter = leaf.cbeginValueOn(); iter; ++iter) {
+        ValueT vdbValue = *iter;
+        openvdb::Coord coord = iter.getCoord();
+        T toMantaValue;
+        convertFrom(vdbValue, &toMantaValue);
+        to->set(coord.x(), coord.y(), coord.z(), toMantaValue);
+      }
+    });
+
+    // Active tiles above the leaf level hold one value for a whole block of voxels
+    const openvdb::CoordBBox gridBBox(
+        openvdb::Coord(0),
+        openvdb::Coord(to->getSizeX() - 1, to->getSizeY() - 1, to->getSizeZ() - 1));
+    typename GridType::ValueOnCIter tileIter = from->cbeginValueOn();
+    tileIter.setMaxDepth(GridType::ValueOnCIter::LEAF_DEPTH - 1);
+    for (; tileIter.test(); ++tileIter) {
+      openvdb::CoordBBox tileBBox;
+      tileIter.getBoundingBox(tileBBox);
+      tileBBox.intersect(gridBBox);
+      if (tileBBox.empty()) {
+        continue;
+      }
       T toMantaValue;
-      convertFrom(vdbValue, &toMantaValue);
-      to->set(coord.x(), coord.y(), coord.z(), toMantaValue);
+      convertFrom(*tileIter, &toMantaValue);
+      for (int k = tileBBox.min().z(); k <= tileBBox.max().z(); ++k) {
+        for (int j = tileBBox.min().y(); j <= tileBBox.max().y(); ++j) {
+          for (int i = tileBBox.min().x(); i <= tileBBox.max().x(); ++i) {
+            to->set(i, j, k, toMantaValue);
+          }
+        }
+      }
     }
   }
   // When importing all grid cells, using a grid accessor is usually faster than a value iterator
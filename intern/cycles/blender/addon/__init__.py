@@ -48,6 +48,7 @@ class CyclesRender(bpy.types.RenderEngine):
     bl_use_spherical_stereo = True
     bl_use_custom_freestyle = True
     bl_use_alembic_procedural = True
+    bl_use_shared_scene_data = True
 
     def __init__(self):
         self.session = None
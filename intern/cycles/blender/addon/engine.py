@@ -13,6 +13,9 @@ def _configure_argument_parser():
     parser.add_argument("--cycles-print-stats",
                         help="Print rendering statistics to stderr",
                         action='store_true')
+    parser.add_argument("--cycles-kernel-stats-json",
+                        help="Write statistics of GPU kernels to the given file in JSON format",
+                        default=None)
     parser.add_argument("--cycles-device",
                         help="Set the device to use for Cycles, overriding user preferences and the scene setting."
                              "Valid options are 'CPU', 'CUDA', 'OPTIX', 'HIP' or 'METAL'."
@@ -35,6 +38,10 @@ def _parse_command_line():
         import _cycles
         _cycles.enable_print_stats()
 
+    if args.cycles_kernel_stats_json:
+        import _cycles
+        _cycles.set_kernel_stats_filepath(args.cycles_kernel_stats_json)
+
     if args.cycles_device:
         import _cycles
         _cycles.set_device_override(args.cycles_device)
@@ -52,6 +52,7 @@ class AddPresetSampling(AddPresetBase, Operator):
         "cycles.adaptive_threshold",
         "cycles.adaptive_min_samples",
         "cycles.time_limit",
+        "cycles.use_time_budget",
         "cycles.use_denoising",
         "cycles.denoiser",
         "cycles.denoising_input_passes",
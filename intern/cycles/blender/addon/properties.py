@@ -337,6 +337,13 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         step=100.0,
         unit='TIME_ABSOLUTE',
     )
+    use_time_budget: BoolProperty(
+        name="Time Budget",
+        description="Use the time limit as a budget for the whole frame, including denoising. "
+        "With adaptive sampling the noise threshold is lowered progressively, so that the image has "
+        "a uniform noise level when the budget is used up",
+        default=False,
+    )
 
     sampling_pattern: EnumProperty(
         name="Sampling Pattern",
@@ -378,6 +385,13 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         default=0.01,
     )
 
+    use_light_tree: BoolProperty(
+        name="Light Tree",
+        description="Choose lights based on their estimated contribution to the shading point, using a hierarchy over all lights. "
+        "Reduces noise in scenes with many lights",
+        default=False,
+    )
+
     use_adaptive_sampling: BoolProperty(
         name="Use Adaptive Sampling",
         description="Automatically reduce the number of samples per pixel based on estimated noise level",
@@ -658,6 +672,17 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         description="Use compact BVH structure (uses less ram but renders slower)",
         default=True,
     )
+    debug_use_compressed_bvh: BoolProperty(
+        name="Use Compressed BVH",
+        description="Quantize BVH node bounds when not using Embree, OptiX or Metal (uses less ram but renders slower)",
+        default=False,
+    )
+    debug_use_ray_sorting: BoolProperty(
+        name="Use Ray Sorting",
+        description="Sort rays by origin and direction before intersecting them on the GPU, "
+        "improving coherence of BVH traversal for incoherent bounces",
+        default=False,
+    )
     debug_bvh_time_steps: IntProperty(
         name="BVH Time Steps",
         description="Split BVH primitives by this number of time steps to speed up render time in cost of memory",
@@ -233,6 +233,9 @@ class CYCLES_RENDER_PT_sampling_render(CyclesButtonsPanel, Panel):
         else:
             col.prop(cscene, "samples", text="Samples")
         col.prop(cscene, "time_limit")
+        sub = col.column()
+        sub.active = cscene.time_limit != 0.0
+        sub.prop(cscene, "use_time_budget")
 
 
 class CYCLES_RENDER_PT_sampling_render_denoise(CyclesButtonsPanel, Panel):
@@ -299,6 +302,7 @@ class CYCLES_RENDER_PT_sampling_advanced(CyclesButtonsPanel, Panel):
         col.prop(cscene, "min_light_bounces")
         col.prop(cscene, "min_transparent_bounces")
         col.prop(cscene, "light_sampling_threshold", text="Light Threshold")
+        col.prop(cscene, "use_light_tree")
 
         for view_layer in scene.view_layers:
             if view_layer.samples > 0:
@@ -687,6 +691,7 @@ class CYCLES_RENDER_PT_performance_acceleration_structure(CyclesButtonsPanel, Pa
                 sub.prop(cscene, "debug_bvh_time_steps")
 
                 col.prop(cscene, "debug_use_hair_bvh")
+                col.prop(cscene, "debug_use_compressed_bvh")
 
                 sub = col.column(align=True)
                 sub.label(text="Cycles built without Embree support")
@@ -698,6 +703,8 @@ class CYCLES_RENDER_PT_performance_acceleration_structure(CyclesButtonsPanel, Pa
             sub.prop(cscene, "debug_bvh_time_steps")
 
             col.prop(cscene, "debug_use_hair_bvh")
+            col.prop(cscene, "debug_use_compressed_bvh")
+            col.prop(cscene, "debug_use_ray_sorting")
 
             # CPU is used in addition to a GPU
             if use_multi_device(context) and use_embree:
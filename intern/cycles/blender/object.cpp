@@ -21,6 +21,7 @@
 #include "util/hash.h"
 #include "util/log.h"
 #include "util/task.h"
+#include "util/time.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -232,9 +233,12 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
     return NULL;
   }
 
-  /* Use task pool only for non-instances, since sync_dupli_particle accesses
-   * geometry. This restriction should be removed for better performance. */
-  TaskPool *object_geom_task_pool = (is_instance) ? NULL : geom_task_pool;
+  /* Use task pool except for particle instances, since sync_dupli_particle accesses geometry.
+   * The deferred sync only uses the real object and the object data, which stay valid after
+   * the depsgraph iterator moved on. */
+  TaskPool *object_geom_task_pool = (is_instance && b_instance.particle_system()) ?
+                                        NULL :
+                                        geom_task_pool;
 
   /* key to lookup object */
   ObjectKey key(b_parent, persistent_id, b_ob_info.real_object, use_particle_hair);
@@ -594,6 +598,8 @@ void BlenderSync::sync_objects(BL::Depsgraph &b_depsgraph,
   BL::ViewLayer b_view_layer = b_depsgraph.view_layer_eval();
   BL::Depsgraph::object_instances_iterator b_instance_iter;
 
+  scoped_timer timer;
+
   for (b_depsgraph.object_instances.begin(b_instance_iter);
        b_instance_iter != b_depsgraph.object_instances.end() && !cancel;
        ++b_instance_iter) {
@@ -667,7 +673,11 @@ void BlenderSync::sync_objects(BL::Depsgraph &b_depsgraph,
     cancel = progress.get_cancel();
   }
 
+  VLOG(1) << "Time spent iterating objects: " << timer.get_time();
+
+  scoped_timer wait_timer;
   geom_task_pool.wait_work();
+  VLOG(1) << "Time spent waiting for geometry synchronization: " << wait_timer.get_time();
 
   progress.set_sync_status("");
 
@@ -868,6 +868,15 @@ static PyObject *enable_print_stats_func(PyObject * /*self*/, PyObject * /*args*
   Py_RETURN_NONE;
 }
 
+static PyObject *set_kernel_stats_filepath_func(PyObject * /*self*/, PyObject *arg)
+{
+  PyObject *filepath_string = PyObject_Str(arg);
+  BlenderSession::kernel_stats_filepath = PyUnicode_AsUTF8(filepath_string);
+  Py_DECREF(filepath_string);
+
+  Py_RETURN_NONE;
+}
+
 static PyObject *get_device_types_func(PyObject * /*self*/, PyObject * /*args*/)
 {
   vector<DeviceType> device_types = Device::available_types();
@@ -956,6 +965,7 @@ static PyMethodDef methods[] = {
 
     /* Statistics. */
     {"enable_print_stats", enable_print_stats_func, METH_NOARGS, ""},
+    {"set_kernel_stats_filepath", set_kernel_stats_filepath_func, METH_O, ""},
 
     /* Compute Device selection */
     {"get_device_types", get_device_types_func, METH_VARARGS, ""},
@@ -40,6 +40,7 @@ CCL_NAMESPACE_BEGIN
 DeviceTypeMask BlenderSession::device_override = DEVICE_MASK_ALL;
 bool BlenderSession::headless = false;
 bool BlenderSession::print_render_stats = false;
+string BlenderSession::kernel_stats_filepath;
 
 BlenderSession::BlenderSession(BL::RenderEngine &b_engine,
                                BL::Preferences &b_userpref,
@@ -157,6 +158,12 @@ void BlenderSession::create_session()
 
 void BlenderSession::reset_session(BL::BlendData &b_data, BL::Depsgraph &b_depsgraph)
 {
+  /* Blender keeps the depsgraph alive between view layers of the same frame (the engine uses
+   * shared scene data), in which case the Cycles scene is still valid and is only updated for
+   * what differs between the view layers. */
+  const bool is_shared_depsgraph = (sync != nullptr) &&
+                                   (b_depsgraph.ptr.data == this->b_depsgraph.ptr.data);
+
   /* Update data, scene and depsgraph pointers. These can change after undo. */
   this->b_data = b_data;
   this->b_depsgraph = b_depsgraph;
@@ -199,7 +206,7 @@ void BlenderSession::reset_session(BL::BlendData &b_data, BL::Depsgraph &b_depsg
   const SceneParams scene_params = BlenderSync::get_scene_params(b_scene, background);
 
   if (scene->params.modified(scene_params) || session->params.modified(session_params) ||
-      !this->b_render.use_persistent_data()) {
+      !(this->b_render.use_persistent_data() || is_shared_depsgraph)) {
     /* if scene or session parameters changed, it's easier to simply re-create
      * them rather than trying to distinguish which settings need to be updated
      */
@@ -435,10 +442,21 @@ void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
     session->start();
     session->wait();
 
-    if (!b_engine.is_preview() && background && print_render_stats) {
+    if (!b_engine.is_preview() && background &&
+        (print_render_stats || !kernel_stats_filepath.empty())) {
       RenderStats stats;
       session->collect_statistics(&stats);
-      printf("Render statistics:\n%s\n", stats.full_report().c_str());
+      if (print_render_stats) {
+        printf("Render statistics:\n%s\n", stats.full_report().c_str());
+      }
+      if (!kernel_stats_filepath.empty()) {
+        string json = stats.device_kernels.json_report();
+        if (!path_write_text(kernel_stats_filepath, json)) {
+          fprintf(stderr,
+                  "Failed to write kernel statistics to %s\n",
+                  kernel_stats_filepath.c_str());
+        }
+      }
     }
 
     if (session->progress.get_cancel())
@@ -119,6 +119,9 @@ class BlenderSession {
 
   static bool print_render_stats;
 
+  /* File to write statistics of GPU kernels to in JSON format, after every final render. */
+  static string kernel_stats_filepath;
+
  protected:
   void stamp_view_layer_metadata(Scene *scene, const string &view_layer_name);
 
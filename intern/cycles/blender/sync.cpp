@@ -266,16 +266,26 @@ void BlenderSync::sync_data(BL::RenderSettings &b_render,
   sync_view_layer(b_view_layer);
   sync_integrator(b_view_layer, background);
   sync_film(b_view_layer, b_v3d);
-  sync_shaders(b_depsgraph, b_v3d, auto_refresh_update);
-  sync_images();
+  {
+    scoped_timer stage_timer;
+    sync_shaders(b_depsgraph, b_v3d, auto_refresh_update);
+    sync_images();
+    VLOG(1) << "Time spent synchronizing shaders and images: " << stage_timer.get_time();
+  }
 
   geometry_synced.clear(); /* use for objects and motion sync */
 
   if (scene->need_motion() == Scene::MOTION_PASS || scene->need_motion() == Scene::MOTION_NONE ||
       scene->camera->get_motion_position() == Camera::MOTION_POSITION_CENTER) {
+    scoped_timer stage_timer;
     sync_objects(b_depsgraph, b_v3d);
+    VLOG(1) << "Time spent synchronizing objects: " << stage_timer.get_time();
+  }
+  {
+    scoped_timer stage_timer;
+    sync_motion(b_render, b_depsgraph, b_v3d, b_override, width, height, python_thread_state);
+    VLOG(1) << "Time spent synchronizing motion: " << stage_timer.get_time();
   }
-  sync_motion(b_render, b_depsgraph, b_v3d, b_override, width, height, python_thread_state);
 
   geometry_synced.clear();
 
@@ -341,11 +351,14 @@ void BlenderSync::sync_integrator(BL::ViewLayer &b_view_layer, bool background)
   }
 
   integrator->set_light_sampling_threshold(get_float(cscene, "light_sampling_threshold"));
+  integrator->set_use_light_tree(get_boolean(cscene, "use_light_tree"));
 
   SamplingPattern sampling_pattern = (SamplingPattern)get_enum(
       cscene, "sampling_pattern", SAMPLING_NUM_PATTERNS, SAMPLING_PATTERN_SOBOL);
   integrator->set_sampling_pattern(sampling_pattern);
 
+  integrator->set_use_ray_sorting(get_boolean(cscene, "debug_use_ray_sorting"));
+
   int samples = 1;
   bool use_adaptive_sampling = false;
   if (preview) {
@@ -798,6 +811,7 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene, bool background)
   params.use_bvh_spatial_split = RNA_boolean_get(&cscene, "debug_use_spatial_splits");
   params.use_bvh_compact_structure = RNA_boolean_get(&cscene, "debug_use_compact_bvh");
   params.use_bvh_unaligned_nodes = RNA_boolean_get(&cscene, "debug_use_hair_bvh");
+  params.use_bvh_compressed_nodes = RNA_boolean_get(&cscene, "debug_use_compressed_bvh");
   params.num_bvh_time_steps = RNA_int_get(&cscene, "debug_bvh_time_steps");
 
   PointerRNA csscene = RNA_pointer_get(&b_scene.ptr, "cycles_curves");
@@ -902,6 +916,7 @@ SessionParams BlenderSync::get_session_params(BL::RenderEngine &b_engine,
   /* Time limit. */
   if (background) {
     params.time_limit = (double)get_float(cscene, "time_limit");
+    params.use_time_budget = get_boolean(cscene, "use_time_budget");
   }
   else {
     /* For the viewport it kind of makes more sense to think in terms of the noise floor, which is
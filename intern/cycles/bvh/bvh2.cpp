@@ -14,6 +14,7 @@
 #include "bvh/unaligned.h"
 
 #include "util/foreach.h"
+#include "util/math.h"
 #include "util/progress.h"
 
 CCL_NAMESPACE_BEGIN
@@ -131,6 +132,15 @@ void BVH2::pack_inner(const BVHStackEntry &e, const BVHStackEntry &e0, const BVH
   if (e0.node->is_unaligned || e1.node->is_unaligned) {
     pack_unaligned_inner(e, e0, e1);
   }
+  else if (params.use_compressed_nodes) {
+    pack_compressed_node(e.idx,
+                         e0.node->bounds,
+                         e1.node->bounds,
+                         e0.encodeIdx(),
+                         e1.encodeIdx(),
+                         e0.node->visibility,
+                         e1.node->visibility);
+  }
   else {
     pack_aligned_inner(e, e0, e1);
   }
@@ -181,6 +191,94 @@ void BVH2::pack_aligned_node(int idx,
   memcpy(&pack.nodes[idx], data, sizeof(int4) * BVH_NODE_SIZE);
 }
 
+/* Quantize the bounds of both children along one axis to 8 bits, relative to the origin of the
+ * node. The decoded bounds are computed as `origin + q * 2^exponent`, which is exact except for
+ * the final rounding of the addition, so the same rounding is used here to make sure the decoded
+ * bounds always contain the original ones. */
+static uint quantize_node_axis(const float origin,
+                               const float lo0,
+                               const float hi0,
+                               const float lo1,
+                               const float hi1,
+                               uint &r_exponent)
+{
+  const float extent = max(hi0, hi1) - origin;
+  int exponent = 127;
+  if (isfinite(extent)) {
+    frexpf(extent / 255.0f, &exponent);
+    exponent = clamp(exponent, -126, 127);
+  }
+
+  const float lo[2] = {lo0, lo1};
+  const float hi[2] = {hi0, hi1};
+  for (;; exponent++) {
+    const float scale = ldexpf(1.0f, exponent);
+    uint packed = 0;
+    bool fits = true;
+    for (int i = 0; i < 2 && fits; i++) {
+      int q_lo = (int)clamp(floorf((lo[i] - origin) / scale), 0.0f, 255.0f);
+      while (q_lo > 0 && origin + q_lo * scale > lo[i]) {
+        q_lo--;
+      }
+      int q_hi = (int)clamp(ceilf((hi[i] - origin) / scale), 0.0f, 256.0f);
+      while (q_hi < 256 && origin + q_hi * scale < hi[i]) {
+        q_hi++;
+      }
+      /* The largest exponent overflows to infinity for the upper bound, so it always fits. */
+      fits = q_hi <= 255 || exponent == 127;
+      packed |= (uint)q_lo << (i * 8);
+      packed |= (uint)min(q_hi, 255) << (16 + i * 8);
+    }
+    if (fits) {
+      r_exponent = (uint)(exponent + 127);
+      return packed;
+    }
+  }
+}
+
+void BVH2::pack_compressed_node(int idx,
+                                const BoundBox &b0,
+                                const BoundBox &b1,
+                                int c0,
+                                int c1,
+                                uint visibility0,
+                                uint visibility1)
+{
+  assert(idx + BVH_COMPRESSED_NODE_SIZE <= pack.nodes.size());
+  assert(c0 < 0 || c0 < pack.nodes.size());
+  assert(c1 < 0 || c1 < pack.nodes.size());
+
+  /* Empty children have no primitives that can be hit, store them as a point at the bounds of
+   * the other child to keep the quantization range small. */
+  BoundBox bounds0 = b0.valid() ? b0 : (b1.valid() ? BoundBox(b1.min) : BoundBox(zero_float3()));
+  BoundBox bounds1 = b1.valid() ? b1 : BoundBox(bounds0.min);
+
+  const float3 origin = min(bounds0.min, bounds1.min);
+  uint exponent_x, exponent_y, exponent_z;
+  const uint quantized_x = quantize_node_axis(
+      origin.x, bounds0.min.x, bounds0.max.x, bounds1.min.x, bounds1.max.x, exponent_x);
+  const uint quantized_y = quantize_node_axis(
+      origin.y, bounds0.min.y, bounds0.max.y, bounds1.min.y, bounds1.max.y, exponent_y);
+  const uint quantized_z = quantize_node_axis(
+      origin.z, bounds0.min.z, bounds0.max.z, bounds1.min.z, bounds1.max.z, exponent_z);
+
+  /* The unaligned flag on the second child tags the node as compressed, aligned nodes never have
+   * it set otherwise. */
+  int4 data[BVH_COMPRESSED_NODE_SIZE] = {
+      make_int4(visibility0 & ~PATH_RAY_NODE_UNALIGNED,
+                visibility1 | PATH_RAY_NODE_UNALIGNED,
+                c0,
+                c1),
+      make_int4(__float_as_int(origin.x),
+                __float_as_int(origin.y),
+                __float_as_int(origin.z),
+                exponent_x | (exponent_y << 8) | (exponent_z << 16)),
+      make_int4(quantized_x, quantized_y, quantized_z, 0),
+  };
+
+  memcpy(&pack.nodes[idx], data, sizeof(int4) * BVH_COMPRESSED_NODE_SIZE);
+}
+
 void BVH2::pack_unaligned_inner(const BVHStackEntry &e,
                                 const BVHStackEntry &e0,
                                 const BVHStackEntry &e1)
@@ -228,20 +326,30 @@ void BVH2::pack_unaligned_node(int idx,
   memcpy(&pack.nodes[idx], data, sizeof(float4) * BVH_UNALIGNED_NODE_SIZE);
 }
 
+int BVH2::inner_node_size(const BVHNode *node) const
+{
+  if (node->has_unaligned()) {
+    return BVH_UNALIGNED_NODE_SIZE;
+  }
+  return params.use_compressed_nodes ? BVH_COMPRESSED_NODE_SIZE : BVH_NODE_SIZE;
+}
+
 void BVH2::pack_nodes(const BVHNode *root)
 {
   const size_t num_nodes = root->getSubtreeSize(BVH_STAT_NODE_COUNT);
   const size_t num_leaf_nodes = root->getSubtreeSize(BVH_STAT_LEAF_COUNT);
   assert(num_leaf_nodes <= num_nodes);
   const size_t num_inner_nodes = num_nodes - num_leaf_nodes;
+  const size_t aligned_node_size = params.use_compressed_nodes ? BVH_COMPRESSED_NODE_SIZE :
+                                                                  BVH_NODE_SIZE;
   size_t node_size;
   if (params.use_unaligned_nodes) {
     const size_t num_unaligned_nodes = root->getSubtreeSize(BVH_STAT_UNALIGNED_INNER_COUNT);
     node_size = (num_unaligned_nodes * BVH_UNALIGNED_NODE_SIZE) +
-                (num_inner_nodes - num_unaligned_nodes) * BVH_NODE_SIZE;
+                (num_inner_nodes - num_unaligned_nodes) * aligned_node_size;
   }
   else {
-    node_size = num_inner_nodes * BVH_NODE_SIZE;
+    node_size = num_inner_nodes * aligned_node_size;
   }
   /* Resize arrays */
   pack.nodes.clear();
@@ -264,7 +372,7 @@ void BVH2::pack_nodes(const BVHNode *root)
   }
   else {
     stack.push_back(BVHStackEntry(root, nextNodeIdx));
-    nextNodeIdx += root->has_unaligned() ? BVH_UNALIGNED_NODE_SIZE : BVH_NODE_SIZE;
+    nextNodeIdx += inner_node_size(root);
   }
 
   while (stack.size()) {
@@ -285,8 +393,7 @@ void BVH2::pack_nodes(const BVHNode *root)
         }
         else {
           idx[i] = nextNodeIdx;
-          nextNodeIdx += e.node->get_child(i)->has_unaligned() ? BVH_UNALIGNED_NODE_SIZE :
-                                                                 BVH_NODE_SIZE;
+          nextNodeIdx += inner_node_size(e.node->get_child(i));
         }
       }
 
@@ -330,10 +437,11 @@ void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
     memcpy(&pack.leaf_nodes[idx], leaf_data, sizeof(float4) * BVH_NODE_LEAF_SIZE);
   }
   else {
-    assert(idx + BVH_NODE_SIZE <= pack.nodes.size());
+    assert(idx + BVH_COMPRESSED_NODE_SIZE <= pack.nodes.size());
 
     const int4 *data = &pack.nodes[idx];
     const bool is_unaligned = (data[0].x & PATH_RAY_NODE_UNALIGNED) != 0;
+    const bool is_compressed = !is_unaligned && (data[0].y & PATH_RAY_NODE_UNALIGNED) != 0;
     const int c0 = data[0].z;
     const int c1 = data[0].w;
     /* refit inner node, set bbox from children */
@@ -348,6 +456,9 @@ void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
       pack_unaligned_node(
           idx, aligned_space, aligned_space, bbox0, bbox1, c0, c1, visibility0, visibility1);
     }
+    else if (is_compressed) {
+      pack_compressed_node(idx, bbox0, bbox1, c0, c1, visibility0, visibility1);
+    }
     else {
       pack_aligned_node(idx, bbox0, bbox1, c0, c1, visibility0, visibility1);
     }
@@ -614,6 +725,10 @@ void BVH2::pack_instances(size_t nodes_size, size_t leaf_nodes_size)
           nsize = BVH_UNALIGNED_NODE_SIZE;
           nsize_bbox = 0;
         }
+        else if (bvh_nodes[i].y & PATH_RAY_NODE_UNALIGNED) {
+          nsize = BVH_COMPRESSED_NODE_SIZE;
+          nsize_bbox = 0;
+        }
         else {
           nsize = BVH_NODE_SIZE;
           nsize_bbox = 0;
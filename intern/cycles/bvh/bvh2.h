@@ -16,6 +16,7 @@ CCL_NAMESPACE_BEGIN
 #define BVH_NODE_SIZE 4
 #define BVH_NODE_LEAF_SIZE 1
 #define BVH_UNALIGNED_NODE_SIZE 7
+#define BVH_COMPRESSED_NODE_SIZE 3
 
 /* Pack Utility */
 struct BVHStackEntry {
@@ -50,6 +51,9 @@ class BVH2 : public BVH {
   /* pack */
   void pack_nodes(const BVHNode *root);
 
+  /* Number of int4 elements used to store an inner node. */
+  int inner_node_size(const BVHNode *node) const;
+
   void pack_leaf(const BVHStackEntry &e, const LeafNode *leaf);
   void pack_inner(const BVHStackEntry &e, const BVHStackEntry &e0, const BVHStackEntry &e1);
 
@@ -64,6 +68,15 @@ class BVH2 : public BVH {
                          uint visibility0,
                          uint visibility1);
 
+  /* Aligned node with child bounds quantized to 8 bits relative to the node bounds. */
+  void pack_compressed_node(int idx,
+                            const BoundBox &b0,
+                            const BoundBox &b1,
+                            int c0,
+                            int c1,
+                            uint visibility0,
+                            uint visibility1);
+
   void pack_unaligned_inner(const BVHStackEntry &e,
                             const BVHStackEntry &e0,
                             const BVHStackEntry &e1);
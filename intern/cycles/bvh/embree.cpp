@@ -101,12 +101,13 @@ static void rtc_filter_occluded_func(const RTCFilterFunctionNArguments *args)
 
       ++ctx->num_hits;
 
-      /* Always use baked shadow transparency for curves. */
-      if (current_isect.type & PRIMITIVE_CURVE) {
-        ctx->throughput *= intersection_curve_shadow_transparency(
-            kg, current_isect.object, current_isect.prim, current_isect.u);
+      /* Use baked or constant shadow transparency when available. */
+      const float transparency = intersection_shadow_transparency(
+          kg, current_isect.object, current_isect.prim, current_isect.type, current_isect.u);
+      if (transparency >= 0.0f) {
+        ctx->throughput *= transparency;
 
-        if (ctx->throughput < CURVE_SHADOW_TRANSPARENCY_CUTOFF) {
+        if (ctx->throughput < SHADOW_TRANSPARENCY_CUTOFF) {
           ctx->opaque_hit = true;
           return;
         }
@@ -424,10 +425,62 @@ void BVHEmbree::build(Progress &progress, Stats *stats, RTCDevice rtc_device_)
     return;
   }
 
+  if (params.top_level) {
+    update_object_states();
+  }
+
   rtcSetSceneProgressMonitorFunction(scene, rtc_progress_func, &progress);
   rtcCommitScene(scene);
 }
 
+BVHEmbree::ObjectState BVHEmbree::get_object_state(const Object *ob)
+{
+  const Geometry *geom = ob->get_geometry();
+
+  ObjectState state;
+  state.traceable = ob->is_traceable();
+  state.instanced_scene = NULL;
+  state.num_motion_steps = 1;
+  state.prim_offset = geom->prim_offset;
+  state.visibility = ob->visibility_for_tracing();
+  if (geom->is_instanced() && geom->bvh) {
+    state.visibility = 0;
+    state.instanced_scene = static_cast<const BVHEmbree *>(geom->bvh)->scene;
+    if (ob->use_motion()) {
+      state.num_motion_steps = min(ob->get_motion().size(), (size_t)RTC_MAX_TIME_STEP_COUNT);
+    }
+  }
+  return state;
+}
+
+void BVHEmbree::update_object_states()
+{
+  object_states.clear();
+  object_states.reserve(objects.size());
+  foreach (const Object *ob, objects) {
+    object_states.push_back(get_object_state(ob));
+  }
+}
+
+bool BVHEmbree::can_refit() const
+{
+  if (!scene) {
+    return false;
+  }
+  if (!params.top_level) {
+    return true;
+  }
+  if (object_states.size() != objects.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < objects.size(); i++) {
+    if (!(get_object_state(objects[i]) == object_states[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void BVHEmbree::add_object(Object *ob, int i)
 {
   Geometry *geom = ob->get_geometry();
@@ -465,6 +518,20 @@ void BVHEmbree::add_instance(Object *ob, int i)
   rtcSetGeometryInstancedScene(geom_id, instance_bvh->scene);
   rtcSetGeometryTimeStepCount(geom_id, num_motion_steps);
 
+  set_instance_transform(geom_id, ob);
+
+  rtcSetGeometryUserData(geom_id, (void *)instance_bvh->scene);
+  rtcSetGeometryMask(geom_id, ob->visibility_for_tracing());
+
+  rtcCommitGeometry(geom_id);
+  rtcAttachGeometryByID(scene, geom_id, i * 2);
+  rtcReleaseGeometry(geom_id);
+}
+
+void BVHEmbree::set_instance_transform(RTCGeometry geom_id, const Object *ob)
+{
+  const size_t num_motion_steps = min(ob->get_motion().size(), (size_t)RTC_MAX_TIME_STEP_COUNT);
+
   if (ob->use_motion()) {
     array<DecomposedTransform> decomp(ob->get_motion().size());
     transform_motion_decompose(decomp.data(), ob->get_motion().data(), ob->get_motion().size());
@@ -486,13 +553,6 @@ void BVHEmbree::add_instance(Object *ob, int i)
     rtcSetGeometryTransform(
         geom_id, 0, RTC_FORMAT_FLOAT3X4_ROW_MAJOR, (const float *)&ob->get_tfm());
   }
-
-  rtcSetGeometryUserData(geom_id, (void *)instance_bvh->scene);
-  rtcSetGeometryMask(geom_id, ob->visibility_for_tracing());
-
-  rtcCommitGeometry(geom_id);
-  rtcAttachGeometryByID(scene, geom_id, i * 2);
-  rtcReleaseGeometry(geom_id);
 }
 
 void BVHEmbree::add_triangles(const Object *ob, const Mesh *mesh, int i)
@@ -820,6 +880,24 @@ void BVHEmbree::refit(Progress &progress)
   /* Update all vertex buffers, then tell Embree to rebuild/-fit the BVHs. */
   unsigned geom_id = 0;
   foreach (Object *ob, objects) {
+    if (params.top_level && ob->is_traceable()) {
+      if (ob->get_geometry()->is_instanced()) {
+        /* Only the transform and visibility of instances can change, the instanced scene is
+         * the same as checked by #can_refit. */
+        RTCGeometry geom = rtcGetGeometry(scene, geom_id);
+        set_instance_transform(geom, ob);
+        rtcSetGeometryMask(geom, ob->visibility_for_tracing());
+        rtcCommitGeometry(geom);
+        geom_id += 2;
+        continue;
+      }
+      if (!ob->get_geometry()->is_modified()) {
+        /* Vertex buffers of unchanged geometry are still valid. */
+        geom_id += 2;
+        continue;
+      }
+    }
+
     if (!params.top_level || (ob->is_traceable() && !ob->get_geometry()->is_instanced())) {
       Geometry *geom = ob->get_geometry();
 
@@ -853,6 +931,10 @@ void BVHEmbree::refit(Progress &progress)
     geom_id += 2;
   }
 
+  if (params.top_level) {
+    update_object_states();
+  }
+
   rtcCommitScene(scene);
 }
 
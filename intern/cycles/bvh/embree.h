@@ -27,6 +27,11 @@ class BVHEmbree : public BVH {
   void build(Progress &progress, Stats *stats, RTCDevice rtc_device);
   void refit(Progress &progress);
 
+  /* Whether the scene can be updated in place by #refit. For the top level this is only the case
+   * when no object changed its instancing or traceability and all instanced object BVHs were
+   * refitted rather than rebuilt. */
+  bool can_refit() const;
+
   RTCScene scene;
 
  protected:
@@ -43,6 +48,28 @@ class BVHEmbree : public BVH {
   void add_triangles(const Object *ob, const Mesh *mesh, int i);
 
  private:
+  /* State of an object in the top level scene which can not be changed by #refit. */
+  struct ObjectState {
+    /* Instanced object BVH, NULL for objects which are added to the top level directly. */
+    RTCScene instanced_scene;
+    size_t num_motion_steps;
+    size_t prim_offset;
+    /* Visibility of objects added directly, instances update it on refit. */
+    uint visibility;
+    bool traceable;
+
+    bool operator==(const ObjectState &other) const
+    {
+      return instanced_scene == other.instanced_scene &&
+             num_motion_steps == other.num_motion_steps && prim_offset == other.prim_offset &&
+             visibility == other.visibility && traceable == other.traceable;
+    }
+  };
+
+  static ObjectState get_object_state(const Object *ob);
+  void update_object_states();
+
+  void set_instance_transform(RTCGeometry geom_id, const Object *ob);
   void set_tri_vertex_buffer(RTCGeometry geom_id, const Mesh *mesh, const bool update);
   void set_curve_vertex_buffer(RTCGeometry geom_id, const Hair *hair, const bool update);
   void set_point_vertex_buffer(RTCGeometry geom_id,
@@ -51,6 +78,9 @@ class BVHEmbree : public BVH {
 
   RTCDevice rtc_device;
   enum RTCBuildQuality build_quality;
+
+  /* Per object state of the top level scene at the time it was last built or refitted. */
+  vector<ObjectState> object_states;
 };
 
 CCL_NAMESPACE_END
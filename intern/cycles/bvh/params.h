@@ -87,6 +87,10 @@ class BVHParams {
   /* Use compact acceleration structure (Embree)*/
   bool use_compact_structure;
 
+  /* Quantize the bounds of aligned nodes (BVH2), which uses less memory at the cost of looser
+   * bounding boxes. */
+  bool use_compressed_nodes;
+
   /* Split time range to this number of steps and create leaf node for each
    * of this time steps.
    *
@@ -130,6 +134,7 @@ class BVHParams {
     top_level = false;
     bvh_layout = BVH_LAYOUT_BVH2;
     use_compact_structure = true;
+    use_compressed_nodes = false;
     use_unaligned_nodes = false;
 
     num_motion_curve_steps = 0;
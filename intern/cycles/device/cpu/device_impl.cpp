@@ -263,7 +263,7 @@ void CPUDevice::build_bvh(BVH *bvh, Progress &progress, bool refit)
       bvh->params.bvh_layout == BVH_LAYOUT_MULTI_OPTIX_EMBREE ||
       bvh->params.bvh_layout == BVH_LAYOUT_MULTI_METAL_EMBREE) {
     BVHEmbree *const bvh_embree = static_cast<BVHEmbree *>(bvh);
-    if (refit) {
+    if (refit && bvh_embree->can_refit()) {
       bvh_embree->refit(progress);
     }
     else {
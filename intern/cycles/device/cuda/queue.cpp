@@ -181,6 +181,8 @@ void CUDADeviceQueue::copy_to_device(device_memory &mem)
   assert(mem.device_pointer != 0);
   assert(mem.host_pointer != nullptr);
 
+  debug_copy(mem);
+
   /* Copy memory to device. */
   const CUDAContextScope scope(cuda_device_);
   assert_success(
@@ -200,6 +202,8 @@ void CUDADeviceQueue::copy_from_device(device_memory &mem)
   assert(mem.device_pointer != 0);
   assert(mem.host_pointer != nullptr);
 
+  debug_copy(mem);
+
   /* Copy memory from device. */
   const CUDAContextScope scope(cuda_device_);
   assert_success(
@@ -179,6 +179,8 @@ void HIPDeviceQueue::copy_to_device(device_memory &mem)
   assert(mem.device_pointer != 0);
   assert(mem.host_pointer != nullptr);
 
+  debug_copy(mem);
+
   /* Copy memory to device. */
   const HIPContextScope scope(hip_device_);
   assert_success(
@@ -198,6 +200,8 @@ void HIPDeviceQueue::copy_from_device(device_memory &mem)
   assert(mem.device_pointer != 0);
   assert(mem.host_pointer != nullptr);
 
+  debug_copy(mem);
+
   /* Copy memory from device. */
   const HIPContextScope scope(hip_device_);
   assert_success(
@@ -94,6 +94,8 @@ void MetalDeviceQueue::init_execution()
   /* Synchronize all textures and memory copies before executing task. */
   metal_device->load_texture_info();
 
+  debug_init_execution();
+
   synchronize();
 }
 
@@ -108,6 +110,8 @@ bool MetalDeviceQueue::enqueue(DeviceKernel kernel,
   VLOG(3) << "Metal queue launch " << device_kernel_as_string(kernel) << ", work_size "
           << work_size;
 
+  debug_enqueue(kernel, work_size);
+
   const MetalDeviceKernel &metal_kernel = metal_device->kernels.get(kernel);
   const MetalKernelPipeline &metal_kernel_pso = metal_kernel.get_pso();
 
@@ -381,6 +385,8 @@ bool MetalDeviceQueue::synchronize()
     mtlCommandBuffer = nil;
   }
 
+  debug_synchronize();
+
   return !(metal_device->have_error());
 }
 
@@ -425,6 +431,8 @@ void MetalDeviceQueue::copy_to_device(device_memory &mem)
   assert(mem.device_pointer != 0);
   assert(mem.host_pointer != nullptr);
 
+  debug_copy(mem);
+
   std::lock_guard<std::recursive_mutex> lock(metal_device->metal_mem_map_mutex);
   auto result = metal_device->metal_mem_map.find(&mem);
   if (result != metal_device->metal_mem_map.end()) {
@@ -464,6 +472,8 @@ void MetalDeviceQueue::copy_from_device(device_memory &mem)
   assert(mem.device_pointer != 0);
   assert(mem.host_pointer != nullptr);
 
+  debug_copy(mem);
+
   std::lock_guard<std::recursive_mutex> lock(metal_device->metal_mem_map_mutex);
   MetalDevice::MetalMem &mmem = *metal_device->metal_mem_map.at(&mem);
   if (mmem.mtlBuffer) {
@@ -3,6 +3,8 @@
 
 #include "device/queue.h"
 
+#include "device/memory.h"
+
 #include "util/algorithm.h"
 #include "util/log.h"
 #include "util/time.h"
@@ -11,8 +13,21 @@
 
 CCL_NAMESPACE_BEGIN
 
+void DeviceQueueStatistics::add(const DeviceQueueStatistics &other)
+{
+  for (int i = 0; i < DEVICE_KERNEL_NUM; i++) {
+    kernels[i].num_launches += other.kernels[i].num_launches;
+    kernels[i].num_work_items += other.kernels[i].num_work_items;
+    kernels[i].time += other.kernels[i].time;
+  }
+  num_copied_bytes += other.num_copied_bytes;
+}
+
 DeviceQueue::DeviceQueue(Device *device)
-    : device(device), last_kernels_enqueued_(0), last_sync_time_(0.0)
+    : device(device),
+      last_kernels_enqueued_(0),
+      last_kernel_enqueued_(DEVICE_KERNEL_NUM),
+      last_sync_time_(0.0)
 {
   DCHECK_NE(device, nullptr);
 }
@@ -40,13 +55,17 @@ DeviceQueue::~DeviceQueue()
   }
 }
 
+void DeviceQueue::reset_statistics()
+{
+  stats_ = DeviceQueueStatistics();
+}
+
 void DeviceQueue::debug_init_execution()
 {
-  if (VLOG_IS_ON(3)) {
-    last_sync_time_ = time_dt();
-  }
+  last_sync_time_ = time_dt();
 
   last_kernels_enqueued_ = 0;
+  last_kernel_enqueued_ = DEVICE_KERNEL_NUM;
 }
 
 void DeviceQueue::debug_enqueue(DeviceKernel kernel, const int work_size)
@@ -57,21 +76,37 @@ void DeviceQueue::debug_enqueue(DeviceKernel kernel, const int work_size)
   }
 
   last_kernels_enqueued_ |= (uint64_t(1) << (uint64_t)kernel);
+  last_kernel_enqueued_ = kernel;
+
+  DeviceKernelStatistics &kernel_stats = stats_.kernels[kernel];
+  kernel_stats.num_launches++;
+  kernel_stats.num_work_items += work_size;
 }
 
 void DeviceQueue::debug_synchronize()
 {
+  const double new_time = time_dt();
+  const double elapsed_time = new_time - last_sync_time_;
+
   if (VLOG_IS_ON(3)) {
-    const double new_time = time_dt();
-    const double elapsed_time = new_time - last_sync_time_;
     VLOG(4) << "GPU queue synchronize, elapsed " << std::setw(10) << elapsed_time << "s";
 
     stats_kernel_time_[last_kernels_enqueued_] += elapsed_time;
+  }
 
-    last_sync_time_ = new_time;
+  if (last_kernel_enqueued_ != DEVICE_KERNEL_NUM) {
+    stats_.kernels[last_kernel_enqueued_].time += elapsed_time;
   }
 
+  last_sync_time_ = new_time;
+
   last_kernels_enqueued_ = 0;
+  last_kernel_enqueued_ = DEVICE_KERNEL_NUM;
+}
+
+void DeviceQueue::debug_copy(device_memory &mem)
+{
+  stats_.num_copied_bytes += mem.memory_size();
 }
 
 string DeviceQueue::debug_active_kernels()
@@ -87,6 +87,27 @@ struct DeviceKernelArguments {
   }
 };
 
+/* Statistics of a single kernel enqueued in a device queue. */
+struct DeviceKernelStatistics {
+  /* Number of times the kernel was enqueued. */
+  uint64_t num_launches = 0;
+  /* Sum of work sizes of all launches. For integrator kernels this is the number of active
+   * paths the kernel was executed for. */
+  uint64_t num_work_items = 0;
+  /* Accumulated execution time in seconds. */
+  double time = 0.0;
+};
+
+/* Statistics of all kernels and memory copies of a device queue. */
+struct DeviceQueueStatistics {
+  DeviceKernelStatistics kernels[DEVICE_KERNEL_NUM];
+
+  /* Number of bytes copied between host and device as part of the queue. */
+  uint64_t num_copied_bytes = 0;
+
+  void add(const DeviceQueueStatistics &other);
+};
+
 /* Abstraction of a command queue for a device.
  * Provides API to schedule kernel execution in a specific queue with minimal possible overhead
  * from driver side.
@@ -149,6 +170,19 @@ class DeviceQueue {
     return nullptr;
   }
 
+  /* Statistics of kernels enqueued since the construction of the queue or the last call of
+   * `reset_statistics()`.
+   *
+   * The execution time is measured between synchronizations, and is attributed to the last
+   * kernel enqueued before synchronizing. For the path tracer this is the integrator kernel, with
+   * the helper kernels scheduled before it (such as the computation of queued paths) included
+   * in its time. */
+  const DeviceQueueStatistics &statistics() const
+  {
+    return stats_;
+  }
+  void reset_statistics();
+
   /* Device this queue has been created for. */
   Device *device;
 
@@ -160,14 +194,19 @@ class DeviceQueue {
   void debug_init_execution();
   void debug_enqueue(DeviceKernel kernel, const int work_size);
   void debug_synchronize();
+  void debug_copy(device_memory &mem);
   string debug_active_kernels();
 
   /* Combination of kernels enqueued together sync last synchronize. */
   DeviceKernelMask last_kernels_enqueued_;
+  /* Last kernel enqueued since last synchronize, DEVICE_KERNEL_NUM if there is none. */
+  DeviceKernel last_kernel_enqueued_;
   /* Time of synchronize call. */
   double last_sync_time_;
   /* Accumulated execution time for combinations of kernels launched together. */
   map<DeviceKernelMask, double> stats_kernel_time_;
+  /* Statistics of individual kernels. */
+  DeviceQueueStatistics stats_;
 };
 
 CCL_NAMESPACE_END
@@ -27,6 +27,11 @@ OIDNDenoiser::OIDNDenoiser(Device *path_trace_device, const DenoiseParams &param
 }
 
 #ifdef WITH_OPENIMAGEDENOISE
+/* Approximate limit of the scratch memory used by every OIDN filter, in megabytes. OIDN splits
+ * larger images into overlapping tiles itself, so the memory used for filtering doesn't grow
+ * with the resolution of the render. */
+static const int kOIDNMaxMemoryMB = 2048;
+
 static bool oidn_progress_monitor_function(void *user_ptr, double /*n*/)
 {
   OIDNDenoiser *oidn_denoiser = reinterpret_cast<OIDNDenoiser *>(user_ptr);
@@ -167,6 +172,7 @@ class OIDNDenoiseContext {
         denoise_params_.prefilter == DENOISER_PREFILTER_ACCURATE) {
       oidn_filter.set("cleanAux", true);
     }
+    oidn_filter.set("maxMemoryMB", kOIDNMaxMemoryMB);
     oidn_filter.commit();
 
     filter_guiding_pass_if_needed(oidn_device, oidn_albedo_pass_);
@@ -196,6 +202,7 @@ class OIDNDenoiseContext {
     oidn::FilterRef oidn_filter = oidn_device.newFilter("RT");
     set_pass(oidn_filter, oidn_pass);
     set_output_pass(oidn_filter, oidn_pass);
+    oidn_filter.set("maxMemoryMB", kOIDNMaxMemoryMB);
     oidn_filter.commit();
     oidn_filter.execute();
 
@@ -117,6 +117,10 @@ void PathTrace::reset(const BufferParams &full_params,
   render_state_.tile_written = false;
 
   did_draw_after_reset_ = false;
+
+  for (auto &&path_trace_work : path_trace_works_) {
+    path_trace_work->reset_device_queue_statistics();
+  }
 }
 
 void PathTrace::device_free()
@@ -995,6 +999,13 @@ int PathTrace::get_num_render_tile_samples() const
   return render_scheduler_.get_num_rendered_samples();
 }
 
+void PathTrace::get_device_queue_statistics(DeviceQueueStatistics &statistics) const
+{
+  for (auto &&path_trace_work : path_trace_works_) {
+    path_trace_work->add_device_queue_statistics(statistics);
+  }
+}
+
 bool PathTrace::get_render_tile_pixels(const PassAccessor &pass_accessor,
                                        const PassAccessor::Destination &destination)
 {
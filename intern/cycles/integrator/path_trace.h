@@ -132,6 +132,10 @@ class PathTrace {
   /* Get number of samples in the current big tile render buffers. */
   int get_num_render_tile_samples() const;
 
+  /* Get statistics of kernels executed on GPU devices since the last reset, accumulated over
+   * all devices. */
+  void get_device_queue_statistics(DeviceQueueStatistics &statistics) const;
+
   /* Get pass data of the entire big tile.
    * This call puts pass render result from all devices into the final pixels storage.
    *
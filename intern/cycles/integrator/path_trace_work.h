@@ -14,6 +14,7 @@ CCL_NAMESPACE_BEGIN
 class BufferParams;
 class Device;
 class DeviceScene;
+struct DeviceQueueStatistics;
 class Film;
 class PathTraceDisplay;
 class RenderBuffers;
@@ -125,6 +126,15 @@ class PathTraceWork {
   /* Run cryptomatte pass post-processing kernels. */
   virtual void cryptomatte_postproces() = 0;
 
+  /* Accumulate statistics of kernels executed by this work into the given statistics.
+   * Only works which schedule kernels via a device queue have statistics. */
+  virtual void add_device_queue_statistics(DeviceQueueStatistics & /*statistics*/) const
+  {
+  }
+  virtual void reset_device_queue_statistics()
+  {
+  }
+
   /* Cheap-ish request to see whether rendering is requested and is to be stopped as soon as
    * possible, without waiting for any samples to be finished. */
   inline bool is_cancel_requested() const
@@ -71,9 +71,21 @@ void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
     }
   }
 
-  tbb::task_arena local_arena = local_tbb_arena_create(device_);
-  local_arena.execute([&]() {
-    tbb::parallel_for(int64_t(0), total_pixels_num, [&](int64_t work_index) {
+  /* Consecutive pixels are rendered by the same task, so the per-task setup is done once for
+   * the whole range rather than for every pixel. */
+  const auto render_pixels = [&](const blocked_range<int64_t> &range) {
+    CPUKernelThreadGlobals *kernel_globals = kernel_thread_globals_get(kernel_thread_globals_);
+
+    KernelWorkTile work_tile;
+    work_tile.w = 1;
+    work_tile.h = 1;
+    work_tile.start_sample = start_sample;
+    work_tile.sample_offset = sample_offset;
+    work_tile.num_samples = 1;
+    work_tile.offset = effective_buffer_params_.offset;
+    work_tile.stride = effective_buffer_params_.stride;
+
+    for (int64_t work_index = range.begin(); work_index < range.end(); ++work_index) {
       if (is_cancel_requested()) {
         return;
       }
@@ -81,22 +93,17 @@ void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
       const int y = work_index / image_width;
       const int x = work_index - y * image_width;
 
-      KernelWorkTile work_tile;
       work_tile.x = effective_buffer_params_.full_x + x;
       work_tile.y = effective_buffer_params_.full_y + y;
-      work_tile.w = 1;
-      work_tile.h = 1;
-      work_tile.start_sample = start_sample;
-      work_tile.sample_offset = sample_offset;
-      work_tile.num_samples = 1;
-      work_tile.offset = effective_buffer_params_.offset;
-      work_tile.stride = effective_buffer_params_.stride;
-
-      CPUKernelThreadGlobals *kernel_globals = kernel_thread_globals_get(kernel_thread_globals_);
 
       render_samples_full_pipeline(kernel_globals, work_tile, samples_num);
-    });
-  });
+    }
+  };
+
+  tbb::task_arena local_arena = local_tbb_arena_create(device_);
+  local_arena.execute(
+      [&]() { tbb::parallel_for(blocked_range<int64_t>(0, total_pixels_num), render_pixels); });
+
   if (device_->profiler.active()) {
     for (CPUKernelThreadGlobals &kernel_globals : kernel_thread_globals_) {
       kernel_globals.stop_profiling();
@@ -67,6 +67,7 @@ PathTraceWorkGPU::PathTraceWorkGPU(Device *device,
           device, "integrator_shader_raytrace_sort_counter", MEM_READ_WRITE),
       integrator_shader_sort_prefix_sum_(
           device, "integrator_shader_sort_prefix_sum", MEM_READ_WRITE),
+      integrator_ray_sort_counter_(device, "integrator_ray_sort_counter", MEM_READ_WRITE),
       integrator_next_main_path_index_(device, "integrator_next_main_path_index", MEM_READ_WRITE),
       integrator_next_shadow_path_index_(
           device, "integrator_next_shadow_path_index", MEM_READ_WRITE),
@@ -188,14 +189,35 @@ void PathTraceWorkGPU::alloc_integrator_sorting()
     integrator_shader_raytrace_sort_counter_.alloc(max_shaders);
     integrator_shader_raytrace_sort_counter_.zero_to_device();
 
-    integrator_shader_sort_prefix_sum_.alloc(max_shaders);
-    integrator_shader_sort_prefix_sum_.zero_to_device();
-
     integrator_state_gpu_.sort_key_counter[DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE] =
         (int *)integrator_shader_sort_counter_.device_pointer;
     integrator_state_gpu_.sort_key_counter[DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE_RAYTRACE] =
         (int *)integrator_shader_raytrace_sort_counter_.device_pointer;
   }
+
+  /* Allocate arrays for ray sorting. A null counter tells the kernels to not sort paths queued
+   * for the closest intersection. */
+  const bool use_ray_sorting = device_scene_->data.integrator.use_ray_sorting;
+  if (use_ray_sorting) {
+    if (integrator_ray_sort_counter_.size() == 0) {
+      integrator_ray_sort_counter_.alloc(INTEGRATOR_RAY_SORT_NUM_KEYS);
+      integrator_ray_sort_counter_.zero_to_device();
+    }
+    integrator_state_gpu_.sort_key_counter[DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST] =
+        (int *)integrator_ray_sort_counter_.device_pointer;
+  }
+  else {
+    integrator_ray_sort_counter_.free();
+    integrator_state_gpu_.sort_key_counter[DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST] = nullptr;
+  }
+
+  /* The prefix sum is shared by all sorted kernels. */
+  const int max_sort_keys = (use_ray_sorting) ? max(max_shaders, INTEGRATOR_RAY_SORT_NUM_KEYS) :
+                                                max_shaders;
+  if (integrator_shader_sort_prefix_sum_.size() < max_sort_keys) {
+    integrator_shader_sort_prefix_sum_.alloc(max_sort_keys);
+    integrator_shader_sort_prefix_sum_.zero_to_device();
+  }
 }
 
 void PathTraceWorkGPU::alloc_integrator_path_split()
@@ -255,6 +277,9 @@ void PathTraceWorkGPU::render_samples(RenderStatistics &statistics,
 
   enqueue_reset();
 
+  num_ray_sort_launches_ = 0;
+  num_ray_sort_paths_ = 0;
+
   int num_iterations = 0;
   uint64_t num_busy_accum = 0;
 
@@ -300,6 +325,12 @@ void PathTraceWorkGPU::render_samples(RenderStatistics &statistics,
   }
 
   statistics.occupancy = static_cast<float>(num_busy_accum) / num_iterations / max_num_paths_;
+
+  if (num_ray_sort_launches_) {
+    VLOG(3) << "Ray sorting: " << num_ray_sort_launches_
+            << " sorted closest intersection launches, "
+            << num_ray_sort_paths_ / num_ray_sort_launches_ << " paths per launch on average.";
+  }
 }
 
 DeviceKernel PathTraceWorkGPU::get_most_queued_kernel() const
@@ -327,6 +358,9 @@ void PathTraceWorkGPU::enqueue_reset()
   queue_->zero_to_device(integrator_queue_counter_);
   queue_->zero_to_device(integrator_shader_sort_counter_);
   queue_->zero_to_device(integrator_shader_raytrace_sort_counter_);
+  if (integrator_ray_sort_counter_.size()) {
+    queue_->zero_to_device(integrator_ray_sort_counter_);
+  }
 
   /* Tiles enqueue need to know number of active paths, which is based on this counter. Zero the
    * counter on the host side because `zero_to_device()` is not doing it. */
@@ -402,12 +436,17 @@ void PathTraceWorkGPU::enqueue_path_iteration(DeviceKernel kernel, const int num
   int num_queued = queue_counter->num_queued[kernel];
 
   if (kernel_uses_sorting(kernel)) {
-    /* Compute array of active paths, sorted by shader. */
+    /* Compute array of active paths, sorted by shader or by ray coherence key. */
     work_size = num_queued;
     d_path_index = queued_paths_.device_pointer;
 
     compute_sorted_queued_paths(
         DEVICE_KERNEL_INTEGRATOR_SORTED_PATHS_ARRAY, kernel, num_paths_limit);
+
+    if (kernel == DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST) {
+      ++num_ray_sort_launches_;
+      num_ray_sort_paths_ += min(num_queued, num_paths_limit);
+    }
   }
   else if (num_queued < work_size) {
     work_size = num_queued;
@@ -474,12 +513,14 @@ void PathTraceWorkGPU::compute_sorted_queued_paths(DeviceKernel kernel,
   device_ptr d_prefix_sum = integrator_shader_sort_prefix_sum_.device_pointer;
   assert(d_counter != 0 && d_prefix_sum != 0);
 
-  /* Compute prefix sum of number of active paths with each shader. */
+  /* Compute prefix sum of number of active paths with each shader or ray sort key. */
   {
     const int work_size = 1;
-    int max_shaders = device_scene_->data.max_shaders;
+    int num_keys = (queued_kernel == DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST) ?
+                       INTEGRATOR_RAY_SORT_NUM_KEYS :
+                       device_scene_->data.max_shaders;
 
-    DeviceKernelArguments args(&d_counter, &d_prefix_sum, &max_shaders);
+    DeviceKernelArguments args(&d_counter, &d_prefix_sum, &num_keys);
 
     queue_->enqueue(DEVICE_KERNEL_PREFIX_SUM, work_size, args);
   }
@@ -1077,8 +1118,22 @@ int PathTraceWorkGPU::shadow_catcher_count_possible_splits()
   return num_queued_paths_.data()[0];
 }
 
+void PathTraceWorkGPU::add_device_queue_statistics(DeviceQueueStatistics &statistics) const
+{
+  statistics.add(queue_->statistics());
+}
+
+void PathTraceWorkGPU::reset_device_queue_statistics()
+{
+  queue_->reset_statistics();
+}
+
 bool PathTraceWorkGPU::kernel_uses_sorting(DeviceKernel kernel)
 {
+  if (kernel == DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST) {
+    return integrator_state_gpu_.sort_key_counter[kernel] != nullptr;
+  }
+
   return (kernel == DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE ||
           kernel == DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE_RAYTRACE);
 }
@@ -48,6 +48,9 @@ class PathTraceWorkGPU : public PathTraceWork {
   virtual int adaptive_sampling_converge_filter_count_active(float threshold, bool reset) override;
   virtual void cryptomatte_postproces() override;
 
+  virtual void add_device_queue_statistics(DeviceQueueStatistics &statistics) const override;
+  virtual void reset_device_queue_statistics() override;
+
  protected:
   void alloc_integrator_soa();
   void alloc_integrator_queue();
@@ -134,6 +137,11 @@ class PathTraceWorkGPU : public PathTraceWork {
   device_vector<int> integrator_shader_sort_counter_;
   device_vector<int> integrator_shader_raytrace_sort_counter_;
   device_vector<int> integrator_shader_sort_prefix_sum_;
+  /* Ray sorting for the closest intersection kernel. */
+  device_vector<int> integrator_ray_sort_counter_;
+  /* Statistics of ray sorting, reset for every `render_samples()` call. */
+  int num_ray_sort_launches_ = 0;
+  int64_t num_ray_sort_paths_ = 0;
   /* Path split. */
   device_vector<int> integrator_next_main_path_index_;
   device_vector<int> integrator_next_shadow_path_index_;
@@ -95,6 +95,16 @@ double RenderScheduler::get_time_limit() const
   return time_limit_;
 }
 
+void RenderScheduler::set_use_time_budget(bool use_time_budget)
+{
+  use_time_budget_ = use_time_budget;
+}
+
+bool RenderScheduler::get_use_time_budget() const
+{
+  return use_time_budget_;
+}
+
 int RenderScheduler::get_rendered_sample() const
 {
   DCHECK_GT(get_num_rendered_samples(), 0);
@@ -154,6 +164,9 @@ void RenderScheduler::reset(const BufferParams &buffer_params, int num_samples,
   state_.end_render_time = 0.0;
   state_.time_limit_reached = false;
 
+  time_budget_state_.start_render_time = 0.0;
+  time_budget_state_.num_finished_tiles = 0;
+
   state_.occupancy_num_samples = 0;
   state_.occupancy = 1.0f;
 
@@ -170,7 +183,12 @@ void RenderScheduler::reset(const BufferParams &buffer_params, int num_samples,
 
 void RenderScheduler::reset_for_next_tile()
 {
+  const auto time_budget_state = time_budget_state_;
+
   reset(buffer_params_, num_samples_, sample_offset_);
+
+  time_budget_state_ = time_budget_state;
+  ++time_budget_state_.num_finished_tiles;
 }
 
 bool RenderScheduler::render_work_reschedule_on_converge(RenderWork &render_work)
@@ -198,7 +216,7 @@ bool RenderScheduler::render_work_reschedule_on_converge(RenderWork &render_work
 
 bool RenderScheduler::render_work_reschedule_on_idle(RenderWork &render_work)
 {
-  if (!use_progressive_noise_floor_) {
+  if (!use_progressive_noise_floor()) {
     return false;
   }
 
@@ -449,6 +467,10 @@ void RenderScheduler::report_work_begin(const RenderWork &render_work)
   if (render_work.resolution_divider == pixel_size_ && render_work.path_trace.num_samples != 0 &&
       render_work.path_trace.start_sample == get_start_sample()) {
     state_.start_render_time = time_dt();
+
+    if (time_budget_state_.start_render_time == 0.0) {
+      time_budget_state_.start_render_time = state_.start_render_time;
+    }
   }
 }
 
@@ -523,6 +545,10 @@ void RenderScheduler::report_denoise_time(const RenderWork &render_work, double
 
   denoise_time_.add_average(final_time_approx);
 
+  if (render_work.resolution_divider == pixel_size_) {
+    time_budget_denoise_time_ = time;
+  }
+
   VLOG(4) << "Average denoising time: " << denoise_time_.get_average() << " seconds.";
 }
 
@@ -687,9 +713,10 @@ double RenderScheduler::guess_display_update_interval_in_seconds_for_num_samples
   double update_interval = guess_display_update_interval_in_seconds_for_num_samples_no_limit(
       num_rendered_samples);
 
-  if (time_limit_ != 0.0 && state_.start_render_time != 0.0) {
+  const double time_limit = get_tile_time_limit();
+  if (time_limit != 0.0 && state_.start_render_time != 0.0) {
     const double remaining_render_time = max(0.0,
-                                             time_limit_ - (time_dt() - state_.start_render_time));
+                                             time_limit - (time_dt() - state_.start_render_time));
 
     update_interval = min(update_interval, remaining_render_time);
   }
@@ -835,9 +862,10 @@ int RenderScheduler::get_num_samples_to_path_trace() const
      * When time limit is not used the number of samples per render iteration is either increasing
      * or stays the same, so there is no need to clamp number of samples calculated for occupancy.
      */
-    if (time_limit_ != 0.0 && state_.start_render_time != 0.0) {
+    const double time_limit = get_tile_time_limit();
+    if (time_limit != 0.0 && state_.start_render_time != 0.0) {
       const double remaining_render_time = max(
-          0.0, time_limit_ - (time_dt() - state_.start_render_time));
+          0.0, time_limit - (time_dt() - state_.start_render_time));
       const double time_per_sample_average = path_trace_time_.get_average();
       const double predicted_render_time = num_samples_to_occupy * time_per_sample_average;
 
@@ -907,7 +935,7 @@ bool RenderScheduler::work_need_adaptive_filter() const
 
 float RenderScheduler::work_adaptive_threshold() const
 {
-  if (!use_progressive_noise_floor_) {
+  if (!use_progressive_noise_floor()) {
     return adaptive_sampling_.threshold;
   }
 
@@ -1139,7 +1167,9 @@ bool RenderScheduler::work_report_reset_average(const RenderWork &render_work)
 
 void RenderScheduler::check_time_limit_reached()
 {
-  if (time_limit_ == 0.0) {
+  const double time_limit = get_tile_time_limit();
+
+  if (time_limit == 0.0) {
     /* No limit is enforced. */
     return;
   }
@@ -1151,7 +1181,7 @@ void RenderScheduler::check_time_limit_reached()
 
   const double current_time = time_dt();
 
-  if (current_time - state_.start_render_time < time_limit_) {
+  if (current_time - state_.start_render_time < time_limit) {
     /* Time limit is not reached yet. */
     return;
   }
@@ -1160,6 +1190,42 @@ void RenderScheduler::check_time_limit_reached()
   state_.end_render_time = current_time;
 }
 
+bool RenderScheduler::is_time_budget_used() const
+{
+  return use_time_budget_ && time_limit_ != 0.0 && background_;
+}
+
+double RenderScheduler::get_tile_time_limit() const
+{
+  if (!is_time_budget_used() || state_.start_render_time == 0.0) {
+    return time_limit_;
+  }
+
+  double budget = time_limit_;
+
+  /* Reserve time for denoising the final result. Use the time of the last denoising when it is
+   * known, otherwise a fraction of the budget. */
+  if (denoiser_params_.use) {
+    budget -= (time_budget_denoise_time_ >= 0.0) ? time_budget_denoise_time_ : 0.05 * time_limit_;
+  }
+
+  /* Distribute what is left from the previous tiles evenly over the remaining tiles. */
+  const double previous_tiles_time = state_.start_render_time -
+                                     time_budget_state_.start_render_time;
+  const int num_remaining_tiles = max(
+      tile_manager_.get_num_tiles() - time_budget_state_.num_finished_tiles, 1);
+
+  /* Use a tiny positive value when the budget is exceeded, zero would disable the limit. */
+  return max((budget - previous_tiles_time) / num_remaining_tiles, 1e-6);
+}
+
+bool RenderScheduler::use_progressive_noise_floor() const
+{
+  /* With the time budget the render might stop at any time, so keep lowering the noise floor
+   * uniformly, spending samples on the noisiest pixels first. */
+  return use_progressive_noise_floor_ || is_time_budget_used();
+}
+
 /* --------------------------------------------------------------------
  * Utility functions.
  */
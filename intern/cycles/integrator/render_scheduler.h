@@ -121,6 +121,13 @@ class RenderScheduler {
   void set_time_limit(double time_limit);
   double get_time_limit() const;
 
+  /* When time budget is used the time limit is a budget for the entire frame: it is distributed
+   * over the tiles, and includes the time needed for denoising the result. Adaptive sampling then
+   * progressively lowers the noise floor, so that when the budget is used up the image has a
+   * uniform noise level. */
+  void set_use_time_budget(bool use_time_budget);
+  bool get_use_time_budget() const;
+
   /* Get sample up to which rendering has been done.
    * This is an absolute 0-based value.
    *
@@ -275,6 +282,17 @@ class RenderScheduler {
    * average render time information. */
   void check_time_limit_reached();
 
+  /* Check whether time budget is to be enforced for the current render. */
+  bool is_time_budget_used() const;
+
+  /* Time limit in seconds for path tracing of the current tile, counted from the start of its
+   * rendering. When the time budget is used this is the share of the remaining frame budget.
+   * Zero means no limit is applied. */
+  double get_tile_time_limit() const;
+
+  /* Whether the adaptive sampling threshold is to be lowered progressively. */
+  bool use_progressive_noise_floor() const;
+
   /* Helper class to keep track of task timing.
    *
    * Contains two parts: wall time and average. The wall time is an actual wall time of how long it
@@ -416,6 +434,23 @@ class RenderScheduler {
    * Zero means no limit is applied. */
   double time_limit_ = 0.0;
 
+  bool use_time_budget_ = false;
+
+  /* State of the time budget of the frame. Unlike `state_` it is preserved when moving to the
+   * next tile. */
+  struct {
+    /* Time at which path tracing of the first tile of the frame started. */
+    double start_render_time = 0.0;
+
+    /* Number of tiles which finished rendering. */
+    int num_finished_tiles = 0;
+  } time_budget_state_;
+
+  /* Time it took to denoise the last result, used to reserve the time needed for denoising when
+   * the time budget is used. Negative if no denoising happened yet. Not affected by the reset, so
+   * that it is known for the next tile and the next render of the session. */
+  double time_budget_denoise_time_ = -1.0;
+
   /* Headless rendering without interface. */
   bool headless_;
 
@@ -15,6 +15,68 @@ ccl_device_forceinline Transform bvh_unaligned_node_fetch_space(KernelGlobals kg
   return space;
 }
 
+/* Decode a bound quantized by `pack_compressed_node()`. */
+ccl_device_forceinline float bvh_compressed_node_bound(const float origin,
+                                                       const float scale,
+                                                       const uint quantized,
+                                                       const int shift)
+{
+  return origin + (float)((quantized >> shift) & 0xff) * scale;
+}
+
+ccl_device_forceinline int bvh_compressed_node_intersect(KernelGlobals kg,
+                                                         const float3 P,
+                                                         const float3 idir,
+                                                         const float t,
+                                                         const int node_addr,
+                                                         const float4 cnodes,
+                                                         const uint visibility,
+                                                         float dist[2])
+{
+  /* fetch node data */
+  float4 node0 = kernel_tex_fetch(__bvh_nodes, node_addr + 1);
+  float4 node1 = kernel_tex_fetch(__bvh_nodes, node_addr + 2);
+
+  const uint exponents = __float_as_uint(node0.w);
+  const float scale_x = __uint_as_float((exponents & 0xff) << 23);
+  const float scale_y = __uint_as_float(((exponents >> 8) & 0xff) << 23);
+  const float scale_z = __uint_as_float(((exponents >> 16) & 0xff) << 23);
+  const uint qx = __float_as_uint(node1.x);
+  const uint qy = __float_as_uint(node1.y);
+  const uint qz = __float_as_uint(node1.z);
+
+  /* intersect ray against child nodes */
+  float c0lox = (bvh_compressed_node_bound(node0.x, scale_x, qx, 0) - P.x) * idir.x;
+  float c0hix = (bvh_compressed_node_bound(node0.x, scale_x, qx, 16) - P.x) * idir.x;
+  float c0loy = (bvh_compressed_node_bound(node0.y, scale_y, qy, 0) - P.y) * idir.y;
+  float c0hiy = (bvh_compressed_node_bound(node0.y, scale_y, qy, 16) - P.y) * idir.y;
+  float c0loz = (bvh_compressed_node_bound(node0.z, scale_z, qz, 0) - P.z) * idir.z;
+  float c0hiz = (bvh_compressed_node_bound(node0.z, scale_z, qz, 16) - P.z) * idir.z;
+  float c0min = max4(0.0f, min(c0lox, c0hix), min(c0loy, c0hiy), min(c0loz, c0hiz));
+  float c0max = min4(t, max(c0lox, c0hix), max(c0loy, c0hiy), max(c0loz, c0hiz));
+
+  float c1lox = (bvh_compressed_node_bound(node0.x, scale_x, qx, 8) - P.x) * idir.x;
+  float c1hix = (bvh_compressed_node_bound(node0.x, scale_x, qx, 24) - P.x) * idir.x;
+  float c1loy = (bvh_compressed_node_bound(node0.y, scale_y, qy, 8) - P.y) * idir.y;
+  float c1hiy = (bvh_compressed_node_bound(node0.y, scale_y, qy, 24) - P.y) * idir.y;
+  float c1loz = (bvh_compressed_node_bound(node0.z, scale_z, qz, 8) - P.z) * idir.z;
+  float c1hiz = (bvh_compressed_node_bound(node0.z, scale_z, qz, 24) - P.z) * idir.z;
+  float c1min = max4(0.0f, min(c1lox, c1hix), min(c1loy, c1hiy), min(c1loz, c1hiz));
+  float c1max = min4(t, max(c1lox, c1hix), max(c1loy, c1hiy), max(c1loz, c1hiz));
+
+  dist[0] = c0min;
+  dist[1] = c1min;
+
+#ifdef __VISIBILITY_FLAG__
+  /* The unaligned flag of the second child tags the node as compressed. */
+  const uint visibility1 = __float_as_uint(cnodes.y) & ~PATH_RAY_NODE_UNALIGNED;
+  return (((c0max >= c0min) && (__float_as_uint(cnodes.x) & visibility)) ? 1 : 0) |
+         (((c1max >= c1min) && (visibility1 & visibility)) ? 2 : 0);
+#else
+  return ((c0max >= c0min) ? 1 : 0) | ((c1max >= c1min) ? 2 : 0);
+#endif
+}
+
 ccl_device_forceinline int bvh_aligned_node_intersect(KernelGlobals kg,
                                                       const float3 P,
                                                       const float3 idir,
@@ -25,9 +87,10 @@ ccl_device_forceinline int bvh_aligned_node_intersect(KernelGlobals kg,
 {
 
   /* fetch node data */
-#ifdef __VISIBILITY_FLAG__
   float4 cnodes = kernel_tex_fetch(__bvh_nodes, node_addr + 0);
-#endif
+  if (__float_as_uint(cnodes.y) & PATH_RAY_NODE_UNALIGNED) {
+    return bvh_compressed_node_intersect(kg, P, idir, t, node_addr, cnodes, visibility, dist);
+  }
   float4 node0 = kernel_tex_fetch(__bvh_nodes, node_addr + 1);
   float4 node1 = kernel_tex_fetch(__bvh_nodes, node_addr + 2);
   float4 node2 = kernel_tex_fetch(__bvh_nodes, node_addr + 3);
@@ -238,12 +238,13 @@ ccl_device_inline
 
               bool record_intersection = true;
 
-              /* Always use baked shadow transparency for curves. */
-              if (isect.type & PRIMITIVE_CURVE) {
-                *r_throughput *= intersection_curve_shadow_transparency(
-                    kg, isect.object, isect.prim, isect.u);
+              /* Use baked or constant shadow transparency when available. */
+              const float transparency = intersection_shadow_transparency(
+                  kg, isect.object, isect.prim, isect.type, isect.u);
+              if (transparency >= 0.0f) {
+                *r_throughput *= transparency;
 
-                if (*r_throughput < CURVE_SHADOW_TRANSPARENCY_CUTOFF) {
+                if (*r_throughput < SHADOW_TRANSPARENCY_CUTOFF) {
                   return true;
                 }
                 else {
@@ -136,7 +136,7 @@ ccl_device_inline int intersection_find_attribute(KernelGlobals kg,
 /* Transparent Shadows */
 
 /* Cut-off value to stop transparent shadow tracing when practically opaque. */
-#define CURVE_SHADOW_TRANSPARENCY_CUTOFF 0.001f
+#define SHADOW_TRANSPARENCY_CUTOFF 0.001f
 
 ccl_device_inline float intersection_curve_shadow_transparency(KernelGlobals kg,
                                                                const int object,
@@ -161,6 +161,22 @@ ccl_device_inline float intersection_curve_shadow_transparency(KernelGlobals kg,
   return (1.0f - u) * f0 + u * f1;
 }
 
+/* Shadow transparency that is known during traversal, baked for curves or constant for the
+ * shader. Negative when the intersection must be recorded for shader evaluation. */
+ccl_device_inline float intersection_shadow_transparency(KernelGlobals kg,
+                                                         const int object,
+                                                         const int prim,
+                                                         const int type,
+                                                         const float u)
+{
+  if (type & PRIMITIVE_CURVE) {
+    return intersection_curve_shadow_transparency(kg, object, prim, u);
+  }
+
+  const int shader = intersection_get_shader_from_isect_prim(kg, prim, type);
+  return kernel_tex_fetch(__shaders, shader).constant_shadow_transparency;
+}
+
 ccl_device_inline bool intersection_skip_self(ccl_private const RaySelfPrimitives &self,
                                               const int object,
                                               const int prim)
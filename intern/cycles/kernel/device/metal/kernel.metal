@@ -223,14 +223,16 @@ bool metalrt_shadow_all_hit(constant KernelParamsMetal &launch_params_metal,
     return false;
   }
   
-  /* Always use baked shadow transparency for curves. */
-  if (type & PRIMITIVE_CURVE) {
+  /* Use baked or constant shadow transparency when available. */
+  const float transparency = context.intersection_shadow_transparency(
+      nullptr, object, prim, type, u);
+  if (transparency >= 0.0f) {
     float throughput = payload.throughput;
-    throughput *= context.intersection_curve_shadow_transparency(nullptr, object, prim, u);
+    throughput *= transparency;
     payload.throughput = throughput;
     payload.num_hits += 1;
 
-    if (throughput < CURVE_SHADOW_TRANSPARENCY_CUTOFF) {
+    if (throughput < SHADOW_TRANSPARENCY_CUTOFF) {
       /* Accept result and terminate if throughput is sufficiently low */
       payload.result = true;
       return false;
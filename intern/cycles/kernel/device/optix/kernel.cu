@@ -234,14 +234,15 @@ extern "C" __global__ void __anyhit__kernel_optix_shadow_all_hit()
     return optixTerminateRay();
   }
 
-  /* Always use baked shadow transparency for curves. */
-  if (type & PRIMITIVE_CURVE) {
+  /* Use baked or constant shadow transparency when available. */
+  const float transparency = intersection_shadow_transparency(nullptr, object, prim, type, u);
+  if (transparency >= 0.0f) {
     float throughput = __uint_as_float(optixGetPayload_1());
-    throughput *= intersection_curve_shadow_transparency(nullptr, object, prim, u);
+    throughput *= transparency;
     optixSetPayload_1(__float_as_uint(throughput));
     optixSetPayload_2(uint16_pack_to_uint(num_recorded_hits, num_hits + 1));
 
-    if (throughput < CURVE_SHADOW_TRANSPARENCY_CUTOFF) {
+    if (throughput < SHADOW_TRANSPARENCY_CUTOFF) {
       optixSetPayload_5(true);
       return optixTerminateRay();
     }
@@ -103,7 +103,7 @@ ccl_device bool integrator_init_from_camera(KernelGlobals kg,
     INTEGRATOR_PATH_INIT(DEVICE_KERNEL_INTEGRATOR_INTERSECT_VOLUME_STACK);
   }
   else {
-    INTEGRATOR_PATH_INIT(DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST);
+    INTEGRATOR_PATH_INIT_INTERSECT_CLOSEST();
   }
 
   return true;
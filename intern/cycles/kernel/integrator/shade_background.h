@@ -66,7 +66,8 @@ ccl_device float3 integrator_eval_background_shader(KernelGlobals kg,
 
     /* multiple importance sampling, get background light pdf for ray
      * direction, and compute weight with respect to BSDF pdf */
-    const float pdf = background_light_pdf(kg, ray_P - ray_D * mis_ray_t, ray_D);
+    const float pdf = background_light_pdf(
+        kg, ray_P - ray_D * mis_ray_t, ray_D, INTEGRATOR_STATE(state, path, flag));
     const float mis_weight = light_sample_mis_weight_forward(kg, mis_ray_pdf, pdf);
     L *= mis_weight;
   }
@@ -121,12 +122,12 @@ ccl_device_inline void integrate_distant_lights(KernelGlobals kg,
 {
   const float3 ray_D = INTEGRATOR_STATE(state, ray, D);
   const float ray_time = INTEGRATOR_STATE(state, ray, time);
+  const uint32_t path_flag = INTEGRATOR_STATE(state, path, flag);
   LightSample ls ccl_optional_struct_init;
   for (int lamp = 0; lamp < kernel_data.integrator.num_all_lights; lamp++) {
-    if (light_sample_from_distant_ray(kg, ray_D, lamp, &ls)) {
+    if (light_sample_from_distant_ray(kg, ray_D, lamp, path_flag, &ls)) {
       /* Use visibility flag to skip lights. */
 #ifdef __PASSES__
-      const uint32_t path_flag = INTEGRATOR_STATE(state, path, flag);
 
       if (ls.shader & SHADER_EXCLUDE_ANY) {
         if (((ls.shader & SHADER_EXCLUDE_DIFFUSE) && (path_flag & PATH_RAY_DIFFUSE)) ||
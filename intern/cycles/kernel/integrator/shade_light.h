@@ -36,8 +36,11 @@ ccl_device_inline void integrate_light(KernelGlobals kg,
   isect.t += mis_ray_t;
   INTEGRATOR_STATE_WRITE(state, path, mis_ray_t) = isect.t;
 
+  const uint32_t path_flag = INTEGRATOR_STATE(state, path, flag);
+
   LightSample ls ccl_optional_struct_init;
-  const bool use_light_sample = light_sample_from_intersection(kg, &isect, ray_P, ray_D, &ls);
+  const bool use_light_sample = light_sample_from_intersection(
+      kg, &isect, ray_P, ray_D, path_flag, &ls);
 
   if (!use_light_sample) {
     return;
@@ -45,8 +48,6 @@ ccl_device_inline void integrate_light(KernelGlobals kg,
 
   /* Use visibility flag to skip lights. */
 #ifdef __PASSES__
-  const uint32_t path_flag = INTEGRATOR_STATE(state, path, flag);
-
   if (ls.shader & SHADER_EXCLUDE_ANY) {
     if (((ls.shader & SHADER_EXCLUDE_DIFFUSE) && (path_flag & PATH_RAY_DIFFUSE)) ||
         ((ls.shader & SHADER_EXCLUDE_GLOSSY) &&
@@ -103,8 +104,7 @@ ccl_device void integrator_shade_light(KernelGlobals kg,
     return;
   }
   else {
-    INTEGRATOR_PATH_NEXT(DEVICE_KERNEL_INTEGRATOR_SHADE_LIGHT,
-                         DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST);
+    INTEGRATOR_PATH_NEXT_INTERSECT_CLOSEST(DEVICE_KERNEL_INTEGRATOR_SHADE_LIGHT);
     return;
   }
 
@@ -79,7 +79,7 @@ ccl_device_forceinline void integrate_surface_emission(KernelGlobals kg,
 
     /* Multiple importance sampling, get triangle light pdf,
      * and compute weight with respect to BSDF pdf. */
-    float pdf = triangle_light_pdf(kg, sd, t);
+    float pdf = triangle_light_pdf(kg, sd, t, path_flag);
     float mis_weight = light_sample_mis_weight_forward(kg, bsdf_pdf, pdf);
     L *= mis_weight;
   }
@@ -110,8 +110,13 @@ ccl_device_forceinline void integrate_surface_direct_light(KernelGlobals kg,
     float light_u, light_v;
     path_state_rng_2D(kg, rng_state, PRNG_LIGHT_U, &light_u, &light_v);
 
-    if (!light_distribution_sample_from_position(
-            kg, light_u, light_v, sd->time, sd->P, bounce, path_flag, &ls)) {
+    const bool use_light_sample =
+        kernel_data.integrator.use_light_tree ?
+            light_tree_sample_from_position(
+                kg, light_u, light_v, sd->time, sd->P, bounce, path_flag, &ls) :
+            light_distribution_sample_from_position(
+                kg, light_u, light_v, sd->time, sd->P, bounce, path_flag, &ls);
+    if (!use_light_sample) {
       return;
     }
   }
@@ -541,7 +546,7 @@ ccl_device_forceinline void integrator_shade_surface(KernelGlobals kg,
     }
     else {
       kernel_assert(INTEGRATOR_STATE(state, ray, t) != 0.0f);
-      INTEGRATOR_PATH_NEXT(current_kernel, DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST);
+      INTEGRATOR_PATH_NEXT_INTERSECT_CLOSEST(current_kernel);
     }
   }
   else {
@@ -1025,8 +1025,7 @@ ccl_device void integrator_shade_volume(KernelGlobals kg,
 
   if (event == VOLUME_PATH_SCATTERED) {
     /* Queue intersect_closest kernel. */
-    INTEGRATOR_PATH_NEXT(DEVICE_KERNEL_INTEGRATOR_SHADE_VOLUME,
-                         DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST);
+    INTEGRATOR_PATH_NEXT_INTERSECT_CLOSEST(DEVICE_KERNEL_INTEGRATOR_SHADE_VOLUME);
     return;
   }
   else if (event == VOLUME_PATH_MISSED) {
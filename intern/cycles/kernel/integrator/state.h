@@ -35,6 +35,12 @@
 
 CCL_NAMESPACE_BEGIN
 
+/* Rays queued for the closest intersection kernel can be sorted by direction octant and by a hash
+ * of the grid cell containing their origin, so that rays traversing the same part of the BVH are
+ * intersected together. */
+#define INTEGRATOR_RAY_SORT_NUM_CELLS 64
+#define INTEGRATOR_RAY_SORT_NUM_KEYS (8 * INTEGRATOR_RAY_SORT_NUM_CELLS)
+
 /* Data structures */
 
 /* Integrator State
@@ -119,7 +125,8 @@ typedef struct IntegratorStateGPU {
   /* Count number of queued kernels. */
   ccl_global IntegratorQueueCounter *queue_counter;
 
-  /* Count number of kernels queued for specific shaders. */
+  /* Count number of kernels queued for specific shaders, or for ray sort keys in case of
+   * the closest intersection kernel. Null for kernels that don't sort paths. */
   ccl_global int *sort_key_counter[DEVICE_KERNEL_INTEGRATOR_NUM];
 
   /* Index of shadow path which will be used by a next shadow path.  */
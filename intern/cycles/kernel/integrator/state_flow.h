@@ -25,6 +25,10 @@ CCL_NAMESPACE_BEGIN
  * INTEGRATOR_PATH_NEXT(current_kernel, next_kernel)
  * INTEGRATOR_PATH_TERMINATE(current_kernel)
  *
+ * Paths continuing with the closest intersection kernel use
+ * INTEGRATOR_PATH_INIT_INTERSECT_CLOSEST() and INTEGRATOR_PATH_NEXT_INTERSECT_CLOSEST(), so that
+ * they can optionally be sorted by ray coherence.
+ *
  * For the shadow path similar functions are used, and again each shadow kernel must call
  * one of them, and only once.
  */
@@ -90,6 +94,26 @@ CCL_NAMESPACE_BEGIN
                                   1); \
     }
 
+/* Queue the path for the closest intersection kernel, sorted by ray coherence key when the host
+ * allocated counters for ray sorting. */
+#  define INTEGRATOR_PATH_INIT_INTERSECT_CLOSEST() \
+    if (kernel_integrator_state.sort_key_counter[DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST]) { \
+      INTEGRATOR_PATH_INIT_SORTED(DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST, \
+                                  integrator_state_ray_sort_key(kg, state)); \
+    } \
+    else { \
+      INTEGRATOR_PATH_INIT(DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST); \
+    }
+#  define INTEGRATOR_PATH_NEXT_INTERSECT_CLOSEST(current_kernel) \
+    if (kernel_integrator_state.sort_key_counter[DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST]) { \
+      INTEGRATOR_PATH_NEXT_SORTED(current_kernel, \
+                                  DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST, \
+                                  integrator_state_ray_sort_key(kg, state)); \
+    } \
+    else { \
+      INTEGRATOR_PATH_NEXT(current_kernel, DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST); \
+    }
+
 #else
 
 #  define INTEGRATOR_PATH_INIT(next_kernel) \
@@ -115,6 +139,10 @@ CCL_NAMESPACE_BEGIN
       (void)key; \
       (void)current_kernel; \
     }
+#  define INTEGRATOR_PATH_INIT_INTERSECT_CLOSEST() \
+    INTEGRATOR_PATH_INIT(DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST);
+#  define INTEGRATOR_PATH_NEXT_INTERSECT_CLOSEST(current_kernel) \
+    INTEGRATOR_PATH_NEXT(current_kernel, DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST);
 
 #  define INTEGRATOR_SHADOW_PATH_INIT(shadow_state, state, next_kernel, shadow_type) \
     IntegratorShadowState shadow_state = &state->shadow_type; \
@@ -7,6 +7,8 @@
 
 #include "kernel/util/differential.h"
 
+#include "util/hash.h"
+
 CCL_NAMESPACE_BEGIN
 
 /* Ray */
@@ -35,6 +37,27 @@ ccl_device_forceinline void integrator_state_read_ray(KernelGlobals kg,
   ray->dD = INTEGRATOR_STATE(state, ray, dD);
 }
 
+/* Coherence key of the ray, used to sort paths queued for the closest intersection kernel. Rays
+ * are binned by direction octant and by a hash of the grid cell containing their origin. */
+
+ccl_device_forceinline int integrator_state_ray_sort_key(KernelGlobals kg,
+                                                         ConstIntegratorState state)
+{
+  const float3 P = INTEGRATOR_STATE(state, ray, P) * kernel_data.integrator.ray_sort_inv_cell_size;
+  const float3 D = INTEGRATOR_STATE(state, ray, D);
+
+  /* Clamp in float before converting, rays may start far outside of the scene bounds. */
+  const float cell_limit = 1e6f;
+  const int cx = (int)clamp(floorf(P.x), -cell_limit, cell_limit);
+  const int cy = (int)clamp(floorf(P.y), -cell_limit, cell_limit);
+  const int cz = (int)clamp(floorf(P.z), -cell_limit, cell_limit);
+  const uint cell = hash_uint3((uint)cx, (uint)cy, (uint)cz) % INTEGRATOR_RAY_SORT_NUM_CELLS;
+
+  const uint octant = ((D.x < 0.0f) ? 1 : 0) | ((D.y < 0.0f) ? 2 : 0) | ((D.z < 0.0f) ? 4 : 0);
+
+  return (int)(octant * INTEGRATOR_RAY_SORT_NUM_CELLS + cell);
+}
+
 /* Shadow Ray */
 
 ccl_device_forceinline void integrator_state_write_shadow_ray(
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "kernel/light/common.h"
+#include "kernel/light/tree.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -392,7 +393,10 @@ ccl_device_inline float3 background_light_sample(
   return D;
 }
 
-ccl_device float background_light_pdf(KernelGlobals kg, float3 P, float3 direction)
+ccl_device float background_light_pdf(KernelGlobals kg,
+                                      float3 P,
+                                      float3 direction,
+                                      const uint32_t path_flag)
 {
   float portal_method_pdf = kernel_data.background.portal_weight;
   float sun_method_pdf = kernel_data.background.sun_weight;
@@ -416,7 +420,7 @@ ccl_device float background_light_pdf(KernelGlobals kg, float3 P, float3 directi
   float pdf_fac = (portal_method_pdf + sun_method_pdf + map_method_pdf);
   if (pdf_fac == 0.0f) {
     /* Use uniform as a fallback if we can't use any strategy. */
-    return kernel_data.integrator.pdf_lights / M_4PI_F;
+    return light_select_distant_pdf(kg, path_flag) / M_4PI_F;
   }
 
   pdf_fac = 1.0f / pdf_fac;
@@ -432,7 +436,7 @@ ccl_device float background_light_pdf(KernelGlobals kg, float3 P, float3 directi
     pdf += background_map_pdf(kg, direction) * map_method_pdf;
   }
 
-  return pdf * kernel_data.integrator.pdf_lights;
+  return pdf * light_select_distant_pdf(kg, path_flag);
 }
 
 #endif
@@ -220,8 +220,6 @@ ccl_device_inline bool light_sample(KernelGlobals kg,
     }
   }
 
-  ls->pdf *= kernel_data.integrator.pdf_lights;
-
   return in_volume_segment || (ls->pdf > 0.0f);
 }
 
@@ -345,6 +343,7 @@ ccl_device bool lights_intersect(KernelGlobals kg,
 ccl_device bool light_sample_from_distant_ray(KernelGlobals kg,
                                               const float3 ray_D,
                                               const int lamp,
+                                              const uint32_t path_flag,
                                               ccl_private LightSample *ccl_restrict ls)
 {
   ccl_global const KernelLight *klight = &kernel_tex_fetch(__lights, lamp);
@@ -409,7 +408,7 @@ ccl_device bool light_sample_from_distant_ray(KernelGlobals kg,
   float invarea = klight->distant.invarea;
   ls->pdf = invarea / (costheta * costheta * costheta);
   ls->eval_fac = ls->pdf;
-  ls->pdf *= kernel_data.integrator.pdf_lights;
+  ls->pdf *= light_select_distant_pdf(kg, path_flag);
 
   return true;
 }
@@ -418,6 +417,7 @@ ccl_device bool light_sample_from_intersection(KernelGlobals kg,
                                                ccl_private const Intersection *ccl_restrict isect,
                                                const float3 ray_P,
                                                const float3 ray_D,
+                                               const uint32_t path_flag,
                                                ccl_private LightSample *ccl_restrict ls)
 {
   const int lamp = isect->prim;
@@ -537,7 +537,7 @@ ccl_device bool light_sample_from_intersection(KernelGlobals kg,
     return false;
   }
 
-  ls->pdf *= kernel_data.integrator.pdf_lights;
+  ls->pdf *= light_select_lamp_pdf(kg, lamp, ray_P, path_flag);
 
   return true;
 }
@@ -574,24 +574,49 @@ ccl_device_inline bool triangle_world_space_vertices(
   return has_motion;
 }
 
-ccl_device_inline float triangle_light_pdf_area(KernelGlobals kg,
-                                                const float3 Ng,
-                                                const float3 I,
-                                                float t)
+/* Conversion from the area measure to solid angle, without the probability of choosing the
+ * triangle. */
+ccl_device_inline float triangle_light_pdf_area_sampling(const float3 Ng, const float3 I, float t)
 {
-  float pdf = kernel_data.integrator.pdf_triangles;
   float cos_pi = fabsf(dot(Ng, I));
 
   if (cos_pi == 0.0f)
     return 0.0f;
 
-  return t * t * pdf / cos_pi;
+  return t * t / cos_pi;
+}
+
+ccl_device_inline float triangle_light_pdf_area(KernelGlobals kg,
+                                                const float3 Ng,
+                                                const float3 I,
+                                                float t)
+{
+  return kernel_data.integrator.pdf_triangles * triangle_light_pdf_area_sampling(Ng, I, t);
 }
 
 ccl_device_forceinline float triangle_light_pdf(KernelGlobals kg,
                                                 ccl_private const ShaderData *sd,
-                                                float t)
+                                                float t,
+                                                const uint32_t path_flag)
 {
+  /* sd contains the point on the light source
+   * calculate Px, the point that we're shading */
+  const float3 Px = sd->P + sd->I * t;
+
+  /* Probability of the light tree choosing the triangle, the light distribution chooses
+   * triangles proportional to their area instead. */
+  float tree_pdf = 0.0f;
+  if (light_tree_use(kg, path_flag)) {
+    const int emitter = light_tree_triangle_emitter(kg, sd->object, sd->prim);
+    if (emitter == -1) {
+      return 0.0f;
+    }
+    tree_pdf = light_tree_pdf(kg, Px, emitter);
+    if (tree_pdf == 0.0f) {
+      return 0.0f;
+    }
+  }
+
   /* A naive heuristic to decide between costly solid angle sampling
    * and simple area sampling, comparing the distance to the triangle plane
    * to the length of the edges of the triangle. */
@@ -607,9 +632,6 @@ ccl_device_forceinline float triangle_light_pdf(KernelGlobals kg,
   const float distance_to_plane = fabsf(dot(N, sd->I * t)) / dot(N, N);
 
   if (longest_edge_squared > distance_to_plane * distance_to_plane) {
-    /* sd contains the point on the light source
-     * calculate Px, the point that we're shading */
-    const float3 Px = sd->P + sd->I * t;
     const float3 v0_p = V[0] - Px;
     const float3 v1_p = V[1] - Px;
     const float3 v2_p = V[2] - Px;
@@ -627,6 +649,9 @@ ccl_device_forceinline float triangle_light_pdf(KernelGlobals kg,
     if (UNLIKELY(solid_angle == 0.0f)) {
       return 0.0f;
     }
+    else if (tree_pdf != 0.0f) {
+      return tree_pdf / solid_angle;
+    }
     else {
       float area = 1.0f;
       if (has_motion) {
@@ -641,6 +666,13 @@ ccl_device_forceinline float triangle_light_pdf(KernelGlobals kg,
       return pdf / solid_angle;
     }
   }
+  else if (tree_pdf != 0.0f) {
+    const float area = 0.5f * len(N);
+    if (UNLIKELY(area == 0.0f)) {
+      return 0.0f;
+    }
+    return tree_pdf * triangle_light_pdf_area_sampling(sd->Ng, sd->I, t) / area;
+  }
   else {
     float pdf = triangle_light_pdf_area(kg, sd->Ng, sd->I, t);
     if (has_motion) {
@@ -659,6 +691,8 @@ ccl_device_forceinline float triangle_light_pdf(KernelGlobals kg,
   }
 }
 
+/* The probability of having chosen the triangle is given by `tree_pdf` when it was chosen by the
+ * light tree, or zero when it was chosen from the light distribution. */
 template<bool in_volume_segment>
 ccl_device_forceinline void triangle_light_sample(KernelGlobals kg,
                                                   int prim,
@@ -667,7 +701,8 @@ ccl_device_forceinline void triangle_light_sample(KernelGlobals kg,
                                                   float randv,
                                                   float time,
                                                   ccl_private LightSample *ls,
-                                                  const float3 P)
+                                                  const float3 P,
+                                                  const float tree_pdf)
 {
   /* A naive heuristic to decide between costly solid angle sampling
    * and simple area sampling, comparing the distance to the triangle plane
@@ -773,6 +808,9 @@ ccl_device_forceinline void triangle_light_sample(KernelGlobals kg,
       ls->pdf = 0.0f;
       return;
     }
+    else if (tree_pdf != 0.0f) {
+      ls->pdf = tree_pdf / solid_angle;
+    }
     else {
       if (has_motion) {
         /* get the center frame vertices, this is what the PDF was calculated from */
@@ -801,8 +839,15 @@ ccl_device_forceinline void triangle_light_sample(KernelGlobals kg,
     ls->P = u * V[0] + v * V[1] + t * V[2];
     /* compute incoming direction, distance and pdf */
     ls->D = normalize_len(ls->P - P, &ls->t);
-    ls->pdf = triangle_light_pdf_area(kg, ls->Ng, -ls->D, ls->t);
-    if (has_motion && area != 0.0f) {
+    if (tree_pdf != 0.0f) {
+      ls->pdf = (area != 0.0f) ?
+                    tree_pdf * triangle_light_pdf_area_sampling(ls->Ng, -ls->D, ls->t) / area :
+                    0.0f;
+    }
+    else {
+      ls->pdf = triangle_light_pdf_area(kg, ls->Ng, -ls->D, ls->t);
+    }
+    if (tree_pdf == 0.0f && has_motion && area != 0.0f) {
       /* scale the PDF.
        * area = the area the sample was taken from
        * area_pre = the are from which pdf_triangles was calculated from */
@@ -860,18 +905,21 @@ ccl_device_inline bool light_select_reached_max_bounces(KernelGlobals kg, int in
   return (bounce > kernel_tex_fetch(__lights, index).max_bounces);
 }
 
+/* Sample a position on the emitter at the given index of the light distribution. The probability
+ * of having chosen the emitter is given by `tree_pdf` when it was chosen by the light tree, or
+ * zero when it was chosen from the light distribution. */
 template<bool in_volume_segment>
-ccl_device_noinline bool light_distribution_sample(KernelGlobals kg,
-                                                   float randu,
-                                                   const float randv,
-                                                   const float time,
-                                                   const float3 P,
-                                                   const int bounce,
-                                                   const uint32_t path_flag,
-                                                   ccl_private LightSample *ls)
+ccl_device_forceinline bool light_emitter_sample(KernelGlobals kg,
+                                                 const int index,
+                                                 const float randu,
+                                                 const float randv,
+                                                 const float time,
+                                                 const float3 P,
+                                                 const int bounce,
+                                                 const uint32_t path_flag,
+                                                 const float tree_pdf,
+                                                 ccl_private LightSample *ls)
 {
-  /* Sample light index from distribution. */
-  const int index = light_distribution_sample(kg, &randu);
   ccl_global const KernelLightDistribution *kdistribution = &kernel_tex_fetch(__light_distribution,
                                                                               index);
   const int prim = kdistribution->prim;
@@ -887,7 +935,8 @@ ccl_device_noinline bool light_distribution_sample(KernelGlobals kg,
     }
 
     const int shader_flag = kdistribution->mesh_light.shader_flag;
-    triangle_light_sample<in_volume_segment>(kg, prim, object, randu, randv, time, ls, P);
+    triangle_light_sample<in_volume_segment>(
+        kg, prim, object, randu, randv, time, ls, P, tree_pdf);
     ls->shader |= shader_flag;
     return (ls->pdf > 0.0f);
   }
@@ -898,7 +947,28 @@ ccl_device_noinline bool light_distribution_sample(KernelGlobals kg,
     return false;
   }
 
-  return light_sample<in_volume_segment>(kg, lamp, randu, randv, P, path_flag, ls);
+  if (!light_sample<in_volume_segment>(kg, lamp, randu, randv, P, path_flag, ls)) {
+    return false;
+  }
+
+  ls->pdf *= (tree_pdf != 0.0f) ? tree_pdf : kernel_data.integrator.pdf_lights;
+  return true;
+}
+
+template<bool in_volume_segment>
+ccl_device_noinline bool light_distribution_sample(KernelGlobals kg,
+                                                   float randu,
+                                                   const float randv,
+                                                   const float time,
+                                                   const float3 P,
+                                                   const int bounce,
+                                                   const uint32_t path_flag,
+                                                   ccl_private LightSample *ls)
+{
+  /* Sample light index from distribution. */
+  const int index = light_distribution_sample(kg, &randu);
+  return light_emitter_sample<in_volume_segment>(
+      kg, index, randu, randv, time, P, bounce, path_flag, 0.0f, ls);
 }
 
 ccl_device_inline bool light_distribution_sample_from_volume_segment(KernelGlobals kg,
@@ -925,6 +995,26 @@ ccl_device_inline bool light_distribution_sample_from_position(KernelGlobals kg,
   return light_distribution_sample<false>(kg, randu, randv, time, P, bounce, path_flag, ls);
 }
 
+ccl_device_noinline bool light_tree_sample_from_position(KernelGlobals kg,
+                                                        float randu,
+                                                        const float randv,
+                                                        const float time,
+                                                        const float3 P,
+                                                        const int bounce,
+                                                        const uint32_t path_flag,
+                                                        ccl_private LightSample *ls)
+{
+  /* Choose the emitter with the light tree. */
+  float tree_pdf;
+  const int index = light_tree_sample(kg, P, &randu, &tree_pdf);
+  if (index == -1) {
+    return false;
+  }
+
+  return light_emitter_sample<false>(
+      kg, index, randu, randv, time, P, bounce, path_flag, tree_pdf, ls);
+}
+
 ccl_device_inline bool light_distribution_sample_new_position(KernelGlobals kg,
                                                               const float randu,
                                                               const float randv,
@@ -934,11 +1024,15 @@ ccl_device_inline bool light_distribution_sample_new_position(KernelGlobals kg,
 {
   /* Sample a new position on the same light, for volume sampling. */
   if (ls->type == LIGHT_TRIANGLE) {
-    triangle_light_sample<false>(kg, ls->prim, ls->object, randu, randv, time, ls, P);
+    triangle_light_sample<false>(kg, ls->prim, ls->object, randu, randv, time, ls, P, 0.0f);
     return (ls->pdf > 0.0f);
   }
   else {
-    return light_sample<false>(kg, ls->lamp, randu, randv, P, 0, ls);
+    if (!light_sample<false>(kg, ls->lamp, randu, randv, P, 0, ls)) {
+      return false;
+    }
+    ls->pdf *= kernel_data.integrator.pdf_lights;
+    return true;
   }
 }
 
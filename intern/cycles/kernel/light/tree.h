@@ -0,0 +1,300 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright 2011-2022 Blender Foundation */
+
+#pragma once
+
+CCL_NAMESPACE_BEGIN
+
+/* Light Tree
+ *
+ * Hierarchical importance sampling of many lights, based on "Importance Sampling of Many
+ * Lights with Adaptive Tree Splitting" by Alejandro Conty Estevez and Christopher Kulla.
+ *
+ * Local emitters (lamps with a position and emissive triangles) are stored in a tree, where every
+ * node bounds its emitters by a box, a cone of emission directions and their total energy. The
+ * tree is traversed from the root, choosing a child proportional to its importance as seen from
+ * the shading point. Distant lamps and the background are kept out of the tree and are chosen
+ * uniformly with a fixed probability.
+ *
+ * Only the emitter side of the importance is used, so the probability of choosing an emitter
+ * only depends on the shading position. This keeps the PDF cheap to evaluate again for MIS when
+ * an emitter is hit by an indirect ray. */
+
+ccl_device_inline bool light_tree_use(KernelGlobals kg, const uint32_t path_flag)
+{
+  /* Volume scattering always uses the light distribution, since the light is chosen for a ray
+   * segment there rather than for a single position. */
+  return kernel_data.integrator.use_light_tree && !(path_flag & PATH_RAY_VOLUME_SCATTER);
+}
+
+ccl_device float light_tree_importance(const float3 P,
+                                       const float3 centroid,
+                                       const float radius,
+                                       const float3 axis,
+                                       const float theta_o,
+                                       const float theta_e,
+                                       const float energy)
+{
+  if (energy == 0.0f) {
+    return 0.0f;
+  }
+
+  float distance;
+  const float3 point_to_centroid = safe_normalize_len(centroid - P, &distance);
+
+  float cos_theta_prime = 1.0f;
+  if (theta_o + theta_e < M_PI_F && distance > radius) {
+    /* Smallest angle between the emission cone and the direction towards the shading point,
+     * accounting for the extent of the bounding sphere as seen from the shading point. */
+    const float theta = fast_acosf(clamp(dot(axis, -point_to_centroid), -1.0f, 1.0f));
+    const float theta_u = fast_asinf(radius / distance);
+    const float theta_prime = max(theta - theta_o - theta_u, 0.0f);
+    if (theta_prime >= theta_e) {
+      return 0.0f;
+    }
+    cos_theta_prime = fast_cosf(theta_prime);
+  }
+
+  /* Clamp the distance to the size of the bounds, to avoid the singularity when the shading
+   * point is close to or inside them. */
+  const float distance_sq = max(sqr(distance), 0.25f * sqr(radius));
+  return energy * cos_theta_prime / distance_sq;
+}
+
+ccl_device float light_tree_node_importance(KernelGlobals kg, const float3 P, const int index)
+{
+  ccl_global const KernelLightTreeNode *knode = &kernel_tex_fetch(__light_tree_nodes, index);
+  const float3 bbox_min = make_float3(knode->bbox_min[0], knode->bbox_min[1], knode->bbox_min[2]);
+  const float3 bbox_max = make_float3(knode->bbox_max[0], knode->bbox_max[1], knode->bbox_max[2]);
+  const float3 axis = make_float3(knode->axis[0], knode->axis[1], knode->axis[2]);
+
+  return light_tree_importance(P,
+                               0.5f * (bbox_min + bbox_max),
+                               0.5f * len(bbox_max - bbox_min),
+                               axis,
+                               knode->theta_o,
+                               knode->theta_e,
+                               knode->energy);
+}
+
+ccl_device float light_tree_emitter_importance(KernelGlobals kg, const float3 P, const int index)
+{
+  ccl_global const KernelLightTreeEmitter *kemitter = &kernel_tex_fetch(__light_tree_emitters,
+                                                                        index);
+  const float3 centroid = make_float3(
+      kemitter->centroid[0], kemitter->centroid[1], kemitter->centroid[2]);
+  const float3 axis = make_float3(kemitter->axis[0], kemitter->axis[1], kemitter->axis[2]);
+
+  return light_tree_importance(
+      P, centroid, kemitter->radius, axis, kemitter->theta_o, kemitter->theta_e, kemitter->energy);
+}
+
+/* Choose an emitter of a leaf node proportional to its importance. The random number is rescaled
+ * so it can be reused for sampling a position on the emitter. */
+ccl_device int light_tree_leaf_sample(KernelGlobals kg,
+                                      const float3 P,
+                                      const int node_index,
+                                      ccl_private float *randu,
+                                      ccl_private float *pdf)
+{
+  ccl_global const KernelLightTreeNode *knode = &kernel_tex_fetch(__light_tree_nodes, node_index);
+  const int first_emitter = knode->child_index;
+  const int num_emitters = knode->num_emitters;
+
+  float total_importance = 0.0f;
+  for (int i = 0; i < num_emitters; i++) {
+    total_importance += light_tree_emitter_importance(kg, P, first_emitter + i);
+  }
+  if (total_importance == 0.0f) {
+    return -1;
+  }
+
+  const float r = *randu * total_importance;
+  float cdf = 0.0f;
+  int selected = -1;
+  float selected_importance = 0.0f;
+  float selected_cdf = 0.0f;
+
+  for (int i = 0; i < num_emitters; i++) {
+    const float importance = light_tree_emitter_importance(kg, P, first_emitter + i);
+    if (importance == 0.0f) {
+      continue;
+    }
+
+    selected = first_emitter + i;
+    selected_importance = importance;
+    selected_cdf = cdf;
+
+    cdf += importance;
+    if (r < cdf) {
+      break;
+    }
+  }
+
+  *randu = saturatef((r - selected_cdf) / selected_importance);
+  *pdf *= selected_importance / total_importance;
+  return selected;
+}
+
+/* Choose an emitter from the shading point, returns its index in the light distribution or -1
+ * when no emitter contributes. */
+ccl_device int light_tree_sample(KernelGlobals kg,
+                                 const float3 P,
+                                 ccl_private float *randu,
+                                 ccl_private float *pdf)
+{
+  const int num_distant = kernel_data.integrator.num_light_tree_distant;
+  const float distant_pdf = kernel_data.integrator.light_tree_distant_pdf;
+
+  *pdf = 1.0f;
+
+  if (num_distant > 0) {
+    if (*randu < distant_pdf) {
+      const float u = (*randu / distant_pdf) * num_distant;
+      const int distant = min((int)u, num_distant - 1);
+      *randu = saturatef(u - distant);
+      *pdf = distant_pdf / num_distant;
+
+      const int index = kernel_data.integrator.num_light_tree_local + distant;
+      return kernel_tex_fetch(__light_tree_emitters, index).distribution_id;
+    }
+
+    *randu = (*randu - distant_pdf) / (1.0f - distant_pdf);
+    *pdf = 1.0f - distant_pdf;
+  }
+
+  int node_index = 0;
+  while (kernel_tex_fetch(__light_tree_nodes, node_index).num_emitters == 0) {
+    const int left_index = node_index + 1;
+    const int right_index = kernel_tex_fetch(__light_tree_nodes, node_index).child_index;
+
+    const float left_importance = light_tree_node_importance(kg, P, left_index);
+    const float right_importance = light_tree_node_importance(kg, P, right_index);
+    const float total_importance = left_importance + right_importance;
+    if (total_importance == 0.0f) {
+      return -1;
+    }
+
+    const float left_probability = left_importance / total_importance;
+    if (right_importance == 0.0f || (left_importance != 0.0f && *randu < left_probability)) {
+      node_index = left_index;
+      *randu = saturatef(*randu / left_probability);
+      *pdf *= left_probability;
+    }
+    else {
+      const float right_probability = 1.0f - left_probability;
+      node_index = right_index;
+      *randu = saturatef((*randu - left_probability) / right_probability);
+      *pdf *= right_probability;
+    }
+  }
+
+  const int emitter = light_tree_leaf_sample(kg, P, node_index, randu, pdf);
+  if (emitter == -1) {
+    return -1;
+  }
+
+  return kernel_tex_fetch(__light_tree_emitters, emitter).distribution_id;
+}
+
+/* Probability of `light_tree_sample()` choosing the given emitter from the shading point. */
+ccl_device float light_tree_pdf(KernelGlobals kg, const float3 P, const int emitter)
+{
+  const int num_local = kernel_data.integrator.num_light_tree_local;
+  const int num_distant = kernel_data.integrator.num_light_tree_distant;
+  const float distant_pdf = kernel_data.integrator.light_tree_distant_pdf;
+
+  if (emitter >= num_local) {
+    return distant_pdf / num_distant;
+  }
+
+  ccl_global const KernelLightTreeEmitter *kemitter = &kernel_tex_fetch(__light_tree_emitters,
+                                                                        emitter);
+  const int leaf_index = kemitter->leaf_index;
+  uint bit_trail = kemitter->bit_trail;
+
+  float pdf = (num_distant > 0) ? 1.0f - distant_pdf : 1.0f;
+
+  int node_index = 0;
+  while (node_index != leaf_index) {
+    const int left_index = node_index + 1;
+    const int right_index = kernel_tex_fetch(__light_tree_nodes, node_index).child_index;
+
+    const float left_importance = light_tree_node_importance(kg, P, left_index);
+    const float right_importance = light_tree_node_importance(kg, P, right_index);
+    const float total_importance = left_importance + right_importance;
+    if (total_importance == 0.0f) {
+      return 0.0f;
+    }
+
+    if (bit_trail & 1) {
+      node_index = right_index;
+      pdf *= right_importance / total_importance;
+    }
+    else {
+      node_index = left_index;
+      pdf *= left_importance / total_importance;
+    }
+    bit_trail >>= 1;
+  }
+
+  ccl_global const KernelLightTreeNode *kleaf = &kernel_tex_fetch(__light_tree_nodes,
+                                                                  leaf_index);
+  float total_importance = 0.0f;
+  for (int i = 0; i < kleaf->num_emitters; i++) {
+    total_importance += light_tree_emitter_importance(kg, P, kleaf->child_index + i);
+  }
+  if (total_importance == 0.0f) {
+    return 0.0f;
+  }
+
+  return pdf * light_tree_emitter_importance(kg, P, emitter) / total_importance;
+}
+
+/* Emitter of a lamp or triangle, -1 if it is not part of the light tree. The lookup table starts
+ * with the emitter of every lamp, followed by the offset of the triangle table of every object.
+ * A triangle table starts with the primitive offset of the mesh. */
+
+ccl_device_inline int light_tree_lamp_emitter(KernelGlobals kg, const int lamp)
+{
+  return kernel_tex_fetch(__light_tree_emitter_index, lamp);
+}
+
+ccl_device_inline int light_tree_triangle_emitter(KernelGlobals kg,
+                                                  const int object,
+                                                  const int prim)
+{
+  const int offset = kernel_tex_fetch(__light_tree_emitter_index,
+                                      kernel_data.integrator.num_all_lights + object);
+  if (offset == -1) {
+    return -1;
+  }
+
+  const int prim_offset = kernel_tex_fetch(__light_tree_emitter_index, offset);
+  return kernel_tex_fetch(__light_tree_emitter_index, offset + 1 + prim - prim_offset);
+}
+
+/* Probability of choosing a distant lamp or the background. */
+ccl_device_inline float light_select_distant_pdf(KernelGlobals kg, const uint32_t path_flag)
+{
+  if (light_tree_use(kg, path_flag)) {
+    return kernel_data.integrator.light_tree_distant_pdf /
+           kernel_data.integrator.num_light_tree_distant;
+  }
+  return kernel_data.integrator.pdf_lights;
+}
+
+/* Probability of choosing a lamp from the shading point. */
+ccl_device_inline float light_select_lamp_pdf(KernelGlobals kg,
+                                              const int lamp,
+                                              const float3 P,
+                                              const uint32_t path_flag)
+{
+  if (light_tree_use(kg, path_flag)) {
+    const int emitter = light_tree_lamp_emitter(kg, lamp);
+    return (emitter != -1) ? light_tree_pdf(kg, P, emitter) : 0.0f;
+  }
+  return kernel_data.integrator.pdf_lights;
+}
+
+CCL_NAMESPACE_END
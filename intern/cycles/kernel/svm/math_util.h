@@ -189,6 +189,49 @@ ccl_device float svm_math(NodeMathType type, float a, float b, float c)
   }
 }
 
+ccl_device_inline float smootherstep(float edge0, float edge1, float x)
+{
+  x = clamp(safe_divide((x - edge0), (edge1 - edge0)), 0.0f, 1.0f);
+  return x * x * x * (x * (x * 6.0f - 15.0f) + 10.0f);
+}
+
+ccl_device float svm_map_range(NodeMapRangeType type,
+                               float value,
+                               float from_min,
+                               float from_max,
+                               float to_min,
+                               float to_max,
+                               float steps)
+{
+  if (from_max == from_min) {
+    return 0.0f;
+  }
+
+  float factor = value;
+  switch (type) {
+    default:
+    case NODE_MAP_RANGE_LINEAR:
+      factor = (value - from_min) / (from_max - from_min);
+      break;
+    case NODE_MAP_RANGE_STEPPED: {
+      factor = (value - from_min) / (from_max - from_min);
+      factor = (steps > 0.0f) ? floorf(factor * (steps + 1.0f)) / steps : 0.0f;
+      break;
+    }
+    case NODE_MAP_RANGE_SMOOTHSTEP: {
+      factor = (from_min > from_max) ? 1.0f - smoothstep(from_max, from_min, factor) :
+                                       smoothstep(from_min, from_max, factor);
+      break;
+    }
+    case NODE_MAP_RANGE_SMOOTHERSTEP: {
+      factor = (from_min > from_max) ? 1.0f - smootherstep(from_max, from_min, factor) :
+                                       smootherstep(from_min, from_max, factor);
+      break;
+    }
+  }
+  return to_min + factor * (to_max - to_min);
+}
+
 ccl_device float3 svm_math_blackbody_color(float t)
 {
   /* TODO(lukas): Reimplement in XYZ. */
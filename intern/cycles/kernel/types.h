@@ -1218,8 +1218,15 @@ typedef struct KernelIntegrator {
   /* MIS debugging. */
   int direct_light_sampling_type;
 
-  /* padding */
-  int pad1, pad2;
+  /* Ray sorting for the closest intersection kernel. */
+  int use_ray_sorting;
+  float ray_sort_inv_cell_size;
+
+  /* Light tree. */
+  int use_light_tree;
+  int num_light_tree_local;
+  int num_light_tree_distant;
+  float light_tree_distant_pdf;
 } KernelIntegrator;
 static_assert_align(KernelIntegrator, 16);
 
@@ -1410,6 +1417,42 @@ typedef struct KernelLightDistribution {
 } KernelLightDistribution;
 static_assert_align(KernelLightDistribution, 16);
 
+/* Light tree node, bounding the emitters below it by position, orientation and energy. Inner
+ * nodes have their first child directly after them and store the index of the second one, leaf
+ * nodes store the range of emitters in the emitters array. */
+typedef struct KernelLightTreeNode {
+  float bbox_min[3];
+  float energy;
+  float bbox_max[3];
+  /* Bounding cone of the emission directions. */
+  float theta_o;
+  float axis[3];
+  float theta_e;
+  /* Second child for inner nodes, first emitter for leaf nodes. */
+  int child_index;
+  /* Zero for inner nodes. */
+  int num_emitters;
+  int pad1, pad2;
+} KernelLightTreeNode;
+static_assert_align(KernelLightTreeNode, 16);
+
+typedef struct KernelLightTreeEmitter {
+  float centroid[3];
+  float energy;
+  float axis[3];
+  float theta_o;
+  float theta_e;
+  float radius;
+  /* Index into the light distribution. */
+  int distribution_id;
+  /* Leaf node containing the emitter, and the path to it from the root: bit i is set when the
+   * second child is taken at depth i. */
+  int leaf_index;
+  uint bit_trail;
+  int pad1, pad2, pad3;
+} KernelLightTreeEmitter;
+static_assert_align(KernelLightTreeEmitter, 16);
+
 typedef struct KernelParticle {
   int index;
   float age;
@@ -1429,7 +1472,9 @@ typedef struct KernelShader {
   float cryptomatte_id;
   int flags;
   int pass_id;
-  int pad2, pad3;
+  /* Shadow transparency when it does not depend on the shading point, negative otherwise. */
+  float constant_shadow_transparency;
+  int pad3;
 } KernelShader;
 static_assert_align(KernelShader, 16);
 
@@ -474,6 +474,8 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
   data.num_samples = schema.getNumSamples();
   data.shader_face_sets = parse_face_sets_for_shader_assignment(schema, get_used_shaders());
 
+  data_is_animated = data.num_samples > 1;
+
   read_geometry_data(proc, cached_data, data, progress);
 
   if (progress.get_cancel()) {
@@ -516,7 +518,9 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
     data.velocities = schema.getVelocitiesProperty();
     data.shader_face_sets = parse_face_sets_for_shader_assignment(schema, get_used_shaders());
 
-    read_geometry_data(proc, cached_data, data, progress);
+    data_is_animated = data.num_samples > 1;
+
+  read_geometry_data(proc, cached_data, data, progress);
 
     if (progress.get_cancel()) {
       return;
@@ -552,6 +556,8 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
   data.velocities = schema.getVelocitiesProperty();
   data.shader_face_sets = parse_face_sets_for_shader_assignment(schema, get_used_shaders());
 
+  data_is_animated = data.num_samples > 1;
+
   read_geometry_data(proc, cached_data, data, progress);
 
   if (progress.get_cancel()) {
@@ -594,6 +600,8 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
   data.default_radius = proc->get_default_radius();
   data.radius_scale = get_radius_scale();
 
+  data_is_animated = data.num_samples > 1;
+
   read_geometry_data(proc, cached_data, data, progress);
 
   if (progress.get_cancel()) {
@@ -881,6 +889,18 @@ void AlembicProcedural::generate(Scene *scene, Progress &progress)
     }
   }
 
+  /* Without prefetching only the samples around the current frame are loaded, so animated data
+   * has to be read again when the frame changes. Constant objects keep their cache. */
+  const bool reload_animated_data = !use_prefetch && frame_is_modified();
+  if (reload_animated_data) {
+    for (Node *node : objects) {
+      AlembicObject *object = static_cast<AlembicObject *>(node);
+      if (object->data_is_animated) {
+        object->clear_cache();
+      }
+    }
+  }
+
   if (prefetch_cache_size_is_modified()) {
     /* Check whether the current memory usage fits in the new requested size,
      * abort the render if it is any higher. */
@@ -907,7 +927,7 @@ void AlembicProcedural::generate(Scene *scene, Progress &progress)
 
     /* skip constant objects */
     if (object->is_constant() && !object->is_modified() && !object->need_shader_update &&
-        !scale_is_modified()) {
+        !scale_is_modified() && !(reload_animated_data && object->data_is_animated)) {
       continue;
     }
 
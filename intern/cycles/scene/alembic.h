@@ -435,12 +435,17 @@ class AlembicObject : public Node {
   void clear_cache()
   {
     cached_data_.clear();
+    data_loaded = false;
   }
 
   Object *object = nullptr;
 
   bool data_loaded = false;
 
+  /* Set if the schema has more than one sample. Without prefetching the cache only holds the
+   * samples for the current frame, so it is not enough to check whether the cache is constant. */
+  bool data_is_animated = false;
+
   CachedData cached_data_;
 
   void setup_transform_cache(CachedData &cached_data, float scale);
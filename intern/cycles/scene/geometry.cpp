@@ -224,6 +224,7 @@ void Geometry::compute_bvh(
       BVHParams bparams;
       bparams.use_spatial_split = params->use_bvh_spatial_split;
       bparams.use_compact_structure = params->use_bvh_compact_structure;
+      bparams.use_compressed_nodes = params->use_bvh_compressed_nodes;
       bparams.bvh_layout = bvh_layout;
       bparams.use_unaligned_nodes = dscene->data.bvh.have_curves &&
                                     params->use_bvh_unaligned_nodes;
@@ -1260,6 +1261,7 @@ void GeometryManager::device_update_mesh(Device *,
 void GeometryManager::device_update_bvh(Device *device,
                                         DeviceScene *dscene,
                                         Scene *scene,
+                                        const bool geometry_topology_changed,
                                         Progress &progress)
 {
   /* bvh build */
@@ -1272,6 +1274,7 @@ void GeometryManager::device_update_bvh(Device *device,
   bparams.use_spatial_split = scene->params.use_bvh_spatial_split;
   bparams.use_unaligned_nodes = dscene->data.bvh.have_curves &&
                                 scene->params.use_bvh_unaligned_nodes;
+  bparams.use_compressed_nodes = scene->params.use_bvh_compressed_nodes;
   bparams.num_motion_triangle_steps = scene->params.num_bvh_time_steps;
   bparams.num_motion_curve_steps = scene->params.num_bvh_time_steps;
   bparams.num_motion_point_steps = scene->params.num_bvh_time_steps;
@@ -1280,9 +1283,15 @@ void GeometryManager::device_update_bvh(Device *device,
 
   VLOG(1) << "Using " << bvh_layout_name(bparams.bvh_layout) << " layout.";
 
+  /* Embree can update the transforms of instances and the vertices of objects in the top level
+   * scene in place, but the device falls back to a full build when objects changed from or to
+   * being instanced. This avoids recreating the whole top level scene when only object
+   * transforms are animated. */
   const bool can_refit = scene->bvh != nullptr &&
                          (bparams.bvh_layout == BVHLayout::BVH_LAYOUT_OPTIX ||
-                          bparams.bvh_layout == BVHLayout::BVH_LAYOUT_METAL);
+                          bparams.bvh_layout == BVHLayout::BVH_LAYOUT_METAL ||
+                          (bparams.bvh_layout == BVHLayout::BVH_LAYOUT_EMBREE &&
+                           !geometry_topology_changed));
 
   BVH *bvh = scene->bvh;
   if (!scene->bvh) {
@@ -2006,6 +2015,8 @@ void GeometryManager::device_update(Device *device,
    * change. */
   bool need_update_scene_bvh = (scene->bvh == nullptr ||
                                 (update_flags & (TRANSFORM_MODIFIED | VISIBILITY_MODIFIED)) != 0);
+  /* Compute before the object BVHs are built, which clears the rebuild tag of the geometry. */
+  bool geometry_topology_changed = false;
   {
     scoped_callback_timer timer([scene](double time) {
       if (scene->update_stats) {
@@ -2018,6 +2029,7 @@ void GeometryManager::device_update(Device *device,
     foreach (Geometry *geom, scene->geometry) {
       if (geom->is_modified() || geom->need_update_bvh_for_offset) {
         need_update_scene_bvh = true;
+        geometry_topology_changed |= geom->need_update_rebuild;
         pool.push(function_bind(
             &Geometry::compute_bvh, geom, device, dscene, &scene->params, &progress, i, num_bvh));
         if (geom->need_build_bvh(bvh_layout)) {
@@ -2062,7 +2074,7 @@ void GeometryManager::device_update(Device *device,
         scene->update_stats->geometry.times.add_entry({"device_update (build scene BVH)", time});
       }
     });
-    device_update_bvh(device, dscene, scene, progress);
+    device_update_bvh(device, dscene, scene, geometry_topology_changed, progress);
     if (progress.get_cancel()) {
       return;
     }
@@ -240,7 +240,13 @@ class GeometryManager {
                                 Scene *scene,
                                 Progress &progress);
 
-  void device_update_bvh(Device *device, DeviceScene *dscene, Scene *scene, Progress &progress);
+  /* Build or update the scene BVH. When no geometry in the scene had its topology changed, a
+   * BVH layout which supports it refits the scene BVH instead of rebuilding it. */
+  void device_update_bvh(Device *device,
+                         DeviceScene *dscene,
+                         Scene *scene,
+                         const bool geometry_topology_changed,
+                         Progress &progress);
 
   void device_update_displacement_images(Device *device, Scene *scene, Progress &progress);
 
@@ -266,6 +266,11 @@ ustring ImageLoader::osl_filepath() const
   return ustring();
 }
 
+bool ImageLoader::load_metadata_reduced(ImageMetaData & /*metadata*/, const size_t /*max_size*/)
+{
+  return false;
+}
+
 bool ImageLoader::equals(const ImageLoader *a, const ImageLoader *b)
 {
   if (a == NULL && b == NULL) {
@@ -486,10 +491,21 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   }
 
   /* Get metadata. */
-  int width = img->metadata.width;
-  int height = img->metadata.height;
-  int depth = img->metadata.depth;
-  int components = img->metadata.channels;
+  ImageMetaData metadata = img->metadata;
+  const size_t full_size = max(max(metadata.width, metadata.height), metadata.depth);
+  if (texture_limit > 0 && full_size > texture_limit) {
+    /* Read a lower resolution version from the file if there is one, any remaining difference
+     * to the limit is handled by scaling down below. */
+    if (img->loader->load_metadata_reduced(metadata, texture_limit)) {
+      VLOG(1) << "Using " << metadata.width << "x" << metadata.height
+              << " resolution stored in image " << img->loader->name() << ".";
+    }
+  }
+
+  int width = metadata.width;
+  int height = metadata.height;
+  int depth = metadata.depth;
+  int components = metadata.channels;
 
   /* Read pixels. */
   vector<StorageType> pixels_storage;
@@ -516,8 +532,7 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   }
 
   const size_t num_pixels = ((size_t)width) * height * depth;
-  img->loader->load_pixels(
-      img->metadata, pixels, num_pixels * components, image_associate_alpha(img));
+  img->loader->load_pixels(metadata, pixels, num_pixels * components, image_associate_alpha(img));
 
   /* The kernel can handle 1 and 4 channel images. Anything that is not a single
    * channel image is converted to RGBA format. */
@@ -106,6 +106,12 @@ class ImageLoader {
                            const size_t pixels_size,
                            const bool associate_alpha) = 0;
 
+  /* Optional: reduce the resolution in the metadata to that of a lower resolution version
+   * stored in the file, like a MIP level of a .tx file, with no dimension larger than max_size if
+   * available. load_pixels() then reads that version, which avoids loading and scaling down the
+   * full resolution image. Returns false if the file has no lower resolution versions. */
+  virtual bool load_metadata_reduced(ImageMetaData &metadata, const size_t max_size);
+
   /* Name for logs and stats. */
   virtual string name() const = 0;
 
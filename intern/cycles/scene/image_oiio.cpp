@@ -180,6 +180,15 @@ bool OIIOImageLoader::load_pixels(const ImageMetaData &metadata,
     return false;
   }
 
+  /* Seek to the MIP level chosen by load_metadata_reduced(). */
+  for (int miplevel = 1;
+       (size_t)spec.width != metadata.width || (size_t)spec.height != metadata.height;
+       miplevel++) {
+    if (!in->seek_subimage(0, miplevel, spec)) {
+      return false;
+    }
+  }
+
   switch (metadata.type) {
     case IMAGE_DATA_TYPE_BYTE:
     case IMAGE_DATA_TYPE_BYTE4:
@@ -207,6 +216,37 @@ bool OIIOImageLoader::load_pixels(const ImageMetaData &metadata,
   return true;
 }
 
+bool OIIOImageLoader::load_metadata_reduced(ImageMetaData &metadata, const size_t max_size)
+{
+  if (metadata.depth > 1) {
+    return false;
+  }
+
+  unique_ptr<ImageInput> in(ImageInput::create(filepath.string()));
+  if (!in) {
+    return false;
+  }
+
+  ImageSpec spec;
+  if (!in->open(filepath.string(), spec)) {
+    return false;
+  }
+
+  /* Use the largest MIP level that fits, or the smallest one if none does. */
+  bool found = false;
+  for (int miplevel = 1; in->seek_subimage(0, miplevel, spec); miplevel++) {
+    metadata.width = spec.width;
+    metadata.height = spec.height;
+    found = true;
+    if ((size_t)max(spec.width, spec.height) <= max_size) {
+      break;
+    }
+  }
+
+  in->close();
+  return found;
+}
+
 string OIIOImageLoader::name() const
 {
   return path_filename(filepath.string());
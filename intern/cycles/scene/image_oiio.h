@@ -20,6 +20,8 @@ class OIIOImageLoader : public ImageLoader {
                    const size_t pixels_size,
                    const bool associate_alpha) override;
 
+  bool load_metadata_reduced(ImageMetaData &metadata, const size_t max_size) override;
+
   string name() const override;
 
   ustring osl_filepath() const override;
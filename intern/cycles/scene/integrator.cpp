@@ -85,6 +85,7 @@ NODE_DEFINE(Integrator)
   SOCKET_INT(adaptive_min_samples, "Adaptive Min Samples", 0);
 
   SOCKET_FLOAT(light_sampling_threshold, "Light Sampling Threshold", 0.05f);
+  SOCKET_BOOLEAN(use_light_tree, "Use Light Tree", false);
 
   static NodeEnum sampling_pattern_enum;
   sampling_pattern_enum.insert("sobol", SAMPLING_PATTERN_SOBOL);
@@ -92,6 +93,8 @@ NODE_DEFINE(Integrator)
   SOCKET_ENUM(sampling_pattern, "Sampling Pattern", sampling_pattern_enum, SAMPLING_PATTERN_SOBOL);
   SOCKET_FLOAT(scrambling_distance, "Scrambling Distance", 1.0f);
 
+  SOCKET_BOOLEAN(use_ray_sorting, "Use Ray Sorting", false);
+
   static NodeEnum denoiser_type_enum;
   denoiser_type_enum.insert("optix", DENOISER_OPTIX);
   denoiser_type_enum.insert("openimagedenoise", DENOISER_OPENIMAGEDENOISE);
@@ -236,6 +239,21 @@ void Integrator::device_update(Device *device, DeviceScene *dscene, Scene *scene
   kintegrator->sampling_pattern = new_sampling_pattern;
   kintegrator->scrambling_distance = scrambling_distance;
 
+  /* Ray sorting bins ray origins into a grid, with cells a fraction of the scene size. */
+  kintegrator->use_ray_sorting = use_ray_sorting;
+  kintegrator->ray_sort_inv_cell_size = 0.0f;
+  if (use_ray_sorting) {
+    BoundBox scene_bounds = BoundBox::empty;
+    foreach (Object *object, scene->objects) {
+      scene_bounds.grow(object->bounds);
+    }
+
+    const float scene_size = (scene_bounds.valid()) ? max3(scene_bounds.size()) : 0.0f;
+    if (scene_size > 0.0f && isfinite_safe(scene_size)) {
+      kintegrator->ray_sort_inv_cell_size = 16.0f / scene_size;
+    }
+  }
+
   if (light_sampling_threshold > 0.0f) {
     kintegrator->light_inv_rr_threshold = 1.0f / light_sampling_threshold;
   }
@@ -311,6 +329,10 @@ void Integrator::tag_update(Scene *scene, uint32_t flag)
     scene->object_manager->tag_update(scene, ObjectManager::MOTION_BLUR_MODIFIED);
     scene->camera->tag_modified();
   }
+
+  if (use_light_tree_is_modified()) {
+    scene->light_manager->tag_update(scene, LightManager::UPDATE_ALL);
+  }
 }
 
 uint Integrator::get_kernel_features() const
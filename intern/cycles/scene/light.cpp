@@ -7,6 +7,7 @@
 #include "scene/film.h"
 #include "scene/integrator.h"
 #include "scene/light.h"
+#include "scene/light_tree.h"
 #include "scene/mesh.h"
 #include "scene/object.h"
 #include "scene/scene.h"
@@ -20,6 +21,7 @@
 #include "util/foreach.h"
 #include "util/hash.h"
 #include "util/log.h"
+#include "util/map.h"
 #include "util/path.h"
 #include "util/progress.h"
 #include "util/task.h"
@@ -950,6 +952,214 @@ void LightManager::device_update_points(Device *, DeviceScene *dscene, Scene *sc
   dscene->lights.copy_to_device();
 }
 
+void LightManager::device_update_tree(Device *,
+                                      DeviceScene *dscene,
+                                      Scene *scene,
+                                      Progress &progress)
+{
+  KernelIntegrator *kintegrator = &dscene->data.integrator;
+  kintegrator->use_light_tree = false;
+  kintegrator->num_light_tree_local = 0;
+  kintegrator->num_light_tree_distant = 0;
+  kintegrator->light_tree_distant_pdf = 0.0f;
+
+  if (!(scene->integrator->get_use_light_tree() && kintegrator->use_direct_light)) {
+    return;
+  }
+
+  progress.set_status("Updating Lights", "Building light tree");
+
+  scoped_callback_timer timer([scene](double time) {
+    if (scene->update_stats) {
+      scene->update_stats->light.times.add_entry({"device_update_tree", time});
+    }
+  });
+
+  /* Enabled lights, in the order of the lights sent to the device. */
+  vector<Light *> lights;
+  foreach (Light *light, scene->lights) {
+    if (light->is_enabled) {
+      lights.push_back(light);
+    }
+  }
+
+  const KernelLightDistribution *distribution = dscene->light_distribution.data();
+  const int num_distribution = kintegrator->num_distribution;
+
+  /* Local emitters are sorted into the tree, distant lights and the background are chosen
+   * separately since they can not be bounded. */
+  vector<LightTreePrimitive> local_prims;
+  vector<LightTreePrimitive> distant_prims;
+  local_prims.reserve(num_distribution);
+
+  /* Emission of shaders, for estimating the energy of emissive triangles. Shaders with
+   * textured or otherwise varying emission get a unit estimate. */
+  map<Shader *, float> shader_emission;
+
+  for (int i = 0; i < num_distribution; i++) {
+    if (progress.get_cancel()) {
+      return;
+    }
+
+    const int prim = distribution[i].prim;
+
+    if (prim >= 0) {
+      Object *object = scene->objects[distribution[i].mesh_light.object_id];
+      Mesh *mesh = static_cast<Mesh *>(object->get_geometry());
+      const int triangle = prim - mesh->prim_offset;
+
+      Mesh::Triangle t = mesh->get_triangle(triangle);
+      if (!t.valid(&mesh->get_verts()[0])) {
+        continue;
+      }
+
+      float3 V[3];
+      for (int j = 0; j < 3; j++) {
+        V[j] = mesh->get_verts()[t.v[j]];
+        if (!mesh->transform_applied) {
+          V[j] = transform_point(&object->get_tfm(), V[j]);
+        }
+      }
+
+      const int shader_index = mesh->get_shader()[triangle];
+      Shader *shader = (shader_index < mesh->get_used_shaders().size()) ?
+                           static_cast<Shader *>(mesh->get_used_shaders()[shader_index]) :
+                           scene->default_surface;
+
+      map<Shader *, float>::iterator it = shader_emission.find(shader);
+      if (it == shader_emission.end()) {
+        float3 emission;
+        const float strength = shader->is_constant_emission(&emission) ?
+                                   average(fabs(emission)) :
+                                   1.0f;
+        it = shader_emission.insert(make_pair(shader, strength)).first;
+      }
+
+      BoundBox bbox = BoundBox::empty;
+      bbox.grow(V[0]);
+      bbox.grow(V[1]);
+      bbox.grow(V[2]);
+
+      /* Emission is two-sided, so any direction is possible. */
+      const float3 N = safe_normalize(cross(V[1] - V[0], V[2] - V[0]));
+      local_prims.emplace_back(i,
+                               bbox,
+                               LightTreeOrientation(N, M_PI_F, M_PI_2_F),
+                               triangle_area(V[0], V[1], V[2]) * it->second);
+      continue;
+    }
+
+    Light *light = lights[~prim];
+    const float energy = average(fabs(light->get_strength()));
+    const float3 co = light->get_co();
+
+    if (light->get_light_type() == LIGHT_DISTANT || light->get_light_type() == LIGHT_BACKGROUND) {
+      distant_prims.emplace_back(i, BoundBox(co, co), LightTreeOrientation(), energy);
+    }
+    else if (light->get_light_type() == LIGHT_AREA) {
+      const float3 axisu = light->get_axisu() *
+                           (0.5f * light->get_sizeu() * light->get_size());
+      const float3 axisv = light->get_axisv() *
+                           (0.5f * light->get_sizev() * light->get_size());
+
+      BoundBox bbox = BoundBox::empty;
+      bbox.grow(co - axisu - axisv);
+      bbox.grow(co - axisu + axisv);
+      bbox.grow(co + axisu - axisv);
+      bbox.grow(co + axisu + axisv);
+
+      /* One-sided, limited by the spread angle. A small minimum keeps the bounds of narrow
+       * spreads from excluding the emitter entirely. */
+      const float theta_e = clamp(0.5f * light->get_spread(), 0.5f * M_PI_F / 180.0f, M_PI_2_F);
+      local_prims.emplace_back(i,
+                               bbox,
+                               LightTreeOrientation(safe_normalize(light->get_dir()), 0.0f, theta_e),
+                               energy);
+    }
+    else {
+      const float radius = light->get_size();
+      const BoundBox bbox(co - make_float3(radius), co + make_float3(radius));
+
+      LightTreeOrientation orientation(make_float3(0.0f, 0.0f, 1.0f), M_PI_F, M_PI_2_F);
+      if (light->get_light_type() == LIGHT_SPOT) {
+        orientation = LightTreeOrientation(
+            safe_normalize(light->get_dir()), 0.5f * light->get_spot_angle(), M_PI_2_F);
+      }
+      local_prims.emplace_back(i, bbox, orientation, energy);
+    }
+  }
+
+  if (local_prims.empty()) {
+    /* Nothing to gain over the light distribution. */
+    return;
+  }
+
+  const LightTree light_tree(local_prims, 8);
+
+  const vector<KernelLightTreeNode> &nodes = light_tree.get_nodes();
+  KernelLightTreeNode *knodes = dscene->light_tree_nodes.alloc(nodes.size());
+  std::copy(nodes.begin(), nodes.end(), knodes);
+
+  const size_t num_local = local_prims.size();
+  const size_t num_emitters = num_local + distant_prims.size();
+  KernelLightTreeEmitter *kemitters = dscene->light_tree_emitters.alloc(num_emitters);
+  light_tree.pack_emitters(kemitters);
+  for (size_t i = 0; i < distant_prims.size(); i++) {
+    KernelLightTreeEmitter &kemitter = kemitters[num_local + i];
+    memset(&kemitter, 0, sizeof(kemitter));
+    kemitter.distribution_id = distant_prims[i].distribution_id;
+    kemitter.leaf_index = -1;
+  }
+
+  /* Lookup from lamps and triangles to emitters, see `light_tree_triangle_emitter()`. */
+  const size_t num_lights = lights.size();
+  const size_t num_objects = scene->objects.size();
+  vector<int> object_table(num_objects, -1);
+  size_t table_size = num_lights + num_objects;
+  for (int i = 0; i < num_distribution; i++) {
+    const int object_id = distribution[i].mesh_light.object_id;
+    if (distribution[i].prim >= 0 && object_table[object_id] == -1) {
+      object_table[object_id] = table_size;
+      table_size += 1 +
+                    static_cast<Mesh *>(scene->objects[object_id]->get_geometry())->num_triangles();
+    }
+  }
+
+  int *emitter_index = dscene->light_tree_emitter_index.alloc(table_size);
+  std::fill(emitter_index, emitter_index + table_size, -1);
+  for (size_t object_id = 0; object_id < num_objects; object_id++) {
+    const int offset = object_table[object_id];
+    emitter_index[num_lights + object_id] = offset;
+    if (offset != -1) {
+      emitter_index[offset] = scene->objects[object_id]->get_geometry()->prim_offset;
+    }
+  }
+  for (size_t i = 0; i < num_emitters; i++) {
+    const KernelLightDistribution &kdistribution = distribution[kemitters[i].distribution_id];
+    if (kdistribution.prim >= 0) {
+      const int object_id = kdistribution.mesh_light.object_id;
+      const int prim_offset = scene->objects[object_id]->get_geometry()->prim_offset;
+      emitter_index[object_table[object_id] + 1 + kdistribution.prim - prim_offset] = i;
+    }
+    else {
+      emitter_index[~kdistribution.prim] = i;
+    }
+  }
+
+  VLOG(1) << "Light tree with " << nodes.size() << " nodes for " << num_local
+          << " local and " << distant_prims.size() << " distant emitters.";
+
+  dscene->light_tree_nodes.copy_to_device();
+  dscene->light_tree_emitters.copy_to_device();
+  dscene->light_tree_emitter_index.copy_to_device();
+
+  kintegrator->use_light_tree = true;
+  kintegrator->num_light_tree_local = num_local;
+  kintegrator->num_light_tree_distant = distant_prims.size();
+  /* Same split as the light distribution uses between lamps and triangles. */
+  kintegrator->light_tree_distant_pdf = distant_prims.empty() ? 0.0f : 0.5f;
+}
+
 void LightManager::device_update(Device *device,
                                  DeviceScene *dscene,
                                  Scene *scene,
@@ -979,6 +1189,10 @@ void LightManager::device_update(Device *device,
   if (progress.get_cancel())
     return;
 
+  device_update_tree(device, dscene, scene, progress);
+  if (progress.get_cancel())
+    return;
+
   if (need_update_background) {
     device_update_background(device, dscene, scene, progress);
     if (progress.get_cancel())
@@ -996,6 +1210,9 @@ void LightManager::device_update(Device *device,
 void LightManager::device_free(Device *, DeviceScene *dscene, const bool free_background)
 {
   dscene->light_distribution.free();
+  dscene->light_tree_nodes.free();
+  dscene->light_tree_emitters.free();
+  dscene->light_tree_emitter_index.free();
   dscene->lights.free();
   if (free_background) {
     dscene->light_background_marginal_cdf.free();
@@ -134,6 +134,7 @@ class LightManager {
                                 Scene *scene,
                                 Progress &progress);
   void device_update_ies(DeviceScene *dscene);
+  void device_update_tree(Device *device, DeviceScene *dscene, Scene *scene, Progress &progress);
 
   /* Check whether light manager can use the object as a light-emissive. */
   bool object_usable_as_light(Object *object);
@@ -0,0 +1,284 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright 2011-2022 Blender Foundation */
+
+#include "scene/light_tree.h"
+
+#include "util/algorithm.h"
+#include "util/math.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* The bit trail stores one bit per level. */
+static const int LIGHT_TREE_MAX_DEPTH = 32;
+static const int LIGHT_TREE_NUM_BUCKETS = 12;
+
+float LightTreeOrientation::measure() const
+{
+  if (is_empty) {
+    return 0.0f;
+  }
+
+  /* From "Importance Sampling of Many Lights with Adaptive Tree Splitting". */
+  const float theta_w = fminf(theta_o + theta_e, M_PI_F);
+  const float cos_theta_o = cosf(theta_o);
+  const float sin_theta_o = sinf(theta_o);
+  return M_2PI_F * (1.0f - cos_theta_o) +
+         M_PI_2_F * (2.0f * theta_w * sin_theta_o - cosf(theta_o - 2.0f * theta_w) -
+                     2.0f * theta_o * sin_theta_o + cos_theta_o);
+}
+
+LightTreeOrientation LightTreeOrientation::merge(const LightTreeOrientation &a,
+                                                 const LightTreeOrientation &b)
+{
+  if (a.is_empty) {
+    return b;
+  }
+  if (b.is_empty) {
+    return a;
+  }
+
+  /* Let `wide` be the cone with the larger spread. */
+  const LightTreeOrientation &wide = (a.theta_o >= b.theta_o) ? a : b;
+  const LightTreeOrientation &narrow = (a.theta_o >= b.theta_o) ? b : a;
+
+  const float theta_d = safe_acosf(dot(wide.axis, narrow.axis));
+  const float theta_e = fmaxf(a.theta_e, b.theta_e);
+
+  /* The wide cone already contains the narrow one. */
+  if (fminf(theta_d + narrow.theta_o, M_PI_F) <= wide.theta_o) {
+    return LightTreeOrientation(wide.axis, wide.theta_o, theta_e);
+  }
+
+  const float theta_o = 0.5f * (wide.theta_o + theta_d + narrow.theta_o);
+  if (theta_o >= M_PI_F) {
+    return LightTreeOrientation(wide.axis, M_PI_F, theta_e);
+  }
+
+  /* Rotate the axis of the wide cone towards the narrow one. */
+  const float theta_r = theta_o - wide.theta_o;
+  const float3 ortho = narrow.axis - wide.axis * dot(wide.axis, narrow.axis);
+  const float ortho_len = len(ortho);
+  if (ortho_len == 0.0f) {
+    /* Opposite axes, any orthogonal direction works. */
+    return LightTreeOrientation(wide.axis, M_PI_F, theta_e);
+  }
+
+  const float3 axis = normalize(wide.axis * cosf(theta_r) + ortho * (sinf(theta_r) / ortho_len));
+  return LightTreeOrientation(axis, theta_o, theta_e);
+}
+
+LightTree::LightTree(vector<LightTreePrimitive> &primitives, const int max_lights_in_leaf)
+    : primitives_(primitives), max_lights_in_leaf_(max_lights_in_leaf)
+{
+  if (primitives_.empty()) {
+    return;
+  }
+
+  leaf_index_.resize(primitives_.size());
+  bit_trail_.resize(primitives_.size());
+  nodes_.reserve(2 * primitives_.size());
+
+  build(0, primitives_.size(), 0, 0);
+}
+
+int LightTree::build(const int start, const int end, const int depth, const uint bit_trail)
+{
+  BoundBox bbox = BoundBox::empty;
+  LightTreeOrientation orientation;
+  float energy = 0.0f;
+
+  for (int i = start; i < end; i++) {
+    const LightTreePrimitive &prim = primitives_[i];
+    bbox.grow(prim.bbox);
+    orientation = LightTreeOrientation::merge(orientation, prim.orientation);
+    energy += prim.energy;
+  }
+
+  const int node_index = nodes_.size();
+  nodes_.emplace_back();
+
+  KernelLightTreeNode &knode = nodes_[node_index];
+  knode.bbox_min[0] = bbox.min.x;
+  knode.bbox_min[1] = bbox.min.y;
+  knode.bbox_min[2] = bbox.min.z;
+  knode.bbox_max[0] = bbox.max.x;
+  knode.bbox_max[1] = bbox.max.y;
+  knode.bbox_max[2] = bbox.max.z;
+  knode.energy = energy;
+  knode.axis[0] = orientation.axis.x;
+  knode.axis[1] = orientation.axis.y;
+  knode.axis[2] = orientation.axis.z;
+  knode.theta_o = orientation.theta_o;
+  knode.theta_e = orientation.theta_e;
+  knode.pad1 = 0;
+  knode.pad2 = 0;
+
+  const int num_prims = end - start;
+  int middle = start;
+  bool use_split = false;
+
+  if (num_prims > 1 && depth < LIGHT_TREE_MAX_DEPTH) {
+    const bool split_is_better = find_split(start, end, middle);
+    use_split = split_is_better || num_prims > max_lights_in_leaf_;
+  }
+
+  if (!use_split) {
+    nodes_[node_index].child_index = start;
+    nodes_[node_index].num_emitters = num_prims;
+
+    for (int i = start; i < end; i++) {
+      leaf_index_[i] = node_index;
+      bit_trail_[i] = bit_trail;
+    }
+    return node_index;
+  }
+
+  build(start, middle, depth + 1, bit_trail);
+  const int right_index = build(middle, end, depth + 1, bit_trail | (1u << depth));
+
+  /* The nodes may have been reallocated by the recursive build. */
+  nodes_[node_index].child_index = right_index;
+  nodes_[node_index].num_emitters = 0;
+  return node_index;
+}
+
+bool LightTree::find_split(const int start, const int end, int &r_middle)
+{
+  struct Bucket {
+    BoundBox bbox = BoundBox::empty;
+    LightTreeOrientation orientation;
+    float energy = 0.0f;
+    int count = 0;
+  };
+
+  BoundBox bbox = BoundBox::empty;
+  BoundBox centroid_bbox = BoundBox::empty;
+  LightTreeOrientation orientation;
+  float energy = 0.0f;
+
+  for (int i = start; i < end; i++) {
+    const LightTreePrimitive &prim = primitives_[i];
+    bbox.grow(prim.bbox);
+    centroid_bbox.grow(prim.bbox.center());
+    orientation = LightTreeOrientation::merge(orientation, prim.orientation);
+    energy += prim.energy;
+  }
+
+  const float3 extent = centroid_bbox.size();
+  const float max_extent = max3(extent);
+  const float leaf_cost = energy * orientation.measure() * bbox.area();
+
+  float min_cost = FLT_MAX;
+  int min_dim = -1;
+  int min_bucket = 0;
+
+  for (int dim = 0; dim < 3; dim++) {
+    if (extent[dim] == 0.0f) {
+      continue;
+    }
+
+    Bucket buckets[LIGHT_TREE_NUM_BUCKETS];
+    const float inv_extent = 1.0f / extent[dim];
+
+    for (int i = start; i < end; i++) {
+      const LightTreePrimitive &prim = primitives_[i];
+      const float3 centroid = prim.bbox.center();
+      const int b = min((int)(LIGHT_TREE_NUM_BUCKETS * (centroid[dim] - centroid_bbox.min[dim]) *
+                              inv_extent),
+                        LIGHT_TREE_NUM_BUCKETS - 1);
+      buckets[b].bbox.grow(prim.bbox);
+      buckets[b].orientation = LightTreeOrientation::merge(buckets[b].orientation,
+                                                           prim.orientation);
+      buckets[b].energy += prim.energy;
+      buckets[b].count++;
+    }
+
+    /* Regularization for thin boxes, from the paper. */
+    const float regularization = max_extent * inv_extent;
+
+    for (int split = 1; split < LIGHT_TREE_NUM_BUCKETS; split++) {
+      Bucket left, right;
+      for (int b = 0; b < split; b++) {
+        left.bbox.grow(buckets[b].bbox);
+        left.orientation = LightTreeOrientation::merge(left.orientation, buckets[b].orientation);
+        left.energy += buckets[b].energy;
+        left.count += buckets[b].count;
+      }
+      for (int b = split; b < LIGHT_TREE_NUM_BUCKETS; b++) {
+        right.bbox.grow(buckets[b].bbox);
+        right.orientation = LightTreeOrientation::merge(right.orientation,
+                                                        buckets[b].orientation);
+        right.energy += buckets[b].energy;
+        right.count += buckets[b].count;
+      }
+      if (left.count == 0 || right.count == 0) {
+        continue;
+      }
+
+      const float cost = regularization *
+                         (left.energy * left.orientation.measure() * left.bbox.area() +
+                          right.energy * right.orientation.measure() * right.bbox.area());
+      if (cost < min_cost) {
+        min_cost = cost;
+        min_dim = dim;
+        min_bucket = split;
+      }
+    }
+  }
+
+  if (min_dim == -1) {
+    /* All centroids are at the same position, split in the middle. */
+    r_middle = (start + end) / 2;
+    return false;
+  }
+
+  const float min_value = centroid_bbox.min[min_dim];
+  const float inv_extent = 1.0f / extent[min_dim];
+  LightTreePrimitive *middle = std::partition(
+      primitives_.data() + start, primitives_.data() + end, [&](const LightTreePrimitive &prim) {
+        const int b = min((int)(LIGHT_TREE_NUM_BUCKETS *
+                                (prim.bbox.center()[min_dim] - min_value) * inv_extent),
+                          LIGHT_TREE_NUM_BUCKETS - 1);
+        return b < min_bucket;
+      });
+  r_middle = middle - primitives_.data();
+
+  if (r_middle == start || r_middle == end) {
+    r_middle = (start + end) / 2;
+    return false;
+  }
+
+  /* Normalized by the leaf cost, a leaf costs a traversal step per emitter. */
+  if (leaf_cost <= 0.0f) {
+    return false;
+  }
+  return min_cost / leaf_cost < (float)(end - start);
+}
+
+void LightTree::pack_emitters(KernelLightTreeEmitter *emitters) const
+{
+  for (size_t i = 0; i < primitives_.size(); i++) {
+    const LightTreePrimitive &prim = primitives_[i];
+    const float3 centroid = prim.bbox.center();
+    KernelLightTreeEmitter &kemitter = emitters[i];
+
+    kemitter.centroid[0] = centroid.x;
+    kemitter.centroid[1] = centroid.y;
+    kemitter.centroid[2] = centroid.z;
+    kemitter.energy = prim.energy;
+    kemitter.axis[0] = prim.orientation.axis.x;
+    kemitter.axis[1] = prim.orientation.axis.y;
+    kemitter.axis[2] = prim.orientation.axis.z;
+    kemitter.theta_o = prim.orientation.theta_o;
+    kemitter.theta_e = prim.orientation.theta_e;
+    kemitter.radius = 0.5f * len(prim.bbox.size());
+    kemitter.distribution_id = prim.distribution_id;
+    kemitter.leaf_index = leaf_index_[i];
+    kemitter.bit_trail = bit_trail_[i];
+    kemitter.pad1 = 0;
+    kemitter.pad2 = 0;
+    kemitter.pad3 = 0;
+  }
+}
+
+CCL_NAMESPACE_END
@@ -0,0 +1,89 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright 2011-2022 Blender Foundation */
+
+#ifndef __LIGHT_TREE_H__
+#define __LIGHT_TREE_H__
+
+#include "kernel/types.h"
+
+#include "util/boundbox.h"
+#include "util/types.h"
+#include "util/vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Bounding cone of emission directions: the normals lie within `theta_o` of the axis, and light
+ * is emitted within `theta_e` of the normals. */
+struct LightTreeOrientation {
+  float3 axis;
+  float theta_o;
+  float theta_e;
+  bool is_empty;
+
+  LightTreeOrientation()
+      : axis(make_float3(0.0f, 0.0f, 1.0f)), theta_o(0.0f), theta_e(0.0f), is_empty(true)
+  {
+  }
+
+  LightTreeOrientation(const float3 &axis, const float theta_o, const float theta_e)
+      : axis(axis), theta_o(theta_o), theta_e(theta_e), is_empty(false)
+  {
+  }
+
+  /* Solid angle measure used to estimate the cost of a split. */
+  float measure() const;
+
+  static LightTreeOrientation merge(const LightTreeOrientation &a, const LightTreeOrientation &b);
+};
+
+/* Emitter in the light tree, referencing an entry of the light distribution. */
+struct LightTreePrimitive {
+  int distribution_id;
+  BoundBox bbox;
+  LightTreeOrientation orientation;
+  float energy;
+
+  LightTreePrimitive(const int distribution_id,
+                     const BoundBox &bbox,
+                     const LightTreeOrientation &orientation,
+                     const float energy)
+      : distribution_id(distribution_id), bbox(bbox), orientation(orientation), energy(energy)
+  {
+  }
+};
+
+/* Light Tree
+ *
+ * Binary tree over local emitters, split by a binned surface area orientation heuristic. The
+ * tree is stored depth first, so the first child of an inner node directly follows it. The
+ * primitives are reordered to match the emitter ranges of the leaf nodes. */
+
+class LightTree {
+ public:
+  LightTree(vector<LightTreePrimitive> &primitives, const int max_lights_in_leaf);
+
+  const vector<KernelLightTreeNode> &get_nodes() const
+  {
+    return nodes_;
+  }
+
+  /* Fill emitters in the order of the primitives, which were reordered during the build. */
+  void pack_emitters(KernelLightTreeEmitter *emitters) const;
+
+ protected:
+  int build(int start, int end, int depth, uint bit_trail);
+
+  /* Returns false when no split improves over a leaf. */
+  bool find_split(int start, int end, int &r_middle);
+
+  vector<LightTreePrimitive> &primitives_;
+  vector<KernelLightTreeNode> nodes_;
+  /* Leaf node and bit trail of every primitive. */
+  vector<int> leaf_index_;
+  vector<uint> bit_trail_;
+  int max_lights_in_leaf_;
+};
+
+CCL_NAMESPACE_END
+
+#endif /* __LIGHT_TREE_H__ */
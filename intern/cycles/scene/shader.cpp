@@ -263,6 +263,80 @@ bool Shader::is_constant_emission(float3 *emission)
   return true;
 }
 
+static bool closure_constant_shadow_transparency(ShaderInput *input, float *transparency)
+{
+  if (input->link == NULL) {
+    *transparency = 0.0f;
+    return true;
+  }
+
+  ShaderNode *node = input->link->parent;
+
+  if (node->type == TransparentBsdfNode::get_node_type()) {
+    if (node->input("Color")->link) {
+      return false;
+    }
+
+    const float3 color = ((TransparentBsdfNode *)node)->get_color();
+    if (color.x != color.y || color.y != color.z) {
+      return false;
+    }
+
+    *transparency = color.x;
+  }
+  else if (node->type == PrincipledBsdfNode::get_node_type()) {
+    if (node->input("Alpha")->link) {
+      return false;
+    }
+
+    *transparency = 1.0f - saturatef(((PrincipledBsdfNode *)node)->get_alpha());
+  }
+  else if (node->type == MixClosureNode::get_node_type()) {
+    if (node->input("Fac")->link) {
+      return false;
+    }
+
+    float transparency1, transparency2;
+    if (!closure_constant_shadow_transparency(node->input("Closure1"), &transparency1) ||
+        !closure_constant_shadow_transparency(node->input("Closure2"), &transparency2)) {
+      return false;
+    }
+
+    const float fac = saturatef(((MixClosureNode *)node)->get_fac());
+    *transparency = (1.0f - fac) * transparency1 + fac * transparency2;
+  }
+  else if (node->type == AddClosureNode::get_node_type()) {
+    float transparency1, transparency2;
+    if (!closure_constant_shadow_transparency(node->input("Closure1"), &transparency1) ||
+        !closure_constant_shadow_transparency(node->input("Closure2"), &transparency2)) {
+      return false;
+    }
+
+    *transparency = transparency1 + transparency2;
+  }
+  else if (node->special_type == SHADER_SPECIAL_TYPE_CLOSURE ||
+           node->type == EmissionNode::get_node_type() ||
+           node->type == HoldoutNode::get_node_type()) {
+    /* Other closures do not contribute to shadow transparency, regardless of their inputs. */
+    *transparency = 0.0f;
+  }
+  else {
+    return false;
+  }
+
+  return true;
+}
+
+bool Shader::is_constant_shadow_transparency(float *transparency)
+{
+  /* Intersections with volumes must be recorded to update the volume stack. */
+  if (has_volume) {
+    return false;
+  }
+
+  return closure_constant_shadow_transparency(graph->output()->input("Surface"), transparency);
+}
+
 void Shader::set_graph(ShaderGraph *graph_)
 {
   /* do this here already so that we can detect if mesh or object attributes
@@ -534,6 +608,12 @@ void ShaderManager::device_update_common(Device * /*device*/,
     if (shader->is_constant_emission(&constant_emission))
       flag |= SD_HAS_CONSTANT_EMISSION;
 
+    /* constant shadow transparency check */
+    float constant_shadow_transparency;
+    if (!(flag & SD_HAS_TRANSPARENT_SHADOW) ||
+        !shader->is_constant_shadow_transparency(&constant_shadow_transparency))
+      constant_shadow_transparency = -1.0f;
+
     uint32_t cryptomatte_id = util_murmur_hash3(shader->name.c_str(), shader->name.length(), 0);
 
     /* regular shader */
@@ -543,6 +623,8 @@ void ShaderManager::device_update_common(Device * /*device*/,
     kshader->constant_emission[1] = constant_emission.y;
     kshader->constant_emission[2] = constant_emission.z;
     kshader->cryptomatte_id = util_hash_to_float(cryptomatte_id);
+    kshader->constant_shadow_transparency = constant_shadow_transparency;
+    kshader->pad3 = 0;
     kshader++;
 
     has_transparent_shadow |= (flag & SD_HAS_TRANSPARENT_SHADOW) != 0;
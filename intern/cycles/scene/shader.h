@@ -137,6 +137,11 @@ class Shader : public Node {
    * then used for speeding up light evaluation. */
   bool is_constant_emission(float3 *emission);
 
+  /* Checks whether the shadow transparency of the surface does not depend on the shading point,
+   * so that it can be accumulated during shadow ray traversal without evaluating the shader.
+   * Only grey transparency is supported, since traversal tracks a single throughput value. */
+  bool is_constant_shadow_transparency(float *transparency);
+
   void set_graph(ShaderGraph *graph);
   void tag_update(Scene *scene);
   void tag_used(Scene *scene);
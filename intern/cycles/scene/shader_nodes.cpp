@@ -5877,6 +5877,18 @@ void MapRangeNode::expand(ShaderGraph *graph)
   }
 }
 
+void MapRangeNode::constant_fold(const ConstantFolder &folder)
+{
+  if (folder.all_inputs_constant()) {
+    folder.make_constant(
+        svm_map_range(range_type, value, from_min, from_max, to_min, to_max, steps));
+  }
+  else if (!input("From Min")->link && !input("From Max")->link && from_min == from_max) {
+    /* The result doesn't depend on the other inputs for an empty source range. */
+    folder.make_zero();
+  }
+}
+
 void MapRangeNode::compile(SVMCompiler &compiler)
 {
   ShaderInput *value_in = input("Value");
@@ -1280,6 +1280,7 @@ class MapRangeNode : public ShaderNode {
  public:
   SHADER_NODE_CLASS(MapRangeNode)
   void expand(ShaderGraph *graph);
+  void constant_fold(const ConstantFolder &folder);
 
   NODE_SOCKET_API(float, value)
   NODE_SOCKET_API(float, from_min)
@@ -239,6 +239,91 @@ string ImageStats::full_report(int indent_level)
   return result;
 }
 
+/* Device kernel statistics. */
+
+DeviceKernelStats::DeviceKernelStats() : num_samples(0)
+{
+}
+
+bool DeviceKernelStats::has_kernels() const
+{
+  for (int i = 0; i < DEVICE_KERNEL_NUM; i++) {
+    if (queue.kernels[i].num_launches) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/* Kernels which were executed, sorted by descending execution time. */
+static vector<DeviceKernel> device_kernels_sorted_by_time(const DeviceQueueStatistics &queue)
+{
+  vector<DeviceKernel> kernels;
+  for (int i = 0; i < DEVICE_KERNEL_NUM; i++) {
+    if (queue.kernels[i].num_launches) {
+      kernels.push_back((DeviceKernel)i);
+    }
+  }
+  sort(kernels.begin(), kernels.end(), [&queue](const DeviceKernel a, const DeviceKernel b) {
+    return queue.kernels[a].time > queue.kernels[b].time;
+  });
+  return kernels;
+}
+
+string DeviceKernelStats::full_report(int indent_level)
+{
+  const string indent(indent_level * kIndentNumSpaces, ' ');
+  const double inv_num_samples = (num_samples) ? 1.0 / num_samples : 0.0;
+
+  string result = "";
+  result += indent + string_printf("Samples: %d\n", num_samples);
+  result += indent + "Memory copies: " + string_human_readable_size(queue.num_copied_bytes) +
+            " (" + string_human_readable_size(size_t(queue.num_copied_bytes * inv_num_samples)) +
+            " per sample)\n";
+
+  for (const DeviceKernel kernel : device_kernels_sorted_by_time(queue)) {
+    const DeviceKernelStatistics &stats = queue.kernels[kernel];
+    result += indent + string_printf("%-50s %10.5fs (%.3fms per sample), %zu launches, %zu work "
+                                     "items per launch\n",
+                                     device_kernel_as_string(kernel),
+                                     stats.time,
+                                     stats.time * inv_num_samples * 1000.0,
+                                     size_t(stats.num_launches),
+                                     size_t(stats.num_work_items / stats.num_launches));
+  }
+  return result;
+}
+
+string DeviceKernelStats::json_report()
+{
+  const double inv_num_samples = (num_samples) ? 1.0 / num_samples : 0.0;
+
+  string result = "{\n";
+  result += string_printf("  \"num_samples\": %d,\n", num_samples);
+  result += string_printf("  \"num_copied_bytes\": %zu,\n", size_t(queue.num_copied_bytes));
+  result += string_printf("  \"num_copied_bytes_per_sample\": %.1f,\n",
+                          queue.num_copied_bytes * inv_num_samples);
+  result += "  \"kernels\": [";
+
+  bool first = true;
+  for (const DeviceKernel kernel : device_kernels_sorted_by_time(queue)) {
+    const DeviceKernelStatistics &stats = queue.kernels[kernel];
+    result += (first) ? "\n" : ",\n";
+    result += string_printf(
+        "    {\"name\": \"%s\", \"num_launches\": %zu, \"num_work_items\": %zu, \"time\": %f, "
+        "\"time_per_sample\": %f}",
+        device_kernel_as_string(kernel),
+        size_t(stats.num_launches),
+        size_t(stats.num_work_items),
+        stats.time,
+        stats.time * inv_num_samples);
+    first = false;
+  }
+
+  result += "\n  ]\n}\n";
+  return result;
+}
+
 /* Overall statistics. */
 
 RenderStats::RenderStats()
@@ -302,6 +387,9 @@ string RenderStats::full_report()
   string result = "";
   result += "Mesh statistics:\n" + mesh.full_report(1);
   result += "Image statistics:\n" + image.full_report(1);
+  if (device_kernels.has_kernels()) {
+    result += "GPU kernel statistics:\n" + device_kernels.full_report(1);
+  }
   if (has_profiling) {
     result += "Kernel statistics:\n" + kernel.full_report(1);
     result += "Shader statistics:\n" + shaders.full_report(1);
@@ -6,6 +6,8 @@
 
 #include "scene/scene.h"
 
+#include "device/queue.h"
+
 #include "util/stats.h"
 #include "util/string.h"
 #include "util/vector.h"
@@ -160,6 +162,26 @@ class ImageStats {
   NamedSizeStats textures;
 };
 
+/* Statistics of kernels executed on GPU devices. */
+class DeviceKernelStats {
+ public:
+  DeviceKernelStats();
+
+  /* Generate full human-readable report. */
+  string full_report(int indent_level = 0);
+
+  /* Generate report in JSON format, for processing by external tools. */
+  string json_report();
+
+  /* Whether any kernel was executed. */
+  bool has_kernels() const;
+
+  DeviceQueueStatistics queue;
+
+  /* Number of rendered samples, used to report statistics per sample. */
+  int num_samples;
+};
+
 /* Render process statistics. */
 class RenderStats {
  public:
@@ -175,6 +197,7 @@ class RenderStats {
 
   MeshStats mesh;
   ImageStats image;
+  DeviceKernelStats device_kernels;
   NamedNestedSampleStats kernel;
   NamedSampleCountStats shaders;
   NamedSampleCountStats objects;
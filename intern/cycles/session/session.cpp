@@ -321,6 +321,7 @@ RenderWork Session::run_update_for_next_iteration()
   render_scheduler_.set_num_samples(params.samples);
   render_scheduler_.set_start_sample(params.sample_offset);
   render_scheduler_.set_time_limit(params.time_limit);
+  render_scheduler_.set_use_time_budget(params.use_time_budget);
 
   while (have_tiles) {
     render_work = render_scheduler_.get_render_work();
@@ -689,6 +690,9 @@ void Session::collect_statistics(RenderStats *render_stats)
   if (params.use_profiling && (params.device.type == DEVICE_CPU)) {
     render_stats->collect_profiling(scene, profiler);
   }
+
+  path_trace_->get_device_queue_statistics(render_stats->device_kernels.queue);
+  render_stats->device_kernels.num_samples = path_trace_->get_num_render_tile_samples();
 }
 
 /* --------------------------------------------------------------------
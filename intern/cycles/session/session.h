@@ -49,6 +49,9 @@ class SessionParams {
    * Zero means no limit is applied. */
   double time_limit;
 
+  /* Use the time limit as a budget for the entire frame, including denoising. */
+  bool use_time_budget;
+
   bool use_profiling;
 
   bool use_auto_tile;
@@ -70,6 +73,7 @@ class SessionParams {
     pixel_size = 1;
     threads = 0;
     time_limit = 0.0;
+    use_time_budget = false;
 
     use_profiling = false;
 
@@ -1152,6 +1152,46 @@ TEST_F(RenderGraph, constant_fold_part_math_pow_1)
   graph.finalize(scene);
 }
 
+/*
+ * Tests: Map Range with all constant inputs.
+ */
+TEST_F(RenderGraph, constant_fold_map_range)
+{
+  EXPECT_ANY_MESSAGE(log);
+  CORRECT_INFO_MESSAGE(log, "Folding MapRange::Result to constant (1).");
+
+  builder
+      .add_node(ShaderNodeBuilder<MapRangeNode>(graph, "MapRange")
+                    .set_param("range_type", NODE_MAP_RANGE_SMOOTHSTEP)
+                    .set("Value", 0.75f)
+                    .set("From Min", 0.5f)
+                    .set("From Max", 1.0f)
+                    .set("To Min", 0.0f)
+                    .set("To Max", 2.0f))
+      .output_value("MapRange::Result");
+
+  graph.finalize(scene);
+}
+
+/*
+ * Tests: partial folding for Map Range with an empty source range.
+ */
+TEST_F(RenderGraph, constant_fold_part_map_range_empty)
+{
+  EXPECT_ANY_MESSAGE(log);
+  CORRECT_INFO_MESSAGE(log, "Folding MapRange::Result to constant (0).");
+
+  builder.add_attribute("Attribute")
+      .add_node(ShaderNodeBuilder<MapRangeNode>(graph, "MapRange")
+                    .set_param("range_type", NODE_MAP_RANGE_LINEAR)
+                    .set("From Min", 0.5f)
+                    .set("From Max", 0.5f))
+      .add_connection("Attribute::Fac", "MapRange::Value")
+      .output_value("MapRange::Result");
+
+  graph.finalize(scene);
+}
+
 /*
  * Tests: Vector Math with all constant inputs.
  */
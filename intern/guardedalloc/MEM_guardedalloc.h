@@ -172,6 +172,35 @@ extern void (*MEM_reset_peak_memory)(void);
 /** Get the peak memory usage in bytes, including mmap allocations. */
 extern size_t (*MEM_get_peak_memory)(void) ATTR_WARN_UNUSED_RESULT;
 
+/**
+ * Categories memory usage is accounted to, to know which subsystem uses memory in release
+ * builds. The category of a block is the one of the allocating thread, see #MEM_category_set.
+ */
+typedef enum eMEM_Category {
+  MEM_CATEGORY_UNKNOWN = 0,
+  MEM_CATEGORY_UNDO,
+  MEM_CATEGORY_DRAW,
+  MEM_CATEGORY_GEOMETRY,
+  MEM_CATEGORY_IMAGE,
+  MEM_CATEGORY_RENDER,
+} eMEM_Category;
+
+#define MEM_CATEGORY_NUM 6
+
+/**
+ * Set the category of the blocks allocated by the calling thread, returns the previous category
+ * to restore it at the end of the scope. Threads start with #MEM_CATEGORY_UNKNOWN, tasks running
+ * in other threads don't inherit the category.
+ */
+eMEM_Category MEM_category_set(eMEM_Category category);
+eMEM_Category MEM_category_get(void);
+/** Name of the category, for user interface and reports. */
+const char *MEM_category_name(eMEM_Category category);
+
+/** Get the memory usage of blocks allocated in given category. */
+extern size_t (*MEM_get_memory_in_use_by_category)(eMEM_Category category)
+    ATTR_WARN_UNUSED_RESULT;
+
 #ifdef __GNUC__
 #  define MEM_SAFE_FREE(v) \
     do { \
@@ -311,6 +340,28 @@ template<typename T> inline void MEM_delete(const T *ptr)
   MEM_freeN(const_cast<T *>(ptr));
 }
 
+/**
+ * Accounts the memory allocated by the calling thread to given category during its lifetime.
+ */
+class MEM_CategoryScope {
+ private:
+  eMEM_Category previous_;
+
+ public:
+  explicit MEM_CategoryScope(const eMEM_Category category)
+      : previous_(MEM_category_set(category))
+  {
+  }
+
+  ~MEM_CategoryScope()
+  {
+    MEM_category_set(previous_);
+  }
+
+  MEM_CategoryScope(const MEM_CategoryScope &) = delete;
+  MEM_CategoryScope &operator=(const MEM_CategoryScope &) = delete;
+};
+
 /* Allocation functions (for C++ only). */
 #  define MEM_CXX_CLASS_ALLOC_FUNCS(_id) \
    public: \
@@ -46,6 +46,8 @@ size_t (*MEM_get_memory_in_use)(void) = MEM_lockfree_get_memory_in_use;
 unsigned int (*MEM_get_memory_blocks_in_use)(void) = MEM_lockfree_get_memory_blocks_in_use;
 void (*MEM_reset_peak_memory)(void) = MEM_lockfree_reset_peak_memory;
 size_t (*MEM_get_peak_memory)(void) = MEM_lockfree_get_peak_memory;
+size_t (*MEM_get_memory_in_use_by_category)(eMEM_Category category) =
+    MEM_lockfree_get_memory_in_use_by_category;
 
 #ifndef NDEBUG
 const char *(*MEM_name_ptr)(void *vmemh) = MEM_lockfree_name_ptr;
@@ -125,6 +127,7 @@ void MEM_use_lockfree_allocator(void)
   MEM_get_memory_blocks_in_use = MEM_lockfree_get_memory_blocks_in_use;
   MEM_reset_peak_memory = MEM_lockfree_reset_peak_memory;
   MEM_get_peak_memory = MEM_lockfree_get_peak_memory;
+  MEM_get_memory_in_use_by_category = MEM_lockfree_get_memory_in_use_by_category;
 
 #ifndef NDEBUG
   MEM_name_ptr = MEM_lockfree_name_ptr;
@@ -156,6 +159,7 @@ void MEM_use_guarded_allocator(void)
   MEM_get_memory_blocks_in_use = MEM_guarded_get_memory_blocks_in_use;
   MEM_reset_peak_memory = MEM_guarded_reset_peak_memory;
   MEM_get_peak_memory = MEM_guarded_get_peak_memory;
+  MEM_get_memory_in_use_by_category = MEM_guarded_get_memory_in_use_by_category;
 
 #ifndef NDEBUG
   MEM_name_ptr = MEM_guarded_name_ptr;
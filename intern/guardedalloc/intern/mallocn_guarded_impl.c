@@ -81,7 +81,8 @@ typedef struct MemHead {
   const char *name;
   const char *nextname;
   int tag2;
-  short pad1;
+  /* #eMEM_Category the block is accounted to. */
+  short category;
   /* if non-zero aligned allocation was used and alignment is stored here. */
   short alignment;
 #ifdef DEBUG_MEMCOUNTER
@@ -146,6 +147,7 @@ static const char *check_memlist(MemHead *memh);
 
 static unsigned int totblock = 0;
 static size_t mem_in_use = 0, peak_mem = 0;
+static size_t mem_in_use_by_category[MEM_CATEGORY_NUM] = {0};
 
 static volatile struct localListBase _membase;
 static volatile struct localListBase *membase = &_membase;
@@ -402,7 +404,7 @@ static void make_memhead_header(MemHead *memh, size_t len, const char *str)
   memh->name = str;
   memh->nextname = NULL;
   memh->len = len;
-  memh->pad1 = 0;
+  memh->category = (short)MEM_category_get();
   memh->alignment = 0;
   memh->tag2 = MEMTAG2;
 
@@ -419,6 +421,7 @@ static void make_memhead_header(MemHead *memh, size_t len, const char *str)
 
   atomic_add_and_fetch_u(&totblock, 1);
   atomic_add_and_fetch_z(&mem_in_use, len);
+  atomic_add_and_fetch_z(&mem_in_use_by_category[memh->category], len);
 
   mem_lock_thread();
   addtail(membase, &memh->next);
@@ -990,6 +993,7 @@ static void rem_memblock(MemHead *memh)
 
   atomic_sub_and_fetch_u(&totblock, 1);
   atomic_sub_and_fetch_z(&mem_in_use, memh->len);
+  atomic_sub_and_fetch_z(&mem_in_use_by_category[memh->category], memh->len);
 
 #ifdef DEBUG_MEMDUPLINAME
   if (memh->need_free_name)
@@ -1177,6 +1181,11 @@ size_t MEM_guarded_get_memory_in_use(void)
   return _mem_in_use;
 }
 
+size_t MEM_guarded_get_memory_in_use_by_category(eMEM_Category category)
+{
+  return mem_in_use_by_category[category];
+}
+
 unsigned int MEM_guarded_get_memory_blocks_in_use(void)
 {
   unsigned int _totblock;
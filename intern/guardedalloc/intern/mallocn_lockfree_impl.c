@@ -6,7 +6,9 @@
  * Memory allocation which keeps track on allocated memory counters
  */
 
+#include <assert.h>
 #include <stdarg.h>
+#include <stdint.h>
 #include <stdio.h> /* printf */
 #include <stdlib.h>
 #include <string.h> /* memcpy */
@@ -17,7 +19,6 @@
 /* to ensure strict conversions */
 #include "../../source/blender/blenlib/BLI_strict_flags.h"
 
-#include "atomic_ops.h"
 #include "mallocn_intern.h"
 
 typedef struct MemHead {
@@ -30,8 +31,6 @@ typedef struct MemHeadAligned {
   size_t len;
 } MemHeadAligned;
 
-static unsigned int totblock = 0;
-static size_t mem_in_use = 0, peak_mem = 0;
 static bool malloc_debug_memset = false;
 
 static void (*error_callback)(const char *) = NULL;
@@ -45,17 +44,20 @@ enum {
 #define MEMHEAD_ALIGNED_FROM_PTR(ptr) (((MemHeadAligned *)ptr) - 1)
 #define MEMHEAD_IS_ALIGNED(memhead) ((memhead)->len & (size_t)MEMHEAD_ALIGN_FLAG)
 
-/* Uncomment this to have proper peak counter. */
-#define USE_ATOMIC_MAX
-
-MEM_INLINE void update_maximum(size_t *maximum_value, size_t value)
-{
-#ifdef USE_ATOMIC_MAX
-  atomic_fetch_and_update_max_z(maximum_value, value);
+#if SIZE_MAX > UINT32_MAX
+/* The category of the block is stored in the highest bits of its length, which are never used
+ * by actual lengths. */
+#  define MEMHEAD_CATEGORY_SHIFT (sizeof(size_t) * 8 - 4)
+#  define MEMHEAD_CATEGORY_FLAG(category) ((size_t)(category) << MEMHEAD_CATEGORY_SHIFT)
+#  define MEMHEAD_CATEGORY(memhead) ((eMEM_Category)((memhead)->len >> MEMHEAD_CATEGORY_SHIFT))
 #else
-  *maximum_value = value > *maximum_value ? value : *maximum_value;
+/* Lengths need all the bits, everything is accounted to the unknown category. */
+#  define MEMHEAD_CATEGORY_FLAG(category) ((size_t)0)
+#  define MEMHEAD_CATEGORY(memhead) MEM_CATEGORY_UNKNOWN
 #endif
-}
+
+#define MEMHEAD_LEN(memhead) \
+  ((memhead)->len & ~(MEMHEAD_CATEGORY_FLAG(0xF) | (size_t)MEMHEAD_ALIGN_FLAG))
 
 #ifdef __GNUC__
 __attribute__((format(printf, 1, 2)))
@@ -79,7 +81,7 @@ print_error(const char *str, ...)
 size_t MEM_lockfree_allocN_len(const void *vmemh)
 {
   if (vmemh) {
-    return MEMHEAD_FROM_PTR(vmemh)->len & ~((size_t)(MEMHEAD_ALIGN_FLAG));
+    return MEMHEAD_LEN(MEMHEAD_FROM_PTR(vmemh));
   }
 
   return 0;
@@ -102,8 +104,7 @@ void MEM_lockfree_freeN(void *vmemh)
     return;
   }
 
-  atomic_sub_and_fetch_u(&totblock, 1);
-  atomic_sub_and_fetch_z(&mem_in_use, len);
+  memory_usage_block_free(len, MEMHEAD_CATEGORY(memh));
 
   if (UNLIKELY(malloc_debug_memset && len)) {
     memset(memh + 1, 255, len);
@@ -222,17 +223,16 @@ void *MEM_lockfree_callocN(size_t len, const char *str)
   memh = (MemHead *)calloc(1, len + sizeof(MemHead));
 
   if (LIKELY(memh)) {
-    memh->len = len;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    update_maximum(&peak_mem, mem_in_use);
+    const eMEM_Category category = MEM_category_get();
+    memh->len = len | MEMHEAD_CATEGORY_FLAG(category);
+    memory_usage_block_alloc(len, category);
 
     return PTR_FROM_MEMHEAD(memh);
   }
   print_error("Calloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
               SIZET_ARG(len),
               str,
-              (unsigned int)mem_in_use);
+              (unsigned int)memory_usage_current());
   return NULL;
 }
 
@@ -246,7 +246,7 @@ void *MEM_lockfree_calloc_arrayN(size_t len, size_t size, const char *str)
         SIZET_ARG(len),
         SIZET_ARG(size),
         str,
-        (unsigned int)mem_in_use);
+        (unsigned int)memory_usage_current());
     abort();
     return NULL;
   }
@@ -267,17 +267,16 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
       memset(memh + 1, 255, len);
     }
 
-    memh->len = len;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    update_maximum(&peak_mem, mem_in_use);
+    const eMEM_Category category = MEM_category_get();
+    memh->len = len | MEMHEAD_CATEGORY_FLAG(category);
+    memory_usage_block_alloc(len, category);
 
     return PTR_FROM_MEMHEAD(memh);
   }
   print_error("Malloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
               SIZET_ARG(len),
               str,
-              (unsigned int)mem_in_use);
+              (unsigned int)memory_usage_current());
   return NULL;
 }
 
@@ -291,7 +290,7 @@ void *MEM_lockfree_malloc_arrayN(size_t len, size_t size, const char *str)
         SIZET_ARG(len),
         SIZET_ARG(size),
         str,
-        (unsigned int)mem_in_use);
+        (unsigned int)memory_usage_current());
     abort();
     return NULL;
   }
@@ -337,18 +336,17 @@ void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str
       memset(memh + 1, 255, len);
     }
 
-    memh->len = len | (size_t)MEMHEAD_ALIGN_FLAG;
+    const eMEM_Category category = MEM_category_get();
+    memh->len = len | MEMHEAD_CATEGORY_FLAG(category) | (size_t)MEMHEAD_ALIGN_FLAG;
     memh->alignment = (short)alignment;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    update_maximum(&peak_mem, mem_in_use);
+    memory_usage_block_alloc(len, category);
 
     return PTR_FROM_MEMHEAD(memh);
   }
   print_error("Malloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
               SIZET_ARG(len),
               str,
-              (unsigned int)mem_in_use);
+              (unsigned int)memory_usage_current());
   return NULL;
 }
 
@@ -368,8 +366,8 @@ void MEM_lockfree_callbackmemlist(void (*func)(void *))
 
 void MEM_lockfree_printmemlist_stats(void)
 {
-  printf("\ntotal memory len: %.3f MB\n", (double)mem_in_use / (double)(1024 * 1024));
-  printf("peak memory len: %.3f MB\n", (double)peak_mem / (double)(1024 * 1024));
+  printf("\ntotal memory len: %.3f MB\n", (double)memory_usage_current() / (double)(1024 * 1024));
+  printf("peak memory len: %.3f MB\n", (double)memory_usage_peak() / (double)(1024 * 1024));
   printf(
       "\nFor more detailed per-block statistics run Blender with memory debugging command line "
       "argument.\n");
@@ -397,23 +395,27 @@ void MEM_lockfree_set_memory_debug(void)
 
 size_t MEM_lockfree_get_memory_in_use(void)
 {
-  return mem_in_use;
+  return memory_usage_current();
 }
 
 unsigned int MEM_lockfree_get_memory_blocks_in_use(void)
 {
-  return totblock;
+  return (unsigned int)memory_usage_block_num();
 }
 
-/* dummy */
 void MEM_lockfree_reset_peak_memory(void)
 {
-  peak_mem = mem_in_use;
+  memory_usage_peak_reset();
 }
 
 size_t MEM_lockfree_get_peak_memory(void)
 {
-  return peak_mem;
+  return memory_usage_peak();
+}
+
+size_t MEM_lockfree_get_memory_in_use_by_category(eMEM_Category category)
+{
+  return memory_usage_category_current(category);
 }
 
 #ifndef NDEBUG
@@ -0,0 +1,262 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup intern_mem
+ *
+ * Memory usage counters of the lock-free allocator.
+ *
+ * Updating a single global atomic counter from every allocation makes all threads fight over
+ * the same cache line. Instead, every thread has its own counters that only it writes to, and
+ * the totals are computed by summing them when queried, which is rare.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "MEM_guardedalloc.h"
+#include "mallocn_intern.h"
+
+namespace {
+
+/**
+ * Peak memory is only updated when the memory in use of a thread grew by this amount since its
+ * last update, to avoid summing the counters of all threads on every allocation.
+ */
+constexpr int64_t peak_update_threshold = 1024 * 1024;
+
+struct Local;
+
+struct Global {
+  /** Protects #locals, which is only modified when threads start and stop allocating. */
+  std::mutex locals_mutex;
+  std::vector<Local *> locals;
+
+  /**
+   * Usage of threads that exited, and of allocations done after the main thread started
+   * shutting down, when #use_local_counters is false.
+   */
+  std::atomic<int64_t> blocks_num_outside_locals = 0;
+  std::atomic<int64_t> mem_in_use_outside_locals = 0;
+  std::atomic<int64_t> mem_in_use_by_category_outside_locals[MEM_CATEGORY_NUM] = {};
+
+  std::atomic<size_t> peak = 0;
+};
+
+/**
+ * Counters of a single thread. They are atomic so that other threads can read them, but only the
+ * owning thread writes them, so that no atomic read-modify-write is necessary.
+ *
+ * Freeing a block allocated by another thread decrements the counters of the freeing thread,
+ * so a thread's counters can be negative, only their sum is meaningful.
+ */
+struct Local {
+  std::atomic<int64_t> blocks_num = 0;
+  std::atomic<int64_t> mem_in_use = 0;
+  std::atomic<int64_t> mem_in_use_by_category[MEM_CATEGORY_NUM] = {};
+  int64_t mem_in_use_during_peak_update = 0;
+  bool is_main = false;
+
+  Local();
+  ~Local();
+};
+
+/**
+ * Thread local storage is destructed before static variables, but memory is still freed when
+ * static variables are destructed. Global counters are used once the main thread storage is
+ * destructed, so that it is never accessed afterwards.
+ */
+std::atomic<bool> use_local_counters = true;
+
+/** Category of the blocks allocated by the thread, trivially destructible unlike #Local. */
+thread_local eMEM_Category current_category = MEM_CATEGORY_UNKNOWN;
+
+const char *category_names[MEM_CATEGORY_NUM] = {
+    "Unknown",
+    "Undo",
+    "Draw",
+    "Geometry",
+    "Image",
+    "Render",
+};
+
+}  // namespace
+
+static Global &get_global()
+{
+  /* Never destructed, the leak detector reads the counters when static variables are
+   * destructed, which may happen after this would be destructed. */
+  static Global &global = *new Global();
+  return global;
+}
+
+static Local &get_local_data()
+{
+  static thread_local Local local;
+  return local;
+}
+
+Local::Local()
+{
+  Global &global = get_global();
+  std::lock_guard lock{global.locals_mutex};
+  /* The first thread to allocate memory is the main thread. */
+  is_main = global.locals.empty();
+  global.locals.push_back(this);
+}
+
+Local::~Local()
+{
+  Global &global = get_global();
+  std::lock_guard lock{global.locals_mutex};
+  global.locals.erase(std::find(global.locals.begin(), global.locals.end(), this));
+  global.blocks_num_outside_locals.fetch_add(blocks_num.load(std::memory_order_relaxed),
+                                             std::memory_order_relaxed);
+  global.mem_in_use_outside_locals.fetch_add(mem_in_use.load(std::memory_order_relaxed),
+                                             std::memory_order_relaxed);
+  for (int i = 0; i < MEM_CATEGORY_NUM; i++) {
+    global.mem_in_use_by_category_outside_locals[i].fetch_add(
+        mem_in_use_by_category[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+  if (is_main) {
+    use_local_counters.store(false, std::memory_order_relaxed);
+  }
+}
+
+static size_t get_blocks_num()
+{
+  Global &global = get_global();
+  std::lock_guard lock{global.locals_mutex};
+  int64_t blocks_num = global.blocks_num_outside_locals.load(std::memory_order_relaxed);
+  for (const Local *local : global.locals) {
+    blocks_num += local->blocks_num.load(std::memory_order_relaxed);
+  }
+  return size_t(std::max<int64_t>(blocks_num, 0));
+}
+
+static size_t get_mem_in_use()
+{
+  Global &global = get_global();
+  std::lock_guard lock{global.locals_mutex};
+  int64_t mem_in_use = global.mem_in_use_outside_locals.load(std::memory_order_relaxed);
+  for (const Local *local : global.locals) {
+    mem_in_use += local->mem_in_use.load(std::memory_order_relaxed);
+  }
+  return size_t(std::max<int64_t>(mem_in_use, 0));
+}
+
+static size_t get_mem_in_use_by_category(const eMEM_Category category)
+{
+  Global &global = get_global();
+  std::lock_guard lock{global.locals_mutex};
+  int64_t mem_in_use = global.mem_in_use_by_category_outside_locals[category].load(
+      std::memory_order_relaxed);
+  for (const Local *local : global.locals) {
+    mem_in_use += local->mem_in_use_by_category[category].load(std::memory_order_relaxed);
+  }
+  return size_t(std::max<int64_t>(mem_in_use, 0));
+}
+
+static void update_global_peak()
+{
+  Global &global = get_global();
+  const size_t mem_in_use = get_mem_in_use();
+  size_t peak = global.peak.load(std::memory_order_relaxed);
+  while (mem_in_use > peak &&
+         !global.peak.compare_exchange_weak(peak, mem_in_use, std::memory_order_relaxed)) {
+    /* Pass. */
+  }
+}
+
+/** Adds \a value to a counter only written by the calling thread. */
+static void local_counter_add(std::atomic<int64_t> &counter, const int64_t value)
+{
+  counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+void memory_usage_block_alloc(const size_t size, const eMEM_Category category)
+{
+  if (LIKELY(use_local_counters.load(std::memory_order_relaxed))) {
+    Local &local = get_local_data();
+    local_counter_add(local.blocks_num, 1);
+    local_counter_add(local.mem_in_use, int64_t(size));
+    local_counter_add(local.mem_in_use_by_category[category], int64_t(size));
+    const int64_t mem_in_use = local.mem_in_use.load(std::memory_order_relaxed);
+    if (mem_in_use - local.mem_in_use_during_peak_update > peak_update_threshold) {
+      local.mem_in_use_during_peak_update = mem_in_use;
+      update_global_peak();
+    }
+  }
+  else {
+    Global &global = get_global();
+    global.blocks_num_outside_locals.fetch_add(1, std::memory_order_relaxed);
+    global.mem_in_use_outside_locals.fetch_add(int64_t(size), std::memory_order_relaxed);
+    global.mem_in_use_by_category_outside_locals[category].fetch_add(int64_t(size),
+                                                                     std::memory_order_relaxed);
+  }
+}
+
+void memory_usage_block_free(const size_t size, const eMEM_Category category)
+{
+  if (LIKELY(use_local_counters.load(std::memory_order_relaxed))) {
+    Local &local = get_local_data();
+    local_counter_add(local.blocks_num, -1);
+    local_counter_add(local.mem_in_use, -int64_t(size));
+    local_counter_add(local.mem_in_use_by_category[category], -int64_t(size));
+    const int64_t mem_in_use = local.mem_in_use.load(std::memory_order_relaxed);
+    /* Keep the threshold relative to the lowest usage, so that growing again updates the peak. */
+    local.mem_in_use_during_peak_update = std::min(local.mem_in_use_during_peak_update,
+                                                   mem_in_use);
+  }
+  else {
+    Global &global = get_global();
+    global.blocks_num_outside_locals.fetch_sub(1, std::memory_order_relaxed);
+    global.mem_in_use_outside_locals.fetch_sub(int64_t(size), std::memory_order_relaxed);
+    global.mem_in_use_by_category_outside_locals[category].fetch_sub(int64_t(size),
+                                                                     std::memory_order_relaxed);
+  }
+}
+
+size_t memory_usage_block_num()
+{
+  return get_blocks_num();
+}
+
+size_t memory_usage_current()
+{
+  return get_mem_in_use();
+}
+
+size_t memory_usage_peak()
+{
+  update_global_peak();
+  return get_global().peak.load(std::memory_order_relaxed);
+}
+
+void memory_usage_peak_reset()
+{
+  get_global().peak.store(get_mem_in_use(), std::memory_order_relaxed);
+}
+
+size_t memory_usage_category_current(const eMEM_Category category)
+{
+  return get_mem_in_use_by_category(category);
+}
+
+eMEM_Category MEM_category_set(const eMEM_Category category)
+{
+  const eMEM_Category previous = current_category;
+  current_category = category;
+  return previous;
+}
+
+eMEM_Category MEM_category_get()
+{
+  return current_category;
+}
+
+const char *MEM_category_name(const eMEM_Category category)
+{
+  return category_names[category];
+}
@@ -40,8 +40,10 @@
  */
 
 #include "MEM_Allocator.h"
+#include <algorithm>
 #include <list>
 #include <queue>
+#include <utility>
 #include <vector>
 
 template<class T> class MEM_CacheLimiter;
@@ -57,6 +59,9 @@ bool MEM_CacheLimiter_is_disabled(void);
 
 template<class T> class MEM_CacheLimiterHandle {
  public:
+  typedef std::list<MEM_CacheLimiterHandle<T> *, MEM_Allocator<MEM_CacheLimiterHandle<T> *>>
+      queue_t;
+
   explicit MEM_CacheLimiterHandle(T *data_, MEM_CacheLimiter<T> *parent_)
       : data(data_), refcount(0), parent(parent_)
   {
@@ -118,7 +123,8 @@ template<class T> class MEM_CacheLimiterHandle {
 
   T *data;
   int refcount;
-  int pos;
+  /** Position in the queue of the cache, which is ordered from least to most recently used. */
+  typename queue_t::iterator pos;
   MEM_CacheLimiter<T> *parent;
 };
 
@@ -134,25 +140,23 @@ template<class T> class MEM_CacheLimiter {
 
   ~MEM_CacheLimiter()
   {
-    int i;
-    for (i = 0; i < queue.size(); i++) {
-      delete queue[i];
+    for (iterator it = queue.begin(); it != queue.end(); it++) {
+      delete *it;
     }
   }
 
   MEM_CacheLimiterHandle<T> *insert(T *elem)
   {
     queue.push_back(new MEM_CacheLimiterHandle<T>(elem, this));
-    queue.back()->pos = queue.size() - 1;
+    queue.back()->pos = std::prev(queue.end());
     return queue.back();
   }
 
   void unmanage(MEM_CacheLimiterHandle<T> *handle)
   {
-    int pos = handle->pos;
-    queue[pos] = queue.back();
-    queue[pos]->pos = pos;
-    queue.pop_back();
+    /* Erase instead of moving the last element into the gap, that would make the most recently
+     * used element the next one to be freed. */
+    queue.erase(handle->pos);
     delete handle;
   }
 
@@ -160,9 +164,8 @@ template<class T> class MEM_CacheLimiter {
   {
     size_t size = 0;
     if (data_size_func) {
-      int i;
-      for (i = 0; i < queue.size(); i++) {
-        size += data_size_func(queue[i]->get()->get_data());
+      for (iterator it = queue.begin(); it != queue.end(); it++) {
+        size += data_size_func((*it)->get()->get_data());
       }
     }
     else {
@@ -191,11 +194,12 @@ template<class T> class MEM_CacheLimiter {
       return;
     }
 
-    while (!queue.empty() && mem_in_use > max) {
-      MEM_CacheElementPtr elem = get_least_priority_destroyable_element();
+    /* Sort the elements by priority once, instead of searching the least priority element
+     * again for every element that is freed. */
+    std::vector<std::pair<int, MEM_CacheElementPtr>> elements = get_destroyable_elements();
 
-      if (!elem)
-        break;
+    for (size_t i = 0; i < elements.size() && mem_in_use > max; i++) {
+      MEM_CacheElementPtr elem = elements[i].second;
 
       if (data_size_func) {
         cur_size = data_size_func(elem->get()->get_data());
@@ -217,17 +221,9 @@ template<class T> class MEM_CacheLimiter {
 
   void touch(MEM_CacheLimiterHandle<T> *handle)
   {
-    /* If we're using custom priority callback re-arranging the queue
-     * doesn't make much sense because we'll iterate it all to get
-     * least priority element anyway.
-     */
-    if (item_priority_func == NULL) {
-      queue[handle->pos] = queue.back();
-      queue[handle->pos]->pos = handle->pos;
-      queue.pop_back();
-      queue.push_back(handle);
-      handle->pos = queue.size() - 1;
-    }
+    /* Move the element to the end of the queue, the iterator stays valid. The order is also used
+     * for the default priority passed to the priority callback. */
+    queue.splice(queue.end(), queue, handle->pos);
   }
 
   void set_item_priority_func(MEM_CacheLimiter_ItemPriority_Func item_priority_func)
@@ -242,7 +238,7 @@ template<class T> class MEM_CacheLimiter {
 
  private:
   typedef MEM_CacheLimiterHandle<T> *MEM_CacheElementPtr;
-  typedef std::vector<MEM_CacheElementPtr, MEM_Allocator<MEM_CacheElementPtr>> MEM_CacheQueue;
+  typedef typename MEM_CacheLimiterHandle<T>::queue_t MEM_CacheQueue;
   typedef typename MEM_CacheQueue::iterator iterator;
 
   /* Check whether element can be destroyed when enforcing cache limits */
@@ -259,46 +255,40 @@ template<class T> class MEM_CacheLimiter {
     return true;
   }
 
-  MEM_CacheElementPtr get_least_priority_destroyable_element(void)
+  /**
+   * Get the elements that can be destroyed with their priority, sorted from the lowest to the
+   * highest priority. Without a priority callback the least recently used elements come first.
+   */
+  std::vector<std::pair<int, MEM_CacheElementPtr>> get_destroyable_elements()
   {
-    if (queue.empty())
-      return NULL;
+    std::vector<std::pair<int, MEM_CacheElementPtr>> elements;
+    elements.reserve(queue.size());
 
-    MEM_CacheElementPtr best_match_elem = NULL;
+    int i = 0;
+    for (iterator it = queue.begin(); it != queue.end(); it++, i++) {
+      MEM_CacheElementPtr elem = *it;
 
-    if (!item_priority_func) {
-      for (iterator it = queue.begin(); it != queue.end(); it++) {
-        MEM_CacheElementPtr elem = *it;
-        if (!can_destroy_element(elem))
-          continue;
-        best_match_elem = elem;
-        break;
-      }
-    }
-    else {
-      int best_match_priority = 0;
-      int i;
-
-      for (i = 0; i < queue.size(); i++) {
-        MEM_CacheElementPtr elem = queue[i];
-
-        if (!can_destroy_element(elem))
-          continue;
+      if (!can_destroy_element(elem))
+        continue;
 
-        /* By default 0 means highest priority element. */
-        /* Casting a size type to int is questionable,
-         * but unlikely to cause problems. */
-        int priority = -((int)(queue.size()) - i - 1);
+      /* By default 0 means highest priority element. */
+      /* Casting a size type to int is questionable,
+       * but unlikely to cause problems. */
+      int priority = -((int)(queue.size()) - i - 1);
+      if (item_priority_func) {
         priority = item_priority_func(elem->get()->get_data(), priority);
-
-        if (priority < best_match_priority || best_match_elem == NULL) {
-          best_match_priority = priority;
-          best_match_elem = elem;
-        }
       }
+      elements.push_back(std::make_pair(priority, elem));
     }
 
-    return best_match_elem;
+    /* Keep the queue order for elements with the same priority. */
+    std::stable_sort(elements.begin(),
+                     elements.end(),
+                     [](const std::pair<int, MEM_CacheElementPtr> &a,
+                        const std::pair<int, MEM_CacheElementPtr> &b) {
+                       return a.first < b.first;
+                     });
+    return elements;
   }
 
   MEM_CacheQueue queue;
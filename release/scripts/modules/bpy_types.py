@@ -512,7 +512,9 @@ class Mesh(bpy_types.ID):
 
         self.polygons.foreach_set("loop_total", face_lengths)
         self.polygons.foreach_set("loop_start", loop_starts)
-        self.polygons.foreach_set("vertices", vertex_indices)
+        # The loops are in the same order as the face vertices, setting them directly avoids
+        # the much slower per-polygon access of the dynamically sized `vertices` arrays.
+        self.loops.foreach_set("vertex_index", vertex_indices)
 
         if edges_len or faces_len:
             self.update(
@@ -676,6 +676,10 @@ class NODE_PT_quality(bpy.types.Panel):
 
         col = layout.column()
         col.prop(tree, "use_opencl")
+        if prefs.experimental.use_full_frame_compositor:
+            sub = col.column()
+            sub.active = tree.execution_mode == 'FULL_FRAME'
+            sub.prop(tree, "use_gpu")
         col.prop(tree, "use_groupnode_buffer")
         col.prop(tree, "use_two_pass")
         col.prop(tree, "use_viewer_border")
@@ -706,7 +710,7 @@ class NODE_PT_overlay(Panel):
         col.prop(overlay, "show_context_path", text="Context Path")
         col.prop(snode, "show_annotation", text="Annotations")
 
-        if snode.tree_type == 'GeometryNodeTree':
+        if snode.tree_type in {'GeometryNodeTree', 'CompositorNodeTree'}:
             col.separator()
             col.prop(overlay, "show_timing", text="Timings")
 
@@ -637,6 +637,7 @@ class USERPREF_PT_system_memory(SystemPanel, CenterAlignMixIn, Panel):
         col = layout.column()
         col.prop(system, "texture_time_out", text="Texture Time Out")
         col.prop(system, "texture_collection_rate", text="Garbage Collection Rate")
+        col.prop(system, "texture_memory_limit", text="Memory Limit")
 
         layout.separator()
 
@@ -667,6 +668,7 @@ class USERPREF_PT_system_video_sequencer(SystemPanel, CenterAlignMixIn, Panel):
         layout.separator()
 
         layout.prop(system, "sequencer_proxy_setup")
+        layout.prop(system, "use_hardware_video_decoding")
 
 
 # -----------------------------------------------------------------------------
@@ -2277,6 +2279,8 @@ class USERPREF_PT_experimental_prototypes(ExperimentalPanel, Panel):
                 ({"property": "use_new_point_cloud_type"}, "T75717"),
                 ({"property": "use_full_frame_compositor"}, "T88150"),
                 ({"property": "enable_eevee_next"}, "T93220"),
+                ({"property": "use_undo_skip_unchanged_ids"}, None),
+                ({"property": "use_undo_compression"}, None),
             ),
         )
 
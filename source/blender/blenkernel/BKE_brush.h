@@ -97,6 +97,14 @@ float BKE_brush_curve_strength_clamped(const struct Brush *br, float p, float le
  * Uses the brush curve control to find a strength value.
  */
 float BKE_brush_curve_strength(const struct Brush *br, float p, float len);
+/**
+ * Same as #BKE_brush_curve_strength for an array of distances, replaced by their strength.
+ * The curve preset is only checked once, so that the loops can be vectorized.
+ */
+void BKE_brush_curve_strength_array(const struct Brush *br,
+                                    float *values,
+                                    int values_num,
+                                    float len);
 
 /* Sampling. */
 
@@ -270,6 +270,30 @@ void free_bvhtree_from_editmesh(struct BVHTreeFromEditMesh *data);
  */
 void free_bvhtree_from_mesh(struct BVHTreeFromMesh *data);
 
+/**
+ * Find the nearest element for every coordinate, using the default callback.
+ * Much faster than separate #BLI_bvhtree_find_nearest calls for many coordinates,
+ * see #BLI_bvhtree_find_nearest_batch.
+ *
+ * \param r_nearest: Array of \a co_num items, with initialized index and distance.
+ */
+void BKE_bvhtree_from_mesh_find_nearest_batch(struct BVHTreeFromMesh *data,
+                                              const float (*co)[3],
+                                              int co_num,
+                                              BVHTreeNearest *r_nearest);
+/**
+ * Cast a ray for every origin and (normalized) direction, using the default callback,
+ * see #BLI_bvhtree_ray_cast_batch.
+ *
+ * \param r_hits: Array of \a ray_num items, with initialized index and distance.
+ */
+void BKE_bvhtree_from_mesh_ray_cast_batch(struct BVHTreeFromMesh *data,
+                                          const float (*co)[3],
+                                          const float (*dir)[3],
+                                          int ray_num,
+                                          float radius,
+                                          BVHTreeRayHit *r_hits);
+
 /**
  * Math functions used by callbacks
  */
@@ -296,6 +320,14 @@ BVHTree *BKE_bvhtree_from_pointcloud_get(struct BVHTreeFromPointCloud *data,
 
 void free_bvhtree_from_pointcloud(struct BVHTreeFromPointCloud *data);
 
+/**
+ * Find the nearest point for every coordinate, see #BKE_bvhtree_from_mesh_find_nearest_batch.
+ */
+void BKE_bvhtree_from_pointcloud_find_nearest_batch(struct BVHTreeFromPointCloud *data,
+                                                    const float (*co)[3],
+                                                    int co_num,
+                                                    BVHTreeNearest *r_nearest);
+
 /**
  * BVHCache
  */
@@ -305,9 +337,18 @@ void free_bvhtree_from_pointcloud(struct BVHTreeFromPointCloud *data);
 bool bvhcache_has_tree(const struct BVHCache *bvh_cache, const BVHTree *tree);
 struct BVHCache *bvhcache_init(void);
 /**
- * Frees a BVH-cache.
+ * Frees a BVH-cache. Trees shared with other caches are freed by their last user.
  */
 void bvhcache_free(struct BVHCache *bvh_cache);
+/**
+ * Create a cache for a copy of \a mesh, sharing the trees of \a bvh_cache. The trees are
+ * checked against the data of the copy when they are first requested from it, so that trees
+ * of unchanged geometry are reused, and trees of deformed geometry can be refit instead of
+ * being built again.
+ *
+ * \return Null when there are no trees to share.
+ */
+struct BVHCache *bvhcache_copy_shared(struct BVHCache *bvh_cache, const struct Mesh *mesh);
 
 #ifdef __cplusplus
 }
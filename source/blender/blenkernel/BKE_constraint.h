@@ -264,6 +264,21 @@ void BKE_constraint_panel_expand(struct bConstraint *con);
 
 /* Constraint Evaluation function prototypes */
 
+/**
+ * Initialize \a cob (usually allocated on the stack) for the evaluation of the constraints of an
+ * object or bone, see #BKE_constraints_flush_evalob.
+ */
+void BKE_constraints_init_evalob(struct bConstraintOb *cob,
+                                 struct Depsgraph *depsgraph,
+                                 struct Scene *scene,
+                                 struct Object *ob,
+                                 void *subdata,
+                                 short datatype);
+/**
+ * Copy the result of constraint evaluation initialized with #BKE_constraints_init_evalob
+ * back to the owner.
+ */
+void BKE_constraints_flush_evalob(struct bConstraintOb *cob);
 /**
  * This function MEM_calloc's a #bConstraintOb struct,
  * that will need to be freed after evaluation.
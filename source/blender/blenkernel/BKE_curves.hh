@@ -86,6 +86,15 @@ class CurvesGeometryRuntime {
   mutable Vector<float3> evaluated_normals_cache;
   mutable std::mutex normal_cache_mutex;
   mutable bool normal_cache_dirty = true;
+
+  /**
+   * The length at the end of every evaluated segment, accumulated along each curve. Cyclic curves
+   * have one more segment than evaluated points, so the lengths of every curve start at its first
+   * evaluated point plus the index of the curve.
+   */
+  mutable Vector<float> evaluated_length_cache;
+  mutable std::mutex length_cache_mutex;
+  mutable bool length_cache_dirty = true;
 };
 
 /**
@@ -202,6 +211,20 @@ class CurvesGeometry : public ::CurvesGeometry {
   Span<float> nurbs_weights() const;
   MutableSpan<float> nurbs_weights();
 
+  /**
+   * The method used to calculate the normals of every curve (#NormalMode), on the curve domain.
+   * Call #tag_normals_changed after changes.
+   */
+  VArray<int8_t> normal_mode() const;
+  MutableSpan<int8_t> normal_mode();
+
+  /**
+   * The rotation of the normals around the tangents in radians, on the point domain. The span is
+   * empty when there is no tilt. Call #tag_normals_changed after changes.
+   */
+  Span<float> tilt() const;
+  MutableSpan<float> tilt();
+
   /**
    * The index of a triangle (#MLoopTri) that a curve is attached to.
    * The index is -1, if the curve is not attached.
@@ -259,6 +282,29 @@ class CurvesGeometry : public ::CurvesGeometry {
   Span<int> evaluated_offsets() const;
 
   Span<float3> evaluated_positions() const;
+  /** The direction of every curve at each evaluated point. */
+  Span<float3> evaluated_tangents() const;
+  /** The normals of every curve at each evaluated point, calculated with #normal_mode. */
+  Span<float3> evaluated_normals() const;
+
+  /**
+   * Make sure the accumulated lengths of all curves' evaluated segments are calculated, before
+   * accessing them with #evaluated_lengths_for_curve from multiple threads.
+   */
+  void ensure_evaluated_lengths() const;
+  /**
+   * The length along the curve at the end of every evaluated segment. The length at the first
+   * point is zero and is not stored. Call #ensure_evaluated_lengths first.
+   */
+  Span<float> evaluated_lengths_for_curve(int curve_index, bool cyclic) const;
+  float evaluated_length_total_for_curve(int curve_index, bool cyclic) const;
+
+  /**
+   * Evaluate a generic point attribute of a single curve to its evaluated points, with the
+   * interpolation that is used for the positions. The evaluated offsets and other caches used for
+   * the interpolation are calculated if necessary.
+   */
+  void interpolate_to_evaluated(int curve_index, GSpan src, GMutableSpan dst) const;
 
  private:
   /**
@@ -266,6 +312,9 @@ class CurvesGeometry : public ::CurvesGeometry {
    */
   void ensure_nurbs_basis_cache() const;
 
+  /** The range of a curve's lengths in #CurvesGeometryRuntime::evaluated_length_cache. */
+  IndexRange lengths_range_for_curve(int curve_index, bool cyclic) const;
+
   /* --------------------------------------------------------------------
    * Operations.
    */
@@ -375,8 +424,48 @@ void calculate_evaluated_positions(Span<float3> positions,
                                    Span<int> evaluated_offsets,
                                    MutableSpan<float3> evaluated_positions);
 
+/**
+ * Evaluate generic data to the evaluated points, with linear interpolation for every segment.
+ * \param evaluated_offsets: The same offsets as for #calculate_evaluated_positions.
+ */
+void interpolate_to_evaluated(GSpan src, Span<int> evaluated_offsets, GMutableSpan dst);
+
 }  // namespace bezier
 
+namespace poly {
+
+/**
+ * Calculate the direction of the curve at every point, the bisector of the adjacent segments.
+ */
+void calculate_tangents(Span<float3> positions, bool is_cyclic, MutableSpan<float3> tangents);
+
+/**
+ * Calculate normals perpendicular to the tangent and the Z axis, see #NORMAL_MODE_Z_UP.
+ */
+void calculate_normals_z_up(Span<float3> tangents, MutableSpan<float3> normals);
+
+/**
+ * Calculate normals with the smallest twist along the curve, see #NORMAL_MODE_MINIMUM_TWIST.
+ */
+void calculate_normals_minimum(Span<float3> tangents, bool cyclic, MutableSpan<float3> normals);
+
+/**
+ * Rotate the normals around the tangent at every point by the tilt angle.
+ */
+void rotate_normals_by_tilts(Span<float3> tangents,
+                             Span<float> tilts,
+                             MutableSpan<float3> normals);
+
+/**
+ * Calculate the length along the curve at the end of every segment.
+ * The size of \a lengths is expected to be the number of segments, see #curve_segment_size.
+ */
+void calculate_accumulated_lengths(Span<float3> positions,
+                                   bool cyclic,
+                                   MutableSpan<float> lengths);
+
+}  // namespace poly
+
 namespace catmull_rom {
 
 /**
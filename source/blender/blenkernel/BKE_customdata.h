@@ -479,6 +479,12 @@ void CustomData_set_layer_flag(struct CustomData *data, int type, int flag);
 void CustomData_clear_layer_flag(struct CustomData *data, int type, int flag);
 
 void CustomData_bmesh_set_default(struct CustomData *data, void **block);
+/**
+ * Allocate a block from the memory pool of \a data, leaving its content uninitialized. This is
+ * the only part of #CustomData_to_bmesh_block which is not thread-safe, so it can be used to copy
+ * data in parallel once all blocks are allocated.
+ */
+void CustomData_bmesh_alloc_block(struct CustomData *data, void **block);
 void CustomData_bmesh_free_block(struct CustomData *data, void **block);
 /**
  * Same as #CustomData_bmesh_free_block but zero the memory rather than freeing.
@@ -18,6 +18,7 @@ struct DynamicPaintModifierData;
 struct DynamicPaintRuntime;
 struct Object;
 struct Scene;
+struct TaskPool;
 
 /* Actual surface point */
 typedef struct PaintSurfaceData {
@@ -128,9 +129,16 @@ int dynamicPaint_calculateFrame(struct DynamicPaintSurface *surface,
                                 struct Scene *scene,
                                 struct Object *cObject,
                                 int frame);
+/**
+ * Write an output layer of an image sequence surface to \a filename.
+ *
+ * \param save_pool: When not NULL, the image is filled immediately but encoded and written by a
+ * task in this pool, so that the next frame can be calculated meanwhile.
+ */
 void dynamicPaint_outputSurfaceImage(struct DynamicPaintSurface *surface,
                                      char *filename,
-                                     short output_layer);
+                                     short output_layer,
+                                     struct TaskPool *save_pool);
 
 /* PaintPoint state */
 #define DPAINT_PAINT_NONE -1
@@ -125,6 +125,24 @@ void BKE_effectors_apply(struct ListBase *effectors,
                          float *force,
                          float *wind_force,
                          float *impulse);
+/**
+ * Same as #BKE_effectors_apply for an array of points, evaluating one effector at a time over
+ * chunks of points, in parallel when the effectors allow it. Forces are accumulated into the
+ * arrays of \a points_num items, \a wind_force and \a impulse are optional.
+ */
+void BKE_effectors_apply_array(struct ListBase *effectors,
+                               struct ListBase *colliders,
+                               struct EffectorWeights *weights,
+                               struct EffectedPoint *points,
+                               int points_num,
+                               float (*force)[3],
+                               float (*wind_force)[3],
+                               float (*impulse)[3]);
+/**
+ * Reset the random generators used for noise to their state after #BKE_effectors_create,
+ * so that an effector list can be reused for multiple objects with the same result.
+ */
+void BKE_effectors_random_reset(struct ListBase *effectors);
 void BKE_effectors_free(struct ListBase *lb);
 
 void pd_point_from_particle(struct ParticleSimulationData *sim,
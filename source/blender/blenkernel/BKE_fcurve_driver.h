@@ -117,6 +117,11 @@ bool driver_get_variable_property(struct ChannelDriver *driver,
  * Check if the expression in the driver conforms to the simple subset.
  */
 bool BKE_driver_has_simple_expression(struct ChannelDriver *driver);
+/**
+ * Return the part of the driver expression where the simple subset could not be parsed,
+ * so the expression has to be evaluated by Python. NULL for simple expressions.
+ */
+const char *BKE_driver_simple_expression_error(struct ChannelDriver *driver);
 /**
  * Check if the expression in the driver may depend on the current frame.
  */
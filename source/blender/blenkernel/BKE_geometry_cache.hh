@@ -0,0 +1,108 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bke
+ *
+ * Cache of evaluated geometry per frame, so that procedural or simulated geometry only has to be
+ * computed once and can be played back afterwards.
+ *
+ * Frames are kept in memory (cheap, since geometry components are shared with the evaluated
+ * result) and optionally written to a directory in the background. Frames that were removed from
+ * memory because of the memory limit are read back from disk.
+ *
+ * The files store the attribute arrays of meshes, point clouds and curves without any encoding,
+ * each array aligned so it can be read directly into the final attribute (or mapped).
+ */
+
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "BLI_map.hh"
+#include "BLI_set.hh"
+
+#include "BKE_geometry_set.hh"
+
+struct TaskPool;
+
+namespace blender::bke {
+
+class GeometryFrameCache {
+ private:
+  struct WriteTask;
+
+  struct MemoryFrame {
+    GeometrySet geometry;
+    int64_t size_in_bytes;
+    uint64_t last_used;
+  };
+
+  Map<int, MemoryFrame> memory_frames_;
+  int64_t memory_size_ = 0;
+  int64_t memory_limit_ = 0;
+  uint64_t use_counter_ = 0;
+
+  /** Directory and file name prefix of the disk cache, empty when only the memory is used. */
+  std::string directory_;
+  std::string file_prefix_;
+  /** Frames that are known to be valid on disk, or which are being written. */
+  Set<int> disk_frames_;
+  /** Frames written by this cache, these are removed from disk when the cache is cleared. */
+  Set<int> written_frames_;
+  /** Frames that could not be written, removed from #disk_frames_ when the writes are done. */
+  Vector<int> failed_writes_;
+  std::mutex failed_writes_mutex_;
+  TaskPool *write_pool_ = nullptr;
+
+  std::optional<int> last_evaluated_frame_;
+
+ public:
+  GeometryFrameCache() = default;
+  GeometryFrameCache(const GeometryFrameCache &other) = delete;
+  GeometryFrameCache &operator=(const GeometryFrameCache &other) = delete;
+  ~GeometryFrameCache();
+
+  /**
+   * \param memory_limit: Size in bytes of the frames kept in memory, zero means no limit.
+   */
+  void set_memory_limit(int64_t memory_limit);
+  /**
+   * Use \a directory (an absolute path) for the disk cache, or only keep frames in memory when
+   * it is empty. When the directory changes, frames that exist in it already are used.
+   */
+  void set_disk_directory(StringRefNull directory, StringRefNull file_prefix);
+
+  /**
+   * Call before every evaluation of \a frame. When the same frame is evaluated again, something
+   * other than time has changed, so all cached frames are outdated and removed.
+   */
+  void tag_evaluation(int frame);
+
+  std::optional<GeometrySet> lookup(int frame);
+  void add(int frame, const GeometrySet &geometry);
+
+  /**
+   * Remove all frames from memory, and the files written by this cache from disk.
+   */
+  void clear();
+
+ private:
+  std::string frame_filepath(int frame) const;
+  void wait_for_writes();
+  void free_memory_frames_over_limit(int frame_to_keep);
+};
+
+/**
+ * Whether all data of \a geometry can be stored in a cache file, see #geometry_cache_write_file.
+ */
+bool geometry_cache_file_supports(const GeometrySet &geometry);
+/**
+ * Write the meshes, point clouds and curves of \a geometry to a cache file. Layers with pointers
+ * (like vertex groups) and anonymous attributes are not written.
+ */
+bool geometry_cache_write_file(const GeometrySet &geometry, const char *filepath);
+std::optional<GeometrySet> geometry_cache_read_file(const char *filepath);
+
+}  // namespace blender::bke
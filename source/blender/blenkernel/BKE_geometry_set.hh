@@ -398,6 +398,9 @@ struct GeometrySet {
   /**
    * Modify every (recursive) instance separately. This is often more efficient than realizing all
    * instances just to change the same thing on all of them.
+   *
+   * Geometry that is referenced by multiple instances components is only modified once, the
+   * result is shared with all of them afterwards.
    */
   void modify_geometry_sets(ForeachSubGeometryCallback callback);
 
@@ -195,7 +195,8 @@ enum {
   G_DEBUG_XR = (1 << 19),                    /* XR/OpenXR messages */
   G_DEBUG_XR_TIME = (1 << 20),               /* XR/OpenXR timing messages */
 
-  G_DEBUG_GHOST = (1 << 21), /* Debug GHOST module. */
+  G_DEBUG_GHOST = (1 << 21),      /* Debug GHOST module. */
+  G_DEBUG_DRAW_TRACE = (1 << 22), /* Write viewport frame timings to a trace file. */
 };
 
 #define G_DEBUG_ALL \
@@ -301,6 +301,10 @@ void BKE_image_free_all_gputextures(struct Main *bmain);
  * Same as above but only free animated images.
  */
 void BKE_image_free_anim_gputextures(struct Main *bmain);
+/**
+ * Free the GPU textures of images not used for longer than the texture time out, and of the least
+ * recently used images when over the texture memory limit.
+ */
 void BKE_image_free_old_gputextures(struct Main *bmain);
 
 /**
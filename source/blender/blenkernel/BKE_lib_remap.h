@@ -76,6 +76,17 @@ enum {
    * the 'separate' mesh operator.
    */
   ID_REMAP_FORCE_OBDATA_IN_EDITMODE = 1 << 9,
+  /**
+   * Use the users stored in `bmain->relations` to only process IDs actually using the remapped
+   * ones, instead of checking the pointers of all IDs in Main. Meant for batches of remappings,
+   * where the relations can be built once and reused for all of them.
+   *
+   * The relations are updated with the new usages created by the remapping. They must include
+   * all current users of the remapped IDs, and no freed IDs. IDs which are not in the relations
+   * yet (e.g. added to Main after they were built) are always processed. When a remapped ID is
+   * not in the relations, all IDs are processed.
+   */
+  ID_REMAP_USE_MAIN_RELATIONS = 1 << 10,
 };
 
 typedef enum eIDRemapType {
@@ -30,6 +30,7 @@ extern "C" {
 
 struct BLI_mempool;
 struct BlendThumbnail;
+struct FlatHash;
 struct GHash;
 struct GSet;
 struct IDNameLib_Map;
@@ -84,7 +85,7 @@ typedef enum eMainIDRelationsEntryTags {
 typedef struct MainIDRelations {
   /* Mapping from an ID pointer to all of its parents (IDs using it) and children (IDs it uses).
    * Values are `MainIDRelationsEntry` pointers. */
-  struct GHash *relations_from_pointers;
+  struct FlatHash *relations_from_pointers;
   /* NOTE: we could add more mappings when needed (e.g. from session uuid?). */
 
   short flag;
@@ -202,6 +203,16 @@ void BKE_main_unlock(struct Main *bmain);
 /** Generate the mappings between used IDs and their users, and vice-versa. */
 void BKE_main_relations_create(struct Main *bmain, short flag);
 void BKE_main_relations_free(struct Main *bmain);
+/**
+ * Register \a id_from as a new user of \a id in existing relations of given `bmain`, if any.
+ *
+ * Used to keep the `from_ids` lists of the relations up to date when adding usages of IDs, only
+ * the parents of \a id are updated, not the `to_ids` of \a id_from.
+ */
+void BKE_main_relations_from_id_add(struct Main *bmain,
+                                    struct ID *id,
+                                    struct ID *id_from,
+                                    int usage_flag);
 /** Set or clear given `tag` in all relation entries of given `bmain`. */
 void BKE_main_relations_tag_set(struct Main *bmain, eMainIDRelationsEntryTags tag, bool value);
 
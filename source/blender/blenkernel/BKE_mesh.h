@@ -24,6 +24,7 @@ struct ID;
 struct KeyBlock;
 struct LinkNode;
 struct ListBase;
+struct LoopSplitFanCache;
 struct MDeformVert;
 struct MDisps;
 struct MEdge;
@@ -643,6 +644,31 @@ void BKE_mesh_normals_loop_split(const struct MVert *mverts,
                                  MLoopNorSpaceArray *r_lnors_spacearr,
                                  short (*clnors_data)[2],
                                  int *r_loop_to_poly);
+/**
+ * Same as #BKE_mesh_normals_loop_split, with an optional cache of the smooth fans.
+ *
+ * \param r_fan_cache: When not null and the split angle is not used (custom normals or no angle
+ * limit), the fans of the previous call are reused if the topology arrays are the same, otherwise
+ * they are computed and stored there. Must be freed with #BKE_mesh_loop_split_fan_cache_free.
+ */
+void BKE_mesh_normals_loop_split_ex(const struct MVert *mverts,
+                                    const float (*vert_normals)[3],
+                                    int numVerts,
+                                    struct MEdge *medges,
+                                    int numEdges,
+                                    struct MLoop *mloops,
+                                    float (*r_loopnors)[3],
+                                    int numLoops,
+                                    struct MPoly *mpolys,
+                                    const float (*polynors)[3],
+                                    int numPolys,
+                                    bool use_split_normals,
+                                    float split_angle,
+                                    MLoopNorSpaceArray *r_lnors_spacearr,
+                                    short (*clnors_data)[2],
+                                    int *r_loop_to_poly,
+                                    struct LoopSplitFanCache **r_fan_cache);
+void BKE_mesh_loop_split_fan_cache_free(struct LoopSplitFanCache *fan_cache);
 
 void BKE_mesh_normals_loop_custom_set(const struct MVert *mverts,
                                       const float (*vert_normals)[3],
@@ -696,6 +722,12 @@ void BKE_mesh_calc_normals_split(struct Mesh *mesh);
  */
 void BKE_mesh_calc_normals_split_ex(struct Mesh *mesh,
                                     struct MLoopNorSpaceArray *r_lnors_spacearr);
+/**
+ * Same as #BKE_mesh_calc_normals_split, reusing the smooth fans stored in the runtime data of
+ * \a mesh_cache when \a mesh shares its topology arrays, e.g. a deformed evaluated mesh and its
+ * input mesh.
+ */
+void BKE_mesh_calc_normals_split_cached(struct Mesh *mesh, const struct Mesh *mesh_cache);
 
 /**
  * Higher level functions hiding most of the code needed around call to
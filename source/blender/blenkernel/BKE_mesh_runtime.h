@@ -22,6 +22,7 @@ struct MLoop;
 struct MLoopTri;
 struct MVertTri;
 struct Mesh;
+struct MeshElemMap;
 struct Object;
 struct Scene;
 
@@ -49,6 +50,24 @@ void BKE_mesh_runtime_looptri_recalc(struct Mesh *mesh);
  * \note This is a ported copy of dm_getLoopTriArray(dm).
  */
 const struct MLoopTri *BKE_mesh_runtime_looptri_ensure(const struct Mesh *mesh);
+
+/**
+ * Cached topology maps of the mesh, see the matching `BKE_mesh_*_map_create` functions.
+ * They are computed on first access and freed with the other geometry caches by
+ * #BKE_mesh_runtime_clear_geometry, which must be called when the mesh topology changes.
+ *
+ * \note These functions only fill a cache, and therefore the mesh argument can
+ * be considered logically const. Concurrent access is protected by a mutex.
+ */
+const struct MeshElemMap *BKE_mesh_runtime_vert_poly_map_ensure(const struct Mesh *mesh);
+const struct MeshElemMap *BKE_mesh_runtime_vert_loop_map_ensure(const struct Mesh *mesh);
+const struct MeshElemMap *BKE_mesh_runtime_vert_edge_map_ensure(const struct Mesh *mesh);
+const struct MeshElemMap *BKE_mesh_runtime_edge_poly_map_ensure(const struct Mesh *mesh);
+/**
+ * Cached index of the polygon of each loop.
+ */
+const int *BKE_mesh_runtime_loop_poly_map_ensure(const struct Mesh *mesh);
+
 bool BKE_mesh_runtime_ensure_edit_data(struct Mesh *mesh);
 bool BKE_mesh_runtime_clear_edit_data(struct Mesh *mesh);
 bool BKE_mesh_runtime_reset_edit_data(struct Mesh *mesh);
@@ -902,6 +902,37 @@ void BKE_node_preview_merge_tree(struct bNodeTree *to_ntree,
                                  struct bNodeTree *from_ntree,
                                  bool remove_old);
 
+/* Node Execution Statistics */
+
+/** Runtime statistics of a node instance from the latest node tree execution. */
+typedef struct bNodeExecutionStats {
+  /** Time spent executing the node, in microseconds. */
+  uint64_t time_us;
+  /** Size of the buffers allocated for the node results, in bytes. */
+  uint64_t mem_size;
+} bNodeExecutionStats;
+
+/**
+ * Statistics of given node instance, added zeroed if missing.
+ */
+bNodeExecutionStats *BKE_node_execution_stats_ensure(struct bNodeTree *ntree,
+                                                     bNodeInstanceKey key);
+/**
+ * Statistics of given node instance, or NULL if the node was not executed.
+ */
+const bNodeExecutionStats *BKE_node_execution_stats_get(const struct bNodeTree *ntree,
+                                                        bNodeInstanceKey key);
+void BKE_node_execution_stats_clear(struct bNodeTree *ntree);
+/**
+ * Sets the statistics of group nodes to the sum of the statistics of the nodes inside them.
+ */
+void BKE_node_execution_stats_accumulate_groups(struct bNodeTree *ntree);
+/**
+ * Moves the statistics of \a from_ntree to \a to_ntree, replacing the existing ones.
+ */
+void BKE_node_execution_stats_merge_tree(struct bNodeTree *to_ntree,
+                                         struct bNodeTree *from_ntree);
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -64,6 +64,8 @@ typedef enum {
 
   PBVH_UpdateTopology = 1 << 13,
   PBVH_UpdateColor = 1 << 14,
+  /** Only the mask changed, draw buffers of mesh PBVH only update their mask attribute. */
+  PBVH_UpdateMaskDrawBuffers = 1 << 15,
 } PBVHNodeFlags;
 
 typedef struct PBVHFrustumPlanes {
@@ -65,6 +65,7 @@ struct BlendDataReader;
 struct BlendWriter;
 struct ClothModifierData;
 struct DynamicPaintSurface;
+struct FileReader;
 struct FluidModifierData;
 struct ListBase;
 struct Main;
@@ -91,6 +92,8 @@ typedef struct PTCacheData {
 
 typedef struct PTCacheFile {
   FILE *fp;
+  /** Used instead of `fp` when reading, the file is memory-mapped when possible. */
+  struct FileReader *reader;
 
   int frame, old_format;
   unsigned int totpoint, type;
@@ -20,6 +20,7 @@ struct OpenSubdiv_Converter;
 struct OpenSubdiv_Evaluator;
 struct OpenSubdiv_TopologyRefiner;
 struct Subdiv;
+struct SubdivMeshCache;
 
 typedef enum eSubdivVtxBoundaryInterpolation {
   /* Do not interpolate boundaries. */
@@ -183,6 +184,8 @@ typedef struct Subdiv {
      * In total this array has a size of `num base faces + 1`.
      */
     int *face_ptex_offset;
+    /* Result of the last #BKE_subdiv_to_mesh, reused when only coarse positions change. */
+    struct SubdivMeshCache *mesh;
   } cache_;
 } Subdiv;
 
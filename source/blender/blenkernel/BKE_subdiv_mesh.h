@@ -16,6 +16,7 @@ extern "C" {
 struct Mesh;
 struct MEdge;
 struct Subdiv;
+struct SubdivMeshCache;
 
 typedef struct SubdivToMeshSettings {
   /* Resolution at which regular ptex (created for quad polygon) are being
@@ -42,6 +43,10 @@ void BKE_subdiv_mesh_interpolate_position_on_edge(const struct Mesh *coarse_mesh
                                                   bool is_simple,
                                                   float u,
                                                   float pos_r[3]);
+
+/* Free the result cache of #BKE_subdiv_to_mesh, stored in the subdivision descriptor. */
+void BKE_subdiv_mesh_cache_free(struct SubdivMeshCache *cache);
+
 #ifdef __cplusplus
 }
 #endif
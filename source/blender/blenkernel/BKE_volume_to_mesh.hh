@@ -37,6 +37,14 @@ struct OpenVDBMeshData {
   }
 };
 
+/**
+ * Use a coarser resolution when volumes are simplified in the viewport, like the grids that are
+ * loaded with a lower resolution already. The grid resolution mode is unchanged for that reason.
+ * \return False when no mesh should be generated, because the simplify factor is zero.
+ */
+bool volume_to_mesh_resolution_simplify(VolumeToMeshResolution &resolution,
+                                        float simplify_factor);
+
 struct Mesh *volume_to_mesh(const openvdb::GridBase &grid,
                             const VolumeToMeshResolution &resolution,
                             float threshold,
@@ -616,8 +616,9 @@ static void mesh_calc_modifier_final_normals(const Mesh *mesh_input,
                                 (final_datamask->lmask & CD_MASK_NORMAL) != 0);
 
   if (do_loop_normals) {
-    /* Compute loop normals (NOTE: will compute poly and vert normals as well, if needed!). */
-    BKE_mesh_calc_normals_split(mesh_final);
+    /* Compute loop normals (NOTE: will compute poly and vert normals as well, if needed!).
+     * Deform-only stacks share the topology of the input mesh, which keeps the smooth fans. */
+    BKE_mesh_calc_normals_split_cached(mesh_final, mesh_input);
     BKE_mesh_tessface_clear(mesh_final);
   }
 
@@ -1758,6 +1759,54 @@ static void object_get_datamask(const Depsgraph *depsgraph,
   }
 }
 
+/**
+ * When the evaluated mesh is only deformed and the original mesh did not change, the topology of
+ * the evaluated mesh stays the same. Take the previous result out of the object in that case, so
+ * its draw cache can be moved to the new result instead of extracting topology buffers again.
+ */
+static Mesh *mesh_eval_take_for_batch_cache_reuse(Object *ob)
+{
+  ID *data_eval = ob->runtime.data_eval;
+  if (data_eval == nullptr || GS(data_eval->name) != ID_ME || !ob->runtime.is_data_eval_owned ||
+      ob->runtime.data_orig == nullptr || ob->runtime.editmesh_eval_cage != nullptr ||
+      ob->sculpt != nullptr) {
+    return nullptr;
+  }
+
+  Mesh *mesh_eval = reinterpret_cast<Mesh *>(data_eval);
+  if (mesh_eval->runtime.batch_cache == nullptr || !mesh_eval->runtime.deformed_only ||
+      mesh_eval->edit_mesh != nullptr) {
+    return nullptr;
+  }
+
+  /* Tagged changes of the original mesh may change its topology. */
+  if (ob->runtime.data_orig->recalc & (ID_RECALC_GEOMETRY | ID_RECALC_COPY_ON_WRITE)) {
+    return nullptr;
+  }
+
+  ob->runtime.data_eval = nullptr;
+  return mesh_eval;
+}
+
+static void mesh_eval_reuse_batch_cache(Object *ob, Mesh *mesh_eval_prev)
+{
+  ID *data_eval = ob->runtime.data_eval;
+  if (data_eval != nullptr && GS(data_eval->name) == ID_ME && ob->runtime.is_data_eval_owned) {
+    Mesh *mesh_eval = reinterpret_cast<Mesh *>(data_eval);
+    if (mesh_eval->runtime.batch_cache == nullptr && mesh_eval->runtime.deformed_only &&
+        mesh_eval->edit_mesh == nullptr && mesh_eval->totvert == mesh_eval_prev->totvert &&
+        mesh_eval->totedge == mesh_eval_prev->totedge &&
+        mesh_eval->totpoly == mesh_eval_prev->totpoly &&
+        mesh_eval->totloop == mesh_eval_prev->totloop) {
+      mesh_eval->runtime.batch_cache = mesh_eval_prev->runtime.batch_cache;
+      mesh_eval_prev->runtime.batch_cache = nullptr;
+      BKE_mesh_batch_cache_dirty_tag(mesh_eval, BKE_MESH_BATCH_DIRTY_DEFORM);
+    }
+  }
+
+  BKE_mesh_eval_delete(mesh_eval_prev);
+}
+
 void makeDerivedMesh(struct Depsgraph *depsgraph,
                      const Scene *scene,
                      Object *ob,
@@ -1769,6 +1818,7 @@ void makeDerivedMesh(struct Depsgraph *depsgraph,
    * they aren't cleaned up properly on mode switch, causing crashes, e.g T58150. */
   BLI_assert(ob->id.tag & LIB_TAG_COPIED_ON_WRITE);
 
+  Mesh *mesh_eval_prev = mesh_eval_take_for_batch_cache_reuse(ob);
   BKE_object_free_derived_caches(ob);
   if (DEG_is_active(depsgraph)) {
     BKE_sculpt_update_object_before_eval(ob);
@@ -1790,6 +1840,10 @@ void makeDerivedMesh(struct Depsgraph *depsgraph,
   else {
     mesh_build_data(depsgraph, scene, ob, &cddata_masks, need_mapping);
   }
+
+  if (mesh_eval_prev != nullptr) {
+    mesh_eval_reuse_batch_cache(ob, mesh_eval_prev);
+  }
 }
 
 /***/
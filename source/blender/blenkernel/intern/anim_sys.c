@@ -20,6 +20,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -363,11 +364,14 @@ static bool is_fcurve_evaluatable(FCurve *fcu)
   return true;
 }
 
-bool BKE_animsys_rna_path_resolve(PointerRNA *ptr,
-                                  /* typically 'fcu->rna_path', 'fcu->array_index' */
-                                  const char *rna_path,
-                                  const int array_index,
-                                  PathResolvedRNA *r_result)
+/**
+ * Resolve the property of \a rna_path, the array index is checked separately with
+ * #animsys_rna_path_resolve_index. \a array_index is only used for reporting.
+ */
+static bool animsys_rna_path_resolve_property(PointerRNA *ptr,
+                                              const char *rna_path,
+                                              const int array_index,
+                                              PathResolvedRNA *r_result)
 {
   if (rna_path == NULL) {
     return false;
@@ -391,14 +395,21 @@ bool BKE_animsys_rna_path_resolve(PointerRNA *ptr,
   if (ptr->owner_id != NULL && !RNA_property_animateable(&r_result->ptr, r_result->prop)) {
     return false;
   }
+  return true;
+}
 
+static bool animsys_rna_path_resolve_index(PointerRNA *ptr,
+                                           const char *rna_path,
+                                           const int array_index,
+                                           PathResolvedRNA *r_result)
+{
   int array_len = RNA_property_array_length(&r_result->ptr, r_result->prop);
   if (array_len && array_index >= array_len) {
     if (G.debug & G_DEBUG) {
       CLOG_WARN(&LOG,
                 "Animato: Invalid array index. ID = '%s',  '%s[%d]', array length is %d",
                 (ptr->owner_id) ? (ptr->owner_id->name + 2) : "<No ID>",
-                path,
+                rna_path,
                 array_index,
                 array_len - 1);
     }
@@ -409,6 +420,50 @@ bool BKE_animsys_rna_path_resolve(PointerRNA *ptr,
   return true;
 }
 
+bool BKE_animsys_rna_path_resolve(PointerRNA *ptr,
+                                  /* typically 'fcu->rna_path', 'fcu->array_index' */
+                                  const char *rna_path,
+                                  const int array_index,
+                                  PathResolvedRNA *r_result)
+{
+  return animsys_rna_path_resolve_property(ptr, rna_path, array_index, r_result) &&
+         animsys_rna_path_resolve_index(ptr, rna_path, array_index, r_result);
+}
+
+/**
+ * The F-Curves of one property (e.g. the components of a location) are usually next to each
+ * other. Resolving the path is much more expensive than evaluating a curve, so the property of the
+ * previous path is kept and reused when the next F-Curve has the same path.
+ */
+typedef struct AnimsysPathCache {
+  /** Path of the previously resolved F-Curve, NULL when nothing was resolved yet. */
+  const char *rna_path;
+  bool is_resolved;
+  PathResolvedRNA resolved;
+} AnimsysPathCache;
+
+static bool animsys_rna_path_resolve_cached(PointerRNA *ptr,
+                                            AnimsysPathCache *cache,
+                                            const char *rna_path,
+                                            const int array_index,
+                                            PathResolvedRNA *r_result)
+{
+  if (rna_path == NULL) {
+    return false;
+  }
+  if (cache->rna_path == NULL ||
+      (cache->rna_path != rna_path && !STREQ(cache->rna_path, rna_path))) {
+    cache->rna_path = rna_path;
+    cache->is_resolved = animsys_rna_path_resolve_property(
+        ptr, rna_path, array_index, &cache->resolved);
+  }
+  if (!cache->is_resolved) {
+    return false;
+  }
+  *r_result = cache->resolved;
+  return animsys_rna_path_resolve_index(ptr, rna_path, array_index, r_result);
+}
+
 /* less than 1.0 evaluates to false, use epsilon to avoid float error */
 #define ANIMSYS_FLOAT_AS_BOOL(value) ((value) > (1.0f - FLT_EPSILON))
 
@@ -589,6 +644,13 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
                                      const AnimationEvalContext *anim_eval_context,
                                      bool flush_to_original)
 {
+  PointerRNA ptr_orig;
+  if (flush_to_original && !animsys_construct_orig_pointer_rna(ptr, &ptr_orig)) {
+    flush_to_original = false;
+  }
+  AnimsysPathCache path_cache = {NULL};
+  AnimsysPathCache orig_path_cache = {NULL};
+
   /* Calculate then execute each curve. */
   LISTBASE_FOREACH (FCurve *, fcu, list) {
 
@@ -597,11 +659,15 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
     }
 
     PathResolvedRNA anim_rna;
-    if (BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+    if (animsys_rna_path_resolve_cached(
+            ptr, &path_cache, fcu->rna_path, fcu->array_index, &anim_rna)) {
       const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
       BKE_animsys_write_to_rna_path(&anim_rna, curval);
-      if (flush_to_original) {
-        animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, curval);
+      PathResolvedRNA orig_anim_rna;
+      if (flush_to_original &&
+          animsys_rna_path_resolve_cached(
+              &ptr_orig, &orig_path_cache, fcu->rna_path, fcu->array_index, &orig_anim_rna)) {
+        BKE_animsys_write_to_rna_path(&orig_anim_rna, curval);
       }
     }
   }
@@ -3260,6 +3326,41 @@ void BKE_animsys_evaluate_animdata(ID *id,
   animsys_evaluate_overrides(&id_ptr, adt);
 }
 
+/** A data-block evaluated by #BKE_animsys_evaluate_all_animation. */
+typedef struct AnimsysEvalAllItem {
+  ID *id;
+  /** Embedded node tree, evaluated before the data-block itself. */
+  bNodeTree *nodetree;
+  eAnimData_Recalc recalc;
+} AnimsysEvalAllItem;
+
+typedef struct AnimsysEvalAllData {
+  const AnimsysEvalAllItem *items;
+  const AnimationEvalContext *anim_eval_context;
+  bool flush_to_original;
+} AnimsysEvalAllData;
+
+static void animsys_evaluate_all_animation_fn(void *__restrict userdata,
+                                              const int index,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const AnimsysEvalAllData *data = userdata;
+  const AnimsysEvalAllItem *item = &data->items[index];
+
+  if (item->nodetree) {
+    BKE_animsys_evaluate_animdata(&item->nodetree->id,
+                                  BKE_animdata_from_id(&item->nodetree->id),
+                                  data->anim_eval_context,
+                                  ADT_RECALC_ANIM,
+                                  data->flush_to_original);
+  }
+  BKE_animsys_evaluate_animdata(item->id,
+                                BKE_animdata_from_id(item->id),
+                                data->anim_eval_context,
+                                item->recalc,
+                                data->flush_to_original);
+}
+
 void BKE_animsys_evaluate_all_animation(Main *main, Depsgraph *depsgraph, float ctime)
 {
   ID *id;
@@ -3272,16 +3373,56 @@ void BKE_animsys_evaluate_all_animation(Main *main, Depsgraph *depsgraph, float
   const AnimationEvalContext anim_eval_context = BKE_animsys_eval_context_construct(depsgraph,
                                                                                     ctime);
 
+  /* optimization:
+   * when there are no actions, don't go over database and loop over heaps of data-blocks,
+   * which should ultimately be empty, since it is not possible for now to have any animation
+   * without some actions, and drivers wouldn't get affected by any state changes
+   *
+   * however, if there are some curves, we will need to make sure that their 'ctime' property gets
+   * set correctly, so this optimization must be skipped in that case...
+   */
+  if (BLI_listbase_is_empty(&main->actions) && BLI_listbase_is_empty(&main->curves)) {
+    if (G.debug & G_DEBUG) {
+      printf("\tNo Actions, so no animation needs to be evaluated...\n");
+    }
+
+    return;
+  }
+
+  /* Gather the data-blocks with animation data first, so they can be evaluated in parallel.
+   * Every data-block only writes to its own properties (drivers are not evaluated here), the
+   * same way the depsgraph evaluates the animation of different data-blocks in parallel. */
+  AnimsysEvalAllItem *items = NULL;
+  int items_len = 0;
+  int items_alloc = 0;
+
   /* macros for less typing
    * - only evaluate animation data for id if it has users (and not just fake ones)
-   * - whether animdata exists is checked for by the evaluation function, though taking
-   *   this outside of the function may make things slightly faster?
+   * - data-blocks without animation data only need to be evaluated for their node tree
    */
+#define EVAL_ANIM_ADD(id_, nodetree_, aflag) \
+  { \
+    bNodeTree *ntree_ = (nodetree_); \
+    if (ntree_ && BKE_animdata_from_id(&ntree_->id) == NULL) { \
+      ntree_ = NULL; \
+    } \
+    if (ntree_ || BKE_animdata_from_id(id_)) { \
+      if (items_len == items_alloc) { \
+        items_alloc = items_alloc ? items_alloc * 2 : 64; \
+        items = MEM_reallocN_id(items, sizeof(*items) * items_alloc, __func__); \
+      } \
+      items[items_len].id = (id_); \
+      items[items_len].nodetree = ntree_; \
+      items[items_len].recalc = (aflag); \
+      items_len++; \
+    } \
+  } \
+  (void)0
+
 #define EVAL_ANIM_IDS(first, aflag) \
   for (id = first; id; id = id->next) { \
     if (ID_REAL_USERS(id) > 0) { \
-      AnimData *adt = BKE_animdata_from_id(id); \
-      BKE_animsys_evaluate_animdata(id, adt, &anim_eval_context, aflag, flush_to_original); \
+      EVAL_ANIM_ADD(id, NULL, aflag); \
     } \
   } \
   (void)0
@@ -3295,34 +3436,12 @@ void BKE_animsys_evaluate_all_animation(Main *main, Depsgraph *depsgraph, float
 #define EVAL_ANIM_NODETREE_IDS(first, NtId_Type, aflag) \
   for (id = first; id; id = id->next) { \
     if (ID_REAL_USERS(id) > 0) { \
-      AnimData *adt = BKE_animdata_from_id(id); \
       NtId_Type *ntp = (NtId_Type *)id; \
-      if (ntp->nodetree) { \
-        AnimData *adt2 = BKE_animdata_from_id((ID *)ntp->nodetree); \
-        BKE_animsys_evaluate_animdata( \
-            &ntp->nodetree->id, adt2, &anim_eval_context, ADT_RECALC_ANIM, flush_to_original); \
-      } \
-      BKE_animsys_evaluate_animdata(id, adt, &anim_eval_context, aflag, flush_to_original); \
+      EVAL_ANIM_ADD(id, ntp->nodetree, aflag); \
     } \
   } \
   (void)0
 
-  /* optimization:
-   * when there are no actions, don't go over database and loop over heaps of data-blocks,
-   * which should ultimately be empty, since it is not possible for now to have any animation
-   * without some actions, and drivers wouldn't get affected by any state changes
-   *
-   * however, if there are some curves, we will need to make sure that their 'ctime' property gets
-   * set correctly, so this optimization must be skipped in that case...
-   */
-  if (BLI_listbase_is_empty(&main->actions) && BLI_listbase_is_empty(&main->curves)) {
-    if (G.debug & G_DEBUG) {
-      printf("\tNo Actions, so no animation needs to be evaluated...\n");
-    }
-
-    return;
-  }
-
   /* nodes */
   EVAL_ANIM_IDS(main->nodetrees.first, ADT_RECALC_ANIM);
 
@@ -3404,6 +3523,22 @@ void BKE_animsys_evaluate_all_animation(Main *main, Depsgraph *depsgraph, float
 
   /* scenes */
   EVAL_ANIM_NODETREE_IDS(main->scenes.first, Scene, ADT_RECALC_ANIM);
+
+#undef EVAL_ANIM_IDS
+#undef EVAL_ANIM_NODETREE_IDS
+#undef EVAL_ANIM_ADD
+
+  AnimsysEvalAllData data = {
+      .items = items,
+      .anim_eval_context = &anim_eval_context,
+      .flush_to_original = flush_to_original,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (items_len > 1);
+  BLI_task_parallel_range(0, items_len, &data, animsys_evaluate_all_animation_fn, &settings);
+
+  MEM_SAFE_FREE(items);
 }
 
 /* ***************************************** */
@@ -2503,26 +2503,26 @@ void BKE_pose_where_is_bone(struct Depsgraph *depsgraph,
   if (do_extra) {
     /* Do constraints */
     if (pchan->constraints.first) {
-      bConstraintOb *cob;
+      bConstraintOb cob;
       float vec[3];
 
       /* make a copy of location of PoseChannel for later */
       copy_v3_v3(vec, pchan->pose_mat[3]);
 
       /* prepare PoseChannel for Constraint solving
-       * - makes a copy of matrix, and creates temporary struct to use
+       * - makes a copy of matrix
        */
-      cob = BKE_constraints_make_evalob(depsgraph, scene, ob, pchan, CONSTRAINT_OBTYPE_BONE);
+      BKE_constraints_init_evalob(&cob, depsgraph, scene, ob, pchan, CONSTRAINT_OBTYPE_BONE);
 
       /* Solve PoseChannel's Constraints */
 
       /* ctime doesn't alter objects. */
-      BKE_constraints_solve(depsgraph, &pchan->constraints, cob, ctime);
+      BKE_constraints_solve(depsgraph, &pchan->constraints, &cob, ctime);
 
       /* cleanup after Constraint Solving
-       * - applies matrix back to pchan, and frees temporary struct used
+       * - applies matrix back to pchan
        */
-      BKE_constraints_clear_evalob(cob);
+      BKE_constraints_flush_evalob(&cob);
 
       /* prevent constraints breaking a chain */
       if (pchan->bone->flag & BONE_CONNECTED) {
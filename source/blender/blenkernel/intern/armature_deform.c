@@ -18,6 +18,7 @@
 
 #include "BLI_listbase.h"
 #include "BLI_math.h"
+#include "BLI_simd.h"
 #include "BLI_task.h"
 #include "BLI_utildefines.h"
 
@@ -46,46 +47,45 @@ static CLG_LogRef LOG = {"bke.armature_deform"};
 /** \name Armature Deform Internal Utilities
  * \{ */
 
-/* Add the effect of one bone or B-Bone segment to the accumulated result. */
+/**
+ * Add the effect of one bone or B-Bone segment to the accumulated result.
+ *
+ * Without dual quaternions, the weighted sum of the deform matrices is accumulated, and applied
+ * to the coordinate once all bones have been added (linear blend skinning).
+ */
 static void pchan_deform_accumulate(const DualQuat *deform_dq,
                                     const float deform_mat[4][4],
-                                    const float co_in[3],
                                     float weight,
-                                    float co_accum[3],
                                     DualQuat *dq_accum,
-                                    float mat_accum[3][3])
+                                    float mat_accum[4][4])
 {
   if (weight == 0.0f) {
     return;
   }
 
   if (dq_accum) {
-    BLI_assert(!co_accum);
+    BLI_assert(!mat_accum);
 
     add_weighted_dq_dq(dq_accum, deform_dq, weight);
   }
   else {
-    float tmp[3];
-    mul_v3_m4v3(tmp, deform_mat, co_in);
-
-    sub_v3_v3(tmp, co_in);
-    madd_v3_v3fl(co_accum, tmp, weight);
-
-    if (mat_accum) {
-      float tmpmat[3][3];
-      copy_m3_m4(tmpmat, deform_mat);
-
-      madd_m3_m3m3fl(mat_accum, mat_accum, tmpmat, weight);
+#ifdef BLI_HAVE_SSE2
+    const __m128 weight_vec = _mm_set1_ps(weight);
+    for (int i = 0; i < 4; i++) {
+      const __m128 col = _mm_mul_ps(_mm_loadu_ps(deform_mat[i]), weight_vec);
+      _mm_storeu_ps(mat_accum[i], _mm_add_ps(_mm_loadu_ps(mat_accum[i]), col));
     }
+#else
+    madd_m4_m4m4fl(mat_accum, mat_accum, deform_mat, weight);
+#endif
   }
 }
 
 static void b_bone_deform(const bPoseChannel *pchan,
                           const float co[3],
                           float weight,
-                          float vec[3],
                           DualQuat *dq,
-                          float defmat[3][3])
+                          float mat_accum[4][4])
 {
   const DualQuat *quats = pchan->runtime.bbone_dual_quats;
   const Mat4 *mats = pchan->runtime.bbone_deform_mats;
@@ -100,9 +100,8 @@ static void b_bone_deform(const bPoseChannel *pchan,
   BKE_pchan_bbone_deform_segment_index(pchan, y / pchan->bone->length, &index, &blend);
 
   pchan_deform_accumulate(
-      &quats[index], mats[index + 1].mat, co, weight * (1.0f - blend), vec, dq, defmat);
-  pchan_deform_accumulate(
-      &quats[index + 1], mats[index + 2].mat, co, weight * blend, vec, dq, defmat);
+      &quats[index], mats[index + 1].mat, weight * (1.0f - blend), dq, mat_accum);
+  pchan_deform_accumulate(&quats[index + 1], mats[index + 2].mat, weight * blend, dq, mat_accum);
 }
 
 float distfactor_to_bone(
@@ -158,8 +157,10 @@ float distfactor_to_bone(
   return 1.0f - (a * a) / (rdist * rdist);
 }
 
-static float dist_bone_deform(
-    bPoseChannel *pchan, float vec[3], DualQuat *dq, float mat[3][3], const float co[3])
+static float dist_bone_deform(bPoseChannel *pchan,
+                              DualQuat *dq,
+                              float mat[4][4],
+                              const float co[3])
 {
   Bone *bone = pchan->bone;
   float fac, contrib = 0.0;
@@ -176,11 +177,10 @@ static float dist_bone_deform(
     contrib = fac;
     if (contrib > 0.0f) {
       if (bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments) {
-        b_bone_deform(pchan, co, fac, vec, dq, mat);
+        b_bone_deform(pchan, co, fac, dq, mat);
       }
       else {
-        pchan_deform_accumulate(
-            &pchan->runtime.deform_dual_quat, pchan->chan_mat, co, fac, vec, dq, mat);
+        pchan_deform_accumulate(&pchan->runtime.deform_dual_quat, pchan->chan_mat, fac, dq, mat);
       }
     }
   }
@@ -188,26 +188,47 @@ static float dist_bone_deform(
   return contrib;
 }
 
-static void pchan_bone_deform(bPoseChannel *pchan,
-                              float weight,
-                              float vec[3],
-                              DualQuat *dq,
-                              float mat[3][3],
-                              const float co[3],
-                              float *contrib)
+/**
+ * Deform data of a vertex group, copied from its pose channel once per evaluation. Deforming a
+ * vertex then reads one compact array indexed by the group, instead of the pose channels and
+ * bones which are large and scattered in memory.
+ */
+typedef struct ArmatureDeformGroup {
+  float deform_mat[4][4];
+  DualQuat deform_dq;
+  /** NULL when the group has no deforming bone. */
+  const bPoseChannel *pchan;
+  bool use_bbone;
+  bool use_envelope_multiply;
+} ArmatureDeformGroup;
+
+static void deform_group_init(ArmatureDeformGroup *group, const bPoseChannel *pchan)
 {
-  Bone *bone = pchan->bone;
+  const Bone *bone = pchan->bone;
+
+  copy_m4_m4(group->deform_mat, pchan->chan_mat);
+  group->deform_dq = pchan->runtime.deform_dual_quat;
+  group->pchan = pchan;
+  group->use_bbone = (bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments);
+  group->use_envelope_multiply = (bone->flag & BONE_MULT_VG_ENV) != 0;
+}
 
+static void deform_group_deform(const ArmatureDeformGroup *group,
+                                float weight,
+                                DualQuat *dq,
+                                float mat[4][4],
+                                const float co[3],
+                                float *contrib)
+{
   if (!weight) {
     return;
   }
 
-  if (bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments) {
-    b_bone_deform(pchan, co, weight, vec, dq, mat);
+  if (group->use_bbone) {
+    b_bone_deform(group->pchan, co, weight, dq, mat);
   }
   else {
-    pchan_deform_accumulate(
-        &pchan->runtime.deform_dual_quat, pchan->chan_mat, co, weight, vec, dq, mat);
+    pchan_deform_accumulate(&group->deform_dq, group->deform_mat, weight, dq, mat);
   }
 
   (*contrib) += weight;
@@ -239,7 +260,7 @@ typedef struct ArmatureUserdata {
   const MDeformVert *dverts;
   int dverts_len;
 
-  bPoseChannel **pchan_from_defbase;
+  const ArmatureDeformGroup *deform_groups;
   int defbase_len;
 
   float premat[4][4];
@@ -266,8 +287,8 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
   DualQuat sumdq, *dq = NULL;
   bPoseChannel *pchan;
   float *co, dco[3];
-  float sumvec[3], summat[3][3];
-  float *vec = NULL, (*smat)[3] = NULL;
+  float summat[3][3], summat4[4][4];
+  float(*smat)[3] = NULL, (*mat)[4] = NULL;
   float contrib = 0.0f;
   float armature_weight = 1.0f; /* default to 1 if no overall def group */
   float prevco_weight = 1.0f;   /* weight for optional cached vertexcos */
@@ -277,13 +298,8 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
     dq = &sumdq;
   }
   else {
-    zero_v3(sumvec);
-    vec = sumvec;
-
-    if (vert_deform_mats) {
-      zero_m3(summat);
-      smat = summat;
-    }
+    zero_m4(summat4);
+    mat = summat4;
   }
 
   if (armature_def_nr != -1 && dvert) {
@@ -317,25 +333,26 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
     unsigned int j;
     for (j = dvert->totweight; j != 0; j--, dw++) {
       const uint index = dw->def_nr;
-      if (index < data->defbase_len && (pchan = data->pchan_from_defbase[index])) {
+      const ArmatureDeformGroup *group;
+      if (index < data->defbase_len && (group = &data->deform_groups[index])->pchan) {
         float weight = dw->weight;
-        Bone *bone = pchan->bone;
 
         deformed = 1;
 
-        if (bone && bone->flag & BONE_MULT_VG_ENV) {
+        if (group->use_envelope_multiply) {
+          const Bone *bone = group->pchan->bone;
           weight *= distfactor_to_bone(
               co, bone->arm_head, bone->arm_tail, bone->rad_head, bone->rad_tail, bone->dist);
         }
 
-        pchan_bone_deform(pchan, weight, vec, dq, smat, co, &contrib);
+        deform_group_deform(group, weight, dq, mat, co, &contrib);
       }
     }
     /* If there are vertex-groups but not groups with bones (like for soft-body groups). */
     if (deformed == 0 && use_envelope) {
       for (pchan = data->ob_arm->pose->chanbase.first; pchan; pchan = pchan->next) {
         if (!(pchan->bone->flag & BONE_NO_DEFORM)) {
-          contrib += dist_bone_deform(pchan, vec, dq, smat, co);
+          contrib += dist_bone_deform(pchan, dq, mat, co);
         }
       }
     }
@@ -343,7 +360,7 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
   else if (use_envelope) {
     for (pchan = data->ob_arm->pose->chanbase.first; pchan; pchan = pchan->next) {
       if (!(pchan->bone->flag & BONE_NO_DEFORM)) {
-        contrib += dist_bone_deform(pchan, vec, dq, smat, co);
+        contrib += dist_bone_deform(pchan, dq, mat, co);
       }
     }
   }
@@ -367,8 +384,15 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
       smat = summat;
     }
     else {
-      mul_v3_fl(vec, armature_weight / contrib);
-      add_v3_v3v3(co, vec, co);
+      /* The accumulated offset is `sum(weight * (mat * co - co))`. */
+      mul_v3_m4v3(dco, summat4, co);
+      madd_v3_v3fl(dco, co, -contrib);
+      madd_v3_v3fl(co, dco, armature_weight / contrib);
+
+      if (vert_deform_mats) {
+        copy_m3_m4(summat, summat4);
+        smat = summat;
+      }
     }
 
     if (vert_deform_mats) {
@@ -460,7 +484,7 @@ static void armature_deform_coords_impl(const Object *ob_arm,
                                         bGPDstroke *gps_target)
 {
   bArmature *arm = ob_arm->data;
-  bPoseChannel **pchan_from_defbase = NULL;
+  ArmatureDeformGroup *deform_groups = NULL;
   const MDeformVert *dverts = NULL;
   bDeformGroup *dg;
   const bool use_envelope = (deformflag & ARM_DEF_ENVELOPE) != 0;
@@ -528,19 +552,17 @@ static void armature_deform_coords_impl(const Object *ob_arm,
       }
 
       if (use_dverts) {
-        pchan_from_defbase = MEM_callocN(sizeof(*pchan_from_defbase) * defbase_len, "defnrToBone");
+        deform_groups = MEM_calloc_arrayN(defbase_len, sizeof(*deform_groups), "defnrToBone");
         /* TODO(sergey): Some considerations here:
          *
          * - Check whether keeping this consistent across frames gives speedup.
          */
         const ListBase *defbase = BKE_object_defgroup_list(ob_target);
         for (i = 0, dg = defbase->first; dg; i++, dg = dg->next) {
-          pchan_from_defbase[i] = BKE_pose_channel_find_name(ob_arm->pose, dg->name);
+          const bPoseChannel *pchan = BKE_pose_channel_find_name(ob_arm->pose, dg->name);
           /* exclude non-deforming bones */
-          if (pchan_from_defbase[i]) {
-            if (pchan_from_defbase[i]->bone->flag & BONE_NO_DEFORM) {
-              pchan_from_defbase[i] = NULL;
-            }
+          if (pchan && !(pchan->bone->flag & BONE_NO_DEFORM)) {
+            deform_group_init(&deform_groups[i], pchan);
           }
         }
       }
@@ -561,7 +583,7 @@ static void armature_deform_coords_impl(const Object *ob_arm,
       .armature_def_nr = armature_def_nr,
       .dverts = dverts,
       .dverts_len = dverts_len,
-      .pchan_from_defbase = pchan_from_defbase,
+      .deform_groups = deform_groups,
       .defbase_len = defbase_len,
       .bmesh =
           {
@@ -599,8 +621,8 @@ static void armature_deform_coords_impl(const Object *ob_arm,
     BLI_task_parallel_range(0, vert_coords_len, &data, armature_vert_task, &settings);
   }
 
-  if (pchan_from_defbase) {
-    MEM_freeN(pchan_from_defbase);
+  if (deform_groups) {
+    MEM_freeN(deform_groups);
   }
 }
 
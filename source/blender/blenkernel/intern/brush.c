@@ -2454,6 +2454,78 @@ float BKE_brush_curve_strength(const Brush *br, float p, const float len)
   return strength;
 }
 
+void BKE_brush_curve_strength_array(const Brush *br,
+                                    float *values,
+                                    const int values_num,
+                                    const float len)
+{
+  /* Normalized distance from the brush edge, zero outside of the brush. */
+  for (int i = 0; i < values_num; i++) {
+    values[i] = values[i] >= len ? 0.0f : 1.0f - values[i] / len;
+  }
+
+  switch (br->curve_preset) {
+    case BRUSH_CURVE_CUSTOM:
+      for (int i = 0; i < values_num; i++) {
+        values[i] = values[i] == 0.0f ? 0.0f :
+                                        BKE_curvemapping_evaluateF(br->curve, 0, 1.0f - values[i]);
+      }
+      break;
+    case BRUSH_CURVE_SHARP:
+      for (int i = 0; i < values_num; i++) {
+        values[i] = values[i] * values[i];
+      }
+      break;
+    case BRUSH_CURVE_SMOOTH:
+      for (int i = 0; i < values_num; i++) {
+        const float p = values[i];
+        values[i] = 3.0f * p * p - 2.0f * p * p * p;
+      }
+      break;
+    case BRUSH_CURVE_SMOOTHER:
+      for (int i = 0; i < values_num; i++) {
+        const float p = values[i];
+        values[i] = pow3f(p) * (p * (p * 6.0f - 15.0f) + 10.0f);
+      }
+      break;
+    case BRUSH_CURVE_ROOT:
+      for (int i = 0; i < values_num; i++) {
+        values[i] = sqrtf(values[i]);
+      }
+      break;
+    case BRUSH_CURVE_LIN:
+      break;
+    case BRUSH_CURVE_CONSTANT:
+      for (int i = 0; i < values_num; i++) {
+        values[i] = values[i] == 0.0f ? 0.0f : 1.0f;
+      }
+      break;
+    case BRUSH_CURVE_SPHERE:
+      for (int i = 0; i < values_num; i++) {
+        const float p = values[i];
+        values[i] = sqrtf(2 * p - p * p);
+      }
+      break;
+    case BRUSH_CURVE_POW4:
+      for (int i = 0; i < values_num; i++) {
+        const float p = values[i];
+        values[i] = p * p * p * p;
+      }
+      break;
+    case BRUSH_CURVE_INVSQUARE:
+      for (int i = 0; i < values_num; i++) {
+        const float p = values[i];
+        values[i] = p * (2.0f - p);
+      }
+      break;
+    default:
+      for (int i = 0; i < values_num; i++) {
+        values[i] = values[i] == 0.0f ? 0.0f : 1.0f;
+      }
+      break;
+  }
+}
+
 float BKE_brush_curve_strength_clamped(const Brush *br, float p, const float len)
 {
   float strength = BKE_brush_curve_strength(br, p, len);
@@ -13,9 +13,11 @@
 #include "DNA_meshdata_types.h"
 #include "DNA_pointcloud_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_linklist.h"
 #include "BLI_math.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -26,13 +28,37 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "atomic_ops.h"
+
+using blender::Array;
+using blender::IndexRange;
+namespace threading = blender::threading;
+
 /* -------------------------------------------------------------------- */
 /** \name BVHCache
  * \{ */
 
+/** Hashes of the mesh data a tree was built from. */
+struct BVHCacheKey {
+  /** Hash of the vertices, the only data that changes when deforming the mesh. */
+  uint64_t positions_hash;
+  /** Hash of the element counts and the other arrays used to build the tree. */
+  uint64_t topology_hash;
+};
+
 struct BVHCacheItem {
   bool is_filled;
+  /**
+   * False when the tree comes from the cache of the mesh this mesh was copied from, and wasn't
+   * checked against the data of this mesh yet, see #bvhcache_verify_for_mesh.
+   */
+  bool is_verified;
+  /** Whether #key is set. It is only computed when the cache is copied. */
+  bool has_key;
+  BVHCacheKey key;
   BVHTree *tree;
+  /** Number of caches sharing the tree, null when it was never shared. */
+  int *tree_users;
 };
 
 struct BVHCache {
@@ -40,6 +66,19 @@ struct BVHCache {
   ThreadMutex mutex;
 };
 
+static void bvhcache_item_free(BVHCacheItem *item)
+{
+  if (item->tree_users) {
+    if (atomic_sub_and_fetch_int32(item->tree_users, 1) > 0) {
+      memset(item, 0, sizeof(*item));
+      return;
+    }
+    MEM_freeN(item->tree_users);
+  }
+  BLI_bvhtree_free(item->tree);
+  memset(item, 0, sizeof(*item));
+}
+
 /**
  * Queries a bvhcache for the cache bvhtree of the request type
  *
@@ -128,20 +167,252 @@ static void bvhcache_insert(BVHCache *bvh_cache, BVHTree *tree, BVHCacheType typ
   BVHCacheItem *item = &bvh_cache->items[type];
   BLI_assert(!item->is_filled);
   item->tree = tree;
+  item->tree_users = nullptr;
+  item->has_key = false;
+  item->is_verified = true;
   item->is_filled = true;
 }
 
 void bvhcache_free(BVHCache *bvh_cache)
 {
   for (int index = 0; index < BVHTREE_MAX_ITEM; index++) {
-    BVHCacheItem *item = &bvh_cache->items[index];
-    BLI_bvhtree_free(item->tree);
-    item->tree = nullptr;
+    bvhcache_item_free(&bvh_cache->items[index]);
   }
   BLI_mutex_end(&bvh_cache->mutex);
   MEM_freeN(bvh_cache);
 }
 
+/* Mix a 64 bit word into the hash. Every step is a bijection, so changing a single word of the
+ * hashed data always changes the hash. */
+static uint64_t bvhcache_hash_word(const uint64_t hash, const uint64_t word)
+{
+  uint64_t h = (hash ^ word) * 0x9e3779b97f4a7c15ull;
+  return h ^ (h >> 32);
+}
+
+/**
+ * Hash used to detect changes of mesh arrays, computed in parallel for large arrays.
+ */
+static uint64_t bvhcache_hash_data(const void *data, const int64_t size, const uint64_t seed)
+{
+  const uchar *bytes = static_cast<const uchar *>(data);
+  const int64_t words_num = size / 8;
+  const int64_t chunk_size = 1 << 14;
+  const int64_t chunks_num = (words_num + chunk_size - 1) / chunk_size;
+
+  Array<uint64_t> chunk_hashes(chunks_num);
+  threading::parallel_for(IndexRange(chunks_num), 4, [&](const IndexRange range) {
+    for (const int64_t chunk : range) {
+      const IndexRange words = IndexRange(chunk * chunk_size,
+                                          std::min(chunk_size, words_num - chunk * chunk_size));
+      uint64_t hash = uint64_t(chunk);
+      for (const int64_t i : words) {
+        uint64_t word;
+        memcpy(&word, bytes + i * 8, sizeof(word));
+        hash = bvhcache_hash_word(hash, word);
+      }
+      chunk_hashes[chunk] = hash;
+    }
+  });
+
+  uint64_t hash = bvhcache_hash_word(seed, uint64_t(size));
+  for (const uint64_t chunk_hash : chunk_hashes) {
+    hash = bvhcache_hash_word(hash, chunk_hash);
+  }
+  if (size > words_num * 8) {
+    uint64_t tail = 0;
+    memcpy(&tail, bytes + words_num * 8, size_t(size - words_num * 8));
+    hash = bvhcache_hash_word(hash, tail);
+  }
+  return hash;
+}
+
+static BVHCacheKey bvhcache_key_from_mesh(const Mesh &mesh, const BVHCacheType type)
+{
+  BVHCacheKey key;
+  key.positions_hash = bvhcache_hash_data(mesh.mvert, sizeof(MVert) * mesh.totvert, 0);
+
+  uint64_t hash = bvhcache_hash_word(uint64_t(type), uint64_t(mesh.totvert));
+  hash = bvhcache_hash_word(hash, uint64_t(mesh.totedge));
+  hash = bvhcache_hash_word(hash, uint64_t(mesh.totface));
+  hash = bvhcache_hash_word(hash, uint64_t(mesh.totloop));
+  hash = bvhcache_hash_word(hash, uint64_t(mesh.totpoly));
+  switch (type) {
+    case BVHTREE_FROM_VERTS:
+      break;
+    case BVHTREE_FROM_EDGES:
+    case BVHTREE_FROM_LOOSEVERTS:
+    case BVHTREE_FROM_LOOSEEDGES:
+      hash = bvhcache_hash_data(mesh.medge, sizeof(MEdge) * mesh.totedge, hash);
+      break;
+    case BVHTREE_FROM_FACES:
+      hash = bvhcache_hash_data(mesh.mface, sizeof(MFace) * mesh.totface, hash);
+      break;
+    case BVHTREE_FROM_LOOPTRI:
+    case BVHTREE_FROM_LOOPTRI_NO_HIDDEN:
+      hash = bvhcache_hash_data(mesh.mloop, sizeof(MLoop) * mesh.totloop, hash);
+      hash = bvhcache_hash_data(mesh.mpoly, sizeof(MPoly) * mesh.totpoly, hash);
+      break;
+    case BVHTREE_FROM_EM_VERTS:
+    case BVHTREE_FROM_EM_EDGES:
+    case BVHTREE_FROM_EM_LOOPTRI:
+    case BVHTREE_MAX_ITEM:
+      BLI_assert_unreachable();
+      break;
+  }
+  key.topology_hash = hash;
+  return key;
+}
+
+/**
+ * Update the bounds of a tree for new positions of the same topology. This is much faster than
+ * building a new tree, though queries get slower when the positions moved a lot.
+ * Trees of a subset of the elements are not supported, since they would need the same mask.
+ */
+static bool bvhtree_refit_from_mesh(BVHTree *tree, const Mesh &mesh, const BVHCacheType type)
+{
+  const MVert *verts = mesh.mvert;
+  switch (type) {
+    case BVHTREE_FROM_VERTS: {
+      if (BLI_bvhtree_get_len(tree) != mesh.totvert) {
+        return false;
+      }
+      threading::parallel_for(IndexRange(mesh.totvert), 4096, [&](const IndexRange range) {
+        for (const int i : range) {
+          BLI_bvhtree_update_node(tree, i, verts[i].co, nullptr, 1);
+        }
+      });
+      break;
+    }
+    case BVHTREE_FROM_EDGES: {
+      if (BLI_bvhtree_get_len(tree) != mesh.totedge) {
+        return false;
+      }
+      const MEdge *edges = mesh.medge;
+      threading::parallel_for(IndexRange(mesh.totedge), 4096, [&](const IndexRange range) {
+        for (const int i : range) {
+          float co[2][3];
+          copy_v3_v3(co[0], verts[edges[i].v1].co);
+          copy_v3_v3(co[1], verts[edges[i].v2].co);
+          BLI_bvhtree_update_node(tree, i, co[0], nullptr, 2);
+        }
+      });
+      break;
+    }
+    case BVHTREE_FROM_LOOPTRI: {
+      const MLoopTri *looptris = BKE_mesh_runtime_looptri_ensure(&mesh);
+      const int looptris_num = BKE_mesh_runtime_looptri_len(&mesh);
+      if (BLI_bvhtree_get_len(tree) != looptris_num) {
+        return false;
+      }
+      const MLoop *loops = mesh.mloop;
+      threading::parallel_for(IndexRange(looptris_num), 4096, [&](const IndexRange range) {
+        for (const int i : range) {
+          float co[3][3];
+          copy_v3_v3(co[0], verts[loops[looptris[i].tri[0]].v].co);
+          copy_v3_v3(co[1], verts[loops[looptris[i].tri[1]].v].co);
+          copy_v3_v3(co[2], verts[loops[looptris[i].tri[2]].v].co);
+          BLI_bvhtree_update_node(tree, i, co[0], nullptr, 3);
+        }
+      });
+      break;
+    }
+    default:
+      return false;
+  }
+  BLI_bvhtree_update_tree(tree);
+  return true;
+}
+
+/**
+ * Check that a tree copied from the cache of another mesh, see #bvhcache_copy_shared, was built
+ * from the same data as this mesh has. Trees of deformed copies are refit when they are not used
+ * by other meshes anymore, and freed otherwise so that they are built again.
+ */
+static void bvhcache_verify_for_mesh(BVHCache *bvh_cache,
+                                     const Mesh &mesh,
+                                     const BVHCacheType type)
+{
+  if (bvh_cache == nullptr) {
+    return;
+  }
+  BVHCacheItem *item = &bvh_cache->items[type];
+  if (!item->is_filled || item->is_verified) {
+    return;
+  }
+
+  /* Hashing and refitting are multithreaded, the current thread must not start tasks that wait
+   * for the lock it holds. */
+  threading::isolate_task([&]() {
+    /* Ensure the triangulation before locking, a refit needs it. */
+    if (ELEM(type, BVHTREE_FROM_LOOPTRI, BVHTREE_FROM_LOOPTRI_NO_HIDDEN)) {
+      BKE_mesh_runtime_looptri_ensure(&mesh);
+    }
+    const BVHCacheKey key = bvhcache_key_from_mesh(mesh, type);
+
+    BLI_mutex_lock(&bvh_cache->mutex);
+    if (item->is_filled && !item->is_verified) {
+      BLI_assert(item->has_key);
+      if (key.topology_hash != item->key.topology_hash) {
+        bvhcache_item_free(item);
+      }
+      else if (key.positions_hash != item->key.positions_hash) {
+        const bool is_shared = item->tree_users &&
+                               atomic_add_and_fetch_int32(item->tree_users, 0) > 1;
+        if (item->tree && !is_shared && bvhtree_refit_from_mesh(item->tree, mesh, type)) {
+          item->key = key;
+          item->is_verified = true;
+        }
+        else {
+          bvhcache_item_free(item);
+        }
+      }
+      else {
+        item->is_verified = true;
+      }
+    }
+    BLI_mutex_unlock(&bvh_cache->mutex);
+  });
+}
+
+BVHCache *bvhcache_copy_shared(BVHCache *bvh_cache, const Mesh *mesh)
+{
+  BVHCache *bvh_cache_dst = nullptr;
+
+  BLI_mutex_lock(&bvh_cache->mutex);
+  for (int type = 0; type < BVHTREE_FROM_EM_VERTS; type++) {
+    BVHCacheItem *item = &bvh_cache->items[type];
+    if (!item->is_filled) {
+      continue;
+    }
+    if (!item->has_key) {
+      if (!item->is_verified) {
+        /* The data the tree was built from is unknown. */
+        continue;
+      }
+      threading::isolate_task(
+          [&]() { item->key = bvhcache_key_from_mesh(*mesh, BVHCacheType(type)); });
+      item->has_key = true;
+    }
+    if (item->tree) {
+      if (item->tree_users == nullptr) {
+        item->tree_users = MEM_cnew<int>(__func__);
+        *item->tree_users = 1;
+      }
+      atomic_add_and_fetch_int32(item->tree_users, 1);
+    }
+    if (bvh_cache_dst == nullptr) {
+      bvh_cache_dst = bvhcache_init();
+    }
+    BVHCacheItem *item_dst = &bvh_cache_dst->items[type];
+    *item_dst = *item;
+    item_dst->is_verified = false;
+  }
+  BLI_mutex_unlock(&bvh_cache->mutex);
+
+  return bvh_cache_dst;
+}
+
 /**
  * BVH-tree balancing inside a mutex lock must be run in isolation. Balancing
  * is multithreaded, and we do not want the current thread to start another task
@@ -1414,6 +1685,8 @@ BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
   BVHCache **bvh_cache_p = (BVHCache **)&mesh->runtime.bvh_cache;
   ThreadMutex *mesh_eval_mutex = (ThreadMutex *)mesh->runtime.eval_mutex;
 
+  bvhcache_verify_for_mesh(*bvh_cache_p, *mesh, bvh_cache_type);
+
   const bool is_cached = bvhcache_find(bvh_cache_p, bvh_cache_type, &tree, nullptr, nullptr);
 
   if (is_cached && tree == nullptr) {
@@ -1745,6 +2018,39 @@ void free_bvhtree_from_mesh(struct BVHTreeFromMesh *data)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Batched Queries
+ * \{ */
+
+void BKE_bvhtree_from_mesh_find_nearest_batch(BVHTreeFromMesh *data,
+                                              const float (*co)[3],
+                                              const int co_num,
+                                              BVHTreeNearest *r_nearest)
+{
+  BLI_bvhtree_find_nearest_batch(
+      data->tree, co, co_num, r_nearest, data->nearest_callback, data, 0);
+}
+
+void BKE_bvhtree_from_mesh_ray_cast_batch(BVHTreeFromMesh *data,
+                                          const float (*co)[3],
+                                          const float (*dir)[3],
+                                          const int ray_num,
+                                          const float radius,
+                                          BVHTreeRayHit *r_hits)
+{
+  BLI_bvhtree_ray_cast_batch(data->tree,
+                             co,
+                             dir,
+                             ray_num,
+                             radius,
+                             r_hits,
+                             data->raycast_callback,
+                             data,
+                             BVH_RAYCAST_DEFAULT);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Point Cloud BVH Building
  * \{ */
@@ -1779,4 +2085,13 @@ void free_bvhtree_from_pointcloud(BVHTreeFromPointCloud *data)
   memset(data, 0, sizeof(*data));
 }
 
+void BKE_bvhtree_from_pointcloud_find_nearest_batch(BVHTreeFromPointCloud *data,
+                                                    const float (*co)[3],
+                                                    const int co_num,
+                                                    BVHTreeNearest *r_nearest)
+{
+  BLI_bvhtree_find_nearest_batch(
+      data->tree, co, co_num, r_nearest, data->nearest_callback, data, 0);
+}
+
 /** \} */
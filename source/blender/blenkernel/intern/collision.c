@@ -58,6 +58,24 @@ typedef struct SelfColDetectData {
   bool collided;
 } SelfColDetectData;
 
+/** Impulses of a self collision pair, computed in parallel and applied in pair order. */
+typedef struct SelfColImpulse {
+  float ia[3][3];
+  float ib[3][3];
+  /** The pair is a static collision that is handled. */
+  bool handled;
+  /** The pair generated impulses. */
+  bool collided;
+} SelfColImpulse;
+
+typedef struct SelfColResponseData {
+  const ClothModifierData *clmd;
+  const CollPair *collisions;
+  SelfColImpulse *impulses;
+  float time_multiplier;
+  float min_distance;
+} SelfColResponseData;
+
 /***********************************
  * Collision modifier code start
  ***********************************/
@@ -820,161 +838,200 @@ static int cloth_collision_response_static(ClothModifierData *clmd,
   return result;
 }
 
-static int cloth_selfcollision_response_static(ClothModifierData *clmd,
-                                               CollPair *collpair,
-                                               uint collision_count,
-                                               const float dt)
+static void cloth_selfcollision_impulse(void *__restrict userdata,
+                                        const int index,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  int result = 0;
-  Cloth *cloth = clmd->clothObject;
-  const float clamp_sq = square_f(clmd->coll_parms->self_clamp * dt);
-  const float time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale);
-  const float min_distance = (2.0f * clmd->coll_parms->selfepsilon) * (8.0f / 9.0f);
+  const SelfColResponseData *data = (const SelfColResponseData *)userdata;
+  const ClothModifierData *clmd = data->clmd;
+  const Cloth *cloth = clmd->clothObject;
+  const CollPair *collpair = &data->collisions[index];
+  SelfColImpulse *impulse_data = &data->impulses[index];
+  const float time_multiplier = data->time_multiplier;
+  const float min_distance = data->min_distance;
+  float w1, w2, w3, u1, u2, u3;
+  float v1[3], v2[3], relativeVelocity[3];
+
+  memset(impulse_data, 0, sizeof(*impulse_data));
+
+  /* Only handle static collisions here. */
+  if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
+    return;
+  }
+  impulse_data->handled = true;
 
-  for (int i = 0; i < collision_count; i++, collpair++) {
-    float ia[3][3] = {{0.0f}};
-    float ib[3][3] = {{0.0f}};
-    float w1, w2, w3, u1, u2, u3;
-    float v1[3], v2[3], relativeVelocity[3];
+  /* Compute barycentric coordinates for both collision points. */
+  collision_compute_barycentric(collpair->pa,
+                                cloth->verts[collpair->ap1].tx,
+                                cloth->verts[collpair->ap2].tx,
+                                cloth->verts[collpair->ap3].tx,
+                                &w1,
+                                &w2,
+                                &w3);
 
-    /* Only handle static collisions here. */
-    if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
-      continue;
-    }
+  collision_compute_barycentric(collpair->pb,
+                                cloth->verts[collpair->bp1].tx,
+                                cloth->verts[collpair->bp2].tx,
+                                cloth->verts[collpair->bp3].tx,
+                                &u1,
+                                &u2,
+                                &u3);
 
-    /* Compute barycentric coordinates for both collision points. */
-    collision_compute_barycentric(collpair->pa,
-                                  cloth->verts[collpair->ap1].tx,
-                                  cloth->verts[collpair->ap2].tx,
-                                  cloth->verts[collpair->ap3].tx,
-                                  &w1,
-                                  &w2,
-                                  &w3);
+  /* Calculate relative "velocity". */
+  collision_interpolateOnTriangle(v1,
+                                  cloth->verts[collpair->ap1].tv,
+                                  cloth->verts[collpair->ap2].tv,
+                                  cloth->verts[collpair->ap3].tv,
+                                  w1,
+                                  w2,
+                                  w3);
+
+  collision_interpolateOnTriangle(v2,
+                                  cloth->verts[collpair->bp1].tv,
+                                  cloth->verts[collpair->bp2].tv,
+                                  cloth->verts[collpair->bp3].tv,
+                                  u1,
+                                  u2,
+                                  u3);
 
-    collision_compute_barycentric(collpair->pb,
-                                  cloth->verts[collpair->bp1].tx,
-                                  cloth->verts[collpair->bp2].tx,
-                                  cloth->verts[collpair->bp3].tx,
-                                  &u1,
-                                  &u2,
-                                  &u3);
+  sub_v3_v3v3(relativeVelocity, v2, v1);
 
-    /* Calculate relative "velocity". */
-    collision_interpolateOnTriangle(v1,
-                                    cloth->verts[collpair->ap1].tv,
-                                    cloth->verts[collpair->ap2].tv,
-                                    cloth->verts[collpair->ap3].tv,
-                                    w1,
-                                    w2,
-                                    w3);
+  /* Calculate the normal component of the relative velocity
+   * (actually only the magnitude - the direction is stored in 'normal'). */
+  const float magrelVel = dot_v3v3(relativeVelocity, collpair->normal);
+  const float d = min_distance - collpair->distance;
 
-    collision_interpolateOnTriangle(v2,
-                                    cloth->verts[collpair->bp1].tv,
-                                    cloth->verts[collpair->bp2].tv,
-                                    cloth->verts[collpair->bp3].tv,
-                                    u1,
-                                    u2,
-                                    u3);
+  /* TODO: Impulses should be weighed by mass as this is self col,
+   * this has to be done after mass distribution is implemented. */
 
-    sub_v3_v3v3(relativeVelocity, v2, v1);
+  /* If magrelVel < 0 the edges are approaching each other. */
+  if (magrelVel > 0.0f) {
+    /* Calculate Impulse magnitude to stop all motion in normal direction. */
+    float magtangent = 0, repulse = 0;
+    double impulse = 0.0;
+    float vrel_t_pre[3];
+    float temp[3];
 
-    /* Calculate the normal component of the relative velocity
-     * (actually only the magnitude - the direction is stored in 'normal'). */
-    const float magrelVel = dot_v3v3(relativeVelocity, collpair->normal);
-    const float d = min_distance - collpair->distance;
+    /* Calculate tangential velocity. */
+    copy_v3_v3(temp, collpair->normal);
+    mul_v3_fl(temp, magrelVel);
+    sub_v3_v3v3(vrel_t_pre, relativeVelocity, temp);
 
-    /* TODO: Impulses should be weighed by mass as this is self col,
-     * this has to be done after mass distribution is implemented. */
+    /* Decrease in magnitude of relative tangential velocity due to coulomb friction
+     * in original formula "magrelVel" should be the
+     * "change of relative velocity in normal direction". */
+    magtangent = min_ff(clmd->coll_parms->self_friction * 0.01f * magrelVel, len_v3(vrel_t_pre));
 
-    /* If magrelVel < 0 the edges are approaching each other. */
-    if (magrelVel > 0.0f) {
-      /* Calculate Impulse magnitude to stop all motion in normal direction. */
-      float magtangent = 0, repulse = 0;
-      double impulse = 0.0;
-      float vrel_t_pre[3];
-      float temp[3];
+    /* Apply friction impulse. */
+    if (magtangent > ALMOST_ZERO) {
+      normalize_v3(vrel_t_pre);
 
-      /* Calculate tangential velocity. */
-      copy_v3_v3(temp, collpair->normal);
-      mul_v3_fl(temp, magrelVel);
-      sub_v3_v3v3(vrel_t_pre, relativeVelocity, temp);
+      impulse = magtangent / 1.5;
 
-      /* Decrease in magnitude of relative tangential velocity due to coulomb friction
-       * in original formula "magrelVel" should be the
-       * "change of relative velocity in normal direction". */
-      magtangent = min_ff(clmd->coll_parms->self_friction * 0.01f * magrelVel, len_v3(vrel_t_pre));
+      VECADDMUL(impulse_data->ia[0], vrel_t_pre, (double)w1 * impulse);
+      VECADDMUL(impulse_data->ia[1], vrel_t_pre, (double)w2 * impulse);
+      VECADDMUL(impulse_data->ia[2], vrel_t_pre, (double)w3 * impulse);
 
-      /* Apply friction impulse. */
-      if (magtangent > ALMOST_ZERO) {
-        normalize_v3(vrel_t_pre);
+      VECADDMUL(impulse_data->ib[0], vrel_t_pre, (double)u1 * -impulse);
+      VECADDMUL(impulse_data->ib[1], vrel_t_pre, (double)u2 * -impulse);
+      VECADDMUL(impulse_data->ib[2], vrel_t_pre, (double)u3 * -impulse);
+    }
 
-        impulse = magtangent / 1.5;
+    /* Apply velocity stopping impulse. */
+    impulse = magrelVel / 3.0f;
+
+    VECADDMUL(impulse_data->ia[0], collpair->normal, (double)w1 * impulse);
+    VECADDMUL(impulse_data->ia[1], collpair->normal, (double)w2 * impulse);
+    VECADDMUL(impulse_data->ia[2], collpair->normal, (double)w3 * impulse);
 
-        VECADDMUL(ia[0], vrel_t_pre, (double)w1 * impulse);
-        VECADDMUL(ia[1], vrel_t_pre, (double)w2 * impulse);
-        VECADDMUL(ia[2], vrel_t_pre, (double)w3 * impulse);
+    VECADDMUL(impulse_data->ib[0], collpair->normal, (double)u1 * -impulse);
+    VECADDMUL(impulse_data->ib[1], collpair->normal, (double)u2 * -impulse);
+    VECADDMUL(impulse_data->ib[2], collpair->normal, (double)u3 * -impulse);
 
-        VECADDMUL(ib[0], vrel_t_pre, (double)u1 * -impulse);
-        VECADDMUL(ib[1], vrel_t_pre, (double)u2 * -impulse);
-        VECADDMUL(ib[2], vrel_t_pre, (double)u3 * -impulse);
+    if ((magrelVel < 0.1f * d * time_multiplier) && (d > ALMOST_ZERO)) {
+      repulse = MIN2(d / time_multiplier, 0.1f * d * time_multiplier - magrelVel);
+
+      if (impulse > ALMOST_ZERO) {
+        repulse = min_ff(repulse, 5.0 * impulse);
       }
 
-      /* Apply velocity stopping impulse. */
-      impulse = magrelVel / 3.0f;
+      repulse = max_ff(impulse, repulse);
+      impulse = repulse / 1.5f;
 
-      VECADDMUL(ia[0], collpair->normal, (double)w1 * impulse);
-      VECADDMUL(ia[1], collpair->normal, (double)w2 * impulse);
-      VECADDMUL(ia[2], collpair->normal, (double)w3 * impulse);
+      VECADDMUL(impulse_data->ia[0], collpair->normal, (double)w1 * impulse);
+      VECADDMUL(impulse_data->ia[1], collpair->normal, (double)w2 * impulse);
+      VECADDMUL(impulse_data->ia[2], collpair->normal, (double)w3 * impulse);
 
-      VECADDMUL(ib[0], collpair->normal, (double)u1 * -impulse);
-      VECADDMUL(ib[1], collpair->normal, (double)u2 * -impulse);
-      VECADDMUL(ib[2], collpair->normal, (double)u3 * -impulse);
+      VECADDMUL(impulse_data->ib[0], collpair->normal, (double)u1 * -impulse);
+      VECADDMUL(impulse_data->ib[1], collpair->normal, (double)u2 * -impulse);
+      VECADDMUL(impulse_data->ib[2], collpair->normal, (double)u3 * -impulse);
+    }
 
-      if ((magrelVel < 0.1f * d * time_multiplier) && (d > ALMOST_ZERO)) {
-        repulse = MIN2(d / time_multiplier, 0.1f * d * time_multiplier - magrelVel);
+    impulse_data->collided = true;
+  }
+  else if (d > ALMOST_ZERO) {
+    /* Stay on the safe side and clamp repulse. */
+    float repulse = d * 1.0f / time_multiplier;
+    float impulse = repulse / 9.0f;
 
-        if (impulse > ALMOST_ZERO) {
-          repulse = min_ff(repulse, 5.0 * impulse);
-        }
+    VECADDMUL(impulse_data->ia[0], collpair->normal, w1 * impulse);
+    VECADDMUL(impulse_data->ia[1], collpair->normal, w2 * impulse);
+    VECADDMUL(impulse_data->ia[2], collpair->normal, w3 * impulse);
 
-        repulse = max_ff(impulse, repulse);
-        impulse = repulse / 1.5f;
+    VECADDMUL(impulse_data->ib[0], collpair->normal, u1 * -impulse);
+    VECADDMUL(impulse_data->ib[1], collpair->normal, u2 * -impulse);
+    VECADDMUL(impulse_data->ib[2], collpair->normal, u3 * -impulse);
 
-        VECADDMUL(ia[0], collpair->normal, (double)w1 * impulse);
-        VECADDMUL(ia[1], collpair->normal, (double)w2 * impulse);
-        VECADDMUL(ia[2], collpair->normal, (double)w3 * impulse);
+    impulse_data->collided = true;
+  }
+}
 
-        VECADDMUL(ib[0], collpair->normal, (double)u1 * -impulse);
-        VECADDMUL(ib[1], collpair->normal, (double)u2 * -impulse);
-        VECADDMUL(ib[2], collpair->normal, (double)u3 * -impulse);
-      }
+/**
+ * The impulses of all pairs only read the vertex state, so they are computed in parallel.
+ * Applying them accumulates into the shared vertices, this is done afterwards in the original
+ * pair order so the result doesn't depend on the number of threads.
+ */
+static int cloth_selfcollision_response_static(ClothModifierData *clmd,
+                                               CollPair *collpair,
+                                               SelfColImpulse *impulses,
+                                               uint collision_count,
+                                               const float dt)
+{
+  int result = 0;
+  Cloth *cloth = clmd->clothObject;
+  const float clamp_sq = square_f(clmd->coll_parms->self_clamp * dt);
 
-      result = 1;
-    }
-    else if (d > ALMOST_ZERO) {
-      /* Stay on the safe side and clamp repulse. */
-      float repulse = d * 1.0f / time_multiplier;
-      float impulse = repulse / 9.0f;
+  SelfColResponseData data = {
+      .clmd = clmd,
+      .collisions = collpair,
+      .impulses = impulses,
+      .time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale),
+      .min_distance = (2.0f * clmd->coll_parms->selfepsilon) * (8.0f / 9.0f),
+  };
 
-      VECADDMUL(ia[0], collpair->normal, w1 * impulse);
-      VECADDMUL(ia[1], collpair->normal, w2 * impulse);
-      VECADDMUL(ia[2], collpair->normal, w3 * impulse);
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 64;
+  BLI_task_parallel_range(0, collision_count, &data, cloth_selfcollision_impulse, &settings);
 
-      VECADDMUL(ib[0], collpair->normal, u1 * -impulse);
-      VECADDMUL(ib[1], collpair->normal, u2 * -impulse);
-      VECADDMUL(ib[2], collpair->normal, u3 * -impulse);
+  for (int i = 0; i < collision_count; i++, collpair++) {
+    const SelfColImpulse *impulse_data = &impulses[i];
 
+    if (!impulse_data->handled) {
+      continue;
+    }
+    if (impulse_data->collided) {
       result = 1;
     }
 
     if (result) {
-      cloth_collision_impulse_vert(clamp_sq, ia[0], &cloth->verts[collpair->ap1]);
-      cloth_collision_impulse_vert(clamp_sq, ia[1], &cloth->verts[collpair->ap2]);
-      cloth_collision_impulse_vert(clamp_sq, ia[2], &cloth->verts[collpair->ap3]);
+      cloth_collision_impulse_vert(clamp_sq, impulse_data->ia[0], &cloth->verts[collpair->ap1]);
+      cloth_collision_impulse_vert(clamp_sq, impulse_data->ia[1], &cloth->verts[collpair->ap2]);
+      cloth_collision_impulse_vert(clamp_sq, impulse_data->ia[2], &cloth->verts[collpair->ap3]);
 
-      cloth_collision_impulse_vert(clamp_sq, ib[0], &cloth->verts[collpair->bp1]);
-      cloth_collision_impulse_vert(clamp_sq, ib[1], &cloth->verts[collpair->bp2]);
-      cloth_collision_impulse_vert(clamp_sq, ib[2], &cloth->verts[collpair->bp3]);
+      cloth_collision_impulse_vert(clamp_sq, impulse_data->ib[0], &cloth->verts[collpair->bp1]);
+      cloth_collision_impulse_vert(clamp_sq, impulse_data->ib[1], &cloth->verts[collpair->bp2]);
+      cloth_collision_impulse_vert(clamp_sq, impulse_data->ib[2], &cloth->verts[collpair->bp3]);
     }
   }
 
@@ -1482,10 +1539,13 @@ static int cloth_bvh_selfcollisions_resolve(ClothModifierData *clmd,
   mvert_num = clmd->clothObject->mvert_num;
   verts = cloth->verts;
 
+  SelfColImpulse *impulses = MEM_mallocN(sizeof(*impulses) * collision_count, __func__);
+
   for (j = 0; j < 2; j++) {
     result = 0;
 
-    result += cloth_selfcollision_response_static(clmd, collisions, collision_count, dt);
+    result += cloth_selfcollision_response_static(
+        clmd, collisions, impulses, collision_count, dt);
 
     /* Apply impulses in parallel. */
     if (result) {
@@ -1506,6 +1566,9 @@ static int cloth_bvh_selfcollisions_resolve(ClothModifierData *clmd,
       break;
     }
   }
+
+  MEM_freeN(impulses);
+
   return ret;
 }
 
@@ -116,14 +116,14 @@ void BKE_constraint_unique_name(bConstraint *con, ListBase *list)
 
 /* ----------------- Evaluation Loop Preparation --------------- */
 
-/* package an object/bone for use in constraint evaluation */
-bConstraintOb *BKE_constraints_make_evalob(
-    Depsgraph *depsgraph, Scene *scene, Object *ob, void *subdata, short datatype)
+void BKE_constraints_init_evalob(bConstraintOb *cob,
+                                 Depsgraph *depsgraph,
+                                 Scene *scene,
+                                 Object *ob,
+                                 void *subdata,
+                                 short datatype)
 {
-  bConstraintOb *cob;
-
-  /* create regardless of whether we have any data! */
-  cob = MEM_callocN(sizeof(bConstraintOb), "bConstraintOb");
+  memset(cob, 0, sizeof(*cob));
 
   /* for system time, part of deglobalization, code nicer later with local time (ton) */
   cob->scene = scene;
@@ -190,26 +190,35 @@ bConstraintOb *BKE_constraints_make_evalob(
       unit_m4(cob->startmat);
       break;
   }
+}
 
+/* package an object/bone for use in constraint evaluation */
+bConstraintOb *BKE_constraints_make_evalob(
+    Depsgraph *depsgraph, Scene *scene, Object *ob, void *subdata, short datatype)
+{
+  /* create regardless of whether we have any data! */
+  bConstraintOb *cob = MEM_mallocN(sizeof(bConstraintOb), "bConstraintOb");
+  BKE_constraints_init_evalob(cob, depsgraph, scene, ob, subdata, datatype);
   return cob;
 }
 
-void BKE_constraints_clear_evalob(bConstraintOb *cob)
+void BKE_constraints_flush_evalob(bConstraintOb *cob)
 {
   float delta[4][4], imat[4][4];
 
-  /* prevent crashes */
-  if (cob == NULL) {
-    return;
-  }
+  /* Constraints often don't change the matrix (e.g. when their influence is animated to zero),
+   * the delta is the identity matrix then and doesn't have to be computed. */
+  const bool is_unchanged = equals_m4m4(cob->startmat, cob->matrix);
 
   /* calculate delta of constraints evaluation */
-  invert_m4_m4(imat, cob->startmat);
-  /* XXX This would seem to be in wrong order. However, it does not work in 'right' order -
-   *     would be nice to understand why premul is needed here instead of usual postmul?
-   *     In any case, we **do not get a delta** here (e.g. startmat & matrix having same location,
-   *     still gives a 'delta' with non-null translation component :/ ). */
-  mul_m4_m4m4(delta, cob->matrix, imat);
+  if (!is_unchanged) {
+    invert_m4_m4(imat, cob->startmat);
+    /* XXX This would seem to be in wrong order. However, it does not work in 'right' order -
+     *     would be nice to understand why premul is needed here instead of usual postmul?
+     *     In any case, we **do not get a delta** here (e.g. startmat & matrix having same
+     *     location, still gives a 'delta' with non-null translation component :/ ). */
+    mul_m4_m4m4(delta, cob->matrix, imat);
+  }
 
   /* copy matrices back to source */
   switch (cob->type) {
@@ -220,7 +229,12 @@ void BKE_constraints_clear_evalob(bConstraintOb *cob)
         copy_m4_m4(cob->ob->obmat, cob->matrix);
 
         /* copy inverse of delta back to owner */
-        invert_m4_m4(cob->ob->constinv, delta);
+        if (is_unchanged) {
+          unit_m4(cob->ob->constinv);
+        }
+        else {
+          invert_m4_m4(cob->ob->constinv, delta);
+        }
       }
       break;
     }
@@ -231,11 +245,26 @@ void BKE_constraints_clear_evalob(bConstraintOb *cob)
         mul_m4_m4m4(cob->pchan->pose_mat, cob->ob->imat, cob->matrix);
 
         /* copy inverse of delta back to owner */
-        invert_m4_m4(cob->pchan->constinv, delta);
+        if (is_unchanged) {
+          unit_m4(cob->pchan->constinv);
+        }
+        else {
+          invert_m4_m4(cob->pchan->constinv, delta);
+        }
       }
       break;
     }
   }
+}
+
+void BKE_constraints_clear_evalob(bConstraintOb *cob)
+{
+  /* prevent crashes */
+  if (cob == NULL) {
+    return;
+  }
+
+  BKE_constraints_flush_evalob(cob);
 
   /* free tempolary struct */
   MEM_freeN(cob);
@@ -134,6 +134,53 @@ void calculate_evaluated_positions(const Span<float3> positions,
   }
 }
 
+template<typename T>
+static inline void linear_interpolation(const T &a, const T &b, MutableSpan<T> dst)
+{
+  dst.first() = a;
+  const float step = 1.0f / dst.size();
+  for (const int i : dst.index_range().drop_front(1)) {
+    dst[i] = attribute_math::mix2(i * step, a, b);
+  }
+}
+
+template<typename T>
+static void interpolate_to_evaluated(const Span<T> src,
+                                     const Span<int> evaluated_offsets,
+                                     MutableSpan<T> dst)
+{
+  BLI_assert(!src.is_empty());
+  BLI_assert(evaluated_offsets.size() == src.size());
+  BLI_assert(evaluated_offsets.last() == dst.size());
+  if (src.size() == 1) {
+    BLI_assert(dst.size() == 1);
+    dst.first() = src.first();
+    return;
+  }
+
+  /* Every segment is interpolated linearly from its control point to the next, the range of the
+   * last segment only contains the last control point when the curve isn't cyclic. */
+  threading::parallel_for(src.index_range(), 512, [&](IndexRange range) {
+    for (const int i : range) {
+      const IndexRange evaluated_range = (i == 0) ?
+                                             IndexRange(evaluated_offsets.first()) :
+                                             offsets_to_range(evaluated_offsets, i - 1);
+      const int next_i = (i == src.size() - 1) ? 0 : i + 1;
+      linear_interpolation(src[i], src[next_i], dst.slice(evaluated_range));
+    }
+  });
+}
+
+void interpolate_to_evaluated(const GSpan src, const Span<int> evaluated_offsets, GMutableSpan dst)
+{
+  attribute_math::convert_to_static_type(src.type(), [&](auto dummy) {
+    using T = decltype(dummy);
+    if constexpr (!std::is_void_v<attribute_math::DefaultMixer<T>>) {
+      interpolate_to_evaluated(src.typed<T>(), evaluated_offsets, dst.typed<T>());
+    }
+  });
+}
+
 /** \} */
 
 }  // namespace blender::bke::curves::bezier
@@ -1,5 +1,7 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <mutex>
+
 #include "BLI_array.hh"
 #include "BLI_set.hh"
 #include "BLI_task.hh"
@@ -32,12 +34,10 @@ struct ResultInfo {
   int profile_edge_len;
 };
 
-static void vert_extrude_to_mesh_data(const Spline &spline,
-                                      const float3 profile_vert,
-                                      MutableSpan<MVert> r_verts,
-                                      MutableSpan<MEdge> r_edges,
-                                      const int vert_offset,
-                                      const int edge_offset)
+static void vert_extrude_to_mesh_topology(const Spline &spline,
+                                          MutableSpan<MEdge> r_edges,
+                                          const int vert_offset,
+                                          const int edge_offset)
 {
   const int eval_size = spline.evaluated_points_size();
   for (const int i : IndexRange(eval_size - 1)) {
@@ -53,19 +53,6 @@ static void vert_extrude_to_mesh_data(const Spline &spline,
     edge.v2 = vert_offset;
     edge.flag = ME_LOOSEEDGE;
   }
-
-  Span<float3> positions = spline.evaluated_positions();
-  Span<float3> tangents = spline.evaluated_tangents();
-  Span<float3> normals = spline.evaluated_normals();
-  VArray<float> radii = spline.interpolate_to_evaluated(spline.radii());
-  for (const int i : IndexRange(eval_size)) {
-    float4x4 point_matrix = float4x4::from_normalized_axis_data(
-        positions[i], normals[i], tangents[i]);
-    point_matrix.apply_scale(radii[i]);
-
-    MVert &vert = r_verts[vert_offset + i];
-    copy_v3_v3(vert.co, point_matrix * profile_vert);
-  }
 }
 
 static void mark_edges_sharp(MutableSpan<MEdge> edges)
@@ -75,22 +62,16 @@ static void mark_edges_sharp(MutableSpan<MEdge> edges)
   }
 }
 
-static void spline_extrude_to_mesh_data(const ResultInfo &info,
-                                        const bool fill_caps,
-                                        MutableSpan<MVert> r_verts,
-                                        MutableSpan<MEdge> r_edges,
-                                        MutableSpan<MLoop> r_loops,
-                                        MutableSpan<MPoly> r_polys)
+static void spline_extrude_to_mesh_topology(const ResultInfo &info,
+                                            const bool fill_caps,
+                                            MutableSpan<MEdge> r_edges,
+                                            MutableSpan<MLoop> r_loops,
+                                            MutableSpan<MPoly> r_polys)
 {
   const Spline &spline = info.spline;
   const Spline &profile = info.profile;
   if (info.profile_vert_len == 1) {
-    vert_extrude_to_mesh_data(spline,
-                              profile.evaluated_positions()[0],
-                              r_verts,
-                              r_edges,
-                              info.vert_offset,
-                              info.edge_offset);
+    vert_extrude_to_mesh_topology(spline, r_edges, info.vert_offset, info.edge_offset);
     return;
   }
 
@@ -203,6 +184,25 @@ static void spline_extrude_to_mesh_data(const ResultInfo &info,
     mark_edges_sharp(r_edges.slice(last_ring_edge_offset, info.profile_edge_len));
   }
 
+  /* Mark edge loops from sharp vector control points sharp. */
+  if (profile.type() == CURVE_TYPE_BEZIER) {
+    const BezierSpline &bezier_spline = static_cast<const BezierSpline &>(profile);
+    Span<int> control_point_offsets = bezier_spline.control_point_offsets();
+    for (const int i : IndexRange(bezier_spline.size())) {
+      if (bezier_spline.point_is_sharp(i)) {
+        mark_edges_sharp(
+            r_edges.slice(spline_edges_start + info.spline_edge_len * control_point_offsets[i],
+                          info.spline_edge_len));
+      }
+    }
+  }
+}
+
+static void spline_extrude_to_mesh_positions(const ResultInfo &info, MutableSpan<MVert> r_verts)
+{
+  const Spline &spline = info.spline;
+  const Spline &profile = info.profile;
+
   /* Calculate the positions of each profile ring profile along the spline. */
   Span<float3> positions = spline.evaluated_positions();
   Span<float3> tangents = spline.evaluated_tangents();
@@ -221,19 +221,6 @@ static void spline_extrude_to_mesh_data(const ResultInfo &info,
       copy_v3_v3(vert.co, point_matrix * profile_positions[i_profile]);
     }
   }
-
-  /* Mark edge loops from sharp vector control points sharp. */
-  if (profile.type() == CURVE_TYPE_BEZIER) {
-    const BezierSpline &bezier_spline = static_cast<const BezierSpline &>(profile);
-    Span<int> control_point_offsets = bezier_spline.control_point_offsets();
-    for (const int i : IndexRange(bezier_spline.size())) {
-      if (bezier_spline.point_is_sharp(i)) {
-        mark_edges_sharp(
-            r_edges.slice(spline_edges_start + info.spline_edge_len * control_point_offsets[i],
-                          info.spline_edge_len));
-      }
-    }
-  }
 }
 
 static inline int spline_extrude_vert_size(const Spline &curve, const Spline &profile)
@@ -675,6 +662,85 @@ static void copy_spline_domain_attributes_to_mesh(const CurveEval &curve,
   }
 }
 
+/**
+ * The edges, corners and faces of the last result. They only depend on the number of evaluated
+ * points of the splines, whether they are cyclic, and on the sharp control points of the profile.
+ * Reusing them avoids building the topology again when only the positions or the attributes of
+ * the curves change, e.g. for animated curves.
+ *
+ * The raw allocator is used, because the cache is only freed when the program exits.
+ */
+static struct TopologyCache {
+  Vector<int, 0, RawAllocator> key;
+  Array<MEdge, 0, RawAllocator> edges;
+  Array<MLoop, 0, RawAllocator> loops;
+  Array<MPoly, 0, RawAllocator> polys;
+  /* Mutex for multithreaded access. */
+  std::mutex mutex;
+} TOPOLOGY_CACHE;
+
+static Vector<int> calculate_topology_key(Span<SplinePtr> profiles,
+                                          Span<SplinePtr> curves,
+                                          const bool fill_caps)
+{
+  Vector<int> key;
+  key.append(fill_caps);
+  key.append(curves.size());
+  for (const SplinePtr &spline : curves) {
+    key.append(spline->evaluated_points_size());
+    key.append(spline->is_cyclic());
+  }
+  key.append(profiles.size());
+  for (const SplinePtr &profile : profiles) {
+    key.append(profile->evaluated_points_size());
+    key.append(profile->is_cyclic());
+    if (profile->type() == CURVE_TYPE_BEZIER) {
+      const BezierSpline &bezier_spline = static_cast<const BezierSpline &>(*profile);
+      Span<int> control_point_offsets = bezier_spline.control_point_offsets();
+      for (const int i : IndexRange(bezier_spline.size())) {
+        if (bezier_spline.point_is_sharp(i)) {
+          key.append(control_point_offsets[i]);
+        }
+      }
+    }
+    /* Separate the sharp points from the next profile. */
+    key.append(-1);
+  }
+  return key;
+}
+
+template<typename T> static void copy_parallel(const Span<T> src, MutableSpan<T> dst)
+{
+  threading::parallel_for(src.index_range(), 4096, [&](const IndexRange range) {
+    dst.slice(range).copy_from(src.slice(range));
+  });
+}
+
+static bool topology_cache_try_copy(const Span<int> key, Mesh &mesh)
+{
+  std::lock_guard lock{TOPOLOGY_CACHE.mutex};
+  if (TOPOLOGY_CACHE.key.as_span() != key) {
+    return false;
+  }
+  copy_parallel(TOPOLOGY_CACHE.edges.as_span(), {mesh.medge, mesh.totedge});
+  copy_parallel(TOPOLOGY_CACHE.loops.as_span(), {mesh.mloop, mesh.totloop});
+  copy_parallel(TOPOLOGY_CACHE.polys.as_span(), {mesh.mpoly, mesh.totpoly});
+  return true;
+}
+
+static void topology_cache_store(const Span<int> key, const Mesh &mesh)
+{
+  std::lock_guard lock{TOPOLOGY_CACHE.mutex};
+  TOPOLOGY_CACHE.key.clear();
+  TOPOLOGY_CACHE.key.extend(key);
+  TOPOLOGY_CACHE.edges.reinitialize(mesh.totedge);
+  TOPOLOGY_CACHE.loops.reinitialize(mesh.totloop);
+  TOPOLOGY_CACHE.polys.reinitialize(mesh.totpoly);
+  copy_parallel(Span(mesh.medge, mesh.totedge), TOPOLOGY_CACHE.edges.as_mutable_span());
+  copy_parallel(Span(mesh.mloop, mesh.totloop), TOPOLOGY_CACHE.loops.as_mutable_span());
+  copy_parallel(Span(mesh.mpoly, mesh.totpoly), TOPOLOGY_CACHE.polys.as_mutable_span());
+}
+
 Mesh *curve_to_mesh_sweep(const CurveEval &curve, const CurveEval &profile, const bool fill_caps)
 {
   Span<SplinePtr> profiles = profile.splines();
@@ -698,6 +764,9 @@ Mesh *curve_to_mesh_sweep(const CurveEval &curve, const CurveEval &profile, cons
   mesh_component.replace(mesh, GeometryOwnershipType::Editable);
   ResultAttributes attributes = create_result_attributes(curve, profile, mesh_component);
 
+  const Vector<int> topology_key = calculate_topology_key(profiles, curves, fill_caps);
+  const bool topology_cached = topology_cache_try_copy(topology_key, *mesh);
+
   threading::parallel_for(curves.index_range(), 128, [&](IndexRange curves_range) {
     for (const int i_spline : curves_range) {
       const Spline &spline = *curves[i_spline];
@@ -722,12 +791,14 @@ Mesh *curve_to_mesh_sweep(const CurveEval &curve, const CurveEval &profile, cons
               profile.evaluated_edges_size(),
           };
 
-          spline_extrude_to_mesh_data(info,
-                                      fill_caps,
-                                      {mesh->mvert, mesh->totvert},
-                                      {mesh->medge, mesh->totedge},
-                                      {mesh->mloop, mesh->totloop},
-                                      {mesh->mpoly, mesh->totpoly});
+          if (!topology_cached) {
+            spline_extrude_to_mesh_topology(info,
+                                            fill_caps,
+                                            {mesh->medge, mesh->totedge},
+                                            {mesh->mloop, mesh->totloop},
+                                            {mesh->mpoly, mesh->totpoly});
+          }
+          spline_extrude_to_mesh_positions(info, {mesh->mvert, mesh->totvert});
 
           copy_point_domain_attributes_to_mesh(info, attributes);
         }
@@ -735,6 +806,10 @@ Mesh *curve_to_mesh_sweep(const CurveEval &curve, const CurveEval &profile, cons
     }
   });
 
+  if (!topology_cached) {
+    topology_cache_store(topology_key, *mesh);
+  }
+
   copy_spline_domain_attributes_to_mesh(curve, profile, offsets, attributes);
 
   for (OutputAttribute &output_attribute : attributes.attributes) {
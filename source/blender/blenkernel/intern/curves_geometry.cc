@@ -31,6 +31,8 @@ static const std::string ATTR_HANDLE_POSITION_RIGHT = "handle_right";
 static const std::string ATTR_NURBS_ORDER = "nurbs_order";
 static const std::string ATTR_NURBS_WEIGHT = "nurbs_weight";
 static const std::string ATTR_NURBS_KNOTS_MODE = "knots_mode";
+static const std::string ATTR_NORMAL_MODE = "normal_mode";
+static const std::string ATTR_TILT = "tilt";
 static const std::string ATTR_SURFACE_TRIANGLE_INDEX = "surface_triangle_index";
 static const std::string ATTR_SURFACE_TRIANGLE_COORDINATE = "surface_triangle_coordinate";
 
@@ -400,6 +402,27 @@ MutableSpan<float2> CurvesGeometry::surface_triangle_coords()
   return get_mutable_attribute<float2>(*this, ATTR_DOMAIN_CURVE, ATTR_SURFACE_TRIANGLE_COORDINATE);
 }
 
+VArray<int8_t> CurvesGeometry::normal_mode() const
+{
+  return get_varray_attribute<int8_t>(
+      *this, ATTR_DOMAIN_CURVE, ATTR_NORMAL_MODE, NORMAL_MODE_MINIMUM_TWIST);
+}
+
+MutableSpan<int8_t> CurvesGeometry::normal_mode()
+{
+  return get_mutable_attribute<int8_t>(*this, ATTR_DOMAIN_CURVE, ATTR_NORMAL_MODE);
+}
+
+Span<float> CurvesGeometry::tilt() const
+{
+  return get_span_attribute<float>(*this, ATTR_DOMAIN_POINT, ATTR_TILT);
+}
+
+MutableSpan<float> CurvesGeometry::tilt()
+{
+  return get_mutable_attribute<float>(*this, ATTR_DOMAIN_POINT, ATTR_TILT);
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -639,6 +662,239 @@ Span<float3> CurvesGeometry::evaluated_positions() const
   return this->runtime->evaluated_position_cache;
 }
 
+Span<float3> CurvesGeometry::evaluated_tangents() const
+{
+  if (!this->runtime->tangent_cache_dirty) {
+    return this->runtime->evaluated_tangents_cache;
+  }
+
+  /* A double checked lock. */
+  std::scoped_lock lock{this->runtime->tangent_cache_mutex};
+  if (!this->runtime->tangent_cache_dirty) {
+    return this->runtime->evaluated_tangents_cache;
+  }
+
+  threading::isolate_task([&]() {
+    const Span<float3> evaluated_positions = this->evaluated_positions();
+    const VArray<bool> cyclic = this->cyclic();
+
+    this->runtime->evaluated_tangents_cache.resize(this->evaluated_points_size());
+    MutableSpan<float3> tangents = this->runtime->evaluated_tangents_cache;
+
+    threading::parallel_for(this->curves_range(), 128, [&](IndexRange curves_range) {
+      for (const int curve_index : curves_range) {
+        const IndexRange evaluated_points = this->evaluated_range_for_curve(curve_index);
+        if (UNLIKELY(evaluated_points.is_empty())) {
+          continue;
+        }
+        curves::poly::calculate_tangents(evaluated_positions.slice(evaluated_points),
+                                         cyclic[curve_index],
+                                         tangents.slice(evaluated_points));
+      }
+    });
+
+    /* Correct the first and last tangents of non-cyclic Bezier curves so that they align with the
+     * inner handles. This is a separate loop to avoid the cost when Bezier curves aren't used. */
+    Vector<int64_t> bezier_indices;
+    const IndexMask bezier_mask = this->indices_for_curve_type(CURVE_TYPE_BEZIER, bezier_indices);
+    if (!bezier_mask.is_empty()) {
+      const Span<float3> positions = this->positions();
+      const Span<float3> handles_left = this->handle_positions_left();
+      const Span<float3> handles_right = this->handle_positions_right();
+
+      threading::parallel_for(bezier_mask.index_range(), 1024, [&](IndexRange range) {
+        for (const int curve_index : bezier_mask.slice(range)) {
+          if (cyclic[curve_index]) {
+            continue;
+          }
+          const IndexRange points = this->range_for_curve(curve_index);
+          const IndexRange evaluated_points = this->evaluated_range_for_curve(curve_index);
+
+          const float3 &first = positions[points.first()];
+          if (handles_right[points.first()] != first) {
+            tangents[evaluated_points.first()] = math::normalize(handles_right[points.first()] -
+                                                                 first);
+          }
+          const float3 &last = positions[points.last()];
+          if (handles_left[points.last()] != last) {
+            tangents[evaluated_points.last()] = math::normalize(last -
+                                                                handles_left[points.last()]);
+          }
+        }
+      });
+    }
+  });
+
+  this->runtime->tangent_cache_dirty = false;
+  return this->runtime->evaluated_tangents_cache;
+}
+
+Span<float3> CurvesGeometry::evaluated_normals() const
+{
+  if (!this->runtime->normal_cache_dirty) {
+    return this->runtime->evaluated_normals_cache;
+  }
+
+  /* A double checked lock. */
+  std::scoped_lock lock{this->runtime->normal_cache_mutex};
+  if (!this->runtime->normal_cache_dirty) {
+    return this->runtime->evaluated_normals_cache;
+  }
+
+  threading::isolate_task([&]() {
+    const Span<float3> evaluated_tangents = this->evaluated_tangents();
+    const VArray<int8_t> types = this->curve_types();
+    const VArray<bool> cyclic = this->cyclic();
+    const VArray<int8_t> normal_mode = this->normal_mode();
+    const Span<float> tilt = this->tilt();
+
+    this->runtime->evaluated_normals_cache.resize(this->evaluated_points_size());
+    MutableSpan<float3> evaluated_normals = this->runtime->evaluated_normals_cache;
+
+    threading::parallel_for(this->curves_range(), 128, [&](IndexRange curves_range) {
+      /* Reuse a buffer for the evaluated tilts. */
+      Vector<float> evaluated_tilts;
+
+      for (const int curve_index : curves_range) {
+        const IndexRange evaluated_points = this->evaluated_range_for_curve(curve_index);
+        if (UNLIKELY(evaluated_points.is_empty())) {
+          continue;
+        }
+        const Span<float3> tangents = evaluated_tangents.slice(evaluated_points);
+        MutableSpan<float3> normals = evaluated_normals.slice(evaluated_points);
+        switch (normal_mode[curve_index]) {
+          case NORMAL_MODE_Z_UP:
+            curves::poly::calculate_normals_z_up(tangents, normals);
+            break;
+          case NORMAL_MODE_MINIMUM_TWIST:
+            curves::poly::calculate_normals_minimum(tangents, cyclic[curve_index], normals);
+            break;
+        }
+
+        /* Rotate the generated normals with the interpolated tilt data. */
+        if (!tilt.is_empty()) {
+          const IndexRange points = this->range_for_curve(curve_index);
+          if (types[curve_index] == CURVE_TYPE_POLY) {
+            curves::poly::rotate_normals_by_tilts(tangents, tilt.slice(points), normals);
+          }
+          else {
+            evaluated_tilts.clear();
+            evaluated_tilts.resize(evaluated_points.size());
+            this->interpolate_to_evaluated(
+                curve_index, tilt.slice(points), evaluated_tilts.as_mutable_span());
+            curves::poly::rotate_normals_by_tilts(tangents, evaluated_tilts, normals);
+          }
+        }
+      }
+    });
+  });
+
+  this->runtime->normal_cache_dirty = false;
+  return this->runtime->evaluated_normals_cache;
+}
+
+void CurvesGeometry::ensure_evaluated_lengths() const
+{
+  if (!this->runtime->length_cache_dirty) {
+    return;
+  }
+
+  /* A double checked lock. */
+  std::scoped_lock lock{this->runtime->length_cache_mutex};
+  if (!this->runtime->length_cache_dirty) {
+    return;
+  }
+
+  threading::isolate_task([&]() {
+    /* Use an extra length value for the final cyclic segment for a consistent size
+     * (see comment on #evaluated_length_cache). */
+    const int total_size = this->evaluated_points_size() + this->curves_size();
+    this->runtime->evaluated_length_cache.resize(total_size);
+    MutableSpan<float> evaluated_lengths = this->runtime->evaluated_length_cache;
+
+    const Span<float3> evaluated_positions = this->evaluated_positions();
+    const VArray<bool> cyclic = this->cyclic();
+
+    threading::parallel_for(this->curves_range(), 128, [&](IndexRange curves_range) {
+      for (const int curve_index : curves_range) {
+        const bool is_cyclic = cyclic[curve_index];
+        const IndexRange evaluated_points = this->evaluated_range_for_curve(curve_index);
+        if (UNLIKELY(evaluated_points.is_empty())) {
+          continue;
+        }
+        const IndexRange lengths_range = this->lengths_range_for_curve(curve_index, is_cyclic);
+        curves::poly::calculate_accumulated_lengths(evaluated_positions.slice(evaluated_points),
+                                                    is_cyclic,
+                                                    evaluated_lengths.slice(lengths_range));
+      }
+    });
+  });
+
+  this->runtime->length_cache_dirty = false;
+}
+
+IndexRange CurvesGeometry::lengths_range_for_curve(const int curve_index, const bool cyclic) const
+{
+  BLI_assert(cyclic == this->cyclic()[curve_index]);
+  const IndexRange points = this->evaluated_range_for_curve(curve_index);
+  const int start = points.start() + curve_index;
+  const int size = curves::curve_segment_size(points.size(), cyclic);
+  return {start, std::max(size, 0)};
+}
+
+Span<float> CurvesGeometry::evaluated_lengths_for_curve(const int curve_index,
+                                                       const bool cyclic) const
+{
+  BLI_assert(!this->runtime->length_cache_dirty);
+  const IndexRange range = this->lengths_range_for_curve(curve_index, cyclic);
+  return this->runtime->evaluated_length_cache.as_span().slice(range);
+}
+
+float CurvesGeometry::evaluated_length_total_for_curve(const int curve_index,
+                                                       const bool cyclic) const
+{
+  const Span<float> lengths = this->evaluated_lengths_for_curve(curve_index, cyclic);
+  return lengths.is_empty() ? 0.0f : lengths.last();
+}
+
+void CurvesGeometry::interpolate_to_evaluated(const int curve_index,
+                                              const GSpan src,
+                                              GMutableSpan dst) const
+{
+  const IndexRange points = this->range_for_curve(curve_index);
+  BLI_assert(src.size() == points.size());
+  /* Make sure the evaluated offsets are calculated, the Bezier interpolation uses them. */
+  this->evaluated_offsets();
+  const IndexRange evaluated_points = this->evaluated_range_for_curve(curve_index);
+  BLI_assert(dst.size() == evaluated_points.size());
+  UNUSED_VARS_NDEBUG(evaluated_points);
+
+  switch (this->curve_types()[curve_index]) {
+    case CURVE_TYPE_CATMULL_ROM:
+      curves::catmull_rom::interpolate_to_evaluated(
+          src, this->cyclic()[curve_index], this->resolution()[curve_index], dst);
+      return;
+    case CURVE_TYPE_POLY:
+      dst.type().copy_assign_n(src.data(), dst.data(), src.size());
+      return;
+    case CURVE_TYPE_BEZIER:
+      curves::bezier::interpolate_to_evaluated(
+          src, this->runtime->bezier_evaluated_offsets.as_span().slice(points), dst);
+      return;
+    case CURVE_TYPE_NURBS: {
+      this->ensure_nurbs_basis_cache();
+      const Span<float> weights = this->nurbs_weights();
+      curves::nurbs::interpolate_to_evaluated(this->runtime->nurbs_basis_cache[curve_index],
+                                              this->nurbs_orders()[curve_index],
+                                              weights.is_empty() ? weights : weights.slice(points),
+                                              src,
+                                              dst);
+      return;
+    }
+  }
+  BLI_assert_unreachable();
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -665,12 +921,14 @@ void CurvesGeometry::tag_positions_changed()
   this->runtime->position_cache_dirty = true;
   this->runtime->tangent_cache_dirty = true;
   this->runtime->normal_cache_dirty = true;
+  this->runtime->length_cache_dirty = true;
 }
 void CurvesGeometry::tag_topology_changed()
 {
   this->runtime->position_cache_dirty = true;
   this->runtime->tangent_cache_dirty = true;
   this->runtime->normal_cache_dirty = true;
+  this->runtime->length_cache_dirty = true;
   this->runtime->offsets_cache_dirty = true;
   this->runtime->nurbs_basis_cache_dirty = true;
 }
@@ -383,4 +383,38 @@ TEST(curves_geometry, NURBSEvaluation)
   }
 }
 
+TEST(curves_geometry, PolyTangentsNormalsLengths)
+{
+  CurvesGeometry curves(4, 1);
+  curves.curve_types().fill(CURVE_TYPE_POLY);
+  curves.offsets().last() = 4;
+
+  MutableSpan<float3> positions = curves.positions();
+  positions[0] = {0, 0, 0};
+  positions[1] = {1, 0, 0};
+  positions[2] = {1, 1, 0};
+  positions[3] = {0, 1, 0};
+
+  const Span<float3> tangents = curves.evaluated_tangents();
+  EXPECT_V3_NEAR(tangents[0], float3(1, 0, 0), 1e-5f);
+  EXPECT_V3_NEAR(tangents[1], float3(M_SQRT1_2, M_SQRT1_2, 0), 1e-5f);
+  EXPECT_V3_NEAR(tangents[3], float3(-1, 0, 0), 1e-5f);
+
+  const Span<float3> normals = curves.evaluated_normals();
+  for (const int i : normals.index_range()) {
+    EXPECT_NEAR(math::dot(normals[i], tangents[i]), 0.0f, 1e-5f);
+  }
+
+  curves.ensure_evaluated_lengths();
+  const Span<float> lengths = curves.evaluated_lengths_for_curve(0, false);
+  EXPECT_EQ(lengths.size(), 3);
+  EXPECT_NEAR(lengths[2], 3.0f, 1e-5f);
+
+  curves.cyclic().fill(true);
+  curves.tag_topology_changed();
+  curves.ensure_evaluated_lengths();
+  EXPECT_EQ(curves.evaluated_lengths_for_curve(0, true).size(), 4);
+  EXPECT_NEAR(curves.evaluated_length_total_for_curve(0, true), 4.0f, 1e-5f);
+}
+
 }  // namespace blender::bke::tests
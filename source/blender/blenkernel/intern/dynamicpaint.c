@@ -3265,9 +3265,28 @@ static void dynamic_paint_output_surface_image_wetmap_cb(
   ibuf->rect_float[pos + 3] = 1.0f;
 }
 
+typedef struct DynamicPaintSaveImageTaskData {
+  ImBuf *ibuf;
+  char filepath[FILE_MAX];
+} DynamicPaintSaveImageTaskData;
+
+static void dynamic_paint_save_image_task(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  DynamicPaintSaveImageTaskData *data = taskdata;
+  IMB_saveiff(data->ibuf, data->filepath, IB_rectfloat);
+}
+
+static void dynamic_paint_save_image_task_free(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  DynamicPaintSaveImageTaskData *data = taskdata;
+  IMB_freeImBuf(data->ibuf);
+  MEM_freeN(data);
+}
+
 void dynamicPaint_outputSurfaceImage(DynamicPaintSurface *surface,
                                      char *filename,
-                                     short output_layer)
+                                     short output_layer,
+                                     TaskPool *save_pool)
 {
   ImBuf *ibuf = NULL;
   PaintSurfaceData *sData = surface->data;
@@ -3392,7 +3411,18 @@ void dynamicPaint_outputSurfaceImage(DynamicPaintSurface *surface,
     ibuf->foptions.quality = 15;
   }
 
-  /* Save image */
+  /* Save image, encoding and writing the file doesn't touch the surface anymore. */
+  if (save_pool) {
+    DynamicPaintSaveImageTaskData *task_data = MEM_mallocN(sizeof(*task_data), __func__);
+    task_data->ibuf = ibuf;
+    BLI_strncpy(task_data->filepath, output_file, sizeof(task_data->filepath));
+    BLI_task_pool_push(save_pool,
+                       dynamic_paint_save_image_task,
+                       task_data,
+                       true,
+                       dynamic_paint_save_image_task_free);
+    return;
+  }
   IMB_saveiff(ibuf, output_file, IB_rectfloat);
   IMB_freeImBuf(ibuf);
 }
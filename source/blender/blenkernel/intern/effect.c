@@ -29,6 +29,7 @@
 #include "BLI_math.h"
 #include "BLI_noise.h"
 #include "BLI_rand.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "PIL_time.h"
@@ -132,7 +133,7 @@ void BKE_partdeflect_free(PartDeflect *pd)
 
 /******************** EFFECTOR RELATIONS ***********************/
 
-static void precalculate_effector(struct Depsgraph *depsgraph, EffectorCache *eff)
+static void effector_random_reset(struct Depsgraph *depsgraph, EffectorCache *eff)
 {
   float ctime = DEG_get_ctime(depsgraph);
   uint cfra = (uint)(ctime >= 0 ? ctime : -ctime);
@@ -142,6 +143,12 @@ static void precalculate_effector(struct Depsgraph *depsgraph, EffectorCache *ef
   else {
     BLI_rng_srandom(eff->pd->rng, eff->pd->seed + cfra);
   }
+}
+
+static void precalculate_effector(struct Depsgraph *depsgraph, EffectorCache *eff)
+{
+  float ctime = DEG_get_ctime(depsgraph);
+  effector_random_reset(depsgraph, eff);
 
   if (eff->pd->forcefield == PFIELD_GUIDE && eff->ob->type == OB_CURVES_LEGACY) {
     Curve *cu = eff->ob->data;
@@ -366,6 +373,15 @@ ListBase *BKE_effectors_create(Depsgraph *depsgraph,
   return effectors;
 }
 
+void BKE_effectors_random_reset(ListBase *effectors)
+{
+  if (effectors) {
+    LISTBASE_FOREACH (EffectorCache *, eff, effectors) {
+      effector_random_reset(eff->depsgraph, eff);
+    }
+  }
+}
+
 void BKE_effectors_free(ListBase *lb)
 {
   if (lb) {
@@ -1113,6 +1129,58 @@ static void do_physical_effector(EffectorCache *eff,
   }
 }
 
+/* Accumulate the force of a single effector on a point, see #BKE_effectors_apply. */
+static void effector_apply(EffectorCache *eff,
+                           ListBase *colliders,
+                           EffectorWeights *weights,
+                           EffectedPoint *point,
+                           float *force,
+                           float *wind_force,
+                           float *impulse)
+{
+  EffectorData efd;
+  int p = 0, tot = 1, step = 1;
+
+  get_effector_tot(eff, &efd, point, &tot, &p, &step);
+
+  for (; p < tot; p += step) {
+    if (get_effector_data(eff, &efd, point, 0)) {
+      efd.falloff = effector_falloff(eff, &efd, point, weights);
+
+      if (efd.falloff > 0.0f) {
+        efd.falloff *= eff_calc_visibility(colliders, eff, &efd, point);
+      }
+      if (efd.falloff > 0.0f) {
+        float out_force[3] = {0, 0, 0};
+
+        if (eff->pd->forcefield == PFIELD_TEXTURE) {
+          do_texture_effector(eff, &efd, point, out_force);
+        }
+        else {
+          do_physical_effector(eff, &efd, point, out_force);
+
+          /* for softbody backward compatibility */
+          if (point->flag & PE_WIND_AS_SPEED && impulse) {
+            sub_v3_v3v3(impulse, impulse, out_force);
+          }
+        }
+
+        if (wind_force) {
+          madd_v3_v3fl(force, out_force, 1.0f - eff->pd->f_wind_factor);
+          madd_v3_v3fl(wind_force, out_force, eff->pd->f_wind_factor);
+        }
+        else {
+          add_v3_v3(force, out_force);
+        }
+      }
+    }
+    else if (eff->flag & PE_VELOCITY_TO_IMPULSE && impulse) {
+      /* special case for harmonic effector */
+      add_v3_v3v3(impulse, impulse, efd.vel);
+    }
+  }
+}
+
 void BKE_effectors_apply(ListBase *effectors,
                          ListBase *colliders,
                          EffectorWeights *weights,
@@ -1151,8 +1219,6 @@ void BKE_effectors_apply(ListBase *effectors,
    *     (is independent of other effectors)
    */
   EffectorCache *eff;
-  EffectorData efd;
-  int p = 0, tot = 1, step = 1;
 
   /* Cycle through collected objects, get total of (1/(gravity_strength * dist^gravity_power)) */
   /* Check for min distance here? (yes would be cool to add that, ton) */
@@ -1160,47 +1226,95 @@ void BKE_effectors_apply(ListBase *effectors,
   if (effectors) {
     for (eff = effectors->first; eff; eff = eff->next) {
       /* object effectors were fully checked to be OK to evaluate! */
+      effector_apply(eff, colliders, weights, point, force, wind_force, impulse);
+    }
+  }
+}
 
-      get_effector_tot(eff, &efd, point, &tot, &p, &step);
-
-      for (; p < tot; p += step) {
-        if (get_effector_data(eff, &efd, point, 0)) {
-          efd.falloff = effector_falloff(eff, &efd, point, weights);
+/* Number of points evaluated by one task in #BKE_effectors_apply_array. */
+#define EFFECTORS_APPLY_CHUNK_SIZE 256
+
+typedef struct EffectorsApplyData {
+  ListBase *effectors;
+  ListBase *colliders;
+  EffectorWeights *weights;
+  EffectedPoint *points;
+  int points_num;
+  float (*force)[3];
+  float (*wind_force)[3];
+  float (*impulse)[3];
+} EffectorsApplyData;
+
+static void effectors_apply_array_chunk(void *__restrict userdata,
+                                        const int chunk,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const EffectorsApplyData *data = userdata;
+  const int start = chunk * EFFECTORS_APPLY_CHUNK_SIZE;
+  const int end = min_ii(start + EFFECTORS_APPLY_CHUNK_SIZE, data->points_num);
+
+  /* One effector at a time, so its data stays in cache while going over the points. The forces
+   * of every point are still accumulated in the same order as #BKE_effectors_apply. */
+  LISTBASE_FOREACH (EffectorCache *, eff, data->effectors) {
+    for (int i = start; i < end; i++) {
+      effector_apply(eff,
+                     data->colliders,
+                     data->weights,
+                     &data->points[i],
+                     data->force[i],
+                     data->wind_force ? data->wind_force[i] : NULL,
+                     data->impulse ? data->impulse[i] : NULL);
+    }
+  }
+}
 
-          if (efd.falloff > 0.0f) {
-            efd.falloff *= eff_calc_visibility(colliders, eff, &efd, point);
-          }
-          if (efd.falloff > 0.0f) {
-            float out_force[3] = {0, 0, 0};
-
-            if (eff->pd->forcefield == PFIELD_TEXTURE) {
-              do_texture_effector(eff, &efd, point, out_force);
-            }
-            else {
-              do_physical_effector(eff, &efd, point, out_force);
-
-              /* for softbody backward compatibility */
-              if (point->flag & PE_WIND_AS_SPEED && impulse) {
-                sub_v3_v3v3(impulse, impulse, out_force);
-              }
-            }
-
-            if (wind_force) {
-              madd_v3_v3fl(force, out_force, 1.0f - eff->pd->f_wind_factor);
-              madd_v3_v3fl(wind_force, out_force, eff->pd->f_wind_factor);
-            }
-            else {
-              add_v3_v3(force, out_force);
-            }
-          }
-        }
-        else if (eff->flag & PE_VELOCITY_TO_IMPULSE && impulse) {
-          /* special case for harmonic effector */
-          add_v3_v3v3(impulse, impulse, efd.vel);
-        }
-      }
+/**
+ * Whether points can be evaluated in parallel. Noise uses the random generator of the effector,
+ * its values are only deterministic when points are evaluated in order. Texture fields and
+ * particle effectors use evaluation code that isn't thread safe.
+ */
+static bool effectors_apply_use_threading(ListBase *effectors)
+{
+  LISTBASE_FOREACH (EffectorCache *, eff, effectors) {
+    if (eff->psys || eff->pd->forcefield == PFIELD_TEXTURE || eff->pd->f_noise > 0.0f) {
+      return false;
     }
   }
+  return true;
+}
+
+void BKE_effectors_apply_array(ListBase *effectors,
+                               ListBase *colliders,
+                               EffectorWeights *weights,
+                               EffectedPoint *points,
+                               const int points_num,
+                               float (*force)[3],
+                               float (*wind_force)[3],
+                               float (*impulse)[3])
+{
+  if (effectors == NULL || points_num == 0) {
+    return;
+  }
+
+  EffectorsApplyData data = {
+      .effectors = effectors,
+      .colliders = colliders,
+      .weights = weights,
+      .points = points,
+      .points_num = points_num,
+      .force = force,
+      .wind_force = wind_force,
+      .impulse = impulse,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = effectors_apply_use_threading(effectors);
+  BLI_task_parallel_range(0,
+                          (int)divide_ceil_u((uint)points_num, EFFECTORS_APPLY_CHUNK_SIZE),
+                          &data,
+                          effectors_apply_array_chunk,
+                          &settings);
 }
 
 /* ======== Simulation Debugging ======== */
@@ -1728,7 +1728,27 @@ static float fcurve_eval_keyframes_interpolate(FCurve *fcu, BezTriple *bezts, fl
    *   Weird errors, like selecting the wrong keyframe range (see T39207), occur.
    *   This lower bound was established in b888a32eee8147b028464336ad2404d8155c64dd.
    */
-  a = BKE_fcurve_bezt_binarysearch_index_ex(bezts, evaltime, fcu->totvert, 0.0001, &exact);
+  const float threshold = 0.0001f;
+
+  /* Playback evaluates a curve at increasing times, so the segment of the previous evaluation or
+   * the one after it usually contain the evaltime. Only use them when the evaltime is not within
+   * the threshold of their keys, that gives the same result as the binary search. */
+  const int totvert = (int)fcu->totvert;
+  a = (unsigned int)fcu->eval_segment_index;
+  if (fcu->eval_segment_index > 0 && fcu->eval_segment_index < totvert &&
+      bezts[a - 1].vec[1][0] + threshold < evaltime && evaltime < bezts[a].vec[1][0] - threshold) {
+    /* Same segment as the previous evaluation. */
+  }
+  else if (fcu->eval_segment_index > 0 && fcu->eval_segment_index + 1 < totvert &&
+           bezts[a].vec[1][0] + threshold < evaltime &&
+           evaltime < bezts[a + 1].vec[1][0] - threshold) {
+    a++;
+    fcu->eval_segment_index = (int)a;
+  }
+  else {
+    a = BKE_fcurve_bezt_binarysearch_index_ex(bezts, evaltime, fcu->totvert, threshold, &exact);
+    fcu->eval_segment_index = (int)a;
+  }
   bezt = bezts + a;
 
   if (exact) {
@@ -1058,6 +1058,19 @@ bool BKE_driver_has_simple_expression(ChannelDriver *driver)
   return driver_compile_simple_expr(driver) && BLI_expr_pylike_is_valid(driver->expr_simple);
 }
 
+const char *BKE_driver_simple_expression_error(ChannelDriver *driver)
+{
+  if (!driver_compile_simple_expr(driver)) {
+    return NULL;
+  }
+
+  const int offset = BLI_expr_pylike_error_offset(driver->expr_simple);
+  if (offset < 0 || (size_t)offset > strlen(driver->expression)) {
+    return NULL;
+  }
+  return driver->expression + offset;
+}
+
 /* TODO(sergey): This is somewhat weak, but we don't want neither false-positive
  * time dependencies nor special exceptions in the depsgraph evaluation. */
 static bool python_driver_exression_depends_on_time(const char *expression)
@@ -197,6 +197,32 @@ TEST(evaluate_fcurve, ExtrapolationBezierKeys)
   BKE_fcurve_free(fcu);
 }
 
+TEST(evaluate_fcurve, SegmentHint)
+{
+  FCurve *fcu = BKE_fcurve_create();
+
+  for (int i = 0; i < 5; i++) {
+    insert_vert_fcurve(fcu, float(i), float(i * i), BEZT_KEYTYPE_KEYFRAME, INSERTKEY_NO_USERPREF);
+    fcu->bezt[i].ipo = BEZT_IPO_LIN;
+  }
+
+  /* Forward, within the previous segment, the next one, and jumping back. */
+  EXPECT_NEAR(evaluate_fcurve(fcu, 0.5f), 0.5f, EPSILON);
+  EXPECT_NEAR(evaluate_fcurve(fcu, 0.75f), 0.75f, EPSILON);
+  EXPECT_NEAR(evaluate_fcurve(fcu, 1.5f), 2.5f, EPSILON);
+  EXPECT_NEAR(evaluate_fcurve(fcu, 3.5f), 12.5f, EPSILON);
+  EXPECT_NEAR(evaluate_fcurve(fcu, 2.0f), 4.0f, EPSILON);
+  EXPECT_NEAR(evaluate_fcurve(fcu, 0.25f), 0.25f, EPSILON);
+
+  /* The hint is validated against the keys, which may have changed since. */
+  fcu->eval_segment_index = 100;
+  EXPECT_NEAR(evaluate_fcurve(fcu, 2.5f), 6.5f, EPSILON);
+  fcu->bezt[3].vec[1][0] = 2.25f;
+  EXPECT_NEAR(evaluate_fcurve(fcu, 2.5f), 9.0f + (16.0f - 9.0f) * (0.25f / 1.75f), 1e-5f);
+
+  BKE_fcurve_free(fcu);
+}
+
 TEST(fcurve_subdivide, BKE_fcurve_bezt_subdivide_handles)
 {
   FCurve *fcu = BKE_fcurve_create();
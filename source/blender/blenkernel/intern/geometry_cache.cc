@@ -0,0 +1,653 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bke
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_endian_defines.h"
+#include "BLI_fileops.h"
+#include "BLI_fileops_types.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_task.h"
+
+#include "DNA_curves_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_pointcloud_types.h"
+
+#include "BKE_curves.hh"
+#include "BKE_customdata.h"
+#include "BKE_geometry_cache.hh"
+#include "BKE_lib_id.h"
+#include "BKE_mesh.h"
+#include "BKE_pointcloud.h"
+
+namespace blender::bke {
+
+/* -------------------------------------------------------------------- */
+/** \name Cache Files
+ *
+ * A file starts with a #FileHeader, followed by each component: its #GeometryComponentType, the
+ * domain sizes and the custom data of every domain. Every array starts at a multiple of
+ * #array_alignment bytes in the file, and is stored with the endianness of the writing platform.
+ * \{ */
+
+static constexpr char file_magic[8] = {'B', 'G', 'E', 'O', 'C', 'A', 'C', 'H'};
+static constexpr int32_t file_version = 1;
+static constexpr int64_t array_alignment = 16;
+static const char *file_extension = ".geocache";
+
+struct FileHeader {
+  char magic[8];
+  int32_t version;
+  int32_t endian;
+  int32_t components_num;
+  int32_t _pad;
+};
+
+struct LayerHeader {
+  int32_t type;
+  int32_t active;
+  int32_t active_rnd;
+  int32_t _pad;
+  char name[MAX_CUSTOMDATA_LAYER_NAME];
+  int64_t size;
+};
+
+class CacheFileWriter {
+ private:
+  FILE *file_;
+  int64_t offset_ = 0;
+  bool is_valid_ = true;
+
+ public:
+  CacheFileWriter(FILE *file) : file_(file)
+  {
+  }
+
+  bool is_valid() const
+  {
+    return is_valid_;
+  }
+
+  void write(const void *data, const int64_t size)
+  {
+    if (is_valid_ && size > 0) {
+      is_valid_ = fwrite(data, 1, size_t(size), file_) == size_t(size);
+    }
+    offset_ += size;
+  }
+
+  template<typename T> void write_value(const T &value)
+  {
+    this->write(&value, sizeof(T));
+  }
+
+  void write_array(const void *data, const int64_t size)
+  {
+    static constexpr char zeros[array_alignment] = {0};
+    this->write(zeros, (array_alignment - offset_ % array_alignment) % array_alignment);
+    this->write(data, size);
+  }
+};
+
+class CacheFileReader {
+ private:
+  FILE *file_;
+  int64_t offset_ = 0;
+  bool is_valid_ = true;
+
+ public:
+  CacheFileReader(FILE *file) : file_(file)
+  {
+  }
+
+  bool is_valid() const
+  {
+    return is_valid_;
+  }
+
+  bool read(void *r_data, const int64_t size)
+  {
+    if (is_valid_ && size > 0) {
+      is_valid_ = fread(r_data, 1, size_t(size), file_) == size_t(size);
+    }
+    offset_ += size;
+    return is_valid_;
+  }
+
+  template<typename T> bool read_value(T &r_value)
+  {
+    return this->read(&r_value, sizeof(T));
+  }
+
+  bool read_array(void *r_data, const int64_t size)
+  {
+    const int64_t padding = (array_alignment - offset_ % array_alignment) % array_alignment;
+    if (is_valid_ && padding > 0) {
+      is_valid_ = fseek(file_, long(padding), SEEK_CUR) == 0;
+    }
+    offset_ += padding;
+    return this->read(r_data, size);
+  }
+};
+
+static bool custom_data_layer_is_written(const CustomDataLayer &layer)
+{
+  return layer.data != nullptr && layer.anonymous_id == nullptr &&
+         !(layer.flag & CD_FLAG_NOCOPY) && !CustomData_layertype_is_dynamic(layer.type);
+}
+
+static void write_custom_data(CacheFileWriter &writer, const CustomData &data, const int size)
+{
+  const Span<CustomDataLayer> layers(data.layers, data.totlayer);
+  int32_t layers_num = 0;
+  for (const CustomDataLayer &layer : layers) {
+    layers_num += custom_data_layer_is_written(layer);
+  }
+  writer.write_value(layers_num);
+
+  for (const CustomDataLayer &layer : layers) {
+    if (!custom_data_layer_is_written(layer)) {
+      continue;
+    }
+    LayerHeader header = {0};
+    header.type = layer.type;
+    header.active = layer.active;
+    header.active_rnd = layer.active_rnd;
+    STRNCPY(header.name, layer.name);
+    header.size = int64_t(CustomData_sizeof(layer.type)) * size;
+    writer.write_value(header);
+    writer.write_array(layer.data, header.size);
+  }
+}
+
+static bool read_custom_data(CacheFileReader &reader, CustomData &data, const int size)
+{
+  int32_t layers_num;
+  if (!reader.read_value(layers_num)) {
+    return false;
+  }
+  Vector<LayerHeader> headers;
+  for (int i = 0; i < layers_num; i++) {
+    LayerHeader header;
+    if (!reader.read_value(header)) {
+      return false;
+    }
+    if (header.type < 0 || header.type >= CD_NUMTYPES ||
+        CustomData_layertype_is_dynamic(header.type) ||
+        header.size != int64_t(CustomData_sizeof(header.type)) * size) {
+      return false;
+    }
+    header.name[sizeof(header.name) - 1] = '\0';
+
+    /* Read into the layers that are created with the geometry, e.g. positions. */
+    void *layer_data = CustomData_layertype_is_singleton(header.type) ?
+                           CustomData_get_layer(&data, header.type) :
+                           CustomData_get_layer_named(&data, header.type, header.name);
+    if (layer_data != nullptr) {
+      if (!reader.read_array(layer_data, header.size)) {
+        return false;
+      }
+    }
+    else {
+      /* Assign the array to the layer after reading, avoiding to initialize it first. */
+      layer_data = MEM_malloc_arrayN(
+          size_t(size), size_t(CustomData_sizeof(header.type)), __func__);
+      if (!reader.read_array(layer_data, header.size)) {
+        MEM_freeN(layer_data);
+        return false;
+      }
+      CustomData_add_layer_named(&data, header.type, CD_ASSIGN, layer_data, size, header.name);
+    }
+    headers.append(header);
+  }
+
+  for (const LayerHeader &header : headers) {
+    CustomData_set_layer_active(&data, header.type, header.active);
+    CustomData_set_layer_render(&data, header.type, header.active_rnd);
+  }
+  return true;
+}
+
+static void write_mesh(CacheFileWriter &writer, const Mesh &mesh)
+{
+  writer.write_value(int32_t(GEO_COMPONENT_TYPE_MESH));
+  const int32_t sizes[4] = {mesh.totvert, mesh.totedge, mesh.totloop, mesh.totpoly};
+  writer.write(sizes, sizeof(sizes));
+  write_custom_data(writer, mesh.vdata, mesh.totvert);
+  write_custom_data(writer, mesh.edata, mesh.totedge);
+  write_custom_data(writer, mesh.ldata, mesh.totloop);
+  write_custom_data(writer, mesh.pdata, mesh.totpoly);
+}
+
+static Mesh *read_mesh(CacheFileReader &reader)
+{
+  int32_t sizes[4];
+  if (!reader.read(sizes, sizeof(sizes)) || sizes[0] < 0 || sizes[1] < 0 || sizes[2] < 0 ||
+      sizes[3] < 0) {
+    return nullptr;
+  }
+  Mesh *mesh = BKE_mesh_new_nomain(sizes[0], sizes[1], 0, sizes[2], sizes[3]);
+  if (!read_custom_data(reader, mesh->vdata, mesh->totvert) ||
+      !read_custom_data(reader, mesh->edata, mesh->totedge) ||
+      !read_custom_data(reader, mesh->ldata, mesh->totloop) ||
+      !read_custom_data(reader, mesh->pdata, mesh->totpoly)) {
+    BKE_id_free(nullptr, mesh);
+    return nullptr;
+  }
+  BKE_mesh_update_customdata_pointers(mesh, false);
+  BKE_mesh_normals_tag_dirty(mesh);
+  return mesh;
+}
+
+static void write_pointcloud(CacheFileWriter &writer, const PointCloud &pointcloud)
+{
+  writer.write_value(int32_t(GEO_COMPONENT_TYPE_POINT_CLOUD));
+  writer.write_value(int32_t(pointcloud.totpoint));
+  write_custom_data(writer, pointcloud.pdata, pointcloud.totpoint);
+}
+
+static PointCloud *read_pointcloud(CacheFileReader &reader)
+{
+  int32_t size;
+  if (!reader.read_value(size) || size < 0) {
+    return nullptr;
+  }
+  PointCloud *pointcloud = BKE_pointcloud_new_nomain(size);
+  if (!read_custom_data(reader, pointcloud->pdata, pointcloud->totpoint)) {
+    BKE_id_free(nullptr, pointcloud);
+    return nullptr;
+  }
+  BKE_pointcloud_update_customdata_pointers(pointcloud);
+  return pointcloud;
+}
+
+static void write_curves(CacheFileWriter &writer, const Curves &curves_id)
+{
+  const CurvesGeometry &curves = CurvesGeometry::wrap(curves_id.geometry);
+  writer.write_value(int32_t(GEO_COMPONENT_TYPE_CURVE));
+  const int32_t sizes[2] = {curves.points_size(), curves.curves_size()};
+  writer.write(sizes, sizeof(sizes));
+  writer.write_array(curves.offsets().data(), curves.offsets().size_in_bytes());
+  write_custom_data(writer, curves.point_data, curves.points_size());
+  write_custom_data(writer, curves.curve_data, curves.curves_size());
+}
+
+static Curves *read_curves(CacheFileReader &reader)
+{
+  int32_t sizes[2];
+  if (!reader.read(sizes, sizeof(sizes)) || sizes[0] < 0 || sizes[1] < 0) {
+    return nullptr;
+  }
+  Curves *curves_id = curves_new_nomain(sizes[0], sizes[1]);
+  CurvesGeometry &curves = CurvesGeometry::wrap(curves_id->geometry);
+  MutableSpan<int> offsets = curves.offsets();
+  bool is_valid = reader.read_array(offsets.data(), offsets.as_span().size_in_bytes());
+  /* Invalid offsets would cause out of bounds access later on. */
+  is_valid = is_valid && offsets.first() == 0 && offsets.last() == sizes[0];
+  for (const int i : IndexRange(sizes[1])) {
+    is_valid = is_valid && offsets[i] <= offsets[i + 1];
+  }
+  is_valid = is_valid && read_custom_data(reader, curves.point_data, sizes[0]) &&
+             read_custom_data(reader, curves.curve_data, sizes[1]);
+  if (!is_valid) {
+    BKE_id_free(nullptr, curves_id);
+    return nullptr;
+  }
+  curves.update_customdata_pointers();
+  return curves_id;
+}
+
+bool geometry_cache_file_supports(const GeometrySet &geometry)
+{
+  /* Material and object pointers can't be written to the file. */
+  if (geometry.has_instances() || geometry.has_volume()) {
+    return false;
+  }
+  const Mesh *mesh = geometry.get_mesh_for_read();
+  if (mesh != nullptr && mesh->totcol > 0) {
+    return false;
+  }
+  const PointCloud *pointcloud = geometry.get_pointcloud_for_read();
+  if (pointcloud != nullptr && pointcloud->totcol > 0) {
+    return false;
+  }
+  const Curves *curves = geometry.get_curves_for_read();
+  if (curves != nullptr && (curves->totcol > 0 || curves->surface != nullptr)) {
+    return false;
+  }
+  return true;
+}
+
+bool geometry_cache_write_file(const GeometrySet &geometry, const char *filepath)
+{
+  const Mesh *mesh = geometry.get_mesh_for_read();
+  const PointCloud *pointcloud = geometry.get_pointcloud_for_read();
+  const Curves *curves = geometry.get_curves_for_read();
+
+  /* Write to a temporary file first, so that a frame is never read while it is written. */
+  char filepath_tmp[FILE_MAX];
+  BLI_snprintf(filepath_tmp, sizeof(filepath_tmp), "%s@", filepath);
+  FILE *file = BLI_fopen(filepath_tmp, "wb");
+  if (file == nullptr) {
+    return false;
+  }
+
+  CacheFileWriter writer(file);
+  FileHeader header = {{0}};
+  memcpy(header.magic, file_magic, sizeof(header.magic));
+  header.version = file_version;
+  header.endian = ENDIAN_ORDER;
+  header.components_num = int32_t(mesh != nullptr) + int32_t(pointcloud != nullptr) +
+                          int32_t(curves != nullptr);
+  writer.write_value(header);
+
+  if (mesh != nullptr) {
+    write_mesh(writer, *mesh);
+  }
+  if (pointcloud != nullptr) {
+    write_pointcloud(writer, *pointcloud);
+  }
+  if (curves != nullptr) {
+    write_curves(writer, *curves);
+  }
+
+  const bool is_valid = writer.is_valid() && fclose(file) == 0;
+  if (!is_valid || BLI_rename(filepath_tmp, filepath) != 0) {
+    BLI_delete(filepath_tmp, false, false);
+    return false;
+  }
+  return true;
+}
+
+std::optional<GeometrySet> geometry_cache_read_file(const char *filepath)
+{
+  FILE *file = BLI_fopen(filepath, "rb");
+  if (file == nullptr) {
+    return std::nullopt;
+  }
+
+  CacheFileReader reader(file);
+  FileHeader header;
+  if (!reader.read_value(header) || memcmp(header.magic, file_magic, sizeof(file_magic)) != 0 ||
+      header.version != file_version || header.endian != ENDIAN_ORDER) {
+    fclose(file);
+    return std::nullopt;
+  }
+
+  GeometrySet geometry;
+  bool is_valid = true;
+  for (int i = 0; i < header.components_num && is_valid; i++) {
+    int32_t type;
+    if (!reader.read_value(type)) {
+      is_valid = false;
+      break;
+    }
+    switch (type) {
+      case GEO_COMPONENT_TYPE_MESH: {
+        Mesh *mesh = read_mesh(reader);
+        is_valid = mesh != nullptr;
+        geometry.replace_mesh(mesh);
+        break;
+      }
+      case GEO_COMPONENT_TYPE_POINT_CLOUD: {
+        PointCloud *pointcloud = read_pointcloud(reader);
+        is_valid = pointcloud != nullptr;
+        geometry.replace_pointcloud(pointcloud);
+        break;
+      }
+      case GEO_COMPONENT_TYPE_CURVE: {
+        Curves *curves = read_curves(reader);
+        is_valid = curves != nullptr;
+        geometry.replace_curves(curves);
+        break;
+      }
+      default:
+        is_valid = false;
+        break;
+    }
+  }
+  fclose(file);
+
+  if (!is_valid) {
+    return std::nullopt;
+  }
+  return geometry;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Frame Cache
+ * \{ */
+
+struct GeometryFrameCache::WriteTask {
+  GeometryFrameCache *cache;
+  GeometrySet geometry;
+  std::string filepath;
+  int frame;
+
+  static void run(TaskPool *__restrict UNUSED(pool), void *taskdata)
+  {
+    WriteTask &task = *static_cast<WriteTask *>(taskdata);
+    BLI_make_existing_file(task.filepath.c_str());
+    if (!geometry_cache_write_file(task.geometry, task.filepath.c_str())) {
+      std::scoped_lock lock{task.cache->failed_writes_mutex_};
+      task.cache->failed_writes_.append(task.frame);
+    }
+  }
+
+  static void free(TaskPool *__restrict UNUSED(pool), void *taskdata)
+  {
+    delete static_cast<WriteTask *>(taskdata);
+  }
+};
+
+static int64_t custom_data_size_in_bytes(const CustomData &data, const int size)
+{
+  int64_t size_in_bytes = 0;
+  for (const CustomDataLayer &layer : Span(data.layers, data.totlayer)) {
+    size_in_bytes += int64_t(CustomData_sizeof(layer.type)) * size;
+  }
+  return size_in_bytes;
+}
+
+static int64_t geometry_size_in_bytes(const GeometrySet &geometry)
+{
+  int64_t size_in_bytes = 0;
+  if (const Mesh *mesh = geometry.get_mesh_for_read()) {
+    size_in_bytes += custom_data_size_in_bytes(mesh->vdata, mesh->totvert);
+    size_in_bytes += custom_data_size_in_bytes(mesh->edata, mesh->totedge);
+    size_in_bytes += custom_data_size_in_bytes(mesh->ldata, mesh->totloop);
+    size_in_bytes += custom_data_size_in_bytes(mesh->pdata, mesh->totpoly);
+  }
+  if (const PointCloud *pointcloud = geometry.get_pointcloud_for_read()) {
+    size_in_bytes += custom_data_size_in_bytes(pointcloud->pdata, pointcloud->totpoint);
+  }
+  if (const Curves *curves_id = geometry.get_curves_for_read()) {
+    const CurvesGeometry &curves = CurvesGeometry::wrap(curves_id->geometry);
+    size_in_bytes += custom_data_size_in_bytes(curves.point_data, curves.points_size());
+    size_in_bytes += custom_data_size_in_bytes(curves.curve_data, curves.curves_size());
+    size_in_bytes += curves.offsets().size_in_bytes();
+  }
+  return size_in_bytes;
+}
+
+GeometryFrameCache::~GeometryFrameCache()
+{
+  if (write_pool_ != nullptr) {
+    BLI_task_pool_work_and_wait(write_pool_);
+    BLI_task_pool_free(write_pool_);
+  }
+}
+
+void GeometryFrameCache::set_memory_limit(const int64_t memory_limit)
+{
+  memory_limit_ = memory_limit;
+}
+
+void GeometryFrameCache::set_disk_directory(StringRefNull directory, StringRefNull file_prefix)
+{
+  if (StringRef(directory_) == directory && StringRef(file_prefix_) == file_prefix) {
+    return;
+  }
+  this->wait_for_writes();
+  directory_ = directory;
+  file_prefix_ = file_prefix;
+  disk_frames_.clear();
+  written_frames_.clear();
+  /* Changing the directory shouldn't invalidate the frames that exist in it. */
+  last_evaluated_frame_.reset();
+
+  if (directory_.empty() || !BLI_is_dir(directory_.c_str())) {
+    return;
+  }
+  const std::string prefix = file_prefix_ + "_";
+  struct direntry *entries;
+  const uint entries_num = BLI_filelist_dir_contents(directory_.c_str(), &entries);
+  for (const uint i : IndexRange(entries_num)) {
+    const StringRefNull name = entries[i].relname;
+    if (!name.startswith(prefix) || !name.endswith(file_extension)) {
+      continue;
+    }
+    const std::string frame_str = name.substr(prefix.size(),
+                                              name.size() - prefix.size() -
+                                                  strlen(file_extension));
+    char *frame_end;
+    const long frame = strtol(frame_str.c_str(), &frame_end, 10);
+    if (!frame_str.empty() && *frame_end == '\0') {
+      disk_frames_.add(int(frame));
+    }
+  }
+  BLI_filelist_free(entries, entries_num);
+}
+
+void GeometryFrameCache::tag_evaluation(const int frame)
+{
+  if (last_evaluated_frame_ == frame) {
+    this->clear();
+  }
+  last_evaluated_frame_ = frame;
+}
+
+std::optional<GeometrySet> GeometryFrameCache::lookup(const int frame)
+{
+  if (MemoryFrame *memory_frame = memory_frames_.lookup_ptr(frame)) {
+    memory_frame->last_used = ++use_counter_;
+    return memory_frame->geometry;
+  }
+  if (directory_.empty() || !disk_frames_.contains(frame)) {
+    return std::nullopt;
+  }
+  /* The frame may have been removed from memory before it has been written. */
+  this->wait_for_writes();
+  if (!disk_frames_.contains(frame)) {
+    return std::nullopt;
+  }
+  std::optional<GeometrySet> geometry = geometry_cache_read_file(
+      this->frame_filepath(frame).c_str());
+  if (!geometry.has_value()) {
+    disk_frames_.remove(frame);
+    return std::nullopt;
+  }
+  const int64_t size_in_bytes = geometry_size_in_bytes(*geometry);
+  memory_frames_.add_new(frame, {*geometry, size_in_bytes, ++use_counter_});
+  memory_size_ += size_in_bytes;
+  this->free_memory_frames_over_limit(frame);
+  return geometry;
+}
+
+void GeometryFrameCache::add(const int frame, const GeometrySet &geometry)
+{
+  const int64_t size_in_bytes = geometry_size_in_bytes(geometry);
+  if (const MemoryFrame *memory_frame = memory_frames_.lookup_ptr(frame)) {
+    memory_size_ -= memory_frame->size_in_bytes;
+  }
+  memory_frames_.add_overwrite(frame, {geometry, size_in_bytes, ++use_counter_});
+  memory_size_ += size_in_bytes;
+
+  if (!directory_.empty() && !disk_frames_.contains(frame) &&
+      geometry_cache_file_supports(geometry)) {
+    if (write_pool_ == nullptr) {
+      write_pool_ = BLI_task_pool_create_background_serial(nullptr, TASK_PRIORITY_LOW);
+    }
+    /* The geometry components are shared with the task, the evaluated geometry is never
+     * modified in place while the task holds a reference to it. */
+    WriteTask *task = new WriteTask{this, geometry, this->frame_filepath(frame), frame};
+    BLI_task_pool_push(write_pool_, WriteTask::run, task, true, WriteTask::free);
+    disk_frames_.add(frame);
+    written_frames_.add(frame);
+  }
+
+  this->free_memory_frames_over_limit(frame);
+}
+
+void GeometryFrameCache::clear()
+{
+  this->wait_for_writes();
+  memory_frames_.clear();
+  memory_size_ = 0;
+  for (const int frame : written_frames_) {
+    const std::string filepath = this->frame_filepath(frame);
+    if (BLI_exists(filepath.c_str())) {
+      BLI_delete(filepath.c_str(), false, false);
+    }
+  }
+  written_frames_.clear();
+  /* Frames that existed in the directory before are outdated too, they are overwritten when the
+   * frames are evaluated again. */
+  disk_frames_.clear();
+}
+
+std::string GeometryFrameCache::frame_filepath(const int frame) const
+{
+  char filename[FILE_MAXFILE];
+  BLI_snprintf(
+      filename, sizeof(filename), "%s_%06d%s", file_prefix_.c_str(), frame, file_extension);
+  char filepath[FILE_MAX];
+  BLI_join_dirfile(filepath, sizeof(filepath), directory_.c_str(), filename);
+  return filepath;
+}
+
+void GeometryFrameCache::wait_for_writes()
+{
+  if (write_pool_ == nullptr) {
+    return;
+  }
+  BLI_task_pool_work_and_wait(write_pool_);
+  std::scoped_lock lock{failed_writes_mutex_};
+  for (const int frame : failed_writes_) {
+    disk_frames_.remove(frame);
+    written_frames_.remove(frame);
+  }
+  failed_writes_.clear();
+}
+
+void GeometryFrameCache::free_memory_frames_over_limit(const int frame_to_keep)
+{
+  while (memory_limit_ > 0 && memory_size_ > memory_limit_) {
+    /* Remove the frame that was used least recently. */
+    std::optional<int> frame_to_remove;
+    uint64_t oldest_use = UINT64_MAX;
+    for (const auto item : memory_frames_.items()) {
+      if (item.key != frame_to_keep && item.value.last_used < oldest_use) {
+        frame_to_remove = item.key;
+        oldest_use = item.value.last_used;
+      }
+    }
+    if (!frame_to_remove.has_value()) {
+      break;
+    }
+    memory_size_ -= memory_frames_.pop(*frame_to_remove).size_in_bytes;
+  }
+}
+
+/** \} */
+
+}  // namespace blender::bke
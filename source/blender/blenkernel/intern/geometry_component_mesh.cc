@@ -251,6 +251,63 @@ static GVArray adapt_mesh_domain_corner_to_point(const Mesh &mesh, const GVArray
   return new_varray;
 }
 
+/**
+ * A virtual array that copies the value at an index of another domain for every element. Only
+ * the accessed elements are computed, and materializing checks the source array once, so that
+ * the values of a span are gathered without a virtual call for every element.
+ */
+template<typename T, typename IndexFn>
+class VArrayImpl_For_MeshDomainCopy final : public VArrayImpl<T> {
+ private:
+  VArray<T> src_;
+  IndexFn index_fn_;
+
+ public:
+  VArrayImpl_For_MeshDomainCopy(const int64_t size, VArray<T> src, IndexFn index_fn)
+      : VArrayImpl<T>(size), src_(std::move(src)), index_fn_(std::move(index_fn))
+  {
+  }
+
+ private:
+  T get(const int64_t index) const override
+  {
+    return src_[index_fn_(index)];
+  }
+
+  template<typename Fn> void foreach_value(const IndexMask mask, const Fn &fn) const
+  {
+    if (src_.is_span()) {
+      const Span<T> src = src_.get_internal_span();
+      mask.foreach_index([&](const int64_t i) { fn(i, src[index_fn_(i)]); });
+    }
+    else {
+      mask.foreach_index([&](const int64_t i) { fn(i, src_[index_fn_(i)]); });
+    }
+  }
+
+  void materialize(IndexMask mask, MutableSpan<T> r_span) const override
+  {
+    T *dst = r_span.data();
+    this->foreach_value(mask, [&](const int64_t i, const T &value) { dst[i] = value; });
+  }
+
+  void materialize_to_uninitialized(IndexMask mask, MutableSpan<T> r_span) const override
+  {
+    T *dst = r_span.data();
+    this->foreach_value(mask, [&](const int64_t i, const T &value) { new (dst + i) T(value); });
+  }
+};
+
+template<typename T, typename IndexFn>
+static VArray<T> mesh_domain_copy_varray(const int64_t size, VArray<T> src, IndexFn index_fn)
+{
+  if (src.is_single()) {
+    return VArray<T>::ForSingle(src.get_internal_single(), size);
+  }
+  return VArray<T>::template For<VArrayImpl_For_MeshDomainCopy<T, IndexFn>>(
+      size, std::move(src), std::move(index_fn));
+}
+
 /**
  * Each corner's value is simply a copy of the value at its vertex.
  */
@@ -259,11 +316,10 @@ static GVArray adapt_mesh_domain_point_to_corner(const Mesh &mesh, const GVArray
   GVArray new_varray;
   attribute_math::convert_to_static_type(varray.type(), [&](auto dummy) {
     using T = decltype(dummy);
-    new_varray = VArray<T>::ForFunc(mesh.totloop,
-                                    [&mesh, varray = varray.typed<T>()](const int64_t loop_index) {
-                                      const int vertex_index = mesh.mloop[loop_index].v;
-                                      return varray[vertex_index];
-                                    });
+    new_varray = mesh_domain_copy_varray<T>(
+        mesh.totloop, varray.typed<T>(), [&mesh](const int64_t loop_index) {
+          return int64_t(mesh.mloop[loop_index].v);
+        });
   });
   return new_varray;
 }
@@ -460,8 +516,15 @@ static GVArray adapt_mesh_domain_face_to_corner(const Mesh &mesh, const GVArray
   attribute_math::convert_to_static_type(varray.type(), [&](auto dummy) {
     using T = decltype(dummy);
     if constexpr (!std::is_void_v<attribute_math::DefaultMixer<T>>) {
+      const VArray<T> face_values = varray.typed<T>();
+      /* Finding the face of a corner requires a map of the whole mesh, which isn't worth it for
+       * accessing a few corners lazily. A single value doesn't need the topology at all though. */
+      if (face_values.is_single()) {
+        new_varray = VArray<T>::ForSingle(face_values.get_internal_single(), mesh.totloop);
+        return;
+      }
       Array<T> values(mesh.totloop);
-      adapt_mesh_domain_face_to_corner_impl<T>(mesh, varray.typed<T>(), values);
+      adapt_mesh_domain_face_to_corner_impl<T>(mesh, face_values, values);
       new_varray = VArray<T>::ForContainer(std::move(values));
     }
   });
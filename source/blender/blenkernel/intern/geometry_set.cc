@@ -527,32 +527,76 @@ blender::Vector<GeometryComponentType> GeometrySet::gather_component_types(
   return types;
 }
 
+/**
+ * Identifies a geometry set by the components it references. Geometry sets that reference the
+ * same components contain the same data, even if they are referenced by different instances.
+ */
+struct GeometrySetComponentsKey {
+  Vector<const GeometryComponent *, GEO_COMPONENT_TYPE_ENUM_SIZE> components;
+
+  uint64_t hash() const
+  {
+    uint64_t hash = 0;
+    for (const GeometryComponent *component : this->components) {
+      hash = blender::get_default_hash_2(hash, component);
+    }
+    return hash;
+  }
+
+  friend bool operator==(const GeometrySetComponentsKey &a, const GeometrySetComponentsKey &b)
+  {
+    return a.components.as_span() == b.components.as_span();
+  }
+};
+
+struct GatherMutableGeometrySetsInfo {
+  /** Geometry sets that are modified, each with unique data. */
+  Vector<GeometrySet *> geometry_sets;
+  /** The first geometry set that has been found for some data. */
+  Map<GeometrySetComponentsKey, GeometrySet *> geometry_set_by_key;
+  /** Geometry sets whose data is the same as that of another geometry set in #geometry_sets. They
+   * are not modified separately but are replaced with the modified geometry set in the end. */
+  Vector<std::pair<GeometrySet *, GeometrySet *>> duplicates;
+};
+
 static void gather_mutable_geometry_sets(GeometrySet &geometry_set,
-                                         Vector<GeometrySet *> &r_geometry_sets)
-{
-  r_geometry_sets.append(&geometry_set);
+                                         GatherMutableGeometrySetsInfo &info)
+{
+  /* The key has to be built before anything is modified, because getting write access to a
+   * component can create a copy of it. */
+  GeometrySetComponentsKey key{geometry_set.get_components_for_read()};
+  GeometrySet *&original = info.geometry_set_by_key.lookup_or_add(std::move(key), &geometry_set);
+  if (original != &geometry_set) {
+    /* The same data is referenced by different instances components. Only modify it once,
+     * otherwise every copy would make its own copy of the data. */
+    info.duplicates.append({&geometry_set, original});
+    return;
+  }
+  info.geometry_sets.append(&geometry_set);
   if (!geometry_set.has_instances()) {
     return;
   }
-  /* In the future this can be improved by deduplicating instance references across different
-   * instances. */
   InstancesComponent &instances_component =
       geometry_set.get_component_for_write<InstancesComponent>();
   instances_component.ensure_geometry_instances();
   for (const int handle : instances_component.references().index_range()) {
     if (instances_component.references()[handle].type() == InstanceReference::Type::GeometrySet) {
       GeometrySet &instance_geometry = instances_component.geometry_set_from_reference(handle);
-      gather_mutable_geometry_sets(instance_geometry, r_geometry_sets);
+      gather_mutable_geometry_sets(instance_geometry, info);
     }
   }
 }
 
 void GeometrySet::modify_geometry_sets(ForeachSubGeometryCallback callback)
 {
-  Vector<GeometrySet *> geometry_sets;
-  gather_mutable_geometry_sets(*this, geometry_sets);
+  GatherMutableGeometrySetsInfo info;
+  gather_mutable_geometry_sets(*this, info);
   blender::threading::parallel_for_each(
-      geometry_sets, [&](GeometrySet *geometry_set) { callback(*geometry_set); });
+      info.geometry_sets, [&](GeometrySet *geometry_set) { callback(*geometry_set); });
+  /* Share the modified data with all other places that referenced the same data before. */
+  for (const std::pair<GeometrySet *, GeometrySet *> &item : info.duplicates) {
+    *item.first = *item.second;
+  }
 }
 
 /** \} */
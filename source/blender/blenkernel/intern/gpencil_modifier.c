@@ -796,7 +796,9 @@ void BKE_gpencil_modifiers_calc(Depsgraph *depsgraph, Scene *scene, Object *ob)
           }
 
           if (mti->deformStroke) {
+            int stroke_index = 0;
             LISTBASE_FOREACH (bGPDstroke *, gps, &gpf->strokes) {
+              gps->runtime.stroke_index = stroke_index++;
               mti->deformStroke(md, depsgraph, ob, gpl, gpf, gps);
             }
           }
@@ -4590,6 +4590,7 @@ static ImBuf *image_acquire_ibuf(Image *ima, ImageUser *iuser, void **r_lock)
   }
 
   if (ibuf == nullptr) {
+    MEM_CategoryScope mem_category_scope(MEM_CATEGORY_IMAGE);
     /* We are sure we have to load the ibuf, using source and type. */
     if (ima->source == IMA_SRC_MOVIE) {
       /* Source is from single file, use flip-book to store ibuf. */
@@ -5,6 +5,8 @@
  * \ingroup bke
  */
 
+#include <algorithm>
+
 #include "MEM_guardedalloc.h"
 
 #include "BLI_bitmap.h"
@@ -12,6 +14,7 @@
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
 
 #include "DNA_image_types.h"
 #include "DNA_userdef_types.h"
@@ -618,11 +621,76 @@ void BKE_image_free_anim_gputextures(Main *bmain)
   }
 }
 
+static size_t image_gpu_memory_size(const Image *ima)
+{
+  size_t size = 0;
+  for (int eye = 0; eye < 2; eye++) {
+    for (int i = 0; i < TEXTARGET_COUNT; i++) {
+      for (int resolution = 0; resolution < IMA_TEXTURE_RESOLUTION_LEN; resolution++) {
+        if (ima->gputexture[i][eye][resolution] != nullptr) {
+          size += GPU_texture_memory_size(ima->gputexture[i][eye][resolution]);
+        }
+      }
+    }
+  }
+  return size;
+}
+
+/**
+ * Free the GPU textures of the least recently used images until the textures fit in the memory
+ * limit from the preferences.
+ */
+static void image_free_gputextures_over_limit(Main *bmain, const int ctime)
+{
+  if (U.texture_memory_limit <= 0) {
+    return;
+  }
+
+  struct ImageGPUSize {
+    Image *ima;
+    size_t size;
+  };
+  blender::Vector<ImageGPUSize> images;
+  size_t total_size = 0;
+  LISTBASE_FOREACH (Image *, ima, &bmain->images) {
+    const size_t size = image_gpu_memory_size(ima);
+    if (size > 0) {
+      images.append({ima, size});
+      total_size += size;
+    }
+  }
+
+  const size_t limit = (size_t)U.texture_memory_limit * 1024 * 1024;
+  if (total_size <= limit) {
+    return;
+  }
+
+  std::sort(images.begin(), images.end(), [](const ImageGPUSize &a, const ImageGPUSize &b) {
+    return a.ima->lastused < b.ima->lastused;
+  });
+
+  for (const ImageGPUSize &item : images) {
+    if (total_size <= limit) {
+      break;
+    }
+    /* Keep the textures used by the last redraws, they would be uploaded again right away. */
+    if ((item.ima->flag & IMA_NOCOLLECT) || ctime - item.ima->lastused < 1) {
+      continue;
+    }
+    image_free_gpu(item.ima, true);
+    total_size -= item.size;
+  }
+}
+
 void BKE_image_free_old_gputextures(Main *bmain)
 {
   static int lasttime = 0;
   int ctime = (int)PIL_check_seconds_timer();
 
+  if (!G.is_rendering) {
+    image_free_gputextures_over_limit(bmain, ctime);
+  }
+
   /*
    * Run garbage collector once for every collecting period of time
    * if textimeout is 0, that's the option to NOT run the collector
@@ -769,8 +769,32 @@ typedef struct LayerCollectionResync {
   bool is_used;
 } LayerCollectionResync;
 
+/**
+ * Whether \a child is a child collection of \a parent. \a r_child_hint is the place to start
+ * looking, which is the child after the last one found. When the children are looked up in the
+ * order of the hierarchy, this avoids a quadratic cost for collections with many children.
+ */
+static bool collection_child_find_with_hint(const Collection *parent,
+                                            const Collection *child,
+                                            CollectionChild **r_child_hint)
+{
+  CollectionChild *collection_child = *r_child_hint;
+  if (collection_child == NULL || collection_child->collection != child) {
+    collection_child = BLI_findptr(
+        &parent->children, child, offsetof(CollectionChild, collection));
+  }
+  if (collection_child != NULL) {
+    *r_child_hint = collection_child->next;
+    return true;
+  }
+  return false;
+}
+
 static LayerCollectionResync *layer_collection_resync_create_recurse(
-    LayerCollectionResync *parent_layer_resync, LayerCollection *layer, BLI_mempool *mempool)
+    LayerCollectionResync *parent_layer_resync,
+    LayerCollection *layer,
+    CollectionChild **r_parent_child_hint,
+    BLI_mempool *mempool)
 {
   LayerCollectionResync *layer_resync = BLI_mempool_calloc(mempool);
 
@@ -783,11 +807,11 @@ static LayerCollectionResync *layer_collection_resync_create_recurse(
 
   layer_resync->is_usable = (layer->collection != NULL);
   layer_resync->is_valid_as_child =
-      layer_resync->is_usable && (parent_layer_resync == NULL ||
-                                  (parent_layer_resync->is_usable &&
-                                   BLI_findptr(&parent_layer_resync->layer->collection->children,
-                                               layer->collection,
-                                               offsetof(CollectionChild, collection)) != NULL));
+      layer_resync->is_usable &&
+      (parent_layer_resync == NULL ||
+       (parent_layer_resync->is_usable &&
+        collection_child_find_with_hint(
+            parent_layer_resync->layer->collection, layer->collection, r_parent_child_hint)));
   if (layer_resync->is_valid_as_child) {
     layer_resync->is_used = parent_layer_resync != NULL ? parent_layer_resync->is_used : true;
   }
@@ -799,9 +823,11 @@ static LayerCollectionResync *layer_collection_resync_create_recurse(
     layer_resync->is_valid_as_parent = layer_resync->is_usable;
   }
   else {
+    CollectionChild *child_hint = layer_resync->is_usable ? layer->collection->children.first :
+                                                            NULL;
     LISTBASE_FOREACH (LayerCollection *, child_layer, &layer->layer_collections) {
       LayerCollectionResync *child_layer_resync = layer_collection_resync_create_recurse(
-          layer_resync, child_layer, mempool);
+          layer_resync, child_layer, &child_hint, mempool);
       if (layer_resync->is_usable && child_layer_resync->is_valid_as_child) {
         layer_resync->is_valid_as_parent = true;
       }
@@ -1018,10 +1044,24 @@ static void layer_collection_sync(ViewLayer *view_layer,
 
   BLI_assert(layer_resync->is_used);
 
+  /* While the old children layers match the children collections in order, the next old child
+   * layer is the one #layer_collection_resync_find would find, since collections are only once in
+   * the children of a collection. That avoids searching the old hierarchy for every child in the
+   * common case of an unchanged hierarchy. */
+  LayerCollectionResync *next_child_layer_resync = layer_resync->children_layer_resync.first;
+
   LISTBASE_FOREACH (CollectionChild *, child, &layer_resync->collection->children) {
     Collection *child_collection = child->collection;
-    LayerCollectionResync *child_layer_resync = layer_collection_resync_find(layer_resync,
-                                                                             child_collection);
+    LayerCollectionResync *child_layer_resync;
+    if (next_child_layer_resync != NULL &&
+        next_child_layer_resync->collection == child_collection) {
+      child_layer_resync = next_child_layer_resync;
+      next_child_layer_resync = next_child_layer_resync->next;
+    }
+    else {
+      child_layer_resync = layer_collection_resync_find(layer_resync, child_collection);
+      next_child_layer_resync = NULL;
+    }
 
     if (child_layer_resync != NULL) {
       BLI_assert(child_layer_resync->collection != NULL);
@@ -1249,7 +1289,7 @@ void BKE_layer_collection_sync(const Scene *scene, ViewLayer *view_layer)
   BLI_mempool *layer_resync_mempool = BLI_mempool_create(
       sizeof(LayerCollectionResync), 1024, 1024, BLI_MEMPOOL_NOP);
   LayerCollectionResync *master_layer_resync = layer_collection_resync_create_recurse(
-      NULL, view_layer->layer_collections.first, layer_resync_mempool);
+      NULL, view_layer->layer_collections.first, NULL, layer_resync_mempool);
 
   /* Generate new layer connections and object bases when collections changed. */
   ListBase new_object_bases = {.first = NULL, .last = NULL};
@@ -31,6 +31,7 @@
 
 #include "BLI_alloca.h"
 #include "BLI_blenlib.h"
+#include "BLI_flathash.h"
 #include "BLI_ghash.h"
 #include "BLI_linklist.h"
 #include "BLI_memarena.h"
@@ -1787,7 +1788,7 @@ static void library_make_local_copying_check(ID *id,
     return; /* Already checked, nothing else to do. */
   }
 
-  MainIDRelationsEntry *entry = BLI_ghash_lookup(id_relations->relations_from_pointers, id);
+  MainIDRelationsEntry *entry = BLI_flathash_lookup(id_relations->relations_from_pointers, id);
   BLI_gset_insert(loop_tags, id);
   for (MainIDRelationsEntryItem *from_id_entry = entry->from_ids; from_id_entry != NULL;
        from_id_entry = from_id_entry->next) {
@@ -218,7 +218,15 @@ static size_t id_delete(Main *bmain, const bool do_tagged_deletion)
      * This gives tremendous speed-up when deleting a large amount of IDs from a Main
      * containing thousands of those.
      * This also means that we have to be very careful here, as we by-pass many 'common'
-     * processing, hence risking to 'corrupt' at least user counts, if not IDs themselves. */
+     * processing, hence risking to 'corrupt' at least user counts, if not IDs themselves.
+     *
+     * Users of all IDs are gathered once, so that only the actual users of the deleted IDs have
+     * to be checked when remapping, instead of all IDs of the Main database. */
+    const bool use_relations = (bmain->relations == NULL);
+    if (use_relations) {
+      BKE_main_relations_create(bmain, 0);
+    }
+    struct IDRemapper *remapper = BKE_id_remapper_create();
     bool keep_looping = true;
     while (keep_looping) {
       ID *id, *id_next;
@@ -249,24 +257,32 @@ static size_t id_delete(Main *bmain, const bool do_tagged_deletion)
         dummy_link.next = tagged_deleted_ids.first;
         last_remapped_id = (ID *)(&dummy_link);
       }
+      BKE_id_remapper_clear(remapper);
+      for (id = last_remapped_id->next; id; id = id->next) {
+        BKE_id_remapper_add(remapper, id, NULL);
+      }
+      /* Will tag 'never NULL' users of these IDs too.
+       *
+       * NOTE: #BKE_libblock_unlink() cannot be used here, since it would ignore indirect
+       * links, this can lead to nasty crashing here in second, actual deleting loop.
+       * Also, this will also flag users of deleted data that cannot be unlinked
+       * (object using deleted obdata, etc.), so that they also get deleted. */
+      BKE_libblock_remap_multiple_locked(bmain,
+                                         remapper,
+                                         (ID_REMAP_FLAG_NEVER_NULL_USAGE |
+                                          ID_REMAP_FORCE_NEVER_NULL_USAGE |
+                                          ID_REMAP_FORCE_INTERNAL_RUNTIME_POINTERS |
+                                          (use_relations ? ID_REMAP_USE_MAIN_RELATIONS : 0)));
       for (id = last_remapped_id->next; id; id = id->next) {
-        /* Will tag 'never NULL' users of this ID too.
-         *
-         * NOTE: #BKE_libblock_unlink() cannot be used here, since it would ignore indirect
-         * links, this can lead to nasty crashing here in second, actual deleting loop.
-         * Also, this will also flag users of deleted data that cannot be unlinked
-         * (object using deleted obdata, etc.), so that they also get deleted. */
-        BKE_libblock_remap_locked(bmain,
-                                  id,
-                                  NULL,
-                                  (ID_REMAP_FLAG_NEVER_NULL_USAGE |
-                                   ID_REMAP_FORCE_NEVER_NULL_USAGE |
-                                   ID_REMAP_FORCE_INTERNAL_RUNTIME_POINTERS));
         /* Since we removed ID from Main,
          * we also need to unlink its own other IDs usages ourself. */
         BKE_libblock_relink_ex(bmain, id, NULL, NULL, ID_REMAP_FORCE_INTERNAL_RUNTIME_POINTERS);
       }
     }
+    BKE_id_remapper_free(remapper);
+    if (use_relations) {
+      BKE_main_relations_free(bmain);
+    }
 
     /* Now we can safely mark that ID as not being in Main database anymore. */
     /* NOTE: This needs to be done in a separate loop than above, otherwise some usercounts of
@@ -38,10 +38,12 @@
 
 #include "BLO_readfile.h"
 
+#include "BLI_flathash.h"
 #include "BLI_ghash.h"
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
 #include "BLI_memarena.h"
+#include "BLI_stack.h"
 #include "BLI_string.h"
 #include "BLI_task.h"
 #include "BLI_utildefines.h"
@@ -510,6 +512,10 @@ typedef struct LibOverrideGroupTagData {
    * Avoids calling #BKE_collection_object_find over and over, this function is very expansive. */
   GHash *linked_object_to_instantiating_collections;
   MemArena *mem_arena;
+
+  /* All relations entries tagged as processed, see #lib_override_group_tag_data_processed_clear.
+   * Shared by all recursive calls. */
+  BLI_Stack *processed_entries;
 } LibOverrideGroupTagData;
 
 static void lib_override_group_tag_data_object_to_collection_init_collection_process(
@@ -540,6 +546,7 @@ static void lib_override_group_tag_data_object_to_collection_init_collection_pro
 static void lib_override_group_tag_data_object_to_collection_init(LibOverrideGroupTagData *data)
 {
   data->mem_arena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
+  data->processed_entries = BLI_stack_new(sizeof(MainIDRelationsEntry *), __func__);
 
   data->linked_object_to_instantiating_collections = BLI_ghash_new(
       BLI_ghashutil_ptrhash, BLI_ghashutil_ptrcmp, __func__);
@@ -556,9 +563,31 @@ static void lib_override_group_tag_data_clear(LibOverrideGroupTagData *data)
 {
   BLI_ghash_free(data->linked_object_to_instantiating_collections, NULL, NULL);
   BLI_memarena_free(data->mem_arena);
+  BLI_stack_free(data->processed_entries);
   memset(data, 0, sizeof(*data));
 }
 
+/* Tag given relations entry as processed, keeping track of it. */
+static void lib_override_group_tag_data_entry_processed_tag(LibOverrideGroupTagData *data,
+                                                            MainIDRelationsEntry *entry)
+{
+  entry->tags |= MAINIDRELATIONS_ENTRY_TAGS_PROCESSED;
+  BLI_stack_push(data->processed_entries, &entry);
+}
+
+/* Clear the processed tag of all relations entries processed since last call.
+ *
+ * Much cheaper than #BKE_main_relations_tag_set when processing many small hierarchies in a big
+ * Main, since only the entries of the processed hierarchies are affected. */
+static void lib_override_group_tag_data_processed_clear(LibOverrideGroupTagData *data)
+{
+  while (!BLI_stack_is_empty(data->processed_entries)) {
+    MainIDRelationsEntry *entry;
+    BLI_stack_pop(data->processed_entries, &entry);
+    entry->tags &= ~MAINIDRELATIONS_ENTRY_TAGS_PROCESSED;
+  }
+}
+
 /* Tag all IDs in dependency relationships within an override hierarchy/group.
  *
  * Requires existing `Main.relations`.
@@ -571,7 +600,7 @@ static bool lib_override_hierarchy_dependencies_recursive_tag(LibOverrideGroupTa
   ID *id = data->id_root;
   const bool is_override = data->is_override;
 
-  MainIDRelationsEntry *entry = BLI_ghash_lookup(bmain->relations->relations_from_pointers, id);
+  MainIDRelationsEntry *entry = BLI_flathash_lookup(bmain->relations->relations_from_pointers, id);
   BLI_assert(entry != NULL);
 
   if (entry->tags & MAINIDRELATIONS_ENTRY_TAGS_PROCESSED) {
@@ -580,7 +609,7 @@ static bool lib_override_hierarchy_dependencies_recursive_tag(LibOverrideGroupTa
   }
   /* This way we won't process again that ID, should we encounter it again through another
    * relationship hierarchy. */
-  entry->tags |= MAINIDRELATIONS_ENTRY_TAGS_PROCESSED;
+  lib_override_group_tag_data_entry_processed_tag(data, entry);
 
   for (MainIDRelationsEntryItem *to_id_entry = entry->to_ids; to_id_entry != NULL;
        to_id_entry = to_id_entry->next) {
@@ -616,8 +645,8 @@ static void lib_override_linked_group_tag_recursive(LibOverrideGroupTagData *dat
   const uint tag = data->tag;
   const uint missing_tag = data->missing_tag;
 
-  MainIDRelationsEntry *entry = BLI_ghash_lookup(bmain->relations->relations_from_pointers,
-                                                 id_owner);
+  MainIDRelationsEntry *entry = BLI_flathash_lookup(bmain->relations->relations_from_pointers,
+                                                    id_owner);
   BLI_assert(entry != NULL);
 
   if (entry->tags & MAINIDRELATIONS_ENTRY_TAGS_PROCESSED) {
@@ -626,7 +655,7 @@ static void lib_override_linked_group_tag_recursive(LibOverrideGroupTagData *dat
   }
   /* This way we won't process again that ID, should we encounter it again through another
    * relationship hierarchy. */
-  entry->tags |= MAINIDRELATIONS_ENTRY_TAGS_PROCESSED;
+  lib_override_group_tag_data_entry_processed_tag(data, entry);
 
   for (MainIDRelationsEntryItem *to_id_entry = entry->to_ids; to_id_entry != NULL;
        to_id_entry = to_id_entry->next) {
@@ -835,8 +864,8 @@ static void lib_override_overrides_group_tag_recursive(LibOverrideGroupTagData *
   const uint tag = data->tag;
   const uint missing_tag = data->missing_tag;
 
-  MainIDRelationsEntry *entry = BLI_ghash_lookup(bmain->relations->relations_from_pointers,
-                                                 id_owner);
+  MainIDRelationsEntry *entry = BLI_flathash_lookup(bmain->relations->relations_from_pointers,
+                                                    id_owner);
   BLI_assert(entry != NULL);
 
   if (entry->tags & MAINIDRELATIONS_ENTRY_TAGS_PROCESSED) {
@@ -845,7 +874,7 @@ static void lib_override_overrides_group_tag_recursive(LibOverrideGroupTagData *
   }
   /* This way we won't process again that ID, should we encounter it again through another
    * relationship hierarchy. */
-  entry->tags |= MAINIDRELATIONS_ENTRY_TAGS_PROCESSED;
+  lib_override_group_tag_data_entry_processed_tag(data, entry);
 
   for (MainIDRelationsEntryItem *to_id_entry = entry->to_ids; to_id_entry != NULL;
        to_id_entry = to_id_entry->next) {
@@ -929,7 +958,7 @@ static bool lib_override_library_create_do(Main *bmain,
   lib_override_group_tag_data_object_to_collection_init(&data);
   lib_override_linked_group_tag(&data);
 
-  BKE_main_relations_tag_set(bmain, MAINIDRELATIONS_ENTRY_TAGS_PROCESSED, false);
+  lib_override_group_tag_data_processed_clear(&data);
   lib_override_hierarchy_dependencies_recursive_tag(&data);
 
   BKE_main_relations_free(bmain);
@@ -1152,7 +1181,7 @@ static ID *lib_override_root_find(Main *bmain, ID *id, const int curr_level, int
     return NULL;
   }
 
-  MainIDRelationsEntry *entry = BLI_ghash_lookup(bmain->relations->relations_from_pointers, id);
+  MainIDRelationsEntry *entry = BLI_flathash_lookup(bmain->relations->relations_from_pointers, id);
   BLI_assert(entry != NULL);
 
   if (entry->tags & MAINIDRELATIONS_ENTRY_TAGS_PROCESSED) {
@@ -1247,8 +1276,8 @@ static void lib_override_root_hierarchy_set(Main *bmain, ID *id_root, ID *id, ID
       }
 
       ID *id_from_ref = id_from->override_library->reference;
-      MainIDRelationsEntry *entry = BLI_ghash_lookup(bmain->relations->relations_from_pointers,
-                                                     id->override_library->reference);
+      MainIDRelationsEntry *entry = BLI_flathash_lookup(bmain->relations->relations_from_pointers,
+                                                        id->override_library->reference);
       BLI_assert(entry != NULL);
 
       bool do_replace_root = false;
@@ -1289,7 +1318,7 @@ static void lib_override_root_hierarchy_set(Main *bmain, ID *id_root, ID *id, ID
     id->override_library->hierarchy_root = id_root;
   }
 
-  MainIDRelationsEntry *entry = BLI_ghash_lookup(bmain->relations->relations_from_pointers, id);
+  MainIDRelationsEntry *entry = BLI_flathash_lookup(bmain->relations->relations_from_pointers, id);
   BLI_assert(entry != NULL);
 
   for (MainIDRelationsEntryItem *to_id_entry = entry->to_ids; to_id_entry != NULL;
@@ -1471,18 +1500,18 @@ static bool lib_override_library_resync(Main *bmain,
     }
 
     /* Tag local overrides of the current resync sub-hierarchy. */
-    BKE_main_relations_tag_set(bmain, MAINIDRELATIONS_ENTRY_TAGS_PROCESSED, false);
+    lib_override_group_tag_data_processed_clear(&data);
     data.id_root = id_resync_root;
     data.is_override = true;
     lib_override_overrides_group_tag(&data);
 
     /* Tag reference data matching the current resync sub-hierarchy. */
-    BKE_main_relations_tag_set(bmain, MAINIDRELATIONS_ENTRY_TAGS_PROCESSED, false);
+    lib_override_group_tag_data_processed_clear(&data);
     data.id_root = id_resync_root->override_library->reference;
     data.is_override = false;
     lib_override_linked_group_tag(&data);
 
-    BKE_main_relations_tag_set(bmain, MAINIDRELATIONS_ENTRY_TAGS_PROCESSED, false);
+    lib_override_group_tag_data_processed_clear(&data);
     lib_override_hierarchy_dependencies_recursive_tag(&data);
 
     FOREACH_MAIN_ID_BEGIN (bmain, id) {
@@ -1557,12 +1586,12 @@ static bool lib_override_library_resync(Main *bmain,
     FOREACH_MAIN_ID_END;
 
     /* Code above may have added some tags, we need to update this too. */
-    BKE_main_relations_tag_set(bmain, MAINIDRELATIONS_ENTRY_TAGS_PROCESSED, false);
+    lib_override_group_tag_data_processed_clear(&data);
     lib_override_hierarchy_dependencies_recursive_tag(&data);
   }
 
   /* Tag all local overrides of the current hierarchy. */
-  BKE_main_relations_tag_set(bmain, MAINIDRELATIONS_ENTRY_TAGS_PROCESSED, false);
+  lib_override_group_tag_data_processed_clear(&data);
   data.id_root = id_root;
   data.is_override = true;
   lib_override_overrides_group_tag(&data);
@@ -1903,7 +1932,7 @@ static bool lib_override_resync_tagging_finalize_recurse(
     return false;
   }
 
-  MainIDRelationsEntry *entry = BLI_ghash_lookup(bmain->relations->relations_from_pointers, id);
+  MainIDRelationsEntry *entry = BLI_flathash_lookup(bmain->relations->relations_from_pointers, id);
   BLI_assert(entry != NULL);
 
   if (entry->tags & MAINIDRELATIONS_ENTRY_TAGS_PROCESSED) {
@@ -2057,9 +2086,9 @@ static void lib_override_library_main_resync_on_library_indirect_level(
 
     data.id_root = id->override_library->reference;
     lib_override_linked_group_tag(&data);
-    BKE_main_relations_tag_set(bmain, MAINIDRELATIONS_ENTRY_TAGS_PROCESSED, false);
+    lib_override_group_tag_data_processed_clear(&data);
     lib_override_hierarchy_dependencies_recursive_tag(&data);
-    BKE_main_relations_tag_set(bmain, MAINIDRELATIONS_ENTRY_TAGS_PROCESSED, false);
+    lib_override_group_tag_data_processed_clear(&data);
   }
   FOREACH_MAIN_ID_END;
   lib_override_group_tag_data_clear(&data);
@@ -2091,7 +2120,8 @@ static void lib_override_library_main_resync_on_library_indirect_level(
       continue;
     }
 
-    MainIDRelationsEntry *entry = BLI_ghash_lookup(bmain->relations->relations_from_pointers, id);
+    MainIDRelationsEntry *entry = BLI_flathash_lookup(bmain->relations->relations_from_pointers,
+                                                      id);
     BLI_assert(entry != NULL);
 
     for (MainIDRelationsEntryItem *entry_item = entry->to_ids; entry_item != NULL;
@@ -3102,7 +3132,7 @@ static void lib_override_library_id_hierarchy_recursive_reset(Main *bmain, ID *i
     return;
   }
 
-  void **entry_vp = BLI_ghash_lookup_p(bmain->relations->relations_from_pointers, id_root);
+  void **entry_vp = BLI_flathash_lookup_p(bmain->relations->relations_from_pointers, id_root);
   if (entry_vp == NULL) {
     /* This ID is not used by nor using any other ID. */
     lib_override_library_id_reset_do(bmain, id_root);
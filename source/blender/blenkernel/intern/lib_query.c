@@ -9,6 +9,7 @@
 
 #include "DNA_anim_types.h"
 
+#include "BLI_flathash.h"
 #include "BLI_ghash.h"
 #include "BLI_linklist_stack.h"
 #include "BLI_listbase.h"
@@ -56,7 +57,7 @@ typedef struct LibraryForeachIDData {
   int status;
 
   /* To handle recursion. */
-  GSet *ids_handled; /* All IDs that are either already done, or still in ids_todo stack. */
+  FlatHash *ids_handled; /* All IDs that are either already done, or still in ids_todo stack. */
   BLI_LINKSTACK_DECLARE(ids_todo, ID *);
 } LibraryForeachIDData;
 
@@ -95,7 +96,7 @@ void BKE_lib_query_foreachid_process(LibraryForeachIDData *data, ID **id_pp, int
     BLI_assert(*(id_pp) == old_id);
   }
   if (old_id && (flag & IDWALK_RECURSE)) {
-    if (BLI_gset_add((data)->ids_handled, old_id)) {
+    if (BLI_flathash_add((data)->ids_handled, old_id)) {
       if (!(callback_return & IDWALK_RET_STOP_RECURSION)) {
         BLI_LINKSTACK_PUSH(data->ids_todo, old_id);
       }
@@ -168,7 +169,7 @@ void BKE_library_foreach_ID_embedded(LibraryForeachIDData *data, ID **id_pp)
      * IDWALK_RECURSE case is troublesome, see T49553. */
     /* XXX note that this breaks the 'owner id' thing now, we likely want to handle that
      * differently at some point, but for now it should not be a problem in practice. */
-    if (BLI_gset_add(data->ids_handled, id)) {
+    if (BLI_flathash_add(data->ids_handled, id)) {
       BLI_LINKSTACK_PUSH(data->ids_todo, id);
     }
   }
@@ -184,7 +185,7 @@ void BKE_library_foreach_ID_embedded(LibraryForeachIDData *data, ID **id_pp)
 static void library_foreach_ID_data_cleanup(LibraryForeachIDData *data)
 {
   if (data->ids_handled != NULL) {
-    BLI_gset_free(data->ids_handled, NULL);
+    BLI_flathash_free(data->ids_handled, NULL, NULL);
     BLI_LINKSTACK_FREE(data->ids_todo);
   }
 }
@@ -211,10 +212,10 @@ static bool library_foreach_ID_link(Main *bmain,
      * see also comments in #BKE_library_foreach_ID_embedded.
      * This is why we can always create this data here, and do not need to try and re-use it from
      * `inherit_data`. */
-    data.ids_handled = BLI_gset_new(BLI_ghashutil_ptrhash, BLI_ghashutil_ptrcmp, __func__);
+    data.ids_handled = BLI_flathash_ptr_new(__func__);
     BLI_LINKSTACK_INIT(data.ids_todo);
 
-    BLI_gset_add(data.ids_handled, id);
+    BLI_flathash_add(data.ids_handled, id);
   }
   else {
     data.ids_handled = NULL;
@@ -280,8 +281,8 @@ static bool library_foreach_ID_link(Main *bmain,
        * but we might as well use it (Main->relations is always assumed valid,
        * it's responsibility of code creating it to free it,
        * especially if/when it starts modifying Main database). */
-      MainIDRelationsEntry *entry = BLI_ghash_lookup(bmain->relations->relations_from_pointers,
-                                                     id);
+      MainIDRelationsEntry *entry = BLI_flathash_lookup(bmain->relations->relations_from_pointers,
+                                                        id);
       for (MainIDRelationsEntryItem *to_id_entry = entry->to_ids; to_id_entry != NULL;
            to_id_entry = to_id_entry->next) {
         BKE_lib_query_foreachid_process(
@@ -660,8 +661,8 @@ static void lib_query_unused_ids_tag_recurse(Main *bmain,
     return;
   }
 
-  MainIDRelationsEntry *id_relations = BLI_ghash_lookup(bmain->relations->relations_from_pointers,
-                                                        id);
+  MainIDRelationsEntry *id_relations = BLI_flathash_lookup(
+      bmain->relations->relations_from_pointers, id);
   if ((id_relations->tags & MAINIDRELATIONS_ENTRY_TAGS_PROCESSED) != 0) {
     return;
   }
@@ -8,6 +8,7 @@
 
 #include "CLG_log.h"
 
+#include "BLI_flathash.h"
 #include "BLI_linklist.h"
 #include "BLI_utildefines.h"
 
@@ -120,6 +121,11 @@ static void foreach_libblock_remap_callback_apply(ID *id_owner,
    * pointer otherwise the incorrect users are decreased and increased on the same instance. */
   ID *new_id = violates_never_null ? NULL : *id_ptr;
 
+  if (new_id != NULL && (id_remap_data->flag & ID_REMAP_USE_MAIN_RELATIONS) != 0) {
+    /* Keep the users of new_id valid for the next remappings using the same relations. */
+    BKE_main_relations_from_id_add(id_remap_data->bmain, new_id, id_self, cb_flag);
+  }
+
   if (cb_flag & IDWALK_CB_USER) {
     /* NOTE: by default we don't user-count IDs which are not in the main database.
      * This is because in certain conditions we can have data-blocks in
@@ -429,6 +435,97 @@ static void libblock_remap_reset_remapping_status_callback(ID *old_id,
   BKE_libblock_runtime_reset_remapping_status(old_id);
 }
 
+typedef struct LibblockRemapUsersData {
+  MainIDRelations *relations;
+  /** Set of the IDs using any of the remapped IDs. */
+  FlatHash *id_users;
+  /** False when some users may be missing from `id_users`. */
+  bool is_complete;
+} LibBlockRemapUsersData;
+
+static void libblock_remap_users_gather_cb(ID *old_id, ID *UNUSED(new_id), void *user_data)
+{
+  LibBlockRemapUsersData *data = user_data;
+  const MainIDRelationsEntry *entry = BLI_flathash_lookup(
+      data->relations->relations_from_pointers, old_id);
+  if (entry == NULL) {
+    data->is_complete = false;
+    return;
+  }
+
+  for (MainIDRelationsEntryItem *from_item = entry->from_ids; from_item != NULL;
+       from_item = from_item->next) {
+    ID *id_from = from_item->id_pointer.from;
+    if ((id_from->flag & LIB_EMBEDDED_DATA) == 0) {
+      BLI_flathash_add(data->id_users, id_from);
+      continue;
+    }
+    /* Embedded IDs are processed as part of their owner, which is their only user. */
+    const MainIDRelationsEntry *embedded_entry = BLI_flathash_lookup(
+        data->relations->relations_from_pointers, id_from);
+    if (embedded_entry == NULL) {
+      data->is_complete = false;
+      continue;
+    }
+    for (MainIDRelationsEntryItem *owner_item = embedded_entry->from_ids; owner_item != NULL;
+         owner_item = owner_item->next) {
+      if ((owner_item->usage_flag & IDWALK_CB_EMBEDDED) != 0) {
+        BLI_flathash_add(data->id_users, owner_item->id_pointer.from);
+      }
+    }
+  }
+}
+
+/**
+ * Gather all IDs using any of the remapped IDs from given \a relations.
+ *
+ * \return NULL when the relations do not know about all users of the remapped IDs.
+ */
+static FlatHash *libblock_remap_users_gather(MainIDRelations *relations,
+                                             const struct IDRemapper *id_remapper)
+{
+  LibBlockRemapUsersData data = {
+      .relations = relations,
+      .id_users = BLI_flathash_ptr_new(__func__),
+      .is_complete = true,
+  };
+  BKE_id_remapper_iter(id_remapper, libblock_remap_users_gather_cb, &data);
+  if (!data.is_complete) {
+    BLI_flathash_free(data.id_users, NULL, NULL);
+    return NULL;
+  }
+  return data.id_users;
+}
+
+/**
+ * Whether \a id may use any of the remapped IDs, according to the users gathered by
+ * #libblock_remap_users_gather.
+ */
+static bool libblock_remap_id_may_use_mappings(const MainIDRelations *relations,
+                                               const FlatHash *id_users,
+                                               ID *id,
+                                               const struct IDRemapper *id_remapper,
+                                               const short remap_flags)
+{
+  if (BLI_flathash_haskey(id_users, id)) {
+    return true;
+  }
+  if (!BLI_flathash_haskey(relations->relations_from_pointers, id)) {
+    /* Unknown ID, added after the relations were built. */
+    return true;
+  }
+  if ((remap_flags & ID_REMAP_FORCE_INTERNAL_RUNTIME_POINTERS) != 0) {
+    /* Runtime pointers are not part of the relations. */
+    return (BKE_id_remapper_get_mapping_result(
+                id_remapper, id->newid, ID_REMAP_APPLY_DEFAULT, NULL) !=
+                ID_REMAP_RESULT_SOURCE_UNAVAILABLE ||
+            BKE_id_remapper_get_mapping_result(
+                id_remapper, id->orig_id, ID_REMAP_APPLY_DEFAULT, NULL) !=
+                ID_REMAP_RESULT_SOURCE_UNAVAILABLE);
+  }
+  return false;
+}
+
 /**
  * Execute the 'data' part of the remapping (that is, all ID pointers from other ID data-blocks).
  *
@@ -481,10 +578,14 @@ static void libblock_remap_data(Main *bmain,
         NULL, id, foreach_libblock_remap_callback, &id_remap_data, foreach_id_flags);
   }
   else {
-    /* Note that this is a very 'brute force' approach,
-     * maybe we could use some depsgraph to only process objects actually using given old_id...
-     * sounds rather unlikely currently, though, so this will do for now. */
+    /* Note that this is a very 'brute force' approach, unless the users of the remapped IDs
+     * are known from the Main relations (see #ID_REMAP_USE_MAIN_RELATIONS). */
     ID *id_curr;
+    MainIDRelations *relations = (remap_flags & ID_REMAP_USE_MAIN_RELATIONS) != 0 ?
+                                     bmain->relations :
+                                     NULL;
+    FlatHash *id_users = relations != NULL ? libblock_remap_users_gather(relations, id_remapper) :
+                                             NULL;
 
     FOREACH_MAIN_ID_BEGIN (bmain, id_curr) {
       const uint64_t can_use_filter_id = BKE_library_id_can_use_filter_id(id_curr);
@@ -494,6 +595,10 @@ static void libblock_remap_data(Main *bmain,
       if (!has_mapping) {
         continue;
       }
+      if (id_users != NULL && !libblock_remap_id_may_use_mappings(
+                                  relations, id_users, id_curr, id_remapper, remap_flags)) {
+        continue;
+      }
 
       /* Note that we cannot skip indirect usages of old_id
        * here (if requested), we still need to check it for the
@@ -506,6 +611,10 @@ static void libblock_remap_data(Main *bmain,
           NULL, id_curr, foreach_libblock_remap_callback, &id_remap_data, foreach_id_flags);
     }
     FOREACH_MAIN_ID_END;
+
+    if (id_users != NULL) {
+      BLI_flathash_free(id_users, NULL, NULL);
+    }
   }
 
   BKE_id_remapper_iter(id_remapper, libblock_remap_data_update_tags, &id_remap_data);
@@ -12,6 +12,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_flathash.h"
 #include "BLI_ghash.h"
 #include "BLI_mempool.h"
 #include "BLI_threads.h"
@@ -209,6 +210,27 @@ void BKE_main_unlock(struct Main *bmain)
   BLI_spin_unlock((SpinLock *)bmain->lock);
 }
 
+static void main_relations_from_id_add(MainIDRelations *bmain_relations,
+                                       ID *id,
+                                       ID *id_from,
+                                       const int usage_flag)
+{
+  MainIDRelationsEntry **entry_p;
+  if (!BLI_flathash_ensure_p(bmain_relations->relations_from_pointers, id, (void ***)&entry_p)) {
+    *entry_p = MEM_callocN(sizeof(**entry_p), __func__);
+    (*entry_p)->session_uuid = id->session_uuid;
+  }
+  else {
+    BLI_assert((*entry_p)->session_uuid == id->session_uuid);
+  }
+  MainIDRelationsEntryItem *from_id_entry = BLI_mempool_alloc(bmain_relations->entry_items_pool);
+  from_id_entry->next = (*entry_p)->from_ids;
+  from_id_entry->id_pointer.from = id_from;
+  from_id_entry->session_uuid = id_from->session_uuid;
+  from_id_entry->usage_flag = usage_flag;
+  (*entry_p)->from_ids = from_id_entry;
+}
+
 static int main_relations_create_idlink_cb(LibraryIDLinkCallbackData *cb_data)
 {
   MainIDRelations *bmain_relations = cb_data->user_data;
@@ -221,7 +243,7 @@ static int main_relations_create_idlink_cb(LibraryIDLinkCallbackData *cb_data)
 
     /* Add `id_pointer` as child of `id_self`. */
     {
-      if (!BLI_ghash_ensure_p(
+      if (!BLI_flathash_ensure_p(
               bmain_relations->relations_from_pointers, id_self, (void ***)&entry_p)) {
         *entry_p = MEM_callocN(sizeof(**entry_p), __func__);
         (*entry_p)->session_uuid = id_self->session_uuid;
@@ -240,21 +262,7 @@ static int main_relations_create_idlink_cb(LibraryIDLinkCallbackData *cb_data)
 
     /* Add `id_self` as parent of `id_pointer`. */
     if (*id_pointer != NULL) {
-      if (!BLI_ghash_ensure_p(
-              bmain_relations->relations_from_pointers, *id_pointer, (void ***)&entry_p)) {
-        *entry_p = MEM_callocN(sizeof(**entry_p), __func__);
-        (*entry_p)->session_uuid = (*id_pointer)->session_uuid;
-      }
-      else {
-        BLI_assert((*entry_p)->session_uuid == (*id_pointer)->session_uuid);
-      }
-      MainIDRelationsEntryItem *from_id_entry = BLI_mempool_alloc(
-          bmain_relations->entry_items_pool);
-      from_id_entry->next = (*entry_p)->from_ids;
-      from_id_entry->id_pointer.from = id_self;
-      from_id_entry->session_uuid = id_self->session_uuid;
-      from_id_entry->usage_flag = cb_flag;
-      (*entry_p)->from_ids = from_id_entry;
+      main_relations_from_id_add(bmain_relations, *id_pointer, id_self, cb_flag);
     }
   }
 
@@ -268,8 +276,7 @@ void BKE_main_relations_create(Main *bmain, const short flag)
   }
 
   bmain->relations = MEM_mallocN(sizeof(*bmain->relations), __func__);
-  bmain->relations->relations_from_pointers = BLI_ghash_new(
-      BLI_ghashutil_ptrhash, BLI_ghashutil_ptrcmp, __func__);
+  bmain->relations->relations_from_pointers = BLI_flathash_ptr_new(__func__);
   bmain->relations->entry_items_pool = BLI_mempool_create(
       sizeof(MainIDRelationsEntryItem), 128, 128, BLI_MEMPOOL_NOP);
 
@@ -282,7 +289,8 @@ void BKE_main_relations_create(Main *bmain, const short flag)
 
     /* Ensure all IDs do have an entry, even if they are not connected to any other. */
     MainIDRelationsEntry **entry_p;
-    if (!BLI_ghash_ensure_p(bmain->relations->relations_from_pointers, id, (void ***)&entry_p)) {
+    if (!BLI_flathash_ensure_p(
+            bmain->relations->relations_from_pointers, id, (void ***)&entry_p)) {
       *entry_p = MEM_callocN(sizeof(**entry_p), __func__);
       (*entry_p)->session_uuid = id->session_uuid;
     }
@@ -300,7 +308,7 @@ void BKE_main_relations_free(Main *bmain)
 {
   if (bmain->relations != NULL) {
     if (bmain->relations->relations_from_pointers != NULL) {
-      BLI_ghash_free(bmain->relations->relations_from_pointers, NULL, MEM_freeN);
+      BLI_flathash_free(bmain->relations->relations_from_pointers, NULL, MEM_freeN);
     }
     BLI_mempool_destroy(bmain->relations->entry_items_pool);
     MEM_freeN(bmain->relations);
@@ -308,6 +316,14 @@ void BKE_main_relations_free(Main *bmain)
   }
 }
 
+void BKE_main_relations_from_id_add(Main *bmain, ID *id, ID *id_from, const int usage_flag)
+{
+  if (bmain->relations == NULL) {
+    return;
+  }
+  main_relations_from_id_add(bmain->relations, id, id_from, usage_flag);
+}
+
 void BKE_main_relations_tag_set(struct Main *bmain,
                                 const eMainIDRelationsEntryTags tag,
                                 const bool value)
@@ -316,11 +332,9 @@ void BKE_main_relations_tag_set(struct Main *bmain,
     return;
   }
 
-  GHashIterator *gh_iter;
-  for (gh_iter = BLI_ghashIterator_new(bmain->relations->relations_from_pointers);
-       !BLI_ghashIterator_done(gh_iter);
-       BLI_ghashIterator_step(gh_iter)) {
-    MainIDRelationsEntry *entry = BLI_ghashIterator_getValue(gh_iter);
+  FlatHashIterator fh_iter;
+  FLATHASH_ITER (fh_iter, bmain->relations->relations_from_pointers) {
+    MainIDRelationsEntry *entry = BLI_flathashIterator_getValue(&fh_iter);
     if (value) {
       entry->tags |= tag;
     }
@@ -328,7 +342,6 @@ void BKE_main_relations_tag_set(struct Main *bmain,
       entry->tags &= ~tag;
     }
   }
-  BLI_ghashIterator_free(gh_iter);
 }
 
 GSet *BKE_main_gset_create(Main *bmain, GSet *gset)
@@ -5,6 +5,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_flathash.h"
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
 #include "BLI_mempool.h"
@@ -30,7 +31,7 @@
  * This doesn't account for adding/removing data-blocks,
  * and should only be used when performing many lookups.
  *
- * \note GHash's are initialized on demand,
+ * \note Hashes are initialized on demand,
  * since its likely some types will never have lookups run on them,
  * so its a waste to create and never use.
  * \{ */
@@ -43,7 +44,7 @@ struct IDNameLib_Key {
 };
 
 struct IDNameLib_TypeMap {
-  GHash *map;
+  FlatHash *map;
   short id_type;
 };
 
@@ -52,12 +53,12 @@ struct IDNameLib_TypeMap {
  */
 struct IDNameLib_Map {
   struct IDNameLib_TypeMap type_maps[INDEX_ID_MAX];
-  struct GHash *uuid_map;
+  FlatHash *uuid_map;
   struct Main *bmain;
   struct GSet *valid_id_pointers;
   int idmap_types;
 
-  /* For storage of keys for the TypeMap ghash, avoids many single allocs. */
+  /* For storage of keys for the TypeMap hash, avoids many single allocs. */
   BLI_mempool *type_maps_keys_pool;
 };
 
@@ -95,11 +96,11 @@ struct IDNameLib_Map *BKE_main_idmap_create(struct Main *bmain,
 
   if (idmap_types & MAIN_IDMAP_TYPE_UUID) {
     ID *id;
-    id_map->uuid_map = BLI_ghash_int_new(__func__);
+    id_map->uuid_map = BLI_flathash_int_new(__func__);
     FOREACH_MAIN_ID_BEGIN (bmain, id) {
       BLI_assert(id->session_uuid != MAIN_ID_SESSION_UUID_UNSET);
       void **id_ptr_v;
-      const bool existing_key = BLI_ghash_ensure_p(
+      const bool existing_key = BLI_flathash_ensure_p(
           id_map->uuid_map, POINTER_FROM_UINT(id->session_uuid), &id_ptr_v);
       BLI_assert(existing_key == false);
       UNUSED_VARS_NDEBUG(existing_key);
@@ -138,7 +139,7 @@ void BKE_main_idmap_insert_id(struct IDNameLib_Map *id_map, ID *id)
       struct IDNameLib_Key *key = BLI_mempool_alloc(id_map->type_maps_keys_pool);
       key->name = id->name + 2;
       key->lib = id->lib;
-      BLI_ghash_insert(type_map->map, key, id);
+      BLI_flathash_insert(type_map->map, key, id);
     }
   }
 
@@ -146,7 +147,7 @@ void BKE_main_idmap_insert_id(struct IDNameLib_Map *id_map, ID *id)
     BLI_assert(id_map->uuid_map != NULL);
     BLI_assert(id->session_uuid != MAIN_ID_SESSION_UUID_UNSET);
     void **id_ptr_v;
-    const bool existing_key = BLI_ghash_ensure_p(
+    const bool existing_key = BLI_flathash_ensure_p(
         id_map->uuid_map, POINTER_FROM_UINT(id->session_uuid), &id_ptr_v);
     BLI_assert(existing_key == false);
     UNUSED_VARS_NDEBUG(existing_key);
@@ -165,9 +166,10 @@ void BKE_main_idmap_remove_id(struct IDNameLib_Map *id_map, ID *id)
     if (LIKELY(type_map != NULL) && type_map->map != NULL) {
       BLI_assert(id_map->type_maps_keys_pool != NULL);
 
-      /* NOTE: We cannot free the key from the MemPool here, would need new API from GHash to also
-       * retrieve key pointer. Not a big deal for now */
-      BLI_ghash_remove(type_map->map, &(struct IDNameLib_Key){id->name + 2, id->lib}, NULL, NULL);
+      /* NOTE: We cannot free the key from the MemPool here, would need new API from FlatHash to
+       * also retrieve key pointer. Not a big deal for now */
+      BLI_flathash_remove(
+          type_map->map, &(struct IDNameLib_Key){id->name + 2, id->lib}, NULL, NULL);
     }
   }
 
@@ -175,7 +177,7 @@ void BKE_main_idmap_remove_id(struct IDNameLib_Map *id_map, ID *id)
     BLI_assert(id_map->uuid_map != NULL);
     BLI_assert(id->session_uuid != MAIN_ID_SESSION_UUID_UNSET);
 
-    BLI_ghash_remove(id_map->uuid_map, POINTER_FROM_UINT(id->session_uuid), NULL, NULL);
+    BLI_flathash_remove(id_map->uuid_map, POINTER_FROM_UINT(id->session_uuid), NULL, NULL);
   }
 }
 
@@ -219,18 +221,19 @@ ID *BKE_main_idmap_lookup_name(struct IDNameLib_Map *id_map,
           sizeof(struct IDNameLib_Key), 1024, 1024, BLI_MEMPOOL_NOP);
     }
 
-    GHash *map = type_map->map = BLI_ghash_new(idkey_hash, idkey_cmp, __func__);
     ListBase *lb = which_libbase(id_map->bmain, id_type);
+    FlatHash *map = type_map->map = BLI_flathash_new_ex(
+        idkey_hash, idkey_cmp, __func__, (uint)BLI_listbase_count(lb));
     for (ID *id = lb->first; id; id = id->next) {
       struct IDNameLib_Key *key = BLI_mempool_alloc(id_map->type_maps_keys_pool);
       key->name = id->name + 2;
       key->lib = id->lib;
-      BLI_ghash_insert(map, key, id);
+      BLI_flathash_insert(map, key, id);
     }
   }
 
   const struct IDNameLib_Key key_lookup = {name, lib};
-  return BLI_ghash_lookup(type_map->map, &key_lookup);
+  return BLI_flathash_lookup(type_map->map, &key_lookup);
 }
 
 ID *BKE_main_idmap_lookup_id(struct IDNameLib_Map *id_map, const ID *id)
@@ -250,7 +253,7 @@ ID *BKE_main_idmap_lookup_id(struct IDNameLib_Map *id_map, const ID *id)
 ID *BKE_main_idmap_lookup_uuid(struct IDNameLib_Map *id_map, const uint session_uuid)
 {
   if (id_map->idmap_types & MAIN_IDMAP_TYPE_UUID) {
-    return BLI_ghash_lookup(id_map->uuid_map, POINTER_FROM_UINT(session_uuid));
+    return BLI_flathash_lookup(id_map->uuid_map, POINTER_FROM_UINT(session_uuid));
   }
   return NULL;
 }
@@ -261,7 +264,7 @@ void BKE_main_idmap_destroy(struct IDNameLib_Map *id_map)
     struct IDNameLib_TypeMap *type_map = id_map->type_maps;
     for (int i = 0; i < INDEX_ID_MAX; i++, type_map++) {
       if (type_map->map) {
-        BLI_ghash_free(type_map->map, NULL, NULL);
+        BLI_flathash_free(type_map->map, NULL, NULL);
         type_map->map = NULL;
       }
     }
@@ -271,7 +274,7 @@ void BKE_main_idmap_destroy(struct IDNameLib_Map *id_map)
     }
   }
   if (id_map->idmap_types & MAIN_IDMAP_TYPE_UUID) {
-    BLI_ghash_free(id_map->uuid_map, NULL, NULL);
+    BLI_flathash_free(id_map->uuid_map, NULL, NULL);
   }
 
   BLI_assert(id_map->type_maps_keys_pool == NULL);
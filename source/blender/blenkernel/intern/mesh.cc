@@ -30,12 +30,14 @@
 #include "BLI_memarena.h"
 #include "BLI_string.h"
 #include "BLI_task.hh"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
 
 #include "BKE_anim_data.h"
 #include "BKE_bpath.h"
+#include "BKE_bvhutils.h"
 #include "BKE_deform.h"
 #include "BKE_editmesh.h"
 #include "BKE_global.h"
@@ -136,6 +138,21 @@ static void mesh_copy_data(Main *bmain, ID *id_dst, const ID *id_src, const int
 
   BKE_mesh_update_customdata_pointers(mesh_dst, do_tessface);
 
+  if (mesh_src->runtime.bvh_cache) {
+    /* Copies often only change some of the data or nothing at all, the trees are checked against
+     * the copied data when they are used. */
+    mesh_dst->runtime.bvh_cache = bvhcache_copy_shared(mesh_src->runtime.bvh_cache, mesh_src);
+  }
+
+  if (mesh_src->runtime.looptris.array) {
+    /* The copy has the same topology, so the tessellation can be copied instead of recalculated.
+     * Like when the positions are changed in place, it is kept when a copy is only deformed.
+     * N-gons are not re-tessellated then, but their triangles still cover the same loops. */
+    mesh_dst->runtime.looptris.array = (MLoopTri *)MEM_dupallocN(mesh_src->runtime.looptris.array);
+    mesh_dst->runtime.looptris.len = mesh_src->runtime.looptris.len;
+    mesh_dst->runtime.looptris.len_alloc = mesh_src->runtime.looptris.len_alloc;
+  }
+
   mesh_dst->cd_flag = mesh_src->cd_flag;
 
   mesh_dst->edit_mesh = nullptr;
@@ -1931,7 +1948,9 @@ void BKE_mesh_anonymous_attributes_remove(Mesh *mesh)
   CustomData_free_layers_anonymous(&mesh->ldata, mesh->totloop);
 }
 
-void BKE_mesh_calc_normals_split_ex(Mesh *mesh, MLoopNorSpaceArray *r_lnors_spacearr)
+static void mesh_calc_normals_split(Mesh *mesh,
+                                    MLoopNorSpaceArray *r_lnors_spacearr,
+                                    LoopSplitFanCache **r_fan_cache)
 {
   float(*r_loopnors)[3];
   short(*clnors)[2] = nullptr;
@@ -1956,31 +1975,69 @@ void BKE_mesh_calc_normals_split_ex(Mesh *mesh, MLoopNorSpaceArray *r_lnors_spac
   /* may be nullptr */
   clnors = (short(*)[2])CustomData_get_layer(&mesh->ldata, CD_CUSTOMLOOPNORMAL);
 
-  BKE_mesh_normals_loop_split(mesh->mvert,
-                              BKE_mesh_vertex_normals_ensure(mesh),
-                              mesh->totvert,
-                              mesh->medge,
-                              mesh->totedge,
-                              mesh->mloop,
-                              r_loopnors,
-                              mesh->totloop,
-                              mesh->mpoly,
-                              BKE_mesh_poly_normals_ensure(mesh),
-                              mesh->totpoly,
-                              use_split_normals,
-                              split_angle,
-                              r_lnors_spacearr,
-                              clnors,
-                              nullptr);
+  BKE_mesh_normals_loop_split_ex(mesh->mvert,
+                                 BKE_mesh_vertex_normals_ensure(mesh),
+                                 mesh->totvert,
+                                 mesh->medge,
+                                 mesh->totedge,
+                                 mesh->mloop,
+                                 r_loopnors,
+                                 mesh->totloop,
+                                 mesh->mpoly,
+                                 BKE_mesh_poly_normals_ensure(mesh),
+                                 mesh->totpoly,
+                                 use_split_normals,
+                                 split_angle,
+                                 r_lnors_spacearr,
+                                 clnors,
+                                 nullptr,
+                                 r_fan_cache);
 
   BKE_mesh_assert_normals_dirty_or_calculated(mesh);
 }
 
+void BKE_mesh_calc_normals_split_ex(Mesh *mesh, MLoopNorSpaceArray *r_lnors_spacearr)
+{
+  mesh_calc_normals_split(mesh, r_lnors_spacearr, nullptr);
+}
+
 void BKE_mesh_calc_normals_split(Mesh *mesh)
 {
   BKE_mesh_calc_normals_split_ex(mesh, nullptr);
 }
 
+void BKE_mesh_calc_normals_split_cached(Mesh *mesh, const Mesh *mesh_cache)
+{
+  if (mesh->medge != mesh_cache->medge || mesh->mloop != mesh_cache->mloop ||
+      mesh->mpoly != mesh_cache->mpoly) {
+    BKE_mesh_calc_normals_split(mesh);
+    return;
+  }
+
+  /* The cache is taken out of the runtime data while in use, so several meshes sharing the same
+   * topology can be evaluated at the same time, only one of them gets the cache though. */
+  Mesh_Runtime *runtime = (Mesh_Runtime *)&mesh_cache->runtime;
+  ThreadMutex *mutex = (ThreadMutex *)runtime->topology_mutex;
+
+  BLI_mutex_lock(mutex);
+  LoopSplitFanCache *fan_cache = runtime->loop_split_fans;
+  runtime->loop_split_fans = nullptr;
+  BLI_mutex_unlock(mutex);
+
+  mesh_calc_normals_split(mesh, nullptr, &fan_cache);
+
+  BLI_mutex_lock(mutex);
+  if (runtime->loop_split_fans == nullptr) {
+    runtime->loop_split_fans = fan_cache;
+    fan_cache = nullptr;
+  }
+  BLI_mutex_unlock(mutex);
+
+  if (fan_cache) {
+    BKE_mesh_loop_split_fan_cache_free(fan_cache);
+  }
+}
+
 /* Split faces helper functions. */
 
 struct SplitFaceNewVert {
@@ -29,6 +29,7 @@
 #include "BLI_task.h"
 #include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_customdata.h"
 #include "BKE_editmesh_cache.h"
@@ -37,7 +38,9 @@
 
 #include "atomic_ops.h"
 
+using blender::IndexRange;
 using blender::Span;
+using blender::Vector;
 
 // #define DEBUG_TIME
 
@@ -207,6 +210,7 @@ void BKE_mesh_calc_normals_poly(const MVert *mvert,
   data.mvert = mvert;
   data.pnors = r_poly_normals;
 
+  settings.name = "mesh_calc_normals_poly";
   BLI_task_parallel_range(0, mpoly_len, &data, mesh_calc_normals_poly_fn, &settings);
 }
 
@@ -329,10 +333,12 @@ static void mesh_calc_normals_poly_and_vertex(const MVert *mvert,
   data.vnors = r_vert_normals;
 
   /* Compute poly normals, accumulating them into vertex normals. */
+  settings.name = "mesh_calc_normals_poly_and_vertex_accum";
   BLI_task_parallel_range(
       0, mpoly_len, &data, mesh_calc_normals_poly_and_vertex_accum_fn, &settings);
 
   /* Normalize and validate computed vertex normals. */
+  settings.name = "mesh_calc_normals_poly_and_vertex_finalize";
   BLI_task_parallel_range(
       0, mvert_len, &data, mesh_calc_normals_poly_and_vertex_finalize_fn, &settings);
 }
@@ -781,6 +787,45 @@ void BKE_lnor_space_custom_normal_to_data(MLoopNorSpace *lnor_space,
 
 #define LOOP_SPLIT_TASK_BLOCK_SIZE 1024
 
+/** Entry point of a smooth fan (or a single loop), as found by #loop_split_generator. */
+struct LoopSplitFan {
+  int ml_curr_index;
+  /** Loop before #ml_curr_index in its polygon, -1 for single loops. */
+  int ml_prev_index;
+  int mp_index;
+};
+
+/**
+ * Split normals data only depending on the mesh topology and its sharp edges and flat faces,
+ * i.e. everything but the normals themselves as long as the split angle is not used. Allows to
+ * skip the sharp edges tagging and the fans search when evaluating the same topology again,
+ * e.g. for a deformed mesh.
+ */
+struct LoopSplitFanCache {
+  /* Used to validate the cache. */
+  const MEdge *medges;
+  const MLoop *mloops;
+  const MPoly *mpolys;
+  int numEdges;
+  int numLoops;
+  int numPolys;
+
+  int (*edge_to_loops)[2] = nullptr;
+  int *loop_to_poly = nullptr;
+  Vector<LoopSplitFan> fans;
+
+  ~LoopSplitFanCache()
+  {
+    MEM_SAFE_FREE(edge_to_loops);
+    MEM_SAFE_FREE(loop_to_poly);
+  }
+};
+
+void BKE_mesh_loop_split_fan_cache_free(LoopSplitFanCache *fan_cache)
+{
+  MEM_delete(fan_cache);
+}
+
 struct LoopSplitTaskData {
   /* Specific to each instance (each task). */
 
@@ -823,6 +868,9 @@ struct LoopSplitTaskDataCommon {
   int numEdges;
   int numLoops;
   int numPolys;
+
+  /** When not null, the generator records the fans it finds there. */
+  Vector<LoopSplitFan> *r_fans;
 };
 
 #define INDEX_UNSET INT_MIN
@@ -830,6 +878,15 @@ struct LoopSplitTaskDataCommon {
 /* See comment about edge_to_loops below. */
 #define IS_EDGE_SHARP(_e2l) (ELEM((_e2l)[1], INDEX_UNSET, INDEX_INVALID))
 
+static bool loop_split_fan_cache_is_valid(const LoopSplitFanCache *fan_cache,
+                                          const LoopSplitTaskDataCommon &common_data)
+{
+  return fan_cache->medges == common_data.medges && fan_cache->mloops == common_data.mloops &&
+         fan_cache->mpolys == common_data.mpolys && fan_cache->numEdges == common_data.numEdges &&
+         fan_cache->numLoops == common_data.numLoops &&
+         fan_cache->numPolys == common_data.numPolys;
+}
+
 static void mesh_edges_sharp_tag(LoopSplitTaskDataCommon *data,
                                  const bool check_angle,
                                  const float split_angle,
@@ -1564,6 +1621,11 @@ static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common
           }
         }
 
+        if (common_data->r_fans) {
+          common_data->r_fans->append(
+              {ml_curr_index, data->e2l_prev ? ml_prev_index : -1, mp_index});
+        }
+
         if (pool) {
           data_idx++;
           if (data_idx == LOOP_SPLIT_TASK_BLOCK_SIZE) {
@@ -1597,9 +1659,68 @@ static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common
 #endif
 }
 
+/**
+ * Same as #loop_split_generator, but computing the fans already found by a previous call on the
+ * same topology.
+ */
+static void loop_split_generator_from_fans(TaskPool *pool,
+                                           LoopSplitTaskDataCommon *common_data,
+                                           const Span<LoopSplitFan> fans)
+{
+  MLoopNorSpaceArray *lnors_spacearr = common_data->lnors_spacearr;
+  const MLoop *mloops = common_data->mloops;
+  const int(*edge_to_loops)[2] = common_data->edge_to_loops;
+
+  /* Temp edge vectors stack, only used when computing lnor spacearr
+   * (and we are not multi-threading). */
+  BLI_Stack *edge_vectors = (!pool && lnors_spacearr) ? BLI_stack_new(sizeof(float[3]), __func__) :
+                                                        nullptr;
+
+  for (int64_t block_start = 0; block_start < fans.size();
+       block_start += LOOP_SPLIT_TASK_BLOCK_SIZE) {
+    const Span<LoopSplitFan> block_fans = fans.slice(
+        block_start, std::min<int64_t>(LOOP_SPLIT_TASK_BLOCK_SIZE, fans.size() - block_start));
+    LoopSplitTaskData *data_buff = (LoopSplitTaskData *)MEM_calloc_arrayN(
+        LOOP_SPLIT_TASK_BLOCK_SIZE, sizeof(*data_buff), __func__);
+
+    for (const int64_t i : block_fans.index_range()) {
+      const LoopSplitFan &fan = block_fans[i];
+      LoopSplitTaskData *data = &data_buff[i];
+      data->ml_curr = &mloops[fan.ml_curr_index];
+      data->ml_curr_index = fan.ml_curr_index;
+      data->mp_index = fan.mp_index;
+      if (fan.ml_prev_index == -1) {
+        data->lnor = &common_data->loopnors[fan.ml_curr_index];
+      }
+      else {
+        data->ml_prev = &mloops[fan.ml_prev_index];
+        data->ml_prev_index = fan.ml_prev_index;
+        data->e2l_prev = edge_to_loops[data->ml_prev->e];
+      }
+      if (lnors_spacearr) {
+        data->lnor_space = BKE_lnor_space_create(lnors_spacearr);
+      }
+    }
+
+    if (pool) {
+      BLI_task_pool_push(pool, loop_split_worker, data_buff, true, nullptr);
+    }
+    else {
+      for (const int64_t i : block_fans.index_range()) {
+        loop_split_worker_do(common_data, &data_buff[i], edge_vectors);
+      }
+      MEM_freeN(data_buff);
+    }
+  }
+
+  if (edge_vectors) {
+    BLI_stack_free(edge_vectors);
+  }
+}
+
 void BKE_mesh_normals_loop_split(const MVert *mverts,
                                  const float (*vert_normals)[3],
-                                 const int UNUSED(numVerts),
+                                 const int numVerts,
                                  MEdge *medges,
                                  const int numEdges,
                                  MLoop *mloops,
@@ -1613,6 +1734,43 @@ void BKE_mesh_normals_loop_split(const MVert *mverts,
                                  MLoopNorSpaceArray *r_lnors_spacearr,
                                  short (*clnors_data)[2],
                                  int *r_loop_to_poly)
+{
+  BKE_mesh_normals_loop_split_ex(mverts,
+                                 vert_normals,
+                                 numVerts,
+                                 medges,
+                                 numEdges,
+                                 mloops,
+                                 r_loopnors,
+                                 numLoops,
+                                 mpolys,
+                                 polynors,
+                                 numPolys,
+                                 use_split_normals,
+                                 split_angle,
+                                 r_lnors_spacearr,
+                                 clnors_data,
+                                 r_loop_to_poly,
+                                 nullptr);
+}
+
+void BKE_mesh_normals_loop_split_ex(const MVert *mverts,
+                                    const float (*vert_normals)[3],
+                                    const int UNUSED(numVerts),
+                                    MEdge *medges,
+                                    const int numEdges,
+                                    MLoop *mloops,
+                                    float (*r_loopnors)[3],
+                                    const int numLoops,
+                                    MPoly *mpolys,
+                                    const float (*polynors)[3],
+                                    const int numPolys,
+                                    const bool use_split_normals,
+                                    const float split_angle,
+                                    MLoopNorSpaceArray *r_lnors_spacearr,
+                                    short (*clnors_data)[2],
+                                    int *r_loop_to_poly,
+                                    LoopSplitFanCache **r_fan_cache)
 {
   /* For now this is not supported.
    * If we do not use split normals, we do not generate anything fancy! */
@@ -1662,17 +1820,17 @@ void BKE_mesh_normals_loop_split(const MVert *mverts,
    * However, if needed, we can store the negated value of loop index instead of INDEX_INVALID
    * to retrieve the real value later in code).
    * Note also that loose edges always have both values set to 0! */
-  int(*edge_to_loops)[2] = (int(*)[2])MEM_calloc_arrayN(
-      (size_t)numEdges, sizeof(*edge_to_loops), __func__);
+  int(*edge_to_loops)[2] = nullptr;
 
   /* Simple mapping from a loop to its polygon index. */
-  int *loop_to_poly = r_loop_to_poly ? r_loop_to_poly :
-                                       (int *)MEM_malloc_arrayN(
-                                           (size_t)numLoops, sizeof(*loop_to_poly), __func__);
+  int *loop_to_poly = nullptr;
 
   /* When using custom loop normals, disable the angle feature! */
   const bool check_angle = (split_angle < (float)M_PI) && (clnors_data == nullptr);
 
+  /* Without the angle feature, fans only depend on the topology and the sharp flags. */
+  const bool use_fan_cache = (r_fan_cache != nullptr) && !check_angle;
+
   MLoopNorSpaceArray _lnors_spacearr = {nullptr};
 
 #ifdef DEBUG_TIME
@@ -1703,27 +1861,92 @@ void BKE_mesh_normals_loop_split(const MVert *mverts,
   common_data.numEdges = numEdges;
   common_data.numLoops = numLoops;
   common_data.numPolys = numPolys;
+  common_data.r_fans = nullptr;
 
-  /* This first loop check which edges are actually smooth, and compute edge vectors. */
-  mesh_edges_sharp_tag(&common_data, check_angle, split_angle, false);
+  LoopSplitFanCache *fan_cache = nullptr;
+  if (use_fan_cache && *r_fan_cache) {
+    if (loop_split_fan_cache_is_valid(*r_fan_cache, common_data)) {
+      fan_cache = *r_fan_cache;
+    }
+    else {
+      BKE_mesh_loop_split_fan_cache_free(*r_fan_cache);
+      *r_fan_cache = nullptr;
+    }
+  }
 
-  if (numLoops < LOOP_SPLIT_TASK_BLOCK_SIZE * 8) {
-    /* Not enough loops to be worth the whole threading overhead. */
-    loop_split_generator(nullptr, &common_data);
+  if (fan_cache) {
+    common_data.edge_to_loops = fan_cache->edge_to_loops;
+    common_data.loop_to_poly = fan_cache->loop_to_poly;
+    if (r_loop_to_poly) {
+      memcpy(r_loop_to_poly, fan_cache->loop_to_poly, sizeof(*r_loop_to_poly) * (size_t)numLoops);
+    }
+
+    /* Same pre-population as done by #mesh_edges_sharp_tag. */
+    blender::threading::parallel_for(IndexRange(numLoops), 4096, [&](const IndexRange range) {
+      for (const int ml_index : range) {
+        copy_v3_v3(r_loopnors[ml_index], vert_normals[mloops[ml_index].v]);
+      }
+    });
   }
   else {
-    TaskPool *task_pool = BLI_task_pool_create(&common_data, TASK_PRIORITY_HIGH);
+    edge_to_loops = (int(*)[2])MEM_calloc_arrayN(
+        (size_t)numEdges, sizeof(*edge_to_loops), __func__);
+    loop_to_poly = (r_loop_to_poly && !use_fan_cache) ?
+                       r_loop_to_poly :
+                       (int *)MEM_malloc_arrayN(
+                           (size_t)numLoops, sizeof(*loop_to_poly), __func__);
+    common_data.edge_to_loops = edge_to_loops;
+    common_data.loop_to_poly = loop_to_poly;
+
+    if (use_fan_cache) {
+      fan_cache = MEM_new<LoopSplitFanCache>(__func__);
+      fan_cache->medges = medges;
+      fan_cache->mloops = mloops;
+      fan_cache->mpolys = mpolys;
+      fan_cache->numEdges = numEdges;
+      fan_cache->numLoops = numLoops;
+      fan_cache->numPolys = numPolys;
+      common_data.r_fans = &fan_cache->fans;
+    }
+
+    /* This first loop check which edges are actually smooth, and compute edge vectors. */
+    mesh_edges_sharp_tag(&common_data, check_angle, split_angle, false);
+  }
+
+  TaskPool *task_pool = nullptr;
+  /* Not enough loops to be worth the whole threading overhead otherwise. */
+  if (numLoops >= LOOP_SPLIT_TASK_BLOCK_SIZE * 8) {
+    task_pool = BLI_task_pool_create(&common_data, TASK_PRIORITY_HIGH);
+  }
 
+  if (common_data.r_fans == nullptr && fan_cache) {
+    loop_split_generator_from_fans(task_pool, &common_data, fan_cache->fans);
+  }
+  else {
     loop_split_generator(task_pool, &common_data);
+  }
 
+  if (task_pool) {
     BLI_task_pool_work_and_wait(task_pool);
-
     BLI_task_pool_free(task_pool);
   }
 
-  MEM_freeN(edge_to_loops);
-  if (!r_loop_to_poly) {
-    MEM_freeN(loop_to_poly);
+  if (use_fan_cache) {
+    if (common_data.r_fans) {
+      /* Newly built cache takes ownership of the topology arrays. */
+      if (r_loop_to_poly) {
+        memcpy(r_loop_to_poly, loop_to_poly, sizeof(*r_loop_to_poly) * (size_t)numLoops);
+      }
+      fan_cache->edge_to_loops = edge_to_loops;
+      fan_cache->loop_to_poly = loop_to_poly;
+      *r_fan_cache = fan_cache;
+    }
+  }
+  else {
+    MEM_freeN(edge_to_loops);
+    if (!r_loop_to_poly) {
+      MEM_freeN(loop_to_poly);
+    }
   }
 
   if (r_lnors_spacearr) {
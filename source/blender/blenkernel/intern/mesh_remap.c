@@ -68,6 +68,59 @@ static bool mesh_remap_bvhtree_query_nearest(BVHTreeFromMesh *treedata,
   return false;
 }
 
+/**
+ * Same as #mesh_remap_bvhtree_query_nearest for all given coordinates (in tree space) at once,
+ * which is much faster than separate queries.
+ *
+ * \return Allocated nearest results, an index of -1 meaning no source was found.
+ */
+static BVHTreeNearest *mesh_remap_bvhtree_query_nearest_batch(BVHTreeFromMesh *treedata,
+                                                              const float (*cos)[3],
+                                                              const int cos_num,
+                                                              const float max_dist_sq)
+{
+  BVHTreeNearest *nearest = MEM_malloc_arrayN((size_t)cos_num, sizeof(*nearest), __func__);
+
+  for (int i = 0; i < cos_num; i++) {
+    nearest[i].index = -1;
+    nearest[i].dist_sq = max_dist_sq;
+  }
+
+  BKE_bvhtree_from_mesh_find_nearest_batch(treedata, cos, cos_num, nearest);
+
+  return nearest;
+}
+
+/**
+ * Same as #mesh_remap_bvhtree_query_nearest_batch for vertices.
+ *
+ * \param r_cos: Allocated coordinates of the vertices in tree space.
+ * \return Allocated nearest results, an index of -1 meaning no source was found.
+ */
+static BVHTreeNearest *mesh_remap_bvhtree_query_nearest_verts(
+    BVHTreeFromMesh *treedata,
+    const MVert *verts,
+    const int verts_num,
+    const SpaceTransform *space_transform,
+    const float max_dist_sq,
+    float (**r_cos)[3])
+{
+  float(*cos)[3] = MEM_malloc_arrayN((size_t)verts_num, sizeof(*cos), __func__);
+
+  for (int i = 0; i < verts_num; i++) {
+    copy_v3_v3(cos[i], verts[i].co);
+
+    /* Convert the vertex to tree coordinates, if needed. */
+    if (space_transform) {
+      BLI_space_transform_apply(space_transform, cos[i]);
+    }
+  }
+
+  *r_cos = cos;
+  return mesh_remap_bvhtree_query_nearest_batch(
+      treedata, (const float(*)[3])cos, verts_num, max_dist_sq);
+}
+
 static bool mesh_remap_bvhtree_query_raycast(BVHTreeFromMesh *treedata,
                                              BVHTreeRayHit *rayhit,
                                              const float co[3],
@@ -101,6 +154,51 @@ static bool mesh_remap_bvhtree_query_raycast(BVHTreeFromMesh *treedata,
   return false;
 }
 
+/**
+ * Same as #mesh_remap_bvhtree_query_raycast for all given coordinates and normals (in tree
+ * space) at once, which is much faster than separate queries.
+ *
+ * \return Allocated hits, an index of -1 meaning no source was found.
+ */
+static BVHTreeRayHit *mesh_remap_bvhtree_query_raycast_batch(BVHTreeFromMesh *treedata,
+                                                             const float (*cos)[3],
+                                                             float (*nos)[3],
+                                                             const int rays_num,
+                                                             const float radius,
+                                                             const float max_dist)
+{
+  BVHTreeRayHit *rayhits = MEM_malloc_arrayN((size_t)rays_num, sizeof(*rayhits), __func__);
+  BVHTreeRayHit *rayhits_inv = MEM_malloc_arrayN((size_t)rays_num, sizeof(*rayhits), __func__);
+
+  for (int i = 0; i < rays_num; i++) {
+    rayhits[i].index = -1;
+    rayhits[i].dist = max_dist;
+  }
+  BKE_bvhtree_from_mesh_ray_cast_batch(
+      treedata, cos, (const float(*)[3])nos, rays_num, radius, rayhits);
+
+  /* Also cast in the other direction! */
+  for (int i = 0; i < rays_num; i++) {
+    rayhits_inv[i] = rayhits[i];
+    negate_v3(nos[i]);
+  }
+  BKE_bvhtree_from_mesh_ray_cast_batch(
+      treedata, cos, (const float(*)[3])nos, rays_num, radius, rayhits_inv);
+
+  for (int i = 0; i < rays_num; i++) {
+    negate_v3(nos[i]);
+    if (rayhits_inv[i].dist < rayhits[i].dist) {
+      rayhits[i] = rayhits_inv[i];
+    }
+    if (rayhits[i].dist > max_dist) {
+      rayhits[i].index = -1;
+    }
+  }
+
+  MEM_freeN(rayhits_inv);
+  return rayhits;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -503,44 +601,41 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
 
     if (mode == MREMAP_MODE_VERT_NEAREST) {
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_VERTS, 2);
-      nearest.index = -1;
 
-      for (i = 0; i < numverts_dst; i++) {
-        copy_v3_v3(tmp_co, verts_dst[i].co);
+      float(*cos_dst)[3];
+      BVHTreeNearest *nearest_dst = mesh_remap_bvhtree_query_nearest_verts(
+          &treedata, verts_dst, numverts_dst, space_transform, max_dist_sq, &cos_dst);
 
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
-
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &nearest.index, &full_weight);
+      for (i = 0; i < numverts_dst; i++) {
+        if (nearest_dst[i].index != -1) {
+          hit_dist = sqrtf(nearest_dst[i].dist_sq);
+          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &nearest_dst[i].index, &full_weight);
         }
         else {
           /* No source for this dest vertex! */
           BKE_mesh_remap_item_define_invalid(r_map, i);
         }
       }
+
+      MEM_freeN(cos_dst);
+      MEM_freeN(nearest_dst);
     }
     else if (ELEM(mode, MREMAP_MODE_VERT_EDGE_NEAREST, MREMAP_MODE_VERT_EDGEINTERP_NEAREST)) {
       MEdge *edges_src = me_src->medge;
       float(*vcos_src)[3] = BKE_mesh_vert_coords_alloc(me_src, NULL);
 
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_EDGES, 2);
-      nearest.index = -1;
 
-      for (i = 0; i < numverts_dst; i++) {
-        copy_v3_v3(tmp_co, verts_dst[i].co);
+      float(*cos_dst)[3];
+      BVHTreeNearest *nearest_dst = mesh_remap_bvhtree_query_nearest_verts(
+          &treedata, verts_dst, numverts_dst, space_transform, max_dist_sq, &cos_dst);
 
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
+      for (i = 0; i < numverts_dst; i++) {
+        copy_v3_v3(tmp_co, cos_dst[i]);
 
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          MEdge *me = &edges_src[nearest.index];
+        if (nearest_dst[i].index != -1) {
+          hit_dist = sqrtf(nearest_dst[i].dist_sq);
+          MEdge *me = &edges_src[nearest_dst[i].index];
           const float *v1cos = vcos_src[me->v1];
           const float *v2cos = vcos_src[me->v2];
 
@@ -571,6 +666,8 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
         }
       }
 
+      MEM_freeN(cos_dst);
+      MEM_freeN(nearest_dst);
       MEM_freeN(vcos_src);
     }
     else if (ELEM(mode,
@@ -625,18 +722,15 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
         }
       }
       else {
-        nearest.index = -1;
+        float(*cos_dst)[3];
+        BVHTreeNearest *nearest_dst = mesh_remap_bvhtree_query_nearest_verts(
+            &treedata, verts_dst, numverts_dst, space_transform, max_dist_sq, &cos_dst);
 
         for (i = 0; i < numverts_dst; i++) {
-          copy_v3_v3(tmp_co, verts_dst[i].co);
-
-          /* Convert the vertex to tree coordinates, if needed. */
-          if (space_transform) {
-            BLI_space_transform_apply(space_transform, tmp_co);
-          }
+          nearest = nearest_dst[i];
 
-          if (mesh_remap_bvhtree_query_nearest(
-                  &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
+          if (nearest.index != -1) {
+            hit_dist = sqrtf(nearest.dist_sq);
             const MLoopTri *lt = &treedata.looptri[nearest.index];
             MPoly *mp = &polys_src[lt->poly];
 
@@ -677,6 +771,9 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
             BKE_mesh_remap_item_define_invalid(r_map, i);
           }
         }
+
+        MEM_freeN(cos_dst);
+        MEM_freeN(nearest_dst);
       }
 
       MEM_freeN(vcos_src);
@@ -727,13 +824,10 @@ void BKE_mesh_remap_calc_edges_from_mesh(const int mode,
     float tmp_co[3], tmp_no[3];
 
     if (mode == MREMAP_MODE_EDGE_VERT_NEAREST) {
-      const int num_verts_src = me_src->totvert;
-      const int num_edges_src = me_src->totedge;
       MEdge *edges_src = me_src->medge;
       float(*vcos_src)[3] = BKE_mesh_vert_coords_alloc(me_src, NULL);
 
-      MeshElemMap *vert_to_edge_src_map;
-      int *vert_to_edge_src_map_mem;
+      const MeshElemMap *vert_to_edge_src_map = BKE_mesh_runtime_vert_edge_map_ensure(me_src);
 
       struct {
         float hit_dist;
@@ -745,12 +839,6 @@ void BKE_mesh_remap_calc_edges_from_mesh(const int mode,
         v_dst_to_src_map[i].hit_dist = -1.0f;
       }
 
-      BKE_mesh_vert_edge_map_create(&vert_to_edge_src_map,
-                                    &vert_to_edge_src_map_mem,
-                                    edges_src,
-                                    num_verts_src,
-                                    num_edges_src);
-
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_VERTS, 2);
       nearest.index = -1;
 
@@ -850,30 +938,37 @@ void BKE_mesh_remap_calc_edges_from_mesh(const int mode,
 
       MEM_freeN(vcos_src);
       MEM_freeN(v_dst_to_src_map);
-      MEM_freeN(vert_to_edge_src_map);
-      MEM_freeN(vert_to_edge_src_map_mem);
     }
     else if (mode == MREMAP_MODE_EDGE_NEAREST) {
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_EDGES, 2);
-      nearest.index = -1;
 
+      float(*cos_dst)[3] = MEM_malloc_arrayN((size_t)numedges_dst, sizeof(*cos_dst), __func__);
       for (i = 0; i < numedges_dst; i++) {
-        interp_v3_v3v3(tmp_co, verts_dst[edges_dst[i].v1].co, verts_dst[edges_dst[i].v2].co, 0.5f);
+        interp_v3_v3v3(
+            cos_dst[i], verts_dst[edges_dst[i].v1].co, verts_dst[edges_dst[i].v2].co, 0.5f);
 
         /* Convert the vertex to tree coordinates, if needed. */
         if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
+          BLI_space_transform_apply(space_transform, cos_dst[i]);
         }
+      }
 
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &nearest.index, &full_weight);
+      BVHTreeNearest *nearest_dst = mesh_remap_bvhtree_query_nearest_batch(
+          &treedata, (const float(*)[3])cos_dst, numedges_dst, max_dist_sq);
+
+      for (i = 0; i < numedges_dst; i++) {
+        if (nearest_dst[i].index != -1) {
+          hit_dist = sqrtf(nearest_dst[i].dist_sq);
+          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &nearest_dst[i].index, &full_weight);
         }
         else {
           /* No source for this dest edge! */
           BKE_mesh_remap_item_define_invalid(r_map, i);
         }
       }
+
+      MEM_freeN(cos_dst);
+      MEM_freeN(nearest_dst);
     }
     else if (mode == MREMAP_MODE_EDGE_POLY_NEAREST) {
       MEdge *edges_src = me_src->medge;
@@ -1049,7 +1144,7 @@ static void mesh_island_to_astar_graph_edge_process(MeshIslandStore *islands,
                                                     MLoop *loops,
                                                     const int edge_idx,
                                                     BLI_bitmap *done_edges,
-                                                    MeshElemMap *edge_to_poly_map,
+                                                    const MeshElemMap *edge_to_poly_map,
                                                     const bool is_edge_innercut,
                                                     const int *poly_island_index_map,
                                                     float (*poly_centers)[3],
@@ -1103,7 +1198,7 @@ static void mesh_island_to_astar_graph_edge_process(MeshIslandStore *islands,
 static void mesh_island_to_astar_graph(MeshIslandStore *islands,
                                        const int island_index,
                                        MVert *verts,
-                                       MeshElemMap *edge_to_poly_map,
+                                       const MeshElemMap *edge_to_poly_map,
                                        const int numedges,
                                        MLoop *loops,
                                        MPoly *polys,
@@ -1293,17 +1388,14 @@ void BKE_mesh_remap_calc_loops_from_mesh(const int mode,
 
     float(*poly_cents_src)[3] = NULL;
 
-    MeshElemMap *vert_to_loop_map_src = NULL;
-    int *vert_to_loop_map_src_buff = NULL;
-    MeshElemMap *vert_to_poly_map_src = NULL;
-    int *vert_to_poly_map_src_buff = NULL;
-    MeshElemMap *edge_to_poly_map_src = NULL;
-    int *edge_to_poly_map_src_buff = NULL;
+    const MeshElemMap *vert_to_loop_map_src = NULL;
+    const MeshElemMap *vert_to_poly_map_src = NULL;
+    const MeshElemMap *edge_to_poly_map_src = NULL;
     MeshElemMap *poly_to_looptri_map_src = NULL;
     int *poly_to_looptri_map_src_buff = NULL;
 
     /* Unlike above, those are one-to-one mappings, simpler! */
-    int *loop_to_poly_map_src = NULL;
+    const int *loop_to_poly_map_src = NULL;
 
     MVert *verts_src = me_src->mvert;
     const int num_verts_src = me_src->totvert;
@@ -1388,44 +1480,21 @@ void BKE_mesh_remap_calc_loops_from_mesh(const int mode,
       }
     }
 
+    /* Topology maps of the source mesh are cached, it is usually reused by many evaluations. */
     if (use_from_vert) {
-      BKE_mesh_vert_loop_map_create(&vert_to_loop_map_src,
-                                    &vert_to_loop_map_src_buff,
-                                    polys_src,
-                                    loops_src,
-                                    num_verts_src,
-                                    num_polys_src,
-                                    num_loops_src);
+      vert_to_loop_map_src = BKE_mesh_runtime_vert_loop_map_ensure(me_src);
       if (mode & MREMAP_USE_POLY) {
-        BKE_mesh_vert_poly_map_create(&vert_to_poly_map_src,
-                                      &vert_to_poly_map_src_buff,
-                                      polys_src,
-                                      loops_src,
-                                      num_verts_src,
-                                      num_polys_src,
-                                      num_loops_src);
+        vert_to_poly_map_src = BKE_mesh_runtime_vert_poly_map_ensure(me_src);
       }
     }
 
     /* Needed for islands (or plain mesh) to AStar graph conversion. */
-    BKE_mesh_edge_poly_map_create(&edge_to_poly_map_src,
-                                  &edge_to_poly_map_src_buff,
-                                  edges_src,
-                                  num_edges_src,
-                                  polys_src,
-                                  num_polys_src,
-                                  loops_src,
-                                  num_loops_src);
+    edge_to_poly_map_src = BKE_mesh_runtime_edge_poly_map_ensure(me_src);
     if (use_from_vert) {
-      loop_to_poly_map_src = MEM_mallocN(sizeof(*loop_to_poly_map_src) * (size_t)num_loops_src,
-                                         __func__);
+      loop_to_poly_map_src = BKE_mesh_runtime_loop_poly_map_ensure(me_src);
       poly_cents_src = MEM_mallocN(sizeof(*poly_cents_src) * (size_t)num_polys_src, __func__);
       for (pidx_src = 0, mp_src = polys_src; pidx_src < num_polys_src; pidx_src++, mp_src++) {
         ml_src = &loops_src[mp_src->loopstart];
-        for (plidx_src = 0, lidx_src = mp_src->loopstart; plidx_src < mp_src->totloop;
-             plidx_src++, lidx_src++) {
-          loop_to_poly_map_src[lidx_src] = pidx_src;
-        }
         BKE_mesh_calc_poly_center(mp_src, ml_src, verts_src, poly_cents_src[pidx_src]);
       }
     }
@@ -1608,7 +1677,7 @@ void BKE_mesh_remap_calc_loops_from_mesh(const int mode,
         ml_dst = &loops_dst[mp_dst->loopstart];
         for (plidx_dst = 0; plidx_dst < mp_dst->totloop; plidx_dst++, ml_dst++) {
           if (use_from_vert) {
-            MeshElemMap *vert_to_refelem_map_src = NULL;
+            const MeshElemMap *vert_to_refelem_map_src = NULL;
 
             copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
             nearest.index = -1;
@@ -2115,33 +2184,12 @@ void BKE_mesh_remap_calc_loops_from_mesh(const int mode,
     if (vcos_src) {
       MEM_freeN(vcos_src);
     }
-    if (vert_to_loop_map_src) {
-      MEM_freeN(vert_to_loop_map_src);
-    }
-    if (vert_to_loop_map_src_buff) {
-      MEM_freeN(vert_to_loop_map_src_buff);
-    }
-    if (vert_to_poly_map_src) {
-      MEM_freeN(vert_to_poly_map_src);
-    }
-    if (vert_to_poly_map_src_buff) {
-      MEM_freeN(vert_to_poly_map_src_buff);
-    }
-    if (edge_to_poly_map_src) {
-      MEM_freeN(edge_to_poly_map_src);
-    }
-    if (edge_to_poly_map_src_buff) {
-      MEM_freeN(edge_to_poly_map_src_buff);
-    }
     if (poly_to_looptri_map_src) {
       MEM_freeN(poly_to_looptri_map_src);
     }
     if (poly_to_looptri_map_src_buff) {
       MEM_freeN(poly_to_looptri_map_src_buff);
     }
-    if (loop_to_poly_map_src) {
-      MEM_freeN(loop_to_poly_map_src);
-    }
     if (poly_cents_src) {
       MEM_freeN(poly_cents_src);
     }
@@ -2191,28 +2239,31 @@ void BKE_mesh_remap_calc_polys_from_mesh(const int mode,
   }
   else {
     BVHTreeFromMesh treedata = {NULL};
-    BVHTreeNearest nearest = {0};
     BVHTreeRayHit rayhit = {0};
     float hit_dist;
 
     BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_LOOPTRI, 2);
 
     if (mode == MREMAP_MODE_POLY_NEAREST) {
-      nearest.index = -1;
-
+      float(*cos_dst)[3] = MEM_malloc_arrayN((size_t)numpolys_dst, sizeof(*cos_dst), __func__);
       for (i = 0; i < numpolys_dst; i++) {
         MPoly *mp = &polys_dst[i];
 
-        BKE_mesh_calc_poly_center(mp, &loops_dst[mp->loopstart], verts_dst, tmp_co);
+        BKE_mesh_calc_poly_center(mp, &loops_dst[mp->loopstart], verts_dst, cos_dst[i]);
 
         /* Convert the vertex to tree coordinates, if needed. */
         if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
+          BLI_space_transform_apply(space_transform, cos_dst[i]);
         }
+      }
 
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          const MLoopTri *lt = &treedata.looptri[nearest.index];
+      BVHTreeNearest *nearest_dst = mesh_remap_bvhtree_query_nearest_batch(
+          &treedata, (const float(*)[3])cos_dst, numpolys_dst, max_dist_sq);
+
+      for (i = 0; i < numpolys_dst; i++) {
+        if (nearest_dst[i].index != -1) {
+          hit_dist = sqrtf(nearest_dst[i].dist_sq);
+          const MLoopTri *lt = &treedata.looptri[nearest_dst[i].index];
           const int poly_index = (int)lt->poly;
           mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &poly_index, &full_weight);
         }
@@ -2221,34 +2272,47 @@ void BKE_mesh_remap_calc_polys_from_mesh(const int mode,
           BKE_mesh_remap_item_define_invalid(r_map, i);
         }
       }
+
+      MEM_freeN(cos_dst);
+      MEM_freeN(nearest_dst);
     }
     else if (mode == MREMAP_MODE_POLY_NOR) {
       BLI_assert(poly_nors_dst);
 
+      float(*cos_dst)[3] = MEM_malloc_arrayN((size_t)numpolys_dst, sizeof(*cos_dst), __func__);
+      float(*nos_dst)[3] = MEM_malloc_arrayN((size_t)numpolys_dst, sizeof(*nos_dst), __func__);
       for (i = 0; i < numpolys_dst; i++) {
         MPoly *mp = &polys_dst[i];
 
-        BKE_mesh_calc_poly_center(mp, &loops_dst[mp->loopstart], verts_dst, tmp_co);
-        copy_v3_v3(tmp_no, poly_nors_dst[i]);
+        BKE_mesh_calc_poly_center(mp, &loops_dst[mp->loopstart], verts_dst, cos_dst[i]);
+        copy_v3_v3(nos_dst[i], poly_nors_dst[i]);
 
         /* Convert the vertex to tree coordinates, if needed. */
         if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-          BLI_space_transform_apply_normal(space_transform, tmp_no);
+          BLI_space_transform_apply(space_transform, cos_dst[i]);
+          BLI_space_transform_apply_normal(space_transform, nos_dst[i]);
         }
+      }
+
+      BVHTreeRayHit *rayhits_dst = mesh_remap_bvhtree_query_raycast_batch(
+          &treedata, (const float(*)[3])cos_dst, nos_dst, numpolys_dst, ray_radius, max_dist);
 
-        if (mesh_remap_bvhtree_query_raycast(
-                &treedata, &rayhit, tmp_co, tmp_no, ray_radius, max_dist, &hit_dist)) {
-          const MLoopTri *lt = &treedata.looptri[rayhit.index];
+      for (i = 0; i < numpolys_dst; i++) {
+        if (rayhits_dst[i].index != -1) {
+          const MLoopTri *lt = &treedata.looptri[rayhits_dst[i].index];
           const int poly_index = (int)lt->poly;
 
-          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &poly_index, &full_weight);
+          mesh_remap_item_define(r_map, i, rayhits_dst[i].dist, 0, 1, &poly_index, &full_weight);
         }
         else {
           /* No source for this dest poly! */
           BKE_mesh_remap_item_define_invalid(r_map, i);
         }
       }
+
+      MEM_freeN(cos_dst);
+      MEM_freeN(nos_dst);
+      MEM_freeN(rayhits_dst);
     }
     else if (mode == MREMAP_MODE_POLY_POLYINTERP_PNORPROJ) {
       /* We cast our rays randomly, with a pseudo-even distribution
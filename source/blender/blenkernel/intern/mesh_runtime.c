@@ -20,6 +20,7 @@
 #include "BKE_bvhutils.h"
 #include "BKE_lib_id.h"
 #include "BKE_mesh.h"
+#include "BKE_mesh_mapping.h"
 #include "BKE_mesh_runtime.h"
 #include "BKE_shrinkwrap.h"
 #include "BKE_subdiv_ccg.h"
@@ -41,6 +42,9 @@ static void mesh_runtime_init_mutexes(Mesh *mesh)
   BLI_mutex_init(mesh->runtime.normals_mutex);
   mesh->runtime.render_mutex = MEM_mallocN(sizeof(ThreadMutex), "mesh runtime render_mutex");
   BLI_mutex_init(mesh->runtime.render_mutex);
+  mesh->runtime.topology_mutex = MEM_mallocN(sizeof(ThreadMutex),
+                                             "mesh runtime topology_mutex");
+  BLI_mutex_init(mesh->runtime.topology_mutex);
 }
 
 /**
@@ -63,6 +67,11 @@ static void mesh_runtime_free_mutexes(Mesh *mesh)
     MEM_freeN(mesh->runtime.render_mutex);
     mesh->runtime.render_mutex = NULL;
   }
+  if (mesh->runtime.topology_mutex != NULL) {
+    BLI_mutex_end(mesh->runtime.topology_mutex);
+    MEM_freeN(mesh->runtime.topology_mutex);
+    mesh->runtime.topology_mutex = NULL;
+  }
 }
 
 void BKE_mesh_runtime_init_data(Mesh *mesh)
@@ -87,6 +96,8 @@ void BKE_mesh_runtime_reset_on_copy(Mesh *mesh, const int UNUSED(flag))
   memset(&runtime->looptris, 0, sizeof(runtime->looptris));
   runtime->bvh_cache = NULL;
   runtime->shrinkwrap_data = NULL;
+  runtime->topology_maps = NULL;
+  runtime->loop_split_fans = NULL;
 
   runtime->vert_normals_dirty = true;
   runtime->poly_normals_dirty = true;
@@ -209,6 +220,169 @@ void BKE_mesh_runtime_verttri_from_looptri(MVertTri *r_verttri,
   }
 }
 
+typedef struct MeshTopologyMaps {
+  /* Sizes of the mesh when the maps were created. */
+  int totvert;
+  int totedge;
+  int totpoly;
+  int totloop;
+
+  MeshElemMap *vert_poly_map;
+  int *vert_poly_mem;
+  MeshElemMap *vert_loop_map;
+  int *vert_loop_mem;
+  MeshElemMap *vert_edge_map;
+  int *vert_edge_mem;
+  MeshElemMap *edge_poly_map;
+  int *edge_poly_mem;
+  int *loop_poly_map;
+} MeshTopologyMaps;
+
+static void mesh_runtime_topology_maps_free(Mesh *mesh)
+{
+  MeshTopologyMaps *maps = mesh->runtime.topology_maps;
+  if (maps == NULL) {
+    return;
+  }
+  MEM_SAFE_FREE(maps->vert_poly_map);
+  MEM_SAFE_FREE(maps->vert_poly_mem);
+  MEM_SAFE_FREE(maps->vert_loop_map);
+  MEM_SAFE_FREE(maps->vert_loop_mem);
+  MEM_SAFE_FREE(maps->vert_edge_map);
+  MEM_SAFE_FREE(maps->vert_edge_mem);
+  MEM_SAFE_FREE(maps->edge_poly_map);
+  MEM_SAFE_FREE(maps->edge_poly_mem);
+  MEM_SAFE_FREE(maps->loop_poly_map);
+  MEM_freeN(maps);
+  mesh->runtime.topology_maps = NULL;
+}
+
+/**
+ * \note Must be called with the #Mesh_Runtime.topology_mutex locked.
+ */
+static MeshTopologyMaps *mesh_runtime_topology_maps_get(Mesh *mesh)
+{
+  MeshTopologyMaps *maps = mesh->runtime.topology_maps;
+  if (maps != NULL) {
+    if (maps->totvert == mesh->totvert && maps->totedge == mesh->totedge &&
+        maps->totpoly == mesh->totpoly && maps->totloop == mesh->totloop) {
+      return maps;
+    }
+    /* The topology changed without clearing the geometry caches. */
+    BLI_assert_unreachable();
+    mesh_runtime_topology_maps_free(mesh);
+  }
+
+  maps = MEM_callocN(sizeof(*maps), __func__);
+  maps->totvert = mesh->totvert;
+  maps->totedge = mesh->totedge;
+  maps->totpoly = mesh->totpoly;
+  maps->totloop = mesh->totloop;
+  mesh->runtime.topology_maps = maps;
+  return maps;
+}
+
+const MeshElemMap *BKE_mesh_runtime_vert_poly_map_ensure(const Mesh *mesh)
+{
+  ThreadMutex *topology_mutex = (ThreadMutex *)mesh->runtime.topology_mutex;
+  BLI_mutex_lock(topology_mutex);
+
+  MeshTopologyMaps *maps = mesh_runtime_topology_maps_get((Mesh *)mesh);
+  if (maps->vert_poly_map == NULL) {
+    BKE_mesh_vert_poly_map_create(&maps->vert_poly_map,
+                                  &maps->vert_poly_mem,
+                                  mesh->mpoly,
+                                  mesh->mloop,
+                                  mesh->totvert,
+                                  mesh->totpoly,
+                                  mesh->totloop);
+  }
+  const MeshElemMap *map = maps->vert_poly_map;
+
+  BLI_mutex_unlock(topology_mutex);
+  return map;
+}
+
+const MeshElemMap *BKE_mesh_runtime_vert_loop_map_ensure(const Mesh *mesh)
+{
+  ThreadMutex *topology_mutex = (ThreadMutex *)mesh->runtime.topology_mutex;
+  BLI_mutex_lock(topology_mutex);
+
+  MeshTopologyMaps *maps = mesh_runtime_topology_maps_get((Mesh *)mesh);
+  if (maps->vert_loop_map == NULL) {
+    BKE_mesh_vert_loop_map_create(&maps->vert_loop_map,
+                                  &maps->vert_loop_mem,
+                                  mesh->mpoly,
+                                  mesh->mloop,
+                                  mesh->totvert,
+                                  mesh->totpoly,
+                                  mesh->totloop);
+  }
+  const MeshElemMap *map = maps->vert_loop_map;
+
+  BLI_mutex_unlock(topology_mutex);
+  return map;
+}
+
+const MeshElemMap *BKE_mesh_runtime_vert_edge_map_ensure(const Mesh *mesh)
+{
+  ThreadMutex *topology_mutex = (ThreadMutex *)mesh->runtime.topology_mutex;
+  BLI_mutex_lock(topology_mutex);
+
+  MeshTopologyMaps *maps = mesh_runtime_topology_maps_get((Mesh *)mesh);
+  if (maps->vert_edge_map == NULL) {
+    BKE_mesh_vert_edge_map_create(
+        &maps->vert_edge_map, &maps->vert_edge_mem, mesh->medge, mesh->totvert, mesh->totedge);
+  }
+  const MeshElemMap *map = maps->vert_edge_map;
+
+  BLI_mutex_unlock(topology_mutex);
+  return map;
+}
+
+const MeshElemMap *BKE_mesh_runtime_edge_poly_map_ensure(const Mesh *mesh)
+{
+  ThreadMutex *topology_mutex = (ThreadMutex *)mesh->runtime.topology_mutex;
+  BLI_mutex_lock(topology_mutex);
+
+  MeshTopologyMaps *maps = mesh_runtime_topology_maps_get((Mesh *)mesh);
+  if (maps->edge_poly_map == NULL) {
+    BKE_mesh_edge_poly_map_create(&maps->edge_poly_map,
+                                  &maps->edge_poly_mem,
+                                  mesh->medge,
+                                  mesh->totedge,
+                                  mesh->mpoly,
+                                  mesh->totpoly,
+                                  mesh->mloop,
+                                  mesh->totloop);
+  }
+  const MeshElemMap *map = maps->edge_poly_map;
+
+  BLI_mutex_unlock(topology_mutex);
+  return map;
+}
+
+const int *BKE_mesh_runtime_loop_poly_map_ensure(const Mesh *mesh)
+{
+  ThreadMutex *topology_mutex = (ThreadMutex *)mesh->runtime.topology_mutex;
+  BLI_mutex_lock(topology_mutex);
+
+  MeshTopologyMaps *maps = mesh_runtime_topology_maps_get((Mesh *)mesh);
+  if (maps->loop_poly_map == NULL) {
+    maps->loop_poly_map = MEM_malloc_arrayN(mesh->totloop, sizeof(int), __func__);
+    for (int i = 0; i < mesh->totpoly; i++) {
+      const MPoly *mp = &mesh->mpoly[i];
+      for (int j = 0; j < mp->totloop; j++) {
+        maps->loop_poly_map[mp->loopstart + j] = i;
+      }
+    }
+  }
+  const int *map = maps->loop_poly_map;
+
+  BLI_mutex_unlock(topology_mutex);
+  return map;
+}
+
 bool BKE_mesh_runtime_ensure_edit_data(struct Mesh *mesh)
 {
   if (mesh->runtime.edit_data != NULL) {
@@ -254,6 +428,11 @@ void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
     mesh->runtime.bvh_cache = NULL;
   }
   MEM_SAFE_FREE(mesh->runtime.looptris.array);
+  mesh_runtime_topology_maps_free(mesh);
+  if (mesh->runtime.loop_split_fans != NULL) {
+    BKE_mesh_loop_split_fan_cache_free(mesh->runtime.loop_split_fans);
+    mesh->runtime.loop_split_fans = NULL;
+  }
   /* TODO(sergey): Does this really belong here? */
   if (mesh->runtime.subdiv_ccg != NULL) {
     BKE_subdiv_ccg_destroy(mesh->runtime.subdiv_ccg);
@@ -0,0 +1,74 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. */
+#include "testing/testing.h"
+
+#include "BKE_idtype.h"
+#include "BKE_lib_id.h"
+#include "BKE_mesh.h"
+#include "BKE_mesh_mapping.h"
+#include "BKE_mesh_runtime.h"
+
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+
+namespace blender::bke::tests {
+
+/** Two quads sharing the edge between vertices 1 and 2. */
+static Mesh *create_two_quads_mesh()
+{
+  BKE_idtype_init();
+  Mesh *mesh = BKE_mesh_new_nomain(6, 7, 0, 8, 2);
+
+  const int edges[7][2] = {{0, 1}, {1, 2}, {2, 3}, {3, 0}, {1, 4}, {4, 5}, {5, 2}};
+  for (int i = 0; i < 7; i++) {
+    mesh->medge[i].v1 = edges[i][0];
+    mesh->medge[i].v2 = edges[i][1];
+  }
+
+  const int loops[8][2] = {{0, 0}, {1, 1}, {2, 2}, {3, 3}, {1, 4}, {4, 5}, {5, 6}, {2, 1}};
+  for (int i = 0; i < 8; i++) {
+    mesh->mloop[i].v = loops[i][0];
+    mesh->mloop[i].e = loops[i][1];
+  }
+
+  for (int i = 0; i < 2; i++) {
+    mesh->mpoly[i].loopstart = i * 4;
+    mesh->mpoly[i].totloop = 4;
+  }
+  return mesh;
+}
+
+TEST(mesh_runtime, topology_maps)
+{
+  Mesh *mesh = create_two_quads_mesh();
+
+  const MeshElemMap *vert_poly_map = BKE_mesh_runtime_vert_poly_map_ensure(mesh);
+  EXPECT_EQ(vert_poly_map, BKE_mesh_runtime_vert_poly_map_ensure(mesh));
+  EXPECT_EQ(vert_poly_map[0].count, 1);
+  EXPECT_EQ(vert_poly_map[1].count, 2);
+  EXPECT_EQ(vert_poly_map[5].count, 1);
+  EXPECT_EQ(vert_poly_map[5].indices[0], 1);
+
+  const MeshElemMap *vert_edge_map = BKE_mesh_runtime_vert_edge_map_ensure(mesh);
+  EXPECT_EQ(vert_edge_map[1].count, 3);
+  EXPECT_EQ(vert_edge_map[3].count, 2);
+
+  const MeshElemMap *edge_poly_map = BKE_mesh_runtime_edge_poly_map_ensure(mesh);
+  EXPECT_EQ(edge_poly_map[1].count, 2);
+  EXPECT_EQ(edge_poly_map[4].count, 1);
+
+  const int *loop_poly_map = BKE_mesh_runtime_loop_poly_map_ensure(mesh);
+  EXPECT_EQ(loop_poly_map[3], 0);
+  EXPECT_EQ(loop_poly_map[4], 1);
+
+  /* Maps are recomputed after the topology changed. */
+  mesh->mloop[7].v = 3;
+  BKE_mesh_runtime_clear_geometry(mesh);
+  vert_poly_map = BKE_mesh_runtime_vert_poly_map_ensure(mesh);
+  EXPECT_EQ(vert_poly_map[2].count, 1);
+  EXPECT_EQ(vert_poly_map[3].count, 2);
+
+  BKE_id_free(nullptr, mesh);
+}
+
+}  // namespace blender::bke::tests
@@ -194,6 +194,9 @@ static void ntree_copy_data(Main *UNUSED(bmain), ID *id_dst, const ID *id_src, c
     ntree_dst->previews = nullptr;
   }
 
+  /* Execution statistics are only valid for the executed tree. */
+  ntree_dst->execution_stats = nullptr;
+
   /* update node->parent pointers */
   LISTBASE_FOREACH (bNode *, new_node, &ntree_dst->nodes) {
     if (new_node->parent) {
@@ -264,6 +267,7 @@ static void ntree_free_data(ID *id)
   if (ntree->previews) {
     BKE_node_instance_hash_free(ntree->previews, (bNodeInstanceValueFP)BKE_node_preview_free);
   }
+  BKE_node_execution_stats_clear(ntree);
 
   if (ntree->id.tag & LIB_TAG_LOCALIZED) {
     BKE_libblock_free_data(&ntree->id, true);
@@ -811,6 +815,7 @@ void ntreeBlendReadData(BlendDataReader *reader, bNodeTree *ntree)
 
   /* TODO: should be dealt by new generic cache handling of IDs... */
   ntree->previews = nullptr;
+  ntree->execution_stats = nullptr;
 
   BLO_read_data_address(reader, &ntree->preview);
   BKE_previewimg_blend_read(reader, ntree->preview);
@@ -2872,6 +2877,81 @@ void BKE_node_preview_merge_tree(bNodeTree *to_ntree, bNodeTree *from_ntree, boo
   }
 }
 
+bNodeExecutionStats *BKE_node_execution_stats_ensure(bNodeTree *ntree, bNodeInstanceKey key)
+{
+  if (!ntree->execution_stats) {
+    ntree->execution_stats = BKE_node_instance_hash_new("node execution stats");
+  }
+  bNodeExecutionStats *stats = (bNodeExecutionStats *)BKE_node_instance_hash_lookup(
+      ntree->execution_stats, key);
+  if (!stats) {
+    stats = MEM_cnew<bNodeExecutionStats>(__func__);
+    BKE_node_instance_hash_insert(ntree->execution_stats, key, stats);
+  }
+  return stats;
+}
+
+const bNodeExecutionStats *BKE_node_execution_stats_get(const bNodeTree *ntree,
+                                                        bNodeInstanceKey key)
+{
+  if (!ntree->execution_stats) {
+    return nullptr;
+  }
+  return (const bNodeExecutionStats *)BKE_node_instance_hash_lookup(ntree->execution_stats, key);
+}
+
+static void node_execution_stats_free(void *stats)
+{
+  MEM_freeN(stats);
+}
+
+void BKE_node_execution_stats_clear(bNodeTree *ntree)
+{
+  if (ntree->execution_stats) {
+    BKE_node_instance_hash_free(ntree->execution_stats, node_execution_stats_free);
+    ntree->execution_stats = nullptr;
+  }
+}
+
+/* Returns the sum of the statistics of the nodes of given tree instance. */
+static bNodeExecutionStats node_execution_stats_accumulate_recursive(bNodeTree *base_ntree,
+                                                                     bNodeTree *ntree,
+                                                                     bNodeInstanceKey parent_key)
+{
+  bNodeExecutionStats sum = {0};
+  LISTBASE_FOREACH (bNode *, node, &ntree->nodes) {
+    bNodeInstanceKey key = BKE_node_instance_key(parent_key, ntree, node);
+    if (ELEM(node->type, NODE_GROUP, NODE_CUSTOM_GROUP) && node->id) {
+      bNodeExecutionStats group_sum = node_execution_stats_accumulate_recursive(
+          base_ntree, (bNodeTree *)node->id, key);
+      if (group_sum.time_us > 0 || group_sum.mem_size > 0) {
+        *BKE_node_execution_stats_ensure(base_ntree, key) = group_sum;
+      }
+      sum.time_us += group_sum.time_us;
+      sum.mem_size += group_sum.mem_size;
+    }
+    else if (const bNodeExecutionStats *stats = BKE_node_execution_stats_get(base_ntree, key)) {
+      sum.time_us += stats->time_us;
+      sum.mem_size += stats->mem_size;
+    }
+  }
+  return sum;
+}
+
+void BKE_node_execution_stats_accumulate_groups(bNodeTree *ntree)
+{
+  if (ntree->execution_stats) {
+    node_execution_stats_accumulate_recursive(ntree, ntree, NODE_INSTANCE_KEY_BASE);
+  }
+}
+
+void BKE_node_execution_stats_merge_tree(bNodeTree *to_ntree, bNodeTree *from_ntree)
+{
+  BKE_node_execution_stats_clear(to_ntree);
+  to_ntree->execution_stats = from_ntree->execution_stats;
+  from_ntree->execution_stats = nullptr;
+}
+
 /* ************** Free stuff ********** */
 
 void nodeUnlinkNode(bNodeTree *ntree, bNode *node)
@@ -98,7 +98,7 @@ void BKE_object_eval_parent(Depsgraph *depsgraph, Object *ob)
 
 void BKE_object_eval_constraints(Depsgraph *depsgraph, Scene *scene, Object *ob)
 {
-  bConstraintOb *cob;
+  bConstraintOb cob;
   float ctime = BKE_scene_ctime_get(scene);
 
   DEG_debug_print_eval(depsgraph, __func__, ob->id.name, ob);
@@ -112,9 +112,9 @@ void BKE_object_eval_constraints(Depsgraph *depsgraph, Scene *scene, Object *ob)
    * Not sure why, this is from Joshua - sergey
    *
    */
-  cob = BKE_constraints_make_evalob(depsgraph, scene, ob, NULL, CONSTRAINT_OBTYPE_OBJECT);
-  BKE_constraints_solve(depsgraph, &ob->constraints, cob, ctime);
-  BKE_constraints_clear_evalob(cob);
+  BKE_constraints_init_evalob(&cob, depsgraph, scene, ob, NULL, CONSTRAINT_OBTYPE_OBJECT);
+  BKE_constraints_solve(depsgraph, &ob->constraints, &cob, ctime);
+  BKE_constraints_flush_evalob(&cob);
 }
 
 void BKE_object_eval_transform_final(Depsgraph *depsgraph, Object *ob)
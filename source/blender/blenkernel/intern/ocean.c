@@ -411,18 +411,20 @@ static void ocean_compute_htilda(void *__restrict userdata,
   const Ocean *o = osd->o;
   const float scale = osd->scale;
   const float t = osd->t;
+  const float chop_amount = osd->chop_amount;
 
   int j;
 
   /* Note the <= _N/2 here, see the FFTW documentation
    * about the mechanics of the complex->real fft storage. */
   for (j = 0; j <= o->_N / 2; j++) {
+    const int index = i * (1 + o->_N / 2) + j;
     fftw_complex exp_param1;
     fftw_complex exp_param2;
     fftw_complex conj_param;
 
-    init_complex(exp_param1, 0.0, omega(o->_k[i * (1 + o->_N / 2) + j], o->_depth) * t);
-    init_complex(exp_param2, 0.0, -omega(o->_k[i * (1 + o->_N / 2) + j], o->_depth) * t);
+    init_complex(exp_param1, 0.0, omega(o->_k[index], o->_depth) * t);
+    init_complex(exp_param2, 0.0, -omega(o->_k[index], o->_depth) * t);
     exp_complex(exp_param1, exp_param1);
     exp_complex(exp_param2, exp_param2);
     conj_complex(conj_param, o->_h0_minus[i * o->_N + j]);
@@ -430,8 +432,76 @@ static void ocean_compute_htilda(void *__restrict userdata,
     mul_complex_c(exp_param1, o->_h0[i * o->_N + j], exp_param1);
     mul_complex_c(exp_param2, conj_param, exp_param2);
 
-    add_comlex_c(o->_htilda[i * (1 + o->_N / 2) + j], exp_param1, exp_param2);
-    mul_complex_f(o->_fft_in[i * (1 + o->_N / 2) + j], o->_htilda[i * (1 + o->_N / 2) + j], scale);
+    add_comlex_c(o->_htilda[index], exp_param1, exp_param2);
+    mul_complex_f(o->_fft_in[index], o->_htilda[index], scale);
+
+    /* The inputs of all other transforms only depend on htilda of the same element,
+     * fill them here while it is in cache, so only the transforms remain single threaded. */
+    if (o->_do_chop) {
+      fftw_complex mul_param;
+      fftw_complex minus_i;
+
+      init_complex(minus_i, 0.0, -1.0);
+      init_complex(mul_param, -scale, 0);
+      mul_complex_f(mul_param, mul_param, chop_amount);
+      mul_complex_c(mul_param, mul_param, minus_i);
+      mul_complex_c(mul_param, mul_param, o->_htilda[index]);
+      mul_complex_f(mul_param,
+                    mul_param,
+                    ((o->_k[index] == 0.0f) ? 0.0f : o->_kx[i] / o->_k[index]));
+      init_complex(o->_fft_in_x[index], real_c(mul_param), image_c(mul_param));
+
+      init_complex(mul_param, -scale, 0);
+      mul_complex_f(mul_param, mul_param, chop_amount);
+      mul_complex_c(mul_param, mul_param, minus_i);
+      mul_complex_c(mul_param, mul_param, o->_htilda[index]);
+      mul_complex_f(mul_param,
+                    mul_param,
+                    ((o->_k[index] == 0.0f) ? 0.0f : o->_kz[j] / o->_k[index]));
+      init_complex(o->_fft_in_z[index], real_c(mul_param), image_c(mul_param));
+    }
+
+    if (o->_do_jacobian) {
+      fftw_complex mul_param;
+
+      init_complex(mul_param, -1, 0);
+      mul_complex_f(mul_param, mul_param, chop_amount);
+      mul_complex_c(mul_param, mul_param, o->_htilda[index]);
+      mul_complex_f(mul_param,
+                    mul_param,
+                    ((o->_k[index] == 0.0f) ? 0.0f : o->_kx[i] * o->_kx[i] / o->_k[index]));
+      init_complex(o->_fft_in_jxx[index], real_c(mul_param), image_c(mul_param));
+
+      init_complex(mul_param, -1, 0);
+      mul_complex_f(mul_param, mul_param, chop_amount);
+      mul_complex_c(mul_param, mul_param, o->_htilda[index]);
+      mul_complex_f(mul_param,
+                    mul_param,
+                    ((o->_k[index] == 0.0f) ? 0.0f : o->_kz[j] * o->_kz[j] / o->_k[index]));
+      init_complex(o->_fft_in_jzz[index], real_c(mul_param), image_c(mul_param));
+
+      init_complex(mul_param, -1, 0);
+      mul_complex_f(mul_param, mul_param, chop_amount);
+      mul_complex_c(mul_param, mul_param, o->_htilda[index]);
+      mul_complex_f(mul_param,
+                    mul_param,
+                    ((o->_k[index] == 0.0f) ? 0.0f : o->_kx[i] * o->_kz[j] / o->_k[index]));
+      init_complex(o->_fft_in_jxz[index], real_c(mul_param), image_c(mul_param));
+    }
+
+    if (o->_do_normals) {
+      fftw_complex mul_param;
+
+      init_complex(mul_param, 0.0, -1.0);
+      mul_complex_c(mul_param, mul_param, o->_htilda[index]);
+      mul_complex_f(mul_param, mul_param, o->_kx[i]);
+      init_complex(o->_fft_in_nx[index], real_c(mul_param), image_c(mul_param));
+
+      init_complex(mul_param, 0.0, -1.0);
+      mul_complex_c(mul_param, mul_param, o->_htilda[index]);
+      mul_complex_f(mul_param, mul_param, o->_kz[i]);
+      init_complex(o->_fft_in_nz[index], real_c(mul_param), image_c(mul_param));
+    }
   }
 }
 
@@ -447,28 +517,7 @@ static void ocean_compute_displacement_x(TaskPool *__restrict pool, void *UNUSED
 {
   OceanSimulateData *osd = BLI_task_pool_user_data(pool);
   const Ocean *o = osd->o;
-  const float scale = osd->scale;
-  const float chop_amount = osd->chop_amount;
-  int i, j;
 
-  for (i = 0; i < o->_M; i++) {
-    for (j = 0; j <= o->_N / 2; j++) {
-      fftw_complex mul_param;
-      fftw_complex minus_i;
-
-      init_complex(minus_i, 0.0, -1.0);
-      init_complex(mul_param, -scale, 0);
-      mul_complex_f(mul_param, mul_param, chop_amount);
-      mul_complex_c(mul_param, mul_param, minus_i);
-      mul_complex_c(mul_param, mul_param, o->_htilda[i * (1 + o->_N / 2) + j]);
-      mul_complex_f(mul_param,
-                    mul_param,
-                    ((o->_k[i * (1 + o->_N / 2) + j] == 0.0f) ?
-                         0.0f :
-                         o->_kx[i] / o->_k[i * (1 + o->_N / 2) + j]));
-      init_complex(o->_fft_in_x[i * (1 + o->_N / 2) + j], real_c(mul_param), image_c(mul_param));
-    }
-  }
   fftw_execute(o->_disp_x_plan);
 }
 
@@ -476,28 +525,7 @@ static void ocean_compute_displacement_z(TaskPool *__restrict pool, void *UNUSED
 {
   OceanSimulateData *osd = BLI_task_pool_user_data(pool);
   const Ocean *o = osd->o;
-  const float scale = osd->scale;
-  const float chop_amount = osd->chop_amount;
-  int i, j;
-
-  for (i = 0; i < o->_M; i++) {
-    for (j = 0; j <= o->_N / 2; j++) {
-      fftw_complex mul_param;
-      fftw_complex minus_i;
 
-      init_complex(minus_i, 0.0, -1.0);
-      init_complex(mul_param, -scale, 0);
-      mul_complex_f(mul_param, mul_param, chop_amount);
-      mul_complex_c(mul_param, mul_param, minus_i);
-      mul_complex_c(mul_param, mul_param, o->_htilda[i * (1 + o->_N / 2) + j]);
-      mul_complex_f(mul_param,
-                    mul_param,
-                    ((o->_k[i * (1 + o->_N / 2) + j] == 0.0f) ?
-                         0.0f :
-                         o->_kz[j] / o->_k[i * (1 + o->_N / 2) + j]));
-      init_complex(o->_fft_in_z[i * (1 + o->_N / 2) + j], real_c(mul_param), image_c(mul_param));
-    }
-  }
   fftw_execute(o->_disp_z_plan);
 }
 
@@ -505,26 +533,8 @@ static void ocean_compute_jacobian_jxx(TaskPool *__restrict pool, void *UNUSED(t
 {
   OceanSimulateData *osd = BLI_task_pool_user_data(pool);
   const Ocean *o = osd->o;
-  const float chop_amount = osd->chop_amount;
   int i, j;
 
-  for (i = 0; i < o->_M; i++) {
-    for (j = 0; j <= o->_N / 2; j++) {
-      fftw_complex mul_param;
-
-      // init_complex(mul_param, -scale, 0);
-      init_complex(mul_param, -1, 0);
-
-      mul_complex_f(mul_param, mul_param, chop_amount);
-      mul_complex_c(mul_param, mul_param, o->_htilda[i * (1 + o->_N / 2) + j]);
-      mul_complex_f(mul_param,
-                    mul_param,
-                    ((o->_k[i * (1 + o->_N / 2) + j] == 0.0f) ?
-                         0.0f :
-                         o->_kx[i] * o->_kx[i] / o->_k[i * (1 + o->_N / 2) + j]));
-      init_complex(o->_fft_in_jxx[i * (1 + o->_N / 2) + j], real_c(mul_param), image_c(mul_param));
-    }
-  }
   fftw_execute(o->_Jxx_plan);
 
   for (i = 0; i < o->_M; i++) {
@@ -538,26 +548,8 @@ static void ocean_compute_jacobian_jzz(TaskPool *__restrict pool, void *UNUSED(t
 {
   OceanSimulateData *osd = BLI_task_pool_user_data(pool);
   const Ocean *o = osd->o;
-  const float chop_amount = osd->chop_amount;
   int i, j;
 
-  for (i = 0; i < o->_M; i++) {
-    for (j = 0; j <= o->_N / 2; j++) {
-      fftw_complex mul_param;
-
-      // init_complex(mul_param, -scale, 0);
-      init_complex(mul_param, -1, 0);
-
-      mul_complex_f(mul_param, mul_param, chop_amount);
-      mul_complex_c(mul_param, mul_param, o->_htilda[i * (1 + o->_N / 2) + j]);
-      mul_complex_f(mul_param,
-                    mul_param,
-                    ((o->_k[i * (1 + o->_N / 2) + j] == 0.0f) ?
-                         0.0f :
-                         o->_kz[j] * o->_kz[j] / o->_k[i * (1 + o->_N / 2) + j]));
-      init_complex(o->_fft_in_jzz[i * (1 + o->_N / 2) + j], real_c(mul_param), image_c(mul_param));
-    }
-  }
   fftw_execute(o->_Jzz_plan);
 
   for (i = 0; i < o->_M; i++) {
@@ -571,26 +563,7 @@ static void ocean_compute_jacobian_jxz(TaskPool *__restrict pool, void *UNUSED(t
 {
   OceanSimulateData *osd = BLI_task_pool_user_data(pool);
   const Ocean *o = osd->o;
-  const float chop_amount = osd->chop_amount;
-  int i, j;
 
-  for (i = 0; i < o->_M; i++) {
-    for (j = 0; j <= o->_N / 2; j++) {
-      fftw_complex mul_param;
-
-      // init_complex(mul_param, -scale, 0);
-      init_complex(mul_param, -1, 0);
-
-      mul_complex_f(mul_param, mul_param, chop_amount);
-      mul_complex_c(mul_param, mul_param, o->_htilda[i * (1 + o->_N / 2) + j]);
-      mul_complex_f(mul_param,
-                    mul_param,
-                    ((o->_k[i * (1 + o->_N / 2) + j] == 0.0f) ?
-                         0.0f :
-                         o->_kx[i] * o->_kz[j] / o->_k[i * (1 + o->_N / 2) + j]));
-      init_complex(o->_fft_in_jxz[i * (1 + o->_N / 2) + j], real_c(mul_param), image_c(mul_param));
-    }
-  }
   fftw_execute(o->_Jxz_plan);
 }
 
@@ -598,18 +571,7 @@ static void ocean_compute_normal_x(TaskPool *__restrict pool, void *UNUSED(taskd
 {
   OceanSimulateData *osd = BLI_task_pool_user_data(pool);
   const Ocean *o = osd->o;
-  int i, j;
 
-  for (i = 0; i < o->_M; i++) {
-    for (j = 0; j <= o->_N / 2; j++) {
-      fftw_complex mul_param;
-
-      init_complex(mul_param, 0.0, -1.0);
-      mul_complex_c(mul_param, mul_param, o->_htilda[i * (1 + o->_N / 2) + j]);
-      mul_complex_f(mul_param, mul_param, o->_kx[i]);
-      init_complex(o->_fft_in_nx[i * (1 + o->_N / 2) + j], real_c(mul_param), image_c(mul_param));
-    }
-  }
   fftw_execute(o->_N_x_plan);
 }
 
@@ -617,18 +579,7 @@ static void ocean_compute_normal_z(TaskPool *__restrict pool, void *UNUSED(taskd
 {
   OceanSimulateData *osd = BLI_task_pool_user_data(pool);
   const Ocean *o = osd->o;
-  int i, j;
 
-  for (i = 0; i < o->_M; i++) {
-    for (j = 0; j <= o->_N / 2; j++) {
-      fftw_complex mul_param;
-
-      init_complex(mul_param, 0.0, -1.0);
-      mul_complex_c(mul_param, mul_param, o->_htilda[i * (1 + o->_N / 2) + j]);
-      mul_complex_f(mul_param, mul_param, o->_kz[i]);
-      init_complex(o->_fft_in_nz[i * (1 + o->_N / 2) + j], real_c(mul_param), image_c(mul_param));
-    }
-  }
   fftw_execute(o->_N_z_plan);
 }
 
@@ -656,12 +607,10 @@ void BKE_ocean_simulate(struct Ocean *o, float t, float scale, float chop_amount
 
   /* Note about multi-threading here: we have to run a first set of computations (htilda one)
    * before we can run all others, since they all depend on it.
-   * So we make a first parallelized forloop run for htilda,
-   * and then pack all other computations into a set of parallel tasks.
-   * This is not optimal in all cases,
-   * but remains reasonably simple and should be OK most of the time. */
+   * So we make a first parallelized forloop run for htilda, which also fills the inputs of
+   * every transform, and then run the transforms themselves as a set of parallel tasks. */
 
-  /* compute a new htilda */
+  /* compute a new htilda and the transform inputs */
   TaskParallelSettings settings;
   BLI_parallel_range_settings_defaults(&settings);
   settings.use_threading = (o->_M > 16);
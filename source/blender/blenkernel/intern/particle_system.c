@@ -30,6 +30,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_edgehash.h"
+#include "BLI_hash.h"
 #include "BLI_kdopbvh.h"
 #include "BLI_kdtree.h"
 #include "BLI_linklist.h"
@@ -3807,6 +3808,56 @@ static void dynamics_step_sph_classical_integrate_task_cb_ex(void *__restrict us
 }
 
 /* unbaked particles are calculated dynamically */
+typedef struct DynamicStepNewtonianTLS {
+  /* Copy of the simulation data with a random generator per thread. */
+  ParticleSimulationData sim;
+} DynamicStepNewtonianTLS;
+
+static void dynamics_step_newtonian_task_cb_ex(void *__restrict userdata,
+                                               const int p,
+                                               const TaskParallelTLS *__restrict tls)
+{
+  DynamicStepSolverTaskData *data = userdata;
+  DynamicStepNewtonianTLS *tls_data = tls->userdata_chunk;
+  ParticleSimulationData *sim = &tls_data->sim;
+  ParticleSystem *psys = sim->psys;
+  ParticleSettings *part = psys->part;
+
+  ParticleData *pa;
+
+  if ((pa = psys->particles + p)->state.time <= 0.0f) {
+    return;
+  }
+
+  /* Seed per particle, so that random forces and collisions don't depend on the order in which
+   * the particles are processed. */
+  if (sim->rng == NULL) {
+    sim->rng = BLI_rng_new(0);
+  }
+  BLI_rng_seed(sim->rng, BLI_hash_int_2d((uint)p, 31415926 + (uint)data->cfra + psys->seed));
+
+  /* do global forces & effectors */
+  basic_integrate(sim, p, pa->state.time, data->cfra);
+
+  /* deflection */
+  if (sim->colliders) {
+    collision_check(sim, p, pa->state.time, data->cfra);
+  }
+
+  /* rotations */
+  basic_rotate(part, pa, pa->state.time, data->timestep);
+}
+
+static void dynamics_step_newtonian_free(const void *__restrict UNUSED(userdata),
+                                         void *__restrict chunk)
+{
+  DynamicStepNewtonianTLS *tls_data = chunk;
+  if (tls_data->sim.rng) {
+    BLI_rng_free(tls_data->sim.rng);
+    tls_data->sim.rng = NULL;
+  }
+}
+
 static void dynamics_step(ParticleSimulationData *sim, float cfra)
 {
   ParticleSystem *psys = sim->psys;
@@ -3934,19 +3985,26 @@ static void dynamics_step(ParticleSimulationData *sim, float cfra)
 
   switch (part->phystype) {
     case PART_PHYS_NEWTON: {
-      LOOP_DYNAMIC_PARTICLES
-      {
-        /* do global forces & effectors */
-        basic_integrate(sim, p, pa->state.time, cfra);
-
-        /* deflection */
-        if (sim->colliders) {
-          collision_check(sim, p, pa->state.time, cfra);
-        }
-
-        /* rotations */
-        basic_rotate(part, pa, pa->state.time, timestep);
-      }
+      DynamicStepSolverTaskData task_data = {
+          .sim = sim,
+          .cfra = cfra,
+          .timestep = timestep,
+          .dtime = dtime,
+      };
+      DynamicStepNewtonianTLS tls_data = {
+          .sim = *sim,
+      };
+      tls_data.sim.rng = NULL;
+
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.use_threading = (psys->totpart > 100);
+      settings.min_iter_per_thread = 64;
+      settings.userdata_chunk = &tls_data;
+      settings.userdata_chunk_size = sizeof(tls_data);
+      settings.func_free = dynamics_step_newtonian_free;
+      BLI_task_parallel_range(
+          0, psys->totpart, &task_data, dynamics_step_newtonian_task_cb_ex, &settings);
       break;
     }
     case PART_PHYS_BOIDS: {
@@ -1326,10 +1326,36 @@ static void pbvh_update_draw_buffer_cb(void *__restrict userdata,
         break;
     }
   }
+  else if ((node->flag & PBVH_UpdateMaskDrawBuffers) && node->draw_buffers) {
+    const int update_flags = pbvh_get_buffers_update_flags(pbvh);
+    switch (pbvh->type) {
+      case PBVH_FACES:
+        GPU_pbvh_mesh_buffers_update_mask(node->draw_buffers,
+                                          pbvh->verts,
+                                          CustomData_get_layer(pbvh->vdata, CD_PAINT_MASK),
+                                          CustomData_get_layer(pbvh->pdata, CD_SCULPT_FACE_SETS),
+                                          update_flags);
+        break;
+      case PBVH_GRIDS:
+      case PBVH_BMESH:
+        /* Promoted to a full update in #pbvh_update_draw_buffers. */
+        BLI_assert_unreachable();
+        break;
+    }
+  }
 }
 
 static void pbvh_update_draw_buffers(PBVH *pbvh, PBVHNode **nodes, int totnode, int update_flag)
 {
+  if (pbvh->type != PBVH_FACES && (update_flag & PBVH_UpdateMaskDrawBuffers)) {
+    /* Only mesh buffers store the mask separately from the other attributes. */
+    for (int n = 0; n < totnode; n++) {
+      if (nodes[n]->flag & PBVH_UpdateMaskDrawBuffers) {
+        nodes[n]->flag |= PBVH_UpdateDrawBuffers;
+      }
+    }
+  }
+
   if ((update_flag & PBVH_RebuildDrawBuffers) || ELEM(pbvh->type, PBVH_GRIDS, PBVH_BMESH)) {
     /* Free buffers uses OpenGL, so not in parallel. */
     for (int n = 0; n < totnode; n++) {
@@ -1363,12 +1389,14 @@ static void pbvh_update_draw_buffers(PBVH *pbvh, PBVHNode **nodes, int totnode,
   for (int i = 0; i < totnode; i++) {
     PBVHNode *node = nodes[i];
 
-    if (node->flag & PBVH_UpdateDrawBuffers) {
+    if ((node->flag & (PBVH_UpdateDrawBuffers | PBVH_UpdateMaskDrawBuffers)) &&
+        node->draw_buffers) {
       /* Flush buffers uses OpenGL, so not in parallel. */
       GPU_pbvh_buffers_update_flush(node->draw_buffers);
     }
 
-    node->flag &= ~(PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers);
+    node->flag &= ~(PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers |
+                    PBVH_UpdateMaskDrawBuffers);
   }
 }
 
@@ -1734,7 +1762,7 @@ void BKE_pbvh_node_mark_update(PBVHNode *node)
 
 void BKE_pbvh_node_mark_update_mask(PBVHNode *node)
 {
-  node->flag |= PBVH_UpdateMask | PBVH_UpdateDrawBuffers | PBVH_UpdateRedraw;
+  node->flag |= PBVH_UpdateMask | PBVH_UpdateMaskDrawBuffers | PBVH_UpdateRedraw;
 }
 
 void BKE_pbvh_node_mark_update_color(PBVHNode *node)
@@ -2680,6 +2708,12 @@ void BKE_pbvh_face_sets_color_set(PBVH *pbvh, int seed, int color_default)
   pbvh->face_sets_color_default = color_default;
 }
 
+/**
+ * Draw buffers of nodes that weren't drawn for this number of redraws are freed, only keeping
+ * the nodes around the view in GPU memory. They are rebuilt when in view again.
+ */
+#define PBVH_DRAW_BUFFERS_UNUSED_REDRAWS 256
+
 /**
  * PBVH drawing, updating draw buffers as needed and culling any nodes outside
  * the specified frustum.
@@ -2700,6 +2734,30 @@ static bool pbvh_draw_search_cb(PBVHNode *node, void *data_v)
   return true;
 }
 
+static void pbvh_free_unused_draw_buffers(PBVH *pbvh)
+{
+  for (int i = 0; i < pbvh->totnode; i++) {
+    PBVHNode *node = &pbvh->nodes[i];
+    if (node->draw_buffers == NULL ||
+        pbvh->draw_gen - node->draw_gen < PBVH_DRAW_BUFFERS_UNUSED_REDRAWS) {
+      continue;
+    }
+
+    /* Free buffers uses OpenGL, so not in parallel. */
+    GPU_pbvh_buffers_free(node->draw_buffers);
+    node->draw_buffers = NULL;
+    /* Fully updated when rebuilt. */
+    node->flag &= ~(PBVH_UpdateDrawBuffers | PBVH_UpdateMaskDrawBuffers);
+  }
+}
+
+static void pbvh_rebuild_freed_draw_buffers_cb(PBVHNode *node, void *UNUSED(data))
+{
+  if (node->draw_buffers == NULL) {
+    node->flag |= PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers;
+  }
+}
+
 void BKE_pbvh_draw_cb(PBVH *pbvh,
                       bool update_only_visible,
                       PBVHFrustumPlanes *update_frustum,
@@ -2711,6 +2769,13 @@ void BKE_pbvh_draw_cb(PBVH *pbvh,
   int totnode;
   int update_flag = 0;
 
+  /* Rebuild draw buffers of nodes which were freed while out of view. */
+  BKE_pbvh_search_callback(pbvh,
+                           draw_frustum ? BKE_pbvh_node_frustum_contain_AABB : NULL,
+                           draw_frustum,
+                           pbvh_rebuild_freed_draw_buffers_cb,
+                           NULL);
+
   /* Search for nodes that need updates. */
   if (update_only_visible) {
     /* Get visible nodes with draw updates. */
@@ -2720,14 +2785,16 @@ void BKE_pbvh_draw_cb(PBVH *pbvh,
   }
   else {
     /* Get all nodes with draw updates, also those outside the view. */
-    const int search_flag = PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers;
+    const int search_flag = PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers |
+                            PBVH_UpdateMaskDrawBuffers;
     BKE_pbvh_search_gather(
         pbvh, update_search_cb, POINTER_FROM_INT(search_flag), &nodes, &totnode);
-    update_flag = PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers;
+    update_flag = search_flag;
   }
 
   /* Update draw buffers. */
-  if (totnode != 0 && (update_flag & (PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers))) {
+  if (totnode != 0 && (update_flag & (PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers |
+                                      PBVH_UpdateMaskDrawBuffers))) {
     pbvh_update_draw_buffers(pbvh, nodes, totnode, update_flag);
   }
   MEM_SAFE_FREE(nodes);
@@ -2736,14 +2803,21 @@ void BKE_pbvh_draw_cb(PBVH *pbvh,
   PBVHDrawSearchData draw_data = {.frustum = draw_frustum, .accum_update_flag = 0};
   BKE_pbvh_search_gather(pbvh, pbvh_draw_search_cb, &draw_data, &nodes, &totnode);
 
+  pbvh->draw_gen++;
   for (int i = 0; i < totnode; i++) {
     PBVHNode *node = nodes[i];
     if (!(node->flag & PBVH_FullyHidden)) {
       draw_fn(user_data, node->draw_buffers);
     }
+    node->draw_gen = pbvh->draw_gen;
   }
 
   MEM_SAFE_FREE(nodes);
+
+  /* All nodes are kept up to date while painting. */
+  if (update_only_visible) {
+    pbvh_free_unused_draw_buffers(pbvh);
+  }
 }
 
 void BKE_pbvh_draw_debug_cb(
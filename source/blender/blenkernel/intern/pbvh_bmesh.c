@@ -47,6 +47,10 @@
 
 #ifdef USE_VERIFY
 static void pbvh_bmesh_verify(PBVH *pbvh);
+
+/* Sibling leaf nodes are joined when they have at most this number of faces together. Lower than
+ * the leaf limit, so that joined nodes don't get split again after a few more faces. */
+#define PBVH_BMESH_JOIN_LIMIT(pbvh) ((pbvh)->leaf_limit / 4)
 #endif
 
 /* -------------------------------------------------------------------- */
@@ -2072,6 +2076,144 @@ void BKE_pbvh_bmesh_node_save_orig(BMesh *bm, PBVHNode *node)
   node->bm_tot_ortri = i;
 }
 
+/* Clear a leaf node which faces were moved to its parent node. */
+static void pbvh_bmesh_node_clear_joined(PBVH *pbvh, PBVHNode *n)
+{
+  GSetIterator gs_iter;
+
+  /* Mark unique verts as unclaimed, they are claimed again by the parent node. */
+  GSET_ITER (gs_iter, n->bm_unique_verts) {
+    BMVert *v = BLI_gsetIterator_getKey(&gs_iter);
+    BM_ELEM_CD_SET_INT(v, pbvh->cd_vert_node_offset, DYNTOPO_NODE_NONE);
+  }
+
+  BLI_gset_free(n->bm_faces, NULL);
+  BLI_gset_free(n->bm_unique_verts, NULL);
+  BLI_gset_free(n->bm_other_verts, NULL);
+  MEM_SAFE_FREE(n->layer_disp);
+  MEM_SAFE_FREE(n->color_buffer.color);
+
+  if (n->draw_buffers) {
+    GPU_pbvh_buffers_free(n->draw_buffers);
+  }
+
+  memset(n, 0, sizeof(*n));
+}
+
+/**
+ * Join the two leaf children of given node into it, when they got too few elements together.
+ * The children are tagged as unused in \a r_unused_nodes.
+ */
+static bool pbvh_bmesh_node_join_children(PBVH *pbvh, int node_index, bool *r_unused_nodes)
+{
+  PBVHNode *n = &pbvh->nodes[node_index];
+  const int children = n->children_offset;
+  PBVHNode *c1 = &pbvh->nodes[children], *c2 = &pbvh->nodes[children + 1];
+
+  if (!(c1->flag & PBVH_Leaf) || !(c2->flag & PBVH_Leaf)) {
+    return false;
+  }
+
+  const int totface = BLI_gset_len(c1->bm_faces) + BLI_gset_len(c2->bm_faces);
+  /* Empty leaves are kept, the joined node would have no bounds. */
+  if (totface == 0 || totface > PBVH_BMESH_JOIN_LIMIT(pbvh)) {
+    return false;
+  }
+
+  n->bm_faces = BLI_gset_ptr_new_ex("bm_faces", totface);
+  GSetIterator gs_iter;
+  GSET_ITER (gs_iter, c1->bm_faces) {
+    BLI_gset_insert(n->bm_faces, BLI_gsetIterator_getKey(&gs_iter));
+  }
+  GSET_ITER (gs_iter, c2->bm_faces) {
+    BLI_gset_insert(n->bm_faces, BLI_gsetIterator_getKey(&gs_iter));
+  }
+
+  pbvh_bmesh_node_clear_joined(pbvh, c1);
+  pbvh_bmesh_node_clear_joined(pbvh, c2);
+  r_unused_nodes[children] = true;
+  r_unused_nodes[children + 1] = true;
+
+  n->flag |= PBVH_Leaf;
+  pbvh_bmesh_node_finalize(pbvh, node_index, pbvh->cd_vert_node_offset, pbvh->cd_face_node_offset);
+  return true;
+}
+
+/* Remove unused nodes from the nodes array, and update the node indices stored in elements. */
+static void pbvh_bmesh_nodes_compact(PBVH *pbvh, const bool *unused_nodes)
+{
+  int *node_map = MEM_malloc_arrayN(pbvh->totnode, sizeof(int), __func__);
+  int totnode = 0;
+  for (int i = 0; i < pbvh->totnode; i++) {
+    node_map[i] = unused_nodes[i] ? DYNTOPO_NODE_NONE : totnode++;
+  }
+
+  /* Children of used nodes are used, and are still stored next to each other. Nodes are only
+   * moved to lower indices so they can be moved in place. */
+  for (int i = 0; i < pbvh->totnode; i++) {
+    const int new_index = node_map[i];
+    if (new_index == DYNTOPO_NODE_NONE) {
+      continue;
+    }
+
+    PBVHNode *n = &pbvh->nodes[i];
+    if (!(n->flag & PBVH_Leaf)) {
+      n->children_offset = node_map[n->children_offset];
+    }
+    else if (new_index != i) {
+      GSetIterator gs_iter;
+      GSET_ITER (gs_iter, n->bm_faces) {
+        BMFace *f = BLI_gsetIterator_getKey(&gs_iter);
+        BM_ELEM_CD_SET_INT(f, pbvh->cd_face_node_offset, new_index);
+      }
+      GSET_ITER (gs_iter, n->bm_unique_verts) {
+        BMVert *v = BLI_gsetIterator_getKey(&gs_iter);
+        BM_ELEM_CD_SET_INT(v, pbvh->cd_vert_node_offset, new_index);
+      }
+    }
+
+    if (new_index != i) {
+      pbvh->nodes[new_index] = *n;
+    }
+  }
+
+  pbvh->totnode = totnode;
+  MEM_freeN(node_map);
+}
+
+/**
+ * Join leaf nodes that lost most of their elements with their sibling, so that leaf sizes stay
+ * balanced when the topology changes. Children are always stored after their parent, so nodes
+ * are visited in reverse order to join the tree bottom up.
+ */
+static void pbvh_bmesh_nodes_join_underfilled(PBVH *pbvh)
+{
+  bool *unused_nodes = NULL;
+
+  for (int i = pbvh->totnode - 1; i >= 0; i--) {
+    PBVHNode *n = &pbvh->nodes[i];
+    if ((n->flag & PBVH_Leaf) || (unused_nodes && unused_nodes[i])) {
+      continue;
+    }
+    if (unused_nodes == NULL) {
+      unused_nodes = MEM_calloc_arrayN(pbvh->totnode, sizeof(bool), __func__);
+    }
+    pbvh_bmesh_node_join_children(pbvh, i, unused_nodes);
+  }
+
+  if (unused_nodes == NULL) {
+    return;
+  }
+
+  for (int i = 0; i < pbvh->totnode; i++) {
+    if (unused_nodes[i]) {
+      pbvh_bmesh_nodes_compact(pbvh, unused_nodes);
+      break;
+    }
+  }
+  MEM_freeN(unused_nodes);
+}
+
 void BKE_pbvh_bmesh_after_stroke(PBVH *pbvh)
 {
   for (int i = 0; i < pbvh->totnode; i++) {
@@ -2079,7 +2221,16 @@ void BKE_pbvh_bmesh_after_stroke(PBVH *pbvh)
     if (n->flag & PBVH_Leaf) {
       /* Free orco/ortri data */
       pbvh_bmesh_node_drop_orig(n);
+    }
+  }
+
+  /* Join nodes that have gotten too few elements, before splitting the ones that have gotten too
+   * many, so that leaves created by splits are not joined back. */
+  pbvh_bmesh_nodes_join_underfilled(pbvh);
 
+  for (int i = 0; i < pbvh->totnode; i++) {
+    PBVHNode *n = &pbvh->nodes[i];
+    if (n->flag & PBVH_Leaf) {
       /* Recursively split nodes that have gotten too many
        * elements */
       pbvh_bmesh_node_limit_ensure(pbvh, i);
@@ -21,6 +21,8 @@ typedef struct {
 struct PBVHNode {
   /* Opaque handle for drawing code */
   struct GPU_PBVH_Buffers *draw_buffers;
+  /* Value of #PBVH.draw_gen when last drawn, to free draw buffers of unused nodes. */
+  int draw_gen;
 
   /* Voxel bounds */
   BB vb;
@@ -165,6 +167,9 @@ struct PBVH {
 
   struct BMLog *bm_log;
   struct SubdivCCG *subdiv_ccg;
+
+  /* Number of #BKE_pbvh_draw_cb calls. */
+  int draw_gen;
 };
 
 /* pbvh.c */
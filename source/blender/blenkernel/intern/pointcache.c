@@ -5,6 +5,7 @@
  * \ingroup bke
  */
 
+#include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -29,6 +30,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_endian_switch.h"
+#include "BLI_filereader.h"
 #include "BLI_math.h"
 #include "BLI_string.h"
 #include "BLI_utildefines.h"
@@ -76,6 +78,11 @@
 #  include "LzmaLib.h"
 #endif
 
+#include <zstd.h>
+
+/* Favor speed, simulation data compresses well enough once shuffled. */
+#define PTCACHE_ZSTD_LEVEL 3
+
 /* needed for directory lookup */
 #ifndef WIN32
 #  include <dirent.h>
@@ -132,11 +139,11 @@ static int ptcache_basic_header_read(PTCacheFile *pf)
   int error = 0;
 
   /* Custom functions should read these basic elements too! */
-  if (!error && !fread(&pf->totpoint, sizeof(unsigned int), 1, pf->fp)) {
+  if (!error && !ptcache_file_read(pf, &pf->totpoint, 1, sizeof(unsigned int))) {
     error = 1;
   }
 
-  if (!error && !fread(&pf->data_types, sizeof(unsigned int), 1, pf->fp)) {
+  if (!error && !ptcache_file_read(pf, &pf->data_types, 1, sizeof(unsigned int))) {
     error = 1;
   }
 
@@ -1433,6 +1440,23 @@ static int ptcache_filename(PTCacheID *pid, char *filename, int cfra, short do_p
   return len; /* make sure the above string is always 16 chars */
 }
 
+static FileReader *ptcache_file_reader_open(const char *filename)
+{
+  const int filedes = BLI_open(filename, O_BINARY | O_RDONLY, 0);
+  if (filedes == -1) {
+    return NULL;
+  }
+  FileReader *rawfile = BLI_filereader_new_file(filedes);
+  /* Cached playback reads many files, map them to memory to avoid copying them around. */
+  FileReader *mmap_file = BLI_filereader_new_mmap(filedes);
+  if (mmap_file == NULL) {
+    return rawfile;
+  }
+  /* Closes the file, the mapping remains valid. */
+  rawfile->close(rawfile);
+  return mmap_file;
+}
+
 /**
  * Caller must close after!
  */
@@ -1440,6 +1464,7 @@ static PTCacheFile *ptcache_file_open(PTCacheID *pid, int mode, int cfra)
 {
   PTCacheFile *pf;
   FILE *fp = NULL;
+  FileReader *reader = NULL;
   char filename[MAX_PTCACHE_FILE];
 
 #ifndef DURIAN_POINTCACHE_LIB_OK
@@ -1458,7 +1483,7 @@ static PTCacheFile *ptcache_file_open(PTCacheID *pid, int mode, int cfra)
   ptcache_filename(pid, filename, cfra, 1, 1);
 
   if (mode == PTCACHE_FILE_READ) {
-    fp = BLI_fopen(filename, "rb");
+    reader = ptcache_file_reader_open(filename);
   }
   else if (mode == PTCACHE_FILE_WRITE) {
     /* Will create the dir if needs be, same as "//textures" is created. */
@@ -1471,12 +1496,13 @@ static PTCacheFile *ptcache_file_open(PTCacheID *pid, int mode, int cfra)
     fp = BLI_fopen(filename, "rb+");
   }
 
-  if (!fp) {
+  if (!fp && !reader) {
     return NULL;
   }
 
   pf = MEM_mallocN(sizeof(PTCacheFile), "PTCacheFile");
   pf->fp = fp;
+  pf->reader = reader;
   pf->old_format = 0;
   pf->frame = cfra;
 
@@ -1485,11 +1511,67 @@ static PTCacheFile *ptcache_file_open(PTCacheID *pid, int mode, int cfra)
 static void ptcache_file_close(PTCacheFile *pf)
 {
   if (pf) {
-    fclose(pf->fp);
+    if (pf->reader) {
+      pf->reader->close(pf->reader);
+    }
+    else {
+      fclose(pf->fp);
+    }
     MEM_freeN(pf);
   }
 }
 
+/**
+ * Split the values of 4 bytes into planes of the bytes of same significance, so that e.g. the
+ * sign and exponent bytes of float coordinates end up next to each other. This makes simulation
+ * data much more compressible. Trailing bytes are kept as is.
+ */
+static void ptcache_bytes_shuffle(const unsigned char *src, unsigned char *dst, const size_t len)
+{
+  const size_t values_num = len / 4;
+  for (size_t i = 0; i < values_num; i++) {
+    for (int b = 0; b < 4; b++) {
+      dst[b * values_num + i] = src[i * 4 + b];
+    }
+  }
+  memcpy(dst + values_num * 4, src + values_num * 4, len - values_num * 4);
+}
+
+static void ptcache_bytes_unshuffle(const unsigned char *src, unsigned char *dst, const size_t len)
+{
+  const size_t values_num = len / 4;
+  for (size_t i = 0; i < values_num; i++) {
+    for (int b = 0; b < 4; b++) {
+      dst[i * 4 + b] = src[b * values_num + i];
+    }
+  }
+  memcpy(dst + values_num * 4, src + values_num * 4, len - values_num * 4);
+}
+
+/**
+ * Get \a len bytes at the current read position, and move past them.
+ *
+ * Memory-mapped files are accessed directly, otherwise the data is read into \a r_buffer, which
+ * has to be freed by the caller.
+ */
+static const unsigned char *ptcache_file_read_data(PTCacheFile *pf,
+                                                   const size_t len,
+                                                   unsigned char **r_buffer)
+{
+  *r_buffer = NULL;
+  if (pf->reader && pf->reader->data) {
+    const unsigned char *data = pf->reader->data(pf->reader, pf->reader->offset, len);
+    if (data != NULL) {
+      pf->reader->seek(pf->reader, (off64_t)len, SEEK_CUR);
+      return data;
+    }
+  }
+  *r_buffer = (unsigned char *)MEM_callocN(sizeof(unsigned char) * len,
+                                           "pointcache_compressed_buffer");
+  ptcache_file_read(pf, *r_buffer, len, sizeof(unsigned char));
+  return *r_buffer;
+}
+
 static int ptcache_file_compressed_read(PTCacheFile *pf, unsigned char *result, unsigned int len)
 {
   int r = 0;
@@ -1498,7 +1580,6 @@ static int ptcache_file_compressed_read(PTCacheFile *pf, unsigned char *result,
 #ifdef WITH_LZO
   size_t out_len = len;
 #endif
-  unsigned char *in;
   unsigned char *props = MEM_callocN(sizeof(char[16]), "tmp");
 
   ptcache_file_read(pf, &compressed, 1, sizeof(unsigned char));
@@ -1510,9 +1591,8 @@ static int ptcache_file_compressed_read(PTCacheFile *pf, unsigned char *result,
       /* do nothing */
     }
     else {
-      in = (unsigned char *)MEM_callocN(sizeof(unsigned char) * in_len,
-                                        "pointcache_compressed_buffer");
-      ptcache_file_read(pf, in, in_len, sizeof(unsigned char));
+      unsigned char *in_buffer;
+      const unsigned char *in = ptcache_file_read_data(pf, in_len, &in_buffer);
 #ifdef WITH_LZO
       if (compressed == 1) {
         r = lzo1x_decompress_safe(in, (lzo_uint)in_len, result, (lzo_uint *)&out_len, NULL);
@@ -1528,7 +1608,20 @@ static int ptcache_file_compressed_read(PTCacheFile *pf, unsigned char *result,
         r = LzmaUncompress(result, &leno, in, &leni, props, sizeOfIt);
       }
 #endif
-      MEM_freeN(in);
+      if (compressed == PTCACHE_COMPRESS_ZSTD) {
+        unsigned char *shuffled = MEM_mallocN(len, "pointcache_zstd_buffer");
+        const size_t out_len = ZSTD_decompress(shuffled, len, in, in_len);
+        if (!ZSTD_isError(out_len) && out_len == len) {
+          ptcache_bytes_unshuffle(shuffled, result, len);
+        }
+        else {
+          r = -1;
+        }
+        MEM_freeN(shuffled);
+      }
+      if (in_buffer) {
+        MEM_freeN(in_buffer);
+      }
     }
   }
   else {
@@ -1552,7 +1645,7 @@ static int ptcache_file_compressed_write(
 
 #ifdef WITH_LZO
   out_len = LZO_OUT_LEN(in_len);
-  if (mode == 1) {
+  if (mode == PTCACHE_COMPRESS_LZO) {
     LZO_HEAP_ALLOC(wrkmem, LZO1X_MEM_COMPRESS);
 
     r = lzo1x_1_compress(in, (lzo_uint)in_len, out, (lzo_uint *)&out_len, wrkmem);
@@ -1565,7 +1658,7 @@ static int ptcache_file_compressed_write(
   }
 #endif
 #ifdef WITH_LZMA
-  if (mode == 2) {
+  if (mode == PTCACHE_COMPRESS_LZMA) {
 
     r = LzmaCompress(out,
                      &out_len,
@@ -1589,6 +1682,20 @@ static int ptcache_file_compressed_write(
     }
   }
 #endif
+  if (mode == PTCACHE_COMPRESS_ZSTD) {
+    unsigned char *shuffled = MEM_mallocN(in_len, "pointcache_zstd_buffer");
+    ptcache_bytes_shuffle(in, shuffled, in_len);
+    /* The output buffer can at least hold #LZO_OUT_LEN bytes, more than what zstd needs. */
+    out_len = ZSTD_compress(out, LZO_OUT_LEN(in_len), shuffled, in_len, PTCACHE_ZSTD_LEVEL);
+    MEM_freeN(shuffled);
+
+    if (ZSTD_isError(out_len) || (out_len >= in_len)) {
+      compressed = 0;
+    }
+    else {
+      compressed = PTCACHE_COMPRESS_ZSTD;
+    }
+  }
 
   ptcache_file_write(pf, &compressed, 1, sizeof(unsigned char));
   if (compressed) {
@@ -1612,6 +1719,10 @@ static int ptcache_file_compressed_write(
 }
 static int ptcache_file_read(PTCacheFile *pf, void *f, unsigned int tot, unsigned int size)
 {
+  if (pf->reader) {
+    const size_t len = (size_t)size * tot;
+    return (pf->reader->read(pf->reader, f, len) == (ssize_t)len);
+  }
   return (fread(f, size, tot, pf->fp) == tot);
 }
 static int ptcache_file_write(PTCacheFile *pf, const void *f, unsigned int tot, unsigned int size)
@@ -1652,7 +1763,7 @@ static int ptcache_file_header_begin_read(PTCacheFile *pf)
 
   pf->data_types = 0;
 
-  if (fread(bphysics, sizeof(char), 8, pf->fp) != 8) {
+  if (!ptcache_file_read(pf, bphysics, 8, sizeof(char))) {
     error = 1;
   }
 
@@ -1660,7 +1771,7 @@ static int ptcache_file_header_begin_read(PTCacheFile *pf)
     error = 1;
   }
 
-  if (!error && !fread(&typeflag, sizeof(unsigned int), 1, pf->fp)) {
+  if (!error && !ptcache_file_read(pf, &typeflag, 1, sizeof(unsigned int))) {
     error = 1;
   }
 
@@ -1669,7 +1780,12 @@ static int ptcache_file_header_begin_read(PTCacheFile *pf)
 
   /* if there was an error set file as it was */
   if (error) {
-    BLI_fseek(pf->fp, 0, SEEK_SET);
+    if (pf->reader) {
+      pf->reader->seek(pf->reader, 0, SEEK_SET);
+    }
+    else {
+      BLI_fseek(pf->fp, 0, SEEK_SET);
+    }
   }
 
   return !error;
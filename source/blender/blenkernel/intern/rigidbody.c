@@ -1661,8 +1661,17 @@ static void rigidbody_update_sim_world(Scene *scene, RigidBodyWorld *rbw)
   rigidbody_update_ob_array(rbw);
 }
 
-static void rigidbody_update_sim_ob(
-    Depsgraph *depsgraph, Scene *scene, RigidBodyWorld *rbw, Object *ob, RigidBodyOb *rbo)
+/**
+ * \param effectors: Effectors of the world, created once for all objects since the list only
+ * depends on the effector weights of the world. Objects that are an effector themselves are
+ * never affected, so there is no need to exclude them from the list.
+ */
+static void rigidbody_update_sim_ob(Depsgraph *depsgraph,
+                                    Scene *scene,
+                                    RigidBodyWorld *rbw,
+                                    ListBase *effectors,
+                                    Object *ob,
+                                    RigidBodyOb *rbo)
 {
   /* only update if rigid body exists */
   if (rbo->shared->physics_object == NULL) {
@@ -1719,10 +1728,7 @@ static void rigidbody_update_sim_ob(
            ((ob->pd == NULL) || (ob->pd->forcefield == PFIELD_NULL))) {
     EffectorWeights *effector_weights = rbw->effector_weights;
     EffectedPoint epoint;
-    ListBase *effectors;
 
-    /* get effectors present in the group specified by effector_weights */
-    effectors = BKE_effectors_create(depsgraph, ob, NULL, effector_weights, false);
     if (effectors) {
       float eff_force[3] = {0.0f, 0.0f, 0.0f};
       float eff_loc[3], eff_vel[3];
@@ -1735,6 +1741,9 @@ static void rigidbody_update_sim_ob(
 
       pd_point_from_loc(scene, eff_loc, eff_vel, 0, &epoint);
 
+      /* Same noise as effectors created for this object only. */
+      BKE_effectors_random_reset(effectors);
+
       /* Calculate net force of effectors, and apply to sim object:
        * - we use 'central force' since apply force requires a "relative position"
        *   which we don't have... */
@@ -1755,9 +1764,6 @@ static void rigidbody_update_sim_ob(
     else if (G.f & G_DEBUG) {
       printf("\tno forces to apply to '%s'\n", ob->id.name + 2);
     }
-
-    /* cleanup */
-    BKE_effectors_free(effectors);
   }
   /* NOTE: passive objects don't need to be updated since they don't move */
 
@@ -1805,6 +1811,9 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
     FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
   }
 
+  /* get effectors present in the group specified by effector_weights */
+  ListBase *effectors = BKE_effectors_create(depsgraph, NULL, NULL, rbw->effector_weights, false);
+
   /* update objects */
   FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (rbw->group, ob) {
     if (ob->type == OB_MESH) {
@@ -1830,12 +1839,10 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
         /* perform simulation data updates as tagged */
         /* refresh object... */
         if (rebuild) {
-          /* World has been rebuilt so rebuild object */
-          /* TODO(Sybren): rigidbody_validate_sim_object() can call rigidbody_validate_sim_shape(),
-           * but neither resets the RBO_FLAG_NEEDS_RESHAPE flag nor
-           * calls RB_body_set_collision_shape().
-           * This results in the collision shape being created twice, which is unnecessary. */
+          /* World has been rebuilt so rebuild object. This rebuilds the collision shape and
+           * creates the body with it, so there is no need to reshape it again below. */
           rigidbody_validate_sim_object(rbw, ob, true);
+          rbo->flag &= ~RBO_FLAG_NEEDS_RESHAPE;
         }
         else if (rbo->flag & RBO_FLAG_NEEDS_VALIDATE) {
           rigidbody_validate_sim_object(rbw, ob, false);
@@ -1855,11 +1862,13 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
       rbo->flag &= ~(RBO_FLAG_NEEDS_VALIDATE | RBO_FLAG_NEEDS_RESHAPE);
 
       /* update simulation object... */
-      rigidbody_update_sim_ob(depsgraph, scene, rbw, ob, rbo);
+      rigidbody_update_sim_ob(depsgraph, scene, rbw, effectors, ob, rbo);
     }
   }
   FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
 
+  BKE_effectors_free(effectors);
+
   /* update constraints */
   if (rbw->constraints == NULL) { /* no constraints, move on */
     return;
@@ -14,6 +14,7 @@
 #include "BLI_utildefines.h"
 
 #include "BKE_modifier.h"
+#include "BKE_subdiv_mesh.h"
 #include "BKE_subdiv_modifier.h"
 
 #include "MEM_guardedalloc.h"
@@ -175,6 +176,10 @@ Subdiv *BKE_subdiv_update_from_mesh(Subdiv *subdiv,
 
 void BKE_subdiv_free(Subdiv *subdiv)
 {
+  if (subdiv->cache_.mesh != NULL) {
+    BKE_subdiv_mesh_cache_free(subdiv->cache_.mesh);
+    subdiv->cache_.mesh = NULL;
+  }
   if (subdiv->evaluator != NULL) {
     const eOpenSubdivEvaluator evaluator_type = subdiv->evaluator->type;
     if (evaluator_type != OPENSUBDIV_EVALUATOR_CPU) {
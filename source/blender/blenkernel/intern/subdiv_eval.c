@@ -321,3 +321,14 @@ void BKE_subdiv_eval_final_point(
     BKE_subdiv_eval_limit_point(subdiv, ptex_face_index, u, v, r_P);
   }
 }
+
+/* ========================= Multiple points queries ======================== */
+
+void BKE_subdiv_eval_limit_points(Subdiv *subdiv,
+                                  const OpenSubdiv_PatchCoord *patch_coords,
+                                  const int num_points,
+                                  float (*r_P)[3])
+{
+  subdiv->evaluator->evaluatePatchesLimit(
+      subdiv->evaluator, patch_coords, num_points, &r_P[0][0], NULL, NULL);
+}
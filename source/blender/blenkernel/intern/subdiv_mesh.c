@@ -15,10 +15,13 @@
 #include "DNA_meshdata_types.h"
 
 #include "BLI_alloca.h"
+#include "BLI_math_base.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.h"
 
 #include "BKE_customdata.h"
 #include "BKE_key.h"
+#include "BKE_lib_id.h"
 #include "BKE_mesh.h"
 #include "BKE_subdiv.h"
 #include "BKE_subdiv_eval.h"
@@ -26,6 +29,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "opensubdiv_capi_type.h"
+
 /* -------------------------------------------------------------------- */
 /** \name Subdivision Context
  * \{ */
@@ -46,6 +51,10 @@ typedef struct SubdivMeshContext {
   /* Per-subdivided vertex counter of averaged values. */
   int *accumulated_counters;
   bool have_displacement;
+  /* Per-subdivided vertex limit surface coordinate, evaluated in batches once the whole topology
+   * is traversed. Only used without displacement, which needs derivatives of every vertex.
+   * Vertices which are not on the limit surface (loose geometry) have a negative ptex face. */
+  OpenSubdiv_PatchCoord *vertex_patch_coords;
 } SubdivMeshContext;
 
 static void subdiv_mesh_ctx_cache_uv_layers(SubdivMeshContext *ctx)
@@ -79,9 +88,22 @@ static void subdiv_mesh_prepare_accumulator(SubdivMeshContext *ctx, int num_vert
       num_vertices, sizeof(*ctx->accumulated_counters), "subdiv accumulated counters");
 }
 
+static void subdiv_mesh_prepare_patch_coords(SubdivMeshContext *ctx, int num_vertices)
+{
+  if (ctx->have_displacement) {
+    return;
+  }
+  ctx->vertex_patch_coords = MEM_malloc_arrayN(
+      num_vertices, sizeof(*ctx->vertex_patch_coords), "subdiv vertex patch coords");
+  for (int i = 0; i < num_vertices; i++) {
+    ctx->vertex_patch_coords[i].ptex_face = -1;
+  }
+}
+
 static void subdiv_mesh_context_free(SubdivMeshContext *ctx)
 {
   MEM_SAFE_FREE(ctx->accumulated_counters);
+  MEM_SAFE_FREE(ctx->vertex_patch_coords);
 }
 
 /** \} */
@@ -464,6 +486,7 @@ static bool subdiv_mesh_topology_info(const SubdivForeachContext *foreach_contex
       subdiv_context->coarse_mesh, num_vertices, num_edges, 0, num_loops, num_polygons, mask);
   subdiv_mesh_ctx_cache_custom_data_layers(subdiv_context);
   subdiv_mesh_prepare_accumulator(subdiv_context, num_vertices);
+  subdiv_mesh_prepare_patch_coords(subdiv_context, num_vertices);
   return true;
 }
 
@@ -505,6 +528,25 @@ static void subdiv_vertex_data_interpolate(const SubdivMeshContext *ctx,
   }
 }
 
+/* Evaluates the limit surface position of the vertex, or only stores its coordinate when the
+ * evaluation is batched, see #subdiv_mesh_eval_vertices. */
+static void subdiv_mesh_eval_limit_point(const SubdivMeshContext *ctx,
+                                         const int ptex_face_index,
+                                         const float u,
+                                         const float v,
+                                         MVert *subdiv_vert)
+{
+  if (ctx->vertex_patch_coords != NULL) {
+    OpenSubdiv_PatchCoord *patch_coord =
+        &ctx->vertex_patch_coords[subdiv_vert - ctx->subdiv_mesh->mvert];
+    patch_coord->ptex_face = ptex_face_index;
+    patch_coord->u = u;
+    patch_coord->v = v;
+    return;
+  }
+  BKE_subdiv_eval_final_point(ctx->subdiv, ptex_face_index, u, v, subdiv_vert->co);
+}
+
 static void evaluate_vertex_and_apply_displacement_copy(const SubdivMeshContext *ctx,
                                                         const int ptex_face_index,
                                                         const float u,
@@ -523,7 +565,12 @@ static void evaluate_vertex_and_apply_displacement_copy(const SubdivMeshContext
   }
   /* Copy custom data and evaluate position. */
   subdiv_vertex_data_copy(ctx, coarse_vert, subdiv_vert);
-  BKE_subdiv_eval_limit_point(ctx->subdiv, ptex_face_index, u, v, subdiv_vert->co);
+  if (ctx->have_displacement) {
+    BKE_subdiv_eval_limit_point(ctx->subdiv, ptex_face_index, u, v, subdiv_vert->co);
+  }
+  else {
+    subdiv_mesh_eval_limit_point(ctx, ptex_face_index, u, v, subdiv_vert);
+  }
   /* Apply displacement. */
   add_v3_v3(subdiv_vert->co, D);
   /* Remove facedot flag. This can happen if there is more than one subsurf modifier. */
@@ -549,7 +596,12 @@ static void evaluate_vertex_and_apply_displacement_interpolate(
   }
   /* Interpolate custom data and evaluate position. */
   subdiv_vertex_data_interpolate(ctx, subdiv_vert, vertex_interpolation, u, v);
-  BKE_subdiv_eval_limit_point(ctx->subdiv, ptex_face_index, u, v, subdiv_vert->co);
+  if (ctx->have_displacement) {
+    BKE_subdiv_eval_limit_point(ctx->subdiv, ptex_face_index, u, v, subdiv_vert->co);
+  }
+  else {
+    subdiv_mesh_eval_limit_point(ctx, ptex_face_index, u, v, subdiv_vert);
+  }
   /* Apply displacement. */
   add_v3_v3(subdiv_vert->co, D);
 }
@@ -707,7 +759,6 @@ static void subdiv_mesh_vertex_inner(const SubdivForeachContext *foreach_context
 {
   SubdivMeshContext *ctx = foreach_context->user_data;
   SubdivMeshTLS *tls = tls_v;
-  Subdiv *subdiv = ctx->subdiv;
   const Mesh *coarse_mesh = ctx->coarse_mesh;
   const MPoly *coarse_mpoly = coarse_mesh->mpoly;
   const MPoly *coarse_poly = &coarse_mpoly[coarse_poly_index];
@@ -716,12 +767,67 @@ static void subdiv_mesh_vertex_inner(const SubdivForeachContext *foreach_context
   MVert *subdiv_vert = &subdiv_mvert[subdiv_vertex_index];
   subdiv_mesh_ensure_vertex_interpolation(ctx, tls, coarse_poly, coarse_corner);
   subdiv_vertex_data_interpolate(ctx, subdiv_vert, &tls->vertex_interpolation, u, v);
-  BKE_subdiv_eval_final_point(subdiv, ptex_face_index, u, v, subdiv_vert->co);
+  subdiv_mesh_eval_limit_point(ctx, ptex_face_index, u, v, subdiv_vert);
   subdiv_mesh_tag_center_vertex(coarse_poly, subdiv_vert, u, v);
 }
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Batched vertex evaluation
+ * \{ */
+
+#define SUBDIV_MESH_EVAL_CHUNK_SIZE 512
+
+static void subdiv_mesh_eval_vertices_chunk(void *__restrict userdata,
+                                            const int chunk_index,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SubdivMeshContext *ctx = userdata;
+  Mesh *subdiv_mesh = ctx->subdiv_mesh;
+  MVert *subdiv_mvert = subdiv_mesh->mvert;
+  const int start_vertex = chunk_index * SUBDIV_MESH_EVAL_CHUNK_SIZE;
+  const int end_vertex = min_ii(start_vertex + SUBDIV_MESH_EVAL_CHUNK_SIZE,
+                                subdiv_mesh->totvert);
+  OpenSubdiv_PatchCoord patch_coords[SUBDIV_MESH_EVAL_CHUNK_SIZE];
+  int vertex_indices[SUBDIV_MESH_EVAL_CHUNK_SIZE];
+  float positions[SUBDIV_MESH_EVAL_CHUNK_SIZE][3];
+  int num_points = 0;
+  for (int vertex_index = start_vertex; vertex_index < end_vertex; vertex_index++) {
+    const OpenSubdiv_PatchCoord *patch_coord = &ctx->vertex_patch_coords[vertex_index];
+    if (patch_coord->ptex_face < 0) {
+      continue;
+    }
+    patch_coords[num_points] = *patch_coord;
+    vertex_indices[num_points] = vertex_index;
+    num_points++;
+  }
+  if (num_points == 0) {
+    return;
+  }
+  BKE_subdiv_eval_limit_points(ctx->subdiv, patch_coords, num_points, positions);
+  for (int i = 0; i < num_points; i++) {
+    copy_v3_v3(subdiv_mvert[vertex_indices[i]].co, positions[i]);
+  }
+}
+
+/* Evaluate positions of all vertices whose evaluation was deferred during the traversal. Points
+ * of a chunk are evaluated with a single call to the evaluator, avoiding the per-point overhead
+ * of patch lookup and buffer setup. */
+static void subdiv_mesh_eval_vertices(SubdivMeshContext *ctx)
+{
+  if (ctx->vertex_patch_coords == NULL || ctx->subdiv_mesh == NULL) {
+    return;
+  }
+  const int num_chunks = divide_ceil_u(ctx->subdiv_mesh->totvert, SUBDIV_MESH_EVAL_CHUNK_SIZE);
+  TaskParallelSettings parallel_range_settings;
+  BLI_parallel_range_settings_defaults(&parallel_range_settings);
+  BLI_task_parallel_range(
+      0, num_chunks, ctx, subdiv_mesh_eval_vertices_chunk, &parallel_range_settings);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Edge subdivision process
  * \{ */
@@ -1104,6 +1210,186 @@ static void setup_foreach_callbacks(const SubdivMeshContext *subdiv_context,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Result cache
+ *
+ * Deforming animated meshes keep their topology and all their data but the positions. The
+ * subdivided topology and interpolated data are then kept from the previous evaluation, only the
+ * positions are evaluated again from the stored limit surface coordinates of the vertices.
+ * \{ */
+
+typedef struct SubdivMeshCache {
+  SubdivToMeshSettings settings;
+  /* Copy of the coarse mesh the cache was created for, only its positions are allowed to change
+   * for the cache to be used. */
+  Mesh *coarse_mesh;
+  /* Subdivided mesh with outdated positions, NULL until the same coarse data has been
+   * subdivided twice, to not keep a copy of meshes which are only evaluated once. */
+  Mesh *subdiv_mesh;
+  OpenSubdiv_PatchCoord *vertex_patch_coords;
+} SubdivMeshCache;
+
+void BKE_subdiv_mesh_cache_free(SubdivMeshCache *cache)
+{
+  BKE_id_free(NULL, cache->coarse_mesh);
+  if (cache->subdiv_mesh != NULL) {
+    BKE_id_free(NULL, cache->subdiv_mesh);
+  }
+  MEM_SAFE_FREE(cache->vertex_patch_coords);
+  MEM_freeN(cache);
+}
+
+static bool subdiv_mesh_cache_layer_equal(const CustomDataLayer *layer_a,
+                                          const CustomDataLayer *layer_b,
+                                          const int num_elements)
+{
+  if (layer_a->type != layer_b->type || !STREQ(layer_a->name, layer_b->name)) {
+    return false;
+  }
+  if (layer_a->data == NULL || layer_b->data == NULL) {
+    return layer_a->data == layer_b->data;
+  }
+  switch (layer_a->type) {
+    case CD_MVERT: {
+      /* Positions are evaluated again, everything else is interpolated. */
+      const MVert *verts_a = layer_a->data;
+      const MVert *verts_b = layer_b->data;
+      for (int i = 0; i < num_elements; i++) {
+        if (verts_a[i].flag != verts_b[i].flag || verts_a[i].bweight != verts_b[i].bweight) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case CD_MDEFORMVERT: {
+      const MDeformVert *dverts_a = layer_a->data;
+      const MDeformVert *dverts_b = layer_b->data;
+      for (int i = 0; i < num_elements; i++) {
+        if (dverts_a[i].totweight != dverts_b[i].totweight ||
+            (dverts_a[i].totweight != 0 &&
+             memcmp(dverts_a[i].dw,
+                    dverts_b[i].dw,
+                    sizeof(*dverts_a[i].dw) * (size_t)dverts_a[i].totweight) != 0)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    default:
+      return memcmp(layer_a->data,
+                    layer_b->data,
+                    (size_t)CustomData_sizeof(layer_a->type) * (size_t)num_elements) == 0;
+  }
+}
+
+static bool subdiv_mesh_cache_custom_data_equal(const CustomData *data_a,
+                                                const CustomData *data_b,
+                                                const int num_elements)
+{
+  if (data_a->totlayer != data_b->totlayer) {
+    return false;
+  }
+  for (int i = 0; i < data_a->totlayer; i++) {
+    if (!subdiv_mesh_cache_layer_equal(&data_a->layers[i], &data_b->layers[i], num_elements)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool subdiv_mesh_cache_is_valid(const SubdivMeshCache *cache,
+                                       const SubdivToMeshSettings *settings,
+                                       const Mesh *coarse_mesh)
+{
+  const Mesh *cached_mesh = cache->coarse_mesh;
+  if (cache->settings.resolution != settings->resolution ||
+      cache->settings.use_optimal_display != settings->use_optimal_display) {
+    return false;
+  }
+  if (cached_mesh->totvert != coarse_mesh->totvert ||
+      cached_mesh->totedge != coarse_mesh->totedge ||
+      cached_mesh->totloop != coarse_mesh->totloop ||
+      cached_mesh->totpoly != coarse_mesh->totpoly) {
+    return false;
+  }
+  return subdiv_mesh_cache_custom_data_equal(
+             &cached_mesh->vdata, &coarse_mesh->vdata, coarse_mesh->totvert) &&
+         subdiv_mesh_cache_custom_data_equal(
+             &cached_mesh->edata, &coarse_mesh->edata, coarse_mesh->totedge) &&
+         subdiv_mesh_cache_custom_data_equal(
+             &cached_mesh->ldata, &coarse_mesh->ldata, coarse_mesh->totloop) &&
+         subdiv_mesh_cache_custom_data_equal(
+             &cached_mesh->pdata, &coarse_mesh->pdata, coarse_mesh->totpoly);
+}
+
+/* Layers with pointers to data allocated outside of the layer can't be reliably compared. */
+static bool subdiv_mesh_cache_is_supported(const Mesh *coarse_mesh)
+{
+  return !CustomData_has_layer(&coarse_mesh->ldata, CD_MDISPS) &&
+         !CustomData_has_layer(&coarse_mesh->ldata, CD_GRID_PAINT_MASK);
+}
+
+/* Returns a copy of the cached result with positions evaluated for the current coarse
+ * positions, or NULL when the cache is not valid for the given coarse mesh. */
+static Mesh *subdiv_mesh_from_cache(Subdiv *subdiv,
+                                    const SubdivToMeshSettings *settings,
+                                    const Mesh *coarse_mesh)
+{
+  SubdivMeshCache *cache = subdiv->cache_.mesh;
+  if (cache == NULL || cache->subdiv_mesh == NULL ||
+      !subdiv_mesh_cache_is_valid(cache, settings, coarse_mesh)) {
+    return NULL;
+  }
+  SubdivMeshContext subdiv_context = {0};
+  subdiv_context.settings = settings;
+  subdiv_context.coarse_mesh = coarse_mesh;
+  subdiv_context.subdiv = subdiv;
+  subdiv_context.subdiv_mesh = BKE_mesh_copy_for_eval(cache->subdiv_mesh, false);
+  subdiv_context.vertex_patch_coords = cache->vertex_patch_coords;
+  BKE_mesh_copy_parameters_for_eval(subdiv_context.subdiv_mesh, coarse_mesh);
+  subdiv_mesh_eval_vertices(&subdiv_context);
+  return subdiv_context.subdiv_mesh;
+}
+
+/* Stores the result of a full subdivision in the cache, taking ownership of the vertices patch
+ * coordinates of the context. */
+static void subdiv_mesh_cache_update(Subdiv *subdiv,
+                                     const SubdivToMeshSettings *settings,
+                                     const Mesh *coarse_mesh,
+                                     SubdivMeshContext *subdiv_context)
+{
+  SubdivMeshCache *cache = subdiv->cache_.mesh;
+  const bool is_valid = cache != NULL && subdiv_mesh_cache_is_valid(cache, settings, coarse_mesh);
+  if (cache != NULL && !is_valid) {
+    BKE_subdiv_mesh_cache_free(cache);
+    subdiv->cache_.mesh = cache = NULL;
+  }
+  if (subdiv_context->vertex_patch_coords == NULL || subdiv_context->subdiv_mesh == NULL ||
+      !subdiv_mesh_cache_is_supported(coarse_mesh)) {
+    return;
+  }
+  if (cache == NULL) {
+    /* First time this data is subdivided, only remember it. */
+    cache = MEM_callocN(sizeof(*cache), __func__);
+    cache->settings = *settings;
+    cache->coarse_mesh = BKE_mesh_copy_for_eval(coarse_mesh, false);
+    subdiv->cache_.mesh = cache;
+    return;
+  }
+  /* Loose geometry positions don't come from the limit surface. */
+  const Mesh *subdiv_mesh = subdiv_context->subdiv_mesh;
+  for (int i = 0; i < subdiv_mesh->totvert; i++) {
+    if (subdiv_context->vertex_patch_coords[i].ptex_face < 0) {
+      return;
+    }
+  }
+  cache->subdiv_mesh = BKE_mesh_copy_for_eval(subdiv_mesh, false);
+  cache->vertex_patch_coords = subdiv_context->vertex_patch_coords;
+  subdiv_context->vertex_patch_coords = NULL;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Public entry point
  * \{ */
@@ -1127,6 +1413,13 @@ Mesh *BKE_subdiv_to_mesh(Subdiv *subdiv,
       return NULL;
     }
   }
+  /* Only positions changed since the previous subdivision, skip the topology traversal. */
+  Mesh *cached_result = subdiv_mesh_from_cache(subdiv, settings, coarse_mesh);
+  if (cached_result != NULL) {
+    BKE_subdiv_stats_end(&subdiv->stats, SUBDIV_STATS_SUBDIV_TO_MESH);
+    BKE_mesh_normals_tag_dirty(cached_result);
+    return cached_result;
+  }
   /* Initialize subdivision mesh creation context. */
   SubdivMeshContext subdiv_context = {0};
   subdiv_context.settings = settings;
@@ -1142,7 +1435,9 @@ Mesh *BKE_subdiv_to_mesh(Subdiv *subdiv,
   foreach_context.user_data_tls_size = sizeof(SubdivMeshTLS);
   foreach_context.user_data_tls = &tls;
   BKE_subdiv_foreach_subdiv_geometry(subdiv, &foreach_context, settings, coarse_mesh);
+  subdiv_mesh_eval_vertices(&subdiv_context);
   BKE_subdiv_stats_end(&subdiv->stats, SUBDIV_STATS_SUBDIV_TO_MESH_GEOMETRY);
+  subdiv_mesh_cache_update(subdiv, settings, coarse_mesh, &subdiv_context);
   Mesh *result = subdiv_context.subdiv_mesh;
   // BKE_mesh_validate(result, true, true);
   BKE_subdiv_stats_end(&subdiv->stats, SUBDIV_STATS_SUBDIV_TO_MESH);
@@ -545,7 +545,10 @@ eUndoPushReturn BKE_undosys_step_push_with_type(UndoStack *ustack,
 
     CLOG_INFO(&LOG, 1, "addr=%p, name='%s', type='%s'", us, us->name, us->type->name);
 
-    if (!undosys_step_encode(C, G_MAIN, ustack, us)) {
+    const eMEM_Category mem_category = MEM_category_set(MEM_CATEGORY_UNDO);
+    const bool encoded = undosys_step_encode(C, G_MAIN, ustack, us);
+    MEM_category_set(mem_category);
+    if (!encoded) {
       MEM_freeN(us);
       undosys_stack_validate(ustack, true);
       return retval;
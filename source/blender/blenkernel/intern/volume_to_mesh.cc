@@ -4,6 +4,7 @@
 
 #include "BLI_math_vec_types.hh"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_mesh_types.h"
@@ -101,9 +102,12 @@ struct VolumeToMeshOp {
 
     /* Better align generated mesh with volume (see T85312). */
     openvdb::Vec3s offset = grid.voxelSize() / 2.0f;
-    for (openvdb::Vec3s &position : this->verts) {
-      position += offset;
-    }
+    MutableSpan<openvdb::Vec3s> verts = this->verts;
+    threading::parallel_for(verts.index_range(), 4096, [&](const IndexRange range) {
+      for (openvdb::Vec3s &position : verts.slice(range)) {
+        position += offset;
+      }
+    });
   }
 };
 
@@ -118,32 +122,57 @@ void fill_mesh_from_openvdb_data(const Span<openvdb::Vec3s> vdb_verts,
                                  MutableSpan<MLoop> loops)
 {
   /* Write vertices. */
-  for (const int i : vdb_verts.index_range()) {
-    const blender::float3 co = blender::float3(vdb_verts[i].asV());
-    copy_v3_v3(verts[vert_offset + i].co, co);
-  }
+  threading::parallel_for(vdb_verts.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const blender::float3 co = blender::float3(vdb_verts[i].asV());
+      copy_v3_v3(verts[vert_offset + i].co, co);
+    }
+  });
 
   /* Write triangles. */
-  for (const int i : vdb_tris.index_range()) {
-    polys[poly_offset + i].loopstart = loop_offset + 3 * i;
-    polys[poly_offset + i].totloop = 3;
-    for (int j = 0; j < 3; j++) {
-      /* Reverse vertex order to get correct normals. */
-      loops[loop_offset + 3 * i + j].v = vert_offset + vdb_tris[i][2 - j];
+  threading::parallel_for(vdb_tris.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      polys[poly_offset + i].loopstart = loop_offset + 3 * i;
+      polys[poly_offset + i].totloop = 3;
+      for (int j = 0; j < 3; j++) {
+        /* Reverse vertex order to get correct normals. */
+        loops[loop_offset + 3 * i + j].v = vert_offset + vdb_tris[i][2 - j];
+      }
     }
-  }
+  });
 
   /* Write quads. */
   const int quad_offset = poly_offset + vdb_tris.size();
   const int quad_loop_offset = loop_offset + vdb_tris.size() * 3;
-  for (const int i : vdb_quads.index_range()) {
-    polys[quad_offset + i].loopstart = quad_loop_offset + 4 * i;
-    polys[quad_offset + i].totloop = 4;
-    for (int j = 0; j < 4; j++) {
-      /* Reverse vertex order to get correct normals. */
-      loops[quad_loop_offset + 4 * i + j].v = vert_offset + vdb_quads[i][3 - j];
+  threading::parallel_for(vdb_quads.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      polys[quad_offset + i].loopstart = quad_loop_offset + 4 * i;
+      polys[quad_offset + i].totloop = 4;
+      for (int j = 0; j < 4; j++) {
+        /* Reverse vertex order to get correct normals. */
+        loops[quad_loop_offset + 4 * i + j].v = vert_offset + vdb_quads[i][3 - j];
+      }
     }
+  });
+}
+
+bool volume_to_mesh_resolution_simplify(VolumeToMeshResolution &resolution,
+                                        const float simplify_factor)
+{
+  switch (resolution.mode) {
+    case VOLUME_TO_MESH_RESOLUTION_MODE_GRID:
+      return true;
+    case VOLUME_TO_MESH_RESOLUTION_MODE_VOXEL_AMOUNT:
+      resolution.settings.voxel_amount *= simplify_factor;
+      return resolution.settings.voxel_amount > 0.0f;
+    case VOLUME_TO_MESH_RESOLUTION_MODE_VOXEL_SIZE:
+      if (simplify_factor <= 0.0f) {
+        return false;
+      }
+      resolution.settings.voxel_size /= simplify_factor;
+      return true;
   }
+  return true;
 }
 
 bke::OpenVDBMeshData volume_to_mesh_data(const openvdb::GridBase &grid,
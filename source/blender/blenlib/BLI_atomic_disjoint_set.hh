@@ -0,0 +1,122 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A disjoint set like #DisjointSet, which can be joined and searched from multiple threads at the
+ * same time. The parent and rank of every element are stored in a single atomic, so that roots
+ * are changed with compare-and-swap, and paths are compressed by halving.
+ */
+
+#include <atomic>
+
+#include "BLI_array.hh"
+
+namespace blender {
+
+class AtomicDisjointSet {
+ private:
+  /* Both members are changed together, the rank is only meaningful for roots. */
+  struct Item {
+    int parent;
+    int rank;
+  };
+
+  Array<std::atomic<Item>> items_;
+
+ public:
+  /**
+   * Create a new disjoint set with the given size. Initially, every element is in a separate set.
+   */
+  AtomicDisjointSet(const int size) : items_(size)
+  {
+    BLI_assert(size >= 0);
+    for (const int i : items_.index_range()) {
+      items_[i].store(Item{i, 0}, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * Join the sets containing elements x and y. Nothing happens when they have been in the same set
+   * before.
+   */
+  void join(int x, int y)
+  {
+    while (true) {
+      x = this->find_root(x);
+      y = this->find_root(y);
+
+      /* x and y are in the same set already. */
+      if (x == y) {
+        return;
+      }
+
+      Item x_item = items_[x].load(std::memory_order_relaxed);
+      Item y_item = items_[y].load(std::memory_order_relaxed);
+
+      /* Another thread may have linked one of the roots in the meantime. */
+      if (x_item.parent != x || y_item.parent != y) {
+        continue;
+      }
+
+      /* Implement union by rank heuristic, the index decides between equal ranks so that two
+       * threads joining the same sets don't make both roots children of each other. */
+      if (x_item.rank < y_item.rank || (x_item.rank == y_item.rank && x < y)) {
+        std::swap(x, y);
+        std::swap(x_item, y_item);
+      }
+
+      /* Make y a child of x, unless it isn't a root anymore. */
+      if (items_[y].compare_exchange_strong(y_item, Item{x, y_item.rank})) {
+        if (x_item.rank == y_item.rank) {
+          /* Failing is fine, the rank is only a heuristic. */
+          items_[x].compare_exchange_strong(x_item, Item{x, x_item.rank + 1});
+        }
+        return;
+      }
+    }
+  }
+
+  /**
+   * Return true when x and y are in the same set.
+   */
+  bool in_same_set(int x, int y)
+  {
+    while (true) {
+      x = this->find_root(x);
+      y = this->find_root(y);
+      if (x == y) {
+        return true;
+      }
+      /* When x is still a root, the sets were disjoint when y was found. */
+      if (items_[x].load(std::memory_order_relaxed).parent == x) {
+        return false;
+      }
+    }
+  }
+
+  /**
+   * Find the element that represents the set containing x currently.
+   */
+  int find_root(int x)
+  {
+    while (true) {
+      const Item item = items_[x].load(std::memory_order_relaxed);
+      if (item.parent == x) {
+        return x;
+      }
+
+      /* Compress path, by making x point to its grandparent. */
+      const int grandparent = items_[item.parent].load(std::memory_order_relaxed).parent;
+      if (grandparent != item.parent) {
+        Item expected = item;
+        items_[x].compare_exchange_weak(expected, Item{grandparent, item.rank});
+      }
+      x = grandparent;
+    }
+  }
+};
+
+}  // namespace blender
@@ -33,6 +33,11 @@ void BLI_expr_pylike_free(struct ExprPyLike_Parsed *expr);
  * Check if the parsing result is valid for evaluation.
  */
 bool BLI_expr_pylike_is_valid(struct ExprPyLike_Parsed *expr);
+/**
+ * Return the offset in the expression of the token that could not be parsed,
+ * or -1 when the expression is valid.
+ */
+int BLI_expr_pylike_error_offset(struct ExprPyLike_Parsed *expr);
 /**
  * Check if the parsed expression always evaluates to the same value.
  */
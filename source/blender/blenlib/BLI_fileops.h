@@ -236,11 +236,16 @@ bool BLI_file_alias_target(const char *filepath, char *r_targetpath) ATTR_WARN_U
 
 bool BLI_file_magic_is_gzip(const char header[4]);
 
+/**
+ * Compresses \a buf into \a file at \a file_offset, using up to \a num_threads worker threads
+ * when Zstd is built with multi-threading support.
+ */
 size_t BLI_file_zstd_from_mem_at_pos(void *buf,
                                      size_t len,
                                      FILE *file,
                                      size_t file_offset,
-                                     int compression_level) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL();
+                                     int compression_level,
+                                     int num_threads) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL();
 size_t BLI_file_unzstd_to_mem_at_pos(void *buf, size_t len, FILE *file, size_t file_offset)
     ATTR_WARN_UNUSED_RESULT ATTR_NONNULL();
 bool BLI_file_magic_is_zstd(const char header[4]);
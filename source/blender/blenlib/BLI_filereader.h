@@ -30,12 +30,20 @@ struct FileReader;
 typedef ssize_t (*FileReaderReadFn)(struct FileReader *reader, void *buffer, size_t size);
 typedef off64_t (*FileReaderSeekFn)(struct FileReader *reader, off64_t offset, int whence);
 typedef void (*FileReaderCloseFn)(struct FileReader *reader);
+typedef const void *(*FileReaderDataFn)(struct FileReader *reader, off64_t offset, size_t size);
 
 /** General structure for all #FileReaders, implementations add custom fields at the end. */
 typedef struct FileReader {
   FileReaderReadFn read;
   FileReaderSeekFn seek;
   FileReaderCloseFn close;
+  /**
+   * Optional, only implemented by readers that have the whole content in memory.
+   * Gives direct read-only access to `size` bytes at `offset` without copying them, or returns
+   * NULL when the range can't be accessed. The pointer stays valid until the reader is closed.
+   * IO errors that happen while reading memory-mapped data are reported by the next call failing.
+   */
+  FileReaderDataFn data;
 
   off64_t offset;
 } FileReader;
@@ -0,0 +1,147 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * FlatHash is a hash-map using open addressing, with the same callbacks as #GHash.
+ *
+ * All entries are stored in a single array, so unlike #GHash, inserting doesn't allocate an
+ * entry and looking up a key doesn't follow a chain of pointers. The hash of every key is
+ * stored too, so that the comparison callback is only called for keys that are likely equal,
+ * and growing doesn't call the hash callback again.
+ *
+ * \warning Value pointers (see #BLI_flathash_lookup_p and #BLI_flathash_ensure_p) are only
+ * valid until the next insertion, since the array may be reallocated.
+ */
+
+#include "BLI_compiler_attrs.h"
+#include "BLI_ghash.h"
+#include "BLI_sys_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct FlatHash FlatHash;
+
+typedef struct FlatHashIterator {
+  const FlatHash *fh;
+  struct FlatHashSlot *slot;
+  unsigned int slot_index;
+} FlatHashIterator;
+
+/* -------------------------------------------------------------------- */
+/** \name FlatHash API
+ *
+ * Defined in `flathash.c`
+ * \{ */
+
+/**
+ * Creates a new, empty FlatHash.
+ *
+ * \param nentries_reserve: Optionally reserve the number of members that the hash will hold,
+ * to avoid growing the hash while inserting.
+ */
+FlatHash *BLI_flathash_new_ex(GHashHashFP hashfp,
+                              GHashCmpFP cmpfp,
+                              const char *info,
+                              unsigned int nentries_reserve) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
+FlatHash *BLI_flathash_new(GHashHashFP hashfp,
+                           GHashCmpFP cmpfp,
+                           const char *info) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
+void BLI_flathash_free(FlatHash *fh, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp);
+/**
+ * Remove all entries, keeping the memory allocated for them.
+ */
+void BLI_flathash_clear(FlatHash *fh, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp);
+/**
+ * Insert a key/value pair into the hash, the key must not be in the hash already.
+ * Unlike #GHash, duplicate keys are not supported, the value of an existing key is replaced.
+ */
+void BLI_flathash_insert(FlatHash *fh, void *key, void *val);
+/**
+ * Insert a new value for a key that may already be in the hash.
+ *
+ * \returns true if a new key has been added.
+ */
+bool BLI_flathash_reinsert(FlatHash *fh,
+                           void *key,
+                           void *val,
+                           GHashKeyFreeFP keyfreefp,
+                           GHashValFreeFP valfreefp);
+/**
+ * Lookup the value of \a key, returns NULL when the key isn't found.
+ */
+void *BLI_flathash_lookup(const FlatHash *fh, const void *key) ATTR_WARN_UNUSED_RESULT;
+/**
+ * Lookup a pointer to the value of \a key, returns NULL when the key isn't found.
+ */
+void **BLI_flathash_lookup_p(FlatHash *fh, const void *key) ATTR_WARN_UNUSED_RESULT;
+/**
+ * Ensure \a key is in \a fh, see #BLI_ghash_ensure_p.
+ *
+ * \returns true when the key was already in the hash, otherwise the value must be set by the
+ * caller.
+ */
+bool BLI_flathash_ensure_p(FlatHash *fh, void *key, void ***r_val) ATTR_WARN_UNUSED_RESULT;
+/**
+ * Add \a key with a NULL value, to use the hash as a set.
+ *
+ * \returns true if the key was added, false when it was in the hash already.
+ */
+bool BLI_flathash_add(FlatHash *fh, void *key);
+/**
+ * Remove \a key from \a fh, or return false if the key wasn't found.
+ */
+bool BLI_flathash_remove(FlatHash *fh,
+                         const void *key,
+                         GHashKeyFreeFP keyfreefp,
+                         GHashValFreeFP valfreefp);
+bool BLI_flathash_haskey(const FlatHash *fh, const void *key) ATTR_WARN_UNUSED_RESULT;
+unsigned int BLI_flathash_len(const FlatHash *fh) ATTR_WARN_UNUSED_RESULT;
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name FlatHash Iterator
+ *
+ * The hash must not be mutated while iterating, except for changing the values.
+ * \{ */
+
+void BLI_flathashIterator_init(FlatHashIterator *fhi, const FlatHash *fh);
+void BLI_flathashIterator_step(FlatHashIterator *fhi);
+void *BLI_flathashIterator_getKey(const FlatHashIterator *fhi) ATTR_WARN_UNUSED_RESULT;
+void *BLI_flathashIterator_getValue(const FlatHashIterator *fhi) ATTR_WARN_UNUSED_RESULT;
+void **BLI_flathashIterator_getValue_p(FlatHashIterator *fhi) ATTR_WARN_UNUSED_RESULT;
+BLI_INLINE bool BLI_flathashIterator_done(const FlatHashIterator *fhi)
+{
+  return fhi->slot == NULL;
+}
+
+#define FLATHASH_ITER(fh_iter_, flathash_) \
+  for (BLI_flathashIterator_init(&(fh_iter_), flathash_); \
+       BLI_flathashIterator_done(&(fh_iter_)) == false; \
+       BLI_flathashIterator_step(&(fh_iter_)))
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Convenience FlatHash Creation Functions
+ * \{ */
+
+FlatHash *BLI_flathash_ptr_new_ex(const char *info,
+                                  unsigned int nentries_reserve) ATTR_MALLOC
+    ATTR_WARN_UNUSED_RESULT;
+FlatHash *BLI_flathash_ptr_new(const char *info) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
+FlatHash *BLI_flathash_str_new_ex(const char *info,
+                                  unsigned int nentries_reserve) ATTR_MALLOC
+    ATTR_WARN_UNUSED_RESULT;
+FlatHash *BLI_flathash_int_new(const char *info) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
+
+/** \} */
+
+#ifdef __cplusplus
+}
+#endif
@@ -226,6 +226,24 @@ int BLI_bvhtree_find_nearest(BVHTree *tree,
                              BVHTree_NearestPointCallback callback,
                              void *userdata);
 
+/**
+ * Find the nearest node for every coordinate in \a co, see #BLI_bvhtree_find_nearest_ex.
+ * This is faster than separate queries: queries run in parallel, in an order that keeps
+ * consecutive queries close to each other, and the result of the previous query is used as an
+ * upper bound for the distance of the next one.
+ *
+ * \param r_nearest: Array of \a co_num items. The index and distance must be initialized,
+ * as they are for single queries.
+ * \note The callback is called from multiple threads.
+ */
+void BLI_bvhtree_find_nearest_batch(BVHTree *tree,
+                                    const float (*co)[3],
+                                    int co_num,
+                                    BVHTreeNearest *r_nearest,
+                                    BVHTree_NearestPointCallback callback,
+                                    void *userdata,
+                                    int flag);
+
 /**
  * Find the first node nearby.
  * Favors speed over quality since it doesn't find the best target node.
@@ -252,6 +270,25 @@ int BLI_bvhtree_ray_cast(BVHTree *tree,
                          BVHTree_RayCastCallback callback,
                          void *userdata);
 
+/**
+ * Cast a ray for every origin and direction, see #BLI_bvhtree_ray_cast_ex.
+ * Rays are processed in parallel, in an order that keeps rays with close origins and
+ * similar directions together.
+ *
+ * \param r_hits: Array of \a ray_num items. The index and distance must be initialized,
+ * as they are for single queries.
+ * \note The callback is called from multiple threads.
+ */
+void BLI_bvhtree_ray_cast_batch(BVHTree *tree,
+                                const float (*co)[3],
+                                const float (*dir)[3],
+                                int ray_num,
+                                float radius,
+                                BVHTreeRayHit *r_hits,
+                                BVHTree_RayCastCallback callback,
+                                void *userdata,
+                                int flag);
+
 /**
  * Calls the callback for every ray intersection
  *
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "BLI_math_vec_types.hh"
+#include "BLI_span.hh"
 
 namespace blender::noise {
 
@@ -103,6 +104,21 @@ float3 perlin_float3_fractal_distorted(float4 position,
                                        float roughness,
                                        float distortion);
 
+/* Batched versions of the 3D distorted fractal perlin noise, with the same octaves, roughness
+ * and distortion for all positions. They are vectorized where SIMD is available and give the
+ * same results as the versions above. */
+
+void perlin_fractal_distorted(Span<float3> positions,
+                              float octaves,
+                              float roughness,
+                              float distortion,
+                              MutableSpan<float> r_values);
+void perlin_float3_fractal_distorted(Span<float3> positions,
+                                     float octaves,
+                                     float roughness,
+                                     float distortion,
+                                     MutableSpan<float3> r_values);
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
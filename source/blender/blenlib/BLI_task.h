@@ -37,6 +37,38 @@ int BLI_task_scheduler_num_threads(void);
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Task Lanes
+ *
+ * Work is scheduled in lanes with their own priority and concurrency limit. Tasks spawned while
+ * running in a lane (task pools, parallel loops) stay in that lane, and threads waiting in one
+ * lane never pick up tasks of another lane, so a short interactive operation can't end up
+ * running a long background task.
+ * \{ */
+
+typedef enum eTaskLane {
+  /** Work the user is waiting for, scheduled before the other lanes. */
+  TASK_LANE_INTERACTIVE,
+  /** Default lane, used by everything that does not run in another lane. */
+  TASK_LANE_EVALUATION,
+  /**
+   * Long running jobs like baking and previews. Scheduled after the other lanes, and leaves at
+   * least one thread to them so the user interface stays responsive.
+   */
+  TASK_LANE_BACKGROUND,
+} eTaskLane;
+
+/**
+ * Run \a func in the given lane. Like #BLI_task_isolate, tasks spawned by \a func are only
+ * run by threads working in the same lane.
+ *
+ * \note The function may run on another thread than the calling one when all threads of the
+ * lane are busy, so it must not rely on thread local state like GPU contexts.
+ */
+void BLI_task_execute_in_lane(eTaskLane lane, void (*func)(void *userdata), void *userdata);
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Task Pool
  *
@@ -192,6 +224,8 @@ typedef struct TaskParallelSettings {
    * having a global use_threading switch based on just range size.
    */
   int min_iter_per_thread;
+  /* Name of the loop in task traces, see #BLI_task_trace_begin. */
+  const char *name;
 } TaskParallelSettings;
 
 BLI_INLINE void BLI_parallel_range_settings_defaults(TaskParallelSettings *settings);
@@ -433,6 +467,55 @@ void BLI_task_isolate(void (*func)(void *userdata), void *userdata);
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Task Tracing
+ *
+ * Optional recording of parallel loops and task pool tasks, to find work that doesn't scale.
+ * Every loop records its name, grain size, number of tasks and the time the tasks were busy,
+ * every task records when and on which thread it ran, so idle threads show as gaps. Recording
+ * is enabled during depsgraph evaluations with time debugging, and written with the depsgraph
+ * timeline by #DEG_debug_stats_trace.
+ *
+ * When disabled, loops only check a flag once.
+ * \{ */
+
+typedef struct TaskTraceEvent {
+  /** Name passed to the loop, or the type of parallel construct when none is given. */
+  const char *name;
+  /** In seconds, as returned by #PIL_check_seconds_timer. */
+  double start_time;
+  double end_time;
+  /** Hash of the `std::thread::id` of the thread the event ran on. */
+  uint64_t thread_id;
+  /** Loop events only, zero for tasks. */
+  int64_t range_size;
+  int64_t grain_size;
+  int tasks_num;
+  /** Sum of the durations of the tasks of the loop. */
+  double busy_time;
+} TaskTraceEvent;
+
+/** Clear previous records and start recording. */
+void BLI_task_trace_begin(void);
+void BLI_task_trace_end(void);
+bool BLI_task_trace_is_enabled(void);
+
+double BLI_task_trace_time(void);
+void BLI_task_trace_add_task(const char *name, double start_time, double end_time);
+void BLI_task_trace_add_loop(const char *name,
+                             double start_time,
+                             double end_time,
+                             int64_t range_size,
+                             int64_t grain_size,
+                             int tasks_num,
+                             double busy_time);
+
+/** Call \a func for every recorded event, must not be called while recording. */
+void BLI_task_trace_foreach(void (*func)(const TaskTraceEvent *event, void *userdata),
+                            void *userdata);
+
+/** \} */
+
 #ifdef __cplusplus
 }
 #endif
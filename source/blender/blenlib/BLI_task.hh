@@ -30,11 +30,58 @@
 #  endif
 #endif
 
+#include <atomic>
+
+#include "MEM_guardedalloc.h"
+
 #include "BLI_index_range.hh"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 namespace blender::threading {
 
+#ifdef WITH_TBB
+namespace detail {
+/** Arena of the lane, null when the lane runs in the arena of the calling thread. */
+tbb::task_arena *task_lane_arena(eTaskLane lane);
+
+/** Same as #parallel_for, recording the loop and its tasks, see #BLI_task_trace_begin. */
+template<typename Function>
+void parallel_for_traced(const IndexRange range,
+                         const int64_t grain_size,
+                         const Function &function,
+                         const char *name)
+{
+  if (name == nullptr) {
+    name = "parallel_for";
+  }
+  const eMEM_Category mem_category = MEM_category_get();
+  std::atomic<int> tasks_num = 0;
+  std::atomic<int64_t> busy_time_ns = 0;
+  const double start_time = BLI_task_trace_time();
+  tbb::parallel_for(
+      tbb::blocked_range<int64_t>(range.first(), range.one_after_last(), grain_size),
+      [&](const tbb::blocked_range<int64_t> &subrange) {
+        MEM_CategoryScope mem_category_scope(mem_category);
+        const double task_start_time = BLI_task_trace_time();
+        function(IndexRange(subrange.begin(), subrange.size()));
+        const double task_end_time = BLI_task_trace_time();
+        BLI_task_trace_add_task(name, task_start_time, task_end_time);
+        tasks_num.fetch_add(1, std::memory_order_relaxed);
+        busy_time_ns.fetch_add(int64_t((task_end_time - task_start_time) * 1e9),
+                               std::memory_order_relaxed);
+      });
+  BLI_task_trace_add_loop(name,
+                          start_time,
+                          BLI_task_trace_time(),
+                          range.size(),
+                          grain_size,
+                          tasks_num.load(),
+                          double(busy_time_ns.load()) * 1e-9);
+}
+}  // namespace detail
+#endif
+
 template<typename Range, typename Function>
 void parallel_for_each(Range &range, const Function &function)
 {
@@ -47,8 +94,14 @@ void parallel_for_each(Range &range, const Function &function)
 #endif
 }
 
+/**
+ * \param name: Identifies the loop in task traces, see #BLI_task_trace_begin.
+ */
 template<typename Function>
-void parallel_for(IndexRange range, int64_t grain_size, const Function &function)
+void parallel_for(IndexRange range,
+                  int64_t grain_size,
+                  const Function &function,
+                  const char *name = nullptr)
 {
   if (range.size() == 0) {
     return;
@@ -56,15 +109,21 @@ void parallel_for(IndexRange range, int64_t grain_size, const Function &function
 #ifdef WITH_TBB
   /* Invoking tbb for small workloads has a large overhead. */
   if (range.size() >= grain_size) {
+    if (UNLIKELY(BLI_task_trace_is_enabled())) {
+      detail::parallel_for_traced(range, grain_size, function, name);
+      return;
+    }
+    const eMEM_Category mem_category = MEM_category_get();
     tbb::parallel_for(
         tbb::blocked_range<int64_t>(range.first(), range.one_after_last(), grain_size),
         [&](const tbb::blocked_range<int64_t> &subrange) {
+          MEM_CategoryScope mem_category_scope(mem_category);
           function(IndexRange(subrange.begin(), subrange.size()));
         });
     return;
   }
 #else
-  UNUSED_VARS(grain_size);
+  UNUSED_VARS(grain_size, name);
 #endif
   function(range);
 }
@@ -113,4 +172,18 @@ template<typename Function> void isolate_task(const Function &function)
 #endif
 }
 
+/** See #BLI_task_execute_in_lane. */
+template<typename Function> void execute_in_lane(const eTaskLane lane, const Function &function)
+{
+#ifdef WITH_TBB
+  if (tbb::task_arena *arena = detail::task_lane_arena(lane)) {
+    arena->execute(function);
+    return;
+  }
+#else
+  UNUSED_VARS(lane);
+#endif
+  function();
+}
+
 }  // namespace blender::threading
@@ -1156,4 +1156,54 @@ inline void devirtualize_varray2(const VArray<T1> &varray1,
   func(varray1, varray2);
 }
 
+/**
+ * Same as `devirtualize_varray2`, but for three virtual arrays. Every combination of spans and
+ * single values is handled, which results in nine instantiations of the function.
+ */
+template<typename T1, typename T2, typename T3, typename Func>
+inline void devirtualize_varray3(const VArray<T1> &varray1,
+                                 const VArray<T2> &varray2,
+                                 const VArray<T3> &varray3,
+                                 const Func &func,
+                                 bool enable = true)
+{
+  /* Support disabling the devirtualization to simplify benchmarking. */
+  if (enable) {
+    const bool is_span1 = varray1.is_span();
+    const bool is_span2 = varray2.is_span();
+    const bool is_span3 = varray3.is_span();
+    const bool is_single1 = !is_span1 && varray1.is_single();
+    const bool is_single2 = !is_span2 && varray2.is_single();
+    const bool is_single3 = !is_span3 && varray3.is_single();
+    if ((is_span1 || is_single1) && (is_span2 || is_single2) && (is_span3 || is_single3)) {
+      /* Devirtualize the first array and pass the others on, so that every case is written only
+       * once. */
+      const auto call_with_first = [&](const auto &array1) {
+        if (is_span2 && is_span3) {
+          func(array1, varray2.get_internal_span(), varray3.get_internal_span());
+        }
+        else if (is_span2) {
+          func(array1, varray2.get_internal_span(), SingleAsSpan(varray3));
+        }
+        else if (is_span3) {
+          func(array1, SingleAsSpan(varray2), varray3.get_internal_span());
+        }
+        else {
+          func(array1, SingleAsSpan(varray2), SingleAsSpan(varray3));
+        }
+      };
+      if (is_span1) {
+        call_with_first(varray1.get_internal_span());
+      }
+      else {
+        call_with_first(SingleAsSpan(varray1));
+      }
+      return;
+    }
+  }
+  /* See #devirtualize_varray2 for why the fallback is used when only some inputs can be
+   * optimized. */
+  func(varray1, varray2, varray3);
+}
+
 }  // namespace blender
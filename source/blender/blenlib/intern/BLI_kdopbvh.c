@@ -20,6 +20,8 @@
  *   #BLI_bvhtree_overlap, #BVHOverlapData_Shared, #BVHOverlapData_Thread
  * - Range Query:
  *   #BLI_bvhtree_range_query
+ * - Batched ray-cast and nearest point, for many queries at once:
+ *   #BLI_bvhtree_ray_cast_batch, #BLI_bvhtree_find_nearest_batch
  */
 
 #include "MEM_guardedalloc.h"
@@ -116,6 +118,8 @@ typedef struct BVHNearestData {
   void *userdata;
   float proj[13]; /* coordinates projection over axis */
   BVHTreeNearest nearest;
+  /* Leaf of the nearest result (only set when found by this search). */
+  BVHNode *nearest_leaf;
 
 } BVHNearestData;
 
@@ -1470,17 +1474,30 @@ static float calc_nearest_point_squared(const float proj[3], BVHNode *node, floa
   return len_squared_v3v3(proj, nearest);
 }
 
+static void find_nearest_leaf(BVHNearestData *data, BVHNode *node)
+{
+  if (data->callback) {
+    data->callback(data->userdata, node->index, data->co, &data->nearest);
+  }
+  else {
+    float nearest[3];
+    const float dist_sq = calc_nearest_point_squared(data->proj, node, nearest);
+    if (dist_sq < data->nearest.dist_sq) {
+      data->nearest.index = node->index;
+      data->nearest.dist_sq = dist_sq;
+      copy_v3_v3(data->nearest.co, nearest);
+    }
+  }
+  if (data->nearest.index == node->index) {
+    data->nearest_leaf = node;
+  }
+}
+
 /* Depth first search method */
 static void dfs_find_nearest_dfs(BVHNearestData *data, BVHNode *node)
 {
   if (node->totnode == 0) {
-    if (data->callback) {
-      data->callback(data->userdata, node->index, data->co, &data->nearest);
-    }
-    else {
-      data->nearest.index = node->index;
-      data->nearest.dist_sq = calc_nearest_point_squared(data->proj, node, data->nearest.co);
-    }
+    find_nearest_leaf(data, node);
   }
   else {
     /* Better heuristic to pick the closest node to dive on */
@@ -1523,13 +1540,7 @@ static void dfs_find_nearest_begin(BVHNearestData *data, BVHNode *node)
 static void heap_find_nearest_inner(BVHNearestData *data, HeapSimple *heap, BVHNode *node)
 {
   if (node->totnode == 0) {
-    if (data->callback) {
-      data->callback(data->userdata, node->index, data->co, &data->nearest);
-    }
-    else {
-      data->nearest.index = node->index;
-      data->nearest.dist_sq = calc_nearest_point_squared(data->proj, node, data->nearest.co);
-    }
+    find_nearest_leaf(data, node);
   }
   else {
     float nearest[3];
@@ -1564,12 +1575,19 @@ static void heap_find_nearest_begin(BVHNearestData *data, BVHNode *root)
   }
 }
 
-int BLI_bvhtree_find_nearest_ex(BVHTree *tree,
-                                const float co[3],
-                                BVHTreeNearest *nearest,
-                                BVHTree_NearestPointCallback callback,
-                                void *userdata,
-                                int flag)
+/**
+ * \param nearest: Input upper bound and output result, unlike the public API it can't be null.
+ * \param hint_leaf: Leaf tested before searching the tree, a leaf close to \a co gives a small
+ * upper bound for the distance early, so that much of the tree is skipped.
+ * \return The leaf of the nearest result, when it was found by this search.
+ */
+static BVHNode *bvhtree_find_nearest_hint(BVHTree *tree,
+                                          const float co[3],
+                                          BVHTreeNearest *nearest,
+                                          BVHTree_NearestPointCallback callback,
+                                          void *userdata,
+                                          int flag,
+                                          BVHNode *hint_leaf)
 {
   axis_t axis_iter;
 
@@ -1587,12 +1605,11 @@ int BLI_bvhtree_find_nearest_ex(BVHTree *tree,
     data.proj[axis_iter] = dot_v3v3(data.co, bvhtree_kdop_axes[axis_iter]);
   }
 
-  if (nearest) {
-    memcpy(&data.nearest, nearest, sizeof(*nearest));
-  }
-  else {
-    data.nearest.index = -1;
-    data.nearest.dist_sq = FLT_MAX;
+  memcpy(&data.nearest, nearest, sizeof(*nearest));
+  data.nearest_leaf = NULL;
+
+  if (hint_leaf) {
+    find_nearest_leaf(&data, hint_leaf);
   }
 
   /* dfs search */
@@ -1606,11 +1623,26 @@ int BLI_bvhtree_find_nearest_ex(BVHTree *tree,
   }
 
   /* copy back results */
-  if (nearest) {
-    memcpy(nearest, &data.nearest, sizeof(*nearest));
-  }
+  memcpy(nearest, &data.nearest, sizeof(*nearest));
 
-  return data.nearest.index;
+  return data.nearest_leaf;
+}
+
+int BLI_bvhtree_find_nearest_ex(BVHTree *tree,
+                                const float co[3],
+                                BVHTreeNearest *nearest,
+                                BVHTree_NearestPointCallback callback,
+                                void *userdata,
+                                int flag)
+{
+  BVHTreeNearest nearest_local;
+  if (nearest == NULL) {
+    nearest_local.index = -1;
+    nearest_local.dist_sq = FLT_MAX;
+    nearest = &nearest_local;
+  }
+  bvhtree_find_nearest_hint(tree, co, nearest, callback, userdata, flag, NULL);
+  return nearest->index;
 }
 
 int BLI_bvhtree_find_nearest(BVHTree *tree,
@@ -2361,3 +2393,250 @@ void BLI_bvhtree_walk_dfs(BVHTree *tree,
 }
 
 /** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name BLI_bvhtree_find_nearest_batch / BLI_bvhtree_ray_cast_batch
+ *
+ * Queries are processed in the order of the Morton code of their coordinates, so that
+ * consecutive queries visit mostly the same nodes, which are then still in the CPU cache.
+ * Chunks of consecutive queries are processed in parallel.
+ *
+ * \{ */
+
+/* Number of consecutive queries processed by a single task. */
+#define BVH_BATCH_CHUNK_SIZE 256
+
+typedef struct BVHBatchOrder {
+  uint code;
+  int index;
+} BVHBatchOrder;
+
+/* Spread the lower 10 bits of the value, leaving two zero bits between each of them. */
+static uint morton_spread_bits(uint v)
+{
+  v &= 0x3ff;
+  v = (v | (v << 16)) & 0x030000ff;
+  v = (v | (v << 8)) & 0x0300f00f;
+  v = (v | (v << 4)) & 0x030c30c3;
+  v = (v | (v << 2)) & 0x09249249;
+  return v;
+}
+
+static uint morton_quantize(const float value)
+{
+  /* Written so that NaN maps to zero. */
+  return (value > 0.0f) ? (uint)min_ff(value, 1023.0f) : 0u;
+}
+
+/* Stable radix sort of the codes, in four passes of 8 bits. */
+static void bvh_batch_order_sort(BVHBatchOrder *order, const int num)
+{
+  BVHBatchOrder *buffer = MEM_malloc_arrayN((size_t)num, sizeof(*buffer), __func__);
+  BVHBatchOrder *src = order;
+  BVHBatchOrder *dst = buffer;
+  for (uint shift = 0; shift < 32; shift += 8) {
+    int offsets[256] = {0};
+    for (int i = 0; i < num; i++) {
+      offsets[(src[i].code >> shift) & 0xff]++;
+    }
+    int offset = 0;
+    for (int i = 0; i < 256; i++) {
+      const int count = offsets[i];
+      offsets[i] = offset;
+      offset += count;
+    }
+    for (int i = 0; i < num; i++) {
+      dst[offsets[(src[i].code >> shift) & 0xff]++] = src[i];
+    }
+    SWAP(BVHBatchOrder *, src, dst);
+  }
+  /* After an even number of passes the result is back in the input array. */
+  BLI_assert(src == order);
+  MEM_freeN(buffer);
+}
+
+/**
+ * Order in which to process the queries. Ray directions are optional, when given
+ * rays going into the same octant are kept together.
+ */
+static BVHBatchOrder *bvh_batch_order_create(const float (*co)[3],
+                                             const float (*dir)[3],
+                                             const int num)
+{
+  float min[3], max[3], scale[3];
+  INIT_MINMAX(min, max);
+  for (int i = 0; i < num; i++) {
+    minmax_v3v3_v3(min, max, co[i]);
+  }
+  for (int axis = 0; axis < 3; axis++) {
+    const float size = max[axis] - min[axis];
+    scale[axis] = (size > 0.0f && size < FLT_MAX) ? 1023.0f / size : 0.0f;
+  }
+
+  BVHBatchOrder *order = MEM_malloc_arrayN((size_t)num, sizeof(*order), __func__);
+  for (int i = 0; i < num; i++) {
+    uint code = 0;
+    for (int axis = 0; axis < 3; axis++) {
+      const float value = (co[i][axis] - min[axis]) * scale[axis];
+      code |= morton_spread_bits(morton_quantize(value)) << axis;
+    }
+    if (dir) {
+      const uint octant = (dir[i][0] < 0.0f ? 1u : 0u) | (dir[i][1] < 0.0f ? 2u : 0u) |
+                          (dir[i][2] < 0.0f ? 4u : 0u);
+      code = (octant << 27) | (code >> 3);
+    }
+    order[i].code = code;
+    order[i].index = i;
+  }
+  bvh_batch_order_sort(order, num);
+  return order;
+}
+
+static void bvh_batch_settings_init(TaskParallelSettings *settings, const int num)
+{
+  BLI_parallel_range_settings_defaults(settings);
+  settings->use_threading = (num > BVH_BATCH_CHUNK_SIZE);
+  settings->min_iter_per_thread = 1;
+}
+
+typedef struct BVHNearestBatchData {
+  BVHTree *tree;
+  const float (*co)[3];
+  BVHTreeNearest *nearest;
+  const BVHBatchOrder *order;
+  int num;
+  BVHTree_NearestPointCallback callback;
+  void *userdata;
+  int flag;
+} BVHNearestBatchData;
+
+static void bvhtree_find_nearest_batch_cb(void *__restrict userdata,
+                                          const int chunk,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BVHNearestBatchData *data = userdata;
+  const int start = chunk * BVH_BATCH_CHUNK_SIZE;
+  const int end = min_ii(start + BVH_BATCH_CHUNK_SIZE, data->num);
+
+  /* The previous query is close, its result is a good first guess for the next one. */
+  BVHNode *hint_leaf = NULL;
+  for (int i = start; i < end; i++) {
+    const int index = data->order[i].index;
+    BVHNode *leaf = bvhtree_find_nearest_hint(data->tree,
+                                              data->co[index],
+                                              &data->nearest[index],
+                                              data->callback,
+                                              data->userdata,
+                                              data->flag,
+                                              hint_leaf);
+    if (leaf) {
+      hint_leaf = leaf;
+    }
+  }
+}
+
+void BLI_bvhtree_find_nearest_batch(BVHTree *tree,
+                                    const float (*co)[3],
+                                    const int co_num,
+                                    BVHTreeNearest *r_nearest,
+                                    BVHTree_NearestPointCallback callback,
+                                    void *userdata,
+                                    const int flag)
+{
+  if (co_num == 0) {
+    return;
+  }
+
+  BVHNearestBatchData data;
+  data.tree = tree;
+  data.co = co;
+  data.nearest = r_nearest;
+  data.order = bvh_batch_order_create(co, NULL, co_num);
+  data.num = co_num;
+  data.callback = callback;
+  data.userdata = userdata;
+  data.flag = flag;
+
+  TaskParallelSettings settings;
+  bvh_batch_settings_init(&settings, co_num);
+  BLI_task_parallel_range(0,
+                          (int)divide_ceil_u((uint)co_num, BVH_BATCH_CHUNK_SIZE),
+                          &data,
+                          bvhtree_find_nearest_batch_cb,
+                          &settings);
+
+  MEM_freeN((void *)data.order);
+}
+
+typedef struct BVHRayCastBatchData {
+  BVHTree *tree;
+  const float (*co)[3];
+  const float (*dir)[3];
+  float radius;
+  BVHTreeRayHit *hits;
+  const BVHBatchOrder *order;
+  int num;
+  BVHTree_RayCastCallback callback;
+  void *userdata;
+  int flag;
+} BVHRayCastBatchData;
+
+static void bvhtree_ray_cast_batch_cb(void *__restrict userdata,
+                                      const int chunk,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BVHRayCastBatchData *data = userdata;
+  const int start = chunk * BVH_BATCH_CHUNK_SIZE;
+  const int end = min_ii(start + BVH_BATCH_CHUNK_SIZE, data->num);
+
+  for (int i = start; i < end; i++) {
+    const int index = data->order[i].index;
+    BLI_bvhtree_ray_cast_ex(data->tree,
+                            data->co[index],
+                            data->dir[index],
+                            data->radius,
+                            &data->hits[index],
+                            data->callback,
+                            data->userdata,
+                            data->flag);
+  }
+}
+
+void BLI_bvhtree_ray_cast_batch(BVHTree *tree,
+                                const float (*co)[3],
+                                const float (*dir)[3],
+                                const int ray_num,
+                                const float radius,
+                                BVHTreeRayHit *r_hits,
+                                BVHTree_RayCastCallback callback,
+                                void *userdata,
+                                const int flag)
+{
+  if (ray_num == 0) {
+    return;
+  }
+
+  BVHRayCastBatchData data;
+  data.tree = tree;
+  data.co = co;
+  data.dir = dir;
+  data.radius = radius;
+  data.hits = r_hits;
+  data.order = bvh_batch_order_create(co, dir, ray_num);
+  data.num = ray_num;
+  data.callback = callback;
+  data.userdata = userdata;
+  data.flag = flag;
+
+  TaskParallelSettings settings;
+  bvh_batch_settings_init(&settings, ray_num);
+  BLI_task_parallel_range(0,
+                          (int)divide_ceil_u((uint)ray_num, BVH_BATCH_CHUNK_SIZE),
+                          &data,
+                          bvhtree_ray_cast_batch_cb,
+                          &settings);
+
+  MEM_freeN((void *)data.order);
+}
+
+/** \} */
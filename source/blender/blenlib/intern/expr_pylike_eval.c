@@ -98,6 +98,8 @@ typedef struct ExprOp {
 struct ExprPyLike_Parsed {
   int ops_count;
   int max_stack;
+  /* Offset in the expression of the token that could not be parsed, or -1. */
+  int error_offset;
 
   ExprOp ops[];
 };
@@ -120,6 +122,11 @@ bool BLI_expr_pylike_is_valid(ExprPyLike_Parsed *expr)
   return expr != NULL && expr->ops_count > 0;
 }
 
+int BLI_expr_pylike_error_offset(ExprPyLike_Parsed *expr)
+{
+  return (expr != NULL && expr->ops_count == 0) ? expr->error_offset : -1;
+}
+
 bool BLI_expr_pylike_is_constant(ExprPyLike_Parsed *expr)
 {
   return expr != NULL && expr->ops_count == 1 && expr->ops[0].opcode == OPCODE_CONST;
@@ -316,6 +323,16 @@ static double op_log2(double a, double b)
   return log(a) / log(b);
 }
 
+static double op_identity(double a)
+{
+  return a;
+}
+
+static double op_bool(double a)
+{
+  return a ? 1.0 : 0.0;
+}
+
 static double op_lerp(double a, double b, double x)
 {
   return a * (1.0 - x) + b * x;
@@ -381,7 +398,13 @@ typedef struct BuiltinConstDef {
 } BuiltinConstDef;
 
 static BuiltinConstDef builtin_consts[] = {
-    {"pi", M_PI}, {"True", 1.0}, {"False", 0.0}, {NULL, 0.0}};
+    {"pi", M_PI},
+    {"tau", 2.0 * M_PI},
+    {"e", M_E},
+    {"True", 1.0},
+    {"False", 0.0},
+    {NULL, 0.0},
+};
 
 typedef struct BuiltinOpDef {
   const char *name;
@@ -406,6 +429,8 @@ static BuiltinOpDef builtin_ops[] = {
     {"trunc", OPCODE_FUNC1, trunc},
     {"round", OPCODE_FUNC1, round},
     {"int", OPCODE_FUNC1, trunc},
+    {"float", OPCODE_FUNC1, op_identity},
+    {"bool", OPCODE_FUNC1, op_bool},
     {"sin", OPCODE_FUNC1, sin},
     {"cos", OPCODE_FUNC1, cos},
     {"tan", OPCODE_FUNC1, tan},
@@ -413,9 +438,21 @@ static BuiltinOpDef builtin_ops[] = {
     {"acos", OPCODE_FUNC1, acos},
     {"atan", OPCODE_FUNC1, atan},
     {"atan2", OPCODE_FUNC2, atan2},
+    {"sinh", OPCODE_FUNC1, sinh},
+    {"cosh", OPCODE_FUNC1, cosh},
+    {"tanh", OPCODE_FUNC1, tanh},
+    {"asinh", OPCODE_FUNC1, asinh},
+    {"acosh", OPCODE_FUNC1, acosh},
+    {"atanh", OPCODE_FUNC1, atanh},
+    {"hypot", OPCODE_FUNC2, hypot},
+    {"copysign", OPCODE_FUNC2, copysign},
     {"exp", OPCODE_FUNC1, exp},
+    {"expm1", OPCODE_FUNC1, expm1},
     {"log", OPCODE_FUNC1, log},
     {"log", OPCODE_FUNC2, op_log2},
+    {"log2", OPCODE_FUNC1, log2},
+    {"log10", OPCODE_FUNC1, log10},
+    {"log1p", OPCODE_FUNC1, log1p},
     {"sqrt", OPCODE_FUNC1, sqrt},
     {"pow", OPCODE_FUNC2, pow},
     {"fmod", OPCODE_FUNC2, fmod},
@@ -478,6 +515,8 @@ typedef struct ExprParseState {
   /* Original expression */
   const char *expr;
   const char *cur;
+  /* Start of the current token, to report where parsing failed. */
+  const char *token_start;
 
   /* Current token */
   short token;
@@ -634,6 +673,8 @@ static bool parse_next_token(ExprParseState *state)
     state->cur++;
   }
 
+  state->token_start = state->cur;
+
   /* End of string. */
   if (*state->cur == 0) {
     state->token = 0;
@@ -1084,6 +1125,8 @@ ExprPyLike_Parsed *BLI_expr_pylike_parse(const char *expression,
   else {
     /* Always return a non-NULL object so that parse failure can be cached. */
     expr = MEM_callocN(sizeof(ExprPyLike_Parsed), "ExprPyLike_Parsed(empty)");
+    expr->error_offset = (int)((state.token_start ? state.token_start : state.cur) -
+                               state.expr);
   }
 
   MEM_freeN(state.tokenbuf);
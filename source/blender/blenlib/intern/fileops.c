@@ -47,12 +47,16 @@
 #include "BLI_utildefines.h"
 
 size_t BLI_file_zstd_from_mem_at_pos(
-    void *buf, size_t len, FILE *file, size_t file_offset, int compression_level)
+    void *buf, size_t len, FILE *file, size_t file_offset, int compression_level, int num_threads)
 {
   fseek(file, file_offset, SEEK_SET);
 
   ZSTD_CCtx *ctx = ZSTD_createCCtx();
   ZSTD_CCtx_setParameter(ctx, ZSTD_c_compressionLevel, compression_level);
+  if (num_threads > 1) {
+    /* Fails without multi-threading support, compression is then done on the calling thread. */
+    ZSTD_CCtx_setParameter(ctx, ZSTD_c_nbWorkers, num_threads);
+  }
 
   ZSTD_inBuffer input = {buf, len, 0};
 
@@ -12,9 +12,14 @@
 #include "BLI_endian_switch.h"
 #include "BLI_filereader.h"
 #include "BLI_math_base.h"
+#include "BLI_task.h"
 
 #include "MEM_guardedalloc.h"
 
+/* Number of frames that are decompressed at once. The frames written by Blender are 1 MB in size
+ * when decompressed. */
+#define ZSTD_READ_AHEAD_FRAMES 8
+
 typedef struct {
   FileReader reader;
 
@@ -29,8 +34,11 @@ typedef struct {
     size_t *compressed_ofs;
     size_t *uncompressed_ofs;
 
-    char *cached_content;
-    int cached_frame;
+    /* Frames are decompressed in batches of consecutive frames, in parallel. Since the file is
+     * usually read sequentially, the following frames are needed soon. */
+    char *cached_content[ZSTD_READ_AHEAD_FRAMES];
+    int cached_first_frame;
+    int cached_frames_num;
   } seek;
 } ZstdReader;
 
@@ -126,7 +134,8 @@ static bool zstd_read_seek_table(ZstdReader *zstd)
     return false;
   }
 
-  zstd->seek.cached_frame = -1;
+  zstd->seek.cached_first_frame = -1;
+  zstd->seek.cached_frames_num = 0;
 
   return true;
 }
@@ -154,41 +163,100 @@ static int zstd_frame_from_pos(ZstdReader *zstd, size_t pos)
   return low;
 }
 
-/* Ensure that the currently loaded frame is the correct one. */
-static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
+static void zstd_free_cache(ZstdReader *zstd)
 {
-  if (zstd->seek.cached_frame == frame) {
-    /* Cached frame matches, so just return it. */
-    return zstd->seek.cached_content;
+  for (int i = 0; i < zstd->seek.cached_frames_num; i++) {
+    MEM_SAFE_FREE(zstd->seek.cached_content[i]);
   }
+  zstd->seek.cached_first_frame = -1;
+  zstd->seek.cached_frames_num = 0;
+}
 
-  /* Cached frame doesn't match, so discard it and cache the wanted one instead. */
-  MEM_SAFE_FREE(zstd->seek.cached_content);
+typedef struct ZstdDecompressFramesData {
+  ZstdReader *zstd;
+  /* Compressed data of all frames in the batch, they are stored contiguously in the file. */
+  const char *compressed_data;
+  int first_frame;
+  bool *r_errors;
+} ZstdDecompressFramesData;
+
+static void zstd_decompress_frame_task(void *__restrict userdata,
+                                       const int index,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ZstdDecompressFramesData *data = userdata;
+  ZstdReader *zstd = data->zstd;
+  const int frame = data->first_frame + index;
 
-  size_t compressed_size = zstd->seek.compressed_ofs[frame + 1] - zstd->seek.compressed_ofs[frame];
+  const size_t *compressed_ofs = zstd->seek.compressed_ofs;
+  size_t compressed_size = compressed_ofs[frame + 1] - compressed_ofs[frame];
   size_t uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
                              zstd->seek.uncompressed_ofs[frame];
+  const char *compressed_data = data->compressed_data + compressed_ofs[frame] -
+                                compressed_ofs[data->first_frame];
 
   char *uncompressed_data = MEM_mallocN(uncompressed_size, __func__);
+  /* The shared decompression context can't be used from multiple threads. */
+  size_t res = ZSTD_decompress(
+      uncompressed_data, uncompressed_size, compressed_data, compressed_size);
+  if (ZSTD_isError(res) || res < uncompressed_size) {
+    MEM_freeN(uncompressed_data);
+    data->r_errors[index] = true;
+    return;
+  }
+  zstd->seek.cached_content[index] = uncompressed_data;
+}
+
+/* Ensure that the given frame is loaded. If it is not, it is decompressed together with the
+ * following frames. */
+static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
+{
+  const int cached_index = frame - zstd->seek.cached_first_frame;
+  if (zstd->seek.cached_first_frame != -1 && cached_index >= 0 &&
+      cached_index < zstd->seek.cached_frames_num) {
+    /* Cached frame matches, so just return it. */
+    return zstd->seek.cached_content[cached_index];
+  }
+
+  /* Cached frames don't match, so discard them and cache the wanted ones instead. */
+  zstd_free_cache(zstd);
+
+  const int frames_num = min_ii(ZSTD_READ_AHEAD_FRAMES, zstd->seek.num_frames - frame);
+  size_t compressed_size = zstd->seek.compressed_ofs[frame + frames_num] -
+                           zstd->seek.compressed_ofs[frame];
+
   char *compressed_data = MEM_mallocN(compressed_size, __func__);
   if (zstd->base->seek(zstd->base, zstd->seek.compressed_ofs[frame], SEEK_SET) < 0 ||
       zstd->base->read(zstd->base, compressed_data, compressed_size) < compressed_size) {
     MEM_freeN(compressed_data);
-    MEM_freeN(uncompressed_data);
     return NULL;
   }
 
-  size_t res = ZSTD_decompressDCtx(
-      zstd->ctx, uncompressed_data, uncompressed_size, compressed_data, compressed_size);
+  bool errors[ZSTD_READ_AHEAD_FRAMES] = {false};
+  ZstdDecompressFramesData data = {zstd, compressed_data, frame, errors};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = frames_num > 1;
+  BLI_task_parallel_range(0, frames_num, &data, zstd_decompress_frame_task, &settings);
   MEM_freeN(compressed_data);
-  if (ZSTD_isError(res) || res < uncompressed_size) {
-    MEM_freeN(uncompressed_data);
+
+  zstd->seek.cached_first_frame = frame;
+  zstd->seek.cached_frames_num = frames_num;
+  if (errors[0]) {
+    zstd_free_cache(zstd);
     return NULL;
   }
-
-  zstd->seek.cached_frame = frame;
-  zstd->seek.cached_content = uncompressed_data;
-  return uncompressed_data;
+  /* Only keep the frames up to the first one that failed to decompress. */
+  for (int i = 1; i < frames_num; i++) {
+    if (errors[i]) {
+      for (int j = i; j < frames_num; j++) {
+        MEM_SAFE_FREE(zstd->seek.cached_content[j]);
+      }
+      zstd->seek.cached_frames_num = i;
+      break;
+    }
+  }
+  return zstd->seek.cached_content[0];
 }
 
 static ssize_t zstd_read_seekable(FileReader *reader, void *buffer, size_t size)
@@ -281,7 +349,7 @@ static void zstd_close(FileReader *reader)
   if (zstd->reader.seek) {
     MEM_freeN(zstd->seek.uncompressed_ofs);
     MEM_freeN(zstd->seek.compressed_ofs);
-    MEM_freeN(zstd->seek.cached_content);
+    zstd_free_cache(zstd);
   }
   else {
     MEM_freeN((void *)zstd->in_buf.src);
@@ -0,0 +1,411 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ *
+ * A hash-map with open addressing, see #BLI_flathash.h.
+ *
+ * The slots are probed the same way as #blender::Map does, which works well for the simple
+ * hash functions used by #GHash (e.g. #BLI_ghashutil_ptrhash), since all bits of the hash are
+ * used eventually. Removed keys leave a tombstone behind, which are only reclaimed when the
+ * slot array is rebuilt.
+ */
+
+#include <string.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_flathash.h"
+#include "BLI_utildefines.h"
+
+#include "BLI_strict_flags.h"
+
+enum {
+  FLATHASH_SLOT_EMPTY = 0,
+  FLATHASH_SLOT_OCCUPIED = 1,
+  FLATHASH_SLOT_REMOVED = 2,
+};
+
+typedef struct FlatHashSlot {
+  void *key;
+  void *val;
+  uint hash;
+  uint state;
+} FlatHashSlot;
+
+struct FlatHash {
+  GHashHashFP hashfp;
+  GHashCmpFP cmpfp;
+
+  FlatHashSlot *slots;
+  /** The number of slots minus one, the number of slots is a power of two. */
+  uint slots_mask;
+  /** Number of occupied slots. */
+  uint len;
+  /** Number of slots that are not empty, including removed ones. */
+  uint slots_used;
+  const char *info;
+};
+
+#define FLATHASH_MIN_SLOTS 8
+
+#define FLATHASH_PROBE_BEGIN(fh, hash, slot_index) \
+  { \
+    uint _perturb = (hash); \
+    uint _probe = (hash); \
+    while (true) { \
+      const uint slot_index = _probe & (fh)->slots_mask;
+
+#define FLATHASH_PROBE_END() \
+  _perturb >>= 5; \
+  _probe = 5 * _probe + 1 + _perturb; \
+  } \
+  } \
+  ((void)0)
+
+/* -------------------------------------------------------------------- */
+/** \name Internal Utility API
+ * \{ */
+
+/** Slots are never more than half used, to keep the probing sequences short. */
+static uint flathash_slots_num_for_len(const uint len)
+{
+  uint slots_num = FLATHASH_MIN_SLOTS;
+  while (slots_num / 2 < len) {
+    slots_num *= 2;
+  }
+  return slots_num;
+}
+
+static void flathash_slots_alloc(FlatHash *fh, const uint slots_num)
+{
+  fh->slots = MEM_calloc_arrayN(slots_num, sizeof(*fh->slots), fh->info);
+  fh->slots_mask = slots_num - 1;
+  fh->slots_used = 0;
+}
+
+/** Insert into a slot array without removed slots, for a key that is not in the hash. */
+static void flathash_insert_new_slot(FlatHash *fh, void *key, void *val, const uint hash)
+{
+  FLATHASH_PROBE_BEGIN (fh, hash, slot_index) {
+    FlatHashSlot *slot = &fh->slots[slot_index];
+    if (slot->state == FLATHASH_SLOT_EMPTY) {
+      slot->key = key;
+      slot->val = val;
+      slot->hash = hash;
+      slot->state = FLATHASH_SLOT_OCCUPIED;
+      fh->slots_used++;
+      return;
+    }
+  }
+  FLATHASH_PROBE_END();
+}
+
+/**
+ * Rebuild the slot array so that one more key can be added, also reclaiming removed slots.
+ */
+static void flathash_grow_for_insert(FlatHash *fh)
+{
+  if ((fh->slots_used + 1) <= (fh->slots_mask + 1) / 2) {
+    return;
+  }
+
+  FlatHashSlot *slots_old = fh->slots;
+  const uint slots_num_old = fh->slots_mask + 1;
+  /* Double the size when the slots are mostly occupied, otherwise only reclaim removed ones. */
+  flathash_slots_alloc(fh, flathash_slots_num_for_len((fh->len + 1) * 2));
+
+  for (uint i = 0; i < slots_num_old; i++) {
+    const FlatHashSlot *slot = &slots_old[i];
+    if (slot->state == FLATHASH_SLOT_OCCUPIED) {
+      flathash_insert_new_slot(fh, slot->key, slot->val, slot->hash);
+    }
+  }
+  MEM_freeN(slots_old);
+}
+
+BLI_INLINE FlatHashSlot *flathash_lookup_slot(const FlatHash *fh,
+                                              const void *key,
+                                              const uint hash)
+{
+  FLATHASH_PROBE_BEGIN (fh, hash, slot_index) {
+    FlatHashSlot *slot = &fh->slots[slot_index];
+    if (slot->state == FLATHASH_SLOT_EMPTY) {
+      return NULL;
+    }
+    if (slot->state == FLATHASH_SLOT_OCCUPIED && slot->hash == hash &&
+        fh->cmpfp(key, slot->key) == false) {
+      return slot;
+    }
+  }
+  FLATHASH_PROBE_END();
+}
+
+/**
+ * Find the slot of \a key, or the slot to insert it into when it isn't found.
+ * The hash must have room for one more key.
+ */
+static FlatHashSlot *flathash_lookup_slot_for_insert(FlatHash *fh,
+                                                     const void *key,
+                                                     const uint hash,
+                                                     bool *r_found)
+{
+  FlatHashSlot *slot_removed = NULL;
+  FLATHASH_PROBE_BEGIN (fh, hash, slot_index) {
+    FlatHashSlot *slot = &fh->slots[slot_index];
+    if (slot->state == FLATHASH_SLOT_EMPTY) {
+      *r_found = false;
+      if (slot_removed) {
+        return slot_removed;
+      }
+      fh->slots_used++;
+      return slot;
+    }
+    if (slot->state == FLATHASH_SLOT_REMOVED) {
+      if (slot_removed == NULL) {
+        slot_removed = slot;
+      }
+    }
+    else if (slot->hash == hash && fh->cmpfp(key, slot->key) == false) {
+      *r_found = true;
+      return slot;
+    }
+  }
+  FLATHASH_PROBE_END();
+}
+
+static void flathash_slot_free(FlatHashSlot *slot,
+                               GHashKeyFreeFP keyfreefp,
+                               GHashValFreeFP valfreefp)
+{
+  if (keyfreefp) {
+    keyfreefp(slot->key);
+  }
+  if (valfreefp) {
+    valfreefp(slot->val);
+  }
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Public API
+ * \{ */
+
+FlatHash *BLI_flathash_new_ex(GHashHashFP hashfp,
+                              GHashCmpFP cmpfp,
+                              const char *info,
+                              const uint nentries_reserve)
+{
+  FlatHash *fh = MEM_mallocN(sizeof(*fh), info);
+  fh->hashfp = hashfp;
+  fh->cmpfp = cmpfp;
+  fh->info = info;
+  fh->len = 0;
+  flathash_slots_alloc(fh, flathash_slots_num_for_len(nentries_reserve));
+  return fh;
+}
+
+FlatHash *BLI_flathash_new(GHashHashFP hashfp, GHashCmpFP cmpfp, const char *info)
+{
+  return BLI_flathash_new_ex(hashfp, cmpfp, info, 0);
+}
+
+void BLI_flathash_clear(FlatHash *fh, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp)
+{
+  const uint slots_num = fh->slots_mask + 1;
+  if (keyfreefp || valfreefp) {
+    for (uint i = 0; i < slots_num; i++) {
+      FlatHashSlot *slot = &fh->slots[i];
+      if (slot->state == FLATHASH_SLOT_OCCUPIED) {
+        flathash_slot_free(slot, keyfreefp, valfreefp);
+      }
+    }
+  }
+  memset(fh->slots, 0, sizeof(*fh->slots) * slots_num);
+  fh->len = 0;
+  fh->slots_used = 0;
+}
+
+void BLI_flathash_free(FlatHash *fh, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp)
+{
+  if (keyfreefp || valfreefp) {
+    BLI_flathash_clear(fh, keyfreefp, valfreefp);
+  }
+  MEM_freeN(fh->slots);
+  MEM_freeN(fh);
+}
+
+void BLI_flathash_insert(FlatHash *fh, void *key, void *val)
+{
+  const uint hash = fh->hashfp(key);
+  BLI_assert(!BLI_flathash_haskey(fh, key));
+  flathash_grow_for_insert(fh);
+  bool found;
+  FlatHashSlot *slot = flathash_lookup_slot_for_insert(fh, key, hash, &found);
+  slot->key = key;
+  slot->val = val;
+  if (!found) {
+    slot->hash = hash;
+    slot->state = FLATHASH_SLOT_OCCUPIED;
+    fh->len++;
+  }
+}
+
+bool BLI_flathash_reinsert(
+    FlatHash *fh, void *key, void *val, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp)
+{
+  const uint hash = fh->hashfp(key);
+  flathash_grow_for_insert(fh);
+  bool found;
+  FlatHashSlot *slot = flathash_lookup_slot_for_insert(fh, key, hash, &found);
+  if (found) {
+    flathash_slot_free(slot, keyfreefp, valfreefp);
+  }
+  else {
+    slot->hash = hash;
+    slot->state = FLATHASH_SLOT_OCCUPIED;
+    fh->len++;
+  }
+  slot->key = key;
+  slot->val = val;
+  return !found;
+}
+
+void *BLI_flathash_lookup(const FlatHash *fh, const void *key)
+{
+  const FlatHashSlot *slot = flathash_lookup_slot(fh, key, fh->hashfp(key));
+  return slot ? slot->val : NULL;
+}
+
+void **BLI_flathash_lookup_p(FlatHash *fh, const void *key)
+{
+  FlatHashSlot *slot = flathash_lookup_slot(fh, key, fh->hashfp(key));
+  return slot ? &slot->val : NULL;
+}
+
+bool BLI_flathash_ensure_p(FlatHash *fh, void *key, void ***r_val)
+{
+  const uint hash = fh->hashfp(key);
+  flathash_grow_for_insert(fh);
+  bool found;
+  FlatHashSlot *slot = flathash_lookup_slot_for_insert(fh, key, hash, &found);
+  if (!found) {
+    slot->key = key;
+    slot->val = NULL;
+    slot->hash = hash;
+    slot->state = FLATHASH_SLOT_OCCUPIED;
+    fh->len++;
+  }
+  *r_val = &slot->val;
+  return found;
+}
+
+bool BLI_flathash_add(FlatHash *fh, void *key)
+{
+  void **val_p;
+  return !BLI_flathash_ensure_p(fh, key, &val_p);
+}
+
+bool BLI_flathash_remove(FlatHash *fh,
+                         const void *key,
+                         GHashKeyFreeFP keyfreefp,
+                         GHashValFreeFP valfreefp)
+{
+  FlatHashSlot *slot = flathash_lookup_slot(fh, key, fh->hashfp(key));
+  if (slot == NULL) {
+    return false;
+  }
+  flathash_slot_free(slot, keyfreefp, valfreefp);
+  slot->key = NULL;
+  slot->val = NULL;
+  slot->state = FLATHASH_SLOT_REMOVED;
+  fh->len--;
+  return true;
+}
+
+bool BLI_flathash_haskey(const FlatHash *fh, const void *key)
+{
+  return flathash_lookup_slot(fh, key, fh->hashfp(key)) != NULL;
+}
+
+uint BLI_flathash_len(const FlatHash *fh)
+{
+  return fh->len;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Iterator API
+ * \{ */
+
+static void flathash_iterator_find_occupied(FlatHashIterator *fhi)
+{
+  const uint slots_num = fhi->fh->slots_mask + 1;
+  for (; fhi->slot_index < slots_num; fhi->slot_index++) {
+    FlatHashSlot *slot = &fhi->fh->slots[fhi->slot_index];
+    if (slot->state == FLATHASH_SLOT_OCCUPIED) {
+      fhi->slot = slot;
+      return;
+    }
+  }
+  fhi->slot = NULL;
+}
+
+void BLI_flathashIterator_init(FlatHashIterator *fhi, const FlatHash *fh)
+{
+  fhi->fh = fh;
+  fhi->slot_index = 0;
+  flathash_iterator_find_occupied(fhi);
+}
+
+void BLI_flathashIterator_step(FlatHashIterator *fhi)
+{
+  BLI_assert(fhi->slot != NULL);
+  fhi->slot_index++;
+  flathash_iterator_find_occupied(fhi);
+}
+
+void *BLI_flathashIterator_getKey(const FlatHashIterator *fhi)
+{
+  return fhi->slot->key;
+}
+
+void *BLI_flathashIterator_getValue(const FlatHashIterator *fhi)
+{
+  return fhi->slot->val;
+}
+
+void **BLI_flathashIterator_getValue_p(FlatHashIterator *fhi)
+{
+  return &fhi->slot->val;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Convenience FlatHash Creation Functions
+ * \{ */
+
+FlatHash *BLI_flathash_ptr_new_ex(const char *info, const uint nentries_reserve)
+{
+  return BLI_flathash_new_ex(BLI_ghashutil_ptrhash, BLI_ghashutil_ptrcmp, info, nentries_reserve);
+}
+
+FlatHash *BLI_flathash_ptr_new(const char *info)
+{
+  return BLI_flathash_ptr_new_ex(info, 0);
+}
+
+FlatHash *BLI_flathash_str_new_ex(const char *info, const uint nentries_reserve)
+{
+  return BLI_flathash_new_ex(BLI_ghashutil_strhash_p, BLI_ghashutil_strcmp, info, nentries_reserve);
+}
+
+FlatHash *BLI_flathash_int_new(const char *info)
+{
+  return BLI_flathash_new_ex(BLI_ghashutil_inthash_p, BLI_ghashutil_intcmp, info, 0);
+}
+
+/** \} */
@@ -8,6 +8,7 @@
 
 #include "BLI_kdtree_impl.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_strict_flags.h"
 #include "BLI_utildefines.h"
 
@@ -42,6 +43,11 @@ struct KDTree {
 #define KD_NEAR_ALLOC_INC 100 /* alloc increment for collecting nearest */
 #define KD_FOUND_ALLOC_INC 50 /* alloc increment for collecting nearest */
 
+/** Sub-trees with more nodes than this are balanced level by level, one task per sub-tree. */
+#define KD_BALANCE_PARALLEL_THRESHOLD 8192
+/** Number of searches done by a single task of the multi-threaded searches. */
+#define KD_BATCH_CHUNK_SIZE 256
+
 #define KD_NODE_UNSET ((uint)-1)
 
 /**
@@ -131,19 +137,14 @@ void BLI_kdtree_nd_(insert)(KDTree *tree, int index, const float co[KD_DIMS])
 #endif
 }
 
-static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+/**
+ * Partition the nodes around the median on \a axis, returns the position of the median.
+ */
+static uint kdtree_balance_partition(KDTreeNode *nodes, uint nodes_len, uint axis)
 {
-  KDTreeNode *node;
   float co;
   uint left, right, median, i, j;
 
-  if (nodes_len <= 0) {
-    return KD_NODE_UNSET;
-  }
-  else if (nodes_len == 1) {
-    return 0 + ofs;
-  }
-
   /* Quick-sort style sorting around median. */
   left = 0;
   right = nodes_len - 1;
@@ -176,6 +177,23 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
     }
   }
 
+  return median;
+}
+
+static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+{
+  KDTreeNode *node;
+  uint median;
+
+  if (nodes_len <= 0) {
+    return KD_NODE_UNSET;
+  }
+  else if (nodes_len == 1) {
+    return 0 + ofs;
+  }
+
+  median = kdtree_balance_partition(nodes, nodes_len, axis);
+
   /* Set node and sort sub-nodes. */
   node = &nodes[median];
   node->d = axis;
@@ -187,6 +205,117 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
   return median + ofs;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Multi-Threaded Balancing
+ *
+ * The root of a sub-tree only depends on the range of nodes it is built from, so the sub-trees
+ * of a level can be balanced independently. The top levels are partitioned level by level with
+ * one task per sub-tree, the remaining sub-trees are balanced recursively by a task each.
+ * The resulting tree is the same as #kdtree_balance creates.
+ * \{ */
+
+typedef struct KDBalanceRange {
+  uint ofs, len;
+} KDBalanceRange;
+
+typedef struct KDBalanceData {
+  KDTreeNode *nodes;
+  const KDBalanceRange *ranges;
+  uint axis;
+  /** Balance the whole sub-tree of every range, instead of only partitioning it. */
+  bool is_last_level;
+} KDBalanceData;
+
+/** The root of the sub-tree built from a range, see #kdtree_balance. */
+static uint kdtree_balance_range_root(const uint ofs, const uint len)
+{
+  return (len == 0) ? KD_NODE_UNSET : ofs + len / 2;
+}
+
+static void kdtree_balance_range_cb(void *__restrict userdata,
+                                     const int range_index,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KDBalanceData *data = userdata;
+  const KDBalanceRange range = data->ranges[range_index];
+
+  if (data->is_last_level) {
+    kdtree_balance(data->nodes + range.ofs, range.len, data->axis, range.ofs);
+    return;
+  }
+  if (range.len <= 1) {
+    return;
+  }
+
+  const uint median = kdtree_balance_partition(data->nodes + range.ofs, range.len, data->axis);
+  BLI_assert(median == range.len / 2);
+  KDTreeNode *node = &data->nodes[range.ofs + median];
+  node->d = data->axis;
+  node->left = kdtree_balance_range_root(range.ofs, median);
+  node->right = kdtree_balance_range_root(range.ofs + median + 1, range.len - (median + 1));
+}
+
+static uint kdtree_balance_parallel(KDTreeNode *nodes, uint nodes_len)
+{
+  /* A level has one range per sub-tree, the size of the sub-trees differ by one at most. */
+  uint ranges_len_capacity = 1;
+  while (nodes_len / ranges_len_capacity > KD_BALANCE_PARALLEL_THRESHOLD) {
+    ranges_len_capacity *= 2;
+  }
+  KDBalanceRange *ranges = MEM_mallocN(sizeof(*ranges) * ranges_len_capacity, __func__);
+  KDBalanceRange *ranges_next = MEM_mallocN(sizeof(*ranges) * ranges_len_capacity, __func__);
+  uint ranges_len = 1;
+  ranges[0].ofs = 0;
+  ranges[0].len = nodes_len;
+
+  KDBalanceData data = {
+      .nodes = nodes,
+      .ranges = ranges,
+      .axis = 0,
+      .is_last_level = false,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+
+  while (true) {
+    data.ranges = ranges;
+    data.is_last_level = (ranges[0].len <= KD_BALANCE_PARALLEL_THRESHOLD) ||
+                         (ranges_len * 2 > ranges_len_capacity);
+    BLI_task_parallel_range(0, (int)ranges_len, &data, kdtree_balance_range_cb, &settings);
+    if (data.is_last_level) {
+      break;
+    }
+
+    uint ranges_next_len = 0;
+    for (uint i = 0; i < ranges_len; i++) {
+      const KDBalanceRange range = ranges[i];
+      const uint median = range.len / 2;
+      if (median > 0) {
+        ranges_next[ranges_next_len].ofs = range.ofs;
+        ranges_next[ranges_next_len].len = median;
+        ranges_next_len++;
+      }
+      if (median + 1 < range.len) {
+        ranges_next[ranges_next_len].ofs = range.ofs + median + 1;
+        ranges_next[ranges_next_len].len = range.len - (median + 1);
+        ranges_next_len++;
+      }
+    }
+    SWAP(KDBalanceRange *, ranges, ranges_next);
+    ranges_len = ranges_next_len;
+    data.axis = (data.axis + 1) % KD_DIMS;
+  }
+
+  MEM_freeN(ranges);
+  MEM_freeN(ranges_next);
+
+  return kdtree_balance_range_root(0, nodes_len);
+}
+
+/** \} */
+
 void BLI_kdtree_nd_(balance)(KDTree *tree)
 {
   if (tree->root != KD_NODE_ROOT_IS_INIT) {
@@ -196,7 +325,12 @@ void BLI_kdtree_nd_(balance)(KDTree *tree)
     }
   }
 
-  tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  if (tree->nodes_len > KD_BALANCE_PARALLEL_THRESHOLD) {
+    tree->root = kdtree_balance_parallel(tree->nodes, tree->nodes_len);
+  }
+  else {
+    tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  }
 
 #ifdef DEBUG
   tree->is_balanced = true;
@@ -792,6 +926,123 @@ finally:
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Batched Searches
+ * \{ */
+
+static void kdtree_batch_settings_init(TaskParallelSettings *settings, const int co_len)
+{
+  BLI_parallel_range_settings_defaults(settings);
+  settings->use_threading = (co_len > KD_BATCH_CHUNK_SIZE);
+  settings->min_iter_per_thread = KD_BATCH_CHUNK_SIZE;
+}
+
+typedef struct KDNearestBatchData {
+  const KDTree *tree;
+  const float (*co)[KD_DIMS];
+  KDTreeNearest *nearest;
+} KDNearestBatchData;
+
+static void kdtree_find_nearest_batch_cb(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KDNearestBatchData *data = userdata;
+  KDTreeNearest *nearest = &data->nearest[i];
+  if (BLI_kdtree_nd_(find_nearest)(data->tree, data->co[i], nearest) == -1) {
+    nearest->index = -1;
+    nearest->dist = FLT_MAX;
+  }
+}
+
+/**
+ * Multi-threaded version of #BLI_kdtree_3d_find_nearest, finding the nearest point of every
+ * coordinate in \a co.
+ *
+ * \param r_nearest: An array of \a co_len results, the index is -1 when no point was found.
+ */
+void BLI_kdtree_nd_(find_nearest_batch)(const KDTree *tree,
+                                        const float (*co)[KD_DIMS],
+                                        const int co_len,
+                                        KDTreeNearest *r_nearest)
+{
+  KDNearestBatchData data = {
+      .tree = tree,
+      .co = co,
+      .nearest = r_nearest,
+  };
+  TaskParallelSettings settings;
+  kdtree_batch_settings_init(&settings, co_len);
+  BLI_task_parallel_range(0, co_len, &data, kdtree_find_nearest_batch_cb, &settings);
+}
+
+typedef struct KDRangeSearchBatchData {
+  const KDTree *tree;
+  const float (*co)[KD_DIMS];
+  float range;
+  bool (*search_cb)(
+      void *user_data, int co_index, int index, const float co[KD_DIMS], float dist_sq);
+  void *user_data;
+} KDRangeSearchBatchData;
+
+typedef struct KDRangeSearchBatchQuery {
+  const KDRangeSearchBatchData *data;
+  int co_index;
+} KDRangeSearchBatchQuery;
+
+static bool kdtree_range_search_batch_query_cb(void *user_data,
+                                               const int index,
+                                               const float co[KD_DIMS],
+                                               const float dist_sq)
+{
+  const KDRangeSearchBatchQuery *query = user_data;
+  return query->data->search_cb(query->data->user_data, query->co_index, index, co, dist_sq);
+}
+
+static void kdtree_range_search_batch_cb(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KDRangeSearchBatchData *data = userdata;
+  KDRangeSearchBatchQuery query = {
+      .data = data,
+      .co_index = i,
+  };
+  BLI_kdtree_nd_(range_search_cb)(
+      data->tree, data->co[i], data->range, kdtree_range_search_batch_query_cb, &query);
+}
+
+/**
+ * Multi-threaded version of #BLI_kdtree_3d_range_search_cb, searching around every coordinate in
+ * \a co.
+ *
+ * \param search_cb: Called for every node found in \a range of the coordinate at \a co_index,
+ * false return value stops the search of that coordinate.
+ * It's called from multiple threads, though never for the same coordinate at the same time.
+ */
+void BLI_kdtree_nd_(range_search_batch_cb)(
+    const KDTree *tree,
+    const float (*co)[KD_DIMS],
+    const int co_len,
+    const float range,
+    bool (*search_cb)(
+        void *user_data, int co_index, int index, const float co[KD_DIMS], float dist_sq),
+    void *user_data)
+{
+  KDRangeSearchBatchData data = {
+      .tree = tree,
+      .co = co,
+      .range = range,
+      .search_cb = search_cb,
+      .user_data = user_data,
+  };
+  TaskParallelSettings settings;
+  kdtree_batch_settings_init(&settings, co_len);
+  BLI_task_parallel_range(0, co_len, &data, kdtree_range_search_batch_cb, &settings);
+}
+
+/** \} */
+
 /**
  * Use when we want to loop over nodes ordered by index.
  * Requires indices to be aligned with nodes.
@@ -823,6 +1074,68 @@ struct DeDuplicateParams {
   int search;
 };
 
+typedef struct DeDuplicateNeighborData {
+  const KDTree *tree;
+  float range;
+  /** Per node, false when there are no other nodes in range, so there is nothing to merge. */
+  bool *has_neighbors;
+} DeDuplicateNeighborData;
+
+typedef struct DeDuplicateNeighborQuery {
+  int search;
+  bool found;
+} DeDuplicateNeighborQuery;
+
+static bool deduplicate_neighbor_search_cb(void *user_data,
+                                           const int index,
+                                           const float UNUSED(co[KD_DIMS]),
+                                           const float UNUSED(dist_sq))
+{
+  DeDuplicateNeighborQuery *query = user_data;
+  if (index != query->search) {
+    query->found = true;
+    return false;
+  }
+  return true;
+}
+
+static void deduplicate_neighbor_task_cb(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const DeDuplicateNeighborData *data = userdata;
+  const KDTreeNode *node = &data->tree->nodes[i];
+  DeDuplicateNeighborQuery query = {
+      .search = node->index,
+      .found = false,
+  };
+  BLI_kdtree_nd_(range_search_cb)(
+      data->tree, node->co, data->range, deduplicate_neighbor_search_cb, &query);
+  data->has_neighbors[i] = query.found;
+}
+
+/**
+ * Find the nodes that have other nodes in range in parallel, so that the order dependent search
+ * of #BLI_kdtree_3d_calc_duplicates_fast can skip the others.
+ * Returns null when the tree is too small to benefit from it.
+ */
+static bool *deduplicate_find_neighbors(const KDTree *tree, const float range)
+{
+  if (tree->nodes_len <= KD_BALANCE_PARALLEL_THRESHOLD) {
+    return NULL;
+  }
+  DeDuplicateNeighborData data = {
+      .tree = tree,
+      .range = range,
+      .has_neighbors = MEM_mallocN(sizeof(bool) * tree->nodes_len, __func__),
+  };
+  TaskParallelSettings settings;
+  kdtree_batch_settings_init(&settings, (int)tree->nodes_len);
+  BLI_task_parallel_range(
+      0, (int)tree->nodes_len, &data, deduplicate_neighbor_task_cb, &settings);
+  return data.has_neighbors;
+}
+
 static void deduplicate_recursive(const struct DeDuplicateParams *p, uint i)
 {
   const KDTreeNode *node = &p->nodes[i];
@@ -883,12 +1196,17 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
       .duplicates = duplicates,
       .duplicates_found = &found,
   };
+  /* Searching nodes without neighbors never changes the result of the searches. */
+  bool *has_neighbors = deduplicate_find_neighbors(tree, range);
 
   if (use_index_order) {
     uint *order = kdtree_order(tree);
     for (uint i = 0; i < tree->nodes_len; i++) {
       const uint node_index = order[i];
       const int index = (int)i;
+      if (has_neighbors && !has_neighbors[node_index]) {
+        continue;
+      }
       if (ELEM(duplicates[index], -1, index)) {
         p.search = index;
         copy_vn_vn(p.search_co, tree->nodes[node_index].co);
@@ -906,6 +1224,9 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
     for (uint i = 0; i < tree->nodes_len; i++) {
       const uint node_index = i;
       const int index = p.nodes[node_index].index;
+      if (has_neighbors && !has_neighbors[node_index]) {
+        continue;
+      }
       if (ELEM(duplicates[index], -1, index)) {
         p.search = index;
         copy_vn_vn(p.search_co, tree->nodes[node_index].co);
@@ -918,6 +1239,7 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
       }
     }
   }
+  MEM_SAFE_FREE(has_neighbors);
   return found;
 }
 
@@ -8,6 +8,8 @@
 #ifdef WITH_GMP
 
 #  include <algorithm>
+#  include <array>
+#  include <atomic>
 #  include <fstream>
 #  include <iostream>
 #  include <memory>
@@ -16,6 +18,7 @@
 #  include "BLI_array.hh"
 #  include "BLI_assert.h"
 #  include "BLI_delaunay_2d.h"
+#  include "BLI_enumerable_thread_specific.hh"
 #  include "BLI_hash.hh"
 #  include "BLI_kdopbvh.h"
 #  include "BLI_map.hh"
@@ -297,6 +300,10 @@ std::ostream &operator<<(std::ostream &os, const Face *f)
  * It also keeps has a hash table of all Verts created so that it can
  * ensure that only one instance of a Vert with a given co_exact will
  * exist. I.e., it de-duplicates the vertices.
+ *
+ * The intersect phase creates Verts and Faces from many threads at once, so to avoid
+ * contention the Vert hash table is split into shards with their own lock (chosen by the
+ * hash of the Vert), and the Verts and Faces are owned by per-thread vectors.
  */
 class IMeshArena::IMeshArenaImpl : NonCopyable, NonMovable {
 
@@ -323,64 +330,82 @@ class IMeshArena::IMeshArenaImpl : NonCopyable, NonMovable {
     }
   };
 
-  Set<VSetKey> vset_;
+  /** Number of shards of the Vert hash table, must be a power of two. */
+  static constexpr int vset_shards_num_log2 = 6;
+  static constexpr int vset_shards_num = 1 << vset_shards_num_log2;
+
+  struct VSetShard {
+    Set<VSetKey> vset;
+    /* Need a lock when multi-threading to protect adding new elements. */
+#  ifdef USE_SPINLOCK
+    SpinLock lock;
+#  else
+    ThreadMutex *mutex;
+#  endif
+  };
+
+  std::array<VSetShard, vset_shards_num> vset_shards_;
 
   /**
-   * Ownership of the Vert memory is here, so destroying this reclaims that memory.
+   * Ownership of the Vert and Face memory is here, so destroying this reclaims that memory.
+   * Every thread appends to its own vectors, so that no lock is needed.
    *
    * TODO: replace these with pooled allocation, and just destroy the pools at the end.
    */
-  Vector<std::unique_ptr<Vert>> allocated_verts_;
-  Vector<std::unique_ptr<Face>> allocated_faces_;
+  struct Allocated {
+    Vector<std::unique_ptr<Vert>> verts;
+    Vector<std::unique_ptr<Face>> faces;
+  };
+  threading::EnumerableThreadSpecific<Allocated> allocated_;
 
   /* Use these to allocate ids when Verts and Faces are allocated. */
-  int next_vert_id_ = 0;
-  int next_face_id_ = 0;
-
-  /* Need a lock when multi-threading to protect allocation of new elements. */
-#  ifdef USE_SPINLOCK
-  SpinLock lock_;
-#  else
-  ThreadMutex *mutex_;
-#  endif
+  std::atomic<int> next_vert_id_ = 0;
+  std::atomic<int> next_face_id_ = 0;
 
  public:
   IMeshArenaImpl()
   {
     if (intersect_use_threading) {
+      for (VSetShard &shard : vset_shards_) {
 #  ifdef USE_SPINLOCK
-      BLI_spin_init(&lock_);
+        BLI_spin_init(&shard.lock);
 #  else
-      mutex_ = BLI_mutex_alloc();
+        shard.mutex = BLI_mutex_alloc();
 #  endif
+      }
     }
   }
   ~IMeshArenaImpl()
   {
     if (intersect_use_threading) {
+      for (VSetShard &shard : vset_shards_) {
 #  ifdef USE_SPINLOCK
-      BLI_spin_end(&lock_);
+        BLI_spin_end(&shard.lock);
 #  else
-      BLI_mutex_free(mutex_);
+        BLI_mutex_free(shard.mutex);
 #  endif
+      }
     }
   }
 
   void reserve(int vert_num_hint, int face_num_hint)
   {
-    vset_.reserve(vert_num_hint);
-    allocated_verts_.reserve(vert_num_hint);
-    allocated_faces_.reserve(face_num_hint);
+    for (VSetShard &shard : vset_shards_) {
+      shard.vset.reserve(vert_num_hint / vset_shards_num);
+    }
+    Allocated &allocated = allocated_.local();
+    allocated.verts.reserve(vert_num_hint);
+    allocated.faces.reserve(face_num_hint);
   }
 
   int tot_allocated_verts() const
   {
-    return allocated_verts_.size();
+    return next_vert_id_;
   }
 
   int tot_allocated_faces() const
   {
-    return allocated_faces_.size();
+    return next_face_id_;
   }
 
   const Vert *add_or_find_vert(const mpq3 &co, int orig)
@@ -403,21 +428,7 @@ class IMeshArena::IMeshArenaImpl : NonCopyable, NonMovable {
   Face *add_face(Span<const Vert *> verts, int orig, Span<int> edge_origs, Span<bool> is_intersect)
   {
     Face *f = new Face(verts, next_face_id_++, orig, edge_origs, is_intersect);
-    if (intersect_use_threading) {
-#  ifdef USE_SPINLOCK
-      BLI_spin_lock(&lock_);
-#  else
-      BLI_mutex_lock(mutex_);
-#  endif
-    }
-    allocated_faces_.append(std::unique_ptr<Face>(f));
-    if (intersect_use_threading) {
-#  ifdef USE_SPINLOCK
-      BLI_spin_unlock(&lock_);
-#  else
-      BLI_mutex_unlock(mutex_);
-#  endif
-    }
+    allocated_.local().faces.append(std::unique_ptr<Face>(f));
     return f;
   }
 
@@ -438,21 +449,10 @@ class IMeshArena::IMeshArenaImpl : NonCopyable, NonMovable {
   {
     Vert vtry(co, double3(co[0].get_d(), co[1].get_d(), co[2].get_d()), NO_INDEX, NO_INDEX);
     VSetKey vskey(&vtry);
-    if (intersect_use_threading) {
-#  ifdef USE_SPINLOCK
-      BLI_spin_lock(&lock_);
-#  else
-      BLI_mutex_lock(mutex_);
-#  endif
-    }
-    const VSetKey *lookup = vset_.lookup_key_ptr(vskey);
-    if (intersect_use_threading) {
-#  ifdef USE_SPINLOCK
-      BLI_spin_unlock(&lock_);
-#  else
-      BLI_mutex_unlock(mutex_);
-#  endif
-    }
+    VSetShard &shard = vset_shard(vskey);
+    lock_shard(shard);
+    const VSetKey *lookup = shard.vset.lookup_key_ptr(vskey);
+    unlock_shard(shard);
     if (!lookup) {
       return nullptr;
     }
@@ -469,73 +469,65 @@ class IMeshArena::IMeshArenaImpl : NonCopyable, NonMovable {
     Array<int> eorig(vs.size(), NO_INDEX);
     Array<bool> is_intersect(vs.size(), false);
     Face ftry(vs, NO_INDEX, NO_INDEX, eorig, is_intersect);
-    for (const int i : allocated_faces_.index_range()) {
-      if (ftry.cyclic_equal(*allocated_faces_[i])) {
-        return allocated_faces_[i].get();
+    for (const Allocated &allocated : allocated_) {
+      for (const std::unique_ptr<Face> &face : allocated.faces) {
+        if (ftry.cyclic_equal(*face)) {
+          return face.get();
+        }
       }
     }
     return nullptr;
   }
 
  private:
-  const Vert *add_or_find_vert(const mpq3 &mco, const double3 &dco, int orig)
+  VSetShard &vset_shard(const VSetKey &vskey)
+  {
+    /* Use the high bits of a multiplicative hash, the low bits of the hash are used by the
+     * shard's set itself. */
+    const uint64_t shard_hash = vskey.hash() * uint64_t(0x9E3779B97F4A7C15);
+    return vset_shards_[shard_hash >> (64 - vset_shards_num_log2)];
+  }
+
+  static void lock_shard(VSetShard &shard)
   {
-    Vert *vtry = new Vert(mco, dco, NO_INDEX, NO_INDEX);
-    const Vert *ans;
-    VSetKey vskey(vtry);
     if (intersect_use_threading) {
 #  ifdef USE_SPINLOCK
-      BLI_spin_lock(&lock_);
+      BLI_spin_lock(&shard.lock);
 #  else
-      BLI_mutex_lock(mutex_);
+      BLI_mutex_lock(shard.mutex);
 #  endif
     }
-    const VSetKey *lookup = vset_.lookup_key_ptr(vskey);
-    if (!lookup) {
-      vtry->id = next_vert_id_++;
-      vtry->orig = orig;
-      vskey.vert = vtry;  // new Vert(mco, dco, next_vert_id_++, orig);
-      vset_.add_new(vskey);
-      allocated_verts_.append(std::unique_ptr<Vert>(vskey.vert));
-      ans = vskey.vert;
-    }
-    else {
-      /* It was a duplicate, so return the existing one.
-       * Note that the returned Vert may have a different orig.
-       * This is the intended semantics: if the Vert already
-       * exists then we are merging verts and using the first-seen
-       * one as the canonical one. */
-      delete vtry;
-      ans = lookup->vert;
-    }
+  }
+
+  static void unlock_shard(VSetShard &shard)
+  {
     if (intersect_use_threading) {
 #  ifdef USE_SPINLOCK
-      BLI_spin_unlock(&lock_);
+      BLI_spin_unlock(&shard.lock);
 #  else
-      BLI_mutex_unlock(mutex_);
+      BLI_mutex_unlock(shard.mutex);
 #  endif
     }
-    return ans;
+  }
+
+  const Vert *add_or_find_vert(const mpq3 &mco, const double3 &dco, int orig)
+  {
+    Vert *vtry = new Vert(mco, dco, NO_INDEX, NO_INDEX);
+    vtry->orig = orig;
+    return add_or_find_vert_(vtry);
   };
 
   const Vert *add_or_find_vert_(Vert *vtry)
   {
     const Vert *ans;
     VSetKey vskey(vtry);
-    if (intersect_use_threading) {
-#  ifdef USE_SPINLOCK
-      BLI_spin_lock(&lock_);
-#  else
-      BLI_mutex_lock(mutex_);
-#  endif
-    }
-    const VSetKey *lookup = vset_.lookup_key_ptr(vskey);
+    VSetShard &shard = vset_shard(vskey);
+    lock_shard(shard);
+    const VSetKey *lookup = shard.vset.lookup_key_ptr(vskey);
     if (!lookup) {
       vtry->id = next_vert_id_++;
-      vskey.vert = vtry;  // new Vert(mco, dco, next_vert_id_++, orig);
-      vset_.add_new(vskey);
-      allocated_verts_.append(std::unique_ptr<Vert>(vskey.vert));
-      ans = vskey.vert;
+      shard.vset.add_new(vskey);
+      ans = vtry;
     }
     else {
       /* It was a duplicate, so return the existing one.
@@ -543,15 +535,14 @@ class IMeshArena::IMeshArenaImpl : NonCopyable, NonMovable {
        * This is the intended semantics: if the Vert already
        * exists then we are merging verts and using the first-seen
        * one as the canonical one. */
-      delete vtry;
       ans = lookup->vert;
     }
-    if (intersect_use_threading) {
-#  ifdef USE_SPINLOCK
-      BLI_spin_unlock(&lock_);
-#  else
-      BLI_mutex_unlock(mutex_);
-#  endif
+    unlock_shard(shard);
+    if (ans == vtry) {
+      allocated_.local().verts.append(std::unique_ptr<Vert>(vtry));
+    }
+    else {
+      delete vtry;
     }
     return ans;
   };
@@ -1140,6 +1131,41 @@ static int filter_plane_side(const double3 &p,
   return 0;
 }
 
+/**
+ * The index of the orientation test below, when the input coordinates have index 1:
+ * differences have index 2, each cross product coordinate has index 6,
+ * each product with a difference has index 9 and the sum of three of them has index 11.
+ */
+constexpr int index_orient3d = 11;
+
+/**
+ * Return the approximate sign of `dot(d - a, cross(b - a, c - a))`.
+ * The answer is 1 or -1 if the sign is certain, 0 if the exact sign has to be computed.
+ */
+static int filter_orient3d(const double3 &a, const double3 &b, const double3 &c, const double3 &d)
+{
+  const double3 ba = b - a;
+  const double3 ca = c - a;
+  const double3 ad = d - a;
+  const double3 n(ba.y * ca.z - ba.z * ca.y, ba.z * ca.x - ba.x * ca.z, ba.x * ca.y - ba.y * ca.x);
+  const double det = math::dot(ad, n);
+  if (det == 0.0) {
+    return 0;
+  }
+  const double3 abs_a = math::abs(a);
+  const double3 sup_ba = math::abs(b) + abs_a;
+  const double3 sup_ca = math::abs(c) + abs_a;
+  const double3 sup_ad = math::abs(d) + abs_a;
+  const double3 sup_n(sup_ba.y * sup_ca.z + sup_ba.z * sup_ca.y,
+                      sup_ba.z * sup_ca.x + sup_ba.x * sup_ca.z,
+                      sup_ba.x * sup_ca.y + sup_ba.y * sup_ca.x);
+  const double err_bound = math::dot(sup_ad, sup_n) * index_orient3d * DBL_EPSILON;
+  if (fabs(det) > err_bound) {
+    return det > 0 ? 1 : -1;
+  }
+  return 0;
+}
+
 /*
  * #intersect_tri_tri and helper functions.
  * This code uses the algorithm of Guigue and Devillers, as described
@@ -1170,25 +1196,36 @@ static inline mpq3 tti_interp(
 }
 
 /**
- * Return +1, 0, -1 as a + ad is above, on, or below the oriented plane containing a, b, c in CCW
- * order. This is the same as -oriented(a, b, c, a + ad), but uses fewer arithmetic operations.
- * TODO: change arguments to `const Vert *` and use floating filters.
- * The ba, ca, n, and dotbuf arguments are used as temporaries; declaring them
+ * Return +1, 0, -1 as d is above, on, or below the oriented plane containing a, b, c in CCW
+ * order. This is the same as -oriented(a, b, c, d), but uses fewer arithmetic operations.
+ * The sign is found with double arithmetic when the error bound allows it, exact arithmetic
+ * is only used for (nearly) degenerate cases.
+ * The ad, ba, ca, n, and dotbuf arguments are used as temporaries; declaring them
  * in the caller can avoid many allocs and frees of mpq3 and mpq_class structures.
  */
-static inline int tti_above(const mpq3 &a,
-                            const mpq3 &b,
-                            const mpq3 &c,
-                            const mpq3 &ad,
+static inline int tti_above(const Vert *a,
+                            const Vert *b,
+                            const Vert *c,
+                            const Vert *d,
+                            mpq3 &ad,
                             mpq3 &ba,
                             mpq3 &ca,
                             mpq3 &n,
                             mpq3 &dotbuf)
 {
-  ba = b;
-  ba -= a;
-  ca = c;
-  ca -= a;
+  const int filter_sign = filter_orient3d(a->co, b->co, c->co, d->co);
+  if (filter_sign != 0) {
+#  ifdef PERFDEBUG
+    incperfcount(5); /* Triangle-triangle orientation tests decided by filter. */
+#  endif
+    return filter_sign;
+  }
+  ad = d->co_exact;
+  ad -= a->co_exact;
+  ba = b->co_exact;
+  ba -= a->co_exact;
+  ca = c->co_exact;
+  ca -= a->co_exact;
 
   n.x = ba.y * ca.z - ba.z * ca.y;
   n.y = ba.z * ca.x - ba.x * ca.z;
@@ -1210,16 +1247,22 @@ static inline int tti_above(const mpq3 &a,
  *   of the plane and at least one of q1 and r1 are off the plane.
  * Similarly for p2, q2, r2 with respect to the first triangle's plane.
  */
-static ITT_value itt_canon2(const mpq3 &p1,
-                            const mpq3 &q1,
-                            const mpq3 &r1,
-                            const mpq3 &p2,
-                            const mpq3 &q2,
-                            const mpq3 &r2,
+static ITT_value itt_canon2(const Vert *vp1,
+                            const Vert *vq1,
+                            const Vert *vr1,
+                            const Vert *vp2,
+                            const Vert *vq2,
+                            const Vert *vr2,
                             const mpq3 &n1,
                             const mpq3 &n2)
 {
   constexpr int dbg_level = 0;
+  const mpq3 &p1 = vp1->co_exact;
+  const mpq3 &q1 = vq1->co_exact;
+  const mpq3 &r1 = vr1->co_exact;
+  const mpq3 &p2 = vp2->co_exact;
+  const mpq3 &q2 = vq2->co_exact;
+  const mpq3 &r2 = vr2->co_exact;
   if (dbg_level > 0) {
     std::cout << "\ntri_tri_intersect_canon:\n";
     std::cout << "p1=" << p1 << " q1=" << q1 << " r1=" << r1 << "\n";
@@ -1235,17 +1278,16 @@ static ITT_value itt_canon2(const mpq3 &p1,
     std::cout << "n1=(" << n1[0].get_d() << "," << n1[1].get_d() << "," << n1[2].get_d() << ")\n";
     std::cout << "n2=(" << n2[0].get_d() << "," << n2[1].get_d() << "," << n2[2].get_d() << ")\n";
   }
-  mpq3 p1p2 = p2 - p1;
   mpq3 intersect_1;
   mpq3 intersect_2;
-  mpq3 buf[4];
+  mpq3 buf[5];
   bool no_overlap = false;
   /* Top test in classification tree. */
-  if (tti_above(p1, q1, r2, p1p2, buf[0], buf[1], buf[2], buf[3]) > 0) {
+  if (tti_above(vp1, vq1, vr2, vp2, buf[0], buf[1], buf[2], buf[3], buf[4]) > 0) {
     /* Middle right test in classification tree. */
-    if (tti_above(p1, r1, r2, p1p2, buf[0], buf[1], buf[2], buf[3]) <= 0) {
+    if (tti_above(vp1, vr1, vr2, vp2, buf[0], buf[1], buf[2], buf[3], buf[4]) <= 0) {
       /* Bottom right test in classification tree. */
-      if (tti_above(p1, r1, q2, p1p2, buf[0], buf[1], buf[2], buf[3]) > 0) {
+      if (tti_above(vp1, vr1, vq2, vp2, buf[0], buf[1], buf[2], buf[3], buf[4]) > 0) {
         /* Overlap is [k [i l] j]. */
         if (dbg_level > 0) {
           std::cout << "overlap [k [i l] j]\n";
@@ -1274,7 +1316,7 @@ static ITT_value itt_canon2(const mpq3 &p1,
   }
   else {
     /* Middle left test in classification tree. */
-    if (tti_above(p1, q1, q2, p1p2, buf[0], buf[1], buf[2], buf[3]) < 0) {
+    if (tti_above(vp1, vq1, vq2, vp2, buf[0], buf[1], buf[2], buf[3], buf[4]) < 0) {
       /* No overlap: [i j] [k l]. */
       if (dbg_level > 0) {
         std::cout << "no overlap: [i j] [k l]\n";
@@ -1283,7 +1325,7 @@ static ITT_value itt_canon2(const mpq3 &p1,
     }
     else {
       /* Bottom left test in classification tree. */
-      if (tti_above(p1, r1, q2, p1p2, buf[0], buf[1], buf[2], buf[3]) >= 0) {
+      if (tti_above(vp1, vr1, vq2, vp2, buf[0], buf[1], buf[2], buf[3], buf[4]) >= 0) {
         /* Overlap is [k [i j] l]. */
         if (dbg_level > 0) {
           std::cout << "overlap [k [i j] l]\n";
@@ -1320,12 +1362,12 @@ static ITT_value itt_canon2(const mpq3 &p1,
 
 /* Helper function for intersect_tri_tri. Arguments have been canonicalized for triangle 1. */
 
-static ITT_value itt_canon1(const mpq3 &p1,
-                            const mpq3 &q1,
-                            const mpq3 &r1,
-                            const mpq3 &p2,
-                            const mpq3 &q2,
-                            const mpq3 &r2,
+static ITT_value itt_canon1(const Vert *p1,
+                            const Vert *q1,
+                            const Vert *r1,
+                            const Vert *p2,
+                            const Vert *q2,
+                            const Vert *r2,
                             const mpq3 &n1,
                             const mpq3 &n2,
                             int sp2,
@@ -1527,49 +1569,49 @@ static ITT_value intersect_tri_tri(const IMesh &tm, int t1, int t2)
   ITT_value ans;
   if (sp1 > 0) {
     if (sq1 > 0) {
-      ans = itt_canon1(r1, p1, q1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+      ans = itt_canon1(vr1, vp1, vq1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
     }
     else if (sr1 > 0) {
-      ans = itt_canon1(q1, r1, p1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+      ans = itt_canon1(vq1, vr1, vp1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
     }
     else {
-      ans = itt_canon1(p1, q1, r1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+      ans = itt_canon1(vp1, vq1, vr1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
     }
   }
   else if (sp1 < 0) {
     if (sq1 < 0) {
-      ans = itt_canon1(r1, p1, q1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+      ans = itt_canon1(vr1, vp1, vq1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
     }
     else if (sr1 < 0) {
-      ans = itt_canon1(q1, r1, p1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+      ans = itt_canon1(vq1, vr1, vp1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
     }
     else {
-      ans = itt_canon1(p1, q1, r1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+      ans = itt_canon1(vp1, vq1, vr1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
     }
   }
   else {
     if (sq1 < 0) {
       if (sr1 >= 0) {
-        ans = itt_canon1(q1, r1, p1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+        ans = itt_canon1(vq1, vr1, vp1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
       }
       else {
-        ans = itt_canon1(p1, q1, r1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+        ans = itt_canon1(vp1, vq1, vr1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
       }
     }
     else if (sq1 > 0) {
       if (sr1 > 0) {
-        ans = itt_canon1(p1, q1, r1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+        ans = itt_canon1(vp1, vq1, vr1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
       }
       else {
-        ans = itt_canon1(q1, r1, p1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+        ans = itt_canon1(vq1, vr1, vp1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
       }
     }
     else {
       if (sr1 > 0) {
-        ans = itt_canon1(r1, p1, q1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+        ans = itt_canon1(vr1, vp1, vq1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
       }
       else if (sr1 < 0) {
-        ans = itt_canon1(r1, p1, q1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+        ans = itt_canon1(vr1, vp1, vq1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
       }
       else {
         if (dbg_level > 0) {
@@ -3188,6 +3230,10 @@ static void perfdata_init()
   perfdata->count.append(0);
   perfdata->count_name.append("final non-NONE intersects");
 
+  /* count 5. */
+  perfdata->count.append(0);
+  perfdata->count_name.append("tri tri orientation tests decided by filter");
+
   /* max 0. */
   perfdata->max.append(0);
   perfdata->max_name.append("total faces");
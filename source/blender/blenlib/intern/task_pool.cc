@@ -36,13 +36,20 @@ class Task {
   void *taskdata;
   bool free_taskdata;
   TaskFreeFunction freedata;
+  /* Memory category of the thread pushing the task, so that worker threads inherit it. */
+  eMEM_Category mem_category;
 
   Task(TaskPool *pool,
        TaskRunFunction run,
        void *taskdata,
        bool free_taskdata,
        TaskFreeFunction freedata)
-      : pool(pool), run(run), taskdata(taskdata), free_taskdata(free_taskdata), freedata(freedata)
+      : pool(pool),
+        run(run),
+        taskdata(taskdata),
+        free_taskdata(free_taskdata),
+        freedata(freedata),
+        mem_category(MEM_category_get())
   {
   }
 
@@ -67,7 +74,8 @@ class Task {
         run(other.run),
         taskdata(other.taskdata),
         free_taskdata(other.free_taskdata),
-        freedata(other.freedata)
+        freedata(other.freedata),
+        mem_category(other.mem_category)
   {
     other.pool = nullptr;
     other.run = nullptr;
@@ -82,7 +90,8 @@ class Task {
         run(other.run),
         taskdata(other.taskdata),
         free_taskdata(other.free_taskdata),
-        freedata(other.freedata)
+        freedata(other.freedata),
+        mem_category(other.mem_category)
   {
     ((Task &)other).pool = NULL;
     ((Task &)other).run = NULL;
@@ -161,6 +170,7 @@ struct TaskPool {
 /* Execute task. */
 void Task::operator()() const
 {
+  MEM_CategoryScope mem_category_scope(mem_category);
   run(pool, taskdata);
 }
 
@@ -6,6 +6,7 @@
  * Task parallel range functions.
  */
 
+#include <atomic>
 #include <cstdlib>
 
 #include "MEM_guardedalloc.h"
@@ -26,31 +27,42 @@
 
 #ifdef WITH_TBB
 
+/* Statistics of a traced range, see #BLI_task_trace_begin. */
+struct RangeTrace {
+  const char *name;
+  std::atomic<int> tasks_num = 0;
+  std::atomic<int64_t> busy_time_ns = 0;
+};
+
 /* Functor for running TBB parallel_for and parallel_reduce. */
 struct RangeTask {
   TaskParallelRangeFunc func;
   void *userdata;
   const TaskParallelSettings *settings;
+  RangeTrace *trace;
 
   void *userdata_chunk;
 
   /* Root constructor. */
-  RangeTask(TaskParallelRangeFunc func, void *userdata, const TaskParallelSettings *settings)
-      : func(func), userdata(userdata), settings(settings)
+  RangeTask(TaskParallelRangeFunc func,
+            void *userdata,
+            const TaskParallelSettings *settings,
+            RangeTrace *trace)
+      : func(func), userdata(userdata), settings(settings), trace(trace)
   {
     init_chunk(settings->userdata_chunk);
   }
 
   /* Copy constructor. */
   RangeTask(const RangeTask &other)
-      : func(other.func), userdata(other.userdata), settings(other.settings)
+      : func(other.func), userdata(other.userdata), settings(other.settings), trace(other.trace)
   {
     init_chunk(settings->userdata_chunk);
   }
 
   /* Splitting constructor for parallel reduce. */
   RangeTask(RangeTask &other, tbb::split /* unused */)
-      : func(other.func), userdata(other.userdata), settings(other.settings)
+      : func(other.func), userdata(other.userdata), settings(other.settings), trace(other.trace)
   {
     init_chunk(settings->userdata_chunk);
   }
@@ -76,11 +88,19 @@ struct RangeTask {
 
   void operator()(const tbb::blocked_range<int> &r) const
   {
+    const double start_time = trace ? BLI_task_trace_time() : 0.0;
     TaskParallelTLS tls;
     tls.userdata_chunk = userdata_chunk;
     for (int i = r.begin(); i != r.end(); ++i) {
       func(userdata, i, &tls);
     }
+    if (trace) {
+      const double end_time = BLI_task_trace_time();
+      BLI_task_trace_add_task(trace->name, start_time, end_time);
+      trace->tasks_num.fetch_add(1, std::memory_order_relaxed);
+      trace->busy_time_ns.fetch_add(int64_t((end_time - start_time) * 1e9),
+                                    std::memory_order_relaxed);
+    }
   }
 
   void join(const RangeTask &other)
@@ -100,7 +120,16 @@ void BLI_task_parallel_range(const int start,
 #ifdef WITH_TBB
   /* Multithreading. */
   if (settings->use_threading && BLI_task_scheduler_num_threads() > 1) {
-    RangeTask task(func, userdata, settings);
+    RangeTrace trace_data;
+    RangeTrace *trace = nullptr;
+    double trace_start_time = 0.0;
+    if (UNLIKELY(BLI_task_trace_is_enabled())) {
+      trace_data.name = settings->name ? settings->name : "BLI_task_parallel_range";
+      trace = &trace_data;
+      trace_start_time = BLI_task_trace_time();
+    }
+
+    RangeTask task(func, userdata, settings, trace);
     const size_t grainsize = MAX2(settings->min_iter_per_thread, 1);
     const tbb::blocked_range<int> range(start, stop, grainsize);
 
@@ -113,6 +142,16 @@ void BLI_task_parallel_range(const int start,
     else {
       parallel_for(range, task);
     }
+
+    if (trace) {
+      BLI_task_trace_add_loop(trace->name,
+                              trace_start_time,
+                              BLI_task_trace_time(),
+                              stop - start,
+                              int64_t(grainsize),
+                              trace->tasks_num.load(),
+                              double(trace->busy_time_ns.load()) * 1e-9);
+    }
     return;
   }
 #endif
@@ -9,6 +9,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 
 #ifdef WITH_TBB
@@ -27,6 +28,33 @@ static int task_scheduler_num_threads = 1;
 #ifdef WITH_TBB_GLOBAL_CONTROL
 static tbb::global_control *task_scheduler_global_control = nullptr;
 #endif
+#ifdef WITH_TBB
+/* Arenas of the interactive and background lanes, the evaluation lane uses the arena of the
+ * calling thread. Arenas only take threads when they have work. */
+static tbb::task_arena *task_lane_interactive_arena = nullptr;
+static tbb::task_arena *task_lane_background_arena = nullptr;
+#endif
+
+#ifdef WITH_TBB
+static void task_lane_arenas_init()
+{
+  if (task_scheduler_num_threads <= 1) {
+    return;
+  }
+  const int background_concurrency = task_scheduler_num_threads - 1;
+#  if TBB_INTERFACE_VERSION_MAJOR >= 12
+  task_lane_interactive_arena = MEM_new<tbb::task_arena>(
+      __func__, task_scheduler_num_threads, 1, tbb::task_arena::priority::high);
+  task_lane_background_arena = MEM_new<tbb::task_arena>(
+      __func__, background_concurrency, 1, tbb::task_arena::priority::low);
+#  else
+  /* Arena priorities are only available since TBB 2021, isolation and the concurrency limit of
+   * the background lane still apply. */
+  task_lane_interactive_arena = MEM_new<tbb::task_arena>(__func__, task_scheduler_num_threads);
+  task_lane_background_arena = MEM_new<tbb::task_arena>(__func__, background_concurrency);
+#  endif
+}
+#endif
 
 void BLI_task_scheduler_init()
 {
@@ -50,10 +78,20 @@ void BLI_task_scheduler_init()
 #else
   task_scheduler_num_threads = BLI_system_thread_count();
 #endif
+
+#ifdef WITH_TBB
+  task_lane_arenas_init();
+#endif
 }
 
 void BLI_task_scheduler_exit()
 {
+#ifdef WITH_TBB
+  MEM_delete(task_lane_interactive_arena);
+  MEM_delete(task_lane_background_arena);
+  task_lane_interactive_arena = nullptr;
+  task_lane_background_arena = nullptr;
+#endif
 #ifdef WITH_TBB_GLOBAL_CONTROL
   MEM_delete(task_scheduler_global_control);
 #endif
@@ -64,6 +102,26 @@ int BLI_task_scheduler_num_threads()
   return task_scheduler_num_threads;
 }
 
+#ifdef WITH_TBB
+tbb::task_arena *blender::threading::detail::task_lane_arena(const eTaskLane lane)
+{
+  switch (lane) {
+    case TASK_LANE_INTERACTIVE:
+      return task_lane_interactive_arena;
+    case TASK_LANE_EVALUATION:
+      return nullptr;
+    case TASK_LANE_BACKGROUND:
+      return task_lane_background_arena;
+  }
+  return nullptr;
+}
+#endif
+
+void BLI_task_execute_in_lane(eTaskLane lane, void (*func)(void *userdata), void *userdata)
+{
+  blender::threading::execute_in_lane(lane, [&] { func(userdata); });
+}
+
 void BLI_task_isolate(void (*func)(void *userdata), void *userdata)
 {
 #ifdef WITH_TBB
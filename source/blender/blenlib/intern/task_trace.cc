@@ -0,0 +1,150 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ *
+ * Recording of parallel loops and tasks for performance analysis.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "BLI_task.h"
+#include "BLI_vector.hh"
+
+#include "PIL_time.h"
+
+using blender::Vector;
+
+namespace {
+
+struct ThreadEvents;
+
+struct TraceGlobal {
+  std::mutex mutex;
+  Vector<ThreadEvents *> threads;
+  /** Events of threads that exited. */
+  Vector<TaskTraceEvent> exited_threads_events;
+};
+
+/** Events are recorded per thread, to not serialize the tasks being measured. */
+struct ThreadEvents {
+  Vector<TaskTraceEvent> events;
+  uint64_t thread_id;
+
+  ThreadEvents();
+  ~ThreadEvents();
+};
+
+std::atomic<bool> trace_enabled = false;
+
+}  // namespace
+
+static TraceGlobal &get_trace_global()
+{
+  /* Never destructed, threads may exit after static variables are destructed. */
+  static TraceGlobal &global = *new TraceGlobal();
+  return global;
+}
+
+static ThreadEvents &get_thread_events()
+{
+  static thread_local ThreadEvents thread_events;
+  return thread_events;
+}
+
+ThreadEvents::ThreadEvents()
+{
+  thread_id = std::hash<std::thread::id>()(std::this_thread::get_id());
+  TraceGlobal &global = get_trace_global();
+  std::lock_guard lock{global.mutex};
+  global.threads.append(this);
+}
+
+ThreadEvents::~ThreadEvents()
+{
+  TraceGlobal &global = get_trace_global();
+  std::lock_guard lock{global.mutex};
+  global.threads.remove_first_occurrence_and_reorder(this);
+  global.exited_threads_events.extend(events);
+}
+
+void BLI_task_trace_begin()
+{
+  TraceGlobal &global = get_trace_global();
+  {
+    std::lock_guard lock{global.mutex};
+    for (ThreadEvents *thread_events : global.threads) {
+      thread_events->events.clear();
+    }
+    global.exited_threads_events.clear();
+  }
+  trace_enabled.store(true, std::memory_order_release);
+}
+
+void BLI_task_trace_end()
+{
+  trace_enabled.store(false, std::memory_order_release);
+}
+
+bool BLI_task_trace_is_enabled()
+{
+  return trace_enabled.load(std::memory_order_relaxed);
+}
+
+double BLI_task_trace_time()
+{
+  return PIL_check_seconds_timer();
+}
+
+static void trace_add_event(TaskTraceEvent event)
+{
+  ThreadEvents &thread_events = get_thread_events();
+  event.thread_id = thread_events.thread_id;
+  thread_events.events.append(event);
+}
+
+void BLI_task_trace_add_task(const char *name, const double start_time, const double end_time)
+{
+  TaskTraceEvent event{};
+  event.name = name;
+  event.start_time = start_time;
+  event.end_time = end_time;
+  trace_add_event(event);
+}
+
+void BLI_task_trace_add_loop(const char *name,
+                             const double start_time,
+                             const double end_time,
+                             const int64_t range_size,
+                             const int64_t grain_size,
+                             const int tasks_num,
+                             const double busy_time)
+{
+  TaskTraceEvent event{};
+  event.name = name;
+  event.start_time = start_time;
+  event.end_time = end_time;
+  event.range_size = range_size;
+  event.grain_size = grain_size;
+  event.tasks_num = tasks_num;
+  event.busy_time = busy_time;
+  trace_add_event(event);
+}
+
+void BLI_task_trace_foreach(void (*func)(const TaskTraceEvent *event, void *userdata),
+                            void *userdata)
+{
+  TraceGlobal &global = get_trace_global();
+  std::lock_guard lock{global.mutex};
+  for (const ThreadEvents *thread_events : global.threads) {
+    for (const TaskTraceEvent &event : thread_events->events) {
+      func(&event, userdata);
+    }
+  }
+  for (const TaskTraceEvent &event : global.exited_threads_events) {
+    func(&event, userdata);
+  }
+}
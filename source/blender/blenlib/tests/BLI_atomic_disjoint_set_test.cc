@@ -0,0 +1,55 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_atomic_disjoint_set.hh"
+#include "BLI_task.hh"
+
+namespace blender::tests {
+
+TEST(atomic_disjoint_set, Test)
+{
+  AtomicDisjointSet disjoint_set(6);
+  EXPECT_FALSE(disjoint_set.in_same_set(1, 2));
+  EXPECT_FALSE(disjoint_set.in_same_set(5, 3));
+  EXPECT_TRUE(disjoint_set.in_same_set(2, 2));
+  EXPECT_EQ(disjoint_set.find_root(3), 3);
+
+  disjoint_set.join(1, 2);
+
+  EXPECT_TRUE(disjoint_set.in_same_set(1, 2));
+  EXPECT_FALSE(disjoint_set.in_same_set(0, 1));
+
+  disjoint_set.join(3, 4);
+
+  EXPECT_FALSE(disjoint_set.in_same_set(2, 3));
+  EXPECT_TRUE(disjoint_set.in_same_set(3, 4));
+
+  disjoint_set.join(1, 4);
+
+  EXPECT_TRUE(disjoint_set.in_same_set(1, 4));
+  EXPECT_TRUE(disjoint_set.in_same_set(1, 3));
+  EXPECT_TRUE(disjoint_set.in_same_set(2, 4));
+  EXPECT_FALSE(disjoint_set.in_same_set(0, 4));
+}
+
+TEST(atomic_disjoint_set, Parallel)
+{
+  const int size = 100000;
+  AtomicDisjointSet disjoint_set(size);
+  /* Join all even and all odd elements, in an order that differs between threads. */
+  threading::parallel_for(IndexRange(size - 2), 64, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int x = (i * 7919) % (size - 2);
+      disjoint_set.join(x, x + 2);
+    }
+  });
+  const int even_root = disjoint_set.find_root(0);
+  const int odd_root = disjoint_set.find_root(1);
+  EXPECT_NE(even_root, odd_root);
+  for (const int i : IndexRange(size)) {
+    EXPECT_EQ(disjoint_set.find_root(i), (i % 2) ? odd_root : even_root);
+  }
+}
+
+}  // namespace blender::tests
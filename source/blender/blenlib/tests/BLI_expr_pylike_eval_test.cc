@@ -181,6 +181,17 @@ TEST_CONST(Smoothstep4, "smoothstep(-10,10,20)", 1.0)
 TEST_CONST(Smoothstep5, "smoothstep(-10,10,-5)", 0.15625)
 TEST_EVAL(Smoothstep1, "smoothstep(-10,10,x)", 5, 0.84375)
 
+TEST_CONST(Tau, "tau", 2.0 * M_PI)
+TEST_CONST(E, "e", M_E)
+TEST_CONST(Float, "float(True)", 1.0)
+TEST_CONST(Bool, "bool(-0.5)", TRUE_VAL)
+TEST_CONST(Hypot, "hypot(3, 4)", 5.0)
+TEST_CONST(CopySign, "copysign(2, -1)", -2.0)
+TEST_CONST(Log2, "log2(8)", 3.0)
+TEST_CONST(Log10, "log10(100)", 2.0)
+TEST_EVAL(Tanh, "tanh(x)", 0.0, 0.0)
+TEST_EVAL(Asinh, "asinh(x)", 0.0, 0.0)
+
 TEST_RESULT(Min1, "min(3,1,2)", 1.0)
 TEST_RESULT(Max1, "max(3,1,2)", 3.0)
 TEST_RESULT(Min2, "min(1,2,3)", 1.0)
@@ -338,6 +349,8 @@ TEST_ERROR(PowDomain1, "pow(-1, 0.5)", 0.0, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(PowDomain2, "pow(-1, x)", 0.5, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(PowDomain3, "pow(-1, x)", 2.0, EXPR_PYLIKE_SUCCESS)
 
+TEST_ERROR(AcoshDomain, "acosh(x)", 0.5, EXPR_PYLIKE_MATH_ERROR)
+
 TEST_ERROR(Mixed1, "sqrt(x) + 1 / max(0, x)", -1.0, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(Mixed2, "sqrt(x) + 1 / max(0, x)", 0.0, EXPR_PYLIKE_DIV_BY_ZERO)
 TEST_ERROR(Mixed3, "sqrt(x) + 1 / max(0, x)", 1.0, EXPR_PYLIKE_SUCCESS)
@@ -361,3 +374,19 @@ TEST(expr_pylike, Error_ArgumentCount)
 
   BLI_expr_pylike_free(expr);
 }
+
+TEST(expr_pylike, ErrorOffset)
+{
+  const char *names[1] = {"x"};
+  ExprPyLike_Parsed *expr = BLI_expr_pylike_parse("x * 2", names, ARRAY_SIZE(names));
+  EXPECT_EQ(BLI_expr_pylike_error_offset(expr), -1);
+  BLI_expr_pylike_free(expr);
+
+  expr = BLI_expr_pylike_parse("x + bpy.data", names, ARRAY_SIZE(names));
+  EXPECT_EQ(BLI_expr_pylike_error_offset(expr), 4);
+  BLI_expr_pylike_free(expr);
+
+  expr = BLI_expr_pylike_parse("x +", names, ARRAY_SIZE(names));
+  EXPECT_EQ(BLI_expr_pylike_error_offset(expr), 3);
+  BLI_expr_pylike_free(expr);
+}
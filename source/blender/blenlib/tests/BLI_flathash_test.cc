@@ -0,0 +1,80 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_flathash.h"
+#include "BLI_utildefines.h"
+
+#define TESTCASE_SIZE 10000
+
+TEST(flathash, InsertLookup)
+{
+  FlatHash *fh = BLI_flathash_int_new(__func__);
+  for (uint i = 0; i < TESTCASE_SIZE; i++) {
+    BLI_flathash_insert(fh, POINTER_FROM_UINT(i), POINTER_FROM_UINT(i * 2));
+  }
+  EXPECT_EQ(BLI_flathash_len(fh), TESTCASE_SIZE);
+  for (uint i = 0; i < TESTCASE_SIZE; i++) {
+    EXPECT_EQ(POINTER_AS_UINT(BLI_flathash_lookup(fh, POINTER_FROM_UINT(i))), i * 2);
+  }
+  EXPECT_FALSE(BLI_flathash_haskey(fh, POINTER_FROM_UINT(TESTCASE_SIZE)));
+  EXPECT_EQ(BLI_flathash_lookup_p(fh, POINTER_FROM_UINT(TESTCASE_SIZE)), nullptr);
+  BLI_flathash_free(fh, nullptr, nullptr);
+}
+
+TEST(flathash, RemoveReinsert)
+{
+  FlatHash *fh = BLI_flathash_ptr_new(__func__);
+  int values[TESTCASE_SIZE];
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    BLI_flathash_insert(fh, &values[i], POINTER_FROM_INT(i));
+  }
+  /* Remove and add keys many times, so that removed slots are reused and reclaimed. */
+  for (int pass = 0; pass < 4; pass++) {
+    for (int i = 0; i < TESTCASE_SIZE; i += 2) {
+      EXPECT_TRUE(BLI_flathash_remove(fh, &values[i], nullptr, nullptr));
+      EXPECT_FALSE(BLI_flathash_remove(fh, &values[i], nullptr, nullptr));
+    }
+    EXPECT_EQ(BLI_flathash_len(fh), TESTCASE_SIZE / 2);
+    for (int i = 0; i < TESTCASE_SIZE; i += 2) {
+      EXPECT_TRUE(BLI_flathash_reinsert(fh, &values[i], POINTER_FROM_INT(-i), nullptr, nullptr));
+    }
+    EXPECT_EQ(BLI_flathash_len(fh), TESTCASE_SIZE);
+  }
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    EXPECT_EQ(POINTER_AS_INT(BLI_flathash_lookup(fh, &values[i])), (i % 2) ? i : -i);
+  }
+  EXPECT_FALSE(BLI_flathash_reinsert(fh, &values[1], POINTER_FROM_INT(5), nullptr, nullptr));
+  EXPECT_EQ(POINTER_AS_INT(BLI_flathash_lookup(fh, &values[1])), 5);
+  BLI_flathash_free(fh, nullptr, nullptr);
+}
+
+TEST(flathash, EnsureIterate)
+{
+  const char *keys[] = {"Cube", "Sphere", "Cone", "Plane", "Cube", "Cone"};
+  FlatHash *fh = BLI_flathash_str_new_ex(__func__, 2);
+  for (int i = 0; i < ARRAY_SIZE(keys); i++) {
+    void **val_p;
+    if (!BLI_flathash_ensure_p(fh, (void *)keys[i], &val_p)) {
+      *val_p = POINTER_FROM_INT(0);
+    }
+    *val_p = POINTER_FROM_INT(POINTER_AS_INT(*val_p) + 1);
+  }
+  EXPECT_EQ(BLI_flathash_len(fh), 4);
+  EXPECT_EQ(POINTER_AS_INT(BLI_flathash_lookup(fh, "Cube")), 2);
+  EXPECT_EQ(POINTER_AS_INT(BLI_flathash_lookup(fh, "Plane")), 1);
+
+  int count = 0;
+  FlatHashIterator iter;
+  FLATHASH_ITER (iter, fh) {
+    count += POINTER_AS_INT(BLI_flathashIterator_getValue(&iter));
+  }
+  EXPECT_EQ(count, ARRAY_SIZE(keys));
+
+  BLI_flathash_clear(fh, nullptr, nullptr);
+  EXPECT_EQ(BLI_flathash_len(fh), 0);
+  EXPECT_FALSE(BLI_flathash_haskey(fh, "Cube"));
+  EXPECT_TRUE(BLI_flathash_add(fh, (void *)"Cube"));
+  EXPECT_FALSE(BLI_flathash_add(fh, (void *)"Cube"));
+  BLI_flathash_free(fh, nullptr, nullptr);
+}
@@ -132,3 +132,54 @@ TEST(kdopbvh, OptimalFindNearest_500)
 {
   find_nearest_points_test(500, 1.0, 1000, 12, true);
 }
+
+/**
+ * Batched queries must find the same distances as single queries.
+ */
+static void find_nearest_batch_test(int points_len, int queries_len, int random_seed)
+{
+  struct RNG *rng = BLI_rng_new(random_seed);
+  BVHTree *tree = BLI_bvhtree_new(points_len, 0.0, 8, 8);
+
+  float(*points)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * points_len, __func__);
+  for (int i = 0; i < points_len; i++) {
+    rng_v3_round(points[i], 3, rng, 1000, 1.0f);
+    BLI_bvhtree_insert(tree, i, points[i], 1);
+  }
+  BLI_bvhtree_balance(tree);
+
+  float(*queries)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * queries_len, __func__);
+  BVHTreeNearest *nearest = (BVHTreeNearest *)MEM_mallocN(sizeof(BVHTreeNearest) * queries_len,
+                                                          __func__);
+  for (int i = 0; i < queries_len; i++) {
+    rng_v3_round(queries[i], 3, rng, 1000, 1.5f);
+    nearest[i].index = -1;
+    nearest[i].dist_sq = FLT_MAX;
+  }
+
+  BLI_bvhtree_find_nearest_batch(tree, queries, queries_len, nearest, nullptr, nullptr, 0);
+
+  for (int i = 0; i < queries_len; i++) {
+    BVHTreeNearest nearest_single;
+    nearest_single.index = -1;
+    nearest_single.dist_sq = FLT_MAX;
+    BLI_bvhtree_find_nearest(tree, queries[i], &nearest_single, nullptr, nullptr);
+    EXPECT_GE(nearest[i].index, 0);
+    EXPECT_FLOAT_EQ(nearest[i].dist_sq, nearest_single.dist_sq);
+  }
+
+  BLI_bvhtree_free(tree);
+  BLI_rng_free(rng);
+  MEM_freeN(points);
+  MEM_freeN(queries);
+  MEM_freeN(nearest);
+}
+
+TEST(kdopbvh, FindNearestBatch_1)
+{
+  find_nearest_batch_test(1, 10, 1234);
+}
+TEST(kdopbvh, FindNearestBatch_500)
+{
+  find_nearest_batch_test(500, 2000, 12);
+}
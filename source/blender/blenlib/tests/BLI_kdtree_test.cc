@@ -0,0 +1,154 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_kdtree.h"
+#include "BLI_math_vector.h"
+#include "BLI_rand.h"
+
+/* Enough points for the multi-threaded balancing and duplicate search. */
+#define POINTS_LEN 50000
+
+static float (*points_random_new(const int points_len, const int random_seed))[3]
+{
+  struct RNG *rng = BLI_rng_new(random_seed);
+  float(*points)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * points_len, __func__);
+  for (int i = 0; i < points_len; i++) {
+    BLI_rng_get_float_unit_v3(rng, points[i]);
+    mul_v3_fl(points[i], BLI_rng_get_float(rng));
+  }
+  BLI_rng_free(rng);
+  return points;
+}
+
+static KDTree_3d *kdtree_from_points(const float (*points)[3], const int points_len)
+{
+  KDTree_3d *tree = BLI_kdtree_3d_new(points_len);
+  for (int i = 0; i < points_len; i++) {
+    BLI_kdtree_3d_insert(tree, i, points[i]);
+  }
+  BLI_kdtree_3d_balance(tree);
+  return tree;
+}
+
+static int find_nearest_brute_force(const float (*points)[3],
+                                    const int points_len,
+                                    const float co[3])
+{
+  int nearest = -1;
+  float nearest_dist_sq = FLT_MAX;
+  for (int i = 0; i < points_len; i++) {
+    const float dist_sq = len_squared_v3v3(points[i], co);
+    if (dist_sq < nearest_dist_sq) {
+      nearest = i;
+      nearest_dist_sq = dist_sq;
+    }
+  }
+  return nearest;
+}
+
+TEST(kdtree, Empty)
+{
+  KDTree_3d *tree = BLI_kdtree_3d_new(0);
+  BLI_kdtree_3d_balance(tree);
+  const float co[3] = {0.0f, 0.0f, 0.0f};
+  KDTreeNearest_3d nearest;
+  EXPECT_EQ(BLI_kdtree_3d_find_nearest(tree, co, &nearest), -1);
+  BLI_kdtree_3d_find_nearest_batch(tree, &co, 1, &nearest);
+  EXPECT_EQ(nearest.index, -1);
+  BLI_kdtree_3d_free(tree);
+}
+
+TEST(kdtree, FindNearestBatch)
+{
+  const int queries_len = 1000;
+  float(*points)[3] = points_random_new(POINTS_LEN, 1);
+  float(*queries)[3] = points_random_new(queries_len, 2);
+  KDTree_3d *tree = kdtree_from_points(points, POINTS_LEN);
+
+  KDTreeNearest_3d *nearest = (KDTreeNearest_3d *)MEM_mallocN(
+      sizeof(KDTreeNearest_3d) * queries_len, __func__);
+  BLI_kdtree_3d_find_nearest_batch(tree, queries, queries_len, nearest);
+  for (int i = 0; i < queries_len; i++) {
+    EXPECT_EQ(nearest[i].index, find_nearest_brute_force(points, POINTS_LEN, queries[i]));
+    EXPECT_FLOAT_EQ(nearest[i].dist, len_v3v3(points[nearest[i].index], queries[i]));
+  }
+
+  MEM_freeN(nearest);
+  BLI_kdtree_3d_free(tree);
+  MEM_freeN(queries);
+  MEM_freeN(points);
+}
+
+TEST(kdtree, RangeSearchBatch)
+{
+  const int queries_len = 1000;
+  static constexpr float range = 0.1f;
+  float(*points)[3] = points_random_new(POINTS_LEN, 3);
+  float(*queries)[3] = points_random_new(queries_len, 4);
+  KDTree_3d *tree = kdtree_from_points(points, POINTS_LEN);
+
+  int *found_len = (int *)MEM_callocN(sizeof(int) * queries_len, __func__);
+  BLI_kdtree_3d_range_search_batch_cb(
+      tree,
+      queries,
+      queries_len,
+      range,
+      [](void *user_data,
+         int co_index,
+         int UNUSED(index),
+         const float *UNUSED(co),
+         float dist_sq) {
+        EXPECT_LE(dist_sq, range * range);
+        static_cast<int *>(user_data)[co_index]++;
+        return true;
+      },
+      found_len);
+
+  for (int i = 0; i < queries_len; i++) {
+    int expected_len = 0;
+    for (int j = 0; j < POINTS_LEN; j++) {
+      expected_len += len_squared_v3v3(points[j], queries[i]) <= range * range;
+    }
+    EXPECT_EQ(found_len[i], expected_len);
+  }
+
+  MEM_freeN(found_len);
+  BLI_kdtree_3d_free(tree);
+  MEM_freeN(queries);
+  MEM_freeN(points);
+}
+
+TEST(kdtree, CalcDuplicatesFast)
+{
+  /* Every point has a duplicate slightly offset from it, except for the first few. */
+  const int unique_len = 100;
+  const int points_len = POINTS_LEN;
+  float(*points)[3] = points_random_new(points_len, 5);
+  for (int i = unique_len; i < points_len; i += 2) {
+    copy_v3_v3(points[i + 1], points[i]);
+    points[i + 1][0] += 1e-6f;
+  }
+  for (int i = 0; i < unique_len; i++) {
+    mul_v3_fl(points[i], 100.0f);
+    points[i][0] += 10.0f;
+  }
+  KDTree_3d *tree = kdtree_from_points(points, points_len);
+
+  int *duplicates = (int *)MEM_mallocN(sizeof(int) * points_len, __func__);
+  for (int i = 0; i < points_len; i++) {
+    duplicates[i] = -1;
+  }
+  const int found = BLI_kdtree_3d_calc_duplicates_fast(tree, 1e-5f, true, duplicates);
+  EXPECT_EQ(found, (points_len - unique_len) / 2);
+  for (int i = unique_len; i < points_len; i += 2) {
+    EXPECT_EQ(duplicates[i], i);
+    EXPECT_EQ(duplicates[i + 1], i);
+  }
+
+  MEM_freeN(duplicates);
+  BLI_kdtree_3d_free(tree);
+  MEM_freeN(points);
+}
@@ -0,0 +1,47 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_noise.hh"
+#include "BLI_rand.hh"
+
+namespace blender::noise::tests {
+
+static Array<float3> random_positions(const int size)
+{
+  RandomNumberGenerator rng(0);
+  Array<float3> positions(size);
+  for (float3 &position : positions) {
+    position = float3(rng.get_float(), rng.get_float(), rng.get_float()) * 20.0f - 10.0f;
+  }
+  return positions;
+}
+
+TEST(noise, PerlinFractalDistortedBatch)
+{
+  /* Not a multiple of the SIMD width or of the batch size. */
+  const Array<float3> positions = random_positions(203);
+  for (const float octaves : {0.0f, 2.0f, 3.5f}) {
+    Array<float> values(positions.size());
+    perlin_fractal_distorted(positions, octaves, 0.6f, 0.4f, values);
+    for (const int64_t i : positions.index_range()) {
+      EXPECT_EQ(values[i], perlin_fractal_distorted(positions[i], octaves, 0.6f, 0.4f));
+    }
+  }
+}
+
+TEST(noise, PerlinFloat3FractalDistortedBatch)
+{
+  const Array<float3> positions = random_positions(203);
+  Array<float3> values(positions.size());
+  perlin_float3_fractal_distorted(positions, 2.5f, 0.5f, 1.0f, values);
+  for (const int64_t i : positions.index_range()) {
+    const float3 expected = perlin_float3_fractal_distorted(positions[i], 2.5f, 0.5f, 1.0f);
+    EXPECT_EQ(values[i].x, expected.x);
+    EXPECT_EQ(values[i].y, expected.y);
+    EXPECT_EQ(values[i].z, expected.z);
+  }
+}
+
+}  // namespace blender::noise::tests
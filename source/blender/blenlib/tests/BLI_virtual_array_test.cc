@@ -180,4 +180,29 @@ TEST(virtual_array, MutableToImmutable)
   }
 }
 
+TEST(virtual_array, Devirtualize3)
+{
+  std::array<int, 4> array = {4, 2, 6, 4};
+  const VArray<int> span_varray = VArray<int>::ForSpan(array);
+  const VArray<int> single_varray = VArray<int>::ForSingle(3, 4);
+  const VArray<int> func_varray = VArray<int>::ForFunc(4, [](const int64_t i) { return int(i); });
+
+  const auto sum = [](const VArray<int> &varray1,
+                      const VArray<int> &varray2,
+                      const VArray<int> &varray3) {
+    Array<int> result(4);
+    devirtualize_varray3(
+        varray1, varray2, varray3, [&](const auto &a, const auto &b, const auto &c) {
+          for (const int64_t i : result.index_range()) {
+            result[i] = a[i] + b[i] + c[i];
+          }
+        });
+    return result;
+  };
+
+  EXPECT_EQ(sum(span_varray, single_varray, span_varray).as_span(), Span<int>({11, 7, 15, 11}));
+  EXPECT_EQ(sum(single_varray, single_varray, single_varray).as_span(), Span<int>({9, 9, 9, 9}));
+  EXPECT_EQ(sum(single_varray, span_varray, func_varray).as_span(), Span<int>({7, 6, 11, 10}));
+}
+
 }  // namespace blender::tests
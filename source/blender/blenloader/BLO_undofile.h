@@ -18,6 +18,9 @@ typedef struct {
   const char *buf;
   /** Size in bytes. */
   size_t size;
+  /** When not zero, #buf contains this many bytes of `Zstd` compressed data that decompress to
+   * #size bytes. Only chunks that are not shared with other chunks are compressed. */
+  size_t compressed_size;
   /** When true, this chunk doesn't own the memory, it's shared with a previous #MemFileChunk */
   bool is_identical;
   /** When true, this chunk is also identical to the one in the next step (used by undo code to
@@ -59,6 +62,10 @@ typedef struct {
   int undo_direction;
 
   bool memchunk_identical;
+
+  /** The last chunk that has been decompressed to be read, and its data. */
+  const MemFileChunk *decompressed_chunk;
+  char *decompressed_buf;
 } UndoReader;
 
 /* Actually only used `writefile.c`. */
@@ -69,6 +76,14 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
 void BLO_memfile_write_finalize(MemFileWriteData *mem_data);
 
 void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t size);
+/**
+ * Instead of writing the ID that is currently being written, add the chunks that have been
+ * written for it in the reference memfile again, sharing their memory.
+ * The reference chunk has to be the first one of that ID already.
+ *
+ * \return false when there are no chunks of that ID in the reference memfile.
+ */
+bool BLO_memfile_chunks_reuse_current_id(MemFileWriteData *mem_data);
 
 /* exports */
 
@@ -87,6 +102,18 @@ extern void BLO_memfile_merge(MemFile *first, MemFile *second);
  * Clear is_identical_future before adding next memfile.
  */
 extern void BLO_memfile_clear_future(MemFile *memfile);
+/**
+ * Compress the chunks that are owned by this memfile and not shared with the next step, to reduce
+ * the memory usage of undo steps that are not used as reference for new steps anymore. The chunks
+ * are decompressed when they are read again.
+ */
+extern void BLO_memfile_compress(MemFile *memfile);
+/**
+ * Copy of all chunks of the memfile with their own memory, that can be used independently of the
+ * undo stack (e.g. to write it from another thread). Free with #BLO_memfile_free and
+ * #MEM_freeN.
+ */
+extern MemFile *BLO_memfile_duplicate(const MemFile *memfile);
 
 /* Utilities. */
 
@@ -100,4 +127,21 @@ extern struct Main *BLO_memfile_main_get(struct MemFile *memfile,
  */
 extern bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename);
 
+/** Information about what has been written to a file, to write it incrementally next time. */
+typedef struct MemFileWrittenState MemFileWrittenState;
+
+/**
+ * Same as #BLO_memfile_write_file, but when the file still contains what was written to it last
+ * time, only the chunks that changed are written again. The file is written as a whole otherwise.
+ *
+ * \param state: The state of the previous write to the same file or NULL. It is replaced with the
+ * state of this write, or set to NULL when writing failed.
+ * 
+eturn success.
+ */
+extern bool BLO_memfile_write_file_incremental(struct MemFile *memfile,
+                                               const char *filename,
+                                               MemFileWrittenState **state);
+extern void BLO_memfile_written_state_free(MemFileWrittenState *state);
+
 FileReader *BLO_memfile_new_filereader(MemFile *memfile, int undo_direction);
@@ -48,6 +48,7 @@
 #include "BLI_blenlib.h"
 #include "BLI_endian_defines.h"
 #include "BLI_endian_switch.h"
+#include "BLI_flathash.h"
 #include "BLI_ghash.h"
 #include "BLI_linklist.h"
 #include "BLI_math.h"
@@ -593,7 +594,7 @@ static void read_file_bhead_idname_map_create(FileData *fd)
 
   BLI_assert(fd->bhead_idname_hash == NULL);
 
-  fd->bhead_idname_hash = BLI_ghash_str_new_ex(__func__, reserve);
+  fd->bhead_idname_hash = BLI_flathash_str_new_ex(__func__, reserve);
 
   for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
     if (code_prev != bhead->code) {
@@ -604,7 +605,9 @@ static void read_file_bhead_idname_map_create(FileData *fd)
     }
 
     if (is_link) {
-      BLI_ghash_insert(fd->bhead_idname_hash, (void *)blo_bhead_id_name(fd, bhead), bhead);
+      /* Files with duplicate names are invalid, use the last one as before. */
+      BLI_flathash_reinsert(
+          fd->bhead_idname_hash, (void *)blo_bhead_id_name(fd, bhead), bhead, NULL, NULL);
     }
   }
 }
@@ -968,6 +971,23 @@ static bool blo_bhead_read_data(FileData *fd, BHead *thisblock, void *buf)
   return success;
 }
 
+/**
+ * Direct access to the data of a block that has not been read yet, when the file is in memory
+ * (e.g. memory-mapped). This avoids copying the data when it is only used as source for other
+ * data, like when the struct has to be reconstructed anyway.
+ * Returns NULL when the data can't be accessed directly, it has to be read with
+ * #blo_bhead_read_full then.
+ */
+static const void *blo_bhead_data_direct(FileData *fd, BHead *thisblock)
+{
+  BHeadN *new_bhead = BHEADN_FROM_BHEAD(thisblock);
+  BLI_assert(new_bhead->has_data == false && new_bhead->file_offset != 0);
+  if (fd->file->data == NULL || (fd->flags & FD_FLAGS_IS_MEMFILE)) {
+    return NULL;
+  }
+  return fd->file->data(fd->file, new_bhead->file_offset, (size_t)new_bhead->bhead.len);
+}
+
 static BHead *blo_bhead_read_full(FileData *fd, BHead *thisblock)
 {
   BHeadN *new_bhead = BHEADN_FROM_BHEAD(thisblock);
@@ -1384,7 +1404,7 @@ void blo_filedata_free(FileData *fd)
 
 #ifdef USE_GHASH_BHEAD
     if (fd->bhead_idname_hash) {
-      BLI_ghash_free(fd->bhead_idname_hash, NULL, NULL);
+      BLI_flathash_free(fd->bhead_idname_hash, NULL, NULL);
     }
 #endif
 
@@ -1873,6 +1893,19 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
       if (fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL) {
 #ifdef USE_BHEAD_READ_ON_DEMAND
         if (BHEADN_FROM_BHEAD(bh)->has_data == false) {
+          /* Reconstruct directly from the file data when it is in memory already, instead of
+           * making a temporary copy of the whole block first. */
+          const void *data = blo_bhead_data_direct(fd, bh);
+          if (data != NULL) {
+            temp = DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, data);
+            /* Check for IO errors that happened while accessing the data. */
+            if (UNLIKELY(blo_bhead_data_direct(fd, bh) == NULL)) {
+              fd->flags &= ~FD_FLAGS_FILE_OK;
+              MEM_freeN(temp);
+              temp = NULL;
+            }
+            return temp;
+          }
           bh = blo_bhead_read_full(fd, bh);
           if (UNLIKELY(bh == NULL)) {
             fd->flags &= ~FD_FLAGS_FILE_OK;
@@ -4025,8 +4058,13 @@ static void sort_bhead_old_map(FileData *fd)
   struct BHeadSort *bhs;
   int tot = 0;
 
+  /* Only ID pointers are looked up while expanding, so leave out the data blocks. They are the
+   * vast majority of blocks in big files, sorting them made linking a few IDs from a large
+   * library much slower than necessary. */
   for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
-    tot++;
+    if (blo_bhead_is_id(bhead)) {
+      tot++;
+    }
   }
 
   fd->tot_bheadmap = tot;
@@ -4036,9 +4074,12 @@ static void sort_bhead_old_map(FileData *fd)
 
   bhs = fd->bheadmap = MEM_malloc_arrayN(tot, sizeof(struct BHeadSort), "BHeadSort");
 
-  for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead), bhs++) {
-    bhs->bhead = bhead;
-    bhs->old = bhead->old;
+  for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
+    if (blo_bhead_is_id(bhead)) {
+      bhs->bhead = bhead;
+      bhs->old = bhead->old;
+      bhs++;
+    }
   }
 
   qsort(fd->bheadmap, tot, sizeof(struct BHeadSort), verg_bheadsort);
@@ -4060,6 +4101,7 @@ static BHead *find_previous_lib(FileData *fd, BHead *bhead)
   return bhead;
 }
 
+/** Find the ID block that was written from the `old` ID address. */
 static BHead *find_bhead(FileData *fd, void *old)
 {
 #if 0
@@ -4102,7 +4144,7 @@ static BHead *find_bhead_from_code_name(FileData *fd, const short idcode, const
   *((short *)idname_full) = idcode;
   BLI_strncpy(idname_full + 2, name, sizeof(idname_full) - 2);
 
-  return BLI_ghash_lookup(fd->bhead_idname_hash, idname_full);
+  return BLI_flathash_lookup(fd->bhead_idname_hash, idname_full);
 
 #else
   BHead *bhead;
@@ -4126,7 +4168,7 @@ static BHead *find_bhead_from_code_name(FileData *fd, const short idcode, const
 static BHead *find_bhead_from_idname(FileData *fd, const char *idname)
 {
 #ifdef USE_GHASH_BHEAD
-  return BLI_ghash_lookup(fd->bhead_idname_hash, idname);
+  return BLI_flathash_lookup(fd->bhead_idname_hash, idname);
 #else
   return find_bhead_from_code_name(fd, GS(idname), idname + 2);
 #endif
@@ -96,7 +96,7 @@ typedef struct FileData {
   int tot_bheadmap;
 
   /** See: #USE_GHASH_BHEAD. */
-  struct GHash *bhead_idname_hash;
+  struct FlatHash *bhead_idname_hash;
 
   ListBase *mainlist;
   /** Used for undo. */
@@ -12,6 +12,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <zstd.h>
+
 /* open/close */
 #ifndef _WIN32
 #  include <unistd.h>
@@ -25,6 +27,8 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
+#include "BLI_hash_md5.h"
+#include "BLI_task.h"
 
 #include "BLO_readfile.h"
 #include "BLO_undofile.h"
@@ -51,6 +55,101 @@ void BLO_memfile_free(MemFile *memfile)
   memfile->size = 0;
 }
 
+/* Chunks smaller than this are not worth compressing. */
+#define MEMFILE_CHUNK_COMPRESS_MIN_SIZE 4096
+
+static bool memfile_chunk_decompress(const MemFileChunk *chunk, char *r_buf)
+{
+  const size_t result = ZSTD_decompress(r_buf, chunk->size, chunk->buf, chunk->compressed_size);
+  return !ZSTD_isError(result) && result == chunk->size;
+}
+
+/**
+ * Get the uncompressed data of the chunk. When it is compressed, the data is decompressed into
+ * a new buffer, that is returned in \a r_temp_buf and has to be freed by the caller.
+ */
+static const char *memfile_chunk_data_get(const MemFileChunk *chunk, char **r_temp_buf)
+{
+  *r_temp_buf = NULL;
+  if (chunk->compressed_size == 0) {
+    return chunk->buf;
+  }
+  char *buf = MEM_mallocN(chunk->size, __func__);
+  if (!memfile_chunk_decompress(chunk, buf)) {
+    MEM_freeN(buf);
+    return NULL;
+  }
+  *r_temp_buf = buf;
+  return buf;
+}
+
+static void memfile_compress_chunk_task(void *__restrict userdata,
+                                        const int index,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MemFileChunk *chunk = ((MemFileChunk **)userdata)[index];
+  const size_t bound = ZSTD_compressBound(chunk->size);
+  char *compressed_buf = MEM_mallocN(bound, __func__);
+  /* Use the fastest level, compression is done as part of an undo push. */
+  const size_t compressed_size = ZSTD_compress(compressed_buf, bound, chunk->buf, chunk->size, 1);
+  if (ZSTD_isError(compressed_size) || compressed_size >= chunk->size) {
+    MEM_freeN(compressed_buf);
+    return;
+  }
+  MEM_freeN((void *)chunk->buf);
+  chunk->buf = MEM_reallocN(compressed_buf, compressed_size);
+  chunk->compressed_size = compressed_size;
+}
+
+void BLO_memfile_compress(MemFile *memfile)
+{
+  /* Chunks that are shared with the next step (or from a previous one) must stay as they are,
+   * since their memory is used by other chunks as well. */
+  const int chunks_num = BLI_listbase_count(&memfile->chunks);
+  MemFileChunk **chunks = MEM_malloc_arrayN((size_t)chunks_num, sizeof(MemFileChunk *), __func__);
+  int chunks_to_compress_num = 0;
+  LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+    if (!chunk->is_identical && !chunk->is_identical_future && chunk->compressed_size == 0 &&
+        chunk->size >= MEMFILE_CHUNK_COMPRESS_MIN_SIZE) {
+      chunks[chunks_to_compress_num++] = chunk;
+    }
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  BLI_task_parallel_range(0, chunks_to_compress_num, chunks, memfile_compress_chunk_task, &settings);
+
+  for (int i = 0; i < chunks_to_compress_num; i++) {
+    if (chunks[i]->compressed_size != 0) {
+      memfile->size -= chunks[i]->size - chunks[i]->compressed_size;
+    }
+  }
+  MEM_freeN(chunks);
+}
+
+/**
+ * Decompress all chunks again, for memfiles that are used as reference when writing a new step.
+ */
+static void memfile_decompress(MemFile *memfile)
+{
+  LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+    if (chunk->compressed_size == 0) {
+      continue;
+    }
+    char *buf = MEM_mallocN(chunk->size, __func__);
+    if (!memfile_chunk_decompress(chunk, buf)) {
+      /* Should never happen, keep the chunk compressed, it won't be used as identical chunk. */
+      BLI_assert_unreachable();
+      MEM_freeN(buf);
+      continue;
+    }
+    memfile->size += chunk->size - chunk->compressed_size;
+    MEM_freeN((void *)chunk->buf);
+    chunk->buf = buf;
+    chunk->compressed_size = 0;
+  }
+}
+
 void BLO_memfile_merge(MemFile *first, MemFile *second)
 {
   /* We use this mapping to store the memory buffers from second memfile chunks which are not owned
@@ -93,6 +192,25 @@ void BLO_memfile_clear_future(MemFile *memfile)
   }
 }
 
+MemFile *BLO_memfile_duplicate(const MemFile *memfile)
+{
+  MemFile *memfile_copy = MEM_callocN(sizeof(MemFile), __func__);
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &memfile->chunks) {
+    MemFileChunk *chunk_copy = MEM_mallocN(sizeof(MemFileChunk), __func__);
+    *chunk_copy = *chunk;
+    chunk_copy->next = chunk_copy->prev = NULL;
+    chunk_copy->is_identical = false;
+    chunk_copy->is_identical_future = false;
+    char *buf = MEM_mallocN(chunk->compressed_size ? chunk->compressed_size : chunk->size,
+                            __func__);
+    memcpy(buf, chunk->buf, chunk->compressed_size ? chunk->compressed_size : chunk->size);
+    chunk_copy->buf = buf;
+    BLI_addtail(&memfile_copy->chunks, chunk_copy);
+  }
+  memfile_copy->size = memfile->size;
+  return memfile_copy;
+}
+
 void BLO_memfile_write_init(MemFileWriteData *mem_data,
                             MemFile *written_memfile,
                             MemFile *reference_memfile)
@@ -101,6 +219,11 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
   mem_data->reference_memfile = reference_memfile;
   mem_data->reference_current_chunk = reference_memfile ? reference_memfile->chunks.first : NULL;
 
+  /* The data of the reference chunks is compared with the data that is written. */
+  if (reference_memfile != NULL) {
+    memfile_decompress(reference_memfile);
+  }
+
   /* If we have a reference memfile, we generate a mapping between the session_uuid's of the
    * IDs stored in that previous undo step, and its first matching memchunk. This will allow
    * us to easily find the existing undo memory storage of IDs even when some re-ordering in
@@ -141,6 +264,7 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
 
   MemFileChunk *curchunk = MEM_mallocN(sizeof(MemFileChunk), "MemFileChunk");
   curchunk->size = size;
+  curchunk->compressed_size = 0;
   curchunk->buf = NULL;
   curchunk->is_identical = false;
   /* This is unsafe in the sense that an app handler or other code that does not
@@ -172,6 +296,34 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   }
 }
 
+bool BLO_memfile_chunks_reuse_current_id(MemFileWriteData *mem_data)
+{
+  MemFile *memfile = mem_data->written_memfile;
+  const uint id_session_uuid = mem_data->current_id_session_uuid;
+  MemFileChunk *compchunk = mem_data->reference_current_chunk;
+
+  if (id_session_uuid == MAIN_ID_SESSION_UUID_UNSET || compchunk == NULL ||
+      compchunk->id_session_uuid != id_session_uuid) {
+    return false;
+  }
+
+  for (; compchunk != NULL && compchunk->id_session_uuid == id_session_uuid;
+       compchunk = compchunk->next) {
+    MemFileChunk *curchunk = MEM_mallocN(sizeof(MemFileChunk), "MemFileChunk");
+    curchunk->size = compchunk->size;
+    curchunk->compressed_size = 0;
+    curchunk->buf = compchunk->buf;
+    curchunk->is_identical = true;
+    curchunk->is_identical_future = true;
+    curchunk->id_session_uuid = id_session_uuid;
+    BLI_addtail(&memfile->chunks, curchunk);
+
+    compchunk->is_identical_future = true;
+  }
+  mem_data->reference_current_chunk = compchunk;
+  return true;
+}
+
 struct Main *BLO_memfile_main_get(struct MemFile *memfile,
                                   struct Main *bmain,
                                   struct Scene **r_scene)
@@ -227,12 +379,18 @@ bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename)
   }
 
   for (chunk = memfile->chunks.first; chunk; chunk = chunk->next) {
+    char *temp_buf;
+    const char *buf = memfile_chunk_data_get(chunk, &temp_buf);
+    if (buf == NULL) {
+      break;
+    }
 #ifdef _WIN32
-    if ((size_t)write(file, chunk->buf, (uint)chunk->size) != chunk->size)
+    const bool success = (size_t)write(file, buf, (uint)chunk->size) == chunk->size;
 #else
-    if ((size_t)write(file, chunk->buf, chunk->size) != chunk->size)
+    const bool success = (size_t)write(file, buf, chunk->size) == chunk->size;
 #endif
-    {
+    MEM_SAFE_FREE(temp_buf);
+    if (!success) {
       break;
     }
   }
@@ -249,6 +407,161 @@ bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename)
   return true;
 }
 
+typedef struct MemFileWrittenChunk {
+  size_t offset;
+  size_t size;
+  uchar digest[16];
+} MemFileWrittenChunk;
+
+struct MemFileWrittenState {
+  char filename[FILE_MAX];
+  MemFileWrittenChunk *chunks;
+  int chunks_num;
+  size_t file_size;
+  /** Modification time of the file after writing, to detect changes by others. */
+  int64_t mtime;
+};
+
+void BLO_memfile_written_state_free(MemFileWrittenState *state)
+{
+  if (state == NULL) {
+    return;
+  }
+  MEM_SAFE_FREE(state->chunks);
+  MEM_freeN(state);
+}
+
+/** Find out whether the file still contains what has been written last time. */
+static bool memfile_written_state_is_valid(const MemFileWrittenState *state, const char *filename)
+{
+  if (state == NULL || !STREQ(state->filename, filename)) {
+    return false;
+  }
+  BLI_stat_t st;
+  if (BLI_stat(filename, &st) != 0) {
+    return false;
+  }
+  return (size_t)st.st_size == state->file_size && (int64_t)st.st_mtime == state->mtime;
+}
+
+bool BLO_memfile_write_file_incremental(struct MemFile *memfile,
+                                        const char *filename,
+                                        MemFileWrittenState **state)
+{
+  MemFileWrittenState *prev_state = *state;
+  *state = NULL;
+  if (!memfile_written_state_is_valid(prev_state, filename)) {
+    BLO_memfile_written_state_free(prev_state);
+    prev_state = NULL;
+  }
+
+  /* Same as in #BLO_memfile_write_file, but only truncating when writing the whole file. */
+  int oflags = O_BINARY | O_WRONLY | O_CREAT;
+  if (prev_state == NULL) {
+    oflags |= O_TRUNC;
+  }
+#ifdef O_NOFOLLOW
+  oflags |= O_NOFOLLOW;
+#endif
+  const int file = BLI_open(filename, oflags, 0666);
+
+  if (file == -1) {
+    BLO_memfile_written_state_free(prev_state);
+    fprintf(stderr,
+            "Unable to save '%s': %s\n",
+            filename,
+            errno ? strerror(errno) : "Unknown error opening file");
+    return false;
+  }
+
+  MemFileWrittenState *new_state = MEM_callocN(sizeof(MemFileWrittenState), __func__);
+  BLI_strncpy(new_state->filename, filename, sizeof(new_state->filename));
+  new_state->chunks_num = BLI_listbase_count(&memfile->chunks);
+  new_state->chunks = MEM_malloc_arrayN(
+      (size_t)new_state->chunks_num, sizeof(MemFileWrittenChunk), __func__);
+
+  bool success = true;
+  size_t offset = 0;
+  /* Position in the file, to avoid seeking when consecutive chunks are written. */
+  size_t file_offset = 0;
+  int prev_index = 0;
+  int chunk_index = 0;
+  LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+    MemFileWrittenChunk *written_chunk = &new_state->chunks[chunk_index++];
+    written_chunk->offset = offset;
+    written_chunk->size = chunk->size;
+    char *temp_buf;
+    const char *buf = memfile_chunk_data_get(chunk, &temp_buf);
+    if (buf == NULL) {
+      success = false;
+      break;
+    }
+    BLI_hash_md5_buffer(buf, chunk->size, written_chunk->digest);
+
+    /* Chunks of both states are sorted by offset, so the matching one can be found by walking
+     * over both at the same time. A chunk is only skipped when the same data is at the same place
+     * in the file already. */
+    bool is_unchanged = false;
+    if (prev_state != NULL) {
+      while (prev_index < prev_state->chunks_num &&
+             prev_state->chunks[prev_index].offset < offset) {
+        prev_index++;
+      }
+      if (prev_index < prev_state->chunks_num) {
+        const MemFileWrittenChunk *prev_chunk = &prev_state->chunks[prev_index];
+        is_unchanged = prev_chunk->offset == offset && prev_chunk->size == chunk->size &&
+                       memcmp(prev_chunk->digest, written_chunk->digest, 16) == 0;
+      }
+    }
+
+    if (!is_unchanged) {
+      if (file_offset != offset && BLI_lseek(file, (int64_t)offset, SEEK_SET) == -1) {
+        success = false;
+      }
+#ifdef _WIN32
+      else if ((size_t)write(file, buf, (uint)chunk->size) != chunk->size)
+#else
+      else if ((size_t)write(file, buf, chunk->size) != chunk->size)
+#endif
+      {
+        success = false;
+      }
+      file_offset = offset + chunk->size;
+    }
+    MEM_SAFE_FREE(temp_buf);
+    if (!success) {
+      break;
+    }
+    offset += chunk->size;
+  }
+
+  /* Remove what is left from a previous larger file. */
+  if (success && prev_state != NULL && prev_state->file_size > offset) {
+#ifdef _WIN32
+    success = _chsize_s(file, (int64_t)offset) == 0;
+#else
+    success = ftruncate(file, (off_t)offset) == 0;
+#endif
+  }
+
+  close(file);
+  BLO_memfile_written_state_free(prev_state);
+
+  BLI_stat_t st;
+  if (!success || BLI_stat(filename, &st) != 0) {
+    BLO_memfile_written_state_free(new_state);
+    fprintf(stderr,
+            "Unable to save '%s': %s\n",
+            filename,
+            errno ? strerror(errno) : "Unknown error writing file");
+    return false;
+  }
+  new_state->file_size = offset;
+  new_state->mtime = (int64_t)st.st_mtime;
+  *state = new_state;
+  return true;
+}
+
 static ssize_t undo_read(FileReader *reader, void *buffer, size_t size)
 {
   UndoReader *undo = (UndoReader *)reader;
@@ -305,7 +618,24 @@ static ssize_t undo_read(FileReader *reader, void *buffer, size_t size)
         readsize = chunk->size - chunkoffset;
       }
 
-      memcpy(POINTER_OFFSET(buffer, totread), chunk->buf + chunkoffset, readsize);
+      const char *chunk_buf = chunk->buf;
+      if (chunk->compressed_size != 0) {
+        /* Reads are mostly sequential, so keep the decompressed data of the last chunk. */
+        if (undo->decompressed_chunk != chunk) {
+          MEM_SAFE_FREE(undo->decompressed_buf);
+          undo->decompressed_chunk = NULL;
+          char *temp_buf;
+          if (memfile_chunk_data_get(chunk, &temp_buf) == NULL) {
+            printf("illegal read, chunk decompression failed\n");
+            return 0;
+          }
+          undo->decompressed_chunk = chunk;
+          undo->decompressed_buf = temp_buf;
+        }
+        chunk_buf = undo->decompressed_buf;
+      }
+
+      memcpy(POINTER_OFFSET(buffer, totread), chunk_buf + chunkoffset, readsize);
       totread += readsize;
       undo->reader.offset += (off64_t)readsize;
       seek += readsize;
@@ -326,6 +656,8 @@ static ssize_t undo_read(FileReader *reader, void *buffer, size_t size)
 
 static void undo_close(FileReader *reader)
 {
+  UndoReader *undo = (UndoReader *)reader;
+  MEM_SAFE_FREE(undo->decompressed_buf);
   MEM_freeN(reader);
 }
 
@@ -2446,5 +2446,27 @@ void blo_do_versions_300(FileData *fd, Library *UNUSED(lib), Main *bmain)
         scene->toolsettings->curves_sculpt->curve_length = 0.3f;
       }
     }
+
+    if (!DNA_struct_elem_find(fd->filesdna, "NodesModifierData", "int", "cache_memory_limit")) {
+      LISTBASE_FOREACH (Object *, ob, &bmain->objects) {
+        LISTBASE_FOREACH (ModifierData *, md, &ob->modifiers) {
+          if (md->type == eModifierType_Nodes) {
+            NodesModifierData *nmd = (NodesModifierData *)md;
+            nmd->cache_memory_limit = 4096;
+          }
+        }
+      }
+    }
+
+    if (!DNA_struct_elem_find(fd->filesdna, "ArmatureModifierData", "int", "cache_memory_limit")) {
+      LISTBASE_FOREACH (Object *, ob, &bmain->objects) {
+        LISTBASE_FOREACH (ModifierData *, md, &ob->modifiers) {
+          if (md->type == eModifierType_Armature) {
+            ArmatureModifierData *amd = (ArmatureModifierData *)md;
+            amd->cache_memory_limit = 1024;
+          }
+        }
+      }
+    }
   }
 }
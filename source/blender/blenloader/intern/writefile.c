@@ -643,6 +643,60 @@ static void mywrite_id_end(WriteData *wd, ID *UNUSED(id))
   }
 }
 
+/**
+ * Skip writing an ID for an undo step when it has certainly not changed since the previous step,
+ * by reusing the chunks of the previous step. This avoids the cost of serializing it again.
+ *
+ * Only done for ID types whose changes are reliably tagged in the depsgraph, which is detected
+ * with #ID.recalc_up_to_undo_push. Additionally, the ID struct itself has to be identical to the
+ * one in the previous step, that also detects changes that are not tagged, like renaming.
+ *
+ * \param id_buffer: Copy of the ID struct with cleared runtime data, as it would be written.
+ */
+static bool mywrite_id_reuse_unchanged(WriteData *wd,
+                                       const ID *id,
+                                       const void *id_buffer,
+                                       const size_t idtype_struct_size)
+{
+  if (!wd->use_memfile || !USER_EXPERIMENTAL_TEST(&U, use_undo_skip_unchanged_ids)) {
+    return false;
+  }
+  if (!ELEM(GS(id->name),
+            ID_OB,
+            ID_ME,
+            ID_CU_LEGACY,
+            ID_MB,
+            ID_LT,
+            ID_AR,
+            ID_MA,
+            ID_CV,
+            ID_PT)) {
+    return false;
+  }
+  if (id->recalc_up_to_undo_push != 0) {
+    return false;
+  }
+  bNodeTree *nodetree = ntreeFromID((ID *)id);
+  if (nodetree != NULL && nodetree->id.recalc_up_to_undo_push != 0) {
+    return false;
+  }
+
+  /* The first chunk of an ID starts with the ID struct, see #mywrite_id_begin. */
+  const MemFileChunk *ref_chunk = wd->mem.reference_current_chunk;
+  if (ref_chunk == NULL || ref_chunk->id_session_uuid != id->session_uuid ||
+      ref_chunk->size < sizeof(BHead) + idtype_struct_size) {
+    return false;
+  }
+  const BHead *ref_bhead = (const BHead *)ref_chunk->buf;
+  if (ref_bhead->code != GS(id->name) || ref_bhead->old != id ||
+      ref_bhead->len != (int)idtype_struct_size ||
+      memcmp(ref_bhead + 1, id_buffer, idtype_struct_size) != 0) {
+    return false;
+  }
+
+  return BLO_memfile_chunks_reuse_current_id(&wd->mem);
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -1198,7 +1252,10 @@ static bool write_file_handle(Main *mainvar,
         ((ID *)id_buffer)->py_instance = NULL;
 
         const IDTypeInfo *id_type = BKE_idtype_get_info_from_id(id);
-        if (id_type->blend_write != NULL) {
+        if (mywrite_id_reuse_unchanged(wd, id, id_buffer, idtype_struct_size)) {
+          /* Nothing to write. */
+        }
+        else if (id_type->blend_write != NULL) {
           id_type->blend_write(&writer, (ID *)id_buffer, id);
         }
 
@@ -83,6 +83,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math_vector.h"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 
 #include "BKE_customdata.h"
 #include "BKE_mesh.h"
@@ -374,29 +375,38 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *me, const struct BMeshFromMeshPar
       copy_v3_v3(v->no, vert_normals[i]);
     }
 
-    /* Copy Custom Data */
-    CustomData_to_bmesh_block(&me->vdata, &bm->vdata, i, &v->head.data, true);
+    /* Custom data is copied in parallel below, only the allocation uses the memory pool. */
+    CustomData_bmesh_alloc_block(&bm->vdata, &v->head.data);
+  }
+  if (is_new) {
+    bm->elem_index_dirty &= ~BM_VERT; /* Added in order, clear dirty flag. */
+  }
 
-    if (cd_vert_bweight_offset != -1) {
-      BM_ELEM_CD_SET_FLOAT(v, cd_vert_bweight_offset, (float)mvert[i].bweight / 255.0f);
-    }
+  blender::threading::parallel_for(mvert.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      BMVert *v = vtable[i];
 
-    /* Set shape key original index. */
-    if (cd_shape_keyindex_offset != -1) {
-      BM_ELEM_CD_SET_INT(v, cd_shape_keyindex_offset, i);
-    }
+      /* Copy Custom Data */
+      CustomData_to_bmesh_block(&me->vdata, &bm->vdata, i, &v->head.data, true);
 
-    /* Set shape-key data. */
-    if (tot_shape_keys) {
-      float(*co_dst)[3] = (float(*)[3])BM_ELEM_CD_GET_VOID_P(v, cd_shape_key_offset);
-      for (int j = 0; j < tot_shape_keys; j++, co_dst++) {
-        copy_v3_v3(*co_dst, shape_key_table[j][i]);
+      if (cd_vert_bweight_offset != -1) {
+        BM_ELEM_CD_SET_FLOAT(v, cd_vert_bweight_offset, (float)mvert[i].bweight / 255.0f);
+      }
+
+      /* Set shape key original index. */
+      if (cd_shape_keyindex_offset != -1) {
+        BM_ELEM_CD_SET_INT(v, cd_shape_keyindex_offset, i);
+      }
+
+      /* Set shape-key data. */
+      if (tot_shape_keys) {
+        float(*co_dst)[3] = (float(*)[3])BM_ELEM_CD_GET_VOID_P(v, cd_shape_key_offset);
+        for (int j = 0; j < tot_shape_keys; j++, co_dst++) {
+          copy_v3_v3(*co_dst, shape_key_table[j][i]);
+        }
       }
     }
-  }
-  if (is_new) {
-    bm->elem_index_dirty &= ~BM_VERT; /* Added in order, clear dirty flag. */
-  }
+  });
 
   Span<MEdge> medge{me->medge, me->totedge};
   Array<BMEdge *> etable(me->totedge);
@@ -413,37 +423,39 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *me, const struct BMeshFromMeshPar
       BM_edge_select_set(bm, e, true);
     }
 
-    /* Copy Custom Data */
-    CustomData_to_bmesh_block(&me->edata, &bm->edata, i, &e->head.data, true);
-
-    if (cd_edge_bweight_offset != -1) {
-      BM_ELEM_CD_SET_FLOAT(e, cd_edge_bweight_offset, (float)medge[i].bweight / 255.0f);
-    }
-    if (cd_edge_crease_offset != -1) {
-      BM_ELEM_CD_SET_FLOAT(e, cd_edge_crease_offset, (float)medge[i].crease / 255.0f);
-    }
+    CustomData_bmesh_alloc_block(&bm->edata, &e->head.data);
   }
   if (is_new) {
     bm->elem_index_dirty &= ~BM_EDGE; /* Added in order, clear dirty flag. */
   }
 
+  blender::threading::parallel_for(medge.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      BMEdge *e = etable[i];
+
+      /* Copy Custom Data */
+      CustomData_to_bmesh_block(&me->edata, &bm->edata, i, &e->head.data, true);
+
+      if (cd_edge_bweight_offset != -1) {
+        BM_ELEM_CD_SET_FLOAT(e, cd_edge_bweight_offset, (float)medge[i].bweight / 255.0f);
+      }
+      if (cd_edge_crease_offset != -1) {
+        BM_ELEM_CD_SET_FLOAT(e, cd_edge_crease_offset, (float)medge[i].crease / 255.0f);
+      }
+    }
+  });
+
   Span<MPoly> mpoly{me->mpoly, me->totpoly};
   Span<MLoop> mloop{me->mloop, me->totloop};
 
-  /* Only needed for selection. */
-
-  Array<BMFace *> ftable;
-  if (me->mselect && me->totselect != 0) {
-    ftable.reinitialize(me->totpoly);
-  }
+  /* Null for skipped faces. Also needed for selection. */
+  Array<BMFace *> ftable(me->totpoly);
 
   int totloops = 0;
   for (const int i : mpoly.index_range()) {
     BMFace *f = bm_face_create_from_mpoly(
         *bm, mloop.slice(mpoly[i].loopstart, mpoly[i].totloop), vtable, etable);
-    if (!ftable.is_empty()) {
-      ftable[i] = f;
-    }
+    ftable[i] = f;
 
     if (UNLIKELY(f == nullptr)) {
       printf(
@@ -471,28 +483,45 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *me, const struct BMeshFromMeshPar
       bm->act_face = f;
     }
 
-    int j = mpoly[i].loopstart;
     BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
     BMLoop *l_iter = l_first;
     do {
       /* Don't use 'j' since we may have skipped some faces, hence some loops. */
       BM_elem_index_set(l_iter, totloops++); /* set_ok */
 
-      /* Save index of corresponding #MLoop. */
-      CustomData_to_bmesh_block(&me->ldata, &bm->ldata, j++, &l_iter->head.data, true);
+      CustomData_bmesh_alloc_block(&bm->ldata, &l_iter->head.data);
     } while ((l_iter = l_iter->next) != l_first);
 
-    /* Copy Custom Data */
-    CustomData_to_bmesh_block(&me->pdata, &bm->pdata, i, &f->head.data, true);
-
-    if (params->calc_face_normal) {
-      BM_face_normal_update(f);
-    }
+    CustomData_bmesh_alloc_block(&bm->pdata, &f->head.data);
   }
   if (is_new) {
     bm->elem_index_dirty &= ~(BM_FACE | BM_LOOP); /* Added in order, clear dirty flag. */
   }
 
+  blender::threading::parallel_for(mpoly.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      BMFace *f = ftable[i];
+      if (f == nullptr) {
+        continue;
+      }
+
+      int j = mpoly[i].loopstart;
+      BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
+      BMLoop *l_iter = l_first;
+      do {
+        /* Save index of corresponding #MLoop. */
+        CustomData_to_bmesh_block(&me->ldata, &bm->ldata, j++, &l_iter->head.data, true);
+      } while ((l_iter = l_iter->next) != l_first);
+
+      /* Copy Custom Data */
+      CustomData_to_bmesh_block(&me->pdata, &bm->pdata, i, &f->head.data, true);
+
+      if (params->calc_face_normal) {
+        BM_face_normal_update(f);
+      }
+    }
+  });
+
   /* -------------------------------------------------------------------- */
   /* MSelect clears the array elements (to avoid adding multiple times).
    *
@@ -907,10 +936,7 @@ BLI_INLINE void bmesh_quick_edgedraw_flag(MEdge *med, BMEdge *e)
 
 void BM_mesh_bm_to_me(Main *bmain, BMesh *bm, Mesh *me, const struct BMeshToMeshParams *params)
 {
-  MEdge *med;
-  BMVert *v, *eve;
-  BMEdge *e;
-  BMFace *f;
+  BMVert *eve;
   BMIter iter;
   int i, j;
 
@@ -970,90 +996,92 @@ void BM_mesh_bm_to_me(Main *bmain, BMesh *bm, Mesh *me, const struct BMeshToMesh
   /* This is called again, 'dotess' arg is used there. */
   BKE_mesh_update_customdata_pointers(me, false);
 
-  i = 0;
-  BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
-    copy_v3_v3(mvert->co, v->co);
+  /* Elements are written in parallel from their index, loops are indexed in face order. */
+  BM_mesh_elem_index_ensure(bm, BM_VERT | BM_EDGE | BM_FACE | BM_LOOP);
+  BM_mesh_elem_table_ensure(bm, BM_VERT | BM_EDGE | BM_FACE);
 
-    mvert->flag = BM_vert_flag_to_mflag(v);
+  blender::threading::parallel_for(IndexRange(bm->totvert), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      BMVert *v = BM_vert_at_index(bm, i);
+      MVert *mv = &mvert[i];
 
-    BM_elem_index_set(v, i); /* set_inline */
+      copy_v3_v3(mv->co, v->co);
 
-    /* Copy over custom-data. */
-    CustomData_from_bmesh_block(&bm->vdata, &me->vdata, v->head.data, i);
+      mv->flag = BM_vert_flag_to_mflag(v);
 
-    if (cd_vert_bweight_offset != -1) {
-      mvert->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(v, cd_vert_bweight_offset);
-    }
+      /* Copy over custom-data. */
+      CustomData_from_bmesh_block(&bm->vdata, &me->vdata, v->head.data, i);
 
-    i++;
-    mvert++;
+      if (cd_vert_bweight_offset != -1) {
+        mv->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(v, cd_vert_bweight_offset);
+      }
 
-    BM_CHECK_ELEMENT(v);
-  }
-  bm->elem_index_dirty &= ~BM_VERT;
+      BM_CHECK_ELEMENT(v);
+    }
+  });
 
-  med = medge;
-  i = 0;
-  BM_ITER_MESH (e, &iter, bm, BM_EDGES_OF_MESH) {
-    med->v1 = BM_elem_index_get(e->v1);
-    med->v2 = BM_elem_index_get(e->v2);
+  blender::threading::parallel_for(IndexRange(bm->totedge), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      BMEdge *e = BM_edge_at_index(bm, i);
+      MEdge *med = &medge[i];
 
-    med->flag = BM_edge_flag_to_mflag(e);
+      med->v1 = BM_elem_index_get(e->v1);
+      med->v2 = BM_elem_index_get(e->v2);
 
-    BM_elem_index_set(e, i); /* set_inline */
+      med->flag = BM_edge_flag_to_mflag(e);
 
-    /* Copy over custom-data. */
-    CustomData_from_bmesh_block(&bm->edata, &me->edata, e->head.data, i);
+      /* Copy over custom-data. */
+      CustomData_from_bmesh_block(&bm->edata, &me->edata, e->head.data, i);
 
-    bmesh_quick_edgedraw_flag(med, e);
+      bmesh_quick_edgedraw_flag(med, e);
 
-    if (cd_edge_crease_offset != -1) {
-      med->crease = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(e, cd_edge_crease_offset);
-    }
-    if (cd_edge_bweight_offset != -1) {
-      med->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(e, cd_edge_bweight_offset);
-    }
+      if (cd_edge_crease_offset != -1) {
+        med->crease = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(e, cd_edge_crease_offset);
+      }
+      if (cd_edge_bweight_offset != -1) {
+        med->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(e, cd_edge_bweight_offset);
+      }
 
-    i++;
-    med++;
-    BM_CHECK_ELEMENT(e);
-  }
-  bm->elem_index_dirty &= ~BM_EDGE;
-
-  i = 0;
-  j = 0;
-  BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
-    BMLoop *l_iter, *l_first;
-    mpoly->loopstart = j;
-    mpoly->totloop = f->len;
-    mpoly->mat_nr = f->mat_nr;
-    mpoly->flag = BM_face_flag_to_mflag(f);
-
-    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
-    do {
-      mloop->e = BM_elem_index_get(l_iter->e);
-      mloop->v = BM_elem_index_get(l_iter->v);
+      BM_CHECK_ELEMENT(e);
+    }
+  });
+
+  blender::threading::parallel_for(IndexRange(bm->totface), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      BMFace *f = BM_face_at_index(bm, i);
+      MPoly *mp = &mpoly[i];
+      BMLoop *l_iter, *l_first;
+      l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+
+      int j = BM_elem_index_get(l_first);
+      mp->loopstart = j;
+      mp->totloop = f->len;
+      mp->mat_nr = f->mat_nr;
+      mp->flag = BM_face_flag_to_mflag(f);
+
+      do {
+        MLoop *ml = &mloop[j];
+        ml->e = BM_elem_index_get(l_iter->e);
+        ml->v = BM_elem_index_get(l_iter->v);
+
+        /* Copy over custom-data. */
+        CustomData_from_bmesh_block(&bm->ldata, &me->ldata, l_iter->head.data, j);
+
+        j++;
+        BM_CHECK_ELEMENT(l_iter);
+        BM_CHECK_ELEMENT(l_iter->e);
+        BM_CHECK_ELEMENT(l_iter->v);
+      } while ((l_iter = l_iter->next) != l_first);
 
       /* Copy over custom-data. */
-      CustomData_from_bmesh_block(&bm->ldata, &me->ldata, l_iter->head.data, j);
+      CustomData_from_bmesh_block(&bm->pdata, &me->pdata, f->head.data, i);
 
-      j++;
-      mloop++;
-      BM_CHECK_ELEMENT(l_iter);
-      BM_CHECK_ELEMENT(l_iter->e);
-      BM_CHECK_ELEMENT(l_iter->v);
-    } while ((l_iter = l_iter->next) != l_first);
-
-    if (f == bm->act_face) {
-      me->act_face = i;
+      BM_CHECK_ELEMENT(f);
     }
+  });
 
-    /* Copy over custom-data. */
-    CustomData_from_bmesh_block(&bm->pdata, &me->pdata, f->head.data, i);
-
-    i++;
-    mpoly++;
-    BM_CHECK_ELEMENT(f);
+  if (bm->act_face) {
+    me->act_face = BM_elem_index_get(bm->act_face);
   }
 
   /* Patch hook indices and vertex parents. */
@@ -1199,15 +1227,10 @@ void BM_mesh_bm_to_me_for_eval(BMesh *bm, Mesh *me, const CustomData_MeshMasks *
 
   BKE_mesh_update_customdata_pointers(me, false);
 
-  BMIter iter;
-  BMVert *eve;
-  BMEdge *eed;
-  BMFace *efa;
   MVert *mvert = me->mvert;
   MEdge *medge = me->medge;
   MLoop *mloop = me->mloop;
   MPoly *mpoly = me->mpoly;
-  unsigned int i, j;
 
   const int cd_vert_bweight_offset = CustomData_get_offset(&bm->vdata, CD_BWEIGHT);
   const int cd_edge_bweight_offset = CustomData_get_offset(&bm->edata, CD_BWEIGHT);
@@ -1219,80 +1242,83 @@ void BM_mesh_bm_to_me_for_eval(BMesh *bm, Mesh *me, const CustomData_MeshMasks *
 
   me->runtime.deformed_only = true;
 
-  BM_ITER_MESH_INDEX (eve, &iter, bm, BM_VERTS_OF_MESH, i) {
-    MVert *mv = &mvert[i];
+  /* Elements are written in parallel from their index, loops are indexed in face order. */
+  BM_mesh_elem_index_ensure(bm, BM_VERT | BM_EDGE | BM_FACE | BM_LOOP);
+  BM_mesh_elem_table_ensure(bm, BM_VERT | BM_EDGE | BM_FACE);
 
-    copy_v3_v3(mv->co, eve->co);
+  blender::threading::parallel_for(IndexRange(bm->totvert), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      BMVert *eve = BM_vert_at_index(bm, i);
+      MVert *mv = &mvert[i];
 
-    BM_elem_index_set(eve, i); /* set_inline */
+      copy_v3_v3(mv->co, eve->co);
 
-    mv->flag = BM_vert_flag_to_mflag(eve);
+      mv->flag = BM_vert_flag_to_mflag(eve);
 
-    if (cd_vert_bweight_offset != -1) {
-      mv->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(eve, cd_vert_bweight_offset);
-    }
+      if (cd_vert_bweight_offset != -1) {
+        mv->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(eve, cd_vert_bweight_offset);
+      }
 
-    CustomData_from_bmesh_block(&bm->vdata, &me->vdata, eve->head.data, i);
-  }
-  bm->elem_index_dirty &= ~BM_VERT;
+      CustomData_from_bmesh_block(&bm->vdata, &me->vdata, eve->head.data, i);
+    }
+  });
 
-  BM_ITER_MESH_INDEX (eed, &iter, bm, BM_EDGES_OF_MESH, i) {
-    MEdge *med = &medge[i];
+  blender::threading::parallel_for(IndexRange(bm->totedge), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      BMEdge *eed = BM_edge_at_index(bm, i);
+      MEdge *med = &medge[i];
 
-    BM_elem_index_set(eed, i); /* set_inline */
+      med->v1 = BM_elem_index_get(eed->v1);
+      med->v2 = BM_elem_index_get(eed->v2);
 
-    med->v1 = BM_elem_index_get(eed->v1);
-    med->v2 = BM_elem_index_get(eed->v2);
+      med->flag = BM_edge_flag_to_mflag(eed);
 
-    med->flag = BM_edge_flag_to_mflag(eed);
+      /* Handle this differently to editmode switching,
+       * only enable draw for single user edges rather than calculating angle. */
+      if ((med->flag & ME_EDGEDRAW) == 0) {
+        if (eed->l && eed->l == eed->l->radial_next) {
+          med->flag |= ME_EDGEDRAW;
+        }
+      }
 
-    /* Handle this differently to editmode switching,
-     * only enable draw for single user edges rather than calculating angle. */
-    if ((med->flag & ME_EDGEDRAW) == 0) {
-      if (eed->l && eed->l == eed->l->radial_next) {
-        med->flag |= ME_EDGEDRAW;
+      if (cd_edge_crease_offset != -1) {
+        med->crease = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(eed, cd_edge_crease_offset);
+      }
+      if (cd_edge_bweight_offset != -1) {
+        med->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(eed, cd_edge_bweight_offset);
       }
-    }
 
-    if (cd_edge_crease_offset != -1) {
-      med->crease = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(eed, cd_edge_crease_offset);
-    }
-    if (cd_edge_bweight_offset != -1) {
-      med->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(eed, cd_edge_bweight_offset);
+      CustomData_from_bmesh_block(&bm->edata, &me->edata, eed->head.data, i);
     }
+  });
 
-    CustomData_from_bmesh_block(&bm->edata, &me->edata, eed->head.data, i);
-  }
-  bm->elem_index_dirty &= ~BM_EDGE;
+  blender::threading::parallel_for(IndexRange(bm->totface), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      BMFace *efa = BM_face_at_index(bm, i);
+      BMLoop *l_iter;
+      BMLoop *l_first;
+      MPoly *mp = &mpoly[i];
 
-  j = 0;
-  BM_ITER_MESH_INDEX (efa, &iter, bm, BM_FACES_OF_MESH, i) {
-    BMLoop *l_iter;
-    BMLoop *l_first;
-    MPoly *mp = &mpoly[i];
+      l_iter = l_first = BM_FACE_FIRST_LOOP(efa);
+      int j = BM_elem_index_get(l_first);
 
-    BM_elem_index_set(efa, i); /* set_inline */
+      mp->totloop = efa->len;
+      mp->flag = BM_face_flag_to_mflag(efa);
+      mp->loopstart = j;
+      mp->mat_nr = efa->mat_nr;
 
-    mp->totloop = efa->len;
-    mp->flag = BM_face_flag_to_mflag(efa);
-    mp->loopstart = j;
-    mp->mat_nr = efa->mat_nr;
+      do {
+        MLoop *ml = &mloop[j];
+        ml->v = BM_elem_index_get(l_iter->v);
+        ml->e = BM_elem_index_get(l_iter->e);
+        CustomData_from_bmesh_block(&bm->ldata, &me->ldata, l_iter->head.data, j);
 
-    l_iter = l_first = BM_FACE_FIRST_LOOP(efa);
-    do {
-      mloop->v = BM_elem_index_get(l_iter->v);
-      mloop->e = BM_elem_index_get(l_iter->e);
-      CustomData_from_bmesh_block(&bm->ldata, &me->ldata, l_iter->head.data, j);
+        j++;
+      } while ((l_iter = l_iter->next) != l_first);
 
-      BM_elem_index_set(l_iter, j); /* set_inline */
-
-      j++;
-      mloop++;
-    } while ((l_iter = l_iter->next) != l_first);
-
-    CustomData_from_bmesh_block(&bm->pdata, &me->pdata, efa->head.data, i);
-  }
-  bm->elem_index_dirty &= ~(BM_FACE | BM_LOOP);
+      CustomData_from_bmesh_block(&bm->pdata, &me->pdata, efa->head.data, i);
+    }
+  });
 
   me->cd_flag = BM_mesh_cd_flag_from_bmesh(bm);
 }
@@ -937,6 +937,7 @@ bool BM_mesh_intersect(BMesh *bm,
                        struct BMLoop *(*looptris)[3],
                        const int looptris_tot,
                        int (*test_fn)(BMFace *f, void *user_data),
+                       int (*ray_hits_fn)(const float co[3], int side, void *user_data),
                        void *user_data,
                        const bool use_self,
                        const bool use_separate,
@@ -1539,7 +1540,10 @@ bool BM_mesh_intersect(BMesh *bm,
         // BM_face_calc_center_median(f, co);
         BM_face_calc_point_in_face(f, co);
 
-        hits = isect_bvhtree_point_v3(tree_pair[side], looptri_coords, co);
+        hits = (ray_hits_fn != NULL) ? ray_hits_fn(co, side, user_data) : -1;
+        if (hits == -1) {
+          hits = isect_bvhtree_point_v3(tree_pair[side], looptri_coords, co);
+        }
 
         switch (boolean_mode) {
           case BMESH_ISECT_BOOLEAN_ISECT:
@@ -15,6 +15,9 @@ extern "C" {
  * leaving the resulting edges tagged.
  *
  * \param test_fn: Return value: -1: skip, 0: tree_a, 1: tree_b (use_self == false)
+ * \param ray_hits_fn: Optional, only used for booleans: return how many faces of a side
+ * (0: tree_a, 1: tree_b) a ray from \a co along the positive X axis hits, or -1 to ray-cast
+ * the faces of that side in \a bm. Allows to classify against faces that aren't in \a bm.
  * \param boolean_mode: -1: no-boolean, 0: intersection... see #BMESH_ISECT_BOOLEAN_ISECT.
  * \return true if the mesh is changed (intersections cut or faces removed from boolean).
  */
@@ -22,6 +25,7 @@ bool BM_mesh_intersect(BMesh *bm,
                        struct BMLoop *(*looptris)[3],
                        int looptris_tot,
                        int (*test_fn)(BMFace *f, void *user_data),
+                       int (*ray_hits_fn)(const float co[3], int side, void *user_data),
                        void *user_data,
                        bool use_self,
                        bool use_separate,
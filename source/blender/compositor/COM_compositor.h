@@ -345,6 +345,11 @@ void COM_execute(RenderData *render_data,
  */
 void COM_deinitialize(void);
 
+/**
+ * \brief Free the shaders used by the GPU execution. A GPU context must be active.
+ */
+void COM_free_gpu_shaders(void);
+
 /**
  * \brief Clear all compositor caches. (Compositor system will still remain available).
  * To deinitialize the compositor use the COM_deinitialize method.
@@ -45,4 +45,10 @@ eExecutionModel CompositorContext::get_execution_model() const
   return eExecutionModel::Tiled;
 }
 
+bool CompositorContext::is_gpu_enabled() const
+{
+  return (this->get_bnodetree()->flag & NTREE_COM_GPU) != 0 &&
+         get_execution_model() == eExecutionModel::FullFrame;
+}
+
 }  // namespace blender::compositor
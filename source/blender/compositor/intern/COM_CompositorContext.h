@@ -119,6 +119,14 @@ class CompositorContext {
     return bnodetree_;
   }
 
+  /**
+   * \brief get the bnodetree of the context, to record its runtime execution statistics
+   */
+  bNodeTree *get_bnodetree_for_write() const
+  {
+    return bnodetree_;
+  }
+
   /**
    * \brief get the scene of the context
    */
@@ -261,6 +269,11 @@ class CompositorContext {
     return (this->get_bnodetree()->flag & NTREE_COM_GROUPNODE_BUFFER) != 0;
   }
 
+  /**
+   * Whether operations supporting it are rendered on the GPU. Only for full frame execution.
+   */
+  bool is_gpu_enabled() const;
+
   /**
    * \brief Get the render percentage as a factor.
    * The compositor uses a factor i.o. a percentage.
@@ -5,7 +5,13 @@
 
 #include "BLT_translation.h"
 
+#include "BKE_node.h"
+
+#include "PIL_time.h"
+
 #include "COM_Debug.h"
+#include "COM_GPUExecution.h"
+#include "COM_ResultCache.h"
 #include "COM_ViewerOperation.h"
 #include "COM_WorkScheduler.h"
 
@@ -20,7 +26,10 @@ FullFrameExecutionModel::FullFrameExecutionModel(CompositorContext &context,
                                                  Span<NodeOperation *> operations)
     : ExecutionModel(context, operations),
       active_buffers_(shared_buffers),
-      num_operations_finished_(0)
+      num_operations_finished_(0),
+      use_gpu_(false),
+      use_result_cache_(!context.is_rendering()),
+      use_execution_stats_(!context.is_rendering())
 {
   priorities_.append(eCompositorPriority::High);
   if (!context.is_fast_calculation()) {
@@ -36,8 +45,17 @@ void FullFrameExecutionModel::execute(ExecutionSystem &exec_system)
 
   DebugInfo::graphviz(&exec_system, "compositor_prior_rendering");
 
+  bNodeTree *stats_tree = context_.get_bnodetree_for_write();
+  if (use_execution_stats_) {
+    BKE_node_execution_stats_clear(stats_tree);
+  }
+
   determine_areas_to_render_and_reads();
   render_operations();
+
+  if (use_execution_stats_) {
+    BKE_node_execution_stats_accumulate_groups(stats_tree);
+  }
 }
 
 void FullFrameExecutionModel::determine_areas_to_render_and_reads()
@@ -80,7 +98,8 @@ Vector<MemoryBuffer *> FullFrameExecutionModel::get_input_buffers(NodeOperation
 
 MemoryBuffer *FullFrameExecutionModel::create_operation_buffer(NodeOperation *op,
                                                                const int output_x,
-                                                               const int output_y)
+                                                               const int output_y,
+                                                               Span<rcti> areas)
 {
   rcti rect;
   BLI_rcti_init(
@@ -88,23 +107,88 @@ MemoryBuffer *FullFrameExecutionModel::create_operation_buffer(NodeOperation *op
 
   const DataType data_type = op->get_output_socket(0)->get_data_type();
   const bool is_a_single_elem = op->get_flags().is_constant_operation;
+  if (!is_a_single_elem && !areas.is_empty() && active_buffers_.has_partial_reads_only(op)) {
+    /* Readers only read their areas of interest, which are the areas to render. */
+    rcti areas_rect = areas[0];
+    for (const rcti &area : areas.drop_front(1)) {
+      BLI_rcti_union(&areas_rect, &area);
+    }
+    BLI_rcti_isect(&rect, &areas_rect, &rect);
+  }
   return new MemoryBuffer(data_type, rect, is_a_single_elem);
 }
 
+static size_t get_buffer_mem_size(const MemoryBuffer *buffer)
+{
+  if (buffer == nullptr) {
+    return 0;
+  }
+  const size_t num_elems = buffer->is_a_single_elem() ?
+                               1 :
+                               size_t(buffer->get_width()) * buffer->get_height();
+  return sizeof(float) * num_elems * buffer->get_num_channels();
+}
+
+void FullFrameExecutionModel::add_execution_stats(NodeOperation *op,
+                                                  const double start_time,
+                                                  const size_t mem_size)
+{
+  const bNodeInstanceKey key = op->get_node_instance_key();
+  if (!use_execution_stats_ || key.value == NODE_INSTANCE_KEY_NONE.value) {
+    return;
+  }
+
+  bNodeExecutionStats *stats = BKE_node_execution_stats_ensure(
+      context_.get_bnodetree_for_write(), key);
+  stats->time_us += uint64_t((PIL_check_seconds_timer() - start_time) * 1000000.0);
+  stats->mem_size += mem_size;
+}
+
 void FullFrameExecutionModel::render_operation(NodeOperation *op)
 {
+  const double start_time = PIL_check_seconds_timer();
+  if (use_gpu_ && can_render_operation_gpu(op)) {
+    render_operation_gpu(op);
+    /* Textures are four channels floats, see #GPUExecution::create_texture. */
+    add_execution_stats(op, start_time, sizeof(float[4]) * op->get_width() * op->get_height());
+    return;
+  }
+
   /* Output has no offset for easier image algorithms implementation on operations. */
   constexpr int output_x = 0;
   constexpr int output_y = 0;
 
+  if (float *shared_data = op->get_shared_output_data()) {
+    /* Readers get views of their inputs and don't write to them, so the data can be shared. */
+    const DataType data_type = op->get_output_socket(0)->get_data_type();
+    MemoryBuffer *op_buf = new MemoryBuffer(
+        shared_data, COM_data_type_num_channels(data_type), op->get_width(), op->get_height());
+    DebugInfo::operation_rendered(op, op_buf);
+    add_execution_stats(op, start_time, 0);
+    active_buffers_.set_rendered_buffer(op, std::unique_ptr<MemoryBuffer>(op_buf));
+    operation_finished(op);
+    return;
+  }
+
+  const int op_offset_x = output_x - op->get_canvas().xmin;
+  const int op_offset_y = output_y - op->get_canvas().ymin;
+  Vector<rcti> areas = active_buffers_.get_areas_to_render(op, op_offset_x, op_offset_y);
+
   const bool has_outputs = op->get_number_of_output_sockets() > 0;
-  MemoryBuffer *op_buf = has_outputs ? create_operation_buffer(op, output_x, output_y) : nullptr;
+  MemoryBuffer *op_buf = has_outputs ? create_operation_buffer(op, output_x, output_y, areas) :
+                                       nullptr;
   if (op->get_width() > 0 && op->get_height() > 0) {
     Vector<MemoryBuffer *> input_bufs = get_input_buffers(op, output_x, output_y);
-    const int op_offset_x = output_x - op->get_canvas().xmin;
-    const int op_offset_y = output_y - op->get_canvas().ymin;
-    Vector<rcti> areas = active_buffers_.get_areas_to_render(op, op_offset_x, op_offset_y);
-    op->render(op_buf, areas, input_bufs);
+    std::optional<ResultCacheKey> cache_key;
+    if (use_result_cache_ && op_buf && op->get_flags().is_result_cacheable) {
+      cache_key = ResultCache::generate_key(op, *op_buf, areas, input_bufs);
+    }
+    if (!cache_key || !ResultCache::lookup(*cache_key, *op_buf)) {
+      op->render(op_buf, areas, input_bufs);
+      if (cache_key) {
+        ResultCache::add(std::move(*cache_key), *op_buf);
+      }
+    }
     DebugInfo::operation_rendered(op, op_buf);
 
     for (MemoryBuffer *buf : input_bufs) {
@@ -113,16 +197,56 @@ void FullFrameExecutionModel::render_operation(NodeOperation *op)
   }
   /* Even if operation has no resolution set the empty buffer. It will be clipped with a
    * TranslateOperation from convert resolutions if linked to an operation with resolution. */
+  add_execution_stats(op, start_time, get_buffer_mem_size(op_buf));
   active_buffers_.set_rendered_buffer(op, std::unique_ptr<MemoryBuffer>(op_buf));
 
   operation_finished(op);
 }
 
+bool FullFrameExecutionModel::can_render_operation_gpu(NodeOperation *op)
+{
+  const bool has_color_output = op->get_number_of_output_sockets() > 0 &&
+                                op->get_output_socket(0)->get_data_type() == DataType::Color;
+  if (!has_color_output || op->get_flags().is_constant_operation || op->get_width() == 0 ||
+      op->get_height() == 0 || !op->can_render_gpu()) {
+    return false;
+  }
+
+  /* Shaders read inputs at the same coordinates as the output, inputs at other offsets or sizes
+   * are rendered on the CPU. */
+  for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+    NodeOperation *input = op->get_input_operation(i);
+    if (!input->get_flags().is_constant_operation &&
+        !BLI_rcti_compare(&input->get_canvas(), &op->get_canvas())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void FullFrameExecutionModel::render_operation_gpu(NodeOperation *op)
+{
+  const int num_inputs = op->get_number_of_input_sockets();
+  Vector<GPUTexture *> input_textures(num_inputs);
+  for (int i = 0; i < num_inputs; i++) {
+    input_textures[i] = active_buffers_.get_rendered_texture(op->get_input_operation(i));
+  }
+
+  /* The whole canvas is rendered, areas of interest only matter for CPU buffers. */
+  GPUTexture *texture = GPUExecution::create_texture(
+      DataType::Color, op->get_width(), op->get_height());
+  op->render_gpu(texture, input_textures);
+  active_buffers_.set_rendered_texture(op, texture);
+
+  operation_finished(op);
+}
+
 void FullFrameExecutionModel::render_operations()
 {
   const bool is_rendering = context_.is_rendering();
 
   WorkScheduler::start(this->context_);
+  use_gpu_ = context_.is_gpu_enabled() && GPUExecution::begin();
   for (eCompositorPriority priority : priorities_) {
     for (NodeOperation *op : operations_) {
       const bool has_size = op->get_width() > 0 && op->get_height() > 0;
@@ -137,6 +261,11 @@ void FullFrameExecutionModel::render_operations()
       }
     }
   }
+  if (use_gpu_) {
+    active_buffers_.free_textures();
+    GPUExecution::end();
+    use_gpu_ = false;
+  }
   WorkScheduler::stop();
 }
 
@@ -224,7 +353,7 @@ void FullFrameExecutionModel::determine_reads(NodeOperation *output_op)
       if (!active_buffers_.has_registered_reads(input_op)) {
         stack.append(input_op);
       }
-      active_buffers_.register_read(input_op);
+      active_buffers_.register_read(input_op, operation->get_flags().can_read_partial_inputs);
     }
   }
 }
@@ -42,6 +42,23 @@ class FullFrameExecutionModel : public ExecutionModel {
    */
   Vector<eCompositorPriority> priorities_;
 
+  /**
+   * Whether operations supporting it are rendered on the GPU, see #GPUExecution.
+   */
+  bool use_gpu_;
+
+  /**
+   * Whether results of cacheable operations are kept between executions, see #ResultCache.
+   * Only done while editing, when most inputs don't change between executions.
+   */
+  bool use_result_cache_;
+
+  /**
+   * Whether execution time and memory of operations are recorded into their node statistics,
+   * see #bNodeExecutionStats. Only done while editing, to display them in the node editor.
+   */
+  bool use_execution_stats_;
+
  public:
   FullFrameExecutionModel(CompositorContext &context,
                           SharedOperationBuffers &shared_buffers,
@@ -61,8 +78,25 @@ class FullFrameExecutionModel : public ExecutionModel {
    * Returned memory buffers must be deleted.
    */
   Vector<MemoryBuffer *> get_input_buffers(NodeOperation *op, int output_x, int output_y);
-  MemoryBuffer *create_operation_buffer(NodeOperation *op, int output_x, int output_y);
+  /**
+   * Creates the output buffer of given operation. When all its readers can read partial inputs
+   * only the given areas to render are allocated, otherwise the whole canvas is.
+   */
+  MemoryBuffer *create_operation_buffer(NodeOperation *op,
+                                        int output_x,
+                                        int output_y,
+                                        Span<rcti> areas);
   void render_operation(NodeOperation *op);
+  /**
+   * Whether given operation and its inputs layout can be rendered on the GPU.
+   */
+  bool can_render_operation_gpu(NodeOperation *op);
+  void render_operation_gpu(NodeOperation *op);
+  /**
+   * Adds the time elapsed since \a start_time and given memory size to the statistics of the
+   * node given operation belongs to.
+   */
+  void add_execution_stats(NodeOperation *op, double start_time, size_t mem_size);
 
   void operation_finished(NodeOperation *operation);
 
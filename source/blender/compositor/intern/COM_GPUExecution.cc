@@ -0,0 +1,172 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. */
+
+#include <string>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_map.hh"
+#include "BLI_math_base.h"
+#include "BLI_math_vector.h"
+
+#include "DRW_engine.h"
+
+#include "GPU_capabilities.h"
+#include "GPU_compute.h"
+#include "GPU_shader.h"
+#include "GPU_state.h"
+#include "GPU_texture.h"
+
+#include "COM_GPUExecution.h"
+#include "COM_MemoryBuffer.h"
+
+extern "C" char datatoc_compositor_lib_glsl[];
+
+namespace blender::compositor {
+
+/* Must match `compositor_lib.glsl`. */
+static constexpr int LOCAL_WORK_GROUP_SIZE = 16;
+
+/* Only accessed from the execution thread, compositor executions are serialized. */
+static Map<std::string, GPUShader *> g_shaders;
+
+bool GPUExecution::begin()
+{
+  DRW_opengl_context_enable();
+  if (!GPU_compute_shader_support()) {
+    DRW_opengl_context_disable();
+    return false;
+  }
+  return true;
+}
+
+void GPUExecution::end()
+{
+  GPU_shader_unbind();
+  DRW_opengl_context_disable();
+}
+
+static int get_texture_num_channels(const DataType data_type)
+{
+  return data_type == DataType::Value ? 1 : 4;
+}
+
+GPUTexture *GPUExecution::create_texture(const DataType data_type,
+                                         const int width,
+                                         const int height)
+{
+  const eGPUTextureFormat format = data_type == DataType::Value ? GPU_R32F : GPU_RGBA32F;
+  return GPU_texture_create_2d("compositor_operation", width, height, 1, format, nullptr);
+}
+
+GPUTexture *GPUExecution::create_texture_from_buffer(MemoryBuffer &buffer,
+                                                     const int width,
+                                                     const int height)
+{
+  const int num_channels = buffer.get_num_channels();
+  const DataType data_type = num_channels == 1 ? DataType::Value :
+                             num_channels == 3 ? DataType::Vector :
+                                                 DataType::Color;
+  const bool is_a_single_elem = buffer.is_a_single_elem();
+  GPUTexture *texture = create_texture(
+      data_type, is_a_single_elem ? 1 : width, is_a_single_elem ? 1 : height);
+
+  const rcti &rect = buffer.get_rect();
+  const int offset_x = is_a_single_elem ? 0 : rect.xmin;
+  const int offset_y = is_a_single_elem ? 0 : rect.ymin;
+  const int buffer_width = buffer.get_width();
+  const int buffer_height = buffer.get_height();
+  BLI_assert(is_a_single_elem ||
+             (offset_x >= 0 && offset_y >= 0 && rect.xmax <= width && rect.ymax <= height));
+
+  if (num_channels == get_texture_num_channels(data_type)) {
+    GPU_texture_update_sub(texture,
+                           GPU_DATA_FLOAT,
+                           buffer.get_buffer(),
+                           offset_x,
+                           offset_y,
+                           0,
+                           buffer_width,
+                           buffer_height,
+                           0);
+    return texture;
+  }
+
+  /* Vectors have no matching texture format and are padded to four channels. */
+  const int64_t num_elems = int64_t(buffer_width) * buffer_height;
+  float *data = static_cast<float *>(MEM_mallocN(sizeof(float[4]) * num_elems, __func__));
+  const float *src = buffer.get_buffer();
+  for (int64_t i = 0; i < num_elems; i++) {
+    copy_v3_v3(&data[i * 4], &src[i * num_channels]);
+    data[i * 4 + 3] = 0.0f;
+  }
+  GPU_texture_update_sub(
+      texture, GPU_DATA_FLOAT, data, offset_x, offset_y, 0, buffer_width, buffer_height, 0);
+  MEM_freeN(data);
+  return texture;
+}
+
+MemoryBuffer *GPUExecution::create_buffer_from_texture(GPUTexture *texture,
+                                                       const DataType data_type,
+                                                       const rcti &rect)
+{
+  MemoryBuffer *buffer = new MemoryBuffer(data_type, rect);
+  BLI_assert(GPU_texture_width(texture) == buffer->get_width() &&
+             GPU_texture_height(texture) == buffer->get_height());
+
+  float *data = static_cast<float *>(GPU_texture_read(texture, GPU_DATA_FLOAT, 0));
+  const int num_channels = buffer->get_num_channels();
+  const int texture_num_channels = get_texture_num_channels(data_type);
+  const int64_t num_elems = int64_t(buffer->get_width()) * buffer->get_height();
+  float *dst = buffer->get_buffer();
+  if (num_channels == texture_num_channels) {
+    memcpy(dst, data, sizeof(float) * num_channels * num_elems);
+  }
+  else {
+    for (int64_t i = 0; i < num_elems; i++) {
+      memcpy(&dst[i * num_channels],
+             &data[i * texture_num_channels],
+             sizeof(float) * num_channels);
+    }
+  }
+  MEM_freeN(data);
+  return buffer;
+}
+
+GPUShader *GPUExecution::get_shader(const char *name, const char *source, const char *defines)
+{
+  return g_shaders.lookup_or_add_cb(name, [&]() {
+    GPUShader *shader = GPU_shader_create_compute(
+        source, datatoc_compositor_lib_glsl, defines, name);
+    BLI_assert(shader != nullptr);
+    return shader;
+  });
+}
+
+void GPUExecution::bind_texture(GPUShader *shader, const char *name, GPUTexture *texture)
+{
+  GPU_texture_bind(texture, GPU_shader_get_texture_binding(shader, name));
+}
+
+void GPUExecution::dispatch(GPUShader *shader, GPUTexture *output)
+{
+  GPU_texture_image_bind(output, GPU_shader_get_texture_binding(shader, "output_img"));
+
+  const int groups_x = divide_ceil_u(GPU_texture_width(output), LOCAL_WORK_GROUP_SIZE);
+  const int groups_y = divide_ceil_u(GPU_texture_height(output), LOCAL_WORK_GROUP_SIZE);
+  GPU_compute_dispatch(shader, groups_x, groups_y, 1);
+
+  /* Results are either read by the next operations or downloaded. */
+  GPU_memory_barrier(GPU_BARRIER_TEXTURE_FETCH | GPU_BARRIER_TEXTURE_UPDATE);
+  GPU_texture_image_unbind(output);
+}
+
+void GPUExecution::free_shaders()
+{
+  for (GPUShader *shader : g_shaders.values()) {
+    GPU_shader_free(shader);
+  }
+  g_shaders.clear();
+}
+
+}  // namespace blender::compositor
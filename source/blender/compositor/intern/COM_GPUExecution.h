@@ -0,0 +1,73 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. */
+
+#pragma once
+
+#include "DNA_vec_types.h"
+
+#include "COM_Enums.h"
+
+struct GPUShader;
+struct GPUTexture;
+
+namespace blender::compositor {
+
+class MemoryBuffer;
+
+/**
+ * \brief GPU execution of full frame operations.
+ *
+ * Operations supporting it (see #NodeOperation::can_render_gpu) are rendered by compute shaders
+ * and their results are kept in GPU textures, so that chains of GPU operations don't transfer
+ * buffers back and forth. Other operations are rendered on the CPU as usual, downloading the
+ * textures they read.
+ *
+ * All functions must be called from the execution thread, between #begin and #end.
+ */
+struct GPUExecution {
+  /**
+   * Enables the GPU context for the calling thread. Returns false, with the context disabled
+   * again, when compute shaders are not supported.
+   */
+  static bool begin();
+  static void end();
+
+  /**
+   * Texture holding an operation result of given data type. Color and vector data are stored in
+   * four channels, values in one.
+   */
+  static GPUTexture *create_texture(DataType data_type, int width, int height);
+  /**
+   * Uploads given buffer into a texture of given size, at the buffer rect. The rest of the texture
+   * is undefined, like the areas not rendered in a buffer. Single element buffers are uploaded
+   * as 1x1 textures.
+   */
+  static GPUTexture *create_texture_from_buffer(MemoryBuffer &buffer, int width, int height);
+  /**
+   * Downloads given texture into a new buffer of given data type and area.
+   */
+  static MemoryBuffer *create_buffer_from_texture(GPUTexture *texture,
+                                                  DataType data_type,
+                                                  const rcti &rect);
+
+  /**
+   * Compute shader with given name, compiled with `compositor_lib.glsl` on first use and cached
+   * until #free_shaders.
+   */
+  static GPUShader *get_shader(const char *name, const char *source, const char *defines);
+  /**
+   * Binds given texture to the sampler of given name of the bound shader.
+   */
+  static void bind_texture(GPUShader *shader, const char *name, GPUTexture *texture);
+  /**
+   * Renders the whole output texture with the bound shader, one invocation per pixel.
+   */
+  static void dispatch(GPUShader *shader, GPUTexture *output);
+
+  /**
+   * Frees cached shaders, a GPU context must be active.
+   */
+  static void free_shaders();
+};
+
+}  // namespace blender::compositor
@@ -3,6 +3,8 @@
 
 #include <cstdio>
 
+#include "BKE_node.h"
+
 #include "COM_BufferOperation.h"
 #include "COM_ExecutionSystem.h"
 #include "COM_ReadBufferOperation.h"
@@ -20,6 +22,7 @@ NodeOperation::NodeOperation()
   canvas_input_index_ = 0;
   canvas_ = COM_AREA_NONE;
   btree_ = nullptr;
+  node_instance_key_ = NODE_INSTANCE_KEY_NONE;
 }
 
 float NodeOperation::get_constant_value_default(float default_value)
@@ -289,6 +292,13 @@ void NodeOperation::render(MemoryBuffer *output_buf,
   }
 }
 
+void NodeOperation::render_gpu(GPUTexture *output, Span<GPUTexture *> inputs)
+{
+  init_execution();
+  update_gpu_texture(output, inputs);
+  deinit_execution();
+}
+
 void NodeOperation::render_full_frame(MemoryBuffer *output_buf,
                                       Span<rcti> areas,
                                       Span<MemoryBuffer *> inputs_bufs)
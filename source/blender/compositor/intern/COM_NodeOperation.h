@@ -21,6 +21,8 @@
 
 #include "DNA_node_types.h"
 
+struct GPUTexture;
+
 namespace blender::compositor {
 
 class OpenCLDevice;
@@ -237,6 +239,21 @@ struct NodeOperationFlags {
    */
   bool can_be_constant : 1;
 
+  /**
+   * Whether operation only reads its inputs within its areas of interest, addressing them by
+   * coordinates. Input buffers read only by such operations are allocated for the areas to render
+   * instead of the whole canvas. Operations deriving coordinates from the input buffers rect or
+   * size must not set it.
+   */
+  bool can_read_partial_inputs : 1;
+
+  /**
+   * Whether operation result is kept between executions in the #ResultCache. Only meant for
+   * expensive operations implementing #NodeOperation::hash_output_params, as their inputs
+   * content is hashed to look up the result.
+   */
+  bool is_result_cacheable : 1;
+
   NodeOperationFlags()
   {
     complex = false;
@@ -255,6 +272,8 @@ struct NodeOperationFlags {
     is_fullframe_operation = false;
     is_constant_operation = false;
     can_be_constant = false;
+    can_read_partial_inputs = false;
+    is_result_cacheable = false;
   }
 };
 
@@ -274,6 +293,12 @@ struct NodeOperationHash {
     return operation_;
   }
 
+  /** Hash of the operation type and parameters, not depending on its inputs. */
+  size_t get_own_hash() const
+  {
+    return BLI_ghashutil_combine_hash(type_hash_, params_hash_);
+  }
+
   bool operator==(const NodeOperationHash &other) const
   {
     return type_hash_ == other.type_hash_ && parents_hash_ == other.parents_hash_ &&
@@ -304,6 +329,11 @@ class NodeOperation {
  private:
   int id_;
   std::string name_;
+  /**
+   * Instance key of the node this operation was converted from, used to record node execution
+   * statistics. #NODE_INSTANCE_KEY_NONE for operations not belonging to a node.
+   */
+  bNodeInstanceKey node_instance_key_;
   Vector<NodeOperationInput> inputs_;
   Vector<NodeOperationOutput> outputs_;
 
@@ -363,6 +393,16 @@ class NodeOperation {
     return name_;
   }
 
+  void set_node_instance_key(bNodeInstanceKey key)
+  {
+    node_instance_key_ = key;
+  }
+
+  bNodeInstanceKey get_node_instance_key() const
+  {
+    return node_instance_key_;
+  }
+
   void set_id(const int id)
   {
     id_ = id;
@@ -634,6 +674,16 @@ class NodeOperation {
   {
   }
 
+  /**
+   * Pixels of the whole output, with the channels of the output socket, that are valid until
+   * #deinit_execution. When the operation only copies data that exists already, like a render
+   * pass, they are read in place instead of rendering the operation into a new buffer.
+   */
+  virtual float *get_shared_output_data()
+  {
+    return nullptr;
+  }
+
   /**
    * \brief Get input operation area being read by this operation on rendering given output area.
    *
@@ -649,6 +699,29 @@ class NodeOperation {
   virtual void get_area_of_interest(int input_idx, const rcti &output_area, rcti &r_input_area);
   void get_area_of_interest(NodeOperation *input_op, const rcti &output_area, rcti &r_input_area);
 
+  /**
+   * Whether the operation can be rendered on the GPU with its current settings. Only called when
+   * GPU execution is enabled, otherwise or when false the operation is rendered on the CPU.
+   */
+  virtual bool can_render_gpu()
+  {
+    return false;
+  }
+
+  /**
+   * Executes operation on the GPU rendering its whole canvas, see #GPUExecution.
+   * \param output: Texture to write result to, with the size of the operation.
+   * \param inputs: Inputs operations textures, 1x1 for inputs having a single element.
+   */
+  void render_gpu(GPUTexture *output, Span<GPUTexture *> inputs);
+
+  /**
+   * Executes operation updating output texture. A GPU context is active.
+   */
+  virtual void update_gpu_texture(GPUTexture *UNUSED(output), Span<GPUTexture *> UNUSED(inputs))
+  {
+  }
+
   /** \} */
 
  protected:
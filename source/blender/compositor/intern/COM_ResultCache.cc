@@ -0,0 +1,184 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. */
+
+#include "BLI_array.hh"
+#include "BLI_ghash.h"
+#include "BLI_hash.hh"
+#include "BLI_hash_mm2a.h"
+#include "BLI_map.hh"
+#include "BLI_rect.h"
+#include "BLI_task.hh"
+
+#include "COM_MemoryBuffer.h"
+#include "COM_NodeOperation.h"
+#include "COM_ResultCache.h"
+
+namespace blender::compositor {
+
+/** Memory budget of the cached results. */
+static constexpr size_t RESULT_CACHE_MEMORY_LIMIT = size_t(1024) * 1024 * 1024;
+
+/** Number of floats hashed by a single task when hashing input buffers. */
+static constexpr int64_t HASH_CHUNK_LEN = 1 << 18;
+
+struct CachedResult {
+  std::unique_ptr<MemoryBuffer> buffer;
+  size_t mem_size;
+  /** Value of #g_result_cache.clock when last added or found. */
+  uint64_t last_used;
+};
+
+static struct {
+  Map<ResultCacheKey, CachedResult> results;
+  size_t mem_size = 0;
+  uint64_t clock = 0;
+} g_result_cache;
+
+static bool areas_equal(Span<rcti> a, Span<rcti> b)
+{
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (const int64_t i : a.index_range()) {
+    if (!BLI_rcti_compare(&a[i], &b[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+uint64_t ResultCacheKey::hash() const
+{
+  size_t hash = operation_hash;
+  hash = BLI_ghashutil_combine_hash(hash, get_default_hash_2(rect.xmin, rect.ymin));
+  hash = BLI_ghashutil_combine_hash(hash, get_default_hash_2(rect.xmax, rect.ymax));
+  for (const uint64_t input_hash : inputs_hashes) {
+    hash = BLI_ghashutil_combine_hash(hash, input_hash);
+  }
+  return hash;
+}
+
+bool operator==(const ResultCacheKey &a, const ResultCacheKey &b)
+{
+  return a.operation_hash == b.operation_hash && BLI_rcti_compare(&a.rect, &b.rect) &&
+         areas_equal(a.areas, b.areas) &&
+         a.inputs_hashes.as_span() == b.inputs_hashes.as_span();
+}
+
+static int64_t get_buffer_len(const MemoryBuffer &buffer)
+{
+  const int64_t num_elems = buffer.is_a_single_elem() ?
+                                1 :
+                                int64_t(buffer.get_width()) * buffer.get_height();
+  return num_elems * buffer.get_num_channels();
+}
+
+static size_t get_buffer_mem_size(const MemoryBuffer &buffer)
+{
+  return sizeof(float) * get_buffer_len(buffer);
+}
+
+/**
+ * Hashes the buffer content in parallel chunks. It is only done for the inputs of cacheable
+ * operations, which are expected to take much longer to render than this.
+ */
+static uint64_t hash_buffer_content(MemoryBuffer &buffer)
+{
+  const int64_t len = get_buffer_len(buffer);
+  const int64_t num_chunks = (len + HASH_CHUNK_LEN - 1) / HASH_CHUNK_LEN;
+  const uchar *data = reinterpret_cast<const uchar *>(buffer.get_buffer());
+
+  Array<uint32_t> chunks_hashes(num_chunks);
+  threading::parallel_for(IndexRange(num_chunks), 1, [&](const IndexRange range) {
+    for (const int64_t chunk : range) {
+      const int64_t chunk_start = chunk * HASH_CHUNK_LEN;
+      const int64_t chunk_len = std::min(HASH_CHUNK_LEN, len - chunk_start);
+      chunks_hashes[chunk] = BLI_hash_mm2(
+          data + chunk_start * sizeof(float), chunk_len * sizeof(float), uint32_t(chunk));
+    }
+  });
+
+  size_t hash = get_default_hash_3(buffer.get_num_channels(),
+                                   buffer.is_a_single_elem(),
+                                   get_default_hash_2(buffer.get_width(), buffer.get_height()));
+  for (const uint32_t chunk_hash : chunks_hashes) {
+    hash = BLI_ghashutil_combine_hash(hash, chunk_hash);
+  }
+  return hash;
+}
+
+std::optional<ResultCacheKey> ResultCache::generate_key(NodeOperation *op,
+                                                        const MemoryBuffer &output,
+                                                        Span<rcti> areas,
+                                                        Span<MemoryBuffer *> inputs)
+{
+  std::optional<NodeOperationHash> op_hash = op->generate_hash();
+  if (!op_hash) {
+    return std::nullopt;
+  }
+
+  ResultCacheKey key;
+  key.operation_hash = op_hash->get_own_hash();
+  key.rect = output.get_rect();
+  key.areas.extend(areas);
+  for (MemoryBuffer *input : inputs) {
+    key.inputs_hashes.append(hash_buffer_content(*input));
+  }
+  return key;
+}
+
+bool ResultCache::lookup(const ResultCacheKey &key, MemoryBuffer &r_output)
+{
+  CachedResult *result = g_result_cache.results.lookup_ptr(key);
+  if (result == nullptr) {
+    return false;
+  }
+
+  BLI_assert(BLI_rcti_compare(&result->buffer->get_rect(), &r_output.get_rect()));
+  r_output.copy_from(result->buffer.get(), r_output.get_rect());
+  result->last_used = ++g_result_cache.clock;
+  return true;
+}
+
+static void free_least_recently_used(const size_t required_mem_size)
+{
+  while (!g_result_cache.results.is_empty() &&
+         g_result_cache.mem_size + required_mem_size > RESULT_CACHE_MEMORY_LIMIT) {
+    const ResultCacheKey *lru_key = nullptr;
+    const CachedResult *lru_result = nullptr;
+    for (auto item : g_result_cache.results.items()) {
+      if (lru_result == nullptr || item.value.last_used < lru_result->last_used) {
+        lru_key = &item.key;
+        lru_result = &item.value;
+      }
+    }
+    g_result_cache.mem_size -= lru_result->mem_size;
+    const ResultCacheKey key = *lru_key;
+    g_result_cache.results.remove(key);
+  }
+}
+
+void ResultCache::add(ResultCacheKey key, const MemoryBuffer &output)
+{
+  const size_t mem_size = get_buffer_mem_size(output);
+  if (mem_size > RESULT_CACHE_MEMORY_LIMIT || g_result_cache.results.contains(key)) {
+    return;
+  }
+
+  free_least_recently_used(mem_size);
+
+  CachedResult result;
+  result.buffer = std::make_unique<MemoryBuffer>(output);
+  result.mem_size = mem_size;
+  result.last_used = ++g_result_cache.clock;
+  g_result_cache.results.add_new(std::move(key), std::move(result));
+  g_result_cache.mem_size += mem_size;
+}
+
+void ResultCache::free()
+{
+  g_result_cache.results.clear();
+  g_result_cache.mem_size = 0;
+}
+
+}  // namespace blender::compositor
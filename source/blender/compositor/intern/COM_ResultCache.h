@@ -0,0 +1,68 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. */
+
+#pragma once
+
+#include <optional>
+
+#include "BLI_span.hh"
+#include "BLI_vector.hh"
+
+#include "DNA_vec_types.h"
+
+namespace blender::compositor {
+
+class MemoryBuffer;
+class NodeOperation;
+
+/**
+ * Identifies an operation result independently of the execution: the operation type and
+ * parameters, the areas it renders and the content of its input buffers.
+ */
+struct ResultCacheKey {
+  size_t operation_hash;
+  rcti rect;
+  Vector<rcti> areas;
+  Vector<uint64_t> inputs_hashes;
+
+  uint64_t hash() const;
+  friend bool operator==(const ResultCacheKey &a, const ResultCacheKey &b);
+};
+
+/**
+ * \brief Results of expensive operations kept between executions.
+ *
+ * Editing a node re-executes the whole node tree. Operations flagged as
+ * #NodeOperationFlags::is_result_cacheable get their result from the cache when their
+ * parameters and inputs didn't change, instead of rendering it again. Inputs are identified by
+ * a hash of their content, so upstream operations are still rendered but are expected to be
+ * much cheaper than the cached ones.
+ *
+ * The least recently used results are freed when over the memory budget. Must only be used from
+ * the execution thread, compositor executions are serialized.
+ */
+struct ResultCache {
+  /**
+   * Key of given operation result, or `std::nullopt` if the operation parameters can't be
+   * hashed.
+   */
+  static std::optional<ResultCacheKey> generate_key(NodeOperation *op,
+                                                    const MemoryBuffer &output,
+                                                    Span<rcti> areas,
+                                                    Span<MemoryBuffer *> inputs);
+
+  /**
+   * Copies the cached result of given key into \a r_output, returns false if not cached.
+   */
+  static bool lookup(const ResultCacheKey &key, MemoryBuffer &r_output);
+
+  /**
+   * Caches a copy of given operation result, freeing least recently used results when over the
+   * memory budget.
+   */
+  static void add(ResultCacheKey key, const MemoryBuffer &output);
+
+  static void free();
+};
+
+}  // namespace blender::compositor
@@ -0,0 +1,58 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. */
+
+#pragma once
+
+#include "BLI_simd.h"
+
+#ifdef BLI_HAVE_SSE2
+
+namespace blender::compositor {
+
+/* Helpers for row kernels processing one RGBA pixel per SSE register. Only available when
+ * #BLI_HAVE_SSE2 is defined (natively or through NEON emulation), operations must keep their
+ * scalar implementation otherwise. */
+
+/**
+ * Loads a four channels pixel, buffers elements are not aligned to 16 bytes.
+ */
+inline __m128 simd_load_pixel(const float *elem)
+{
+  return _mm_loadu_ps(elem);
+}
+
+inline void simd_store_pixel(float *elem, const __m128 pixel)
+{
+  _mm_storeu_ps(elem, pixel);
+}
+
+/**
+ * Returns \a color with the alpha channel of \a alpha_source.
+ */
+inline __m128 simd_replace_alpha(const __m128 color, const __m128 alpha_source)
+{
+  const __m128 alpha_mask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+  return _mm_or_ps(_mm_and_ps(alpha_mask, alpha_source), _mm_andnot_ps(alpha_mask, color));
+}
+
+/**
+ * Broadcasts the alpha channel of given pixel to all channels.
+ */
+inline __m128 simd_splat_alpha(const __m128 pixel)
+{
+  return _mm_shuffle_ps(pixel, pixel, _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+inline __m128 simd_abs(const __m128 pixel)
+{
+  return _mm_andnot_ps(_mm_set1_ps(-0.0f), pixel);
+}
+
+inline __m128 simd_clamp_01(const __m128 pixel)
+{
+  return _mm_min_ps(_mm_max_ps(pixel, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+}
+
+}  // namespace blender::compositor
+
+#endif
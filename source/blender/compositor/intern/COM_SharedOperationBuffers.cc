@@ -2,12 +2,20 @@
  * Copyright 2021 Blender Foundation. */
 
 #include "COM_SharedOperationBuffers.h"
+#include "COM_GPUExecution.h"
 #include "COM_NodeOperation.h"
 
+#include "GPU_texture.h"
+
 namespace blender::compositor {
 
 SharedOperationBuffers::BufferData::BufferData()
-    : buffer(nullptr), registered_reads(0), received_reads(0), is_rendered(false)
+    : buffer(nullptr),
+      texture(nullptr),
+      registered_reads(0),
+      partial_reads(0),
+      received_reads(0),
+      is_rendered(false)
 {
 }
 
@@ -40,9 +48,19 @@ bool SharedOperationBuffers::has_registered_reads(NodeOperation *op)
   return get_buffer_data(op).registered_reads > 0;
 }
 
-void SharedOperationBuffers::register_read(NodeOperation *read_op)
+void SharedOperationBuffers::register_read(NodeOperation *read_op, const bool is_partial_read)
 {
-  get_buffer_data(read_op).registered_reads++;
+  BufferData &buf_data = get_buffer_data(read_op);
+  buf_data.registered_reads++;
+  if (is_partial_read) {
+    buf_data.partial_reads++;
+  }
+}
+
+bool SharedOperationBuffers::has_partial_reads_only(NodeOperation *op)
+{
+  const BufferData &buf_data = get_buffer_data(op);
+  return buf_data.registered_reads > 0 && buf_data.partial_reads == buf_data.registered_reads;
 }
 
 Vector<rcti> SharedOperationBuffers::get_areas_to_render(NodeOperation *op,
@@ -73,10 +91,49 @@ void SharedOperationBuffers::set_rendered_buffer(NodeOperation *op,
   buf_data.is_rendered = true;
 }
 
+void SharedOperationBuffers::set_rendered_texture(NodeOperation *op, GPUTexture *texture)
+{
+  BufferData &buf_data = get_buffer_data(op);
+  BLI_assert(buf_data.received_reads == 0);
+  BLI_assert(buf_data.buffer == nullptr && buf_data.texture == nullptr);
+  buf_data.texture = texture;
+  buf_data.is_rendered = true;
+}
+
 MemoryBuffer *SharedOperationBuffers::get_rendered_buffer(NodeOperation *op)
 {
   BLI_assert(is_operation_rendered(op));
-  return get_buffer_data(op).buffer.get();
+  BufferData &buf_data = get_buffer_data(op);
+  if (buf_data.buffer == nullptr && buf_data.texture != nullptr) {
+    /* Rendered on the GPU, operation buffers have no offset. */
+    rcti rect;
+    BLI_rcti_init(&rect, 0, op->get_width(), 0, op->get_height());
+    const DataType data_type = op->get_output_socket(0)->get_data_type();
+    buf_data.buffer = std::unique_ptr<MemoryBuffer>(
+        GPUExecution::create_buffer_from_texture(buf_data.texture, data_type, rect));
+  }
+  return buf_data.buffer.get();
+}
+
+GPUTexture *SharedOperationBuffers::get_rendered_texture(NodeOperation *op)
+{
+  BLI_assert(is_operation_rendered(op));
+  BufferData &buf_data = get_buffer_data(op);
+  if (buf_data.texture == nullptr) {
+    buf_data.texture = GPUExecution::create_texture_from_buffer(
+        *buf_data.buffer, op->get_width(), op->get_height());
+  }
+  return buf_data.texture;
+}
+
+void SharedOperationBuffers::free_textures()
+{
+  for (BufferData &buf_data : buffers_.values()) {
+    if (buf_data.texture) {
+      GPU_texture_free(buf_data.texture);
+      buf_data.texture = nullptr;
+    }
+  }
 }
 
 void SharedOperationBuffers::read_finished(NodeOperation *read_op)
@@ -87,6 +144,10 @@ void SharedOperationBuffers::read_finished(NodeOperation *read_op)
   if (buf_data.received_reads == buf_data.registered_reads) {
     /* Dispose buffer. */
     buf_data.buffer = nullptr;
+    if (buf_data.texture) {
+      GPU_texture_free(buf_data.texture);
+      buf_data.texture = nullptr;
+    }
   }
 }
 
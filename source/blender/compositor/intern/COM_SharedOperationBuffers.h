@@ -12,6 +12,8 @@
 #  include "MEM_guardedalloc.h"
 #endif
 
+struct GPUTexture;
+
 namespace blender::compositor {
 
 class MemoryBuffer;
@@ -27,8 +29,12 @@ class SharedOperationBuffers {
    public:
     BufferData();
     std::unique_ptr<MemoryBuffer> buffer;
+    /** Result of operations rendered on the GPU, or upload of the buffer read by them. */
+    GPUTexture *texture;
     blender::Vector<rcti> render_areas;
     int registered_reads;
+    /** Registered reads from operations that can read partial inputs. */
+    int partial_reads;
     int received_reads;
     bool is_rendered;
   } BufferData;
@@ -51,8 +57,15 @@ class SharedOperationBuffers {
   bool has_registered_reads(NodeOperation *op);
   /**
    * Registers an operation read (other operation depends on given operation).
+   * \param is_partial_read: Whether the reader only reads the areas of interest, see
+   * #NodeOperationFlags::can_read_partial_inputs.
+   */
+  void register_read(NodeOperation *read_op, bool is_partial_read);
+  /**
+   * Whether all the registered reads of given operation are partial, so that only its areas to
+   * render need to be allocated.
    */
-  void register_read(NodeOperation *read_op);
+  bool has_partial_reads_only(NodeOperation *op);
 
   /**
    * Get registered areas given operation needs to render.
@@ -67,9 +80,21 @@ class SharedOperationBuffers {
    */
   void set_rendered_buffer(NodeOperation *op, std::unique_ptr<MemoryBuffer> buffer);
   /**
-   * Get given operation rendered buffer.
+   * Stores given operation texture rendered on the GPU.
+   */
+  void set_rendered_texture(NodeOperation *op, GPUTexture *texture);
+  /**
+   * Get given operation rendered buffer, downloading it if it was rendered on the GPU.
    */
   MemoryBuffer *get_rendered_buffer(NodeOperation *op);
+  /**
+   * Get given operation rendered texture, uploading it if it was rendered on the CPU.
+   */
+  GPUTexture *get_rendered_texture(NodeOperation *op);
+  /**
+   * Frees remaining textures before the GPU context is disabled.
+   */
+  void free_textures();
 
   /**
    * Reports an operation has finished reading given operation. If all given operation dependencies
@@ -3,6 +3,7 @@
 
 #include "COM_BokehBlurOperation.h"
 #include "COM_ConstantOperation.h"
+#include "COM_FHTConvolution.h"
 
 #include "COM_OpenCLDevice.h"
 
@@ -13,6 +14,12 @@ constexpr int BOKEH_INPUT_INDEX = 1;
 constexpr int BOUNDING_BOX_INPUT_INDEX = 2;
 constexpr int SIZE_INPUT_INDEX = 3;
 
+/**
+ * Bokeh radius in pixels from which the blur is computed as a convolution in the frequency
+ * domain, the number of samples of the direct sum grows with the square of the radius.
+ */
+constexpr int FHT_MIN_PIXEL_SIZE = 16;
+
 BokehBlurOperation::BokehBlurOperation()
 {
   this->add_input_socket(DataType::Color);
@@ -306,12 +313,93 @@ void BokehBlurOperation::get_area_of_interest(const int input_idx,
   }
 }
 
+int BokehBlurOperation::get_pixel_size() const
+{
+  const float max_dim = MAX2(this->get_width(), this->get_height());
+  return size_ * max_dim / 100.0f;
+}
+
+void BokehBlurOperation::convolve_area(const rcti &area, Span<MemoryBuffer *> inputs)
+{
+  const int pixel_size = get_pixel_size();
+  const float m = bokehDimension_ / pixel_size;
+  MemoryBuffer *image_input = inputs[IMAGE_INPUT_INDEX];
+  const MemoryBuffer *bokeh_input = inputs[BOKEH_INPUT_INDEX];
+
+  /* Kernel centered at `pixel_size`, flipped compared to the direct sum as it's a convolution.
+   * The direct sum window is `[-pixel_size, pixel_size)`, so the first row and column are
+   * zero. */
+  const int kernel_size = 2 * pixel_size + 1;
+  rcti kernel_rect;
+  BLI_rcti_init(&kernel_rect, 0, kernel_size, 0, kernel_size);
+  MemoryBuffer kernel(DataType::Color, kernel_rect);
+  for (BuffersIterator<float> it = kernel.iterate_with({}); !it.is_end(); ++it) {
+    if (it.x == 0 || it.y == 0) {
+      zero_v4(it.out);
+      continue;
+    }
+    const float u = bokeh_mid_x_ + (it.x - pixel_size) * m;
+    const float v = bokeh_mid_y_ + (it.y - pixel_size) * m;
+    bokeh_input->read_elem_checked(u, v, it.out);
+  }
+
+  /* Pixels read by the area. Pixels outside of the image don't contribute, so the kernel
+   * weights are also convolved with a mask of the image to normalize the result. */
+  rcti read_area;
+  BLI_rcti_init(&read_area,
+                area.xmin - pixel_size,
+                area.xmax + pixel_size,
+                area.ymin - pixel_size,
+                area.ymax + pixel_size);
+  MemoryBuffer image(DataType::Color, read_area);
+  MemoryBuffer weights(DataType::Color, read_area);
+  image.clear();
+  weights.clear();
+  rcti image_area;
+  if (BLI_rcti_isect(&read_area, &image_input->get_rect(), &image_area)) {
+    const float ones[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    image.copy_from(image_input, image_area);
+    weights.fill(image_area, ones);
+  }
+
+  MemoryBuffer color_accum(DataType::Color, read_area);
+  MemoryBuffer multiplier_accum(DataType::Color, read_area);
+  convolve_fht(color_accum.get_buffer(), &image, &kernel, COM_DATA_TYPE_COLOR_CHANNELS);
+  convolve_fht(multiplier_accum.get_buffer(), &weights, &kernel, COM_DATA_TYPE_COLOR_CHANNELS);
+
+  convolved_ = std::make_unique<MemoryBuffer>(DataType::Color, area);
+  for (BuffersIterator<float> it = convolved_->iterate_with({}); !it.is_end(); ++it) {
+    const float *color = color_accum.get_elem(it.x, it.y);
+    const float *multiplier = multiplier_accum.get_elem(it.x, it.y);
+    it.out[0] = color[0] * (1.0f / multiplier[0]);
+    it.out[1] = color[1] * (1.0f / multiplier[1]);
+    it.out[2] = color[2] * (1.0f / multiplier[2]);
+    it.out[3] = color[3] * (1.0f / multiplier[3]);
+  }
+}
+
+void BokehBlurOperation::update_memory_buffer_started(MemoryBuffer *UNUSED(output),
+                                                      const rcti &area,
+                                                      Span<MemoryBuffer *> inputs)
+{
+  /* Sparse sampling of lower qualities is not a convolution. */
+  if (get_pixel_size() >= FHT_MIN_PIXEL_SIZE && get_step() == 1 && !BLI_rcti_is_empty(&area)) {
+    convolve_area(area, inputs);
+  }
+}
+
+void BokehBlurOperation::update_memory_buffer_finished(MemoryBuffer *UNUSED(output),
+                                                       const rcti &UNUSED(area),
+                                                       Span<MemoryBuffer *> UNUSED(inputs))
+{
+  convolved_.reset();
+}
+
 void BokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *output,
                                                       const rcti &area,
                                                       Span<MemoryBuffer *> inputs)
 {
-  const float max_dim = MAX2(this->get_width(), this->get_height());
-  const int pixel_size = size_ * max_dim / 100.0f;
+  const int pixel_size = get_pixel_size();
   const float m = bokehDimension_ / pixel_size;
 
   const MemoryBuffer *image_input = inputs[IMAGE_INPUT_INDEX];
@@ -328,6 +416,11 @@ void BokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *output,
       continue;
     }
 
+    if (convolved_) {
+      convolved_->read_elem(x, y, it.out);
+      continue;
+    }
+
     float color_accum[4] = {0};
     float multiplier_accum[4] = {0};
     if (pixel_size < 2) {
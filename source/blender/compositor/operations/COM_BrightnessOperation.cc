@@ -2,6 +2,11 @@
  * Copyright 2011 Blender Foundation. */
 
 #include "COM_BrightnessOperation.h"
+#include "COM_GPUExecution.h"
+
+#include "GPU_shader.h"
+
+extern "C" char datatoc_compositor_brightness_comp_glsl[];
 
 namespace blender::compositor {
 
@@ -14,6 +19,7 @@ BrightnessOperation::BrightnessOperation()
   input_program_ = nullptr;
   use_premultiply_ = false;
   flags_.can_be_constant = true;
+  flags_.can_read_partial_inputs = true;
 }
 
 void BrightnessOperation::set_use_premultiply(bool use_premultiply)
@@ -115,6 +121,19 @@ void BrightnessOperation::update_memory_buffer_partial(MemoryBuffer *output,
   }
 }
 
+void BrightnessOperation::update_gpu_texture(GPUTexture *output, Span<GPUTexture *> inputs)
+{
+  GPUShader *shader = GPUExecution::get_shader(
+      "compositor_brightness", datatoc_compositor_brightness_comp_glsl, nullptr);
+
+  GPU_shader_bind(shader);
+  GPU_shader_uniform_1b(shader, "use_premultiply", use_premultiply_);
+  GPUExecution::bind_texture(shader, "color_tx", inputs[0]);
+  GPUExecution::bind_texture(shader, "brightness_tx", inputs[1]);
+  GPUExecution::bind_texture(shader, "contrast_tx", inputs[2]);
+  GPUExecution::dispatch(shader, output);
+}
+
 void BrightnessOperation::deinit_execution()
 {
   input_program_ = nullptr;
@@ -41,6 +41,12 @@ class BrightnessOperation : public MultiThreadedOperation {
   void update_memory_buffer_partial(MemoryBuffer *output,
                                     const rcti &area,
                                     Span<MemoryBuffer *> inputs) override;
+
+  bool can_render_gpu() override
+  {
+    return true;
+  }
+  void update_gpu_texture(GPUTexture *output, Span<GPUTexture *> inputs) override;
 };
 
 }  // namespace blender::compositor
@@ -2,6 +2,11 @@
  * Copyright 2011 Blender Foundation. */
 
 #include "COM_ColorBalanceLGGOperation.h"
+#include "COM_GPUExecution.h"
+
+#include "GPU_shader.h"
+
+extern "C" char datatoc_compositor_color_balance_comp_glsl[];
 
 namespace blender::compositor {
 
@@ -80,6 +85,21 @@ void ColorBalanceLGGOperation::update_memory_buffer_row(PixelCursor &p)
   }
 }
 
+void ColorBalanceLGGOperation::update_gpu_texture(GPUTexture *output,
+                                                  Span<GPUTexture *> inputs)
+{
+  GPUShader *shader = GPUExecution::get_shader(
+      "compositor_color_balance", datatoc_compositor_color_balance_comp_glsl, nullptr);
+
+  GPU_shader_bind(shader);
+  GPU_shader_uniform_3fv(shader, "lift", lift_);
+  GPU_shader_uniform_3fv(shader, "gamma_inv", gamma_inv_);
+  GPU_shader_uniform_3fv(shader, "gain", gain_);
+  GPUExecution::bind_texture(shader, "factor_tx", inputs[0]);
+  GPUExecution::bind_texture(shader, "color_tx", inputs[1]);
+  GPUExecution::dispatch(shader, output);
+}
+
 void ColorBalanceLGGOperation::deinit_execution()
 {
   input_value_operation_ = nullptr;
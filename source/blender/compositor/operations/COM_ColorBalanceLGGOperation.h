@@ -58,6 +58,12 @@ class ColorBalanceLGGOperation : public MultiThreadedRowOperation {
   }
 
   void update_memory_buffer_row(PixelCursor &p) override;
+
+  bool can_render_gpu() override
+  {
+    return true;
+  }
+  void update_gpu_texture(GPUTexture *output, Span<GPUTexture *> inputs) override;
 };
 
 }  // namespace blender::compositor
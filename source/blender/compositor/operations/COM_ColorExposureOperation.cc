@@ -2,6 +2,7 @@
  * Copyright 2020 Blender Foundation. */
 
 #include "COM_ColorExposureOperation.h"
+#include "COM_SIMD.h"
 
 namespace blender::compositor {
 
@@ -44,10 +45,15 @@ void ExposureOperation::update_memory_buffer_row(PixelCursor &p)
     const float *in_value = p.ins[0];
     const float *in_exposure = p.ins[1];
     const float exposure = pow(2, in_exposure[0]);
+#ifdef BLI_HAVE_SSE2
+    const __m128 color = simd_load_pixel(in_value);
+    simd_store_pixel(p.out, simd_replace_alpha(_mm_mul_ps(color, _mm_set1_ps(exposure)), color));
+#else
     p.out[0] = in_value[0] * exposure;
     p.out[1] = in_value[1] * exposure;
     p.out[2] = in_value[2] * exposure;
     p.out[3] = in_value[3];
+#endif
   }
 }
 
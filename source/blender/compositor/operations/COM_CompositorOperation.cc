@@ -31,6 +31,7 @@ CompositorOperation::CompositorOperation()
   view_name_ = nullptr;
 
   flags_.use_render_border = true;
+  flags_.can_read_partial_inputs = true;
 }
 
 void CompositorOperation::init_execution()
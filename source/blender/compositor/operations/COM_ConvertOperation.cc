@@ -7,12 +7,15 @@
 
 #include "IMB_colormanagement.h"
 
+#include "COM_SIMD.h"
+
 namespace blender::compositor {
 
 ConvertBaseOperation::ConvertBaseOperation()
 {
   input_operation_ = nullptr;
   flags_.can_be_constant = true;
+  flags_.can_read_partial_inputs = true;
 }
 
 void ConvertBaseOperation::init_execution()
@@ -486,7 +489,19 @@ void ConvertPremulToStraightOperation::execute_pixel_sampled(float output[4],
 void ConvertPremulToStraightOperation::update_memory_buffer_partial(BuffersIterator<float> &it)
 {
   for (; !it.is_end(); ++it) {
+#ifdef BLI_HAVE_SSE2
+    const __m128 premul = simd_load_pixel(it.in(0));
+    const float alpha = it.in(0)[3];
+    if (ELEM(alpha, 0.0f, 1.0f)) {
+      simd_store_pixel(it.out, premul);
+    }
+    else {
+      const __m128 straight = _mm_mul_ps(premul, _mm_set1_ps(1.0f / alpha));
+      simd_store_pixel(it.out, simd_replace_alpha(straight, premul));
+    }
+#else
     copy_v4_v4(it.out, ColorSceneLinear4f<eAlpha::Premultiplied>(it.in(0)).unpremultiply_alpha());
+#endif
   }
 }
 
@@ -512,7 +527,13 @@ void ConvertStraightToPremulOperation::execute_pixel_sampled(float output[4],
 void ConvertStraightToPremulOperation::update_memory_buffer_partial(BuffersIterator<float> &it)
 {
   for (; !it.is_end(); ++it) {
+#ifdef BLI_HAVE_SSE2
+    const __m128 straight = simd_load_pixel(it.in(0));
+    const __m128 premul = _mm_mul_ps(straight, simd_splat_alpha(straight));
+    simd_store_pixel(it.out, simd_replace_alpha(premul, straight));
+#else
     copy_v4_v4(it.out, ColorSceneLinear4f<eAlpha::Straight>(it.in(0)).premultiply_alpha());
+#endif
   }
 }
 
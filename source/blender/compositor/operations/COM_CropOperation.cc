@@ -11,6 +11,7 @@ CropBaseOperation::CropBaseOperation()
   this->add_output_socket(DataType::Color);
   input_operation_ = nullptr;
   settings_ = nullptr;
+  flags_.can_read_partial_inputs = true;
 }
 
 void CropBaseOperation::update_area()
@@ -11,6 +11,7 @@ CurveBaseOperation::CurveBaseOperation()
 {
   curve_mapping_ = nullptr;
   flags_.can_be_constant = true;
+  flags_.can_read_partial_inputs = true;
 }
 
 CurveBaseOperation::~CurveBaseOperation()
@@ -0,0 +1,20 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2011 Blender Foundation. */
+
+#pragma once
+
+namespace blender::compositor {
+
+class MemoryBuffer;
+
+/**
+ * Convolves the first \a num_channels channels of \a image with the same channels of
+ * \a kernel, using a 2D Fast Hartley Transform with block overlap-add. Channels are convolved
+ * in parallel.
+ *
+ * The kernel origin is at its center (half its size rounded down) and pixels outside the image
+ * are zero. \a dst is a color buffer of the image size, channels not convolved are zero.
+ */
+void convolve_fht(float *dst, MemoryBuffer *image, MemoryBuffer *kernel, int num_channels);
+
+}  // namespace blender::compositor
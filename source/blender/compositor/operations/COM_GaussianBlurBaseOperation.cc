@@ -2,6 +2,13 @@
  * Copyright 2021 Blender Foundation. */
 
 #include "COM_GaussianBlurBaseOperation.h"
+#include "COM_GPUExecution.h"
+
+#include "GPU_capabilities.h"
+#include "GPU_shader.h"
+#include "GPU_texture.h"
+
+extern "C" char datatoc_compositor_gaussian_blur_comp_glsl[];
 
 namespace blender::compositor {
 
@@ -136,4 +143,34 @@ void GaussianBlurBaseOperation::update_memory_buffer_partial(MemoryBuffer *outpu
   }
 }
 
+bool GaussianBlurBaseOperation::can_render_gpu()
+{
+  /* The weights are uploaded as a 1D texture. */
+  return filtersize_ * 2 + 1 <= GPU_max_texture_size();
+}
+
+void GaussianBlurBaseOperation::update_gpu_texture(GPUTexture *output,
+                                                   Span<GPUTexture *> inputs)
+{
+  GPUShader *shader = dimension_ == eDimension::X ?
+                          GPUExecution::get_shader("compositor_gaussian_blur_x",
+                                                   datatoc_compositor_gaussian_blur_comp_glsl,
+                                                   "#define DIRECTION ivec2(1, 0)\n") :
+                          GPUExecution::get_shader("compositor_gaussian_blur_y",
+                                                   datatoc_compositor_gaussian_blur_comp_glsl,
+                                                   "#define DIRECTION ivec2(0, 1)\n");
+  GPUTexture *gausstab_tx = GPU_texture_create_1d(
+      "compositor_gausstab", filtersize_ * 2 + 1, 1, GPU_R32F, gausstab_);
+
+  GPU_shader_bind(shader);
+  GPU_shader_uniform_1i(shader, "filter_size", filtersize_);
+  GPU_shader_uniform_1i(shader, "quality_step", QualityStepHelper::get_step());
+  GPUExecution::bind_texture(shader, "input_tx", inputs[IMAGE_INPUT_INDEX]);
+  GPUExecution::bind_texture(shader, "gausstab_tx", gausstab_tx);
+  GPUExecution::dispatch(shader, output);
+
+  GPU_texture_unbind(gausstab_tx);
+  GPU_texture_free(gausstab_tx);
+}
+
 }  // namespace blender::compositor
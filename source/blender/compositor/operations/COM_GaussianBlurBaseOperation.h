@@ -28,6 +28,9 @@ class GaussianBlurBaseOperation : public BlurBaseOperation {
   virtual void update_memory_buffer_partial(MemoryBuffer *output,
                                             const rcti &area,
                                             Span<MemoryBuffer *> inputs) override;
+
+  bool can_render_gpu() override;
+  void update_gpu_texture(GPUTexture *output, Span<GPUTexture *> inputs) override;
 };
 
 }  // namespace blender::compositor
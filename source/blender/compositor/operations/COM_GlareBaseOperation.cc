@@ -11,8 +11,19 @@ GlareBaseOperation::GlareBaseOperation()
   this->add_output_socket(DataType::Color);
   settings_ = nullptr;
   flags_.is_fullframe_operation = true;
+  flags_.is_result_cacheable = true;
   is_output_rendered_ = false;
 }
+
+void GlareBaseOperation::hash_output_params()
+{
+  if (settings_) {
+    hash_params((int)settings_->quality, (int)settings_->iter, (int)settings_->size);
+    hash_params((int)settings_->star_45, (int)settings_->streaks, settings_->colmod);
+    hash_params(settings_->mix, settings_->threshold, settings_->fade);
+    hash_param(settings_->angle_ofs);
+  }
+}
 void GlareBaseOperation::init_execution()
 {
   SingleThreadedOperation::init_execution();
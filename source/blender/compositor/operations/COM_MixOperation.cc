@@ -2,9 +2,48 @@
  * Copyright 2011 Blender Foundation. */
 
 #include "COM_MixOperation.h"
+#include "COM_GPUExecution.h"
+#include "COM_SIMD.h"
+
+#include "BLI_string.h"
+
+#include "GPU_shader.h"
+
+extern "C" char datatoc_compositor_mix_comp_glsl[];
 
 namespace blender::compositor {
 
+#ifdef BLI_HAVE_SSE2
+/**
+ * Mixes a row one pixel per SSE register. \a mix_fn returns the mixed color of given mix factor,
+ * broadcast to all channels, and input colors. Alpha is always the one of the first color.
+ */
+template<typename TCursor, typename TMixFn>
+static void mix_row_simd(TCursor &p,
+                         const bool value_alpha_multiply,
+                         const bool use_clamp,
+                         const TMixFn &mix_fn)
+{
+  while (p.out < p.row_end) {
+    float value = p.value[0];
+    if (value_alpha_multiply) {
+      value *= p.color2[3];
+    }
+    const __m128 color1 = simd_load_pixel(p.color1);
+    const __m128 mixed = mix_fn(_mm_set1_ps(value), color1, simd_load_pixel(p.color2));
+    const __m128 result = simd_replace_alpha(mixed, color1);
+    simd_store_pixel(p.out, use_clamp ? simd_clamp_01(result) : result);
+    p.next();
+  }
+}
+
+static __m128 simd_mix_blend(const __m128 value, const __m128 color1, const __m128 color2)
+{
+  const __m128 value_m = _mm_sub_ps(_mm_set1_ps(1.0f), value);
+  return _mm_add_ps(_mm_mul_ps(value_m, color1), _mm_mul_ps(value, color2));
+}
+#endif
+
 /* ******** Mix Base Operation ******** */
 
 MixBaseOperation::MixBaseOperation()
@@ -19,6 +58,7 @@ MixBaseOperation::MixBaseOperation()
   this->set_use_value_alpha_multiply(false);
   this->set_use_clamp(false);
   flags_.can_be_constant = true;
+  flags_.can_read_partial_inputs = true;
 }
 
 void MixBaseOperation::init_execution()
@@ -107,6 +147,9 @@ void MixBaseOperation::update_memory_buffer_partial(MemoryBuffer *output,
 
 void MixBaseOperation::update_memory_buffer_row(PixelCursor &p)
 {
+#ifdef BLI_HAVE_SSE2
+  mix_row_simd(p, value_alpha_multiply_, false, simd_mix_blend);
+#else
   while (p.out < p.row_end) {
     float value = p.value[0];
     if (this->use_value_alpha_multiply()) {
@@ -119,6 +162,24 @@ void MixBaseOperation::update_memory_buffer_row(PixelCursor &p)
     p.out[3] = p.color1[3];
     p.next();
   }
+#endif
+}
+
+void MixBaseOperation::update_gpu_texture(GPUTexture *output, Span<GPUTexture *> inputs)
+{
+  const char *mix_function = get_gpu_mix_function();
+  char name[64], defines[64];
+  BLI_snprintf(name, sizeof(name), "compositor_%s", mix_function);
+  BLI_snprintf(defines, sizeof(defines), "#define MIX_FUNCTION %s\n", mix_function);
+  GPUShader *shader = GPUExecution::get_shader(name, datatoc_compositor_mix_comp_glsl, defines);
+
+  GPU_shader_bind(shader);
+  GPU_shader_uniform_1b(shader, "use_value_alpha_multiply", value_alpha_multiply_);
+  GPU_shader_uniform_1b(shader, "use_clamp", use_clamp_);
+  GPUExecution::bind_texture(shader, "value_tx", inputs[0]);
+  GPUExecution::bind_texture(shader, "color1_tx", inputs[1]);
+  GPUExecution::bind_texture(shader, "color2_tx", inputs[2]);
+  GPUExecution::dispatch(shader, output);
 }
 
 /* ******** Mix Add Operation ******** */
@@ -150,6 +211,15 @@ void MixAddOperation::execute_pixel_sampled(float output[4],
 
 void MixAddOperation::update_memory_buffer_row(PixelCursor &p)
 {
+#ifdef BLI_HAVE_SSE2
+  mix_row_simd(
+      p,
+      value_alpha_multiply_,
+      use_clamp_,
+      [](const __m128 value, const __m128 color1, const __m128 color2) {
+        return _mm_add_ps(color1, _mm_mul_ps(value, color2));
+      });
+#else
   while (p.out < p.row_end) {
     float value = p.value[0];
     if (this->use_value_alpha_multiply()) {
@@ -163,6 +233,7 @@ void MixAddOperation::update_memory_buffer_row(PixelCursor &p)
     clamp_if_needed(p.out);
     p.next();
   }
+#endif
 }
 
 /* ******** Mix Blend Operation ******** */
@@ -196,6 +267,9 @@ void MixBlendOperation::execute_pixel_sampled(float output[4],
 
 void MixBlendOperation::update_memory_buffer_row(PixelCursor &p)
 {
+#ifdef BLI_HAVE_SSE2
+  mix_row_simd(p, value_alpha_multiply_, use_clamp_, simd_mix_blend);
+#else
   while (p.out < p.row_end) {
     float value = p.value[0];
     if (this->use_value_alpha_multiply()) {
@@ -210,6 +284,7 @@ void MixBlendOperation::update_memory_buffer_row(PixelCursor &p)
     clamp_if_needed(p.out);
     p.next();
   }
+#endif
 }
 
 /* ******** Mix Burn Operation ******** */
@@ -432,6 +507,17 @@ void MixDarkenOperation::execute_pixel_sampled(float output[4],
 
 void MixDarkenOperation::update_memory_buffer_row(PixelCursor &p)
 {
+#ifdef BLI_HAVE_SSE2
+  mix_row_simd(
+      p,
+      value_alpha_multiply_,
+      use_clamp_,
+      [](const __m128 value, const __m128 color1, const __m128 color2) {
+        const __m128 value_m = _mm_sub_ps(_mm_set1_ps(1.0f), value);
+        return _mm_add_ps(_mm_mul_ps(_mm_min_ps(color1, color2), value),
+                          _mm_mul_ps(color1, value_m));
+      });
+#else
   while (p.out < p.row_end) {
     float value = p.value[0];
     if (this->use_value_alpha_multiply()) {
@@ -446,6 +532,7 @@ void MixDarkenOperation::update_memory_buffer_row(PixelCursor &p)
     clamp_if_needed(p.out);
     p.next();
   }
+#endif
 }
 
 /* ******** Mix Difference Operation ******** */
@@ -478,6 +565,17 @@ void MixDifferenceOperation::execute_pixel_sampled(float output[4],
 
 void MixDifferenceOperation::update_memory_buffer_row(PixelCursor &p)
 {
+#ifdef BLI_HAVE_SSE2
+  mix_row_simd(
+      p,
+      value_alpha_multiply_,
+      use_clamp_,
+      [](const __m128 value, const __m128 color1, const __m128 color2) {
+        const __m128 value_m = _mm_sub_ps(_mm_set1_ps(1.0f), value);
+        return _mm_add_ps(_mm_mul_ps(value_m, color1),
+                          _mm_mul_ps(value, simd_abs(_mm_sub_ps(color1, color2))));
+      });
+#else
   while (p.out < p.row_end) {
     float value = p.value[0];
     if (this->use_value_alpha_multiply()) {
@@ -492,6 +590,7 @@ void MixDifferenceOperation::update_memory_buffer_row(PixelCursor &p)
     clamp_if_needed(p.out);
     p.next();
   }
+#endif
 }
 
 /* ******** Mix Difference Operation ******** */
@@ -895,6 +994,15 @@ void MixLightenOperation::execute_pixel_sampled(float output[4],
 
 void MixLightenOperation::update_memory_buffer_row(PixelCursor &p)
 {
+#ifdef BLI_HAVE_SSE2
+  mix_row_simd(
+      p,
+      value_alpha_multiply_,
+      use_clamp_,
+      [](const __m128 value, const __m128 color1, const __m128 color2) {
+        return _mm_max_ps(_mm_mul_ps(value, color2), color1);
+      });
+#else
   while (p.out < p.row_end) {
     float value = p.value[0];
     if (this->use_value_alpha_multiply()) {
@@ -915,6 +1023,7 @@ void MixLightenOperation::update_memory_buffer_row(PixelCursor &p)
     clamp_if_needed(p.out);
     p.next();
   }
+#endif
 }
 
 /* ******** Mix Linear Light Operation ******** */
@@ -1023,6 +1132,16 @@ void MixMultiplyOperation::execute_pixel_sampled(float output[4],
 
 void MixMultiplyOperation::update_memory_buffer_row(PixelCursor &p)
 {
+#ifdef BLI_HAVE_SSE2
+  mix_row_simd(
+      p,
+      value_alpha_multiply_,
+      use_clamp_,
+      [](const __m128 value, const __m128 color1, const __m128 color2) {
+        const __m128 value_m = _mm_sub_ps(_mm_set1_ps(1.0f), value);
+        return _mm_mul_ps(color1, _mm_add_ps(value_m, _mm_mul_ps(value, color2)));
+      });
+#else
   while (p.out < p.row_end) {
     float value = p.value[0];
     if (this->use_value_alpha_multiply()) {
@@ -1038,6 +1157,7 @@ void MixMultiplyOperation::update_memory_buffer_row(PixelCursor &p)
     clamp_if_needed(p.out);
     p.next();
   }
+#endif
 }
 
 /* ******** Mix Overlay Operation ******** */
@@ -1217,6 +1337,18 @@ void MixScreenOperation::execute_pixel_sampled(float output[4],
 
 void MixScreenOperation::update_memory_buffer_row(PixelCursor &p)
 {
+#ifdef BLI_HAVE_SSE2
+  mix_row_simd(
+      p,
+      value_alpha_multiply_,
+      use_clamp_,
+      [](const __m128 value, const __m128 color1, const __m128 color2) {
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 value_m = _mm_sub_ps(one, value);
+        const __m128 factor = _mm_add_ps(value_m, _mm_mul_ps(value, _mm_sub_ps(one, color2)));
+        return _mm_sub_ps(one, _mm_mul_ps(factor, _mm_sub_ps(one, color1)));
+      });
+#else
   while (p.out < p.row_end) {
     float value = p.value[0];
     if (this->use_value_alpha_multiply()) {
@@ -1232,6 +1364,7 @@ void MixScreenOperation::update_memory_buffer_row(PixelCursor &p)
     clamp_if_needed(p.out);
     p.next();
   }
+#endif
 }
 
 /* ******** Mix Soft Light Operation ******** */
@@ -1332,6 +1465,15 @@ void MixSubtractOperation::execute_pixel_sampled(float output[4],
 
 void MixSubtractOperation::update_memory_buffer_row(PixelCursor &p)
 {
+#ifdef BLI_HAVE_SSE2
+  mix_row_simd(
+      p,
+      value_alpha_multiply_,
+      use_clamp_,
+      [](const __m128 value, const __m128 color1, const __m128 color2) {
+        return _mm_sub_ps(color1, _mm_mul_ps(value, color2));
+      });
+#else
   while (p.out < p.row_end) {
     float value = p.value[0];
     if (this->use_value_alpha_multiply()) {
@@ -1345,6 +1487,7 @@ void MixSubtractOperation::update_memory_buffer_row(PixelCursor &p)
     clamp_if_needed(p.out);
     p.next();
   }
+#endif
 }
 
 /* ******** Mix Value Operation ******** */
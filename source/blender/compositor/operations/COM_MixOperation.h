@@ -91,8 +91,23 @@ class MixBaseOperation : public MultiThreadedOperation {
                                     const rcti &area,
                                     Span<MemoryBuffer *> inputs) final;
 
+  bool can_render_gpu() override
+  {
+    return get_gpu_mix_function() != nullptr;
+  }
+  void update_gpu_texture(GPUTexture *output, Span<GPUTexture *> inputs) final;
+
  protected:
   virtual void update_memory_buffer_row(PixelCursor &p);
+
+  /**
+   * Function of `compositor_mix_comp.glsl` matching #update_memory_buffer_row, nullptr when the
+   * mix is only implemented on the CPU.
+   */
+  virtual const char *get_gpu_mix_function() const
+  {
+    return nullptr;
+  }
 };
 
 class MixAddOperation : public MixBaseOperation {
@@ -101,6 +116,10 @@ class MixAddOperation : public MixBaseOperation {
 
  protected:
   void update_memory_buffer_row(PixelCursor &p) override;
+  const char *get_gpu_mix_function() const override
+  {
+    return "mix_add";
+  }
 };
 
 class MixBlendOperation : public MixBaseOperation {
@@ -109,6 +128,10 @@ class MixBlendOperation : public MixBaseOperation {
 
  protected:
   void update_memory_buffer_row(PixelCursor &p) override;
+  const char *get_gpu_mix_function() const override
+  {
+    return "mix_blend";
+  }
 };
 
 class MixColorBurnOperation : public MixBaseOperation {
@@ -133,6 +156,10 @@ class MixDarkenOperation : public MixBaseOperation {
 
  protected:
   void update_memory_buffer_row(PixelCursor &p) override;
+  const char *get_gpu_mix_function() const override
+  {
+    return "mix_darken";
+  }
 };
 
 class MixDifferenceOperation : public MixBaseOperation {
@@ -141,6 +168,10 @@ class MixDifferenceOperation : public MixBaseOperation {
 
  protected:
   void update_memory_buffer_row(PixelCursor &p) override;
+  const char *get_gpu_mix_function() const override
+  {
+    return "mix_difference";
+  }
 };
 
 class MixDivideOperation : public MixBaseOperation {
@@ -149,6 +180,10 @@ class MixDivideOperation : public MixBaseOperation {
 
  protected:
   void update_memory_buffer_row(PixelCursor &p) override;
+  const char *get_gpu_mix_function() const override
+  {
+    return "mix_divide";
+  }
 };
 
 class MixDodgeOperation : public MixBaseOperation {
@@ -181,6 +216,10 @@ class MixLightenOperation : public MixBaseOperation {
 
  protected:
   void update_memory_buffer_row(PixelCursor &p) override;
+  const char *get_gpu_mix_function() const override
+  {
+    return "mix_lighten";
+  }
 };
 
 class MixLinearLightOperation : public MixBaseOperation {
@@ -197,6 +236,10 @@ class MixMultiplyOperation : public MixBaseOperation {
 
  protected:
   void update_memory_buffer_row(PixelCursor &p) override;
+  const char *get_gpu_mix_function() const override
+  {
+    return "mix_multiply";
+  }
 };
 
 class MixOverlayOperation : public MixBaseOperation {
@@ -221,6 +264,10 @@ class MixScreenOperation : public MixBaseOperation {
 
  protected:
   void update_memory_buffer_row(PixelCursor &p) override;
+  const char *get_gpu_mix_function() const override
+  {
+    return "mix_screen";
+  }
 };
 
 class MixSoftLightOperation : public MixBaseOperation {
@@ -237,6 +284,10 @@ class MixSubtractOperation : public MixBaseOperation {
 
  protected:
   void update_memory_buffer_row(PixelCursor &p) override;
+  const char *get_gpu_mix_function() const override
+  {
+    return "mix_subtract";
+  }
 };
 
 class MixValueOperation : public MixBaseOperation {
@@ -233,6 +233,16 @@ std::unique_ptr<MetaData> RenderLayersProg::get_meta_data()
   return std::move(callback_data.meta_data);
 }
 
+float *RenderLayersProg::get_shared_output_data()
+{
+  /* Passes are read in place when the output has all of their channels. */
+  if (input_buffer_ == nullptr ||
+      COM_data_type_num_channels(get_output_socket()->get_data_type()) != elementsize_) {
+    return nullptr;
+  }
+  return input_buffer_;
+}
+
 void RenderLayersProg::update_memory_buffer_partial(MemoryBuffer *output,
                                                     const rcti &area,
                                                     Span<MemoryBuffer *> UNUSED(inputs))
@@ -114,6 +114,8 @@ class RenderLayersProg : public MultiThreadedOperation {
 
   std::unique_ptr<MetaData> get_meta_data() override;
 
+  float *get_shared_output_data() override;
+
   virtual void update_memory_buffer_partial(MemoryBuffer *output,
                                             const rcti &area,
                                             Span<MemoryBuffer *> inputs) override;
@@ -127,6 +129,12 @@ class RenderLayersAOOperation : public RenderLayersProg {
   }
   void execute_pixel_sampled(float output[4], float x, float y, PixelSampler sampler) override;
 
+  float *get_shared_output_data() override
+  {
+    /* Alpha is set to one. */
+    return nullptr;
+  }
+
   void update_memory_buffer_partial(MemoryBuffer *output,
                                     const rcti &area,
                                     Span<MemoryBuffer *> inputs) override;
@@ -14,6 +14,7 @@ SetAlphaMultiplyOperation::SetAlphaMultiplyOperation()
   input_color_ = nullptr;
   input_alpha_ = nullptr;
   flags_.can_be_constant = true;
+  flags_.can_read_partial_inputs = true;
 }
 
 void SetAlphaMultiplyOperation::init_execution()
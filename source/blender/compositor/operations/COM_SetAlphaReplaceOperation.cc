@@ -14,6 +14,7 @@ SetAlphaReplaceOperation::SetAlphaReplaceOperation()
   input_color_ = nullptr;
   input_alpha_ = nullptr;
   flags_.can_be_constant = true;
+  flags_.can_read_partial_inputs = true;
 }
 
 void SetAlphaReplaceOperation::init_execution()
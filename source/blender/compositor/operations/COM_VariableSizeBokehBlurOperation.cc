@@ -18,6 +18,7 @@ VariableSizeBokehBlurOperation::VariableSizeBokehBlurOperation()
   this->add_output_socket(DataType::Color);
   flags_.complex = true;
   flags_.open_cl = true;
+  flags_.is_result_cacheable = true;
 
   input_program_ = nullptr;
   input_bokeh_program_ = nullptr;
@@ -216,6 +217,12 @@ void VariableSizeBokehBlurOperation::deinit_execution()
 #endif
 }
 
+void VariableSizeBokehBlurOperation::hash_output_params()
+{
+  hash_params(max_blur_, threshold_, do_size_scale_);
+  hash_param(get_quality());
+}
+
 bool VariableSizeBokehBlurOperation::determine_depending_area_of_interest(
     rcti *input, ReadBufferOperation *read_operation, rcti *output)
 {
@@ -310,6 +317,19 @@ struct PixelData {
   int image_height;
 };
 
+/**
+ * Start of the gather window reduced to \a radius, keeping the samples positions of the window
+ * starting at \a start when sampling every \a step pixels.
+ */
+static int get_reduced_window_start(const int start,
+                                    const int center,
+                                    const int radius,
+                                    const int step)
+{
+  const int reduced_start = MAX2(center - radius, start);
+  return start + ((reduced_start - start) / step) * step;
+}
+
 static void blur_pixel(int x, int y, PixelData &p)
 {
   BLI_assert(p.bokeh_input->get_width() == COM_BLUR_BOKEH_PIXELS);
@@ -325,10 +345,14 @@ static void blur_pixel(int x, int y, PixelData &p)
   const int maxx = search[2];
   const int maxy = search[3];
 #else
-  const int minx = MAX2(x - p.max_blur_scalar, 0);
-  const int miny = MAX2(y - p.max_blur_scalar, 0);
-  const int maxx = MIN2(x + p.max_blur_scalar, p.image_width);
-  const int maxy = MIN2(y + p.max_blur_scalar, p.image_height);
+  /* Neighbors only contribute within the center pixel size, as their size is limited to it.
+   * Skip the samples outside of it, most pixels have a much smaller size than the maximum. */
+  const int radius = p.size_center < p.max_blur_scalar ? (int)ceilf(p.size_center) :
+                                                        p.max_blur_scalar;
+  const int minx = get_reduced_window_start(MAX2(x - p.max_blur_scalar, 0), x, radius, p.step);
+  const int miny = get_reduced_window_start(MAX2(y - p.max_blur_scalar, 0), y, radius, p.step);
+  const int maxx = MIN3(x + radius + 1, x + p.max_blur_scalar, p.image_width);
+  const int maxy = MIN3(y + radius + 1, y + p.max_blur_scalar, p.image_height);
 #endif
 
   const int color_row_stride = p.image_input->row_stride * p.step;
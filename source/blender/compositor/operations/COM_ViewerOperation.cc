@@ -37,6 +37,7 @@ ViewerOperation::ViewerOperation()
   view_name_ = nullptr;
   flags_.use_viewer_border = true;
   flags_.is_viewer_operation = true;
+  flags_.can_read_partial_inputs = true;
 }
 
 void ViewerOperation::init_execution()
@@ -0,0 +1,41 @@
+/* Must match #BrightnessOperation. */
+
+uniform sampler2D color_tx;
+uniform sampler2D brightness_tx;
+uniform sampler2D contrast_tx;
+
+uniform bool use_premultiply;
+
+void main()
+{
+  ivec2 texel;
+  if (!output_texel_get(texel)) {
+    return;
+  }
+
+  vec4 color = load_input(color_tx, texel);
+  float brightness = load_input(brightness_tx, texel).x / 100.0;
+  float contrast = load_input(contrast_tx, texel).x;
+  float delta = contrast / 200.0;
+
+  /* The algorithm is by Werner D. Streidt, see #BrightnessOperation. */
+  float a, b;
+  if (contrast > 0.0) {
+    a = 1.0 / max(1.0 - delta * 2.0, FLT_EPSILON);
+    b = a * (brightness - delta);
+  }
+  else {
+    delta *= -1.0;
+    a = max(1.0 - delta * 2.0, 0.0);
+    b = a * brightness + delta;
+  }
+
+  if (use_premultiply && color.a != 0.0 && color.a != 1.0) {
+    color.rgb /= color.a;
+  }
+  vec4 result = vec4(a * color.rgb + b, color.a);
+  if (use_premultiply) {
+    result.rgb *= result.a;
+  }
+  imageStore(output_img, texel, result);
+}
@@ -0,0 +1,32 @@
+/* Lift, gamma and gain color balance, must match #ColorBalanceLGGOperation. */
+
+uniform sampler2D factor_tx;
+uniform sampler2D color_tx;
+
+uniform vec3 lift;
+uniform vec3 gamma_inv;
+uniform vec3 gain;
+
+float colorbalance_lgg(float value, float lift, float gamma_inv, float gain)
+{
+  float x = (((linearrgb_to_srgb(value) - 1.0) * lift) + 1.0) * gain;
+  /* Prevent NaN. */
+  x = max(x, 0.0);
+  return pow(srgb_to_linearrgb(x), gamma_inv);
+}
+
+void main()
+{
+  ivec2 texel;
+  if (!output_texel_get(texel)) {
+    return;
+  }
+
+  float fac = min(1.0, load_input(factor_tx, texel).x);
+  vec4 color = load_input(color_tx, texel);
+
+  vec3 balanced = vec3(colorbalance_lgg(color.r, lift.r, gamma_inv.r, gain.r),
+                       colorbalance_lgg(color.g, lift.g, gamma_inv.g, gain.g),
+                       colorbalance_lgg(color.b, lift.b, gamma_inv.b, gain.b));
+  imageStore(output_img, texel, vec4(mix(color.rgb, balanced, fac), color.a));
+}
@@ -0,0 +1,34 @@
+/* One dimension of a separable gaussian blur, must match #GaussianBlurBaseOperation. */
+
+uniform sampler2D input_tx;
+/* Weights of the `filter_size * 2 + 1` pixels centered on the blurred pixel. */
+uniform sampler1D gausstab_tx;
+
+uniform int filter_size;
+uniform int quality_step;
+
+/* Either (1, 0) or (0, 1). */
+const ivec2 direction = DIRECTION;
+
+void main()
+{
+  ivec2 texel;
+  if (!output_texel_get(texel)) {
+    return;
+  }
+
+  int coord = texel.x * direction.x + texel.y * direction.y;
+  ivec2 size = imageSize(output_img);
+  int coord_len = size.x * direction.x + size.y * direction.y;
+  int coord_min = max(coord - filter_size, 0);
+  int coord_max = min(coord + filter_size + 1, coord_len);
+
+  vec4 color_accum = vec4(0.0);
+  float multiplier_accum = 0.0;
+  for (int i = coord_min - coord; i < coord_max - coord; i += quality_step) {
+    float multiplier = texelFetch(gausstab_tx, i + filter_size, 0).x;
+    color_accum += load_input(input_tx, texel + i * direction) * multiplier;
+    multiplier_accum += multiplier;
+  }
+  imageStore(output_img, texel, color_accum / multiplier_accum);
+}
@@ -0,0 +1,39 @@
+/* Common code of the compositor compute shaders, see #GPUExecution. */
+
+/* Must match #LOCAL_WORK_GROUP_SIZE. */
+layout(local_size_x = 16, local_size_y = 16) in;
+
+/* Result of the operation, covering its whole canvas. */
+layout(rgba32f) uniform writeonly image2D output_img;
+
+#define FLT_EPSILON 1.192092896e-07
+
+/* Returns false for the invocations outside of the output. */
+bool output_texel_get(out ivec2 texel)
+{
+  texel = ivec2(gl_GlobalInvocationID.xy);
+  return all(lessThan(texel, imageSize(output_img)));
+}
+
+/* Inputs having a single element are 1x1 textures, read for every pixel. */
+vec4 load_input(sampler2D tx, ivec2 texel)
+{
+  return texelFetch(tx, min(texel, textureSize(tx, 0) - 1), 0);
+}
+
+/* Same as #srgb_to_linearrgb and #linearrgb_to_srgb. */
+float srgb_to_linearrgb(float c)
+{
+  if (c < 0.04045) {
+    return (c < 0.0) ? 0.0 : c * (1.0 / 12.92);
+  }
+  return pow((c + 0.055) * (1.0 / 1.055), 2.4);
+}
+
+float linearrgb_to_srgb(float c)
+{
+  if (c < 0.0031308) {
+    return (c < 0.0) ? 0.0 : c * 12.92;
+  }
+  return 1.055 * pow(c, 1.0 / 2.4) - 0.055;
+}
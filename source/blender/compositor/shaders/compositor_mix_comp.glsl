@@ -0,0 +1,77 @@
+/* Mix operations, #MIX_FUNCTION is one of the functions below. Must match #MixBaseOperation and
+ * its sub-classes. */
+
+uniform sampler2D value_tx;
+uniform sampler2D color1_tx;
+uniform sampler2D color2_tx;
+
+uniform bool use_value_alpha_multiply;
+uniform bool use_clamp;
+
+vec3 mix_blend(float value, vec3 color1, vec3 color2)
+{
+  return (1.0 - value) * color1 + value * color2;
+}
+
+vec3 mix_add(float value, vec3 color1, vec3 color2)
+{
+  return color1 + value * color2;
+}
+
+vec3 mix_multiply(float value, vec3 color1, vec3 color2)
+{
+  return color1 * ((1.0 - value) + value * color2);
+}
+
+vec3 mix_subtract(float value, vec3 color1, vec3 color2)
+{
+  return color1 - value * color2;
+}
+
+vec3 mix_screen(float value, vec3 color1, vec3 color2)
+{
+  return 1.0 - ((1.0 - value) + value * (1.0 - color2)) * (1.0 - color1);
+}
+
+vec3 mix_difference(float value, vec3 color1, vec3 color2)
+{
+  return (1.0 - value) * color1 + value * abs(color1 - color2);
+}
+
+vec3 mix_darken(float value, vec3 color1, vec3 color2)
+{
+  return min(color1, color2) * value + color1 * (1.0 - value);
+}
+
+vec3 mix_lighten(float value, vec3 color1, vec3 color2)
+{
+  return max(value * color2, color1);
+}
+
+vec3 mix_divide(float value, vec3 color1, vec3 color2)
+{
+  /* Components divided by zero are zero. */
+  vec3 result = (1.0 - value) * color1 + value * color1 / color2;
+  return mix(vec3(0.0), result, notEqual(color2, vec3(0.0)));
+}
+
+void main()
+{
+  ivec2 texel;
+  if (!output_texel_get(texel)) {
+    return;
+  }
+
+  float value = load_input(value_tx, texel).x;
+  vec4 color1 = load_input(color1_tx, texel);
+  vec4 color2 = load_input(color2_tx, texel);
+  if (use_value_alpha_multiply) {
+    value *= color2.a;
+  }
+
+  vec4 result = vec4(MIX_FUNCTION(value, color1.rgb, color2.rgb), color1.a);
+  if (use_clamp) {
+    result = clamp(result, 0.0, 1.0);
+  }
+  imageStore(output_img, texel, result);
+}
@@ -0,0 +1,89 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. */
+
+#include "testing/testing.h"
+
+#include "BLI_rect.h"
+
+#include "COM_MemoryBuffer.h"
+#include "COM_NodeOperation.h"
+#include "COM_ResultCache.h"
+
+namespace blender::compositor::tests {
+
+class CacheableOperation : public NodeOperation {
+ private:
+  float param_;
+
+ public:
+  CacheableOperation()
+  {
+    add_output_socket(DataType::Value);
+    set_width(4);
+    set_height(3);
+    param_ = 1.0f;
+    flags_.is_result_cacheable = true;
+  }
+
+  void set_param(float value)
+  {
+    param_ = value;
+  }
+
+  void hash_output_params() override
+  {
+    hash_param(param_);
+  }
+};
+
+static void fill_buffer(MemoryBuffer &buffer, const float value)
+{
+  for (BuffersIterator<float> it = buffer.iterate_with({}); !it.is_end(); ++it) {
+    *it.out = value;
+  }
+}
+
+TEST(ResultCache, lookup)
+{
+  rcti rect;
+  BLI_rcti_init(&rect, 0, 4, 0, 3);
+  const Vector<rcti> areas = {rect};
+
+  CacheableOperation op;
+  MemoryBuffer input(DataType::Value, rect);
+  fill_buffer(input, 0.5f);
+  Vector<MemoryBuffer *> inputs = {&input};
+
+  MemoryBuffer output(DataType::Value, rect);
+  std::optional<ResultCacheKey> key = ResultCache::generate_key(&op, output, areas, inputs);
+  ASSERT_TRUE(key.has_value());
+  EXPECT_FALSE(ResultCache::lookup(*key, output));
+
+  fill_buffer(output, 2.0f);
+  ResultCache::add(*key, output);
+
+  MemoryBuffer cached(DataType::Value, rect);
+  fill_buffer(cached, 0.0f);
+  EXPECT_TRUE(ResultCache::lookup(*key, cached));
+  EXPECT_EQ(*cached.get_elem(3, 2), 2.0f);
+
+  /* Different input content. */
+  fill_buffer(input, 0.25f);
+  key = ResultCache::generate_key(&op, output, areas, inputs);
+  EXPECT_FALSE(ResultCache::lookup(*key, cached));
+
+  /* Different parameters. */
+  fill_buffer(input, 0.5f);
+  op.set_param(3.0f);
+  key = ResultCache::generate_key(&op, output, areas, inputs);
+  EXPECT_FALSE(ResultCache::lookup(*key, cached));
+
+  op.set_param(1.0f);
+  key = ResultCache::generate_key(&op, output, areas, inputs);
+  EXPECT_TRUE(ResultCache::lookup(*key, cached));
+
+  ResultCache::free();
+  EXPECT_FALSE(ResultCache::lookup(*key, cached));
+}
+
+}  // namespace blender::compositor::tests
@@ -127,6 +127,13 @@ const char *DEG_update_tag_as_string(IDRecalcFlag flag);
 /** Tag given ID for an update in all the dependency graphs. */
 void DEG_id_tag_update(struct ID *id, int flag);
 void DEG_id_tag_update_ex(struct Main *bmain, struct ID *id, int flag);
+/**
+ * Same as #DEG_id_tag_update for an object, but the object data is not considered to be modified
+ * when the object geometry is tagged. Use this when only settings of the object itself changed
+ * (like modifier properties), so that the evaluated copy of potentially large object data is kept
+ * instead of being copied from the original again.
+ */
+void DEG_id_tag_update_object_settings(struct ID *object_id, int flag);
 
 void DEG_graph_id_tag_update(struct Main *bmain,
                              struct Depsgraph *depsgraph,
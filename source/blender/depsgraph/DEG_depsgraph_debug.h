@@ -52,6 +52,14 @@ void DEG_debug_stats_gnuplot(const struct Depsgraph *graph,
                              const char *label,
                              const char *output_filename);
 
+/**
+ * Write the timeline of the last evaluation in the Chrome trace event format (JSON). Contains
+ * start time, duration and thread of every evaluated operation, including copy-on-write updates,
+ * and of the parallel loops and their tasks run by the task system during the evaluation.
+ * Timings are only recorded when depsgraph time debugging is enabled.
+ */
+void DEG_debug_stats_trace(const struct Depsgraph *graph, FILE *fp);
+
 /* ************************************************ */
 
 /** Compare two dependency graphs. */
@@ -15,6 +15,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_set.hh"
 #include "BLI_string.h"
 #include "BLI_utildefines.h"
 
@@ -40,6 +41,36 @@
 
 namespace blender::deg {
 
+/* Pose channels of IK and Spline IK chains. The solvers write their pose matrices in between the
+ * Ready and Done operations of the bone, so those can not be evaluated as one operation. */
+static Set<const bPoseChannel *> pose_solver_chain_channels(Object *object)
+{
+  Set<const bPoseChannel *> chain_channels;
+  LISTBASE_FOREACH (bPoseChannel *, pchan, &object->pose->chanbase) {
+    LISTBASE_FOREACH (bConstraint *, con, &pchan->constraints) {
+      bPoseChannel *rootchan;
+      if (con->type == CONSTRAINT_TYPE_KINEMATIC) {
+        rootchan = BKE_armature_ik_solver_find_root(pchan, (bKinematicConstraint *)con->data);
+      }
+      else if (con->type == CONSTRAINT_TYPE_SPLINEIK) {
+        rootchan = BKE_armature_splineik_solver_find_root(pchan,
+                                                          (bSplineIKConstraint *)con->data);
+      }
+      else {
+        continue;
+      }
+      /* Without a root, the whole parent chain is considered to be affected. */
+      for (bPoseChannel *parchan = pchan; parchan != nullptr; parchan = parchan->parent) {
+        chain_channels.add(parchan);
+        if (parchan == rootchan) {
+          break;
+        }
+      }
+    }
+  }
+  return chain_channels;
+}
+
 void DepsgraphNodeBuilder::build_pose_constraints(Object *object,
                                                   bPoseChannel *pchan,
                                                   int pchan_index)
@@ -206,6 +237,7 @@ void DepsgraphNodeBuilder::build_rig(Object *object)
       [object_cow](::Depsgraph *depsgraph) { BKE_pose_eval_done(depsgraph, object_cow); });
   op_node->set_as_exit();
   /* Bones. */
+  const Set<const bPoseChannel *> solver_chain_channels = pose_solver_chain_channels(object);
   int pchan_index = 0;
   LISTBASE_FOREACH (bPoseChannel *, pchan, &object->pose->chanbase) {
     /* Node for bone evaluation. */
@@ -213,24 +245,40 @@ void DepsgraphNodeBuilder::build_rig(Object *object)
         &object->id, NodeType::BONE, pchan->name, OperationCode::BONE_LOCAL);
     op_node->set_as_entry();
 
+    /* Nothing happens in between parenting and done for bones without constraints and solvers,
+     * so both are evaluated by the parenting operation and done is a noop. This halves the number
+     * of scheduled operations for the many trivial bones of typical rigs. */
+    const bool is_trivial_bone = pchan->constraints.first == nullptr &&
+                                 !solver_chain_channels.contains(pchan);
+
     add_operation_node(&object->id,
                        NodeType::BONE,
                        pchan->name,
                        OperationCode::BONE_POSE_PARENT,
-                       [scene_cow, object_cow, pchan_index](::Depsgraph *depsgraph) {
+                       [scene_cow, object_cow, pchan_index, is_trivial_bone](
+                           ::Depsgraph *depsgraph) {
                          BKE_pose_eval_bone(depsgraph, scene_cow, object_cow, pchan_index);
+                         if (is_trivial_bone) {
+                           BKE_pose_bone_done(depsgraph, object_cow, pchan_index);
+                         }
                        });
 
     /* NOTE: Dedicated noop for easier relationship construction. */
     add_operation_node(&object->id, NodeType::BONE, pchan->name, OperationCode::BONE_READY);
 
-    op_node = add_operation_node(&object->id,
-                                 NodeType::BONE,
-                                 pchan->name,
-                                 OperationCode::BONE_DONE,
-                                 [object_cow, pchan_index](::Depsgraph *depsgraph) {
-                                   BKE_pose_bone_done(depsgraph, object_cow, pchan_index);
-                                 });
+    if (is_trivial_bone) {
+      op_node = add_operation_node(
+          &object->id, NodeType::BONE, pchan->name, OperationCode::BONE_DONE);
+    }
+    else {
+      op_node = add_operation_node(&object->id,
+                                   NodeType::BONE,
+                                   pchan->name,
+                                   OperationCode::BONE_DONE,
+                                   [object_cow, pchan_index](::Depsgraph *depsgraph) {
+                                     BKE_pose_bone_done(depsgraph, object_cow, pchan_index);
+                                   });
+    }
 
     /* B-Bone shape computation - the real last step if present. */
     if (check_pchan_has_bbone(object, pchan)) {
@@ -39,17 +39,37 @@ enum {
   OP_REACHABLE = 2,
 };
 
-static void deg_graph_tag_paths_recursive(Node *node)
+/* Mark nodes from which the target can be reached, starting with the sources of the inlinks of
+ * the target, so the target node and its direct children are not flagged as reachable.
+ *
+ * All flagged nodes are added to the visited nodes, so that only their flags have to be cleared
+ * before the next target. Clearing the flags of all operations for every target makes the
+ * reduction quadratic in the number of operations, even when there are only few relations.
+ * An explicit stack is used, since the paths can be too long for recursion. */
+static void deg_graph_tag_paths(OperationNode *target,
+                                Vector<Node *> &r_visited_nodes,
+                                Vector<Node *> &stack)
 {
-  if (node->custom_flags & OP_VISITED) {
-    return;
+  target->custom_flags |= OP_VISITED;
+  r_visited_nodes.append(target);
+  for (Relation *rel : target->inlinks) {
+    stack.append(rel->from);
   }
-  node->custom_flags |= OP_VISITED;
-  for (Relation *rel : node->inlinks) {
-    deg_graph_tag_paths_recursive(rel->from);
-    /* Do this only in inlinks loop, so the target node does not get
-     * flagged. */
-    rel->from->custom_flags |= OP_REACHABLE;
+  while (!stack.is_empty()) {
+    Node *node = stack.pop_last();
+    if (node->custom_flags & OP_VISITED) {
+      continue;
+    }
+    node->custom_flags |= OP_VISITED;
+    r_visited_nodes.append(node);
+    for (Relation *rel : node->inlinks) {
+      /* Do this only in inlinks loop, so the target node does not get
+       * flagged. */
+      rel->from->custom_flags |= OP_REACHABLE;
+      if (!(rel->from->custom_flags & OP_VISITED)) {
+        stack.append(rel->from);
+      }
+    }
   }
 }
 
@@ -57,19 +77,16 @@ void deg_graph_transitive_reduction(Depsgraph *graph)
 {
   int num_removed_relations = 0;
   Vector<Relation *> relations_to_remove;
+  Vector<Node *> visited_nodes;
+  Vector<Node *> stack;
+
+  /* Clear tags. */
+  for (OperationNode *node : graph->operations) {
+    node->custom_flags = 0;
+  }
 
   for (OperationNode *target : graph->operations) {
-    /* Clear tags. */
-    for (OperationNode *node : graph->operations) {
-      node->custom_flags = 0;
-    }
-    /* Mark nodes from which we can reach the target
-     * start with children, so the target node and direct children are not
-     * flagged. */
-    target->custom_flags |= OP_VISITED;
-    for (Relation *rel : target->inlinks) {
-      deg_graph_tag_paths_recursive(rel->from);
-    }
+    deg_graph_tag_paths(target, visited_nodes, stack);
     /* Remove redundant paths to the target. */
     for (Relation *rel : target->inlinks) {
       if (rel->from->type == NodeType::TIMESOURCE) {
@@ -89,6 +106,11 @@ void deg_graph_transitive_reduction(Depsgraph *graph)
     }
     num_removed_relations += relations_to_remove.size();
     relations_to_remove.clear();
+    /* Clear tags of the nodes visited for this target. */
+    for (Node *node : visited_nodes) {
+      node->custom_flags = 0;
+    }
+    visited_nodes.clear();
   }
   DEG_DEBUG_PRINTF((::Depsgraph *)graph, BUILD, "Removed %d relations\n", num_removed_relations);
 }
@@ -0,0 +1,145 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Export of the timeline of the last graph evaluation in the Chrome trace event format, which can
+ * be viewed in `chrome://tracing` or other trace viewers.
+ */
+
+#include "DEG_depsgraph_debug.h"
+
+#include <algorithm>
+
+#include "BLI_map.hh"
+#include "BLI_task.h"
+
+#include "intern/depsgraph.h"
+#include "intern/node/deg_node_component.h"
+#include "intern/node/deg_node_id.h"
+#include "intern/node/deg_node_operation.h"
+
+#include "DNA_ID.h"
+
+namespace deg = blender::deg;
+
+namespace blender::deg {
+namespace {
+
+std::string json_escape(const std::string &str)
+{
+  std::string result;
+  result.reserve(str.size());
+  for (const char c : str) {
+    switch (c) {
+      case '"':
+        result += "\\\"";
+        break;
+      case '\\':
+        result += "\\\\";
+        break;
+      default:
+        if ((unsigned char)c < 0x20) {
+          /* Control characters are not expected in names, skip them. */
+          break;
+        }
+        result += c;
+        break;
+    }
+  }
+  return result;
+}
+
+void collect_task_trace_event(const TaskTraceEvent *event, void *userdata)
+{
+  static_cast<Vector<TaskTraceEvent> *>(userdata)->append(*event);
+}
+
+void deg_debug_stats_trace(const Depsgraph *graph, FILE *fp)
+{
+  Vector<const OperationNode *> evaluated_operations;
+  for (const OperationNode *operation_node : graph->operations) {
+    if (operation_node->stats.current_start_time != 0.0) {
+      evaluated_operations.append(operation_node);
+    }
+  }
+  std::sort(evaluated_operations.begin(),
+            evaluated_operations.end(),
+            [](const OperationNode *a, const OperationNode *b) {
+              return a->stats.current_start_time < b->stats.current_start_time;
+            });
+
+  /* Parallel loops and their tasks recorded during the evaluation. */
+  Vector<TaskTraceEvent> task_events;
+  BLI_task_trace_foreach(collect_task_trace_event, &task_events);
+
+  /* Times are written relative to the first evaluated operation. */
+  const double base_time = evaluated_operations.is_empty() ?
+                               0.0 :
+                               evaluated_operations[0]->stats.current_start_time;
+  /* Map thread identifiers to small numbers, which are easier to read in trace viewers. The
+   * task system uses the same identifiers, so its events line up with the operations. */
+  Map<uint64_t, int> thread_indices;
+  const int threads_num = BLI_task_scheduler_num_threads();
+
+  fprintf(fp, "{\"traceEvents\":[\n");
+  const char *separator = "";
+  for (const OperationNode *operation_node : evaluated_operations) {
+    const ComponentNode *component_node = operation_node->owner;
+    const IDNode *id_node = component_node->owner;
+    const int thread_index = thread_indices.lookup_or_add(operation_node->stats.current_thread_id,
+                                                          thread_indices.size());
+    fprintf(fp,
+            "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+            "\"pid\":0,\"tid\":%d,\"args\":{\"id\":\"%s\",\"component\":\"%s\"}}\n",
+            separator,
+            json_escape(operation_node->identifier()).c_str(),
+            nodeTypeAsString(component_node->type),
+            (operation_node->stats.current_start_time - base_time) * 1e6,
+            operation_node->stats.current_time * 1e6,
+            thread_index,
+            json_escape(id_node->id_orig->name).c_str(),
+            json_escape(component_node->name).c_str());
+    separator = ",";
+  }
+  for (const TaskTraceEvent &event : task_events) {
+    const int thread_index = thread_indices.lookup_or_add(event.thread_id, thread_indices.size());
+    const double duration = event.end_time - event.start_time;
+    fprintf(fp,
+            "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+            "\"pid\":0,\"tid\":%d",
+            separator,
+            json_escape(event.name).c_str(),
+            event.tasks_num ? "PARALLEL_LOOP" : "TASK",
+            (event.start_time - base_time) * 1e6,
+            duration * 1e6,
+            thread_index);
+    if (event.tasks_num) {
+      /* Average number of busy threads relative to the available ones. */
+      const double utilization = duration > 0.0 ? event.busy_time / (duration * threads_num) :
+                                                  1.0;
+      fprintf(fp,
+              ",\"args\":{\"range\":%lld,\"grain_size\":%lld,\"tasks\":%d,"
+              "\"busy_ms\":%.3f,\"utilization\":%.3f}",
+              (long long)event.range_size,
+              (long long)event.grain_size,
+              event.tasks_num,
+              event.busy_time * 1e3,
+              utilization);
+    }
+    fprintf(fp, "}\n");
+    separator = ",";
+  }
+  fprintf(fp, "],\"displayTimeUnit\":\"ms\"}\n");
+}
+
+}  // namespace
+}  // namespace blender::deg
+
+void DEG_debug_stats_trace(const Depsgraph *depsgraph, FILE *fp)
+{
+  if (depsgraph == nullptr) {
+    return;
+  }
+  deg::deg_debug_stats_trace((const deg::Depsgraph *)depsgraph, fp);
+}
@@ -90,20 +90,24 @@ void ensure_boundbox_freed(const Object *dupli_object, Object *temp_dupli_object
   temp_dupli_object->runtime.bb = nullptr;
 }
 
-void free_owned_memory(DEGObjectIterData *data)
+void free_owned_memory_for(const DupliObject *dob, Object *temp_dupli_object)
 {
-  if (data->dupli_object_current == nullptr) {
+  if (dob == nullptr) {
     /* We didn't enter duplication yet, so we can't have any dangling pointers. */
     return;
   }
 
-  const Object *dupli_object = data->dupli_object_current->ob;
-  Object *temp_dupli_object = &data->temp_dupli_object;
+  const Object *dupli_object = dob->ob;
 
   ensure_id_properties_freed(dupli_object, temp_dupli_object);
   ensure_boundbox_freed(dupli_object, temp_dupli_object);
 }
 
+void free_owned_memory(DEGObjectIterData *data)
+{
+  free_owned_memory_for(data->dupli_object_current, &data->temp_dupli_object);
+}
+
 bool deg_object_hide_original(eEvaluationMode eval_mode, Object *ob, DupliObject *dob)
 {
   /* Automatic hiding if this object is being instanced on verts/faces/frames
@@ -160,29 +164,40 @@ bool deg_iterator_duplis_step(DEGObjectIterData *data)
       continue;
     }
 
-    free_owned_memory(data);
+    Object *temp_dupli_object = &data->temp_dupli_object;
+
+    /* Many instances in a row often use the same object and data, for example when scattering
+     * an object on points. The temporary object only differs in the matrices then, so the copy
+     * from the previous instance is reused. That also keeps its bounding box. */
+    const DupliObject *dob_prev = data->dupli_object_current;
+    const bool reuse_temp_object = dob_prev != nullptr && dob_prev->ob == dob->ob &&
+                                   dob_prev->ob_data == dob->ob_data;
 
     data->dupli_object_current = dob;
 
-    /* Temporary object to evaluate. */
-    Object *dupli_parent = data->dupli_parent;
-    Object *temp_dupli_object = &data->temp_dupli_object;
-    *temp_dupli_object = *dob->ob;
-    temp_dupli_object->base_flag = dupli_parent->base_flag | BASE_FROM_DUPLI;
-    temp_dupli_object->base_local_view_bits = dupli_parent->base_local_view_bits;
-    temp_dupli_object->runtime.local_collections_bits =
-        dupli_parent->runtime.local_collections_bits;
-    temp_dupli_object->dt = MIN2(temp_dupli_object->dt, dupli_parent->dt);
-    copy_v4_v4(temp_dupli_object->color, dupli_parent->color);
-    temp_dupli_object->runtime.select_id = dupli_parent->runtime.select_id;
-    if (dob->ob->data != dob->ob_data) {
-      /* Do not modify the original boundbox. */
-      temp_dupli_object->runtime.bb = nullptr;
-      BKE_object_replace_data_on_shallow_copy(temp_dupli_object, dob->ob_data);
-    }
+    if (!reuse_temp_object) {
+      free_owned_memory_for(dob_prev, temp_dupli_object);
+
+      /* Temporary object to evaluate. */
+      Object *dupli_parent = data->dupli_parent;
+      *temp_dupli_object = *dob->ob;
+      temp_dupli_object->base_flag = dupli_parent->base_flag | BASE_FROM_DUPLI;
+      temp_dupli_object->base_local_view_bits = dupli_parent->base_local_view_bits;
+      temp_dupli_object->runtime.local_collections_bits =
+          dupli_parent->runtime.local_collections_bits;
+      temp_dupli_object->dt = MIN2(temp_dupli_object->dt, dupli_parent->dt);
+      copy_v4_v4(temp_dupli_object->color, dupli_parent->color);
+      temp_dupli_object->runtime.select_id = dupli_parent->runtime.select_id;
+      if (dob->ob->data != dob->ob_data) {
+        /* Do not modify the original boundbox. */
+        temp_dupli_object->runtime.bb = nullptr;
+        BKE_object_replace_data_on_shallow_copy(temp_dupli_object, dob->ob_data);
+      }
 
-    /* Duplicated elements shouldn't care whether their original collection is visible or not. */
-    temp_dupli_object->base_flag |= BASE_VISIBLE_DEPSGRAPH;
+      /* Duplicated elements shouldn't care whether their original collection is visible or
+       * not. */
+      temp_dupli_object->base_flag |= BASE_VISIBLE_DEPSGRAPH;
+    }
 
     int ob_visibility = BKE_object_visibility(temp_dupli_object, data->eval_mode);
     if ((ob_visibility & (OB_VISIBLE_SELF | OB_VISIBLE_PARTICLES)) == 0) {
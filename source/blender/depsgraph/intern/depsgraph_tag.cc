@@ -353,7 +353,8 @@ void graph_id_tag_update_single_flag(Main *bmain,
                                      ID *id,
                                      IDNode *id_node,
                                      IDRecalcFlag tag,
-                                     eUpdateSource update_source)
+                                     eUpdateSource update_source,
+                                     const bool tag_object_data = true)
 {
   if (tag == ID_RECALC_EDITORS) {
     if (graph != nullptr && graph->is_active) {
@@ -390,7 +391,9 @@ void graph_id_tag_update_single_flag(Main *bmain,
   }
   /* TODO(sergey): Get rid of this once all areas are using proper data ID
    * for tagging. */
-  deg_graph_id_tag_legacy_compat(bmain, graph, id, tag, update_source);
+  if (tag_object_data || GS(id->name) != ID_OB) {
+    deg_graph_id_tag_legacy_compat(bmain, graph, id, tag, update_source);
+  }
 }
 
 string stringify_append_bit(const string &str, IDRecalcFlag tag)
@@ -614,11 +617,15 @@ NodeType geometry_tag_to_component(const ID *id)
   return NodeType::UNDEFINED;
 }
 
-void id_tag_update(Main *bmain, ID *id, int flag, eUpdateSource update_source)
+void id_tag_update(Main *bmain,
+                   ID *id,
+                   int flag,
+                   eUpdateSource update_source,
+                   const bool tag_object_data)
 {
-  graph_id_tag_update(bmain, nullptr, id, flag, update_source);
+  graph_id_tag_update(bmain, nullptr, id, flag, update_source, tag_object_data);
   for (deg::Depsgraph *depsgraph : deg::get_all_registered_graphs(bmain)) {
-    graph_id_tag_update(bmain, depsgraph, id, flag, update_source);
+    graph_id_tag_update(bmain, depsgraph, id, flag, update_source, tag_object_data);
   }
 
   /* Accumulate all tags for an ID between two undo steps, so they can be
@@ -626,8 +633,12 @@ void id_tag_update(Main *bmain, ID *id, int flag, eUpdateSource update_source)
   id->recalc_after_undo_push |= deg_recalc_flags_effective(nullptr, flag);
 }
 
-void graph_id_tag_update(
-    Main *bmain, Depsgraph *graph, ID *id, int flag, eUpdateSource update_source)
+void graph_id_tag_update(Main *bmain,
+                         Depsgraph *graph,
+                         ID *id,
+                         int flag,
+                         eUpdateSource update_source,
+                         const bool tag_object_data)
 {
   const int debug_flags = (graph != nullptr) ? DEG_debug_flags_get((::Depsgraph *)graph) : G.debug;
   if (graph != nullptr && graph->is_evaluating) {
@@ -668,7 +679,8 @@ void graph_id_tag_update(
   int current_flag = flag;
   while (current_flag != 0) {
     IDRecalcFlag tag = (IDRecalcFlag)(1 << bitscan_forward_clear_i(&current_flag));
-    graph_id_tag_update_single_flag(bmain, graph, id, id_node, tag, update_source);
+    graph_id_tag_update_single_flag(
+        bmain, graph, id, id_node, tag, update_source, tag_object_data);
   }
   /* Special case for nested node tree data-blocks. */
   id_tag_update_ntree_special(bmain, graph, id, flag, update_source);
@@ -761,6 +773,12 @@ void DEG_id_tag_update_ex(Main *bmain, ID *id, int flag)
   deg::id_tag_update(bmain, id, flag, deg::DEG_UPDATE_SOURCE_USER_EDIT);
 }
 
+void DEG_id_tag_update_object_settings(ID *object_id, int flag)
+{
+  BLI_assert(GS(object_id->name) == ID_OB);
+  deg::id_tag_update(G.main, object_id, flag, deg::DEG_UPDATE_SOURCE_USER_EDIT, false);
+}
+
 void DEG_graph_id_tag_update(struct Main *bmain,
                              struct Depsgraph *depsgraph,
                              struct ID *id,
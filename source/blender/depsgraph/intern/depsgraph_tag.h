@@ -18,12 +18,22 @@ struct Depsgraph;
 /* Get type of a node which corresponds to a ID_RECALC_GEOMETRY tag. */
 NodeType geometry_tag_to_component(const ID *id);
 
-/* Tag given ID for an update in all registered dependency graphs. */
-void id_tag_update(Main *bmain, ID *id, int flag, eUpdateSource update_source);
+/* Tag given ID for an update in all registered dependency graphs.
+ * When `tag_object_data` is false, tagging the geometry of an object does not tag its object data
+ * as modified. */
+void id_tag_update(Main *bmain,
+                   ID *id,
+                   int flag,
+                   eUpdateSource update_source,
+                   bool tag_object_data = true);
 
 /* Tag given ID for an update with in a given dependency graph. */
-void graph_id_tag_update(
-    Main *bmain, Depsgraph *graph, ID *id, int flag, eUpdateSource update_source);
+void graph_id_tag_update(Main *bmain,
+                         Depsgraph *graph,
+                         ID *id,
+                         int flag,
+                         eUpdateSource update_source,
+                         bool tag_object_data = true);
 
 /* Tag IDs of the graph for the visibility update tags.
  * Will do nothing if the graph is not tagged for visibility update. */
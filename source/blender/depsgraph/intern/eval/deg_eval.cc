@@ -9,6 +9,8 @@
 
 #include "intern/eval/deg_eval.h"
 
+#include <thread>
+
 #include "PIL_time.h"
 
 #include "BLI_compiler_attrs.h"
@@ -97,23 +99,61 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
     const double start_time = PIL_check_seconds_timer();
     operation_node->evaluate(depsgraph);
     operation_node->stats.current_time += PIL_check_seconds_timer() - start_time;
+    operation_node->stats.current_start_time = start_time;
+    operation_node->stats.current_thread_id = std::hash<std::thread::id>()(
+        std::this_thread::get_id());
   }
   else {
     operation_node->evaluate(depsgraph);
   }
 }
 
+void schedule_node_to_vector(OperationNode *node,
+                             const int /*thread_id*/,
+                             Vector<OperationNode *> *r_ready_nodes)
+{
+  r_ready_nodes->append(node);
+}
+
+/* Pick the node that is evaluated in the current task directly instead of being scheduled to the
+ * pool. Nodes with many dependent operations are preferred, because they are more likely to be on
+ * the critical path of the evaluation. */
+OperationNode *pop_node_to_continue_with(Vector<OperationNode *> &ready_nodes)
+{
+  if (ready_nodes.is_empty()) {
+    return nullptr;
+  }
+  int best_index = 0;
+  for (const int i : ready_nodes.index_range()) {
+    if (ready_nodes[i]->outlinks.size() > ready_nodes[best_index]->outlinks.size()) {
+      best_index = i;
+    }
+  }
+  OperationNode *node = ready_nodes[best_index];
+  ready_nodes.remove_and_reorder(best_index);
+  return node;
+}
+
 void deg_task_run_func(TaskPool *pool, void *taskdata)
 {
   void *userdata_v = BLI_task_pool_user_data(pool);
   DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
 
-  /* Evaluate node. */
+  /* Instead of pushing every child that became ready to the pool, one of them is evaluated in
+   * this task right away. Long chains of small operations (like drivers and transforms) are
+   * evaluated without scheduling overhead this way, and the data they share stays in cache. */
+  Vector<OperationNode *> ready_nodes;
   OperationNode *operation_node = reinterpret_cast<OperationNode *>(taskdata);
-  evaluate_node(state, operation_node);
+  while (operation_node != nullptr) {
+    evaluate_node(state, operation_node);
 
-  /* Schedule children. */
-  schedule_children(state, operation_node, schedule_node_to_pool, pool);
+    schedule_children(state, operation_node, schedule_node_to_vector, &ready_nodes);
+    operation_node = pop_node_to_continue_with(ready_nodes);
+    for (OperationNode *node : ready_nodes) {
+      schedule_node_to_pool(node, 0, pool);
+    }
+    ready_nodes.clear();
+  }
 }
 
 bool check_operation_node_visible(OperationNode *op_node)
@@ -366,6 +406,10 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   state.graph = graph;
   state.do_stats = graph->debug.do_time_debug();
   state.need_single_thread_pass = false;
+  if (state.do_stats) {
+    /* Record parallel loops of the evaluation, for #DEG_debug_stats_trace. */
+    BLI_task_trace_begin();
+  }
   /* Prepare all nodes for evaluation. */
   initialize_execution(&state, graph);
 
@@ -393,6 +437,7 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
    * operation timing here, without aggregating anything to avoid any extra
    * synchronization. */
   if (state.do_stats) {
+    BLI_task_trace_end();
     deg_eval_stats_aggregate(graph);
   }
   /* Clear any uncleared tags - just in case. */
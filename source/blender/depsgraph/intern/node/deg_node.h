@@ -162,6 +162,11 @@ struct Node {
     void reset_current();
     /* Time spend on this node during current graph evaluation. */
     double current_time;
+    /* Point in time when the evaluation of this operation started during the current graph
+     * evaluation, and identifier of the thread it ran on. Used for timeline exports. The start
+     * time is zero when the operation has not been evaluated. */
+    double current_start_time;
+    uint64_t current_thread_id;
   };
   /* Relationships between nodes
    * The reason why all depsgraph nodes are descended from this type (apart
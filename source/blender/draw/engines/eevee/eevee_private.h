@@ -37,6 +37,8 @@ extern struct DrawEngineType draw_engine_eevee_type;
 #define MAX_SHADOW 128 /* TODO: Make this depends on #GL_MAX_ARRAY_TEXTURE_LAYERS. */
 #define MAX_SHADOW_CASCADE 8
 #define MAX_SHADOW_CUBE (MAX_SHADOW - MAX_CASCADE_NUM * MAX_SHADOW_CASCADE)
+/* Bit-mask of the 6 faces of a shadow cube-map. */
+#define SHADOW_CUBE_FACE_ALL 0x3F
 #define MAX_BLOOM_STEP 16
 #define MAX_AOVS 64
 
@@ -549,6 +551,8 @@ typedef struct EEVEE_LightsInfo {
   uchar shadow_cascade_light_indices[MAX_SHADOW_CASCADE];
   /* Update bitmap. */
   BLI_bitmap sh_cube_update[BLI_BITMAP_SIZE(MAX_SHADOW_CUBE)];
+  /* Faces to render of the cubes tagged in `sh_cube_update`. */
+  uchar sh_cube_face_update[MAX_SHADOW_CUBE];
   /* Lights tracking */
   struct BoundSphere shadow_bounds[MAX_LIGHT]; /* Tightly packed light bounds. */
   /* List of bbox and update bitmap. Double buffered. */
@@ -185,6 +185,66 @@ static bool sphere_bbox_intersect(const BoundSphere *bs, const EEVEE_BoundBox *b
   return x && y && z;
 }
 
+/**
+ * Return the faces of the shadow cube that can contain a part of the bounding box.
+ * The box is transformed to the light space of the cube, where each face covers the pyramid
+ * around one axis: the box overlaps the +X face if some of its points verify `x >= |y|` and
+ * `x >= |z|`.
+ */
+static uchar shadow_cube_bbox_faces_get(const EEVEE_ShadowCube *cube_data,
+                                        const EEVEE_BoundBox *bb)
+{
+  /* Enlarge the faces to account for the soft shadows random rotation and the half texel
+   * border used for filtering. */
+  const float face_slope = 1.1f;
+
+  float center[3], halfdim[3];
+  mul_v3_m4v3(center, cube_data->shadowmat, bb->center);
+  for (int i = 0; i < 3; i++) {
+    halfdim[i] = fabsf(cube_data->shadowmat[0][i]) * bb->halfdim[0] +
+                 fabsf(cube_data->shadowmat[1][i]) * bb->halfdim[1] +
+                 fabsf(cube_data->shadowmat[2][i]) * bb->halfdim[2];
+  }
+
+  /* Smallest distance to the axis inside the box, for each axis. */
+  float dist_min[3];
+  for (int i = 0; i < 3; i++) {
+    dist_min[i] = max_ff(0.0f, fabsf(center[i]) - halfdim[i]);
+  }
+
+  uchar faces = 0;
+  for (int axis = 0; axis < 3; axis++) {
+    const int axis_u = (axis + 1) % 3;
+    const int axis_v = (axis + 2) % 3;
+    /* Positive side, then negative side, matching the order of #cubefacemat. */
+    const float extent[2] = {center[axis] + halfdim[axis], halfdim[axis] - center[axis]};
+    for (int side = 0; side < 2; side++) {
+      const float reach = extent[side] * face_slope;
+      if (extent[side] > 0.0f && reach >= dist_min[axis_u] && reach >= dist_min[axis_v]) {
+        faces |= 1 << (axis * 2 + side);
+      }
+    }
+  }
+  return faces;
+}
+
+static void shadow_cube_caster_update_tag(EEVEE_LightsInfo *linfo,
+                                          const EEVEE_BoundBox *bb,
+                                          int cube_index)
+{
+  if (linfo->sh_cube_face_update[cube_index] == SHADOW_CUBE_FACE_ALL) {
+    return;
+  }
+  if (!sphere_bbox_intersect(&linfo->shadow_bounds[cube_index], bb)) {
+    return;
+  }
+  const uchar faces = shadow_cube_bbox_faces_get(&linfo->shadow_cube_data[cube_index], bb);
+  if (faces != 0) {
+    BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], cube_index);
+    linfo->sh_cube_face_update[cube_index] |= faces;
+  }
+}
+
 void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
 {
   EEVEE_StorageList *stl = vedata->stl;
@@ -202,6 +262,7 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
     linfo->cache_num_cube_layer = linfo->num_cube_layer;
     /* Update all lights. */
     BLI_bitmap_set_all(&linfo->sh_cube_update[0], true, MAX_LIGHT);
+    memset(linfo->sh_cube_face_update, SHADOW_CUBE_FACE_ALL, sizeof(linfo->sh_cube_face_update));
   }
 
   if (linfo->num_cascade_layer != linfo->cache_num_cascade_layer) {
@@ -237,22 +298,20 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
     /* Setup shadow cube in UBO and tag for update if necessary. */
     if (EEVEE_shadows_cube_setup(linfo, evli, effects->taa_current_sample - 1)) {
       BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
+      linfo->sh_cube_face_update[j] = SHADOW_CUBE_FACE_ALL;
     }
   }
 
+  /* Only the faces of the shadow cubes seeing a moving shadow caster are rendered again, the
+   * depth of the static casters in the other faces is kept from the previous redraw. */
   /* TODO(fclem): This part can be slow, optimize it. */
   EEVEE_BoundBox *bbox = backbuffer->bbox;
-  BoundSphere *bsphere = linfo->shadow_bounds;
   /* Search for deleted shadow casters or if shcaster WAS in shadow radius. */
   for (int i = 0; i < backbuffer->count; i++) {
     /* If the shadow-caster has been deleted or updated. */
     if (BLI_BITMAP_TEST(backbuffer->update, i)) {
       for (int j = 0; j < linfo->cube_len; j++) {
-        if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
-          if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
-            BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
-          }
-        }
+        shadow_cube_caster_update_tag(linfo, &bbox[i], j);
       }
     }
   }
@@ -262,11 +321,7 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
     /* If the shadow-caster has been updated. */
     if (BLI_BITMAP_TEST(frontbuffer->update, i)) {
       for (int j = 0; j < linfo->cube_len; j++) {
-        if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
-          if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
-            BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
-          }
-        }
+        shadow_cube_caster_update_tag(linfo, &bbox[i], j);
       }
     }
   }
@@ -29,6 +29,7 @@ void EEVEE_shadows_cube_add(EEVEE_LightsInfo *linfo, EEVEE_Light *evli, Object *
 
   if (update) {
     BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], linfo->cube_len);
+    linfo->sh_cube_face_update[linfo->cube_len] = SHADOW_CUBE_FACE_ALL;
   }
 
   sh_data->near = max_ff(la->clipsta, 1e-8f);
@@ -193,6 +194,10 @@ void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata,
     if (evli->light_type != LA_LOCAL && j == 4) {
       continue;
     }
+    /* Only render the faces containing updated shadow casters, the others are still valid. */
+    if ((linfo->sh_cube_face_update[cube_index] & (1 << j)) == 0) {
+      continue;
+    }
     /* TODO(fclem): some cube sides can be invisible in the main views. Cull them. */
     // if (frustum_intersect(g_data->cube_views[j], main_view))
     //   continue;
@@ -206,4 +211,5 @@ void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata,
   }
 
   BLI_BITMAP_SET(&linfo->sh_cube_update[0], cube_index, false);
+  linfo->sh_cube_face_update[cube_index] = 0;
 }
@@ -146,6 +146,9 @@ template<typename TextureMethod> class ScreenSpaceDrawingMode : public AbstractD
 
       LISTBASE_FOREACH (ImageTile *, image_tile_ptr, &image->tiles) {
         const ImageTileWrapper image_tile(image_tile_ptr);
+        if (!is_tile_visible(info, image_tile)) {
+          continue;
+        }
         const int tile_x = image_tile.get_tile_x_offset();
         const int tile_y = image_tile.get_tile_y_offset();
         tile_user.tile = image_tile.get_tile_number();
@@ -168,6 +171,21 @@ template<typename TextureMethod> class ScreenSpaceDrawingMode : public AbstractD
     }
   }
 
+  /**
+   * \brief Check if the uv bounds of the tile overlap with the uv bounds of the texture.
+   *
+   * Tiles outside the texture don't contribute to it, skipping them avoids loading the image
+   * buffers of tiles that aren't on screen.
+   */
+  static bool is_tile_visible(const TextureInfo &info, const ImageTileWrapper &image_tile)
+  {
+    const float tile_x = static_cast<float>(image_tile.get_tile_x_offset());
+    const float tile_y = static_cast<float>(image_tile.get_tile_y_offset());
+    rctf tile_uv_bounds;
+    BLI_rctf_init(&tile_uv_bounds, tile_x, tile_x + 1.0f, tile_y, tile_y + 1.0f);
+    return BLI_rctf_isect(&info.clipping_uv_bounds, &tile_uv_bounds, nullptr);
+  }
+
   /**
    * \brief Update GPUTextures for drawing the image.
    *
@@ -239,6 +257,20 @@ template<typename TextureMethod> class ScreenSpaceDrawingMode : public AbstractD
       if (iterator.tile_data.tile_buffer == nullptr) {
         continue;
       }
+      /* Tiles that aren't on screen don't need a float buffer, they are updated when they become
+       * visible as that changes the uv bounds of the textures. */
+      const ImageTileWrapper changed_tile(iterator.tile_data.tile);
+      bool is_visible = false;
+      for (int i = 0; i < SCREEN_SPACE_DRAWING_MODE_TEXTURE_LEN; i++) {
+        const TextureInfo &info = instance_data.texture_infos[i];
+        if (info.visible && !info.dirty && is_tile_visible(info, changed_tile)) {
+          is_visible = true;
+          break;
+        }
+      }
+      if (!is_visible) {
+        continue;
+      }
       ImBuf *tile_buffer = ensure_float_buffer(instance_data, iterator.tile_data.tile_buffer);
       if (tile_buffer != iterator.tile_data.tile_buffer) {
         do_partial_update_float_buffer(tile_buffer, iterator);
@@ -384,6 +416,10 @@ template<typename TextureMethod> class ScreenSpaceDrawingMode : public AbstractD
     Image *image = instance_data.image;
     LISTBASE_FOREACH (ImageTile *, image_tile_ptr, &image->tiles) {
       const ImageTileWrapper image_tile(image_tile_ptr);
+      /* When drawing repeated the first tile covers the whole texture. */
+      if (!instance_data.flags.do_tile_drawing && !is_tile_visible(info, image_tile)) {
+        continue;
+      }
       tile_user.tile = image_tile.get_tile_number();
 
       ImBuf *tile_buffer = BKE_image_acquire_ibuf(image, &tile_user, &lock);
@@ -243,6 +243,18 @@ DRWShadingGroup *workbench_image_setup_ex(WORKBENCH_PrivateData *wpd,
     workbench_material_get_image(ob, mat_nr, &ima, &iuser, &sampler);
   }
 
+  const bool infront = (ob->dtx & OB_DRAW_IN_FRONT) != 0;
+  const bool transp = wpd->shading.xray_alpha < 1.0f;
+  WORKBENCH_Prepass *prepass = &wpd->prepass[transp][infront][datatype];
+
+  DRWShadingGroup **grp_tex = NULL;
+  /* A hash-map stores image shgroups to pack all similar drawcalls together.
+   * An image only has one GPU texture per redraw, so the shgroup is looked up from the image
+   * first, to only query the GPU texture once for all the objects using it. */
+  if (ima && BLI_ghash_ensure_p(prepass->material_hash, ima, (void ***)&grp_tex)) {
+    return *grp_tex;
+  }
+
   if (ima) {
     if (ima->source == IMA_SRC_TILED) {
       tex = BKE_image_get_gpu_tiles(ima, iuser, NULL);
@@ -257,13 +269,7 @@ DRWShadingGroup *workbench_image_setup_ex(WORKBENCH_PrivateData *wpd,
     tex = wpd->dummy_image_tx;
   }
 
-  const bool infront = (ob->dtx & OB_DRAW_IN_FRONT) != 0;
-  const bool transp = wpd->shading.xray_alpha < 1.0f;
-  WORKBENCH_Prepass *prepass = &wpd->prepass[transp][infront][datatype];
-
-  DRWShadingGroup **grp_tex = NULL;
-  /* A hash-map stores image shgroups to pack all similar drawcalls together. */
-  if (BLI_ghash_ensure_p(prepass->material_hash, tex, (void ***)&grp_tex)) {
+  if (ima == NULL && BLI_ghash_ensure_p(prepass->material_hash, tex, (void ***)&grp_tex)) {
     return *grp_tex;
   }
 
@@ -245,6 +245,7 @@ typedef struct MeshExtractLooseGeom {
  * Data that are kept around between extractions to reduce rebuilding time.
  *
  * - Loose geometry.
+ * - Topology uploaded for the GPU extraction.
  */
 typedef struct MeshBufferCache {
   MeshBufferList buff;
@@ -256,6 +257,14 @@ typedef struct MeshBufferCache {
     int *mat_tri_len;
     int visible_tri_len;
   } poly_sorted;
+
+  /* Loops, polygons and loose vertices used as input of the GPU extraction. They only depend on
+   * the topology, so they are kept when only the positions change. */
+  struct {
+    GPUVertBuf *loops;
+    GPUVertBuf *polys;
+    GPUVertBuf *loose_verts;
+  } gpu_topology;
 } MeshBufferCache;
 
 #define FOREACH_MESH_BUFFER_CACHE(batch_cache, mbc) \
@@ -690,6 +690,35 @@ static void mesh_buffer_cache_create_requested(struct TaskGraph *task_graph,
   mr->use_subsurf_fdots = use_subsurf_fdots;
   mr->use_final_mesh = do_final;
 
+  /* Build the position and normal buffers of large meshes with compute shaders. This has to
+   * happen here since it needs the GPU context, which the extraction tasks do not have. */
+  if (mesh_extract_gpu_supported(mr, do_hq_normals)) {
+    GPUVertBuf *pos_nor = DRW_vbo_requested(mbuflist->vbo.pos_nor) ? mbuflist->vbo.pos_nor :
+                                                                      nullptr;
+    GPUVertBuf *lnor = (DRW_vbo_requested(mbuflist->vbo.lnor) &&
+                        mesh_extract_gpu_lnor_supported(mr)) ?
+                           mbuflist->vbo.lnor :
+                           nullptr;
+    if (pos_nor || lnor) {
+      mesh_extract_gpu_pos_nor_lnor(mr, mbc, pos_nor, lnor);
+
+      ExtractorRunDatas cpu_extractors;
+      for (const ExtractorRunData &run_data : extractors) {
+        if ((pos_nor && run_data.extractor == &extract_pos_nor) ||
+            (lnor && run_data.extractor == &extract_lnor)) {
+          continue;
+        }
+        cpu_extractors.append(run_data);
+      }
+      extractors = std::move(cpu_extractors);
+
+      if (extractors.is_empty()) {
+        mesh_render_data_free(mr);
+        return;
+      }
+    }
+  }
+
 #ifdef DEBUG_TIME
   double rdata_end = PIL_check_seconds_timer();
 #endif
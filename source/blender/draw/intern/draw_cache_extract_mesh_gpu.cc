@@ -0,0 +1,269 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. All rights reserved. */
+
+/** \file
+ * \ingroup draw
+ *
+ * \brief Extraction of Mesh data into VBO using compute shaders.
+ *
+ * The original vertex, loop and polygon arrays are uploaded as storage buffers and the position
+ * and normal buffers are built from them on the GPU, avoiding a CPU pass over all the loops and
+ * the upload of the resulting per loop data. The loops and polygons are only uploaded again when
+ * the topology changes, so a deforming mesh only uploads its vertices.
+ */
+
+#include "MEM_guardedalloc.h"
+
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+
+#include "BLI_math_base.h"
+
+#include "BKE_mesh.h"
+
+#include "GPU_capabilities.h"
+#include "GPU_compute.h"
+#include "GPU_shader.h"
+#include "GPU_state.h"
+
+#include "draw_cache_extract.h"
+#include "draw_shader.h"
+
+#include "mesh_extractors/extract_mesh.h"
+
+/* The shader reads the DNA arrays as they are. */
+BLI_STATIC_ASSERT(sizeof(MVert) == 4 * sizeof(uint32_t), "MVert size mismatch");
+BLI_STATIC_ASSERT(sizeof(MLoop) == 2 * sizeof(uint32_t), "MLoop size mismatch");
+BLI_STATIC_ASSERT(sizeof(MPoly) == 3 * sizeof(uint32_t), "MPoly size mismatch");
+
+/* Uploading the topology does not pay off for small meshes. */
+#define MESH_EXTRACT_GPU_MIN_LOOP_LEN (1 << 16)
+
+#define MESH_EXTRACT_GPU_LOCAL_WORK_GROUP_SIZE 64
+
+/* Number of storage buffers used by `common_mesh_extract_comp.glsl`. */
+#define MESH_EXTRACT_GPU_SSBO_LEN 7
+
+namespace blender::draw {
+
+/* ---------------------------------------------------------------------- */
+/** \name Buffers
+ * \{ */
+
+static GPUVertFormat *get_pos_nor_format()
+{
+  static GPUVertFormat format = {0};
+  if (format.attr_len == 0) {
+    /* WARNING: Must match the format of #extract_pos_nor. */
+    GPU_vertformat_attr_add(&format, "pos", GPU_COMP_F32, 3, GPU_FETCH_FLOAT);
+    GPU_vertformat_attr_add(&format, "nor", GPU_COMP_I10, 4, GPU_FETCH_INT_TO_FLOAT_UNIT);
+    GPU_vertformat_alias_add(&format, "vnor");
+  }
+  return &format;
+}
+
+static GPUVertFormat *get_lnor_format()
+{
+  static GPUVertFormat format = {0};
+  if (format.attr_len == 0) {
+    /* WARNING: Must match the format of #extract_lnor. */
+    GPU_vertformat_attr_add(&format, "nor", GPU_COMP_I10, 4, GPU_FETCH_INT_TO_FLOAT_UNIT);
+    GPU_vertformat_alias_add(&format, "lnor");
+  }
+  return &format;
+}
+
+/**
+ * Create a buffer only meant to be bound as a storage buffer, holding `len` elements of
+ * `comp_len` 32-bit values each.
+ */
+static GPUVertBuf *gpu_storage_buffer_create(const void *data, const int len, const int comp_len)
+{
+  GPUVertFormat format = {0};
+  GPU_vertformat_attr_add(&format, "data", GPU_COMP_U32, comp_len, GPU_FETCH_INT);
+
+  GPUVertBuf *vbo = GPU_vertbuf_create_with_format_ex(&format, GPU_USAGE_STATIC);
+  GPU_vertbuf_data_alloc(vbo, len);
+  memcpy(GPU_vertbuf_get_data(vbo), data, sizeof(uint32_t) * comp_len * len);
+  return vbo;
+}
+
+static void mesh_extract_gpu_topology_ensure(MeshRenderData *mr, MeshBufferCache *mbc)
+{
+  if (mbc->gpu_topology.loops == nullptr) {
+    mbc->gpu_topology.loops = gpu_storage_buffer_create(mr->mloop, mr->loop_len, 2);
+  }
+  if (mbc->gpu_topology.polys == nullptr) {
+    mbc->gpu_topology.polys = gpu_storage_buffer_create(mr->mpoly, mr->poly_len, 3);
+  }
+}
+
+static void mesh_extract_gpu_loose_verts_ensure(MeshRenderData *mr, MeshBufferCache *mbc)
+{
+  mesh_render_data_update_loose_geom(mr, mbc, MR_ITER_LEDGE | MR_ITER_LVERT, MR_DATA_NONE);
+
+  if (mr->loop_loose_len == 0 || mbc->gpu_topology.loose_verts != nullptr) {
+    return;
+  }
+
+  /* Same order as the CPU extraction: both vertices of every loose edge, then the loose
+   * vertices. */
+  uint32_t *loose_verts = static_cast<uint32_t *>(
+      MEM_mallocN(sizeof(uint32_t) * mr->loop_loose_len, __func__));
+  for (int i = 0; i < mr->edge_loose_len; i++) {
+    const MEdge *med = &mr->medge[mr->ledges[i]];
+    loose_verts[i * 2] = med->v1;
+    loose_verts[i * 2 + 1] = med->v2;
+  }
+  for (int i = 0; i < mr->vert_loose_len; i++) {
+    loose_verts[mr->edge_loose_len * 2 + i] = mr->lverts[i];
+  }
+
+  mbc->gpu_topology.loose_verts = gpu_storage_buffer_create(loose_verts, mr->loop_loose_len, 1);
+  MEM_freeN(loose_verts);
+}
+
+/** \} */
+
+/* ---------------------------------------------------------------------- */
+/** \name Dispatch
+ * \{ */
+
+static void mesh_extract_gpu_dispatch(GPUShader *shader, const uint total_dispatch_size)
+{
+  const uint max_res_x = static_cast<uint>(GPU_max_work_group_count(0));
+
+  const uint dispatch_size = divide_ceil_u(total_dispatch_size,
+                                           MESH_EXTRACT_GPU_LOCAL_WORK_GROUP_SIZE);
+  uint dispatch_rx = dispatch_size;
+  uint dispatch_ry = 1u;
+  if (dispatch_rx > max_res_x) {
+    /* Split the work groups in two dimensions, the same way as for GPU subdivision. */
+    dispatch_rx = dispatch_ry = ceilf(sqrtf(dispatch_size));
+    /* Avoid a completely empty dispatch line caused by rounding. */
+    if ((dispatch_rx * (dispatch_ry - 1)) >= dispatch_size) {
+      dispatch_ry -= 1;
+    }
+  }
+  BLI_assert(dispatch_ry < static_cast<uint>(GPU_max_work_group_count(1)));
+
+  GPU_shader_uniform_1i(shader, "total_dispatch_size", static_cast<int>(total_dispatch_size));
+  GPU_compute_dispatch(shader, dispatch_rx, dispatch_ry, 1);
+}
+
+/** \} */
+
+/* ---------------------------------------------------------------------- */
+/** \name Extraction
+ * \{ */
+
+static void mesh_extract_gpu_pos_nor_lnor(MeshRenderData *mr,
+                                          MeshBufferCache *mbc,
+                                          GPUVertBuf *pos_nor,
+                                          GPUVertBuf *lnor)
+{
+  BLI_assert(pos_nor || lnor);
+
+  mesh_extract_gpu_topology_ensure(mr, mbc);
+  if (pos_nor) {
+    mesh_extract_gpu_loose_verts_ensure(mr, mbc);
+  }
+
+  /* Vertex normals are cached on the mesh, and are needed by other extractors anyway. */
+  mr->vert_normals = BKE_mesh_vertex_normals_ensure(mr->me);
+
+  GPUVertBuf *verts = gpu_storage_buffer_create(mr->mvert, mr->vert_len, 4);
+  GPUVertBuf *vert_normals = gpu_storage_buffer_create(mr->vert_normals, mr->vert_len, 3);
+
+  if (pos_nor) {
+    GPU_vertbuf_init_build_on_device(
+        pos_nor, get_pos_nor_format(), mr->loop_len + mr->loop_loose_len);
+  }
+  if (lnor) {
+    GPU_vertbuf_init_build_on_device(lnor, get_lnor_format(), mr->loop_len);
+  }
+
+  if (mr->poly_len > 0) {
+    const eMeshExtractShaderType sh_type = (pos_nor && lnor) ? MESH_EXTRACT_SHADER_POS_NOR_LNOR :
+                                           (pos_nor)         ? MESH_EXTRACT_SHADER_POS_NOR :
+                                                               MESH_EXTRACT_SHADER_LNOR;
+    GPUShader *shader = DRW_shader_mesh_extract_get(sh_type);
+    GPU_shader_bind(shader);
+
+    GPU_vertbuf_bind_as_ssbo(verts, 0);
+    GPU_vertbuf_bind_as_ssbo(mbc->gpu_topology.loops, 1);
+    GPU_vertbuf_bind_as_ssbo(mbc->gpu_topology.polys, 2);
+    GPU_vertbuf_bind_as_ssbo(vert_normals, 3);
+    if (pos_nor) {
+      GPU_vertbuf_bind_as_ssbo(pos_nor, 5);
+    }
+    if (lnor) {
+      GPU_vertbuf_bind_as_ssbo(lnor, 6);
+    }
+
+    /* One invocation per polygon. */
+    mesh_extract_gpu_dispatch(shader, mr->poly_len);
+  }
+
+  if (pos_nor && mr->loop_loose_len > 0) {
+    GPUShader *shader = DRW_shader_mesh_extract_get(MESH_EXTRACT_SHADER_LOOSE_GEOM);
+    GPU_shader_bind(shader);
+
+    GPU_vertbuf_bind_as_ssbo(verts, 0);
+    GPU_vertbuf_bind_as_ssbo(vert_normals, 3);
+    GPU_vertbuf_bind_as_ssbo(mbc->gpu_topology.loose_verts, 4);
+    GPU_vertbuf_bind_as_ssbo(pos_nor, 5);
+
+    GPU_shader_uniform_1i(shader, "loop_len", mr->loop_len);
+    mesh_extract_gpu_dispatch(shader, mr->loop_loose_len);
+  }
+
+  /* This generates vertex buffers, so we need to put a barrier on the vertex attribute array. */
+  GPU_memory_barrier(GPU_BARRIER_SHADER_STORAGE | GPU_BARRIER_VERTEX_ATTRIB_ARRAY);
+
+  /* Cleanup. */
+  GPU_shader_unbind();
+
+  GPU_vertbuf_discard(verts);
+  GPU_vertbuf_discard(vert_normals);
+}
+
+/** \} */
+
+}  // namespace blender::draw
+
+extern "C" {
+
+bool mesh_extract_gpu_supported(const MeshRenderData *mr, const bool do_hq_normals)
+{
+  if (!GPU_compute_shader_support() || !GPU_shader_storage_buffer_objects_support() ||
+      GPU_max_shader_storage_buffer_bindings() < MESH_EXTRACT_GPU_SSBO_LEN) {
+    return false;
+  }
+  /* High quality normals use a different packing. */
+  if (do_hq_normals) {
+    return false;
+  }
+  /* Mapped meshes need the original indices to flag the hidden elements, and edit-meshes are
+   * extracted from the #BMesh. */
+  if (mr->extract_type != MR_EXTRACT_MESH) {
+    return false;
+  }
+  return mr->loop_len >= MESH_EXTRACT_GPU_MIN_LOOP_LEN;
+}
+
+bool mesh_extract_gpu_lnor_supported(const MeshRenderData *mr)
+{
+  /* Split normals are computed on the CPU. */
+  return (mr->me->flag & ME_AUTOSMOOTH) == 0;
+}
+
+void mesh_extract_gpu_pos_nor_lnor(MeshRenderData *mr,
+                                   MeshBufferCache *mbc,
+                                   GPUVertBuf *pos_nor,
+                                   GPUVertBuf *lnor)
+{
+  blender::draw::mesh_extract_gpu_pos_nor_lnor(mr, mbc, pos_nor, lnor);
+}
+
+}  // extern "C"
@@ -17,6 +17,7 @@
 #include "BLI_math_vector.h"
 #include "BLI_math_vector.hh"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_curves_types.h"
@@ -32,7 +33,9 @@
 #include "draw_hair_private.h" /* own include */
 
 using blender::float3;
+using blender::float4;
 using blender::IndexRange;
+using blender::MutableSpan;
 using blender::Span;
 
 static void curves_batch_cache_clear(Curves *curves);
@@ -128,8 +131,8 @@ static void ensure_seg_pt_count(Curves *curves, ParticleHairCache *curves_cache)
 }
 
 static void curves_batch_cache_fill_segments_proc_pos(Curves *curves,
-                                                      GPUVertBufRaw *attr_step,
-                                                      GPUVertBufRaw *length_step)
+                                                      MutableSpan<float4> posTime_data,
+                                                      MutableSpan<float> hairLength_data)
 {
   /* TODO: use hair radius layer if available. */
   const int curve_size = curves->geometry.curve_size;
@@ -137,34 +140,31 @@ static void curves_batch_cache_fill_segments_proc_pos(Curves *curves,
       curves->geometry);
   Span<float3> positions = geometry.positions();
 
-  for (const int i : IndexRange(curve_size)) {
-    const IndexRange curve_range = geometry.range_for_curve(i);
-
-    Span<float3> curve_positions = positions.slice(curve_range);
-    float total_len = 0.0f;
-    float *seg_data_first;
-    for (const int i_curve : curve_positions.index_range()) {
-      float *seg_data = (float *)GPU_vertbuf_raw_step(attr_step);
-      copy_v3_v3(seg_data, curve_positions[i_curve]);
-      if (i_curve == 0) {
-        seg_data_first = seg_data;
+  /* This runs again after every change of the positions, e.g. for every sculpt step. */
+  blender::threading::parallel_for(IndexRange(curve_size), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const IndexRange curve_range = geometry.range_for_curve(i);
+
+      Span<float3> curve_positions = positions.slice(curve_range);
+      MutableSpan<float4> curve_posTime_data = posTime_data.slice(curve_range);
+      float total_len = 0.0f;
+      for (const int i_curve : curve_positions.index_range()) {
+        if (i_curve > 0) {
+          total_len += blender::math::distance(curve_positions[i_curve - 1],
+                                               curve_positions[i_curve]);
+        }
+        curve_posTime_data[i_curve] = float4(curve_positions[i_curve], total_len);
       }
-      else {
-        total_len += blender::math::distance(curve_positions[i_curve - 1],
-                                             curve_positions[i_curve]);
+      /* Assign length value. */
+      hairLength_data[i] = total_len;
+      if (total_len > 0.0f) {
+        /* Divide by total length to have a [0-1] number. */
+        for (float4 &point_posTime : curve_posTime_data) {
+          point_posTime.w /= total_len;
+        }
       }
-      seg_data[3] = total_len;
     }
-    /* Assign length value. */
-    *(float *)GPU_vertbuf_raw_step(length_step) = total_len;
-    if (total_len > 0.0f) {
-      /* Divide by total length to have a [0-1] number. */
-      for ([[maybe_unused]] const int i_curve : curve_positions.index_range()) {
-        seg_data_first[3] /= total_len;
-        seg_data_first += 4;
-      }
-    }
-  }
+  });
 }
 
 static void curves_batch_cache_ensure_procedural_pos(Curves *curves,
@@ -174,25 +174,24 @@ static void curves_batch_cache_ensure_procedural_pos(Curves *curves,
   if (cache->proc_point_buf == nullptr) {
     /* initialize vertex format */
     GPUVertFormat format = {0};
-    uint pos_id = GPU_vertformat_attr_add(&format, "posTime", GPU_COMP_F32, 4, GPU_FETCH_FLOAT);
+    GPU_vertformat_attr_add(&format, "posTime", GPU_COMP_F32, 4, GPU_FETCH_FLOAT);
 
     cache->proc_point_buf = GPU_vertbuf_create_with_format(&format);
     GPU_vertbuf_data_alloc(cache->proc_point_buf, cache->point_len);
 
-    GPUVertBufRaw point_step;
-    GPU_vertbuf_attr_get_raw_data(cache->proc_point_buf, pos_id, &point_step);
+    MutableSpan<float4> posTime_data{
+        static_cast<float4 *>(GPU_vertbuf_get_data(cache->proc_point_buf)), cache->point_len};
 
     GPUVertFormat length_format = {0};
-    uint length_id = GPU_vertformat_attr_add(
-        &length_format, "hairLength", GPU_COMP_F32, 1, GPU_FETCH_FLOAT);
+    GPU_vertformat_attr_add(&length_format, "hairLength", GPU_COMP_F32, 1, GPU_FETCH_FLOAT);
 
     cache->proc_length_buf = GPU_vertbuf_create_with_format(&length_format);
     GPU_vertbuf_data_alloc(cache->proc_length_buf, cache->strands_len);
 
-    GPUVertBufRaw length_step;
-    GPU_vertbuf_attr_get_raw_data(cache->proc_length_buf, length_id, &length_step);
+    MutableSpan<float> hairLength_data{
+        static_cast<float *>(GPU_vertbuf_get_data(cache->proc_length_buf)), cache->strands_len};
 
-    curves_batch_cache_fill_segments_proc_pos(curves, &point_step, &length_step);
+    curves_batch_cache_fill_segments_proc_pos(curves, posTime_data, hairLength_data);
 
     /* Create vbo immediately to bind to texture buffer. */
     GPU_vertbuf_use(cache->proc_point_buf);
@@ -212,41 +211,45 @@ static void curves_batch_cache_ensure_procedural_pos(Curves *curves,
 }
 
 static void curves_batch_cache_fill_strands_data(Curves *curves,
-                                                 GPUVertBufRaw *data_step,
-                                                 GPUVertBufRaw *seg_step)
+                                                 MutableSpan<uint> strand_data,
+                                                 MutableSpan<ushort> strand_seg_data)
 {
   const blender::bke::CurvesGeometry &geometry = blender::bke::CurvesGeometry::wrap(
       curves->geometry);
 
-  for (const int i : IndexRange(geometry.curves_size())) {
-    const IndexRange curve_range = geometry.range_for_curve(i);
+  blender::threading::parallel_for(
+      IndexRange(geometry.curves_size()), 4096, [&](const IndexRange range) {
+        for (const int i : range) {
+          const IndexRange curve_range = geometry.range_for_curve(i);
 
-    *(uint *)GPU_vertbuf_raw_step(data_step) = curve_range.start();
-    *(ushort *)GPU_vertbuf_raw_step(seg_step) = curve_range.size() - 1;
-  }
+          strand_data[i] = curve_range.start();
+          strand_seg_data[i] = curve_range.size() - 1;
+        }
+      });
 }
 
 static void curves_batch_cache_ensure_procedural_strand_data(Curves *curves,
                                                              ParticleHairCache *cache)
 {
-  GPUVertBufRaw data_step, seg_step;
-
   GPUVertFormat format_data = {0};
-  uint data_id = GPU_vertformat_attr_add(&format_data, "data", GPU_COMP_U32, 1, GPU_FETCH_INT);
+  GPU_vertformat_attr_add(&format_data, "data", GPU_COMP_U32, 1, GPU_FETCH_INT);
 
   GPUVertFormat format_seg = {0};
-  uint seg_id = GPU_vertformat_attr_add(&format_seg, "data", GPU_COMP_U16, 1, GPU_FETCH_INT);
+  GPU_vertformat_attr_add(&format_seg, "data", GPU_COMP_U16, 1, GPU_FETCH_INT);
 
   /* Strand Data */
   cache->proc_strand_buf = GPU_vertbuf_create_with_format(&format_data);
   GPU_vertbuf_data_alloc(cache->proc_strand_buf, cache->strands_len);
-  GPU_vertbuf_attr_get_raw_data(cache->proc_strand_buf, data_id, &data_step);
+  MutableSpan<uint> strand_data{static_cast<uint *>(GPU_vertbuf_get_data(cache->proc_strand_buf)),
+                              cache->strands_len};
 
   cache->proc_strand_seg_buf = GPU_vertbuf_create_with_format(&format_seg);
   GPU_vertbuf_data_alloc(cache->proc_strand_seg_buf, cache->strands_len);
-  GPU_vertbuf_attr_get_raw_data(cache->proc_strand_seg_buf, seg_id, &seg_step);
+  MutableSpan<ushort> strand_seg_data{
+      static_cast<ushort *>(GPU_vertbuf_get_data(cache->proc_strand_seg_buf)),
+      cache->strands_len};
 
-  curves_batch_cache_fill_strands_data(curves, &data_step, &seg_step);
+  curves_batch_cache_fill_strands_data(curves, strand_data, strand_seg_data);
 
   /* Create vbo immediately to bind to texture buffer. */
   GPU_vertbuf_use(cache->proc_strand_buf);
@@ -1010,6 +1010,37 @@ void DRW_mesh_batch_cache_dirty_tag(Mesh *me, eMeshBatchDirtyMode mode)
       batch_map = BATCH_MAP(vbo.edituv_data, vbo.fdots_edituv_data);
       mesh_batch_cache_discard_batch(cache, batch_map);
       break;
+    case BKE_MESH_BATCH_DIRTY_DEFORM:
+      if (cache->subdiv_cache) {
+        /* GPU subdivision derives all buffers from the coarse positions. */
+        cache->is_dirty = true;
+        break;
+      }
+      /* Only discard buffers depending on positions, index buffers and attributes stay. */
+      FOREACH_MESH_BUFFER_CACHE (cache, mbc) {
+        GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.pos_nor);
+        GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.lnor);
+        GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.tan);
+        GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edge_fac);
+        GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edituv_stretch_area);
+        GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edituv_stretch_angle);
+        GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.mesh_analysis);
+        GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.fdots_pos);
+        GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.fdots_nor);
+        GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.skin_roots);
+      }
+      batch_map = BATCH_MAP(vbo.pos_nor,
+                            vbo.lnor,
+                            vbo.tan,
+                            vbo.edge_fac,
+                            vbo.edituv_stretch_area,
+                            vbo.edituv_stretch_angle,
+                            vbo.mesh_analysis,
+                            vbo.fdots_pos,
+                            vbo.fdots_nor,
+                            vbo.skin_roots);
+      mesh_batch_cache_discard_batch(cache, batch_map);
+      break;
     default:
       BLI_assert(0);
   }
@@ -1039,6 +1070,10 @@ static void mesh_buffer_cache_clear(MeshBufferCache *mbc)
   MEM_SAFE_FREE(mbc->poly_sorted.tri_first_index);
   MEM_SAFE_FREE(mbc->poly_sorted.mat_tri_len);
   mbc->poly_sorted.visible_tri_len = 0;
+
+  GPU_VERTBUF_DISCARD_SAFE(mbc->gpu_topology.loops);
+  GPU_VERTBUF_DISCARD_SAFE(mbc->gpu_topology.polys);
+  GPU_VERTBUF_DISCARD_SAFE(mbc->gpu_topology.loose_verts);
 }
 
 static void mesh_batch_cache_free_subdiv_cache(MeshBatchCache *cache)
@@ -43,6 +43,7 @@
 #include "DNA_camera_types.h"
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
+#include "DNA_object_force_types.h"
 #include "DNA_world_types.h"
 #include "draw_manager.h"
 
@@ -62,6 +63,8 @@
 
 #include "IMB_colormanagement.h"
 
+#include "PIL_time.h"
+
 #include "RE_engine.h"
 #include "RE_pipeline.h"
 
@@ -1016,6 +1019,7 @@ static void drw_engines_cache_init(void)
     if (DST.text_store_p == NULL) {
       DST.text_store_p = &data->text_draw_cache;
     }
+    data->cache_populate_time = 0.0;
 
     if (engine->cache_init) {
       engine->cache_init(data);
@@ -1051,20 +1055,30 @@ static void drw_engines_cache_populate(Object *ob)
     drw_batch_cache_validate(ob);
   }
 
+  const bool do_trace = DRW_stats_trace_is_enabled();
+
   DRW_ENABLED_ENGINE_ITER (DST.view_data_active, engine, data) {
     if (engine->id_update) {
       engine->id_update(data, &ob->id);
     }
 
     if (engine->cache_populate) {
+      const double time_start = do_trace ? PIL_check_seconds_timer() : 0.0;
       engine->cache_populate(data, ob);
+      if (do_trace) {
+        data->cache_populate_time += (PIL_check_seconds_timer() - time_start) * 1e3;
+      }
     }
   }
 
   /* TODO: in the future it would be nice to generate once for all viewports.
    * But we need threaded DRW manager first. */
   if (!DST.dupli_source) {
+    const double time_start = do_trace ? PIL_check_seconds_timer() : 0.0;
     drw_batch_cache_generate_requested(ob);
+    if (do_trace) {
+      DRW_stats_trace_batch_cache_add(ob, (PIL_check_seconds_timer() - time_start) * 1e3);
+    }
   }
 
   /* ... and clearing it here too because this draw data is
@@ -1654,6 +1668,7 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
 
   /* Cache filling */
   {
+    const eMEM_Category mem_category = MEM_category_set(MEM_CATEGORY_DRAW);
     PROFILE_START(stime);
     drw_engines_cache_init();
     drw_engines_world_update(scene);
@@ -1680,12 +1695,19 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
     drw_duplidata_free();
     drw_engines_cache_finish();
 
+    const double wait_time_start = PIL_check_seconds_timer();
     drw_task_graph_deinit();
+    const double wait_time_end = PIL_check_seconds_timer();
     DRW_render_instance_buffer_finish();
+    MEM_category_set(mem_category);
 
 #ifdef USE_PROFILE
     double *cache_time = DRW_view_data_cache_time_get(DST.view_data_active);
     PROFILE_END_UPDATE(*cache_time, stime);
+    if (DRW_stats_trace_is_enabled()) {
+      DRW_stats_trace_cache_time_set((PIL_check_seconds_timer() - stime) * 1e3,
+                                     (wait_time_end - wait_time_start) * 1e3);
+    }
 #endif
   }
 
@@ -2282,6 +2304,31 @@ void DRW_render_set_time(RenderEngine *engine, Depsgraph *depsgraph, int frame,
   DST.draw_ctx.view_layer = DEG_get_evaluated_view_layer(depsgraph);
 }
 
+/**
+ * Test if a mesh object can be drawn in the select region at all, to skip creating the draw calls
+ * of the objects that are culled anyway. Only done when everything drawn for the object is
+ * inside its bounding box.
+ */
+static bool drw_select_object_is_culled(Object *ob)
+{
+  if (ob->type != OB_MESH || ob->mode != OB_MODE_OBJECT || (ob->base_flag & BASE_FROM_DUPLI)) {
+    return false;
+  }
+  /* Bounds can be displayed as other shapes, larger than the bounding box. */
+  if ((ob->dt == OB_BOUNDBOX) || (ob->dtx & (OB_DRAWBOUNDOX | OB_AXIS | OB_TEXSPACE)) ||
+      (ob->pd && ob->pd->forcefield) || !BLI_listbase_is_empty(&ob->particlesystem)) {
+    return false;
+  }
+  const BoundBox *bb = BKE_object_boundbox_get(ob);
+  if (bb == NULL) {
+    return false;
+  }
+  float min[3], max[3];
+  copy_v3_v3(min, bb->vec[0]);
+  copy_v3_v3(max, bb->vec[6]);
+  return !DRW_culling_min_max_test(DST.view_default, ob->obmat, min, max);
+}
+
 void DRW_draw_select_loop(struct Depsgraph *depsgraph,
                           ARegion *region,
                           View3D *v3d,
@@ -2449,6 +2496,10 @@ void DRW_draw_select_loop(struct Depsgraph *depsgraph,
             }
           }
 
+          if (drw_select_object_is_culled(ob)) {
+            continue;
+          }
+
           DRW_select_load_id(ob->runtime.select_id);
           DST.dupli_parent = data_.dupli_parent;
           DST.dupli_source = data_.dupli_object_current;
@@ -26,6 +26,7 @@
 #include "BLI_listbase.h"
 #include "BLI_memblock.h"
 #include "BLI_mempool.h"
+#include "BLI_task.h"
 
 #ifdef DRW_DEBUG_CULLING
 #  include "BLI_math_bits.h"
@@ -72,6 +73,50 @@ static void draw_call_sort(DRWCommand *array, DRWCommand *array_tmp, int array_l
   memcpy(array, array_tmp, sizeof(*array) * array_len);
 }
 
+typedef struct DRWCommandSortTLS {
+  /* Lazily allocated, since most chunks are not sortable. */
+  DRWCommandChunk *chunk_tmp;
+} DRWCommandSortTLS;
+
+static void draw_command_chunk_iter_step(void *__restrict userdata,
+                                         const TaskParallelTLS *__restrict UNUSED(tls),
+                                         void **r_next_item,
+                                         int *UNUSED(r_next_index),
+                                         bool *r_do_abort)
+{
+  BLI_memblock_iter *iter = (BLI_memblock_iter *)userdata;
+  *r_next_item = BLI_memblock_iterstep(iter);
+  *r_do_abort = (*r_next_item == NULL);
+}
+
+static void draw_command_chunk_sort_cb(void *__restrict UNUSED(userdata),
+                                       void *item,
+                                       int UNUSED(index),
+                                       const TaskParallelTLS *__restrict tls)
+{
+  DRWCommandChunk *chunk = (DRWCommandChunk *)item;
+  /* We can only sort chunks that contain #DRWCommandDraw only. */
+  for (int i = 0; i < ARRAY_SIZE(chunk->command_type); i++) {
+    if (chunk->command_type[i] != 0) {
+      return;
+    }
+  }
+
+  DRWCommandSortTLS *sort_tls = (DRWCommandSortTLS *)tls->userdata_chunk;
+  if (sort_tls->chunk_tmp == NULL) {
+    /* Aligned alloc to avoid unaligned memcpy. */
+    sort_tls->chunk_tmp = MEM_mallocN_aligned(sizeof(DRWCommandChunk), 16, "tmp call chunk");
+  }
+  draw_call_sort(chunk->commands, sort_tls->chunk_tmp->commands, chunk->command_used);
+}
+
+static void draw_command_chunk_sort_free(const void *__restrict UNUSED(userdata),
+                                         void *__restrict userdata_chunk)
+{
+  DRWCommandSortTLS *sort_tls = (DRWCommandSortTLS *)userdata_chunk;
+  MEM_SAFE_FREE(sort_tls->chunk_tmp);
+}
+
 void drw_resource_buffer_finish(DRWData *vmempool)
 {
   int chunk_id = DRW_handle_chunk_get(&DST.resource_handle);
@@ -116,24 +161,28 @@ void drw_resource_buffer_finish(DRWData *vmempool)
 
   DRW_uniform_attrs_pool_flush_all(vmempool->obattrs_ubo_pool);
 
-  /* Aligned alloc to avoid unaligned memcpy. */
-  DRWCommandChunk *chunk_tmp = MEM_mallocN_aligned(sizeof(DRWCommandChunk), 16, "tmp call chunk");
-  DRWCommandChunk *chunk;
+  /* Chunks are sorted independently, so spread them over all threads. This matters for scenes
+   * with many objects, where each chunk is filled with draw calls. */
   BLI_memblock_iter iter;
   BLI_memblock_iternew(vmempool->commands, &iter);
-  while ((chunk = BLI_memblock_iterstep(&iter))) {
-    bool sortable = true;
-    /* We can only sort chunks that contain #DRWCommandDraw only. */
-    for (int i = 0; i < ARRAY_SIZE(chunk->command_type) && sortable; i++) {
-      if (chunk->command_type[i] != 0) {
-        sortable = false;
-      }
-    }
-    if (sortable) {
-      draw_call_sort(chunk->commands, chunk_tmp->commands, chunk->command_used);
-    }
+  void *first_chunk = BLI_memblock_iterstep(&iter);
+  if (first_chunk == NULL) {
+    return;
   }
-  MEM_freeN(chunk_tmp);
+
+  DRWCommandSortTLS sort_tls = {NULL};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.userdata_chunk = &sort_tls;
+  settings.userdata_chunk_size = sizeof(sort_tls);
+  settings.func_free = draw_command_chunk_sort_free;
+  BLI_task_parallel_iterator(&iter,
+                             draw_command_chunk_iter_step,
+                             first_chunk,
+                             0,
+                             -1,
+                             draw_command_chunk_sort_cb,
+                             &settings);
 }
 
 /** \} */
@@ -11,6 +11,7 @@
 #include "BLI_math.h"
 #include "BLI_math_bits.h"
 #include "BLI_memblock.h"
+#include "BLI_task.h"
 
 #include "BKE_global.h"
 
@@ -461,47 +462,72 @@ void DRW_culling_frustum_planes_get(const DRWView *view, float planes[6][4])
   memcpy(planes, view->frustum_planes, sizeof(float[6][4]));
 }
 
+static void draw_culling_state_update(const DRWView *view, DRWCullingState *cull)
+{
+  if (cull->bsphere.radius < 0.0) {
+    cull->mask = 0;
+  }
+  else {
+    bool culled = !draw_culling_sphere_test(
+        &view->frustum_bsphere, view->frustum_planes, &cull->bsphere);
+
+#ifdef DRW_DEBUG_CULLING
+    if (G.debug_value != 0) {
+      if (culled) {
+        DRW_debug_sphere(
+            cull->bsphere.center, cull->bsphere.radius, (const float[4]){1, 0, 0, 1});
+      }
+      else {
+        DRW_debug_sphere(
+            cull->bsphere.center, cull->bsphere.radius, (const float[4]){0, 1, 0, 1});
+      }
+    }
+#endif
+
+    if (view->visibility_fn) {
+      culled = !view->visibility_fn(!culled, cull->user_data);
+    }
+
+    SET_FLAG_FROM_TEST(cull->mask, culled, view->culling_mask);
+  }
+}
+
+static void draw_compute_culling_cb(void *__restrict userdata,
+                                    const int index,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const DRWView *view = (const DRWView *)userdata;
+  DRWCullingState *cull = BLI_memblock_elem_get(
+      DST.vmempool->cullstates, index / DRW_RESOURCE_CHUNK_LEN, index % DRW_RESOURCE_CHUNK_LEN);
+  draw_culling_state_update(view, cull);
+}
+
 static void draw_compute_culling(DRWView *view)
 {
   view = view->parent ? view->parent : view;
 
-  /* TODO(fclem): multi-thread this. */
   /* TODO(fclem): compute all dirty views at once. */
   if (!view->is_dirty) {
     return;
   }
 
-  BLI_memblock_iter iter;
-  BLI_memblock_iternew(DST.vmempool->cullstates, &iter);
-  DRWCullingState *cull;
-  while ((cull = BLI_memblock_iterstep(&iter))) {
-    if (cull->bsphere.radius < 0.0) {
-      cull->mask = 0;
-    }
-    else {
-      bool culled = !draw_culling_sphere_test(
-          &view->frustum_bsphere, view->frustum_planes, &cull->bsphere);
+  /* Culling states are allocated along with the resource handles, so the current handle gives
+   * their number. Every state only stores the visibility bit of this view, so they can be
+   * updated in parallel, which matters with many instances. */
+  const int cull_len = DRW_handle_chunk_get(&DST.resource_handle) * DRW_RESOURCE_CHUNK_LEN +
+                       DRW_handle_id_get(&DST.resource_handle);
 
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = DRW_RESOURCE_CHUNK_LEN;
 #ifdef DRW_DEBUG_CULLING
-      if (G.debug_value != 0) {
-        if (culled) {
-          DRW_debug_sphere(
-              cull->bsphere.center, cull->bsphere.radius, (const float[4]){1, 0, 0, 1});
-        }
-        else {
-          DRW_debug_sphere(
-              cull->bsphere.center, cull->bsphere.radius, (const float[4]){0, 1, 0, 1});
-        }
-      }
+  settings.use_threading = false;
 #endif
-
-      if (view->visibility_fn) {
-        culled = !view->visibility_fn(!culled, cull->user_data);
-      }
-
-      SET_FLAG_FROM_TEST(cull->mask, culled, view->culling_mask);
-    }
+  /* The visibility callbacks of the engines are not required to be thread-safe. */
+  if (view->visibility_fn) {
+    settings.use_threading = false;
   }
+  BLI_task_parallel_range(0, cull_len, view, draw_compute_culling_cb, &settings);
 
   view->is_dirty = false;
 }
@@ -5,10 +5,15 @@
  * \ingroup draw
  */
 
+#include <stdio.h>
+
+#include "BLI_fileops.h"
 #include "BLI_listbase.h"
+#include "BLI_path_util.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
 
+#include "BKE_appdir.h"
 #include "BKE_global.h"
 
 #include "BLF_api.h"
@@ -20,6 +25,8 @@
 #include "GPU_debug.h"
 #include "GPU_texture.h"
 
+#include "PIL_time.h"
+
 #include "UI_resources.h"
 
 #include "draw_manager_profiling.h"
@@ -29,9 +36,15 @@
 #define MIM_RANGE_LEN 8
 #define GPU_TIMER_FALLOFF 0.1
 
+/* Only report the objects whose batch generation takes longer than this (in milliseconds). */
+#define TRACE_BATCH_CACHE_MIN_TIME 0.05
+
 typedef struct DRWTimer {
   uint32_t query[2];
   uint64_t time_average;
+  /* Time spent on the CPU submitting the commands, in milliseconds. */
+  double cpu_time_start;
+  double cpu_time;
   char name[MAX_TIMER_NAME];
   int lvl;       /* Hierarchy level for nested timer. */
   bool is_query; /* Does this timer actually perform queries or is it just a group. */
@@ -47,6 +60,32 @@ static struct DRWTimerPool {
   bool is_querying;    /* Keep track of bad usage. */
 } DTP = {NULL};
 
+typedef struct DRWTraceBatchCache {
+  char name[MAX_ID_NAME - 2];
+  double time;
+} DRWTraceBatchCache;
+
+static struct DRWTrace {
+  FILE *file;
+  int frame;
+  double cache_time;
+  double batch_cache_wait_time;
+  DRWTraceBatchCache *batch_caches;
+  int batch_cache_len;
+  int batch_cache_alloc_len;
+} DTT = {NULL};
+
+static void drw_stats_trace_close(void)
+{
+  if (DTT.file != NULL) {
+    fclose(DTT.file);
+    DTT.file = NULL;
+  }
+  MEM_SAFE_FREE(DTT.batch_caches);
+  DTT.batch_cache_len = 0;
+  DTT.batch_cache_alloc_len = 0;
+}
+
 void DRW_stats_free(void)
 {
   if (DTP.timers != NULL) {
@@ -57,6 +96,7 @@ void DRW_stats_free(void)
     MEM_freeN(DTP.timers);
     DTP.timers = NULL;
   }
+  drw_stats_trace_close();
 }
 
 void DRW_stats_begin(void)
@@ -64,6 +104,12 @@ void DRW_stats_begin(void)
   if (G.debug_value > 20 && G.debug_value < 30) {
     DTP.is_recording = true;
   }
+  if (DRW_stats_trace_is_enabled()) {
+    DTP.is_recording = true;
+  }
+  else if (DTT.file != NULL) {
+    drw_stats_trace_close();
+  }
 
   if (DTP.is_recording && DTP.timers == NULL) {
     DTP.chunk_count = 1;
@@ -98,6 +144,7 @@ static void drw_stats_timer_start_ex(const char *name, const bool is_query)
     BLI_strncpy(timer->name, name, MAX_TIMER_NAME);
     timer->lvl = DTP.timer_increment - DTP.end_increment - 1;
     timer->is_query = is_query;
+    timer->cpu_time_start = PIL_check_seconds_timer();
 
     /* Queries cannot be nested or interleaved. */
     BLI_assert(!DTP.is_querying);
@@ -114,6 +161,20 @@ static void drw_stats_timer_start_ex(const char *name, const bool is_query)
   }
 }
 
+static void drw_stats_timer_end(void)
+{
+  /* The timer that ends is the last one started at the current level. */
+  const int lvl = DTP.timer_increment - DTP.end_increment - 1;
+  for (int i = DTP.timer_increment - 1; i >= 0; i--) {
+    DRWTimer *timer = &DTP.timers[i];
+    if (timer->lvl == lvl) {
+      timer->cpu_time = (PIL_check_seconds_timer() - timer->cpu_time_start) * 1e3;
+      break;
+    }
+  }
+  DTP.end_increment++;
+}
+
 void DRW_stats_group_start(const char *name)
 {
   drw_stats_timer_start_ex(name, false);
@@ -126,7 +187,7 @@ void DRW_stats_group_end(void)
   GPU_debug_group_end();
   if (DTP.is_recording) {
     BLI_assert(!DTP.is_querying);
-    DTP.end_increment++;
+    drw_stats_timer_end();
   }
 }
 
@@ -140,13 +201,130 @@ void DRW_stats_query_end(void)
 {
   GPU_debug_group_end();
   if (DTP.is_recording) {
-    DTP.end_increment++;
+    drw_stats_timer_end();
     BLI_assert(DTP.is_querying);
     // glEndQuery(GL_TIME_ELAPSED);
     DTP.is_querying = false;
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Frame Trace
+ * \{ */
+
+bool DRW_stats_trace_is_enabled(void)
+{
+  return (G.debug & G_DEBUG_DRAW_TRACE) != 0;
+}
+
+void DRW_stats_trace_batch_cache_add(const Object *ob, const double time)
+{
+  if (time < TRACE_BATCH_CACHE_MIN_TIME) {
+    return;
+  }
+  if (DTT.batch_cache_len == DTT.batch_cache_alloc_len) {
+    DTT.batch_cache_alloc_len = max_ii(DTT.batch_cache_alloc_len * 2, 64);
+    DTT.batch_caches = MEM_reallocN_id(DTT.batch_caches,
+                                       sizeof(*DTT.batch_caches) * DTT.batch_cache_alloc_len,
+                                       __func__);
+  }
+  DRWTraceBatchCache *batch_cache = &DTT.batch_caches[DTT.batch_cache_len++];
+  BLI_strncpy(batch_cache->name, ob->id.name + 2, sizeof(batch_cache->name));
+  batch_cache->time = time;
+}
+
+void DRW_stats_trace_cache_time_set(const double cache_time, const double batch_cache_wait_time)
+{
+  DTT.cache_time = cache_time;
+  DTT.batch_cache_wait_time = batch_cache_wait_time;
+}
+
+static void drw_stats_trace_write_string(FILE *file, const char *str)
+{
+  fputc('"', file);
+  for (const char *c = str; *c; c++) {
+    if (ELEM(*c, '"', '\\')) {
+      fputc('\\', file);
+      fputc(*c, file);
+    }
+    else if ((unsigned char)*c < 0x20) {
+      fprintf(file, "\\u%04x", *c);
+    }
+    else {
+      fputc(*c, file);
+    }
+  }
+  fputc('"', file);
+}
+
+static bool drw_stats_trace_open(void)
+{
+  if (DTT.file != NULL) {
+    return true;
+  }
+  char filepath[FILE_MAX];
+  BLI_join_dirfile(filepath, sizeof(filepath), BKE_tempdir_base(), "blender_draw_trace.jsonl");
+  DTT.file = BLI_fopen(filepath, "w");
+  if (DTT.file == NULL) {
+    printf("Draw trace: cannot open \"%s\", disabling the trace\n", filepath);
+    G.debug &= ~G_DEBUG_DRAW_TRACE;
+    return false;
+  }
+  printf("Draw trace: writing frames to \"%s\"\n", filepath);
+  DTT.frame = 0;
+  return true;
+}
+
+/**
+ * Write the timings of the current frame as a single line:
+ * `{"frame", "cache_ms", "batch_cache_wait_ms", "engines": [{"name", "cache_populate_ms"}],
+ * "batch_cache": [{"object", "ms"}], "passes": [{"name", "level", "cpu_ms"}]}`.
+ */
+static void drw_stats_trace_frame_write(void)
+{
+  if (!drw_stats_trace_open()) {
+    return;
+  }
+  FILE *file = DTT.file;
+
+  fprintf(file,
+          "{\"frame\": %d, \"cache_ms\": %.4f, \"batch_cache_wait_ms\": %.4f, \"engines\": [",
+          DTT.frame++,
+          DTT.cache_time,
+          DTT.batch_cache_wait_time);
+  bool first = true;
+  DRW_ENABLED_ENGINE_ITER (DST.view_data_active, engine, data) {
+    fprintf(file, first ? "{\"name\": " : ", {\"name\": ");
+    drw_stats_trace_write_string(file, engine->idname);
+    fprintf(file, ", \"cache_populate_ms\": %.4f}", data->cache_populate_time);
+    first = false;
+  }
+
+  fprintf(file, "], \"batch_cache\": [");
+  for (int i = 0; i < DTT.batch_cache_len; i++) {
+    fprintf(file, (i == 0) ? "{\"object\": " : ", {\"object\": ");
+    drw_stats_trace_write_string(file, DTT.batch_caches[i].name);
+    fprintf(file, ", \"ms\": %.4f}", DTT.batch_caches[i].time);
+  }
+
+  fprintf(file, "], \"passes\": [");
+  for (int i = 0; i < DTP.timer_increment; i++) {
+    const DRWTimer *timer = &DTP.timers[i];
+    fprintf(file, (i == 0) ? "{\"name\": " : ", {\"name\": ");
+    drw_stats_trace_write_string(file, timer->name);
+    fprintf(file, ", \"level\": %d, \"cpu_ms\": %.4f}", timer->lvl, timer->cpu_time);
+  }
+  fprintf(file, "]}\n");
+  /* Keep the file readable while Blender is running. */
+  fflush(file);
+
+  DTT.cache_time = 0.0;
+  DTT.batch_cache_wait_time = 0.0;
+  DTT.batch_cache_len = 0;
+}
+
+/** \} */
+
 void DRW_stats_reset(void)
 {
   BLI_assert((DTP.timer_increment - DTP.end_increment) <= 0 &&
@@ -185,6 +363,10 @@ void DRW_stats_reset(void)
       lvl_time[timer->lvl] += timer->time_average;
     }
 
+    if (DRW_stats_trace_is_enabled()) {
+      drw_stats_trace_frame_write();
+    }
+
     DTP.is_recording = false;
   }
 }
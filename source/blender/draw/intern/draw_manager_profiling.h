@@ -7,6 +7,7 @@
 
 #pragma once
 
+struct Object;
 struct rcti;
 
 void DRW_stats_free(void);
@@ -27,3 +28,14 @@ void DRW_stats_query_start(const char *name);
 void DRW_stats_query_end(void);
 
 void DRW_stats_draw(const rcti *rect);
+
+/**
+ * Frame trace, enabled with `--debug-draw-trace` or `bpy.app.debug_draw_trace`.
+ * Every frame drawn by the draw manager is appended to `blender_draw_trace.jsonl` in the
+ * temporary directory, as one JSON object per line.
+ */
+bool DRW_stats_trace_is_enabled(void);
+/** Time in milliseconds spent generating the requested batches of \a ob. */
+void DRW_stats_trace_batch_cache_add(const struct Object *ob, double time);
+/** Time in milliseconds spent filling the engine caches, and waiting on the batch extraction. */
+void DRW_stats_trace_cache_time_set(double cache_time, double batch_cache_wait_time);
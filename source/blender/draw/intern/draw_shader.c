@@ -22,8 +22,11 @@ extern char datatoc_common_hair_refine_vert_glsl[];
 extern char datatoc_common_hair_refine_comp_glsl[];
 extern char datatoc_gpu_shader_3D_smooth_color_frag_glsl[];
 
+extern char datatoc_common_mesh_extract_comp_glsl[];
+
 static struct {
   struct GPUShader *hair_refine_sh[PART_REFINE_MAX_SHADER];
+  struct GPUShader *mesh_extract_sh[MESH_EXTRACT_MAX_SHADER];
 } e_data = {{NULL}};
 
 /* -------------------------------------------------------------------- */
@@ -94,9 +97,51 @@ GPUShader *DRW_shader_hair_refine_get(ParticleRefineShader refinement,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Mesh extraction
+ * \{ */
+
+GPUShader *DRW_shader_mesh_extract_get(eMeshExtractShaderType sh_type)
+{
+  if (e_data.mesh_extract_sh[sh_type] == NULL) {
+    const char *defines = NULL;
+    const char *name = NULL;
+    switch (sh_type) {
+      case MESH_EXTRACT_SHADER_POS_NOR:
+        defines = "#define POS_NOR\n";
+        name = "mesh extract pos nor";
+        break;
+      case MESH_EXTRACT_SHADER_LNOR:
+        defines = "#define LNOR\n";
+        name = "mesh extract lnor";
+        break;
+      case MESH_EXTRACT_SHADER_POS_NOR_LNOR:
+        defines = "#define POS_NOR\n#define LNOR\n";
+        name = "mesh extract pos nor lnor";
+        break;
+      case MESH_EXTRACT_SHADER_LOOSE_GEOM:
+        defines = "#define LOOSE_GEOM\n";
+        name = "mesh extract loose geom";
+        break;
+      default:
+        BLI_assert_msg(0, "Incorrect shader type");
+        return NULL;
+    }
+    e_data.mesh_extract_sh[sh_type] = GPU_shader_create_compute(
+        datatoc_common_mesh_extract_comp_glsl, NULL, defines, name);
+  }
+
+  return e_data.mesh_extract_sh[sh_type];
+}
+
+/** \} */
+
 void DRW_shaders_free(void)
 {
   for (int i = 0; i < PART_REFINE_MAX_SHADER; i++) {
     DRW_SHADER_FREE_SAFE(e_data.hair_refine_sh[i]);
   }
+  for (int i = 0; i < MESH_EXTRACT_MAX_SHADER; i++) {
+    DRW_SHADER_FREE_SAFE(e_data.mesh_extract_sh[i]);
+  }
 }
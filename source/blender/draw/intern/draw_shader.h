@@ -21,9 +21,18 @@ typedef enum eParticleRefineShaderType {
   PART_REFINE_SHADER_COMPUTE,
 } eParticleRefineShaderType;
 
+typedef enum eMeshExtractShaderType {
+  MESH_EXTRACT_SHADER_POS_NOR,
+  MESH_EXTRACT_SHADER_LNOR,
+  MESH_EXTRACT_SHADER_POS_NOR_LNOR,
+  MESH_EXTRACT_SHADER_LOOSE_GEOM,
+  MESH_EXTRACT_MAX_SHADER,
+} eMeshExtractShaderType;
+
 /* draw_shader.c */
 struct GPUShader *DRW_shader_hair_refine_get(ParticleRefineShader refinement,
                                              eParticleRefineShaderType sh_type);
+struct GPUShader *DRW_shader_mesh_extract_get(eMeshExtractShaderType sh_type);
 void DRW_shaders_free(void);
 
 #ifdef __cplusplus
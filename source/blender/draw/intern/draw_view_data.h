@@ -63,6 +63,8 @@ typedef struct ViewportEngineData {
   double init_time;
   double render_time;
   double background_time;
+  /* Not averaged, only measured for the frame trace. */
+  double cache_populate_time;
 } ViewportEngineData;
 
 typedef struct ViewportEngineData_Info {
@@ -289,6 +289,27 @@ void mesh_render_data_update_looptris(MeshRenderData *mr,
                                       eMRIterType iter_type,
                                       eMRDataType data_flag);
 
+/* draw_cache_extract_mesh_gpu.cc */
+
+/**
+ * Whether the position and loop normal buffers of this mesh can be built with compute shaders
+ * instead of the CPU extractors. Only regular meshes without mapped data are supported.
+ */
+bool mesh_extract_gpu_supported(const MeshRenderData *mr, bool do_hq_normals);
+/**
+ * Whether the loop normals can be built on the GPU, which is not the case when they require
+ * auto-smooth split normals or custom normals.
+ */
+bool mesh_extract_gpu_lnor_supported(const MeshRenderData *mr);
+/**
+ * Build the requested `pos_nor` and `lnor` buffers with compute shaders. Must be called from the
+ * thread owning the GPU context. Either buffer can be NULL when it is not requested.
+ */
+void mesh_extract_gpu_pos_nor_lnor(MeshRenderData *mr,
+                                   MeshBufferCache *mbc,
+                                   GPUVertBuf *pos_nor,
+                                   GPUVertBuf *lnor);
+
 /* draw_cache_extract_mesh_extractors.c */
 typedef struct EditLoopData {
   uchar v_flag;
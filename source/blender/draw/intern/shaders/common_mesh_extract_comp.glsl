@@ -0,0 +1,150 @@
+/* Build the position, vertex normal and loop normal buffers of a mesh from its original
+ * #MVert, #MLoop and #MPoly arrays, uploaded as-is. The output buffers have the same layout as
+ * the ones filled by the CPU extractors (32-bit float position, 10-10-10-2 packed normals). */
+
+layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+
+/* #MVert: float co[3], char flag, bweight, _pad[2]. */
+layout(std430, binding = 0) readonly buffer inputVerts
+{
+  uint mverts[];
+};
+
+/* #MLoop: uint v, e. */
+layout(std430, binding = 1) readonly buffer inputLoops
+{
+  uint mloops[];
+};
+
+/* #MPoly: int loopstart, totloop, short mat_nr, char flag, _pad. */
+layout(std430, binding = 2) readonly buffer inputPolys
+{
+  uint mpolys[];
+};
+
+/* Tightly packed float[3] vertex normals. */
+layout(std430, binding = 3) readonly buffer inputVertNormals
+{
+  float vert_normals[];
+};
+
+/* Vertex of every loose edge end point, followed by the loose vertices. */
+layout(std430, binding = 4) readonly buffer inputLooseVerts
+{
+  uint loose_verts[];
+};
+
+layout(std430, binding = 5) writeonly buffer outputPosNor
+{
+  uint pos_nor[];
+};
+
+layout(std430, binding = 6) writeonly buffer outputLoopNormals
+{
+  uint lnor[];
+};
+
+uniform int loop_len;
+uniform int total_dispatch_size;
+
+/* Must match the flags in DNA_meshdata_types.h. */
+#define SELECT (1u << 0u)
+#define ME_HIDE (1u << 4u)
+#define ME_SMOOTH (1u << 0u)
+#define ME_FACE_SEL (1u << 1u)
+
+uint get_global_invocation_index()
+{
+  uint invocations_per_row = gl_WorkGroupSize.x * gl_NumWorkGroups.x;
+  return gl_GlobalInvocationID.x + gl_GlobalInvocationID.y * invocations_per_row;
+}
+
+vec3 vert_co(uint v)
+{
+  return uintBitsToFloat(uvec3(mverts[v * 4u], mverts[v * 4u + 1u], mverts[v * 4u + 2u]));
+}
+
+uint vert_flag(uint v)
+{
+  return mverts[v * 4u + 3u] & 0xFFu;
+}
+
+vec3 vert_no(uint v)
+{
+  return vec3(vert_normals[v * 3u], vert_normals[v * 3u + 1u], vert_normals[v * 3u + 2u]);
+}
+
+/* Same conversion as #GPU_normal_convert_i10_v3. */
+uint pack_normal(vec3 n, int w)
+{
+  ivec3 q = clamp(ivec3(n * 511.0), ivec3(-512), ivec3(511));
+  return (uint(q.x) & 0x3FFu) | ((uint(q.y) & 0x3FFu) << 10u) | ((uint(q.z) & 0x3FFu) << 20u) |
+         ((uint(w) & 0x3u) << 30u);
+}
+
+void write_pos_nor(uint index, uint v, int w)
+{
+  vec3 co = vert_co(v);
+  pos_nor[index * 4u] = floatBitsToUint(co.x);
+  pos_nor[index * 4u + 1u] = floatBitsToUint(co.y);
+  pos_nor[index * 4u + 2u] = floatBitsToUint(co.z);
+  pos_nor[index * 4u + 3u] = pack_normal(vert_no(v), w);
+}
+
+#ifdef LNOR
+/* Newell's method, same as #BKE_mesh_calc_poly_normal. */
+vec3 poly_normal(uint loopstart, uint totloop)
+{
+  vec3 n = vec3(0.0);
+  vec3 v_prev = vert_co(mloops[(loopstart + totloop - 1u) * 2u]);
+  for (uint i = 0u; i < totloop; i++) {
+    vec3 v_curr = vert_co(mloops[(loopstart + i) * 2u]);
+    n.x += (v_prev.y - v_curr.y) * (v_prev.z + v_curr.z);
+    n.y += (v_prev.z - v_curr.z) * (v_prev.x + v_curr.x);
+    n.z += (v_prev.x - v_curr.x) * (v_prev.y + v_curr.y);
+    v_prev = v_curr;
+  }
+  float len = length(n);
+  return (len > 0.0) ? n / len : vec3(0.0, 0.0, 1.0);
+}
+#endif
+
+void main()
+{
+  uint index = get_global_invocation_index();
+  if (index >= uint(total_dispatch_size)) {
+    return;
+  }
+
+#ifdef LOOSE_GEOM
+  /* One invocation per loose element, stored after the loops. */
+  uint v = loose_verts[index];
+  write_pos_nor(uint(loop_len) + index, v, 0);
+#else
+  /* One invocation per polygon. */
+  uint loopstart = mpolys[index * 3u];
+  uint totloop = mpolys[index * 3u + 1u];
+  uint poly_flag = (mpolys[index * 3u + 2u] >> 16u) & 0xFFu;
+  bool poly_hidden = (poly_flag & ME_HIDE) != 0u;
+
+#  ifdef LNOR
+  bool use_poly_normal = (poly_flag & ME_SMOOTH) == 0u;
+  vec3 poly_no = use_poly_normal ? poly_normal(loopstart, totloop) : vec3(0.0);
+  /* Flag for paint mode overlay. */
+  int lnor_w = poly_hidden ? -1 : (((poly_flag & ME_FACE_SEL) != 0u) ? 1 : 0);
+#  endif
+
+  for (uint l = loopstart; l < loopstart + totloop; l++) {
+    uint v = mloops[l * 2u];
+#  ifdef POS_NOR
+    /* Flag for paint mode overlay. */
+    uint flag = vert_flag(v);
+    int w = (poly_hidden || (flag & ME_HIDE) != 0u) ? -1 : (((flag & SELECT) != 0u) ? 1 : 0);
+    write_pos_nor(l, v, w);
+#  endif
+#  ifdef LNOR
+    lnor[l] = pack_normal(use_poly_normal ? poly_no : vert_no(v), lnor_w);
+#  endif
+  }
+#endif
+}
@@ -17,6 +17,7 @@
 #include "BLI_math.h"
 #include "BLI_memarena.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 
 #include "BLT_translation.h"
 
@@ -980,42 +981,56 @@ static void harmonic_ray_callback(void *userdata,
   }
 }
 
-static MDefBoundIsect *meshdeform_ray_tree_intersect(MeshDeformBind *mdb,
-                                                     const float co1[3],
-                                                     const float co2[3])
+/**
+ * Find the first intersection of the segment from \a co1 to \a co2 with the cage.
+ * Doesn't allocate anything, so it can be used from multiple threads.
+ */
+static bool meshdeform_ray_tree_cast(MeshDeformBind *mdb,
+                                     const float co1[3],
+                                     const float co2[3],
+                                     BVHTreeRayHit *r_hit,
+                                     MeshDeformIsect *r_isect_mdef)
 {
-  BVHTreeRayHit hit;
-  MeshDeformIsect isect_mdef;
   struct MeshRayCallbackData data = {
       mdb,
-      &isect_mdef,
+      r_isect_mdef,
   };
   float end[3], vec_normal[3];
 
   /* happens binding when a cage has no faces */
   if (UNLIKELY(mdb->bvhtree == NULL)) {
-    return NULL;
+    return false;
   }
 
   /* setup isec */
-  memset(&isect_mdef, 0, sizeof(isect_mdef));
-  isect_mdef.lambda = 1e10f;
+  memset(r_isect_mdef, 0, sizeof(*r_isect_mdef));
+  r_isect_mdef->lambda = 1e10f;
 
-  copy_v3_v3(isect_mdef.start, co1);
+  copy_v3_v3(r_isect_mdef->start, co1);
   copy_v3_v3(end, co2);
-  sub_v3_v3v3(isect_mdef.vec, end, isect_mdef.start);
-  isect_mdef.vec_length = normalize_v3_v3(vec_normal, isect_mdef.vec);
+  sub_v3_v3v3(r_isect_mdef->vec, end, r_isect_mdef->start);
+  r_isect_mdef->vec_length = normalize_v3_v3(vec_normal, r_isect_mdef->vec);
+
+  r_hit->index = -1;
+  r_hit->dist = BVH_RAYCAST_DIST_MAX;
+  return BLI_bvhtree_ray_cast_ex(mdb->bvhtree,
+                                 r_isect_mdef->start,
+                                 vec_normal,
+                                 0.0,
+                                 r_hit,
+                                 harmonic_ray_callback,
+                                 &data,
+                                 BVH_RAYCAST_WATERTIGHT) != -1;
+}
 
-  hit.index = -1;
-  hit.dist = BVH_RAYCAST_DIST_MAX;
-  if (BLI_bvhtree_ray_cast_ex(mdb->bvhtree,
-                              isect_mdef.start,
-                              vec_normal,
-                              0.0,
-                              &hit,
-                              harmonic_ray_callback,
-                              &data,
-                              BVH_RAYCAST_WATERTIGHT) != -1) {
+static MDefBoundIsect *meshdeform_ray_tree_intersect(MeshDeformBind *mdb,
+                                                     const float co1[3],
+                                                     const float co2[3])
+{
+  BVHTreeRayHit hit;
+  MeshDeformIsect isect_mdef;
+
+  if (meshdeform_ray_tree_cast(mdb, co1, co2, &hit, &isect_mdef)) {
     const MLoop *mloop = mdb->cagemesh_cache.mloop;
     const MLoopTri *lt = &mdb->cagemesh_cache.looptri[hit.index];
     const MPoly *mp = &mdb->cagemesh_cache.mpoly[lt->poly];
@@ -1050,10 +1065,11 @@ static MDefBoundIsect *meshdeform_ray_tree_intersect(MeshDeformBind *mdb,
   return NULL;
 }
 
-static int meshdeform_inside_cage(MeshDeformBind *mdb, float *co)
+static int meshdeform_inside_cage(MeshDeformBind *mdb, const float co[3])
 {
-  MDefBoundIsect *isect;
-  float outside[3], start[3], dir[3];
+  BVHTreeRayHit hit;
+  MeshDeformIsect isect_mdef;
+  float outside[3];
   int i;
 
   for (i = 1; i <= 6; i++) {
@@ -1061,12 +1077,8 @@ static int meshdeform_inside_cage(MeshDeformBind *mdb, float *co)
     outside[1] = co[1] + (mdb->max[1] - mdb->min[1] + 1.0f) * MESHDEFORM_OFFSET[i][1];
     outside[2] = co[2] + (mdb->max[2] - mdb->min[2] + 1.0f) * MESHDEFORM_OFFSET[i][2];
 
-    copy_v3_v3(start, co);
-    sub_v3_v3v3(dir, outside, start);
-    normalize_v3(dir);
-
-    isect = meshdeform_ray_tree_intersect(mdb, start, outside);
-    if (isect && !isect->facing) {
+    /* Only the facing of the intersection is needed, no need to create a #MDefBoundIsect. */
+    if (meshdeform_ray_tree_cast(mdb, co, outside, &hit, &isect_mdef) && !isect_mdef.isect) {
       return 1;
     }
   }
@@ -1074,6 +1086,14 @@ static int meshdeform_inside_cage(MeshDeformBind *mdb, float *co)
   return 0;
 }
 
+static void meshdeform_inside_cage_task(void *__restrict userdata,
+                                        const int a,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MeshDeformBind *mdb = userdata;
+  mdb->inside[a] = meshdeform_inside_cage(mdb, mdb->vertexcos[a]);
+}
+
 /* solving */
 
 BLI_INLINE int meshdeform_index(MeshDeformBind *mdb, int x, int y, int z, int n)
@@ -1567,7 +1587,7 @@ static void harmonic_coordinates_bind(MeshDeformModifierData *mmd, MeshDeformBin
   MDefBindInfluence *inf;
   MDefInfluence *mdinf;
   MDefCell *cell;
-  float center[3], vec[3], maxwidth, totweight;
+  float center[3], maxwidth, totweight;
   int a, b, x, y, z, totinside, offset;
 
   /* compute bounding box of the cage mesh */
@@ -1631,19 +1651,18 @@ static void harmonic_coordinates_bind(MeshDeformModifierData *mmd, MeshDeformBin
 
   progress_bar(0, "Setting up mesh deform system");
 
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 256;
+  BLI_task_parallel_range(0, mdb->totvert, mdb, meshdeform_inside_cage_task, &settings);
+
   totinside = 0;
   for (a = 0; a < mdb->totvert; a++) {
-    copy_v3_v3(vec, mdb->vertexcos[a]);
-    mdb->inside[a] = meshdeform_inside_cage(mdb, vec);
     if (mdb->inside[a]) {
       totinside++;
     }
   }
 
-  /* free temporary MDefBoundIsects */
-  BLI_memarena_free(mdb->memarena);
-  mdb->memarena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, "harmonic coords arena");
-
   /* start with all cells untyped */
   for (a = 0; a < mdb->size3; a++) {
     mdb->tag[a] = MESHDEFORM_TAG_UNTYPED;
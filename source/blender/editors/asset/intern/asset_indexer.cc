@@ -95,6 +95,15 @@ class AbstractFile {
   {
     return BLI_file_size(get_file_path());
   }
+
+  /**
+   * Query the existence, size and modification time of the file at once, as every `stat` call
+   * adds up when there are many files in a library.
+   */
+  bool stat(BLI_stat_t &r_stat) const
+  {
+    return BLI_stat(get_file_path(), &r_stat) == 0;
+  }
 };
 
 /**
@@ -639,19 +648,26 @@ class AssetIndexFile : public AbstractFile {
 
   /**
    * Returns whether the index file is older than the given asset file.
+   *
+   * \param index_stat: The result of #stat on this index file.
    */
-  bool is_older_than(BlendFile &asset_file) const
+  bool is_older_than(const BLI_stat_t &index_stat, BlendFile &asset_file) const
   {
-    return BLI_file_older(get_file_path(), asset_file.get_file_path());
+    BLI_stat_t asset_stat;
+    if (!asset_file.stat(asset_stat)) {
+      return false;
+    }
+    return index_stat.st_mtime < asset_stat.st_mtime;
   }
 
   /**
    * Check whether the index file contains entries without opening the file.
+   *
+   * \param index_stat: The result of #stat on this index file.
    */
-  bool constains_entries() const
+  bool constains_entries(const BLI_stat_t &index_stat) const
   {
-    const size_t file_size = get_file_size();
-    return file_size >= MIN_FILE_SIZE_WITH_ENTRIES;
+    return size_t(index_stat.st_size) >= MIN_FILE_SIZE_WITH_ENTRIES;
   }
 
   std::unique_ptr<AssetIndex> read_contents() const
@@ -696,7 +712,8 @@ static eFileIndexerResult read_index(const char *filename,
   BlendFile asset_file(filename);
   AssetIndexFile asset_index_file(library_index, asset_file);
 
-  if (!asset_index_file.exists()) {
+  BLI_stat_t index_stat;
+  if (!asset_index_file.stat(index_stat)) {
     return FILE_INDEXER_NEEDS_UPDATE;
   }
 
@@ -706,7 +723,7 @@ static eFileIndexerResult read_index(const char *filename,
    */
   asset_index_file.mark_as_used();
 
-  if (asset_index_file.is_older_than(asset_file)) {
+  if (asset_index_file.is_older_than(index_stat, asset_file)) {
     CLOG_INFO(
         &LOG,
         3,
@@ -716,7 +733,7 @@ static eFileIndexerResult read_index(const char *filename,
     return FILE_INDEXER_NEEDS_UPDATE;
   }
 
-  if (!asset_index_file.constains_entries()) {
+  if (!asset_index_file.constains_entries(index_stat)) {
     CLOG_INFO(&LOG,
               3,
               "Asset file index is to small to contain any entries. [%s]",
@@ -24,6 +24,11 @@ typedef struct ScreenAnimData {
   int nextfra;                /* next frame to go to (when ANIMPLAY_FLAG_USE_NEXT_FRAME is set) */
   double lagging_frame_count; /* used for frame dropping */
   bool from_anim_edit;        /* playback was invoked from animation editor */
+
+  /* Statistics of the last step, for the frame rate info. */
+  int step_skipped_frames; /* frames dropped to keep up with the frame rate */
+  double step_sync_time;   /* seconds spent to synchronize with the audio */
+  double step_eval_time;   /* seconds spent to evaluate the new frame */
 } ScreenAnimData;
 
 /** #ScreenAnimData.flag */
@@ -52,6 +57,13 @@ typedef struct ScreenFrameRateInfo {
   double lredrawtime;
   float redrawtimes_fps[REDRAW_FRAME_AVERAGE];
   short redrawtime_index;
+
+  /* Where the time of the last frames went, to show why playback is slower than real-time. */
+  float eval_times[REDRAW_FRAME_AVERAGE];
+  float sync_times[REDRAW_FRAME_AVERAGE];
+  short eval_time_index;
+  /* Total frames dropped since playback started. */
+  int skipped_frames;
 } ScreenFrameRateInfo;
 
 /* ----------------------------------------------------- */
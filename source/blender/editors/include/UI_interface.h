@@ -778,6 +778,13 @@ void UI_block_free(const struct bContext *C, uiBlock *block);
  */
 void UI_blocklist_free(const struct bContext *C, struct ARegion *region);
 void UI_blocklist_free_inactive(const struct bContext *C, struct ARegion *region);
+/**
+ * Keep the blocks of the last redraw of the region for the next one, instead of defining them
+ * again. Blocks of popups are not affected.
+ *
+ * \return false when there are no blocks that could be kept.
+ */
+bool UI_blocklist_reuse(struct ARegion *region);
 
 /**
  * Is called by notifier.
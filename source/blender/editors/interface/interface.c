@@ -3514,6 +3514,21 @@ void UI_blocklist_free_inactive(const bContext *C, ARegion *region)
   }
 }
 
+bool UI_blocklist_reuse(ARegion *region)
+{
+  bool reused = false;
+
+  LISTBASE_FOREACH (uiBlock *, block, &region->uiblocks) {
+    if (!block->handle) {
+      /* All blocks that weren't active in the last redraw were freed then. */
+      block->active = true;
+      reused = true;
+    }
+  }
+
+  return reused;
+}
+
 void UI_block_region_set(uiBlock *block, ARegion *region)
 {
   ListBase *lb = &region->uiblocks;
@@ -372,6 +372,11 @@ typedef struct uiHandleButtonData {
   /* Button is being applied through an extra icon. */
   bool apply_through_extra_icon;
   bool changed_cursor;
+  /**
+   * Only the highlight of the button changed since it was activated, so only the button itself
+   * has to be redrawn, see #button_tag_redraw.
+   */
+  bool highlight_only;
   wmTimer *flashtimer;
 
   /* edited value */
@@ -8265,6 +8270,32 @@ static bool button_modal_state(uiHandleButtonState state)
               BUTTON_STATE_MENU_OPEN);
 }
 
+/**
+ * Moving the mouse over buttons changes the highlight of one button at a time, avoid redrawing
+ * the whole region for that. Popups clear their whole buffer when drawing, and other regions
+ * than layout based ones may draw content depending on the active button, so they are always
+ * redrawn fully.
+ */
+static void button_tag_redraw(uiBut *but, uiHandleButtonData *data)
+{
+  ARegion *region = data->region;
+
+  if (data->highlight_only && (but->block->handle == NULL) && region->type &&
+      region->type->layout) {
+    rctf rect_fl;
+    rcti rect;
+    ui_block_to_window_rctf(region, but->block, &rect_fl, &but->rect);
+    BLI_rcti_rctf_copy_round(&rect, &rect_fl);
+    /* Outlines and emboss of widgets are drawn slightly outside of the button. */
+    const int pad = (int)ceilf(2.0f * U.pixelsize);
+    BLI_rcti_pad(&rect, pad, pad);
+    ED_region_tag_redraw_partial(region, &rect, false);
+  }
+  else {
+    ED_region_tag_redraw_no_rebuild(region);
+  }
+}
+
 static void button_activate_state(bContext *C, uiBut *but, uiHandleButtonState state)
 {
   uiHandleButtonData *data = but->active;
@@ -8272,6 +8303,12 @@ static void button_activate_state(bContext *C, uiBut *but, uiHandleButtonState s
     return;
   }
 
+  /* Leaving the highlight without canceling may apply the button. */
+  if (!ELEM(state, BUTTON_STATE_HIGHLIGHT, BUTTON_STATE_EXIT) ||
+      (state == BUTTON_STATE_EXIT && !data->cancel)) {
+    data->highlight_only = false;
+  }
+
   /* Highlight has timers for tool-tips and auto open. */
   if (state == BUTTON_STATE_HIGHLIGHT) {
     but->flag &= ~UI_SELECT;
@@ -8439,7 +8476,7 @@ static void button_activate_state(bContext *C, uiBut *but, uiHandleButtonState s
   }
 
   /* redraw */
-  ED_region_tag_redraw_no_rebuild(data->region);
+  button_tag_redraw(but, data);
 }
 
 static void button_activate_init(bContext *C,
@@ -8472,6 +8509,7 @@ static void button_activate_init(bContext *C,
   }
 
   data->state = BUTTON_STATE_INIT;
+  data->highlight_only = true;
 
   /* activate button */
   but->flag |= UI_ACTIVE;
@@ -8650,7 +8688,7 @@ static void button_activate_exit(
   }
 
   /* redraw and refresh (for popups) */
-  ED_region_tag_redraw_no_rebuild(data->region);
+  button_tag_redraw(but, data);
   ED_region_tag_refresh_ui(data->region);
 
   if ((but->flag & UI_BUT_DRAG_MULTI) == 0) {
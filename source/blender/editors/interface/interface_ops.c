@@ -79,6 +79,8 @@
 
 static void ui_region_redraw_immediately(bContext *C, ARegion *region)
 {
+  /* The layout definitions have to run, even when the blocks could be reused. */
+  region->do_draw &= ~RGN_DRAW_NO_REBUILD;
   ED_region_do_layout(C, region);
   WM_draw_region_viewport_bind(region);
   ED_region_do_draw(C, region);
@@ -59,4 +59,5 @@ void ED_operatortypes_io(void)
   WM_operatortype_append(CACHEFILE_OT_layer_move);
 
   WM_operatortype_append(WM_OT_obj_export);
+  WM_operatortype_append(WM_OT_obj_import);
 }
@@ -337,6 +337,8 @@ static int wm_usd_import_exec(bContext *C, wmOperator *op)
   const bool import_meshes = RNA_boolean_get(op->ptr, "import_meshes");
   const bool import_volumes = RNA_boolean_get(op->ptr, "import_volumes");
 
+  const bool read_meshes_on_demand = RNA_boolean_get(op->ptr, "read_meshes_on_demand");
+
   const bool import_subdiv = RNA_boolean_get(op->ptr, "import_subdiv");
 
   const bool import_instance_proxies = RNA_boolean_get(op->ptr, "import_instance_proxies");
@@ -384,6 +386,7 @@ static int wm_usd_import_exec(bContext *C, wmOperator *op)
                                    .import_materials = import_materials,
                                    .import_meshes = import_meshes,
                                    .import_volumes = import_volumes,
+                                   .read_meshes_on_demand = read_meshes_on_demand,
                                    .prim_path_mask = prim_path_mask,
                                    .import_subdiv = import_subdiv,
                                    .import_instance_proxies = import_instance_proxies,
@@ -425,6 +428,7 @@ static void wm_usd_import_draw(bContext *UNUSED(C), wmOperator *op)
   col = uiLayoutColumnWithHeading(box, true, IFACE_("Mesh Data"));
   uiItemR(col, ptr, "read_mesh_uvs", 0, NULL, ICON_NONE);
   uiItemR(col, ptr, "read_mesh_colors", 0, NULL, ICON_NONE);
+  uiItemR(col, ptr, "read_meshes_on_demand", 0, NULL, ICON_NONE);
   col = uiLayoutColumnWithHeading(box, true, IFACE_("Include"));
   uiItemR(col, ptr, "import_subdiv", 0, IFACE_("Subdivision"), ICON_NONE);
   uiItemR(col, ptr, "import_instance_proxies", 0, NULL, ICON_NONE);
@@ -522,6 +526,14 @@ void WM_OT_usd_import(struct wmOperatorType *ot)
 
   RNA_def_boolean(ot->srna, "read_mesh_colors", false, "Vertex Colors", "Read mesh vertex colors");
 
+  RNA_def_boolean(ot->srna,
+                  "read_meshes_on_demand",
+                  false,
+                  "Read on Demand",
+                  "Import meshes without geometry, and read it with a Mesh Sequence Cache modifier "
+                  "when the object is evaluated. Geometry of hidden objects is not loaded, and "
+                  "objects are read in parallel");
+
   RNA_def_string(ot->srna,
                  "prim_path_mask",
                  NULL,
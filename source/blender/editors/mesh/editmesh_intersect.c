@@ -212,6 +212,7 @@ static int edbm_intersect_exec(bContext *C, wmOperator *op)
                                     em->tottri,
                                     test_fn,
                                     NULL,
+                                    NULL,
                                     use_self,
                                     use_separate_all,
                                     true,
@@ -381,6 +382,7 @@ static int edbm_intersect_boolean_exec(bContext *C, wmOperator *op)
                                     em->tottri,
                                     test_fn,
                                     NULL,
+                                    NULL,
                                     false,
                                     false,
                                     true,
@@ -12,6 +12,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -349,6 +350,7 @@ static void dynamicPaint_bakeImageSequence(DynamicPaintBakeJob *job)
   Scene *scene = job->scene;
   int frame = 1, orig_frame;
   int frames;
+  TaskPool *save_pool;
 
   frames = surface->end_frame - surface->start_frame + 1;
   if (frames <= 0) {
@@ -371,6 +373,9 @@ static void dynamicPaint_bakeImageSequence(DynamicPaintBakeJob *job)
     return;
   }
 
+  /* Images are written in the background while the next frame is calculated. */
+  save_pool = BLI_task_pool_create_background(NULL, TASK_PRIORITY_LOW);
+
   /* Loop through selected frames */
   for (frame = surface->start_frame; frame <= surface->end_frame; frame++) {
     /* The first 10% are for createUVSurface... */
@@ -380,7 +385,7 @@ static void dynamicPaint_bakeImageSequence(DynamicPaintBakeJob *job)
     /* If user requested stop, quit baking */
     if (G.is_break) {
       job->success = 0;
-      return;
+      break;
     }
 
     /* Update progress bar */
@@ -392,13 +397,17 @@ static void dynamicPaint_bakeImageSequence(DynamicPaintBakeJob *job)
     ED_update_for_newframe(job->bmain, job->depsgraph);
     if (!dynamicPaint_calculateFrame(surface, job->depsgraph, scene, cObject, frame)) {
       job->success = 0;
-      return;
+      break;
     }
 
     /*
      * Save output images
      */
     {
+      /* Finish the images of the previous frame first,
+       * so no more than one frame of images is kept in memory. */
+      BLI_task_pool_work_and_wait(save_pool);
+
       char filename[FILE_MAX];
 
       /* primary output layer */
@@ -409,7 +418,7 @@ static void dynamicPaint_bakeImageSequence(DynamicPaintBakeJob *job)
         BLI_path_frame(filename, frame, 4);
 
         /* save image */
-        dynamicPaint_outputSurfaceImage(surface, filename, 0);
+        dynamicPaint_outputSurfaceImage(surface, filename, 0, save_pool);
       }
       /* secondary output */
       if (surface->flags & MOD_DPAINT_OUT2 && surface->type == MOD_DPAINT_SURFACE_T_PAINT) {
@@ -419,11 +428,18 @@ static void dynamicPaint_bakeImageSequence(DynamicPaintBakeJob *job)
         BLI_path_frame(filename, frame, 4);
 
         /* save image */
-        dynamicPaint_outputSurfaceImage(surface, filename, 1);
+        dynamicPaint_outputSurfaceImage(surface, filename, 1, save_pool);
       }
     }
   }
 
+  BLI_task_pool_work_and_wait(save_pool);
+  BLI_task_pool_free(save_pool);
+
+  if (!job->success) {
+    return;
+  }
+
   input_scene->r.cfra = orig_frame;
   ED_update_for_newframe(job->bmain, job->depsgraph);
 }
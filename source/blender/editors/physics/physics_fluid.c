@@ -18,6 +18,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_path_util.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -349,6 +350,11 @@ static void fluid_bake_endjob(void *customdata)
   }
 }
 
+static void fluid_bake_sequence_cb(void *job)
+{
+  fluid_bake_sequence(job);
+}
+
 static void fluid_bake_startjob(void *customdata, short *stop, short *do_update, float *progress)
 {
   FluidJob *job = customdata;
@@ -424,7 +430,8 @@ static void fluid_bake_startjob(void *customdata, short *stop, short *do_update,
   }
   DEG_id_tag_update(&job->ob->id, ID_RECALC_GEOMETRY);
 
-  fluid_bake_sequence(job);
+  /* Leave threads to the user interface and viewport while baking. */
+  BLI_task_execute_in_lane(TASK_LANE_BACKGROUND, fluid_bake_sequence_cb, job);
 
   if (do_update) {
     *do_update = true;
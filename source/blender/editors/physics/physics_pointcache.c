@@ -11,6 +11,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_scene_types.h"
@@ -126,6 +127,11 @@ static void ptcache_job_update(void *customdata, float progress, int *cancel)
   *(job->progress) = progress;
 }
 
+static void ptcache_job_bake(void *baker)
+{
+  BKE_ptcache_bake(baker);
+}
+
 static void ptcache_job_startjob(void *customdata, short *stop, short *do_update, float *progress)
 {
   PointCacheJob *job = customdata;
@@ -141,7 +147,8 @@ static void ptcache_job_startjob(void *customdata, short *stop, short *do_update
    */
   WM_set_locked_interface(job->wm, true);
 
-  BKE_ptcache_bake(job->baker);
+  /* Leave threads to the user interface and viewport while baking. */
+  BLI_task_execute_in_lane(TASK_LANE_BACKGROUND, ptcache_job_bake, job->baker);
 
   *do_update = true;
   *stop = 0;
@@ -501,6 +501,13 @@ void ED_region_do_layout(bContext *C, ARegion *region)
     return;
   }
 
+  /* Redraws that don't need a rebuild (e.g. scrolling or button highlights) draw the blocks of
+   * the last layout again. Defining them again means running all panel and header draw
+   * callbacks, which is slow with many (Python defined) buttons. */
+  if ((region->do_draw & RGN_DRAW_NO_REBUILD) && UI_blocklist_reuse(region)) {
+    return;
+  }
+
   region->do_draw |= RGN_DRAWING;
 
   UI_SetTheme(area ? area->spacetype : 0, at->regionid);
@@ -1583,9 +1590,9 @@ static void region_rect_recursive(
 
   /* Tag for redraw if size changes. */
   if (region->winx != prev_winx || region->winy != prev_winy) {
-    /* 3D View needs a full rebuild in case a progressive render runs. Rest can live with
-     * no-rebuild (e.g. Outliner) */
-    if (area->spacetype == SPACE_VIEW3D) {
+    /* 3D View needs a full rebuild in case a progressive render runs. Layouts depend on the
+     * region size. Rest can live with no-rebuild (e.g. Outliner) */
+    if (area->spacetype == SPACE_VIEW3D || (region->type && region->type->layout)) {
       ED_region_tag_redraw(region);
     }
     else {
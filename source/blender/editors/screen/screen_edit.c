@@ -1582,6 +1582,12 @@ void ED_refresh_viewport_fps(bContext *C)
     /* update the values */
     fpsi->redrawtime = fpsi->lredrawtime;
     fpsi->lredrawtime = animtimer->ltime;
+
+    const ScreenAnimData *sad = animtimer->customdata;
+    fpsi->eval_times[fpsi->eval_time_index] = (float)sad->step_eval_time;
+    fpsi->sync_times[fpsi->eval_time_index] = (float)sad->step_sync_time;
+    fpsi->eval_time_index = (fpsi->eval_time_index + 1) % REDRAW_FRAME_AVERAGE;
+    fpsi->skipped_frames += sad->step_skipped_frames;
   }
   else {
     /* playback stopped or shouldn't be running */
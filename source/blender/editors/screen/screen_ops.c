@@ -17,6 +17,8 @@
 
 #include "BLT_translation.h"
 
+#include "PIL_time.h"
+
 #include "DNA_anim_types.h"
 #include "DNA_armature_types.h"
 #include "DNA_curve_types.h"
@@ -4604,6 +4606,8 @@ static int screen_animation_step_invoke(bContext *C, wmOperator *UNUSED(op), con
   wmWindowManager *wm = CTX_wm_manager(C);
   int sync;
   double time;
+  const int cfra_prev = scene->r.cfra;
+  const double step_start_time = PIL_check_seconds_timer();
 
   /* sync, don't sync, or follow scene setting */
   if (sad->flag & ANIMPLAY_FLAG_SYNC) {
@@ -4692,6 +4696,9 @@ static int screen_animation_step_invoke(bContext *C, wmOperator *UNUSED(op), con
     }
   }
 
+  sad->step_sync_time = PIL_check_seconds_timer() - step_start_time;
+  sad->step_skipped_frames = max_ii(abs(scene->r.cfra - cfra_prev) - 1, 0);
+
   /* reset 'jumped' flag before checking if we need to jump... */
   sad->flag &= ~ANIMPLAY_FLAG_JUMPED;
 
@@ -4742,7 +4749,12 @@ static int screen_animation_step_invoke(bContext *C, wmOperator *UNUSED(op), con
 
   /* since we follow drawflags, we can't send notifier but tag regions ourselves */
   if (depsgraph != NULL) {
+    const double eval_start_time = PIL_check_seconds_timer();
     ED_update_for_newframe(bmain, depsgraph);
+    sad->step_eval_time = PIL_check_seconds_timer() - eval_start_time;
+  }
+  else {
+    sad->step_eval_time = 0.0;
   }
 
   LISTBASE_FOREACH (wmWindow *, window, &wm->windows) {
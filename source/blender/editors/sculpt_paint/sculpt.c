@@ -2324,15 +2324,10 @@ static float brush_strength(const Sculpt *sd,
   }
 }
 
-float SCULPT_brush_strength_factor(SculptSession *ss,
-                                   const Brush *br,
-                                   const float brush_point[3],
-                                   const float len,
-                                   const float vno[3],
-                                   const float fno[3],
-                                   const float mask,
-                                   const int vertex_index,
-                                   const int thread_id)
+static float sculpt_brush_texture_factor(SculptSession *ss,
+                                         const Brush *br,
+                                         const float brush_point[3],
+                                         const int thread_id)
 {
   StrokeCache *cache = ss->cache;
   const Scene *scene = cache->vc->scene;
@@ -2393,20 +2388,39 @@ float SCULPT_brush_strength_factor(SculptSession *ss,
     }
   }
 
-  /* Hardness. */
-  float final_len = len;
+  return avg;
+}
+
+/* Distance to the brush center remapped by the brush hardness. */
+static float sculpt_brush_hardness_len(const StrokeCache *cache, const float len)
+{
   const float hardness = cache->paint_brush.hardness;
   float p = len / cache->radius;
   if (p < hardness) {
-    final_len = 0.0f;
+    return 0.0f;
   }
-  else if (hardness == 1.0f) {
-    final_len = cache->radius;
-  }
-  else {
-    p = (p - hardness) / (1.0f - hardness);
-    final_len = p * cache->radius;
+  if (hardness == 1.0f) {
+    return cache->radius;
   }
+  p = (p - hardness) / (1.0f - hardness);
+  return p * cache->radius;
+}
+
+float SCULPT_brush_strength_factor(SculptSession *ss,
+                                   const Brush *br,
+                                   const float brush_point[3],
+                                   const float len,
+                                   const float vno[3],
+                                   const float fno[3],
+                                   const float mask,
+                                   const int vertex_index,
+                                   const int thread_id)
+{
+  StrokeCache *cache = ss->cache;
+  float avg = sculpt_brush_texture_factor(ss, br, brush_point, thread_id);
+
+  /* Hardness. */
+  const float final_len = sculpt_brush_hardness_len(cache, len);
 
   /* Falloff curve. */
   avg *= BKE_brush_curve_strength(br, final_len, cache->radius);
@@ -2421,6 +2435,68 @@ float SCULPT_brush_strength_factor(SculptSession *ss,
   return avg;
 }
 
+void SCULPT_brush_batch_add(SculptBrushBatch *batch, const PBVHVertexIter *vd, const float dist)
+{
+  BLI_assert(batch->len < SCULPT_BRUSH_BATCH_SIZE);
+  const int i = batch->len++;
+  copy_v3_v3(batch->co[i], vd->co);
+  copy_v3_v3(batch->no[i], vd->no ? vd->no : vd->fno);
+  batch->dist[i] = dist;
+  batch->mask[i] = vd->mask ? *vd->mask : 0.0f;
+  batch->vertex_index[i] = vd->index;
+  batch->node_index[i] = vd->i;
+}
+
+void SCULPT_brush_strength_factor_batch(SculptSession *ss,
+                                        const Brush *br,
+                                        SculptBrushBatch *batch,
+                                        const int thread_id)
+{
+  StrokeCache *cache = ss->cache;
+  const int len = batch->len;
+  float *factor = batch->factor;
+
+  if (br->mtex.tex) {
+    for (int i = 0; i < len; i++) {
+      factor[i] = sculpt_brush_texture_factor(ss, br, batch->co[i], thread_id);
+    }
+  }
+  else {
+    copy_vn_fl(factor, len, 1.0f);
+  }
+
+  /* Hardness and falloff curve. */
+  float falloff[SCULPT_BRUSH_BATCH_SIZE];
+  const float hardness = cache->paint_brush.hardness;
+  if (hardness == 0.0f) {
+    memcpy(falloff, batch->dist, sizeof(float) * len);
+  }
+  else {
+    for (int i = 0; i < len; i++) {
+      falloff[i] = sculpt_brush_hardness_len(cache, batch->dist[i]);
+    }
+  }
+  BKE_brush_curve_strength_array(br, falloff, len, cache->radius);
+  for (int i = 0; i < len; i++) {
+    factor[i] *= falloff[i];
+  }
+
+  if (br->flag & BRUSH_FRONTFACE) {
+    for (int i = 0; i < len; i++) {
+      factor[i] *= max_ff(dot_v3v3(batch->no[i], cache->view_normal), 0.0f);
+    }
+  }
+
+  /* Paint mask. */
+  for (int i = 0; i < len; i++) {
+    factor[i] *= 1.0f - batch->mask[i];
+  }
+
+  /* Auto-masking. */
+  SCULPT_automasking_factor_mul_array(
+      cache->automasking, ss, batch->vertex_index, len, factor);
+}
+
 bool SCULPT_search_sphere_cb(PBVHNode *node, void *data_v)
 {
   SculptSearchSphereData *data = data_v;
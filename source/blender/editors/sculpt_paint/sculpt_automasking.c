@@ -144,6 +144,26 @@ float SCULPT_automasking_factor_get(AutomaskingCache *automasking, SculptSession
   return 1.0f;
 }
 
+void SCULPT_automasking_factor_mul_array(AutomaskingCache *automasking,
+                                         SculptSession *ss,
+                                         const int *verts,
+                                         const int verts_num,
+                                         float *r_factors)
+{
+  if (!automasking) {
+    return;
+  }
+  if (automasking->factor) {
+    for (int i = 0; i < verts_num; i++) {
+      r_factors[i] *= automasking->factor[verts[i]];
+    }
+    return;
+  }
+  for (int i = 0; i < verts_num; i++) {
+    r_factors[i] *= SCULPT_automasking_factor_get(automasking, ss, verts[i]);
+  }
+}
+
 void SCULPT_automasking_cache_free(AutomaskingCache *automasking)
 {
   if (!automasking) {
@@ -283,6 +283,21 @@ static void sculpt_project_v3_normal_align(SculptSession *ss,
 /** \name Sculpt Draw Brush
  * \{ */
 
+/* Offset vertices of the batch and empty it. */
+static void do_draw_brush_batch_apply(SculptSession *ss,
+                                      const Brush *brush,
+                                      SculptBrushBatch *batch,
+                                      const float offset[3],
+                                      float (*proxy)[3],
+                                      const int thread_id)
+{
+  SCULPT_brush_strength_factor_batch(ss, brush, batch, thread_id);
+  for (int i = 0; i < batch->len; i++) {
+    mul_v3_v3fl(proxy[batch->node_index[i]], offset, batch->factor[i]);
+  }
+  batch->len = 0;
+}
+
 static void do_draw_brush_task_cb_ex(void *__restrict userdata,
                                      const int n,
                                      const TaskParallelTLS *__restrict tls)
@@ -302,28 +317,26 @@ static void do_draw_brush_task_cb_ex(void *__restrict userdata,
       ss, &test, data->brush->falloff_shape);
   const int thread_id = BLI_task_parallel_thread_id(tls);
 
+  SculptBrushBatch batch;
+  batch.len = 0;
+
   BKE_pbvh_vertex_iter_begin (ss->pbvh, data->nodes[n], vd, PBVH_ITER_UNIQUE) {
     if (!sculpt_brush_test_sq_fn(&test, vd.co)) {
       continue;
     }
-    /* Offset vertex. */
-    const float fade = SCULPT_brush_strength_factor(ss,
-                                                    brush,
-                                                    vd.co,
-                                                    sqrtf(test.dist),
-                                                    vd.no,
-                                                    vd.fno,
-                                                    vd.mask ? *vd.mask : 0.0f,
-                                                    vd.index,
-                                                    thread_id);
-
-    mul_v3_v3fl(proxy[vd.i], offset, fade);
+    SCULPT_brush_batch_add(&batch, &vd, sqrtf(test.dist));
 
     if (vd.mvert) {
       BKE_pbvh_vert_mark_update(ss->pbvh, vd.index);
     }
+
+    if (batch.len == SCULPT_BRUSH_BATCH_SIZE) {
+      do_draw_brush_batch_apply(ss, brush, &batch, offset, proxy, thread_id);
+    }
   }
   BKE_pbvh_vertex_iter_end;
+
+  do_draw_brush_batch_apply(ss, brush, &batch, offset, proxy, thread_id);
 }
 
 void SCULPT_do_draw_brush(Sculpt *sd, Object *ob, PBVHNode **nodes, int totnode)
@@ -1579,6 +1592,24 @@ void SCULPT_do_layer_brush(Sculpt *sd, Object *ob, PBVHNode **nodes, int totnode
   BLI_task_parallel_range(0, totnode, &data, do_layer_brush_task_cb_ex, &settings);
 }
 
+/* Offset vertices of the batch along their normal and empty it. */
+static void do_inflate_brush_batch_apply(SculptSession *ss,
+                                         const Brush *brush,
+                                         SculptBrushBatch *batch,
+                                         float (*inflate_no)[3],
+                                         const float bstrength,
+                                         float (*proxy)[3],
+                                         const int thread_id)
+{
+  SCULPT_brush_strength_factor_batch(ss, brush, batch, thread_id);
+  for (int i = 0; i < batch->len; i++) {
+    float val[3];
+    mul_v3_v3fl(val, inflate_no[i], bstrength * batch->factor[i] * ss->cache->radius);
+    mul_v3_v3v3(proxy[batch->node_index[i]], val, ss->cache->scale);
+  }
+  batch->len = 0;
+}
+
 static void do_inflate_brush_task_cb_ex(void *__restrict userdata,
                                         const int n,
                                         const TaskParallelTLS *__restrict tls)
@@ -1598,36 +1629,29 @@ static void do_inflate_brush_task_cb_ex(void *__restrict userdata,
       ss, &test, data->brush->falloff_shape);
   const int thread_id = BLI_task_parallel_thread_id(tls);
 
+  SculptBrushBatch batch;
+  batch.len = 0;
+  /* Face normal first, unlike #SculptBrushBatch.no. */
+  float inflate_no[SCULPT_BRUSH_BATCH_SIZE][3];
+
   BKE_pbvh_vertex_iter_begin (ss->pbvh, data->nodes[n], vd, PBVH_ITER_UNIQUE) {
     if (!sculpt_brush_test_sq_fn(&test, vd.co)) {
       continue;
     }
-    const float fade = bstrength * SCULPT_brush_strength_factor(ss,
-                                                                brush,
-                                                                vd.co,
-                                                                sqrtf(test.dist),
-                                                                vd.no,
-                                                                vd.fno,
-                                                                vd.mask ? *vd.mask : 0.0f,
-                                                                vd.index,
-                                                                thread_id);
-    float val[3];
-
-    if (vd.fno) {
-      copy_v3_v3(val, vd.fno);
-    }
-    else {
-      copy_v3_v3(val, vd.no);
-    }
-
-    mul_v3_fl(val, fade * ss->cache->radius);
-    mul_v3_v3v3(proxy[vd.i], val, ss->cache->scale);
+    copy_v3_v3(inflate_no[batch.len], vd.fno ? vd.fno : vd.no);
+    SCULPT_brush_batch_add(&batch, &vd, sqrtf(test.dist));
 
     if (vd.mvert) {
       BKE_pbvh_vert_mark_update(ss->pbvh, vd.index);
     }
+
+    if (batch.len == SCULPT_BRUSH_BATCH_SIZE) {
+      do_inflate_brush_batch_apply(ss, brush, &batch, inflate_no, bstrength, proxy, thread_id);
+    }
   }
   BKE_pbvh_vertex_iter_end;
+
+  do_inflate_brush_batch_apply(ss, brush, &batch, inflate_no, bstrength, proxy, thread_id);
 }
 
 void SCULPT_do_inflate_brush(Sculpt *sd, Object *ob, PBVHNode **nodes, int totnode)
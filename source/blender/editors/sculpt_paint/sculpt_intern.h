@@ -178,6 +178,9 @@ typedef struct SculptUndoNode {
   /* Sculpt Face Sets */
   int *face_sets;
 
+  /* Arrays above compressed once the undo step is pushed, NULL while they are expanded. */
+  struct SculptUndoNodeCompressed *compressed;
+
   size_t undo_size;
 } SculptUndoNode;
 
@@ -334,6 +337,27 @@ typedef struct SculptBrushTest {
 
 typedef bool (*SculptBrushTestFn)(SculptBrushTest *test, const float co[3]);
 
+#define SCULPT_BRUSH_BATCH_SIZE 64
+
+/**
+ * Vertices inside the brush, gathered to compute their strength factor together with
+ * #SCULPT_brush_strength_factor_batch. Each factor is computed in a separate loop, with the
+ * brush settings only checked once per batch.
+ */
+typedef struct SculptBrushBatch {
+  int len;
+  float co[SCULPT_BRUSH_BATCH_SIZE][3];
+  /* Vertex normal, or face normal for grids. */
+  float no[SCULPT_BRUSH_BATCH_SIZE][3];
+  /* Distance to the brush center, used as falloff input. */
+  float dist[SCULPT_BRUSH_BATCH_SIZE];
+  float mask[SCULPT_BRUSH_BATCH_SIZE];
+  int vertex_index[SCULPT_BRUSH_BATCH_SIZE];
+  /* Index of the vertex in the node, see #PBVHVertexIter.i. */
+  int node_index[SCULPT_BRUSH_BATCH_SIZE];
+  float factor[SCULPT_BRUSH_BATCH_SIZE];
+} SculptBrushBatch;
+
 typedef struct {
   struct Sculpt *sd;
   struct SculptSession *ss;
@@ -1129,6 +1153,20 @@ float SCULPT_brush_strength_factor(struct SculptSession *ss,
                                    int vertex_index,
                                    int thread_id);
 
+/**
+ * Add a vertex that passed the brush test to the batch, \a dist being its distance to the
+ * brush center. The batch must not be full.
+ */
+void SCULPT_brush_batch_add(SculptBrushBatch *batch, const struct PBVHVertexIter *vd, float dist);
+/**
+ * Compute #SculptBrushBatch.factor of all vertices in the batch, same as
+ * #SCULPT_brush_strength_factor.
+ */
+void SCULPT_brush_strength_factor_batch(struct SculptSession *ss,
+                                        const struct Brush *br,
+                                        SculptBrushBatch *batch,
+                                        int thread_id);
+
 /**
  * Tilts a normal by the x and y tilt values using the view axis.
  */
@@ -1216,6 +1254,14 @@ enum eDynTopoWarnFlag SCULPT_dynamic_topology_check(Scene *scene, Object *ob);
 float SCULPT_automasking_factor_get(struct AutomaskingCache *automasking,
                                     SculptSession *ss,
                                     int vert);
+/**
+ * Multiply \a r_factors by the auto-masking factor of the corresponding vertices.
+ */
+void SCULPT_automasking_factor_mul_array(struct AutomaskingCache *automasking,
+                                         SculptSession *ss,
+                                         const int *verts,
+                                         int verts_num,
+                                         float *r_factors);
 
 /* Returns the automasking cache depending on the active tool. Used for code that can run both for
  * brushes and filter. */
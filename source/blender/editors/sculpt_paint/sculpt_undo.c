@@ -7,6 +7,7 @@
  */
 
 #include <stddef.h>
+#include <zstd.h>
 
 #include "MEM_guardedalloc.h"
 
@@ -52,6 +53,7 @@
 #include "ED_sculpt.h"
 #include "ED_undo.h"
 
+#include "atomic_ops.h"
 #include "bmesh.h"
 #include "sculpt_intern.h"
 
@@ -98,9 +100,25 @@ typedef struct UndoSculpt {
   ListBase nodes;
 
   size_t undo_size;
+
+  /* Background compression of the nodes arrays, NULL when finished. */
+  TaskPool *compress_pool;
 } UndoSculpt;
 
+/* See #sculpt_undo_node_compress. */
+#define SCULPT_UNDO_COMPRESS_ARRAYS_NUM 5
+#define SCULPT_UNDO_COMPRESS_LEVEL 3
+
+typedef struct SculptUndoNodeCompressed {
+  void *data;
+  size_t data_size;
+  /* Number of 32 bit values of each array, zero for arrays that are not allocated. */
+  size_t values_num[SCULPT_UNDO_COMPRESS_ARRAYS_NUM];
+} SculptUndoNodeCompressed;
+
 static UndoSculpt *sculpt_undo_get_nodes(void);
+static UndoSculpt *sculpt_undosys_step_get_nodes(UndoStep *us_p);
+static void sculpt_undo_compress_sync(UndoStack *ustack);
 
 static void update_cb(PBVHNode *node, void *rebuild)
 {
@@ -882,6 +900,11 @@ static void sculpt_undo_free_list(ListBase *lb)
       MEM_freeN(unode->face_sets);
     }
 
+    if (unode->compressed) {
+      MEM_freeN(unode->compressed->data);
+      MEM_freeN(unode->compressed);
+    }
+
     MEM_freeN(unode);
 
     unode = unode_next;
@@ -1362,6 +1385,207 @@ SculptUndoNode *SCULPT_undo_push_node(Object *ob, PBVHNode *node, SculptUndoType
   return unode;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Undo Node Compression
+ *
+ * Once their step is pushed, the coordinates, mask, color and face sets arrays of undo nodes
+ * are compressed in a background task. They are expanded while the step is applied and
+ * compressed again afterwards.
+ *
+ * Each value is XOR-ed with the same component of the previous element. Vertices of a PBVH node
+ * are close to each other, so this mostly leaves zero sign, exponent and high mantissa bits,
+ * which compress well once values are split into planes of bytes of the same significance.
+ * The coding is lossless and independent of the mesh, which may have changed outside of sculpt
+ * undo by the time the step is applied.
+ * \{ */
+
+typedef struct SculptUndoCompressArray {
+  void **data;
+  /* Number of 32 bit values per element. */
+  int components;
+  const char *name;
+} SculptUndoCompressArray;
+
+static void sculpt_undo_compress_arrays_get(
+    SculptUndoNode *unode, SculptUndoCompressArray r_arrays[SCULPT_UNDO_COMPRESS_ARRAYS_NUM])
+{
+  r_arrays[0] = (SculptUndoCompressArray){(void **)&unode->co, 3, "SculptUndoNode.co"};
+  r_arrays[1] = (SculptUndoCompressArray){(void **)&unode->orig_co, 3, "SculptUndoNode.orig_co"};
+  r_arrays[2] = (SculptUndoCompressArray){(void **)&unode->mask, 1, "SculptUndoNode.mask"};
+  r_arrays[3] = (SculptUndoCompressArray){(void **)&unode->col, 4, "SculptUndoNode.col"};
+  r_arrays[4] = (SculptUndoCompressArray){
+      (void **)&unode->face_sets, 1, "SculptUndoNode.face_sets"};
+}
+
+/**
+ * Compress the arrays of given node, returns the number of bytes freed.
+ */
+static size_t sculpt_undo_node_compress(SculptUndoNode *unode)
+{
+  BLI_assert(unode->compressed == NULL);
+
+  SculptUndoCompressArray arrays[SCULPT_UNDO_COMPRESS_ARRAYS_NUM];
+  sculpt_undo_compress_arrays_get(unode, arrays);
+
+  SculptUndoNodeCompressed compressed = {NULL};
+  size_t values_num = 0;
+  for (int i = 0; i < SCULPT_UNDO_COMPRESS_ARRAYS_NUM; i++) {
+    if (*arrays[i].data) {
+      compressed.values_num[i] = MEM_allocN_len(*arrays[i].data) / sizeof(uint32_t);
+      values_num += compressed.values_num[i];
+    }
+  }
+  if (values_num == 0) {
+    return 0;
+  }
+
+  const size_t raw_size = values_num * sizeof(uint32_t);
+  uchar *planes = MEM_mallocN(raw_size, __func__);
+  size_t offset = 0;
+  for (int i = 0; i < SCULPT_UNDO_COMPRESS_ARRAYS_NUM; i++) {
+    const uint32_t *values = *arrays[i].data;
+    const size_t components = (size_t)arrays[i].components;
+    for (size_t j = 0; j < compressed.values_num[i]; j++, offset++) {
+      const uint32_t value = j < components ? values[j] : values[j] ^ values[j - components];
+      planes[offset] = (uchar)value;
+      planes[offset + values_num] = (uchar)(value >> 8);
+      planes[offset + values_num * 2] = (uchar)(value >> 16);
+      planes[offset + values_num * 3] = (uchar)(value >> 24);
+    }
+  }
+
+  const size_t bound = ZSTD_compressBound(raw_size);
+  void *data = MEM_mallocN(bound, __func__);
+  const size_t data_size = ZSTD_compress(data, bound, planes, raw_size, SCULPT_UNDO_COMPRESS_LEVEL);
+  MEM_freeN(planes);
+
+  if (ZSTD_isError(data_size) || data_size >= raw_size) {
+    MEM_freeN(data);
+    return 0;
+  }
+
+  compressed.data = MEM_reallocN(data, data_size);
+  compressed.data_size = data_size;
+  unode->compressed = MEM_mallocN(sizeof(compressed), __func__);
+  *unode->compressed = compressed;
+
+  size_t freed_size = 0;
+  for (int i = 0; i < SCULPT_UNDO_COMPRESS_ARRAYS_NUM; i++) {
+    if (*arrays[i].data) {
+      freed_size += MEM_allocN_len(*arrays[i].data);
+      MEM_freeN(*arrays[i].data);
+      *arrays[i].data = NULL;
+    }
+  }
+  return freed_size - data_size;
+}
+
+/**
+ * Expand the arrays of given node, returns the number of bytes allocated.
+ */
+static size_t sculpt_undo_node_expand(SculptUndoNode *unode)
+{
+  SculptUndoNodeCompressed *compressed = unode->compressed;
+  if (compressed == NULL) {
+    return 0;
+  }
+
+  SculptUndoCompressArray arrays[SCULPT_UNDO_COMPRESS_ARRAYS_NUM];
+  sculpt_undo_compress_arrays_get(unode, arrays);
+
+  size_t values_num = 0;
+  for (int i = 0; i < SCULPT_UNDO_COMPRESS_ARRAYS_NUM; i++) {
+    values_num += compressed->values_num[i];
+  }
+
+  const size_t raw_size = values_num * sizeof(uint32_t);
+  uchar *planes = MEM_mallocN(raw_size, __func__);
+  const size_t size = ZSTD_decompress(planes, raw_size, compressed->data, compressed->data_size);
+  BLI_assert(size == raw_size);
+  UNUSED_VARS_NDEBUG(size);
+
+  size_t offset = 0;
+  for (int i = 0; i < SCULPT_UNDO_COMPRESS_ARRAYS_NUM; i++) {
+    if (compressed->values_num[i] == 0) {
+      continue;
+    }
+    uint32_t *values = MEM_mallocN(sizeof(uint32_t) * compressed->values_num[i], arrays[i].name);
+    const size_t components = (size_t)arrays[i].components;
+    for (size_t j = 0; j < compressed->values_num[i]; j++, offset++) {
+      const uint32_t value = (uint32_t)planes[offset] |
+                             ((uint32_t)planes[offset + values_num] << 8) |
+                             ((uint32_t)planes[offset + values_num * 2] << 16) |
+                             ((uint32_t)planes[offset + values_num * 3] << 24);
+      values[j] = j < components ? value : value ^ values[j - components];
+    }
+    *arrays[i].data = values;
+  }
+  MEM_freeN(planes);
+
+  const size_t data_size = compressed->data_size;
+  MEM_freeN(compressed->data);
+  MEM_freeN(compressed);
+  unode->compressed = NULL;
+
+  return raw_size - data_size;
+}
+
+typedef struct SculptUndoCompressTaskData {
+  UndoSculpt *usculpt;
+  SculptUndoNode *unode;
+} SculptUndoCompressTaskData;
+
+static void sculpt_undo_compress_task_cb(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  SculptUndoCompressTaskData *data = taskdata;
+  const size_t freed_size = sculpt_undo_node_compress(data->unode);
+  if (freed_size != 0) {
+    atomic_sub_and_fetch_z(&data->usculpt->undo_size, freed_size);
+  }
+}
+
+/**
+ * Compress the nodes of a pushed or applied step in the background.
+ */
+static void sculpt_undo_compress_begin(UndoSculpt *usculpt)
+{
+  BLI_assert(usculpt->compress_pool == NULL);
+
+  usculpt->compress_pool = BLI_task_pool_create_background(NULL, TASK_PRIORITY_LOW);
+  LISTBASE_FOREACH (SculptUndoNode *, unode, &usculpt->nodes) {
+    if (!ELEM(unode->type, SCULPT_UNDO_COORDS, SCULPT_UNDO_MASK, SCULPT_UNDO_COLOR) &&
+        unode->face_sets == NULL) {
+      continue;
+    }
+    SculptUndoCompressTaskData *data = MEM_mallocN(sizeof(*data), __func__);
+    data->usculpt = usculpt;
+    data->unode = unode;
+    BLI_task_pool_push(usculpt->compress_pool, sculpt_undo_compress_task_cb, data, true, NULL);
+  }
+}
+
+/**
+ * Wait for the background compression of the step nodes, must be done before accessing them.
+ */
+static void sculpt_undo_compress_end(UndoSculpt *usculpt)
+{
+  if (usculpt->compress_pool) {
+    BLI_task_pool_work_and_wait(usculpt->compress_pool);
+    BLI_task_pool_free(usculpt->compress_pool);
+    usculpt->compress_pool = NULL;
+  }
+}
+
+static void sculpt_undo_expand_list(UndoSculpt *usculpt)
+{
+  sculpt_undo_compress_end(usculpt);
+  LISTBASE_FOREACH (SculptUndoNode *, unode, &usculpt->nodes) {
+    usculpt->undo_size += sculpt_undo_node_expand(unode);
+  }
+}
+
+/** \} */
+
 void SCULPT_undo_push_begin(Object *ob, const char *name)
 {
   UndoStack *ustack = ED_undo_stack_get();
@@ -1402,7 +1626,13 @@ void SCULPT_undo_push_end_ex(const bool use_nested_undo)
   wmWindowManager *wm = G_MAIN->wm.first;
   if (wm->op_undo_depth == 0 || use_nested_undo) {
     UndoStack *ustack = ED_undo_stack_get();
+    /* Account for the compressed size of previous steps before limiting memory. */
+    sculpt_undo_compress_sync(ustack);
     BKE_undosys_step_push(ustack, NULL, NULL);
+    if (ustack->step_active && ustack->step_active->type == BKE_UNDOSYS_TYPE_SCULPT &&
+        sculpt_undosys_step_get_nodes(ustack->step_active) == usculpt) {
+      sculpt_undo_compress_begin(usculpt);
+    }
     if (wm->op_undo_depth == 0) {
       BKE_undosys_stack_limit_steps_and_memory_defaults(ustack);
     }
@@ -1454,7 +1684,9 @@ static void sculpt_undosys_step_decode_undo_impl(struct bContext *C,
                                                  SculptUndoStep *us)
 {
   BLI_assert(us->step.is_applied == true);
+  sculpt_undo_expand_list(&us->data);
   sculpt_undo_restore_list(C, depsgraph, &us->data.nodes);
+  sculpt_undo_compress_begin(&us->data);
   us->step.is_applied = false;
 }
 
@@ -1463,7 +1695,9 @@ static void sculpt_undosys_step_decode_redo_impl(struct bContext *C,
                                                  SculptUndoStep *us)
 {
   BLI_assert(us->step.is_applied == false);
+  sculpt_undo_expand_list(&us->data);
   sculpt_undo_restore_list(C, depsgraph, &us->data.nodes);
+  sculpt_undo_compress_begin(&us->data);
   us->step.is_applied = true;
 }
 
@@ -1567,9 +1801,23 @@ static void sculpt_undosys_step_decode(
 static void sculpt_undosys_step_free(UndoStep *us_p)
 {
   SculptUndoStep *us = (SculptUndoStep *)us_p;
+  sculpt_undo_compress_end(&us->data);
   sculpt_undo_free_list(&us->data.nodes);
 }
 
+static void sculpt_undo_compress_sync(UndoStack *ustack)
+{
+  LISTBASE_FOREACH (UndoStep *, us_p, &ustack->steps) {
+    if (us_p->type == BKE_UNDOSYS_TYPE_SCULPT) {
+      SculptUndoStep *us = (SculptUndoStep *)us_p;
+      if (us->data.compress_pool) {
+        sculpt_undo_compress_end(&us->data);
+        us->step.data_size = us->data.undo_size;
+      }
+    }
+  }
+}
+
 void ED_sculpt_undo_geometry_begin(struct Object *ob, const char *name)
 {
   SCULPT_undo_push_begin(ob, name);
@@ -1077,9 +1077,10 @@ void ED_spacetype_file(void)
 
 void ED_file_init(void)
 {
-  ED_file_read_bookmarks();
-
+  /* Reading the system bookmarks accesses all mounted volumes, only do that when there can be a
+   * file browser. `WM_OT_read_history` still reads them on demand. */
   if (G.background == false) {
+    ED_file_read_bookmarks();
     filelist_init_icons();
   }
 
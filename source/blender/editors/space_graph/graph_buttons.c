@@ -998,6 +998,22 @@ static void graph_draw_driver_settings_panel(uiLayout *layout,
       }
       else {
         uiItemL(col, TIP_("Slow Python expression"), ICON_INFO);
+
+        const char *error = BKE_driver_simple_expression_error(driver);
+        if (error != NULL) {
+          char error_str[64];
+          if (*error == '\0') {
+            BLI_strncpy(
+                error_str, TIP_("Not a simple expression: unexpected end"), sizeof(error_str));
+          }
+          else {
+            BLI_snprintf(error_str,
+                         sizeof(error_str),
+                         TIP_("Not a simple expression at: %.24s"),
+                         error);
+          }
+          uiItemL(col, error_str, ICON_NONE);
+        }
       }
     }
 
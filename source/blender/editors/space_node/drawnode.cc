@@ -1645,6 +1645,14 @@ bool node_link_bezier_handles(const View2D *v2d,
   if (v2d && max_ffff(vec[0][0], vec[1][0], vec[2][0], vec[3][0]) < v2d->cur.xmin) {
     return false; /* clipped */
   }
+  /* The curve is inside the convex hull of its control points, so links above or below the
+   * view can be skipped as well. In big trees most links are outside of the view. */
+  if (v2d && min_ffff(vec[0][1], vec[1][1], vec[2][1], vec[3][1]) > v2d->cur.ymax) {
+    return false; /* clipped */
+  }
+  if (v2d && max_ffff(vec[0][1], vec[1][1], vec[2][1], vec[3][1]) < v2d->cur.ymin) {
+    return false; /* clipped */
+  }
 
   return true;
 }
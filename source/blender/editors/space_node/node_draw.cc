@@ -24,6 +24,7 @@
 #include "BLI_map.hh"
 #include "BLI_set.hh"
 #include "BLI_span.hh"
+#include "BLI_string.h"
 #include "BLI_string_ref.hh"
 #include "BLI_vector.hh"
 #include "BLI_vector_set.hh"
@@ -1589,18 +1590,8 @@ static std::chrono::microseconds node_get_execution_time(const bNodeTree &ntree,
   return exec_time;
 }
 
-static std::string node_get_execution_time_label(const SpaceNode &snode, const bNode &node)
+static std::string execution_time_label(const uint64_t exec_time_us)
 {
-  int node_count = 0;
-  std::chrono::microseconds exec_time = node_get_execution_time(
-      *snode.nodetree, node, snode, node_count);
-
-  if (node_count == 0) {
-    return std::string("");
-  }
-
-  uint64_t exec_time_us = exec_time.count();
-
   /* Don't show time if execution time is 0 microseconds. */
   if (exec_time_us == 0) {
     return std::string("-");
@@ -1623,13 +1614,58 @@ static std::string node_get_execution_time_label(const SpaceNode &snode, const b
   return stream.str() + " ms";
 }
 
+static std::string node_get_execution_time_label(const SpaceNode &snode, const bNode &node)
+{
+  int node_count = 0;
+  std::chrono::microseconds exec_time = node_get_execution_time(
+      *snode.nodetree, node, snode, node_count);
+
+  if (node_count == 0) {
+    return std::string("");
+  }
+
+  return execution_time_label(exec_time.count());
+}
+
 struct NodeExtraInfoRow {
   std::string text;
   const char *tooltip;
   int icon;
 };
 
-static Vector<NodeExtraInfoRow> node_get_extra_info(const SpaceNode &snode, const bNode &node)
+static void node_get_compositor_execution_stats(const SpaceNode &snode,
+                                                bNodeInstanceKey key,
+                                                Vector<NodeExtraInfoRow> &rows)
+{
+  const bNodeExecutionStats *stats = BKE_node_execution_stats_get(snode.nodetree, key);
+  if (stats == nullptr) {
+    return;
+  }
+
+  NodeExtraInfoRow time_row;
+  time_row.text = execution_time_label(stats->time_us);
+  time_row.tooltip = TIP_(
+      "The execution time from the compositor's latest execution. For group nodes, the time for "
+      "all sub-nodes");
+  time_row.icon = ICON_PREVIEW_RANGE;
+  rows.append(std::move(time_row));
+
+  if (stats->mem_size > 0) {
+    char mem_str[15];
+    BLI_str_format_byte_unit(mem_str, stats->mem_size, false);
+    NodeExtraInfoRow mem_row;
+    mem_row.text = mem_str;
+    mem_row.tooltip = TIP_(
+        "The memory of the node results from the compositor's latest execution. For group "
+        "nodes, the memory for all sub-nodes");
+    mem_row.icon = ICON_MEMORY;
+    rows.append(std::move(mem_row));
+  }
+}
+
+static Vector<NodeExtraInfoRow> node_get_extra_info(const SpaceNode &snode,
+                                                    const bNode &node,
+                                                    bNodeInstanceKey key)
 {
   Vector<NodeExtraInfoRow> rows;
   if (!(snode.overlay.flag & SN_OVERLAY_SHOW_OVERLAYS)) {
@@ -1649,6 +1685,9 @@ static Vector<NodeExtraInfoRow> node_get_extra_info(const SpaceNode &snode, cons
       rows.append(std::move(row));
     }
   }
+  if (snode.overlay.flag & SN_OVERLAY_SHOW_TIMINGS && snode.edittree->type == NTREE_COMPOSIT) {
+    node_get_compositor_execution_stats(snode, key, rows);
+  }
   const geo_log::NodeLog *node_log = geo_log::ModifierLog::find_node_by_node_editor_context(snode,
                                                                                             node);
   if (node_log != nullptr) {
@@ -1704,9 +1743,12 @@ static void node_draw_extra_info_row(const bNode &node,
   }
 }
 
-static void node_draw_extra_info_panel(const SpaceNode &snode, const bNode &node, uiBlock &block)
+static void node_draw_extra_info_panel(const SpaceNode &snode,
+                                       const bNode &node,
+                                       uiBlock &block,
+                                       bNodeInstanceKey key)
 {
-  Vector<NodeExtraInfoRow> extra_info_rows = node_get_extra_info(snode, node);
+  Vector<NodeExtraInfoRow> extra_info_rows = node_get_extra_info(snode, node, key);
 
   if (extra_info_rows.size() == 0) {
     return;
@@ -1784,7 +1826,7 @@ static void node_draw_basis(const bContext &C,
 
   GPU_line_width(1.0f);
 
-  node_draw_extra_info_panel(snode, node, block);
+  node_draw_extra_info_panel(snode, node, block, key);
 
   /* Header. */
   {
@@ -2510,7 +2552,8 @@ static void frame_node_draw(const bContext &C,
                             const SpaceNode &snode,
                             bNodeTree &ntree,
                             bNode &node,
-                            uiBlock &block)
+                            uiBlock &block,
+                            bNodeInstanceKey key)
 {
   /* skip if out of view */
   if (BLI_rctf_isect(&node.totr, &region.v2d.cur, nullptr) == false) {
@@ -2552,7 +2595,7 @@ static void frame_node_draw(const bContext &C,
   /* label and text */
   frame_node_draw_label(ntree, node, snode);
 
-  node_draw_extra_info_panel(snode, node, block);
+  node_draw_extra_info_panel(snode, node, block, key);
 
   UI_block_end(&C, &block);
   UI_block_draw(&C, &block);
@@ -2608,7 +2651,7 @@ static void node_draw(const bContext &C,
                       bNodeInstanceKey key)
 {
   if (node.type == NODE_FRAME) {
-    frame_node_draw(C, region, snode, ntree, node, block);
+    frame_node_draw(C, region, snode, ntree, node, block, key);
   }
   else if (node.type == NODE_REROUTE) {
     reroute_node_draw(C, region, ntree, node, block);
@@ -73,6 +73,7 @@ using namespace blender::ed::outliner;
 
 /* prototypes */
 static int outliner_exclude_filter_get(const SpaceOutliner *space_outliner);
+static bool outliner_filter_excludes_object_type(int exclude_filter, const Object *ob);
 
 /* -------------------------------------------------------------------- */
 /** \name Persistent Data
@@ -278,11 +279,28 @@ static void outliner_add_line_styles(SpaceOutliner *space_outliner,
 #endif
 
 /* Can be inlined if necessary. */
+/**
+ * Filtering removes all elements directly below an object that aren't objects, when object
+ * contents are filtered out or the object itself is (only its child objects are kept then).
+ * Don't build them in the first place, which is much of the tree in scenes with many objects.
+ */
+static bool outliner_filter_excludes_object_contents(const SpaceOutliner *space_outliner,
+                                                     const Object *ob)
+{
+  const int exclude_filter = outliner_exclude_filter_get(space_outliner);
+  return (exclude_filter & SO_FILTER_NO_OB_CONTENT) ||
+         outliner_filter_excludes_object_type(exclude_filter, ob);
+}
+
 static void outliner_add_object_contents(SpaceOutliner *space_outliner,
                                          TreeElement *te,
                                          TreeStoreElem *tselem,
                                          Object *ob)
 {
+  if (outliner_filter_excludes_object_contents(space_outliner, ob)) {
+    return;
+  }
+
   if (outliner_animdata_test(ob->adt)) {
     outliner_add_element(space_outliner, &te->subtree, ob, te, TSE_ANIM_DATA, 0);
   }
@@ -1401,6 +1419,31 @@ static int outliner_exclude_filter_get(const SpaceOutliner *space_outliner)
   return exclude_filter;
 }
 
+static bool outliner_filter_excludes_object_type(const int exclude_filter, const Object *ob)
+{
+  if ((exclude_filter & SO_FILTER_OB_TYPE) == SO_FILTER_OB_TYPE) {
+    return true;
+  }
+  if ((exclude_filter & SO_FILTER_OB_TYPE) == 0) {
+    return false;
+  }
+
+  switch (ob->type) {
+    case OB_MESH:
+      return exclude_filter & SO_FILTER_NO_OB_MESH;
+    case OB_ARMATURE:
+      return exclude_filter & SO_FILTER_NO_OB_ARMATURE;
+    case OB_EMPTY:
+      return exclude_filter & SO_FILTER_NO_OB_EMPTY;
+    case OB_LAMP:
+      return exclude_filter & SO_FILTER_NO_OB_LAMP;
+    case OB_CAMERA:
+      return exclude_filter & SO_FILTER_NO_OB_CAMERA;
+    default:
+      return exclude_filter & SO_FILTER_NO_OB_OTHERS;
+  }
+}
+
 static bool outliner_element_visible_get(ViewLayer *view_layer,
                                          TreeElement *te,
                                          const int exclude_filter)
@@ -1411,47 +1454,12 @@ static bool outliner_element_visible_get(ViewLayer *view_layer,
 
   TreeStoreElem *tselem = TREESTORE(te);
   if ((tselem->type == TSE_SOME_ID) && (te->idcode == ID_OB)) {
-    if ((exclude_filter & SO_FILTER_OB_TYPE) == SO_FILTER_OB_TYPE) {
-      return false;
-    }
-
     Object *ob = (Object *)tselem->id;
     Base *base = (Base *)te->directdata;
     BLI_assert((base == nullptr) || (base->object == ob));
 
-    if (exclude_filter & SO_FILTER_OB_TYPE) {
-      switch (ob->type) {
-        case OB_MESH:
-          if (exclude_filter & SO_FILTER_NO_OB_MESH) {
-            return false;
-          }
-          break;
-        case OB_ARMATURE:
-          if (exclude_filter & SO_FILTER_NO_OB_ARMATURE) {
-            return false;
-          }
-          break;
-        case OB_EMPTY:
-          if (exclude_filter & SO_FILTER_NO_OB_EMPTY) {
-            return false;
-          }
-          break;
-        case OB_LAMP:
-          if (exclude_filter & SO_FILTER_NO_OB_LAMP) {
-            return false;
-          }
-          break;
-        case OB_CAMERA:
-          if (exclude_filter & SO_FILTER_NO_OB_CAMERA) {
-            return false;
-          }
-          break;
-        default:
-          if (exclude_filter & SO_FILTER_NO_OB_OTHERS) {
-            return false;
-          }
-          break;
-      }
+    if (outliner_filter_excludes_object_type(exclude_filter, ob)) {
+      return false;
     }
 
     if (exclude_filter & SO_FILTER_OB_STATE) {
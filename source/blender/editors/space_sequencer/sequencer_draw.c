@@ -39,6 +39,7 @@
 #include "GPU_immediate_util.h"
 #include "GPU_matrix.h"
 #include "GPU_state.h"
+#include "GPU_texture.h"
 #include "GPU_vertex_buffer.h"
 #include "GPU_viewport.h"
 
@@ -1754,7 +1755,11 @@ static void *sequencer_OCIO_transform_ibuf(const bContext *C,
   void *display_buffer;
   bool force_fallback = false;
   *r_glsl_used = false;
-  force_fallback |= (ED_draw_imbuf_method(ibuf) != IMAGE_DRAW_METHOD_GLSL);
+  /* The texture of buffers that are displayed with GLSL is kept while they are displayed (see
+   * #sequencer_display_texture_ensure), so unlike for #ED_draw_imbuf_method the size
+   * of the buffer doesn't matter. Changing the view transform or look then doesn't need a CPU
+   * display transform or another upload. */
+  force_fallback |= (U.image_draw_method == IMAGE_DRAW_METHOD_2DTEXTURE);
   force_fallback |= (ibuf->dither != 0.0f);
 
   /* Default */
@@ -1871,6 +1876,57 @@ static void sequencer_preview_get_rect(rctf *preview,
   }
 }
 
+void sequencer_display_texture_free(SpaceSeq *sseq)
+{
+  SpaceSeqRuntime *runtime = &sseq->runtime;
+  if (runtime->display_texture) {
+    GPU_texture_free(runtime->display_texture);
+    runtime->display_texture = NULL;
+  }
+  if (runtime->display_texture_ibuf) {
+    IMB_freeImBuf(runtime->display_texture_ibuf);
+    runtime->display_texture_ibuf = NULL;
+  }
+}
+
+/**
+ * Return a texture with the \a display_buffer. When \a use_cache is true, the buffer doesn't
+ * depend on the view settings, and the texture is kept until a different buffer is displayed.
+ * Otherwise the returned texture has to be freed by the caller.
+ */
+static GPUTexture *sequencer_display_texture_ensure(SpaceSeq *sseq,
+                                                    ImBuf *ibuf,
+                                                    eGPUTextureFormat format,
+                                                    eGPUDataFormat data,
+                                                    void *display_buffer,
+                                                    const bool use_cache)
+{
+  SpaceSeqRuntime *runtime = &sseq->runtime;
+
+  if (!use_cache) {
+    GPUTexture *texture = GPU_texture_create_2d(
+        "seq_display_buf", ibuf->x, ibuf->y, 1, format, NULL);
+    GPU_texture_update(texture, data, display_buffer);
+    return texture;
+  }
+
+  /* The buffer is referenced while its texture is kept, so the pointer can't be reused by
+   * another buffer. Buffers with changed pixels are tagged to update their display buffers. */
+  if (runtime->display_texture && runtime->display_texture_ibuf == ibuf &&
+      GPU_texture_format(runtime->display_texture) == format &&
+      (ibuf->userflags & IB_DISPLAY_BUFFER_INVALID) == 0) {
+    return runtime->display_texture;
+  }
+
+  sequencer_display_texture_free(sseq);
+  runtime->display_texture = GPU_texture_create_2d(
+      "seq_display_buf", ibuf->x, ibuf->y, 1, format, NULL);
+  GPU_texture_update(runtime->display_texture, data, display_buffer);
+  IMB_refImBuf(ibuf);
+  runtime->display_texture_ibuf = ibuf;
+  return runtime->display_texture;
+}
+
 static void sequencer_draw_display_buffer(const bContext *C,
                                           Scene *scene,
                                           ARegion *region,
@@ -1920,9 +1976,11 @@ static void sequencer_draw_display_buffer(const bContext *C,
     GPU_matrix_identity_projection_set();
   }
 
-  GPUTexture *texture = GPU_texture_create_2d(
-      "seq_display_buf", ibuf->x, ibuf->y, 1, format, NULL);
-  GPU_texture_update(texture, data, display_buffer);
+  /* The buffers that are transformed with GLSL contain the linear (or byte) pixels of the image
+   * buffer, which don't change with the view settings. */
+  const bool use_texture_cache = glsl_used && scope == NULL;
+  GPUTexture *texture = sequencer_display_texture_ensure(
+      sseq, ibuf, format, data, display_buffer, use_texture_cache);
   GPU_texture_filter_mode(texture, false);
 
   GPU_texture_bind(texture, 0);
@@ -1960,7 +2018,9 @@ static void sequencer_draw_display_buffer(const bContext *C,
   immEnd();
 
   GPU_texture_unbind(texture);
-  GPU_texture_free(texture);
+  if (!use_texture_cache) {
+    GPU_texture_free(texture);
+  }
 
   if (!glsl_used) {
     immUnbindProgram();
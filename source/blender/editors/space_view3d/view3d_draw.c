@@ -2511,6 +2511,32 @@ void ED_scene_draw_fps(const Scene *scene, int xoffset, int *yoffset)
 
   BLF_draw_default(xoffset, *yoffset, 0.0f, printable, sizeof(printable));
 
+  /* When playback can't keep up, show where the time of a frame goes. */
+  if (fps + 0.5f < (float)(FPS)) {
+    float eval_time = 0.0f, sync_time = 0.0f;
+    for (int i = 0; i < REDRAW_FRAME_AVERAGE; i++) {
+      eval_time += fpsi->eval_times[i];
+      sync_time += fpsi->sync_times[i];
+    }
+    eval_time *= 1000.0f / REDRAW_FRAME_AVERAGE;
+    sync_time *= 1000.0f / REDRAW_FRAME_AVERAGE;
+    /* The rest of the frame is mostly spent drawing. */
+    const float draw_time = max_ff((fps > 0.0f ? 1000.0f / fps : 0.0f) - eval_time - sync_time,
+                                   0.0f);
+
+    char info[128];
+    BLI_snprintf(info,
+                 sizeof(info),
+                 IFACE_("eval: %.1f ms, draw: %.1f ms, sync: %.1f ms, skipped: %d"),
+                 eval_time,
+                 draw_time,
+                 sync_time,
+                 fpsi->skipped_frames);
+
+    *yoffset -= VIEW3D_OVERLAY_LINEHEIGHT;
+    BLF_draw_default(xoffset, *yoffset, 0.0f, info, sizeof(info));
+  }
+
   BLF_disable(font_id, BLF_SHADOW);
 }
 
@@ -845,11 +845,12 @@ static bool motionpath_need_update_object(Scene *scene, Object *ob)
    *      this should be a better fix for T24451 and T37755
    */
 
-  if (autokeyframe_cfra_can_key(scene, &ob->id)) {
-    return (ob->avs.path_bakeflag & MOTIONPATH_BAKE_HAS_PATHS) != 0;
+  /* Check the flag first, finding keys on the current frame isn't free. */
+  if ((ob->avs.path_bakeflag & MOTIONPATH_BAKE_HAS_PATHS) == 0) {
+    return false;
   }
 
-  return false;
+  return autokeyframe_cfra_can_key(scene, &ob->id);
 }
 
 /** \} */
@@ -886,7 +887,9 @@ void recalcData_objects(TransInfo *t)
         autokeyframe_object(t->context, t->scene, t->view_layer, ob, t->mode);
       }
 
-      motionpath_update |= motionpath_need_update_object(t->scene, ob);
+      if (!motionpath_update) {
+        motionpath_update = motionpath_need_update_object(t->scene, ob);
+      }
 
       /* sets recalc flags fully, instead of flushing existing ones
        * otherwise proxies don't function correctly
@@ -10,6 +10,7 @@
 #include "BLI_math.h"
 #include "BLI_math_bits.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 
 #include "BKE_armature.h"
 #include "BKE_context.h"
@@ -29,6 +30,13 @@
 /** \name Transform (Mirror)
  * \{ */
 
+struct ElemMirrorData {
+  TransInfo *t;
+  TransDataContainer *tc;
+  int axis;
+  bool flip;
+};
+
 /**
  * Mirrors an object by negating the scale of the object on the mirror axis, reflecting the
  * location and adjusting the rotation.
@@ -151,9 +159,48 @@ static void ElementMirror(TransInfo *t, TransDataContainer *tc, TransData *td, i
   }
 }
 
+static void element_mirror_fn(void *__restrict iter_data_v,
+                              const int iter,
+                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  struct ElemMirrorData *data = iter_data_v;
+  TransData *td = &data->tc->data[iter];
+  if (td->flag & TD_SKIP) {
+    return;
+  }
+  ElementMirror(data->t, data->tc, td, data->axis, data->flip);
+}
+
+static void transdata_mirror_all(TransInfo *t, const int axis, const bool flip)
+{
+  FOREACH_TRANS_DATA_CONTAINER (t, tc) {
+    if (tc->data_len < TRANSDATA_THREAD_LIMIT) {
+      TransData *td = tc->data;
+      for (int i = 0; i < tc->data_len; i++, td++) {
+        if (td->flag & TD_SKIP) {
+          continue;
+        }
+
+        ElementMirror(t, tc, td, axis, flip);
+      }
+    }
+    else {
+      struct ElemMirrorData data = {
+          .t = t,
+          .tc = tc,
+          .axis = axis,
+          .flip = flip,
+      };
+
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      BLI_task_parallel_range(0, tc->data_len, &data, element_mirror_fn, &settings);
+    }
+  }
+}
+
 static void applyMirror(TransInfo *t, const int UNUSED(mval[2]))
 {
-  int i;
   char str[UI_MAX_DRAW_STR];
   copy_v3_v3(t->values_final, t->values);
 
@@ -177,32 +224,14 @@ static void applyMirror(TransInfo *t, const int UNUSED(mval[2]))
 
     BLI_snprintf(str, sizeof(str), TIP_("Mirror%s"), t->con.text);
 
-    FOREACH_TRANS_DATA_CONTAINER (t, tc) {
-      TransData *td = tc->data;
-      for (i = 0; i < tc->data_len; i++, td++) {
-        if (td->flag & TD_SKIP) {
-          continue;
-        }
-
-        ElementMirror(t, tc, td, special_axis, bitmap_len >= 2);
-      }
-    }
+    transdata_mirror_all(t, special_axis, bitmap_len >= 2);
 
     recalcData(t);
 
     ED_area_status_text(t->area, str);
   }
   else {
-    FOREACH_TRANS_DATA_CONTAINER (t, tc) {
-      TransData *td = tc->data;
-      for (i = 0; i < tc->data_len; i++, td++) {
-        if (td->flag & TD_SKIP) {
-          continue;
-        }
-
-        ElementMirror(t, tc, td, -1, false);
-      }
-    }
+    transdata_mirror_all(t, -1, false);
 
     recalcData(t);
 
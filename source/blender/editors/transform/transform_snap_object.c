@@ -83,6 +83,13 @@ typedef struct SnapObjectData {
   };
 } SnapObjectData;
 
+/** An object to snap to, with the matrix of the instance it is evaluated for. */
+typedef struct SnapObjectCandidate {
+  Object *ob_eval;
+  float obmat[4][4];
+  bool is_object_active;
+} SnapObjectCandidate;
+
 struct SnapObjectContext {
   Scene *scene;
 
@@ -119,6 +126,13 @@ struct SnapObjectContext {
     short clip_plane_len;
     short snap_to_flag;
     bool has_occlusion_plane; /* Ignore plane of occlusion in curves. */
+
+    /**
+     * When not NULL, the objects to snap to, gathered once for the passes of one snap.
+     * See #snap_objects_gather.
+     */
+    SnapObjectCandidate *objects;
+    int objects_len;
   } runtime;
 };
 
@@ -448,6 +462,19 @@ static void iter_snap_objects(SnapObjectContext *sctx,
                               IterSnapObjsCallback sob_callback,
                               void *data)
 {
+  if (sctx->runtime.objects != NULL) {
+    for (int i = 0; i < sctx->runtime.objects_len; i++) {
+      SnapObjectCandidate *candidate = &sctx->runtime.objects[i];
+      sob_callback(sctx,
+                   params,
+                   candidate->ob_eval,
+                   candidate->obmat,
+                   candidate->is_object_active,
+                   data);
+    }
+    return;
+  }
+
   ViewLayer *view_layer = DEG_get_input_view_layer(sctx->runtime.depsgraph);
   const eSnapSelect snap_select = params->snap_select;
 
@@ -504,6 +531,48 @@ static void iter_snap_objects(SnapObjectContext *sctx,
   }
 }
 
+static void snap_object_candidate_add(SnapObjectContext *sctx,
+                                      const struct SnapObjectParams *UNUSED(params),
+                                      Object *ob_eval,
+                                      float obmat[4][4],
+                                      bool is_object_active,
+                                      void *data)
+{
+  int *objects_alloc_len = data;
+  if (sctx->runtime.objects_len == *objects_alloc_len) {
+    *objects_alloc_len = max_ii(*objects_alloc_len * 2, 64);
+    sctx->runtime.objects = MEM_reallocN(sctx->runtime.objects,
+                                         sizeof(*sctx->runtime.objects) * *objects_alloc_len);
+  }
+  SnapObjectCandidate *candidate = &sctx->runtime.objects[sctx->runtime.objects_len++];
+  candidate->ob_eval = ob_eval;
+  copy_m4_m4(candidate->obmat, obmat);
+  candidate->is_object_active = is_object_active;
+}
+
+/**
+ * Walk through the objects once and store them, so that following calls to #iter_snap_objects
+ * don't have to filter the bases and create the dupli-lists of instancers again.
+ * Call #snap_objects_clear when done.
+ */
+static void snap_objects_gather(SnapObjectContext *sctx, const struct SnapObjectParams *params)
+{
+  BLI_assert(sctx->runtime.objects == NULL);
+  int objects_alloc_len = 0;
+  sctx->runtime.objects_len = 0;
+  iter_snap_objects(sctx, params, snap_object_candidate_add, &objects_alloc_len);
+  if (sctx->runtime.objects == NULL) {
+    /* Still use the (empty) list. */
+    sctx->runtime.objects = MEM_mallocN(sizeof(*sctx->runtime.objects), __func__);
+  }
+}
+
+static void snap_objects_clear(SnapObjectContext *sctx)
+{
+  MEM_SAFE_FREE(sctx->runtime.objects);
+  sctx->runtime.objects_len = 0;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -3042,10 +3111,20 @@ static short transform_snap_context_project_view3d_mixed_impl(
 
   bool use_occlusion_test = params->use_occlusion_test && !XRAY_ENABLED(v3d);
 
-  if (snap_to_flag & SCE_SNAP_MODE_FACE || use_occlusion_test) {
+  const bool use_ray = (snap_to_flag & SCE_SNAP_MODE_FACE) || use_occlusion_test;
+  const bool use_nearest = (snap_to_flag &
+                            (SCE_SNAP_MODE_VERTEX | SCE_SNAP_MODE_EDGE |
+                             SCE_SNAP_MODE_EDGE_MIDPOINT | SCE_SNAP_MODE_EDGE_PERPENDICULAR)) != 0;
+  if (use_ray && use_nearest) {
+    /* Both passes go over the same objects. */
+    snap_objects_gather(sctx, params);
+  }
+
+  if (use_ray) {
     float ray_start[3], ray_normal[3];
     if (!ED_view3d_win_to_ray_clipped_ex(
             depsgraph, region, v3d, mval, NULL, ray_normal, ray_start, true)) {
+      snap_objects_clear(sctx);
       return 0;
     }
 
@@ -3088,8 +3167,7 @@ static short transform_snap_context_project_view3d_mixed_impl(
     }
   }
 
-  if (snap_to_flag & (SCE_SNAP_MODE_VERTEX | SCE_SNAP_MODE_EDGE | SCE_SNAP_MODE_EDGE_MIDPOINT |
-                      SCE_SNAP_MODE_EDGE_PERPENDICULAR)) {
+  if (use_nearest) {
     short elem_test, elem = 0;
     float dist_px_tmp = *dist_px;
 
@@ -3183,6 +3261,8 @@ static short transform_snap_context_project_view3d_mixed_impl(
     }
   }
 
+  snap_objects_clear(sctx);
+
   return retval;
 }
 
@@ -89,6 +89,17 @@ static bool memfile_undosys_step_encode(struct bContext *UNUSED(C),
   us->data = BKE_memfile_undo_encode(bmain, us_prev ? us_prev->data : NULL);
   us->step.data_size = us->data->undo_size;
 
+  if (us_prev != NULL) {
+    /* The previous step is not used as reference for new steps anymore. Its size may also have
+     * changed because it was decompressed to be used as reference for the new step. */
+    MemFile *memfile_prev = &us_prev->data->memfile;
+    if (USER_EXPERIMENTAL_TEST(&U, use_undo_compression)) {
+      BLO_memfile_compress(memfile_prev);
+    }
+    us_prev->data->undo_size = memfile_prev->size;
+    us_prev->step.data_size = us_prev->data->undo_size;
+  }
+
   /* Store the fact that we should not re-use old data with that undo step, and reset the Main
    * flag. */
   us->step.use_old_bmain_data = !bmain->use_memfile_full_barrier;
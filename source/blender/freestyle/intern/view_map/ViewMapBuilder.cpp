@@ -26,6 +26,8 @@
 
 #include "BKE_global.h"
 
+#include "BLI_task.hh"
+
 namespace Freestyle {
 
 // XXX Grmll... G is used as template's typename parameter :/
@@ -409,6 +411,45 @@ static int computeVisibility(ViewMap *viewMap,
   return qi;
 }
 
+// Call fn with every ViewEdge. The ViewEdges are handled in parallel, in chunks of about one
+// percent of all edges, so that the render monitor is only used from the calling thread: progress
+// is reported and the break test is done between the chunks.
+template<typename Fn>
+static void foreachViewEdgeParallel(vector<ViewEdge *> &vedges,
+                                    RenderMonitor *iRenderMonitor,
+                                    bool reportProgress,
+                                    const Fn &fn)
+{
+  const int64_t count_step = max<int64_t>(int64_t(ceil(0.01f * vedges.size())), 1);
+  int64_t count = 0;
+  while (count < int64_t(vedges.size())) {
+    if (iRenderMonitor) {
+      if (iRenderMonitor->testBreak()) {
+        break;
+      }
+      if (reportProgress) {
+        stringstream ss;
+        ss << "Freestyle: Visibility computations " << (100 * count / vedges.size()) << "%";
+        iRenderMonitor->setInfo(ss.str());
+        iRenderMonitor->progress((float)count / vedges.size());
+      }
+    }
+    const blender::IndexRange chunk(count, min<int64_t>(count_step, vedges.size() - count));
+    blender::threading::parallel_for(chunk, 16, [&](const blender::IndexRange range) {
+      for (const int64_t i : range) {
+        fn(vedges[i]);
+      }
+    });
+    count += chunk.size();
+  }
+  if (iRenderMonitor && reportProgress && !vedges.empty()) {
+    stringstream ss;
+    ss << "Freestyle: Visibility computations " << (100 * count / vedges.size()) << "%";
+    iRenderMonitor->setInfo(ss.str());
+    iRenderMonitor->progress((float)count / vedges.size());
+  }
+}
+
 // computeCumulativeVisibility returns the lowest x such that the majority of FEdges have QI <= x
 //
 // This was probably the original intention of the "normal" algorithm on which
@@ -426,50 +467,38 @@ static void computeCumulativeVisibility(ViewMap *ioViewMap,
 {
   vector<ViewEdge *> &vedges = ioViewMap->ViewEdges();
 
-  FEdge *fe, *festart;
-  int nSamples = 0;
-  vector<WFace *> wFaces;
-  WFace *wFace = nullptr;
-  unsigned count = 0;
-  unsigned count_step = (unsigned)ceil(0.01f * vedges.size());
-  unsigned tmpQI = 0;
-  unsigned qiClasses[256];
-  unsigned maxIndex, maxCard;
-  unsigned qiMajority;
-  for (vector<ViewEdge *>::iterator ve = vedges.begin(), veend = vedges.end(); ve != veend; ve++) {
-    if (iRenderMonitor) {
-      if (iRenderMonitor->testBreak()) {
-        break;
-      }
-      if (count % count_step == 0) {
-        stringstream ss;
-        ss << "Freestyle: Visibility computations " << (100 * count / vedges.size()) << "%";
-        iRenderMonitor->setInfo(ss.str());
-        iRenderMonitor->progress((float)count / vedges.size());
-      }
-      count++;
-    }
+  // The grid is only read by its iterators, and every ViewEdge only writes to itself and to its
+  // FEdges, so the ViewEdges can be tested in parallel.
+  foreachViewEdgeParallel(vedges, iRenderMonitor, true, [&](ViewEdge *ve) {
+    FEdge *fe, *festart;
+    int nSamples = 0;
+    vector<WFace *> wFaces;
+    WFace *wFace = nullptr;
+    unsigned tmpQI = 0;
+    unsigned qiClasses[256];
+    unsigned maxIndex, maxCard;
+    unsigned qiMajority;
 #if LOGGING
     if (_global.debug & G_DEBUG_FREESTYLE) {
-      cout << "Processing ViewEdge " << (*ve)->getId() << endl;
+      cout << "Processing ViewEdge " << ve->getId() << endl;
     }
 #endif
     // Find an edge to test
-    if (!(*ve)->isInImage()) {
+    if (!ve->isInImage()) {
       // This view edge has been proscenium culled
-      (*ve)->setQI(255);
-      (*ve)->setaShape(nullptr);
+      ve->setQI(255);
+      ve->setaShape(nullptr);
 #if LOGGING
       if (_global.debug & G_DEBUG_FREESTYLE) {
         cout << "\tCulled." << endl;
       }
 #endif
-      continue;
+      return;
     }
 
     // Test edge
-    festart = (*ve)->fedgeA();
-    fe = (*ve)->fedgeA();
+    festart = ve->fedgeA();
+    fe = ve->fedgeA();
     qiMajority = 0;
     do {
       if (fe != nullptr && fe->isInImage()) {
@@ -482,13 +511,13 @@ static void computeCumulativeVisibility(ViewMap *ioViewMap,
       // There are no occludable FEdges on this ViewEdge
       // This should be impossible.
       if (_global.debug & G_DEBUG_FREESTYLE) {
-        cout << "View Edge in viewport without occludable FEdges: " << (*ve)->getId() << endl;
+        cout << "View Edge in viewport without occludable FEdges: " << ve->getId() << endl;
       }
       // We can recover from this error:
       // Treat this edge as fully visible with no occludee
-      (*ve)->setQI(0);
-      (*ve)->setaShape(nullptr);
-      continue;
+      ve->setQI(0);
+      ve->setaShape(nullptr);
+      return;
     }
 
     ++qiMajority;
@@ -507,7 +536,7 @@ static void computeCumulativeVisibility(ViewMap *ioViewMap,
     memset(qiClasses, 0, 256 * sizeof(*qiClasses));
     set<ViewShape *> foundOccluders;
 
-    fe = (*ve)->fedgeA();
+    fe = ve->fedgeA();
     do {
       if (!fe || !fe->isInImage()) {
         fe = fe->nextEdge();
@@ -516,7 +545,7 @@ static void computeCumulativeVisibility(ViewMap *ioViewMap,
       if (maxCard < qiMajority) {
         // ARB: change &wFace to wFace and use reference in called function
         tmpQI = computeVisibility<G, I>(
-            ioViewMap, fe, grid, epsilon, *ve, &wFace, &foundOccluders);
+            ioViewMap, fe, grid, epsilon, ve, &wFace, &foundOccluders);
 #if LOGGING
         if (_global.debug & G_DEBUG_FREESTYLE) {
           cout << "\tFEdge: visibility " << tmpQI << endl;
@@ -539,7 +568,7 @@ static void computeCumulativeVisibility(ViewMap *ioViewMap,
       else {
         // ARB: FindOccludee is redundant if ComputeRayCastingVisibility has been called
         // ARB: change &wFace to wFace and use reference in called function
-        findOccludee<G, I>(fe, grid, epsilon, *ve, &wFace);
+        findOccludee<G, I>(fe, grid, epsilon, ve, &wFace);
 #if LOGGING
         if (_global.debug & G_DEBUG_FREESTYLE) {
           cout << "\tFEdge: occludee only (" << (wFace != NULL ? "found" : "not found") << ")"
@@ -585,7 +614,7 @@ static void computeCumulativeVisibility(ViewMap *ioViewMap,
     for (unsigned count = 0, i = 0; i < 256; ++i) {
       count += qiClasses[i];
       if (count >= qiMajority) {
-        (*ve)->setQI(i);
+        ve->setQI(i);
         break;
       }
     }
@@ -595,11 +624,11 @@ static void computeCumulativeVisibility(ViewMap *ioViewMap,
     for (set<ViewShape *>::iterator o = foundOccluders.begin(), oend = foundOccluders.end();
          o != oend;
          ++o) {
-      (*ve)->AddOccluder((*o));
+      ve->AddOccluder((*o));
     }
 #if LOGGING
     if (_global.debug & G_DEBUG_FREESTYLE) {
-      cout << "\tConclusion: QI = " << maxIndex << ", " << (*ve)->occluders_size() << " occluders."
+      cout << "\tConclusion: QI = " << maxIndex << ", " << ve->occluders_size() << " occluders."
            << endl;
     }
 #else
@@ -608,23 +637,15 @@ static void computeCumulativeVisibility(ViewMap *ioViewMap,
     // occludee --
     if (!wFaces.empty()) {
       if (wFaces.size() <= (float)nSamples / 2.0f) {
-        (*ve)->setaShape(nullptr);
+        ve->setaShape(nullptr);
       }
       else {
         ViewShape *vshape = ioViewMap->viewShape(
             (*wFaces.begin())->GetVertex(0)->shape()->GetId());
-        (*ve)->setaShape(vshape);
+        ve->setaShape(vshape);
       }
     }
-
-    wFaces.clear();
-  }
-  if (iRenderMonitor && !vedges.empty()) {
-    stringstream ss;
-    ss << "Freestyle: Visibility computations " << (100 * count / vedges.size()) << "%";
-    iRenderMonitor->setInfo(ss.str());
-    iRenderMonitor->progress((float)count / vedges.size());
-  }
+  });
 }
 
 template<typename G, typename I>
@@ -635,39 +656,36 @@ static void computeDetailedVisibility(ViewMap *ioViewMap,
 {
   vector<ViewEdge *> &vedges = ioViewMap->ViewEdges();
 
-  FEdge *fe, *festart;
-  int nSamples = 0;
-  vector<WFace *> wFaces;
-  WFace *wFace = nullptr;
-  unsigned tmpQI = 0;
-  unsigned qiClasses[256];
-  unsigned maxIndex, maxCard;
-  unsigned qiMajority;
-  for (vector<ViewEdge *>::iterator ve = vedges.begin(), veend = vedges.end(); ve != veend; ve++) {
-    if (iRenderMonitor && iRenderMonitor->testBreak()) {
-      break;
-    }
+  foreachViewEdgeParallel(vedges, iRenderMonitor, false, [&](ViewEdge *ve) {
+    FEdge *fe, *festart;
+    int nSamples = 0;
+    vector<WFace *> wFaces;
+    WFace *wFace = nullptr;
+    unsigned tmpQI = 0;
+    unsigned qiClasses[256];
+    unsigned maxIndex, maxCard;
+    unsigned qiMajority;
 #if LOGGING
     if (_global.debug & G_DEBUG_FREESTYLE) {
-      cout << "Processing ViewEdge " << (*ve)->getId() << endl;
+      cout << "Processing ViewEdge " << ve->getId() << endl;
     }
 #endif
     // Find an edge to test
-    if (!(*ve)->isInImage()) {
+    if (!ve->isInImage()) {
       // This view edge has been proscenium culled
-      (*ve)->setQI(255);
-      (*ve)->setaShape(nullptr);
+      ve->setQI(255);
+      ve->setaShape(nullptr);
 #if LOGGING
       if (_global.debug & G_DEBUG_FREESTYLE) {
         cout << "\tCulled." << endl;
       }
 #endif
-      continue;
+      return;
     }
 
     // Test edge
-    festart = (*ve)->fedgeA();
-    fe = (*ve)->fedgeA();
+    festart = ve->fedgeA();
+    fe = ve->fedgeA();
     qiMajority = 0;
     do {
       if (fe != nullptr && fe->isInImage()) {
@@ -680,13 +698,13 @@ static void computeDetailedVisibility(ViewMap *ioViewMap,
       // There are no occludable FEdges on this ViewEdge
       // This should be impossible.
       if (_global.debug & G_DEBUG_FREESTYLE) {
-        cout << "View Edge in viewport without occludable FEdges: " << (*ve)->getId() << endl;
+        cout << "View Edge in viewport without occludable FEdges: " << ve->getId() << endl;
       }
       // We can recover from this error:
       // Treat this edge as fully visible with no occludee
-      (*ve)->setQI(0);
-      (*ve)->setaShape(nullptr);
-      continue;
+      ve->setQI(0);
+      ve->setaShape(nullptr);
+      return;
     }
 
     ++qiMajority;
@@ -705,7 +723,7 @@ static void computeDetailedVisibility(ViewMap *ioViewMap,
     memset(qiClasses, 0, 256 * sizeof(*qiClasses));
     set<ViewShape *> foundOccluders;
 
-    fe = (*ve)->fedgeA();
+    fe = ve->fedgeA();
     do {
       if (fe == nullptr || !fe->isInImage()) {
         fe = fe->nextEdge();
@@ -714,7 +732,7 @@ static void computeDetailedVisibility(ViewMap *ioViewMap,
       if (maxCard < qiMajority) {
         // ARB: change &wFace to wFace and use reference in called function
         tmpQI = computeVisibility<G, I>(
-            ioViewMap, fe, grid, epsilon, *ve, &wFace, &foundOccluders);
+            ioViewMap, fe, grid, epsilon, ve, &wFace, &foundOccluders);
 #if LOGGING
         if (_global.debug & G_DEBUG_FREESTYLE) {
           cout << "\tFEdge: visibility " << tmpQI << endl;
@@ -737,7 +755,7 @@ static void computeDetailedVisibility(ViewMap *ioViewMap,
       else {
         // ARB: FindOccludee is redundant if ComputeRayCastingVisibility has been called
         // ARB: change &wFace to wFace and use reference in called function
-        findOccludee<G, I>(fe, grid, epsilon, *ve, &wFace);
+        findOccludee<G, I>(fe, grid, epsilon, ve, &wFace);
 #if LOGGING
         if (_global.debug & G_DEBUG_FREESTYLE) {
           cout << "\tFEdge: occludee only (" << (wFace != NULL ? "found" : "not found") << ")"
@@ -779,35 +797,33 @@ static void computeDetailedVisibility(ViewMap *ioViewMap,
 
     // ViewEdge
     // qi --
-    (*ve)->setQI(maxIndex);
+    ve->setQI(maxIndex);
     // occluders --
     // I would rather not have to go through the effort of creating this this set and then copying
     // out its contents. Is there a reason why ViewEdge::_Occluders cannot be converted to a set<>?
     for (set<ViewShape *>::iterator o = foundOccluders.begin(), oend = foundOccluders.end();
          o != oend;
          ++o) {
-      (*ve)->AddOccluder((*o));
+      ve->AddOccluder((*o));
     }
 #if LOGGING
     if (_global.debug & G_DEBUG_FREESTYLE) {
-      cout << "\tConclusion: QI = " << maxIndex << ", " << (*ve)->occluders_size() << " occluders."
+      cout << "\tConclusion: QI = " << maxIndex << ", " << ve->occluders_size() << " occluders."
            << endl;
     }
 #endif
     // occludee --
     if (!wFaces.empty()) {
       if (wFaces.size() <= (float)nSamples / 2.0f) {
-        (*ve)->setaShape(nullptr);
+        ve->setaShape(nullptr);
       }
       else {
         ViewShape *vshape = ioViewMap->viewShape(
             (*wFaces.begin())->GetVertex(0)->shape()->GetId());
-        (*ve)->setaShape(vshape);
+        ve->setaShape(vshape);
       }
     }
-
-    wFaces.clear();
-  }
+  });
 }
 
 template<typename G, typename I>
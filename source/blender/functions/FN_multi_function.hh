@@ -55,6 +55,19 @@ class MultiFunction {
   void call_auto(IndexMask mask, MFParams params, MFContext context) const;
   virtual void call(IndexMask mask, MFParams params, MFContext context) const = 0;
 
+  /**
+   * Call the function only for the indices in the given slice of the mask. The indices are offset
+   * so that they start at zero, and the parameters are sliced accordingly. This allows the
+   * function to work with temporary arrays that are only as large as the slice.
+   * This is only possible when #supports_offset_slicing returns true.
+   */
+  void call_on_offset_slice(IndexMask mask,
+                            IndexRange mask_slice,
+                            MFParams params,
+                            MFContext context) const;
+  /** Vector parameters cannot be sliced currently. */
+  static bool supports_offset_slicing(const MultiFunction &fn);
+
   virtual uint64_t hash() const
   {
     return get_default_hash(this);
@@ -15,6 +15,11 @@ class MFProcedureExecutor : public MultiFunction {
  private:
   MFSignature signature_;
   const MFProcedure &procedure_;
+  /**
+   * Large masks are processed in chunks of this size, so that the intermediate buffers of all
+   * variables fit into the CPU cache. Zero when the procedure cannot be executed in chunks.
+   */
+  int64_t chunk_size_ = 0;
 
  public:
   MFProcedureExecutor(const MFProcedure &procedure);
@@ -22,6 +27,7 @@ class MFProcedureExecutor : public MultiFunction {
   void call(IndexMask mask, MFParams params, MFContext context) const override;
 
  private:
+  void execute_procedure(IndexMask full_mask, MFParams params, MFContext context) const;
   ExecutionHints get_execution_hints() const override;
 };
 
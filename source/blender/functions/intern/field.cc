@@ -1,9 +1,11 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_linear_allocator.hh"
 #include "BLI_map.hh"
 #include "BLI_multi_value_map.hh"
 #include "BLI_set.hh"
 #include "BLI_stack.hh"
+#include "BLI_task.hh"
 #include "BLI_vector_set.hh"
 
 #include "FN_field.hh"
@@ -273,6 +275,76 @@ static void build_multi_function_procedure_for_fields(MFProcedure &procedure,
   BLI_assert(procedure.validate());
 }
 
+/**
+ * Number of indices that are evaluated at once when the results have to be copied into virtual
+ * arrays that are not spans.
+ */
+static constexpr int64_t field_evaluation_chunk_size = 4096;
+
+/**
+ * Evaluate the procedure for a slice of the mask. Results for outputs in #output_buffers are
+ * written into those buffers directly. Results for #indirect_outputs are computed into a
+ * temporary buffer that is only as large as the chunk, and are then moved into the corresponding
+ * destination virtual arrays.
+ */
+static void evaluate_procedure_chunk(const MFProcedureExecutor &procedure_executor,
+                                     const IndexMask mask,
+                                     const IndexRange mask_slice,
+                                     Span<GVArray> inputs,
+                                     Span<GFieldRef> fields,
+                                     Span<void *> output_buffers,
+                                     Span<int> indirect_outputs,
+                                     Span<GVMutableArray> indirect_dst_varrays)
+{
+  const IndexMask sliced_mask = mask.slice(mask_slice);
+  if (sliced_mask.is_empty()) {
+    return;
+  }
+  const IndexRange slice_range{sliced_mask[0], sliced_mask.last() - sliced_mask[0] + 1};
+
+  Vector<int64_t> offset_mask_indices;
+  const IndexMask offset_mask = mask.slice_and_offset(mask_slice, offset_mask_indices);
+
+  MFParamsBuilder mf_params{procedure_executor, &offset_mask};
+  MFContextBuilder mf_context;
+
+  for (const GVArray &varray : inputs) {
+    mf_params.add_readonly_single_input(varray.slice(slice_range));
+  }
+
+  LinearAllocator<> allocator;
+  Array<void *> chunk_buffers(fields.size(), nullptr);
+  for (const int i : indirect_outputs) {
+    const CPPType &type = fields[i].cpp_type();
+    chunk_buffers[i] = allocator.allocate(type.size() * slice_range.size(), type.alignment());
+  }
+
+  for (const int i : fields.index_range()) {
+    const CPPType &type = fields[i].cpp_type();
+    if (chunk_buffers[i] == nullptr) {
+      mf_params.add_uninitialized_single_output(
+          GMutableSpan{type, output_buffers[i], mask.min_array_size()}.slice(slice_range));
+    }
+    else {
+      mf_params.add_uninitialized_single_output({type, chunk_buffers[i], slice_range.size()});
+    }
+  }
+
+  procedure_executor.call(offset_mask, mf_params, mf_context);
+
+  /* Move the computed values into their final destination. This also destructs the values in
+   * the temporary buffers. */
+  for (const int indirect_index : indirect_outputs.index_range()) {
+    const int i = indirect_outputs[indirect_index];
+    GVMutableArray dst_varray = indirect_dst_varrays[indirect_index];
+    const CPPType &type = fields[i].cpp_type();
+    for (const int64_t offset_index : offset_mask) {
+      void *value = POINTER_OFFSET(chunk_buffers[i], type.size() * offset_index);
+      dst_varray.set_by_relocate(slice_range.start() + offset_index, value);
+    }
+  }
+}
+
 Vector<GVArray> evaluate_fields(ResourceScope &scope,
                                 Span<GFieldRef> fields_to_evaluate,
                                 IndexMask mask,
@@ -368,13 +440,12 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
         procedure, scope, field_tree_info, varying_fields_to_evaluate);
     MFProcedureExecutor procedure_executor{procedure};
 
-    MFParamsBuilder mf_params{procedure_executor, &mask};
-    MFContextBuilder mf_context;
-
-    /* Provide inputs to the procedure executor. */
-    for (const GVArray &varray : field_context_inputs) {
-      mf_params.add_readonly_single_input(varray);
-    }
+    /* Buffers that the procedure writes the results into. They span the entire domain. */
+    Array<void *> output_buffers(varying_fields_to_evaluate.size(), nullptr);
+    /* Outputs whose destination is not a span, so they can't be passed to the procedure
+     * directly. */
+    Vector<int> indirect_outputs;
+    Vector<GVMutableArray> indirect_dst_varrays;
 
     for (const int i : varying_fields_to_evaluate.index_range()) {
       const GFieldRef &field = varying_fields_to_evaluate[i];
@@ -383,10 +454,10 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
 
       /* Try to get an existing virtual array that the result should be written into. */
       GVMutableArray dst_varray = get_dst_varray(out_index);
-      void *buffer;
-      if (!dst_varray || !dst_varray.is_span()) {
+      if (!dst_varray) {
         /* Allocate a new buffer for the computed result. */
-        buffer = scope.linear_allocator().allocate(type.size() * array_size, type.alignment());
+        void *buffer = scope.linear_allocator().allocate(type.size() * array_size,
+                                                          type.alignment());
 
         if (!type.is_trivially_destructible()) {
           /* Destruct values in the end. */
@@ -395,21 +466,60 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
         }
 
         r_varrays[out_index] = GVArray::ForSpan({type, buffer, array_size});
+        output_buffers[i] = buffer;
       }
-      else {
+      else if (dst_varray.is_span()) {
         /* Write the result into the existing span. */
-        buffer = dst_varray.get_internal_span().data();
-
+        output_buffers[i] = dst_varray.get_internal_span().data();
+        r_varrays[out_index] = dst_varray;
+        is_output_written_to_dst[out_index] = true;
+      }
+      else {
+        /* The result is copied into the destination chunk by chunk below. */
+        indirect_outputs.append(i);
+        indirect_dst_varrays.append(dst_varray);
         r_varrays[out_index] = dst_varray;
         is_output_written_to_dst[out_index] = true;
       }
-
-      /* Pass output buffer to the procedure executor. */
-      const GMutableSpan span{type, buffer, array_size};
-      mf_params.add_uninitialized_single_output(span);
     }
 
-    procedure_executor.call_auto(mask, mf_params, mf_context);
+    if (indirect_outputs.is_empty()) {
+      MFParamsBuilder mf_params{procedure_executor, &mask};
+      MFContextBuilder mf_context;
+
+      /* Provide inputs to the procedure executor. */
+      for (const GVArray &varray : field_context_inputs) {
+        mf_params.add_readonly_single_input(varray);
+      }
+      /* Pass output buffers to the procedure executor. */
+      for (const int i : varying_fields_to_evaluate.index_range()) {
+        const CPPType &type = varying_fields_to_evaluate[i].cpp_type();
+        mf_params.add_uninitialized_single_output({type, output_buffers[i], array_size});
+      }
+
+      procedure_executor.call_auto(mask, mf_params, mf_context);
+    }
+    else {
+      /* Evaluate the fields in chunks, so that the temporary buffers for indirect outputs only
+       * have to be as large as a chunk instead of as large as the entire domain. */
+      BLI_assert(MultiFunction::supports_offset_slicing(procedure_executor));
+      threading::parallel_for(
+          mask.index_range(), field_evaluation_chunk_size, [&](const IndexRange range) {
+            for (int64_t start = range.start(); start < range.one_after_last();
+                 start += field_evaluation_chunk_size) {
+              const IndexRange chunk{
+                  start, std::min(field_evaluation_chunk_size, range.one_after_last() - start)};
+              evaluate_procedure_chunk(procedure_executor,
+                                       mask,
+                                       chunk,
+                                       field_context_inputs,
+                                       varying_fields_to_evaluate,
+                                       output_buffers,
+                                       indirect_outputs,
+                                       indirect_dst_varrays);
+            }
+          });
+    }
   }
 
   /* Evaluate constant fields if necessary. */
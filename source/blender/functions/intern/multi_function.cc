@@ -83,52 +83,79 @@ void MultiFunction::call_auto(IndexMask mask, MFParams params, MFContext context
       this->call(sliced_mask, params, context);
       return;
     }
-    const int64_t input_slice_start = sliced_mask[0];
-    const int64_t input_slice_size = sliced_mask.last() - input_slice_start + 1;
-    const IndexRange input_slice_range{input_slice_start, input_slice_size};
-
-    Vector<int64_t> offset_mask_indices;
-    const IndexMask offset_mask = mask.slice_and_offset(sub_range, offset_mask_indices);
-
-    MFParamsBuilder offset_params{*this, offset_mask.min_array_size()};
-
-    /* Slice all parameters so that for the actual function call. */
-    for (const int param_index : this->param_indices()) {
-      const MFParamType param_type = this->param_type(param_index);
-      switch (param_type.category()) {
-        case MFParamType::SingleInput: {
-          const GVArray &varray = params.readonly_single_input(param_index);
-          offset_params.add_readonly_single_input(varray.slice(input_slice_range));
-          break;
+    if (!supports_offset_slicing(*this)) {
+      this->call(sliced_mask, params, context);
+      return;
+    }
+    this->call_on_offset_slice(mask, sub_range, params, context);
+  });
+}
+
+bool MultiFunction::supports_offset_slicing(const MultiFunction &fn)
+{
+  for (const int i : fn.param_indices()) {
+    if (fn.param_type(i).data_type().is_vector()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void MultiFunction::call_on_offset_slice(const IndexMask mask,
+                                         const IndexRange mask_slice,
+                                         MFParams params,
+                                         MFContext context) const
+{
+  BLI_assert(supports_offset_slicing(*this));
+  const IndexMask sliced_mask = mask.slice(mask_slice);
+  if (sliced_mask.is_empty()) {
+    return;
+  }
+  const int64_t input_slice_start = sliced_mask[0];
+  const int64_t input_slice_size = sliced_mask.last() - input_slice_start + 1;
+  const IndexRange input_slice_range{input_slice_start, input_slice_size};
+
+  Vector<int64_t> offset_mask_indices;
+  const IndexMask offset_mask = mask.slice_and_offset(mask_slice, offset_mask_indices);
+
+  MFParamsBuilder offset_params{*this, offset_mask.min_array_size()};
+
+  /* Slice all parameters so that for the actual function call. */
+  for (const int param_index : this->param_indices()) {
+    const MFParamType param_type = this->param_type(param_index);
+    switch (param_type.category()) {
+      case MFParamType::SingleInput: {
+        const GVArray &varray = params.readonly_single_input(param_index);
+        offset_params.add_readonly_single_input(varray.slice(input_slice_range));
+        break;
+      }
+      case MFParamType::SingleMutable: {
+        const GMutableSpan span = params.single_mutable(param_index);
+        const GMutableSpan sliced_span = span.slice(input_slice_range);
+        offset_params.add_single_mutable(sliced_span);
+        break;
+      }
+      case MFParamType::SingleOutput: {
+        const GMutableSpan span = params.uninitialized_single_output_if_required(param_index);
+        if (span.is_empty()) {
+          offset_params.add_ignored_single_output();
         }
-        case MFParamType::SingleMutable: {
-          const GMutableSpan span = params.single_mutable(param_index);
+        else {
           const GMutableSpan sliced_span = span.slice(input_slice_range);
-          offset_params.add_single_mutable(sliced_span);
-          break;
-        }
-        case MFParamType::SingleOutput: {
-          const GMutableSpan span = params.uninitialized_single_output_if_required(param_index);
-          if (span.is_empty()) {
-            offset_params.add_ignored_single_output();
-          }
-          else {
-            const GMutableSpan sliced_span = span.slice(input_slice_range);
-            offset_params.add_uninitialized_single_output(sliced_span);
-          }
-          break;
-        }
-        case MFParamType::VectorInput:
-        case MFParamType::VectorMutable:
-        case MFParamType::VectorOutput: {
-          BLI_assert_unreachable();
-          break;
+          offset_params.add_uninitialized_single_output(sliced_span);
         }
+        break;
+      }
+      case MFParamType::VectorInput:
+      case MFParamType::VectorMutable:
+      case MFParamType::VectorOutput: {
+        BLI_assert_unreachable();
+        break;
       }
     }
+  }
 
-    this->call(offset_mask, offset_params, context);
-  });
+  this->call(offset_mask, offset_params, context);
 }
 
 std::string MultiFunction::debug_name() const
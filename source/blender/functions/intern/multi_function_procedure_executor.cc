@@ -2,6 +2,8 @@
 
 #include "FN_multi_function_procedure_executor.hh"
 
+#include <algorithm>
+
 #include "BLI_stack.hh"
 
 namespace blender::fn {
@@ -16,6 +18,27 @@ MFProcedureExecutor::MFProcedureExecutor(const MFProcedure &procedure) : procedu
 
   signature_ = signature.build();
   this->set_signature(&signature_);
+
+  if (supports_offset_slicing(*this)) {
+    /* Estimate how much memory is needed per index when all variables have a buffer. In practice
+     * fewer buffers are needed at the same time, because buffers of destructed variables are
+     * reused, so this is conservative. */
+    int64_t bytes_per_index = 0;
+    for (const MFVariable *variable : procedure.variables()) {
+      const MFDataType data_type = variable->data_type();
+      if (data_type.is_vector()) {
+        /* Vector variables are stored in separately allocated arrays anyway. */
+        bytes_per_index = 0;
+        break;
+      }
+      bytes_per_index += data_type.single_type().size();
+    }
+    if (bytes_per_index > 0) {
+      /* Roughly the size of a per-core L2 cache. */
+      const int64_t cache_budget = 256 * 1024;
+      chunk_size_ = std::clamp<int64_t>(cache_budget / bytes_per_index, 1024, 16384);
+    }
+  }
 }
 
 using IndicesSplitVectors = std::array<Vector<int64_t>, 2>;
@@ -1167,6 +1190,26 @@ void MFProcedureExecutor::call(IndexMask full_mask, MFParams params, MFContext c
 {
   BLI_assert(procedure_.validate());
 
+  if (chunk_size_ == 0 || full_mask.size() <= chunk_size_) {
+    this->execute_procedure(full_mask, params, context);
+    return;
+  }
+
+  /* Run all instructions on one chunk of the mask before continuing with the next one. That way,
+   * intermediate values are still in the cache when the next instruction reads them, instead of
+   * every instruction streaming arrays that are as large as the entire mask through memory. */
+  for (int64_t start = 0; start < full_mask.size(); start += chunk_size_) {
+    const IndexRange chunk = full_mask.index_range().slice(
+        start, std::min(chunk_size_, full_mask.size() - start));
+    /* This will call #execute_procedure directly, because the offset mask is small enough. */
+    this->call_on_offset_slice(full_mask, chunk, params, context);
+  }
+}
+
+void MFProcedureExecutor::execute_procedure(IndexMask full_mask,
+                                            MFParams params,
+                                            MFContext context) const
+{
   LinearAllocator<> linear_allocator;
 
   VariableStates variable_states{linear_allocator, full_mask};
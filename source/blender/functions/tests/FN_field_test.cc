@@ -155,6 +155,60 @@ TEST(field, TwoFunctions)
   EXPECT_EQ(result[8], 26);
 }
 
+static int get_first(const std::array<int, 2> &item)
+{
+  return item[0];
+}
+
+static void set_first(std::array<int, 2> &item, int value)
+{
+  item[0] = value;
+}
+
+TEST(field, LargeDomainIndirectDestination)
+{
+  GField index_field{std::make_shared<IndexFieldInput>()};
+
+  std::unique_ptr<MultiFunction> add_fn = std::make_unique<CustomMF_SI_SI_SO<int, int, int>>(
+      "add", [](int a, int b) { return a + b; });
+  GField add_field{std::make_shared<FieldOperation>(
+                       FieldOperation(std::move(add_fn), {index_field, index_field})),
+                   0};
+
+  /* The domain is much larger than the chunks that are used for evaluation. */
+  const int size = 100000;
+  Vector<int64_t> indices;
+  for (const int i : IndexRange(size)) {
+    if (i % 3 != 0) {
+      indices.append(i);
+    }
+  }
+  const IndexMask mask{indices};
+
+  Array<std::array<int, 2>> items(size, {-1, -1});
+  Array<int> result_span(size, -1);
+
+  FieldContext context;
+  FieldEvaluator evaluator{context, &mask};
+  evaluator.add_with_destination(
+      Field<int>(add_field),
+      VMutableArray<int>::ForDerivedSpan<std::array<int, 2>, get_first, set_first>(items));
+  evaluator.add_with_destination(index_field, result_span.as_mutable_span());
+  evaluator.evaluate();
+
+  for (const int i : IndexRange(size)) {
+    if (i % 3 == 0) {
+      EXPECT_EQ(items[i][0], -1);
+      EXPECT_EQ(result_span[i], -1);
+    }
+    else {
+      EXPECT_EQ(items[i][0], 2 * i);
+      EXPECT_EQ(result_span[i], i);
+    }
+    EXPECT_EQ(items[i][1], -1);
+  }
+}
+
 class TwoOutputFunction : public MultiFunction {
  private:
   MFSignature signature_;
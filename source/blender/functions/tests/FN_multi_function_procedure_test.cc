@@ -378,4 +378,65 @@ TEST(multi_function_procedure, BufferReuse)
   EXPECT_EQ(results[4], 53);
 }
 
+TEST(multi_function_procedure, LargeMaskChunks)
+{
+  /**
+   * procedure(int a, int b, int *out) {
+   *   int c = a + b;
+   *   out = c + 10;
+   * }
+   */
+
+  CustomMF_SI_SI_SO<int, int, int> add_fn{"add", [](int a, int b) { return a + b; }};
+  CustomMF_SI_SO<int, int> add_10_fn{"add 10", [](int a) { return a + 10; }};
+
+  MFProcedure procedure;
+  MFProcedureBuilder builder{procedure};
+
+  MFVariable *var_a = &builder.add_single_input_parameter<int>();
+  MFVariable *var_b = &builder.add_single_input_parameter<int>();
+  auto [var_c] = builder.add_call<1>(add_fn, {var_a, var_b});
+  builder.add_destruct({var_a, var_b});
+  auto [var_out] = builder.add_call<1>(add_10_fn, {var_c});
+  builder.add_destruct(*var_c);
+  builder.add_return();
+  builder.add_output_parameter(*var_out);
+
+  EXPECT_TRUE(procedure.validate());
+
+  MFProcedureExecutor procedure_fn{procedure};
+
+  /* Use a mask that is large enough to be split into multiple chunks and that does not contain
+   * every index. */
+  const int size = 100000;
+  Vector<int64_t> mask_indices;
+  for (const int i : IndexRange(size)) {
+    if (i % 3 != 0) {
+      mask_indices.append(i);
+    }
+  }
+  Array<int> inputs(size);
+  for (const int i : IndexRange(size)) {
+    inputs[i] = i;
+  }
+  Array<int> results(size, -1);
+
+  MFParamsBuilder params{procedure_fn, size};
+  params.add_readonly_single_input(inputs.as_span());
+  params.add_readonly_single_input_value(5);
+  params.add_uninitialized_single_output(results.as_mutable_span());
+
+  MFContextBuilder context;
+  procedure_fn.call(mask_indices.as_span(), params, context);
+
+  for (const int i : IndexRange(size)) {
+    if (i % 3 == 0) {
+      EXPECT_EQ(results[i], -1);
+    }
+    else {
+      EXPECT_EQ(results[i], i + 15);
+    }
+  }
+}
+
 }  // namespace blender::fn::tests
@@ -0,0 +1,107 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include <array>
+
+#include "BLI_array.hh"
+#include "BLI_index_mask.hh"
+#include "BLI_math_vec_types.hh"
+#include "BLI_span.hh"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+
+struct MVert;
+
+/** \file
+ * \ingroup geo
+ */
+
+namespace blender::geometry {
+
+/**
+ * A uniform grid of the cells that contain points, with cells at least as large as a distance,
+ * so that the points within that distance of a point are in its cell or in one of the 26
+ * neighboring cells. Unlike a KD-tree, it is built in parallel and looking up the points near
+ * every point of a cell at once is cheap.
+ *
+ * The points are indices into the selection the grid is built from.
+ */
+class PointGrid {
+ private:
+  double3 min_;
+  double cell_size_;
+  /** Sorted keys of the cells that contain points. */
+  Array<int64_t> cell_keys_;
+  /** The range in #points_ of every cell, with an extra element for the end of the last cell. */
+  Array<int> cell_offsets_;
+  /** Indices into the selection, sorted by cell and by index within cells. */
+  Array<int> points_;
+  /** The cell of every index in the selection. */
+  Array<int> point_cells_;
+
+ public:
+  PointGrid(Span<float3> positions, IndexMask selection, float distance);
+  PointGrid(Span<MVert> verts, IndexMask selection, float distance);
+
+  int cells_num() const
+  {
+    return int(cell_keys_.size());
+  }
+
+  Span<int> cell_points(const int cell) const
+  {
+    return points_.as_span().slice(cell_offsets_[cell],
+                                   cell_offsets_[cell + 1] - cell_offsets_[cell]);
+  }
+
+  int point_cell(const int point) const
+  {
+    return point_cells_[point];
+  }
+
+  /**
+   * Find the cells next to \a cell, including the cell itself.
+   */
+  void neighbor_cells(int cell, Vector<int, 27> &r_cells) const;
+
+  /**
+   * Call \a fn with every cell and its neighbor cells, in parallel. Consecutive cells are
+   * handled together, which makes finding the neighbors cheaper than with #neighbor_cells.
+   */
+  template<typename Fn> void foreach_cell_with_neighbors(const Fn &fn) const
+  {
+    threading::parallel_for(cell_keys_.index_range(), 256, [&](const IndexRange range) {
+      std::array<int64_t, 9> cursors;
+      for (const int row : IndexRange(9)) {
+        cursors[row] = this->row_cursor(range.first(), row);
+      }
+      Vector<int, 27> neighbor_cells;
+      for (const int cell : range) {
+        neighbor_cells.clear();
+        for (const int row : IndexRange(9)) {
+          this->append_row_cells(cell, row, cursors[row], neighbor_cells);
+        }
+        fn(cell, neighbor_cells.as_span());
+      }
+    });
+  }
+
+ private:
+  template<typename PositionFn>
+  void build(const PositionFn &position_fn, IndexMask selection, float distance);
+
+  /**
+   * Neighbor cells are found in 9 rows of three consecutive keys, which only differ in the last
+   * axis. Return the index of the first cell with a key that isn't smaller than the first key in
+   * the \a row of \a cell.
+   */
+  int64_t row_cursor(int cell, int row) const;
+  /**
+   * Append the cells in the \a row of \a cell, moving the \a cursor forward to its first cell.
+   * The cursor can be reused for the next cell, since the keys are sorted.
+   */
+  void append_row_cells(int cell, int row, int64_t &cursor, Vector<int, 27> &r_cells) const;
+};
+
+}  // namespace blender::geometry
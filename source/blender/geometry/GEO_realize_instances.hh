@@ -2,6 +2,10 @@
 
 #pragma once
 
+#include <optional>
+
+#include "BLI_set.hh"
+
 #include "BKE_geometry_set.hh"
 
 namespace blender::geometry {
@@ -19,6 +23,13 @@ struct RealizeInstancesOptions {
    * instances. Otherwise, instance attributes are ignored.
    */
   bool realize_instance_attributes = true;
+  /**
+   * When set, only the named generic attributes in this set are propagated to the output, all
+   * other named attributes are skipped. Realizing is much cheaper when only few attributes are
+   * needed afterwards. Anonymous attributes and attributes that are required for a valid geometry
+   * (like positions) are not affected. The `id` attribute is only created when it is in the set.
+   */
+  std::optional<Set<std::string>> attributes_to_propagate;
 };
 
 /**
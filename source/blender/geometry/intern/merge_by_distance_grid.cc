@@ -0,0 +1,184 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <algorithm>
+
+#include "BLI_array.hh"
+#include "BLI_atomic_disjoint_set.hh"
+#include "BLI_math_vector.h"
+#include "BLI_task.hh"
+#include "BLI_utildefines.h"
+#include "BLI_vector.hh"
+
+#include "DNA_meshdata_types.h"
+
+#include "GEO_point_grid.hh"
+
+#include "merge_by_distance_grid.hh"
+
+#ifdef WITH_TBB
+#  include <tbb/parallel_sort.h>
+#endif
+
+namespace blender::geometry {
+
+template<typename T> static void sort_parallel(MutableSpan<T> values)
+{
+#ifdef WITH_TBB
+  tbb::parallel_sort(values.begin(), values.end());
+#else
+  std::sort(values.begin(), values.end());
+#endif
+}
+
+template<typename PositionFn>
+static int find_duplicates(const PositionFn &position_fn,
+                           const PointGrid &grid,
+                           const IndexMask selection,
+                           const float merge_distance,
+                           MutableSpan<int> r_dest_map)
+{
+  const float merge_dist_sq = square_f(merge_distance);
+
+  /* Find the points with other points in range, and join the cells of all pairs in range. Only
+   * one pair is needed to join two cells, so that many coincident points stay fast. */
+  Array<bool> has_neighbors(selection.size(), false);
+  AtomicDisjointSet cell_sets(grid.cells_num());
+  grid.foreach_cell_with_neighbors([&](const int cell, const Span<int> neighbor_cells) {
+    for (const int point : grid.cell_points(cell)) {
+      const float *position = position_fn(selection[point]);
+      for (const int neighbor_cell : neighbor_cells) {
+        if (has_neighbors[point] && cell_sets.in_same_set(cell, neighbor_cell)) {
+          continue;
+        }
+        for (const int other : grid.cell_points(neighbor_cell)) {
+          if (other != point &&
+              len_squared_v3v3(position, position_fn(selection[other])) <= merge_dist_sq) {
+            has_neighbors[point] = true;
+            cell_sets.join(cell, neighbor_cell);
+            break;
+          }
+        }
+      }
+    }
+  });
+
+  /* Points in range of each other are in the same group of cells now. Group the points that
+   * have neighbors by the root cell, in order of their index. */
+  Array<int64_t> point_groups(selection.size());
+  threading::parallel_for(selection.index_range(), 4096, [&](const IndexRange range) {
+    for (const int point : range) {
+      point_groups[point] = has_neighbors[point] ?
+                                (int64_t(cell_sets.find_root(grid.point_cell(point))) << 32) |
+                                    point :
+                                -1;
+    }
+  });
+  Vector<int64_t> group_points;
+  for (const int64_t group_point : point_groups) {
+    if (group_point != -1) {
+      group_points.append(group_point);
+    }
+  }
+  if (group_points.is_empty()) {
+    return 0;
+  }
+  sort_parallel(group_points.as_mutable_span());
+  Vector<int> group_offsets;
+  for (const int i : group_points.index_range()) {
+    if (i == 0 || (group_points[i] >> 32) != (group_points[i - 1] >> 32)) {
+      group_offsets.append(i);
+    }
+  }
+  group_offsets.append(group_points.size());
+
+  /* Merge in every group like #BLI_kdtree_3d_calc_duplicates_fast does. Other groups are
+   * written to at the same time, so the distance has to be checked before the map is read. */
+  return threading::parallel_reduce(
+      IndexRange(group_offsets.size() - 1),
+      64,
+      0,
+      [&](const IndexRange range, const int init) {
+        int found = init;
+        Vector<int, 27> neighbor_cells;
+        for (const int group : range) {
+          const Span<int64_t> points = group_points.as_span().slice(
+              group_offsets[group], group_offsets[group + 1] - group_offsets[group]);
+          /* When all points are in one cell, no other cell was joined with it, so the points in
+           * range are all in that cell too. That avoids searching the neighbor cells for the
+           * common case of coincident points. */
+          const int first_cell = grid.point_cell(int(points.first() & 0xffffffff));
+          const bool is_single_cell = std::all_of(
+              points.begin(), points.end(), [&](const int64_t group_point) {
+                return grid.point_cell(int(group_point & 0xffffffff)) == first_cell;
+              });
+          if (is_single_cell) {
+            neighbor_cells.clear();
+            neighbor_cells.append(first_cell);
+          }
+          for (const int64_t group_point : points) {
+            const int point = int(group_point & 0xffffffff);
+            const int index = int(selection[point]);
+            if (!ELEM(r_dest_map[index], -1, index)) {
+              continue;
+            }
+            const float *position = position_fn(index);
+            const int found_prev = found;
+            if (!is_single_cell) {
+              grid.neighbor_cells(grid.point_cell(point), neighbor_cells);
+            }
+            for (const int neighbor_cell : neighbor_cells) {
+              for (const int other : grid.cell_points(neighbor_cell)) {
+                const int other_index = int(selection[other]);
+                if (other != point &&
+                    len_squared_v3v3(position, position_fn(other_index)) <= merge_dist_sq &&
+                    r_dest_map[other_index] == -1) {
+                  r_dest_map[other_index] = index;
+                  found++;
+                }
+              }
+            }
+            if (found != found_prev) {
+              /* Prevent chains of doubles. */
+              r_dest_map[index] = index;
+            }
+          }
+        }
+        return found;
+      },
+      [](const int a, const int b) { return a + b; });
+}
+
+int merge_by_distance_find_duplicates(const Span<float3> positions,
+                                      const IndexMask selection,
+                                      const float merge_distance,
+                                      MutableSpan<int> r_dest_map)
+{
+  /* The KD-tree doesn't find any coincident points in that case either. */
+  if (selection.is_empty() || merge_distance <= 0.0f) {
+    return 0;
+  }
+  const PointGrid grid(positions, selection, merge_distance);
+  return find_duplicates([&](const int64_t i) -> const float * { return positions[i]; },
+                         grid,
+                         selection,
+                         merge_distance,
+                         r_dest_map);
+}
+
+int merge_by_distance_find_duplicates(const Span<MVert> verts,
+                                      const IndexMask selection,
+                                      const float merge_distance,
+                                      MutableSpan<int> r_dest_map)
+{
+  if (selection.is_empty() || merge_distance <= 0.0f) {
+    return 0;
+  }
+  const PointGrid grid(verts, selection, merge_distance);
+  return find_duplicates([&](const int64_t i) -> const float * { return verts[i].co; },
+                         grid,
+                         selection,
+                         merge_distance,
+                         r_dest_map);
+}
+
+}  // namespace blender::geometry
@@ -0,0 +1,38 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include "BLI_index_mask.hh"
+#include "BLI_math_vec_types.hh"
+#include "BLI_span.hh"
+
+struct MVert;
+
+/** \file
+ * \ingroup geo
+ */
+
+namespace blender::geometry {
+
+/**
+ * Find the selected points within \a merge_distance of each other, with the same result as
+ * #BLI_kdtree_3d_calc_duplicates_fast using the index order: every point that isn't merged
+ * yet is the target of all points in range that aren't merged yet, in order of the indices.
+ *
+ * Points are sorted into a uniform grid to find the pairs in range, and the groups of points
+ * connected by these pairs are merged in parallel, since they don't influence each other.
+ *
+ * \param r_dest_map: The index of the point every point is merged into, the selected points
+ * must be initialized to -1. Points that are a target are set to their own index.
+ * \return The number of points that are merged into another point.
+ */
+int merge_by_distance_find_duplicates(Span<float3> positions,
+                                      IndexMask selection,
+                                      float merge_distance,
+                                      MutableSpan<int> r_dest_map);
+int merge_by_distance_find_duplicates(Span<MVert> verts,
+                                      IndexMask selection,
+                                      float merge_distance,
+                                      MutableSpan<int> r_dest_map);
+
+}  // namespace blender::geometry
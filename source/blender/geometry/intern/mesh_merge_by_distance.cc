@@ -1,10 +1,12 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "atomic_ops.h"
+
 #include "BLI_array.hh"
 #include "BLI_index_mask.hh"
-#include "BLI_kdtree.h"
 #include "BLI_math_vector.h"
 #include "BLI_math_vector.hh"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "DNA_mesh_types.h"
@@ -15,6 +17,8 @@
 
 #include "GEO_mesh_merge_by_distance.hh"
 
+#include "merge_by_distance_grid.hh"
+
 //#define USE_WELD_DEBUG
 //#define USE_WELD_NORMALS
 
@@ -1388,6 +1392,47 @@ static void customdata_weld(
 /** \name Mesh Vertex Merging
  * \{ */
 
+/**
+ * Split \a range into chunks of \a chunk_size and call \a fn for all chunks in parallel, with
+ * the offset of the first result element of the chunk. The number of result elements of every
+ * chunk is counted with \a count_fn first, also in parallel.
+ *
+ * \return The total number of result elements.
+ */
+template<typename T, typename CountFn, typename Fn>
+static T parallel_for_chunks_with_offset(const IndexRange range,
+                                         const int64_t chunk_size,
+                                         const CountFn &count_fn,
+                                         const Fn &fn)
+{
+  const int64_t chunks_num = (range.size() + chunk_size - 1) / chunk_size;
+  auto chunk_range = [&](const int64_t chunk) {
+    const int64_t start = chunk * chunk_size;
+    return range.slice(start, std::min(chunk_size, range.size() - start));
+  };
+
+  Array<T> chunk_offsets(chunks_num + 1);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+    for (const int64_t chunk : chunks) {
+      chunk_offsets[chunk] = count_fn(chunk_range(chunk));
+    }
+  });
+  T offset = T(0);
+  for (const int64_t chunk : IndexRange(chunks_num)) {
+    const T count = chunk_offsets[chunk];
+    chunk_offsets[chunk] = offset;
+    offset += count;
+  }
+  chunk_offsets.last() = offset;
+
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+    for (const int64_t chunk : chunks) {
+      fn(chunk_range(chunk), chunk_offsets[chunk]);
+    }
+  });
+  return offset;
+}
+
 static Mesh *create_merged_mesh(const Mesh &mesh,
                                 MutableSpan<int> vert_dest_map,
                                 const int removed_vertex_count)
@@ -1413,38 +1458,52 @@ static Mesh *create_merged_mesh(const Mesh &mesh,
   /* Vertices. */
 
   /* Be careful when editing this array, to avoid new allocations it uses the same buffer as
-   * #vert_dest_map. This map will be used to adjust the edges, polys and loops. */
+   * #vert_dest_map. This map will be used to adjust the edges, polys and loops.
+   * Every chunk only writes the elements it reads from. */
   MutableSpan<int> vert_final = vert_dest_map;
 
-  int dest_index = 0;
-  for (int i = 0; i < totvert; i++) {
-    int source_index = i;
-    int count = 0;
-    while (i < totvert && vert_dest_map[i] == OUT_OF_CONTEXT) {
-      vert_final[i] = dest_index + count;
-      count++;
-      i++;
-    }
-    if (count) {
-      CustomData_copy_data(&mesh.vdata, &result->vdata, source_index, dest_index, count);
-      dest_index += count;
-    }
-    if (i == totvert) {
-      break;
-    }
-    if (vert_dest_map[i] != ELEM_MERGED) {
-      struct WeldGroup *wgroup = &weld_mesh.vert_groups[vert_dest_map[i]];
-      customdata_weld(&mesh.vdata,
-                      &result->vdata,
-                      &weld_mesh.vert_groups_buffer[wgroup->ofs],
-                      wgroup->len,
-                      dest_index);
-      vert_final[i] = dest_index;
-      dest_index++;
-    }
-  }
+  const int vert_dest_len = parallel_for_chunks_with_offset<int>(
+      IndexRange(totvert),
+      4096,
+      [&](const IndexRange range) {
+        int count = 0;
+        for (const int i : range) {
+          count += vert_dest_map[i] != ELEM_MERGED;
+        }
+        return count;
+      },
+      [&](const IndexRange range, int dest_index) {
+        const int range_end = range.one_after_last();
+        for (int i = range.first(); i < range_end; i++) {
+          int source_index = i;
+          int count = 0;
+          while (i < range_end && vert_dest_map[i] == OUT_OF_CONTEXT) {
+            vert_final[i] = dest_index + count;
+            count++;
+            i++;
+          }
+          if (count) {
+            CustomData_copy_data(&mesh.vdata, &result->vdata, source_index, dest_index, count);
+            dest_index += count;
+          }
+          if (i == range_end) {
+            break;
+          }
+          if (vert_dest_map[i] != ELEM_MERGED) {
+            struct WeldGroup *wgroup = &weld_mesh.vert_groups[vert_dest_map[i]];
+            customdata_weld(&mesh.vdata,
+                            &result->vdata,
+                            &weld_mesh.vert_groups_buffer[wgroup->ofs],
+                            wgroup->len,
+                            dest_index);
+            vert_final[i] = dest_index;
+            dest_index++;
+          }
+        }
+      });
 
-  BLI_assert(dest_index == result_nverts);
+  BLI_assert(vert_dest_len == result_nverts);
+  UNUSED_VARS_NDEBUG(vert_dest_len);
 
   /* Edges. */
 
@@ -1452,101 +1511,158 @@ static Mesh *create_merged_mesh(const Mesh &mesh,
    * #edge_groups_map. This map will be used to adjust the polys and loops. */
   MutableSpan<int> edge_final = weld_mesh.edge_groups_map;
 
-  dest_index = 0;
-  for (int i = 0; i < totedge; i++) {
-    const int source_index = i;
-    int count = 0;
-    while (i < totedge && weld_mesh.edge_groups_map[i] == OUT_OF_CONTEXT) {
-      edge_final[i] = dest_index + count;
-      count++;
-      i++;
-    }
-    if (count) {
-      CustomData_copy_data(&mesh.edata, &result->edata, source_index, dest_index, count);
-      MEdge *me = &result->medge[dest_index];
-      dest_index += count;
-      for (; count--; me++) {
-        me->v1 = vert_final[me->v1];
-        me->v2 = vert_final[me->v2];
-      }
-    }
-    if (i == totedge) {
-      break;
-    }
-    if (weld_mesh.edge_groups_map[i] != ELEM_MERGED) {
-      struct WeldGroupEdge *wegrp = &weld_mesh.edge_groups[weld_mesh.edge_groups_map[i]];
-      customdata_weld(&mesh.edata,
-                      &result->edata,
-                      &weld_mesh.edge_groups_buffer[wegrp->group.ofs],
-                      wegrp->group.len,
-                      dest_index);
-      MEdge *me = &result->medge[dest_index];
-      me->v1 = vert_final[wegrp->v1];
-      me->v2 = vert_final[wegrp->v2];
-      /* "For now, assume that all merged edges are loose. This flag will be cleared in the
-       * Polys/Loops step". */
-      me->flag |= ME_LOOSEEDGE;
-
-      edge_final[i] = dest_index;
-      dest_index++;
-    }
-  }
+  const int edge_dest_len = parallel_for_chunks_with_offset<int>(
+      IndexRange(totedge),
+      4096,
+      [&](const IndexRange range) {
+        int count = 0;
+        for (const int i : range) {
+          count += weld_mesh.edge_groups_map[i] != ELEM_MERGED;
+        }
+        return count;
+      },
+      [&](const IndexRange range, int dest_index) {
+        const int range_end = range.one_after_last();
+        for (int i = range.first(); i < range_end; i++) {
+          const int source_index = i;
+          int count = 0;
+          while (i < range_end && weld_mesh.edge_groups_map[i] == OUT_OF_CONTEXT) {
+            edge_final[i] = dest_index + count;
+            count++;
+            i++;
+          }
+          if (count) {
+            CustomData_copy_data(&mesh.edata, &result->edata, source_index, dest_index, count);
+            MEdge *me = &result->medge[dest_index];
+            dest_index += count;
+            for (; count--; me++) {
+              me->v1 = vert_final[me->v1];
+              me->v2 = vert_final[me->v2];
+            }
+          }
+          if (i == range_end) {
+            break;
+          }
+          if (weld_mesh.edge_groups_map[i] != ELEM_MERGED) {
+            struct WeldGroupEdge *wegrp = &weld_mesh.edge_groups[weld_mesh.edge_groups_map[i]];
+            customdata_weld(&mesh.edata,
+                            &result->edata,
+                            &weld_mesh.edge_groups_buffer[wegrp->group.ofs],
+                            wegrp->group.len,
+                            dest_index);
+            MEdge *me = &result->medge[dest_index];
+            me->v1 = vert_final[wegrp->v1];
+            me->v2 = vert_final[wegrp->v2];
+            /* "For now, assume that all merged edges are loose. This flag will be cleared in the
+             * Polys/Loops step". */
+            me->flag |= ME_LOOSEEDGE;
+
+            edge_final[i] = dest_index;
+            dest_index++;
+          }
+        }
+      });
 
-  BLI_assert(dest_index == result_nedges);
+  BLI_assert(edge_dest_len == result_nedges);
+  UNUSED_VARS_NDEBUG(edge_dest_len);
 
   /* Polys/Loops. */
 
-  MPoly *r_mp = &result->mpoly[0];
-  MLoop *r_ml = &result->mloop[0];
-  int r_i = 0;
-  int loop_cur = 0;
-  Array<int, 64> group_buffer(weld_mesh.max_poly_len);
-  for (const int i : mpoly.index_range()) {
-    const MPoly &mp = mpoly[i];
-    const int loop_start = loop_cur;
+  /* The number of polygons and loops of every chunk, polygons with a destination or collapsed
+   * polygons are removed. */
+  auto poly_dest_len = [&](const int i) -> int2 {
     const int poly_ctx = weld_mesh.poly_map[i];
     if (poly_ctx == OUT_OF_CONTEXT) {
-      int mp_loop_len = mp.totloop;
-      CustomData_copy_data(&mesh.ldata, &result->ldata, mp.loopstart, loop_cur, mp_loop_len);
-      loop_cur += mp_loop_len;
-      for (; mp_loop_len--; r_ml++) {
-        r_ml->v = vert_final[r_ml->v];
-        r_ml->e = edge_final[r_ml->e];
-      }
+      return int2(1, mpoly[i].totloop);
     }
-    else {
-      const WeldPoly &wp = weld_mesh.wpoly[poly_ctx];
-      WeldLoopOfPolyIter iter;
-      if (!weld_iter_loop_of_poly_begin(
-              iter, wp, weld_mesh.wloop, mloop, weld_mesh.loop_map, group_buffer.data())) {
-        continue;
-      }
+    const WeldPoly &wp = weld_mesh.wpoly[poly_ctx];
+    WeldLoopOfPolyIter iter;
+    if (!weld_iter_loop_of_poly_begin(
+            iter, wp, weld_mesh.wloop, mloop, weld_mesh.loop_map, nullptr)) {
+      return int2(0);
+    }
+    if (wp.poly_dst != OUT_OF_CONTEXT) {
+      return int2(0);
+    }
+    int loops_len = 0;
+    while (weld_iter_loop_of_poly_next(iter)) {
+      loops_len++;
+    }
+    return int2(1, loops_len);
+  };
 
-      if (wp.poly_dst != OUT_OF_CONTEXT) {
-        continue;
-      }
-      while (weld_iter_loop_of_poly_next(iter)) {
-        customdata_weld(
-            &mesh.ldata, &result->ldata, group_buffer.data(), iter.group_len, loop_cur);
-        int v = vert_final[iter.v];
-        int e = edge_final[iter.e];
-        r_ml->v = v;
-        r_ml->e = e;
-        r_ml++;
-        loop_cur++;
-        if (iter.type) {
-          result->medge[e].flag &= ~ME_LOOSEEDGE;
+  const int2 poly_loop_dest_len = parallel_for_chunks_with_offset<int2>(
+      mpoly.index_range(),
+      1024,
+      [&](const IndexRange range) {
+        int2 count(0);
+        for (const int i : range) {
+          count += poly_dest_len(i);
         }
-        BLI_assert((result->medge[e].flag & ME_LOOSEEDGE) == 0);
-      }
-    }
+        return count;
+      },
+      [&](const IndexRange range, const int2 dest_start) {
+        MPoly *r_mp = &result->mpoly[dest_start[0]];
+        MLoop *r_ml = &result->mloop[dest_start[1]];
+        int r_i = dest_start[0];
+        int loop_cur = dest_start[1];
+        Array<int, 64> group_buffer(weld_mesh.max_poly_len);
+        for (const int i : range) {
+          const MPoly &mp = mpoly[i];
+          const int loop_start = loop_cur;
+          const int poly_ctx = weld_mesh.poly_map[i];
+          if (poly_ctx == OUT_OF_CONTEXT) {
+            int mp_loop_len = mp.totloop;
+            CustomData_copy_data(
+                &mesh.ldata, &result->ldata, mp.loopstart, loop_cur, mp_loop_len);
+            loop_cur += mp_loop_len;
+            for (; mp_loop_len--; r_ml++) {
+              r_ml->v = vert_final[r_ml->v];
+              r_ml->e = edge_final[r_ml->e];
+            }
+          }
+          else {
+            const WeldPoly &wp = weld_mesh.wpoly[poly_ctx];
+            WeldLoopOfPolyIter iter;
+            if (!weld_iter_loop_of_poly_begin(
+                    iter, wp, weld_mesh.wloop, mloop, weld_mesh.loop_map, group_buffer.data())) {
+              continue;
+            }
 
-    CustomData_copy_data(&mesh.pdata, &result->pdata, i, r_i, 1);
-    r_mp->loopstart = loop_start;
-    r_mp->totloop = loop_cur - loop_start;
-    r_mp++;
-    r_i++;
-  }
+            if (wp.poly_dst != OUT_OF_CONTEXT) {
+              continue;
+            }
+            while (weld_iter_loop_of_poly_next(iter)) {
+              customdata_weld(
+                  &mesh.ldata, &result->ldata, group_buffer.data(), iter.group_len, loop_cur);
+              int v = vert_final[iter.v];
+              int e = edge_final[iter.e];
+              r_ml->v = v;
+              r_ml->e = e;
+              r_ml++;
+              loop_cur++;
+              if (iter.type) {
+                /* Edges are shared with polygons of other chunks. */
+                atomic_fetch_and_and_int16(&result->medge[e].flag, short(~ME_LOOSEEDGE));
+              }
+              BLI_assert((result->medge[e].flag & ME_LOOSEEDGE) == 0);
+            }
+          }
+
+          CustomData_copy_data(&mesh.pdata, &result->pdata, i, r_i, 1);
+          r_mp->loopstart = loop_start;
+          r_mp->totloop = loop_cur - loop_start;
+          r_mp++;
+          r_i++;
+        }
+      });
+
+  /* New polygons from split polygons are added at the end. */
+  MPoly *r_mp = &result->mpoly[poly_loop_dest_len[0]];
+  MLoop *r_ml = &result->mloop[poly_loop_dest_len[1]];
+  int r_i = poly_loop_dest_len[0];
+  int loop_cur = poly_loop_dest_len[1];
+  Array<int, 64> group_buffer(weld_mesh.max_poly_len);
 
   for (const int i : IndexRange(weld_mesh.wpoly_new_len)) {
     const WeldPoly &wp = weld_mesh.wpoly_new[i];
@@ -1602,16 +1718,8 @@ std::optional<Mesh *> mesh_merge_by_distance_all(const Mesh &mesh,
 {
   Array<int> vert_dest_map(mesh.totvert, OUT_OF_CONTEXT);
 
-  KDTree_3d *tree = BLI_kdtree_3d_new(selection.size());
-
-  for (const int i : selection) {
-    BLI_kdtree_3d_insert(tree, i, mesh.mvert[i].co);
-  }
-
-  BLI_kdtree_3d_balance(tree);
-  const int vert_kill_len = BLI_kdtree_3d_calc_duplicates_fast(
-      tree, merge_distance, false, vert_dest_map.data());
-  BLI_kdtree_3d_free(tree);
+  const int vert_kill_len = merge_by_distance_find_duplicates(
+      Span(mesh.mvert, mesh.totvert), selection, merge_distance, vert_dest_map);
 
   if (vert_kill_len == 0) {
     return std::nullopt;
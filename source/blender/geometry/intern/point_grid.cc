@@ -0,0 +1,180 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "BLI_math_vector.h"
+#include "BLI_math_vector.hh"
+
+#include "DNA_meshdata_types.h"
+
+#include "GEO_point_grid.hh"
+
+#ifdef WITH_TBB
+#  include <tbb/parallel_sort.h>
+#endif
+
+namespace blender::geometry {
+
+/** Bits of every cell coordinate in the key of a cell. */
+#define GRID_AXIS_BITS 21
+/**
+ * Cells are made larger when there would be more cells along an axis, which still finds all
+ * points in range. The coordinates are offset by one, so the coordinates of neighbors always fit
+ * in #GRID_AXIS_BITS.
+ */
+#define GRID_AXIS_CELLS_MAX (int64_t(1) << (GRID_AXIS_BITS - 1))
+
+/** The difference of the first key in every row of neighbors with the key of the center cell. */
+static const std::array<int64_t, 9> &grid_row_offsets()
+{
+  static const std::array<int64_t, 9> offsets = []() {
+    std::array<int64_t, 9> offsets;
+    int i = 0;
+    for (const int64_t x : {-1, 0, 1}) {
+      for (const int64_t y : {-1, 0, 1}) {
+        const int64_t x_offset = x * (int64_t(1) << (2 * GRID_AXIS_BITS));
+        const int64_t y_offset = y * (int64_t(1) << GRID_AXIS_BITS);
+        offsets[i++] = x_offset + y_offset - 1;
+      }
+    }
+    return offsets;
+  }();
+  return offsets;
+}
+
+static int64_t grid_cell_coord(const float value, const double min, const double cell_size)
+{
+  const double coord = std::floor((double(value) - min) / cell_size);
+  /* Also handles NaN. */
+  if (!(coord >= 0.0)) {
+    return 1;
+  }
+  return std::min(int64_t(coord), GRID_AXIS_CELLS_MAX) + 1;
+}
+
+PointGrid::PointGrid(const Span<float3> positions, const IndexMask selection, const float distance)
+{
+  this->build([&](const int64_t i) -> const float * { return positions[i]; },
+              selection,
+              distance);
+}
+
+PointGrid::PointGrid(const Span<MVert> verts, const IndexMask selection, const float distance)
+{
+  this->build([&](const int64_t i) -> const float * { return verts[i].co; }, selection, distance);
+}
+
+/**
+ * \param position_fn: Returns the position of a point, as a pointer to three floats. This avoids
+ * copying the positions of mesh vertices.
+ */
+template<typename PositionFn>
+void PointGrid::build(const PositionFn &position_fn,
+                      const IndexMask selection,
+                      const float distance)
+{
+  struct Bounds {
+    float3 min;
+    float3 max;
+  };
+  const Bounds bounds = threading::parallel_reduce(
+      selection.index_range(),
+      4096,
+      Bounds{float3(FLT_MAX), float3(-FLT_MAX)},
+      [&](const IndexRange range, const Bounds &init) {
+        Bounds result = init;
+        for (const int i : range) {
+          minmax_v3v3_v3(result.min, result.max, position_fn(selection[i]));
+        }
+        return result;
+      },
+      [](const Bounds &a, const Bounds &b) {
+        return Bounds{math::min(a.min, b.min), math::max(a.max, b.max)};
+      });
+
+  double extent = 0.0;
+  for (const int axis : IndexRange(3)) {
+    min_[axis] = bounds.min[axis];
+    extent = std::max(extent, double(bounds.max[axis]) - double(bounds.min[axis]));
+  }
+  /* The cells are a bit larger than the distance, so that points in range are at most one cell
+   * apart, even with the rounding of the distance calculation. */
+  cell_size_ = std::max(double(distance) * (1.0 + 1e-6), extent / double(GRID_AXIS_CELLS_MAX));
+  if (!(cell_size_ > 0.0)) {
+    cell_size_ = 1.0;
+  }
+
+  Array<std::pair<int64_t, int>> sorted_points(selection.size());
+  threading::parallel_for(selection.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const float *position = position_fn(selection[i]);
+      const int64_t key = (grid_cell_coord(position[0], min_[0], cell_size_)
+                           << (2 * GRID_AXIS_BITS)) |
+                          (grid_cell_coord(position[1], min_[1], cell_size_) << GRID_AXIS_BITS) |
+                          grid_cell_coord(position[2], min_[2], cell_size_);
+      sorted_points[i] = {key, i};
+    }
+  });
+#ifdef WITH_TBB
+  tbb::parallel_sort(sorted_points.begin(), sorted_points.end());
+#else
+  std::sort(sorted_points.begin(), sorted_points.end());
+#endif
+
+  Vector<int64_t> cell_keys;
+  Vector<int> cell_offsets;
+  for (const int i : sorted_points.index_range()) {
+    if (i == 0 || sorted_points[i].first != sorted_points[i - 1].first) {
+      cell_keys.append(sorted_points[i].first);
+      cell_offsets.append(i);
+    }
+  }
+  cell_offsets.append(sorted_points.size());
+  cell_keys_ = cell_keys.as_span();
+  cell_offsets_ = cell_offsets.as_span();
+
+  points_.reinitialize(selection.size());
+  point_cells_.reinitialize(selection.size());
+  threading::parallel_for(cell_keys_.index_range(), 1024, [&](const IndexRange range) {
+    for (const int cell : range) {
+      const IndexRange points(cell_offsets_[cell], cell_offsets_[cell + 1] - cell_offsets_[cell]);
+      for (const int i : points) {
+        points_[i] = sorted_points[i].second;
+        point_cells_[sorted_points[i].second] = cell;
+      }
+    }
+  });
+}
+
+int64_t PointGrid::row_cursor(const int cell, const int row) const
+{
+  const int64_t first_key = cell_keys_[cell] + grid_row_offsets()[row];
+  return std::lower_bound(cell_keys_.begin(), cell_keys_.end(), first_key) - cell_keys_.begin();
+}
+
+void PointGrid::append_row_cells(const int cell,
+                                 const int row,
+                                 int64_t &cursor,
+                                 Vector<int, 27> &r_cells) const
+{
+  const int64_t first_key = cell_keys_[cell] + grid_row_offsets()[row];
+  while (cursor < cell_keys_.size() && cell_keys_[cursor] < first_key) {
+    cursor++;
+  }
+  for (int64_t i = cursor; i < cell_keys_.size() && cell_keys_[i] <= first_key + 2; i++) {
+    r_cells.append(int(i));
+  }
+}
+
+void PointGrid::neighbor_cells(const int cell, Vector<int, 27> &r_cells) const
+{
+  r_cells.clear();
+  for (const int row : IndexRange(9)) {
+    int64_t cursor = this->row_cursor(cell, row);
+    this->append_row_cells(cell, row, cursor, r_cells);
+  }
+}
+
+}  // namespace blender::geometry
@@ -580,6 +580,27 @@ static void gather_realize_tasks_recursive(GatherTasksInfo &gather_info,
   }
 }
 
+/**
+ * Remove named attributes that are not in #RealizeInstancesOptions.attributes_to_propagate.
+ */
+static void remove_filtered_attributes(const RealizeInstancesOptions &options,
+                                       Map<AttributeIDRef, AttributeKind> &attributes)
+{
+  if (!options.attributes_to_propagate.has_value()) {
+    return;
+  }
+  Vector<AttributeIDRef> ids_to_remove;
+  for (const AttributeIDRef &attribute_id : attributes.keys()) {
+    if (attribute_id.is_named() &&
+        !options.attributes_to_propagate->contains_as(attribute_id.name())) {
+      ids_to_remove.append(attribute_id);
+    }
+  }
+  for (const AttributeIDRef &attribute_id : ids_to_remove) {
+    attributes.remove_contained(attribute_id);
+  }
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -598,6 +619,7 @@ static OrderedAttributes gather_generic_pointcloud_attributes_to_propagate(
   Map<AttributeIDRef, AttributeKind> attributes_to_propagate;
   in_geometry_set.gather_attributes_for_propagation(
       src_component_types, GEO_COMPONENT_TYPE_POINT_CLOUD, true, attributes_to_propagate);
+  remove_filtered_attributes(options, attributes_to_propagate);
   attributes_to_propagate.remove("position");
   r_create_id = attributes_to_propagate.pop_try("id").has_value();
   OrderedAttributes ordered_attributes;
@@ -771,6 +793,7 @@ static OrderedAttributes gather_generic_mesh_attributes_to_propagate(
   Map<AttributeIDRef, AttributeKind> attributes_to_propagate;
   in_geometry_set.gather_attributes_for_propagation(
       src_component_types, GEO_COMPONENT_TYPE_MESH, true, attributes_to_propagate);
+  remove_filtered_attributes(options, attributes_to_propagate);
   attributes_to_propagate.remove("position");
   attributes_to_propagate.remove("normal");
   attributes_to_propagate.remove("material_index");
@@ -1037,6 +1060,7 @@ static OrderedAttributes gather_generic_curve_attributes_to_propagate(
   Map<AttributeIDRef, AttributeKind> attributes_to_propagate;
   in_geometry_set.gather_attributes_for_propagation(
       src_component_types, GEO_COMPONENT_TYPE_CURVE, true, attributes_to_propagate);
+  remove_filtered_attributes(options, attributes_to_propagate);
   attributes_to_propagate.remove("position");
   attributes_to_propagate.remove("radius");
   attributes_to_propagate.remove("handle_right");
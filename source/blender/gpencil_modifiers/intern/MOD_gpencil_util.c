@@ -184,7 +184,9 @@ void generic_bake_deform_stroke(
         CFRA = gpf->framenum;
         BKE_scene_graph_update_for_newframe(depsgraph);
       }
+      int stroke_index = 0;
       LISTBASE_FOREACH (bGPDstroke *, gps, &gpf->strokes) {
+        gps->runtime.stroke_index = stroke_index++;
         bake_cb(md, depsgraph, ob, gpl, gpf, gps);
       }
     }
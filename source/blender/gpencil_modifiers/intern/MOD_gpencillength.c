@@ -108,7 +108,6 @@ static bool gpencil_modify_stroke(bGPDstroke *gps,
 static void applyLength(GpencilModifierData *md,
                         Depsgraph *depsgraph,
                         bGPdata *gpd,
-                        bGPDframe *gpf,
                         bGPDstroke *gps,
                         Object *ob)
 {
@@ -143,7 +142,7 @@ static void applyLength(GpencilModifierData *md,
     float rand_offset = BLI_hash_int_01(seed);
 
     /* Get stroke index for random offset. */
-    int rnd_index = BLI_findindex(&gpf->strokes, gps);
+    int rnd_index = gps->runtime.stroke_index;
     const uint primes[2] = {2, 3};
     double offset[2] = {0.0f, 0.0f};
     double r[2];
@@ -208,7 +207,7 @@ static void deformStroke(GpencilModifierData *md,
                          Depsgraph *depsgraph,
                          Object *ob,
                          bGPDlayer *gpl,
-                         bGPDframe *gpf,
+                         bGPDframe *UNUSED(gpf),
                          bGPDstroke *gps)
 {
   bGPdata *gpd = ob->data;
@@ -231,7 +230,7 @@ static void deformStroke(GpencilModifierData *md,
     /* Don't affect cyclic strokes as they have no start/end. */
     return;
   }
-  applyLength(md, depsgraph, gpd, gpf, gps, ob);
+  applyLength(md, depsgraph, gpd, gps, ob);
 }
 
 static void bakeModifier(Main *UNUSED(bmain),
@@ -111,7 +111,7 @@ static void deformStroke(GpencilModifierData *md,
                          Depsgraph *depsgraph,
                          Object *ob,
                          bGPDlayer *gpl,
-                         bGPDframe *gpf,
+                         bGPDframe *UNUSED(gpf),
                          bGPDstroke *gps)
 {
   NoiseGpencilModifierData *mmd = (NoiseGpencilModifierData *)md;
@@ -139,8 +139,7 @@ static void deformStroke(GpencilModifierData *md,
   }
 
   int seed = mmd->seed;
-  /* FIXME(fclem): This is really slow. We should get the stroke index in another way. */
-  int stroke_seed = BLI_findindex(&gpf->strokes, gps);
+  int stroke_seed = gps->runtime.stroke_index;
   seed += stroke_seed;
 
   /* Make sure different modifiers get different seeds. */
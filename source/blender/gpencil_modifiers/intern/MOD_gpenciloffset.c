@@ -59,7 +59,7 @@ static void deformStroke(GpencilModifierData *md,
                          Depsgraph *UNUSED(depsgraph),
                          Object *ob,
                          bGPDlayer *gpl,
-                         bGPDframe *gpf,
+                         bGPDframe *UNUSED(gpf),
                          bGPDstroke *gps)
 {
   OffsetGpencilModifierData *mmd = (OffsetGpencilModifierData *)md;
@@ -92,7 +92,7 @@ static void deformStroke(GpencilModifierData *md,
   float rand_offset = BLI_hash_int_01(seed);
 
   /* Get stroke index for random offset. */
-  int rnd_index = BLI_findindex(&gpf->strokes, gps);
+  int rnd_index = gps->runtime.stroke_index;
   for (int j = 0; j < 3; j++) {
     const uint primes[3] = {2, 3, 7};
     double offset[3] = {0.0f, 0.0f, 0.0f};
@@ -232,8 +232,6 @@ typedef struct LineartRenderBuffer {
   ListBase intersecting_vertex_buffer;
   /** Use the one comes with Line Art. */
   LineartStaticMemPool render_data_pool;
-  ListBase wasted_cuts;
-  SpinLock lock_cuts;
 
   /* This is just a pointer to LineartCache::chain_data_pool, which acts as a cache for line
    * chains. */
@@ -367,6 +365,9 @@ typedef struct LineartRenderTaskInfo {
   ListBase edge_mark;
   ListBase floating;
 
+  /** Segments this thread doesn't use anymore, reused before acquiring new memory. */
+  ListBase wasted_cuts;
+
 } LineartRenderTaskInfo;
 
 typedef struct LineartObjectInfo {
@@ -97,31 +97,25 @@ static void lineart_add_edge_to_list(LineartRenderBuffer *rb, LineartEdge *e);
 
 static LineartCache *lineart_init_cache(void);
 
-static void lineart_discard_segment(LineartRenderBuffer *rb, LineartEdgeSegment *es)
+static void lineart_discard_segment(LineartRenderTaskInfo *rti, LineartEdgeSegment *es)
 {
-  BLI_spin_lock(&rb->lock_cuts);
-
   memset(es, 0, sizeof(LineartEdgeSegment));
 
   /* Storing the node for potentially reuse the memory for new segment data.
-   * Line Art data is not freed after all calculations are done. */
-  BLI_addtail(&rb->wasted_cuts, es);
-
-  BLI_spin_unlock(&rb->lock_cuts);
+   * Line Art data is not freed after all calculations are done. The list is local to the thread,
+   * so this doesn't need a lock. */
+  BLI_addtail(&rti->wasted_cuts, es);
 }
 
-static LineartEdgeSegment *lineart_give_segment(LineartRenderBuffer *rb)
+static LineartEdgeSegment *lineart_give_segment(LineartRenderBuffer *rb,
+                                                LineartRenderTaskInfo *rti)
 {
-  BLI_spin_lock(&rb->lock_cuts);
-
   /* See if there is any already allocated memory we can reuse. */
-  if (rb->wasted_cuts.first) {
-    LineartEdgeSegment *es = (LineartEdgeSegment *)BLI_pophead(&rb->wasted_cuts);
-    BLI_spin_unlock(&rb->lock_cuts);
+  if (rti->wasted_cuts.first) {
+    LineartEdgeSegment *es = (LineartEdgeSegment *)BLI_pophead(&rti->wasted_cuts);
     memset(es, 0, sizeof(LineartEdgeSegment));
     return es;
   }
-  BLI_spin_unlock(&rb->lock_cuts);
 
   /* Otherwise allocate some new memory. */
   return (LineartEdgeSegment *)lineart_mem_acquire_thread(&rb->render_data_pool,
@@ -132,6 +126,7 @@ static LineartEdgeSegment *lineart_give_segment(LineartRenderBuffer *rb)
  * Cuts the edge in image space and mark occlusion level for each segment.
  */
 static void lineart_edge_cut(LineartRenderBuffer *rb,
+                             LineartRenderTaskInfo *rti,
                              LineartEdge *e,
                              double start,
                              double end,
@@ -179,7 +174,7 @@ static void lineart_edge_cut(LineartRenderBuffer *rb,
     ies = es->next;
     if (ies->at > start + 1e-09 && start > es->at) {
       cut_start_before = ies;
-      ns = lineart_give_segment(rb);
+      ns = lineart_give_segment(rb, rti);
       break;
     }
   }
@@ -205,14 +200,14 @@ static void lineart_edge_cut(LineartRenderBuffer *rb,
     /* When an actual cut is needed in the line. */
     if (es->at > end) {
       cut_end_before = es;
-      ns2 = lineart_give_segment(rb);
+      ns2 = lineart_give_segment(rb, rti);
       break;
     }
   }
 
   /* When we still can't find any existing cut in the line, we allocate new ones. */
   if (ns == NULL) {
-    ns = lineart_give_segment(rb);
+    ns = lineart_give_segment(rb, rti);
   }
   if (ns2 == NULL) {
     if (untouched) {
@@ -220,7 +215,7 @@ static void lineart_edge_cut(LineartRenderBuffer *rb,
       cut_end_before = ns2;
     }
     else {
-      ns2 = lineart_give_segment(rb);
+      ns2 = lineart_give_segment(rb, rti);
     }
   }
 
@@ -286,7 +281,7 @@ static void lineart_edge_cut(LineartRenderBuffer *rb,
       BLI_remlink(&e->segments, es);
       /* This puts the node back to the render buffer, if more cut happens, these unused nodes get
        * picked first. */
-      lineart_discard_segment(rb, es);
+      lineart_discard_segment(rti, es);
       continue;
     }
 
@@ -349,8 +344,11 @@ static void lineart_bounding_area_line_add(LineartRenderBuffer *rb,
   ba->line_count++;
 }
 
-static void lineart_occlusion_single_line(LineartRenderBuffer *rb, LineartEdge *e, int thread_id)
+static void lineart_occlusion_single_line(LineartRenderBuffer *rb,
+                                          LineartRenderTaskInfo *rti,
+                                          LineartEdge *e)
 {
+  const int thread_id = rti->thread_id;
   double x = e->v1->fbcoord[0], y = e->v1->fbcoord[1];
   LineartBoundingArea *ba = lineart_edge_first_bounding_area(rb, e);
   LineartBoundingArea *nba = ba;
@@ -393,7 +391,7 @@ static void lineart_occlusion_single_line(LineartRenderBuffer *rb, LineartEdge *
                                                       rb->shift_y,
                                                       &l,
                                                       &r)) {
-        lineart_edge_cut(rb, e, l, r, tri->base.material_mask_bits, tri->base.mat_occlusion);
+        lineart_edge_cut(rb, rti, e, l, r, tri->base.material_mask_bits, tri->base.mat_occlusion);
         if (e->min_occ > rb->max_occlusion_level) {
           /* No need to calculate any longer on this line because no level more than set value is
            * going to show up in the rendered result. */
@@ -451,27 +449,27 @@ static void lineart_occlusion_worker(TaskPool *__restrict UNUSED(pool), LineartR
   while (lineart_occlusion_make_task_info(rb, rti)) {
 
     for (eip = rti->contour.first; eip && eip != rti->contour.last; eip = eip->next) {
-      lineart_occlusion_single_line(rb, eip, rti->thread_id);
+      lineart_occlusion_single_line(rb, rti, eip);
     }
 
     for (eip = rti->crease.first; eip && eip != rti->crease.last; eip = eip->next) {
-      lineart_occlusion_single_line(rb, eip, rti->thread_id);
+      lineart_occlusion_single_line(rb, rti, eip);
     }
 
     for (eip = rti->intersection.first; eip && eip != rti->intersection.last; eip = eip->next) {
-      lineart_occlusion_single_line(rb, eip, rti->thread_id);
+      lineart_occlusion_single_line(rb, rti, eip);
     }
 
     for (eip = rti->material.first; eip && eip != rti->material.last; eip = eip->next) {
-      lineart_occlusion_single_line(rb, eip, rti->thread_id);
+      lineart_occlusion_single_line(rb, rti, eip);
     }
 
     for (eip = rti->edge_mark.first; eip && eip != rti->edge_mark.last; eip = eip->next) {
-      lineart_occlusion_single_line(rb, eip, rti->thread_id);
+      lineart_occlusion_single_line(rb, rti, eip);
     }
 
     for (eip = rti->floating.first; eip && eip != rti->floating.last; eip = eip->next) {
-      lineart_occlusion_single_line(rb, eip, rti->thread_id);
+      lineart_occlusion_single_line(rb, rti, eip);
     }
   }
 }
@@ -3082,14 +3080,12 @@ static void lineart_destroy_render_data(LineartRenderBuffer *rb)
   memset(&rb->floating, 0, sizeof(ListBase));
 
   BLI_listbase_clear(&rb->chains);
-  BLI_listbase_clear(&rb->wasted_cuts);
 
   BLI_listbase_clear(&rb->vertex_buffer_pointers);
   BLI_listbase_clear(&rb->line_buffer_pointers);
   BLI_listbase_clear(&rb->triangle_buffer_pointers);
 
   BLI_spin_end(&rb->lock_task);
-  BLI_spin_end(&rb->lock_cuts);
   BLI_spin_end(&rb->render_data_pool.lock_mem);
 
   lineart_mem_destroy(&rb->render_data_pool);
@@ -3228,7 +3224,6 @@ static LineartRenderBuffer *lineart_create_render_buffer(Scene *scene,
   rb->chain_data_pool = &lc->chain_data_pool;
 
   BLI_spin_init(&rb->lock_task);
-  BLI_spin_init(&rb->lock_cuts);
   BLI_spin_init(&rb->render_data_pool.lock_mem);
 
   return rb;
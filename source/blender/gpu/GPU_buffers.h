@@ -88,6 +88,16 @@ void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
                                   int face_sets_color_default,
                                   const struct MPropCol *vtcol,
                                   int update_flags);
+/**
+ * Only update the mask of mesh buffers, after #GPU_pbvh_mesh_buffers_update was called once.
+ * Other attributes are not uploaded again when flushed.
+ * Threaded: do not call any functions that use OpenGL calls!
+ */
+void GPU_pbvh_mesh_buffers_update_mask(GPU_PBVH_Buffers *buffers,
+                                       const struct MVert *mvert,
+                                       const float *vmask,
+                                       const int *sculpt_face_sets,
+                                       int update_flags);
 
 /**
  * Creates a vertex buffer (coordinate, normal, color) and,
@@ -317,6 +317,11 @@ int GPU_texture_width(const GPUTexture *tex);
 int GPU_texture_height(const GPUTexture *tex);
 int GPU_texture_layer_count(const GPUTexture *tex);
 int GPU_texture_mip_count(const GPUTexture *tex);
+/**
+ * Estimation of the memory used by all the mip levels of the texture, in bytes.
+ * Buffer textures are not counted since their storage belongs to the vertex buffer.
+ */
+size_t GPU_texture_memory_size(const GPUTexture *tex);
 int GPU_texture_orig_width(const GPUTexture *tex);
 int GPU_texture_orig_height(const GPUTexture *tex);
 void GPU_texture_orig_size_set(GPUTexture *tex, int w, int h);
@@ -49,6 +49,8 @@ struct GPU_PBVH_Buffers {
   GPUIndexBuf *index_buf, *index_buf_fast;
   GPUIndexBuf *index_lines_buf, *index_lines_buf_fast;
   GPUVertBuf *vert_buf;
+  /* Mask of mesh buffers, separate so it can be updated without the other attributes. */
+  GPUVertBuf *mask_buf;
 
   GPUBatch *lines;
   GPUBatch *lines_fast;
@@ -84,11 +86,18 @@ struct GPU_PBVH_Buffers {
   bool smooth;
 
   bool show_overlay;
+  /* Part of #show_overlay for face sets, kept for mask only updates. */
+  bool show_face_set_overlay;
 };
 
 static struct {
   GPUVertFormat format;
   uint pos, nor, msk, col, fset;
+  /* Mesh buffers, with the mask in #mask_format instead. */
+  GPUVertFormat mesh_format;
+  uint mesh_pos, mesh_nor, mesh_col, mesh_fset;
+  GPUVertFormat mask_format;
+  uint mask_msk;
 } g_vbo_id = {{0}};
 
 /** \} */
@@ -112,6 +121,18 @@ void gpu_pbvh_init()
         &g_vbo_id.format, "ac", GPU_COMP_U16, 4, GPU_FETCH_INT_TO_FLOAT_UNIT);
     g_vbo_id.fset = GPU_vertformat_attr_add(
         &g_vbo_id.format, "fset", GPU_COMP_U8, 3, GPU_FETCH_INT_TO_FLOAT_UNIT);
+
+    g_vbo_id.mesh_pos = GPU_vertformat_attr_add(
+        &g_vbo_id.mesh_format, "pos", GPU_COMP_F32, 3, GPU_FETCH_FLOAT);
+    g_vbo_id.mesh_nor = GPU_vertformat_attr_add(
+        &g_vbo_id.mesh_format, "nor", GPU_COMP_I16, 3, GPU_FETCH_INT_TO_FLOAT_UNIT);
+    g_vbo_id.mesh_col = GPU_vertformat_attr_add(
+        &g_vbo_id.mesh_format, "ac", GPU_COMP_U16, 4, GPU_FETCH_INT_TO_FLOAT_UNIT);
+    g_vbo_id.mesh_fset = GPU_vertformat_attr_add(
+        &g_vbo_id.mesh_format, "fset", GPU_COMP_U8, 3, GPU_FETCH_INT_TO_FLOAT_UNIT);
+
+    g_vbo_id.mask_msk = GPU_vertformat_attr_add(
+        &g_vbo_id.mask_format, "msk", GPU_COMP_U8, 1, GPU_FETCH_INT_TO_FLOAT_UNIT);
   }
 }
 
@@ -120,6 +141,21 @@ void gpu_pbvh_exit()
   /* Nothing to do. */
 }
 
+/* Allocates a non-initialized buffer with given format to be sent to GPU.
+ * Return is false it indicates that the memory map failed. */
+static bool gpu_pbvh_vbo_data_set(GPUVertBuf **vbo, GPUVertFormat *format, uint vert_len)
+{
+  if (*vbo == NULL) {
+    *vbo = GPU_vertbuf_create_with_format_ex(format, GPU_USAGE_STATIC);
+  }
+  if (GPU_vertbuf_get_data(*vbo) == NULL || GPU_vertbuf_get_vertex_len(*vbo) != vert_len) {
+    /* Allocate buffer if not allocated yet or size changed. */
+    GPU_vertbuf_data_alloc(*vbo, vert_len);
+  }
+
+  return GPU_vertbuf_get_data(*vbo) != NULL;
+}
+
 /* Allocates a non-initialized buffer to be sent to GPU.
  * Return is false it indicates that the memory map failed. */
 static bool gpu_pbvh_vert_buf_data_set(GPU_PBVH_Buffers *buffers, uint vert_len)
@@ -136,19 +172,11 @@ static bool gpu_pbvh_vert_buf_data_set(GPU_PBVH_Buffers *buffers, uint vert_len)
   else if (vert_len != buffers->vert_buf->vertex_len) {
     GPU_vertbuf_data_resize(buffers->vert_buf, vert_len);
   }
+  return GPU_vertbuf_get_data(buffers->vert_buf) != NULL;
 #else
-  if (buffers->vert_buf == NULL) {
-    /* Initialize vertex buffer (match 'VertexBufferFormat'). */
-    buffers->vert_buf = GPU_vertbuf_create_with_format_ex(&g_vbo_id.format, GPU_USAGE_STATIC);
-  }
-  if (GPU_vertbuf_get_data(buffers->vert_buf) == NULL ||
-      GPU_vertbuf_get_vertex_len(buffers->vert_buf) != vert_len) {
-    /* Allocate buffer if not allocated yet or size changed. */
-    GPU_vertbuf_data_alloc(buffers->vert_buf, vert_len);
-  }
+  /* Initialize vertex buffer (match 'VertexBufferFormat'). */
+  return gpu_pbvh_vbo_data_set(&buffers->vert_buf, &g_vbo_id.format, vert_len);
 #endif
-
-  return GPU_vertbuf_get_data(buffers->vert_buf) != NULL;
 }
 
 static void gpu_pbvh_batch_init(GPU_PBVH_Buffers *buffers, GPUPrimType prim)
@@ -192,6 +220,62 @@ static bool gpu_pbvh_is_looptri_visible(const MLoopTri *lt,
           sculpt_face_sets[lt->poly] > SCULPT_FACE_SET_NONE);
 }
 
+/**
+ * Fill the mask buffer of mesh buffers, with vertices in the same order as the other attributes.
+ * Returns true if the mask is empty.
+ */
+static bool gpu_pbvh_mesh_mask_fill(GPU_PBVH_Buffers *buffers,
+                                    const MVert *mvert,
+                                    const float *vmask,
+                                    const int *sculpt_face_sets,
+                                    const bool show_mask)
+{
+  bool empty_mask = true;
+
+  if (!gpu_pbvh_vbo_data_set(&buffers->mask_buf, &g_vbo_id.mask_format, buffers->tot_tri * 3)) {
+    return empty_mask;
+  }
+
+  GPUVertBufRaw msk_step = {0};
+  GPU_vertbuf_attr_get_raw_data(buffers->mask_buf, g_vbo_id.mask_msk, &msk_step);
+
+  for (uint i = 0; i < buffers->face_indices_len; i++) {
+    const MLoopTri *lt = &buffers->looptri[buffers->face_indices[i]];
+    const uint vtri[3] = {
+        buffers->mloop[lt->tri[0]].v,
+        buffers->mloop[lt->tri[1]].v,
+        buffers->mloop[lt->tri[2]].v,
+    };
+
+    if (!gpu_pbvh_is_looptri_visible(lt, mvert, buffers->mloop, sculpt_face_sets)) {
+      continue;
+    }
+
+    uchar cmask = 0;
+    if (show_mask && !buffers->smooth) {
+      const float fmask = (vmask[vtri[0]] + vmask[vtri[1]] + vmask[vtri[2]]) / 3.0f;
+      cmask = (uchar)(fmask * 255);
+    }
+
+    for (uint j = 0; j < 3; j++) {
+      if (show_mask && buffers->smooth) {
+        cmask = (uchar)(vmask[vtri[j]] * 255);
+      }
+      *(uchar *)GPU_vertbuf_raw_step(&msk_step) = cmask;
+      empty_mask = empty_mask && (cmask == 0);
+    }
+  }
+
+  return empty_mask;
+}
+
+static void gpu_pbvh_batch_mask_add(GPUBatch *batch, GPUVertBuf *mask_buf)
+{
+  if (batch && mask_buf && !GPU_batch_vertbuf_has(batch, mask_buf)) {
+    GPU_batch_vertbuf_add(batch, mask_buf);
+  }
+}
+
 void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
                                   const MVert *mvert,
                                   const float (*vert_normals)[3],
@@ -208,26 +292,23 @@ void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
                               (update_flags & GPU_PBVH_BUFFERS_SHOW_SCULPT_FACE_SETS) != 0;
   const bool show_vcol = (vcol || (vtcol && U.experimental.use_sculpt_vertex_colors)) &&
                          (update_flags & GPU_PBVH_BUFFERS_SHOW_VCOL) != 0;
-  bool empty_mask = true;
   bool default_face_set = true;
 
   {
     const int totelem = buffers->tot_tri * 3;
 
     /* Build VBO */
-    if (gpu_pbvh_vert_buf_data_set(buffers, totelem)) {
+    if (gpu_pbvh_vbo_data_set(&buffers->vert_buf, &g_vbo_id.mesh_format, totelem)) {
       GPUVertBufRaw pos_step = {0};
       GPUVertBufRaw nor_step = {0};
-      GPUVertBufRaw msk_step = {0};
       GPUVertBufRaw fset_step = {0};
       GPUVertBufRaw col_step = {0};
 
-      GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.pos, &pos_step);
-      GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.nor, &nor_step);
-      GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.msk, &msk_step);
-      GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.fset, &fset_step);
+      GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.mesh_pos, &pos_step);
+      GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.mesh_nor, &nor_step);
+      GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.mesh_fset, &fset_step);
       if (show_vcol) {
-        GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.col, &col_step);
+        GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.mesh_col, &col_step);
       }
 
       /* calculate normal for each polygon only once */
@@ -265,13 +346,6 @@ void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
           }
         }
 
-        float fmask = 0.0f;
-        uchar cmask = 0;
-        if (show_mask && !buffers->smooth) {
-          fmask = (vmask[vtri[0]] + vmask[vtri[1]] + vmask[vtri[2]]) / 3.0f;
-          cmask = (uchar)(fmask * 255);
-        }
-
         for (uint j = 0; j < 3; j++) {
           const MVert *v = &mvert[vtri[j]];
           copy_v3_v3(GPU_vertbuf_raw_step(&pos_step), v->co);
@@ -281,12 +355,6 @@ void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
           }
           copy_v3_v3_short(GPU_vertbuf_raw_step(&nor_step), no);
 
-          if (show_mask && buffers->smooth) {
-            cmask = (uchar)(vmask[vtri[j]] * 255);
-          }
-
-          *(uchar *)GPU_vertbuf_raw_step(&msk_step) = cmask;
-          empty_mask = empty_mask && (cmask == 0);
           /* Vertex Colors. */
           if (show_vcol) {
             ushort scol[4] = {USHRT_MAX, USHRT_MAX, USHRT_MAX, USHRT_MAX};
@@ -316,15 +384,36 @@ void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
     gpu_pbvh_batch_init(buffers, GPU_PRIM_TRIS);
   }
 
+  const bool empty_mask = gpu_pbvh_mesh_mask_fill(
+      buffers, mvert, vmask, sculpt_face_sets, show_mask);
+  gpu_pbvh_batch_mask_add(buffers->triangles, buffers->mask_buf);
+  gpu_pbvh_batch_mask_add(buffers->triangles_fast, buffers->mask_buf);
+  gpu_pbvh_batch_mask_add(buffers->lines, buffers->mask_buf);
+  gpu_pbvh_batch_mask_add(buffers->lines_fast, buffers->mask_buf);
+
   /* Get material index from the first face of this buffer. */
   const MLoopTri *lt = &buffers->looptri[buffers->face_indices[0]];
   const MPoly *mp = &buffers->mpoly[lt->poly];
   buffers->material_index = mp->mat_nr;
 
+  buffers->show_face_set_overlay = !default_face_set;
   buffers->show_overlay = !empty_mask || !default_face_set;
   buffers->mvert = mvert;
 }
 
+void GPU_pbvh_mesh_buffers_update_mask(GPU_PBVH_Buffers *buffers,
+                                       const MVert *mvert,
+                                       const float *vmask,
+                                       const int *sculpt_face_sets,
+                                       const int update_flags)
+{
+  const bool show_mask = vmask && (update_flags & GPU_PBVH_BUFFERS_SHOW_MASK) != 0;
+  const bool empty_mask = gpu_pbvh_mesh_mask_fill(
+      buffers, mvert, vmask, sculpt_face_sets, show_mask);
+
+  buffers->show_overlay = !empty_mask || buffers->show_face_set_overlay;
+}
+
 GPU_PBVH_Buffers *GPU_pbvh_mesh_buffers_build(const MPoly *mpoly,
                                               const MLoop *mloop,
                                               const MLoopTri *looptri,
@@ -1072,6 +1161,7 @@ static void gpu_pbvh_buffers_clear(GPU_PBVH_Buffers *buffers)
   GPU_INDEXBUF_DISCARD_SAFE(buffers->index_buf_fast);
   GPU_INDEXBUF_DISCARD_SAFE(buffers->index_buf);
   GPU_VERTBUF_DISCARD_SAFE(buffers->vert_buf);
+  GPU_VERTBUF_DISCARD_SAFE(buffers->mask_buf);
 }
 
 void GPU_pbvh_buffers_update_flush(GPU_PBVH_Buffers *buffers)
@@ -1086,6 +1176,9 @@ void GPU_pbvh_buffers_update_flush(GPU_PBVH_Buffers *buffers)
   if (buffers->vert_buf && GPU_vertbuf_get_data(buffers->vert_buf)) {
     GPU_vertbuf_use(buffers->vert_buf);
   }
+  if (buffers->mask_buf && GPU_vertbuf_get_data(buffers->mask_buf)) {
+    GPU_vertbuf_use(buffers->mask_buf);
+  }
 }
 
 void GPU_pbvh_buffers_free(GPU_PBVH_Buffers *buffers)
@@ -52,6 +52,28 @@ Texture::~Texture()
 #endif
 }
 
+size_t Texture::memory_size_get() const
+{
+  if (type_ == GPU_TEXTURE_BUFFER) {
+    return 0;
+  }
+  size_t size = 0;
+  for (int mip = 0; mip < max_ii(1, mipmaps_); mip++) {
+    int extent[3] = {1, 1, 1};
+    mip_size_get(mip, extent);
+    if (format_flag_ & GPU_FORMAT_COMPRESSED) {
+      /* Compressed formats store blocks of 4x4 texels. */
+      extent[0] = divide_ceil_u(extent[0], 4);
+      extent[1] = divide_ceil_u(extent[1], 4);
+      size += to_block_size(format_) * extent[0] * extent[1] * extent[2];
+    }
+    else {
+      size += to_bytesize(format_) * extent[0] * extent[1] * extent[2];
+    }
+  }
+  return size;
+}
+
 bool Texture::init_1D(int w, int layers, int mips, eGPUTextureFormat format)
 {
   w_ = w;
@@ -620,6 +642,11 @@ int GPU_texture_mip_count(const GPUTexture *tex)
   return reinterpret_cast<const Texture *>(tex)->mip_count();
 }
 
+size_t GPU_texture_memory_size(const GPUTexture *tex)
+{
+  return reinterpret_cast<const Texture *>(tex)->memory_size_get();
+}
+
 int GPU_texture_orig_width(const GPUTexture *tex)
 {
   return reinterpret_cast<const Texture *>(tex)->src_w;
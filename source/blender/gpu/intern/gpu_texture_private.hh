@@ -215,6 +215,8 @@ class Texture {
     return mipmaps_;
   }
 
+  size_t memory_size_get() const;
+
   eGPUTextureFormat format_get() const
   {
     return format_;
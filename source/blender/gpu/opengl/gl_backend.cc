@@ -234,6 +234,7 @@ static void detect_workarounds()
     GLContext::geometry_shader_invocations = false;
     GLContext::layered_rendering_support = false;
     GLContext::native_barycentric_support = false;
+    GLContext::program_binary_support = false;
     GLContext::multi_bind_support = false;
     GLContext::multi_draw_indirect_support = false;
     GLContext::shader_draw_parameters_support = false;
@@ -441,6 +442,7 @@ bool GLContext::geometry_shader_invocations = false;
 bool GLContext::fixed_restart_index_support = false;
 bool GLContext::layered_rendering_support = false;
 bool GLContext::native_barycentric_support = false;
+bool GLContext::program_binary_support = false;
 bool GLContext::multi_bind_support = false;
 bool GLContext::multi_draw_indirect_support = false;
 bool GLContext::shader_draw_parameters_support = false;
@@ -509,6 +511,11 @@ void GLBackend::capabilities_init()
   GLContext::fixed_restart_index_support = GLEW_ARB_ES3_compatibility;
   GLContext::layered_rendering_support = GLEW_AMD_vertex_shader_layer;
   GLContext::native_barycentric_support = GLEW_AMD_shader_explicit_vertex_parameter;
+  if (GLEW_ARB_get_program_binary) {
+    GLint binary_formats_len = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binary_formats_len);
+    GLContext::program_binary_support = binary_formats_len > 0;
+  }
   GLContext::multi_bind_support = GLEW_ARB_multi_bind;
   GLContext::multi_draw_indirect_support = GLEW_ARB_multi_draw_indirect;
   GLContext::shader_draw_parameters_support = GLEW_ARB_shader_draw_parameters;
@@ -526,6 +533,10 @@ void GLBackend::capabilities_init()
     GLContext::debug_layer_support = false;
     GLContext::debug_layer_workaround = false;
   }
+  else {
+    /* Always compile the shaders when debugging, to get the compiler logs. */
+    GLContext::program_binary_support = false;
+  }
 }
 
 /** \} */
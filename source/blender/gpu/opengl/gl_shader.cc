@@ -5,8 +5,12 @@
  * \ingroup gpu
  */
 
+#include "BKE_appdir.h"
 #include "BKE_global.h"
 
+#include "BLI_fileops.h"
+#include "BLI_hash_md5.h"
+#include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_vector.hh"
 
@@ -753,6 +757,125 @@ bool GLShader::do_geometry_shader_injection(const shader::ShaderCreateInfo *info
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Program Binary Cache
+ *
+ * Linked programs are written to disk and loaded back in later sessions, which skips the
+ * compilation entirely. The key is a hash of the final sources of every stage and of the driver
+ * identification, so any change of either simply results in a new entry.
+ * \{ */
+
+/** Identifies the file format, to be bumped when the header changes. */
+#define PROGRAM_BINARY_MAGIC 0x42504c47 /* "GLPB" */
+
+struct ProgramBinaryHeader {
+  uint32_t magic;
+  uint32_t format;
+  uint32_t length;
+};
+
+std::string GLShader::program_binary_key() const
+{
+  std::string key;
+  key += (const char *)glGetString(GL_VENDOR);
+  key += (const char *)glGetString(GL_RENDERER);
+  key += (const char *)glGetString(GL_VERSION);
+  key += transform_feedback_key_;
+  for (const DeferredStage &stage : deferred_stages_) {
+    key += std::to_string(stage.gl_stage);
+    for (const std::string &source : stage.sources) {
+      key += source;
+    }
+  }
+
+  uchar digest[16];
+  char hex_digest[33];
+  BLI_hash_md5_buffer(key.data(), key.size(), digest);
+  return BLI_hash_md5_to_hexdigest(digest, hex_digest);
+}
+
+/**
+ * `BKE_appdir_folder_caches/gpu-shader-binaries/<key>.bin`.
+ */
+static bool program_binary_path_get(const char *key, char r_path[FILE_MAX])
+{
+  char dir[FILE_MAX];
+  if (!BKE_appdir_folder_caches(dir, sizeof(dir))) {
+    return false;
+  }
+  BLI_path_append(dir, sizeof(dir), "gpu-shader-binaries");
+  if (!BLI_is_dir(dir) && !BLI_dir_create_recursive(dir)) {
+    return false;
+  }
+
+  char filename[FILE_MAXFILE];
+  BLI_snprintf(filename, sizeof(filename), "%s.bin", key);
+  BLI_join_dirfile(r_path, FILE_MAX, dir, filename);
+  return true;
+}
+
+static bool program_binary_load(GLuint program, const char *path)
+{
+  FILE *file = BLI_fopen(path, "rb");
+  if (file == nullptr) {
+    return false;
+  }
+
+  ProgramBinaryHeader header;
+  Vector<char> binary;
+  bool is_valid = fread(&header, sizeof(header), 1, file) == 1 &&
+                  header.magic == PROGRAM_BINARY_MAGIC && header.length > 0;
+  if (is_valid) {
+    binary.resize(header.length);
+    is_valid = fread(binary.data(), header.length, 1, file) == 1;
+  }
+  fclose(file);
+
+  if (!is_valid) {
+    return false;
+  }
+
+  /* Fails when the driver rejects the binary, the program is then compiled and saved again. */
+  glProgramBinary(program, header.format, binary.data(), header.length);
+  GLint status;
+  glGetProgramiv(program, GL_LINK_STATUS, &status);
+  return status;
+}
+
+static void program_binary_save(GLuint program, const char *path)
+{
+  GLint length = 0;
+  glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0) {
+    return;
+  }
+
+  ProgramBinaryHeader header;
+  Vector<char> binary(length);
+  GLenum format;
+  glGetProgramBinary(program, length, nullptr, &format, binary.data());
+  header.magic = PROGRAM_BINARY_MAGIC;
+  header.format = format;
+  header.length = length;
+
+  /* Write to a temporary file first as other threads or instances might read the same entry. */
+  char tmp_path[FILE_MAX];
+  BLI_snprintf(tmp_path, sizeof(tmp_path), "%s.%p.tmp", path, (void *)binary.data());
+  FILE *file = BLI_fopen(tmp_path, "wb");
+  if (file == nullptr) {
+    return;
+  }
+  const bool is_written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                          fwrite(binary.data(), length, 1, file) == 1;
+  fclose(file);
+
+  if (!is_written || BLI_rename(tmp_path, path) != 0) {
+    BLI_delete(tmp_path, false, false);
+  }
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Shader stage creation
  * \{ */
@@ -860,6 +983,24 @@ char *GLShader::glsl_patch_get(GLenum gl_stage)
 }
 
 GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources)
+{
+  /* Patch the shader code using the first source slot. */
+  sources[0] = glsl_patch_get(gl_stage);
+
+  if (GLContext::program_binary_support) {
+    DeferredStage stage;
+    stage.gl_stage = gl_stage;
+    for (const char *source : sources) {
+      stage.sources.append(source);
+    }
+    deferred_stages_.append(std::move(stage));
+    return 0;
+  }
+
+  return this->compile_shader_stage(gl_stage, sources);
+}
+
+GLuint GLShader::compile_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources)
 {
   GLuint shader = glCreateShader(gl_stage);
   if (shader == 0) {
@@ -867,9 +1008,6 @@ GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *>
     return 0;
   }
 
-  /* Patch the shader code using the first source slot. */
-  sources[0] = glsl_patch_get(gl_stage);
-
   glShaderSource(shader, sources.size(), sources.data(), nullptr);
   glCompileShader(shader);
 
@@ -926,6 +1064,34 @@ void GLShader::fragment_shader_from_glsl(MutableSpan<const char *> sources)
 void GLShader::compute_shader_from_glsl(MutableSpan<const char *> sources)
 {
   compute_shader_ = this->create_shader_stage(GL_COMPUTE_SHADER, sources);
+  is_compute_ = true;
+}
+
+bool GLShader::compile_deferred_stages()
+{
+  for (DeferredStage &stage : deferred_stages_) {
+    Vector<const char *> sources;
+    for (const std::string &source : stage.sources) {
+      sources.append(source.c_str());
+    }
+    const GLuint shader = this->compile_shader_stage(stage.gl_stage, sources);
+    switch (stage.gl_stage) {
+      case GL_VERTEX_SHADER:
+        vert_shader_ = shader;
+        break;
+      case GL_GEOMETRY_SHADER:
+        geom_shader_ = shader;
+        break;
+      case GL_FRAGMENT_SHADER:
+        frag_shader_ = shader;
+        break;
+      case GL_COMPUTE_SHADER:
+        compute_shader_ = shader;
+        break;
+    }
+  }
+  deferred_stages_.clear();
+  return !compilation_failed_;
 }
 
 bool GLShader::finalize(const shader::ShaderCreateInfo *info)
@@ -942,17 +1108,40 @@ bool GLShader::finalize(const shader::ShaderCreateInfo *info)
     geometry_shader_from_glsl(sources);
   }
 
-  glLinkProgram(shader_program_);
+  char binary_path[FILE_MAX] = "";
+  bool is_linked = false;
+  if (!deferred_stages_.is_empty()) {
+    if (program_binary_path_get(this->program_binary_key().c_str(), binary_path)) {
+      is_linked = program_binary_load(shader_program_, binary_path);
+    }
+    if (is_linked) {
+      deferred_stages_.clear();
+    }
+    else {
+      if (!this->compile_deferred_stages()) {
+        return false;
+      }
+      glProgramParameteri(shader_program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+  }
 
-  GLint status;
-  glGetProgramiv(shader_program_, GL_LINK_STATUS, &status);
-  if (!status) {
-    char log[5000];
-    glGetProgramInfoLog(shader_program_, sizeof(log), nullptr, log);
-    Span<const char *> sources;
-    GLLogParser parser;
-    this->print_log(sources, log, "Linking", true, &parser);
-    return false;
+  if (!is_linked) {
+    glLinkProgram(shader_program_);
+
+    GLint status;
+    glGetProgramiv(shader_program_, GL_LINK_STATUS, &status);
+    if (!status) {
+      char log[5000];
+      glGetProgramInfoLog(shader_program_, sizeof(log), nullptr, log);
+      Span<const char *> sources;
+      GLLogParser parser;
+      this->print_log(sources, log, "Linking", true, &parser);
+      return false;
+    }
+
+    if (binary_path[0] != '\0') {
+      program_binary_save(shader_program_, binary_path);
+    }
   }
 
   if (info != nullptr) {
@@ -998,6 +1187,11 @@ void GLShader::transform_feedback_names_set(Span<const char *> name_list,
   glTransformFeedbackVaryings(
       shader_program_, name_list.size(), name_list.data(), GL_INTERLEAVED_ATTRIBS);
   transform_feedback_type_ = geom_type;
+
+  transform_feedback_key_ = std::to_string(geom_type);
+  for (const char *name : name_list) {
+    transform_feedback_key_ += std::string(" ") + name;
+  }
 }
 
 bool GLShader::transform_feedback_enable(GPUVertBuf *buf_)
@@ -34,6 +34,20 @@ class GLShader : public Shader {
   GLuint compute_shader_ = 0;
   /** True if any shader failed to compile. */
   bool compilation_failed_ = false;
+  /** Compute shaders are not compiled when the program is loaded from the binary cache. */
+  bool is_compute_ = false;
+
+  /**
+   * Sources of the stages, kept until #finalize when the program binary cache is used, so the
+   * compilation can be skipped when a binary of the same sources exists.
+   */
+  struct DeferredStage {
+    GLenum gl_stage;
+    Vector<std::string> sources;
+  };
+  Vector<DeferredStage> deferred_stages_;
+  /** Transform feedback setup, part of the binary cache key. */
+  std::string transform_feedback_key_;
 
   eGPUShaderTFBType transform_feedback_type_ = GPU_SHADER_TFB_NONE;
 
@@ -74,14 +88,22 @@ class GLShader : public Shader {
 
   bool is_compute() const
   {
-    return compute_shader_ != 0;
+    return is_compute_;
   }
 
  private:
   char *glsl_patch_get(GLenum gl_stage);
 
-  /** Create, compile and attach the shader stage to the shader program. */
+  /**
+   * Create, compile and attach the shader stage to the shader program. When the program binary
+   * cache is used, the compilation is deferred to #finalize and 0 is returned.
+   */
   GLuint create_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources);
+  GLuint compile_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources);
+  /** Compile the stages deferred by #create_shader_stage. Return false on failure. */
+  bool compile_deferred_stages();
+  /** Key of the program in the binary cache, a hash of all the sources. */
+  std::string program_binary_key() const;
 
   /**
    * \brief features available on newer implementation such as native barycentric coordinates
@@ -75,6 +75,16 @@ struct ImBuf *IMB_thumb_manage(const char *path, ThumbSize size, ThumbSource sou
  */
 void IMB_thumb_makedirs(void);
 
+/**
+ * Load an image to create a thumbnail from. File types that support it are decoded at a reduced
+ * resolution that is at least \a max_thumb_size large, others are loaded at full resolution.
+ * The size of the full image is returned in \a r_width and \a r_height.
+ */
+struct ImBuf *IMB_thumb_load_image(const char *filepath,
+                                   size_t max_thumb_size,
+                                   size_t *r_width,
+                                   size_t *r_height);
+
 /**
  * Special function for loading a thumbnail embedded into a blend file.
  */
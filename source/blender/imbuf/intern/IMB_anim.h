@@ -64,6 +64,10 @@
 
 #define MAXNUMSTREAMS 50
 
+/* Limits of the decoded frames cache of movies, see #anim.frame_cache. */
+#define FFMPEG_FRAME_CACHE_MAX_LEN 64
+#define FFMPEG_FRAME_CACHE_MAX_SIZE ((size_t)128 * 1024 * 1024)
+
 struct IDProperty;
 struct _AviMovie;
 struct anim_index;
@@ -114,8 +118,25 @@ struct anim {
   AVFrame *pFrameRGB;
   AVFrame *pFrameDeinterlaced;
   struct SwsContext *img_convert_ctx;
+  /* Pixel format #img_convert_ctx converts from. */
+  enum AVPixelFormat img_convert_src_format;
   int videoStream;
 
+  /* Hardware decoding device, NULL when decoding in software. */
+  AVBufferRef *hw_device_ctx;
+  /* Pixel format of decoded hardware frames, #AV_PIX_FMT_NONE when decoding in software. */
+  enum AVPixelFormat hw_pix_fmt;
+  /* Hardware frames downloaded to system memory. */
+  AVFrame *pFrameSW;
+
+  /* Ring buffer of references to recently decoded frames, oldest first. Stepping back within a
+   * group of pictures then doesn't need decoding it again from its key frame. */
+  AVFrame *frame_cache[FFMPEG_FRAME_CACHE_MAX_LEN];
+  int64_t frame_cache_pts[FFMPEG_FRAME_CACHE_MAX_LEN];
+  int frame_cache_start;
+  int frame_cache_len;
+  size_t frame_cache_size;
+
   struct ImBuf *cur_frame_final;
   int64_t cur_pts;
   int64_t cur_key_frame_pts;
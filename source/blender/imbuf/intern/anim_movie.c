@@ -43,6 +43,7 @@
 #include "BLI_utildefines.h"
 
 #include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
 
 #include "MEM_guardedalloc.h"
 
@@ -65,6 +66,7 @@
 
 #  include <libavcodec/avcodec.h>
 #  include <libavformat/avformat.h>
+#  include <libavutil/hwcontext.h>
 #  include <libavutil/imgutils.h>
 #  include <libavutil/rational.h>
 #  include <libswscale/swscale.h>
@@ -488,6 +490,130 @@ static ImBuf *avi_fetchibuf(struct anim *anim, int position)
 
 #ifdef WITH_FFMPEG
 
+/* Hardware decoding device types to try, in order of preference. */
+static const enum AVHWDeviceType ffmpeg_hw_device_types[] = {
+#  if defined(_WIN32)
+    AV_HWDEVICE_TYPE_D3D11VA,
+    AV_HWDEVICE_TYPE_CUDA,
+#  elif defined(__APPLE__)
+    AV_HWDEVICE_TYPE_VIDEOTOOLBOX,
+#  else
+    AV_HWDEVICE_TYPE_VAAPI,
+    AV_HWDEVICE_TYPE_CUDA,
+#  endif
+};
+
+static enum AVPixelFormat ffmpeg_get_hw_format(AVCodecContext *pCodecCtx,
+                                               const enum AVPixelFormat *pix_fmts)
+{
+  const struct anim *anim = pCodecCtx->opaque;
+  for (const enum AVPixelFormat *pix_fmt = pix_fmts; *pix_fmt != AV_PIX_FMT_NONE; pix_fmt++) {
+    if (*pix_fmt == anim->hw_pix_fmt) {
+      return *pix_fmt;
+    }
+  }
+  /* The stream can't be decoded by the device (e.g. unsupported profile), use software. */
+  return avcodec_default_get_format(pCodecCtx, pix_fmts);
+}
+
+/* Sets up hardware decoding of the codec context when enabled in the preferences and a device
+ * supporting the codec is available. Decoded frames are then downloaded in
+ * #ffmpeg_postprocess. */
+static void ffmpeg_hw_decoding_init(struct anim *anim,
+                                    AVCodecContext *pCodecCtx,
+                                    const AVCodec *pCodec)
+{
+  anim->hw_device_ctx = NULL;
+  anim->hw_pix_fmt = AV_PIX_FMT_NONE;
+
+  /* Deinterlacing works on the codec pixel format, which downloaded frames may not have. */
+  if (!(U.flag & USER_FFMPEG_HW_DECODING) || (anim->ib_flags & IB_animdeinterlace)) {
+    return;
+  }
+
+  for (int i = 0; i < ARRAY_SIZE(ffmpeg_hw_device_types); i++) {
+    const enum AVHWDeviceType device_type = ffmpeg_hw_device_types[i];
+    for (int config_index = 0;; config_index++) {
+      const AVCodecHWConfig *config = avcodec_get_hw_config(pCodec, config_index);
+      if (config == NULL) {
+        break;
+      }
+      if (!(config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) ||
+          config->device_type != device_type) {
+        continue;
+      }
+      if (av_hwdevice_ctx_create(&anim->hw_device_ctx, device_type, NULL, NULL, 0) < 0) {
+        break;
+      }
+      anim->hw_pix_fmt = config->pix_fmt;
+      pCodecCtx->hw_device_ctx = av_buffer_ref(anim->hw_device_ctx);
+      pCodecCtx->opaque = anim;
+      pCodecCtx->get_format = ffmpeg_get_hw_format;
+      /* Hardware decoders do their own scheduling, frame threads would only add latency. */
+      pCodecCtx->thread_count = 1;
+      av_log(anim->pFormatCtx,
+             AV_LOG_INFO,
+             "Using %s hardware decoding\n",
+             av_hwdevice_get_type_name(device_type));
+      return;
+    }
+  }
+}
+
+/* Creates the context converting frames of given pixel format to RGBA. */
+static bool ffmpeg_sws_context_init(struct anim *anim, const enum AVPixelFormat src_format)
+{
+  /* The following for color space determination */
+  int srcRange, dstRange, brightness, contrast, saturation;
+  int *table;
+  const int *inv_table;
+
+  sws_freeContext(anim->img_convert_ctx);
+  anim->img_convert_ctx = sws_getContext(anim->x,
+                                         anim->y,
+                                         src_format,
+                                         anim->x,
+                                         anim->y,
+                                         AV_PIX_FMT_RGBA,
+                                         SWS_BILINEAR | SWS_PRINT_INFO | SWS_FULL_CHR_H_INT,
+                                         NULL,
+                                         NULL,
+                                         NULL);
+  anim->img_convert_src_format = src_format;
+
+  if (!anim->img_convert_ctx) {
+    return false;
+  }
+
+  /* Try do detect if input has 0-255 YCbCR range (JFIF Jpeg MotionJpeg) */
+  if (!sws_getColorspaceDetails(anim->img_convert_ctx,
+                                (int **)&inv_table,
+                                &srcRange,
+                                &table,
+                                &dstRange,
+                                &brightness,
+                                &contrast,
+                                &saturation)) {
+    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
+    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
+
+    if (sws_setColorspaceDetails(anim->img_convert_ctx,
+                                 (int *)inv_table,
+                                 srcRange,
+                                 table,
+                                 dstRange,
+                                 brightness,
+                                 contrast,
+                                 saturation)) {
+      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+    }
+  }
+  else {
+    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+  }
+  return true;
+}
+
 static int startffmpeg(struct anim *anim)
 {
   int i, video_stream_index;
@@ -501,11 +627,6 @@ static int startffmpeg(struct anim *anim)
   double frs_den;
   int streamcount;
 
-  /* The following for color space determination */
-  int srcRange, dstRange, brightness, contrast, saturation;
-  int *table;
-  const int *inv_table;
-
   if (anim == NULL) {
     return (-1);
   }
@@ -569,12 +690,16 @@ static int startffmpeg(struct anim *anim)
     pCodecCtx->thread_type = FF_THREAD_SLICE;
   }
 
+  ffmpeg_hw_decoding_init(anim, pCodecCtx, pCodec);
+
   if (avcodec_open2(pCodecCtx, pCodec, NULL) < 0) {
+    av_buffer_unref(&anim->hw_device_ctx);
     avformat_close_input(&pFormatCtx);
     return -1;
   }
   if (pCodecCtx->pix_fmt == AV_PIX_FMT_NONE) {
     avcodec_free_context(&anim->pCodecCtx);
+    av_buffer_unref(&anim->hw_device_ctx);
     avformat_close_input(&pFormatCtx);
     return -1;
   }
@@ -684,6 +809,7 @@ static int startffmpeg(struct anim *anim)
 
   anim->pFrame = av_frame_alloc();
   anim->pFrameComplete = false;
+  anim->pFrameSW = av_frame_alloc();
   anim->pFrameDeinterlaced = av_frame_alloc();
   anim->pFrameRGB = av_frame_alloc();
   anim->pFrameRGB->format = AV_PIX_FMT_RGBA;
@@ -697,7 +823,9 @@ static int startffmpeg(struct anim *anim)
     av_packet_free(&anim->cur_packet);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
+    av_frame_free(&anim->pFrameSW);
     av_frame_free(&anim->pFrame);
+    av_buffer_unref(&anim->hw_device_ctx);
     anim->pCodecCtx = NULL;
     return -1;
   }
@@ -709,7 +837,9 @@ static int startffmpeg(struct anim *anim)
     av_packet_free(&anim->cur_packet);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
+    av_frame_free(&anim->pFrameSW);
     av_frame_free(&anim->pFrame);
+    av_buffer_unref(&anim->hw_device_ctx);
     anim->pCodecCtx = NULL;
     return -1;
   }
@@ -728,75 +858,34 @@ static int startffmpeg(struct anim *anim)
                          1);
   }
 
-  anim->img_convert_ctx = sws_getContext(anim->x,
-                                         anim->y,
-                                         anim->pCodecCtx->pix_fmt,
-                                         anim->x,
-                                         anim->y,
-                                         AV_PIX_FMT_RGBA,
-                                         SWS_BILINEAR | SWS_PRINT_INFO | SWS_FULL_CHR_H_INT,
-                                         NULL,
-                                         NULL,
-                                         NULL);
-
-  if (!anim->img_convert_ctx) {
+  anim->img_convert_ctx = NULL;
+  if (!ffmpeg_sws_context_init(anim, anim->pCodecCtx->pix_fmt)) {
     fprintf(stderr, "Can't transform color space??? Bailing out...\n");
     avcodec_free_context(&anim->pCodecCtx);
     avformat_close_input(&anim->pFormatCtx);
     av_packet_free(&anim->cur_packet);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
+    av_frame_free(&anim->pFrameSW);
     av_frame_free(&anim->pFrame);
+    av_buffer_unref(&anim->hw_device_ctx);
     anim->pCodecCtx = NULL;
     return -1;
   }
 
-  /* Try do detect if input has 0-255 YCbCR range (JFIF Jpeg MotionJpeg) */
-  if (!sws_getColorspaceDetails(anim->img_convert_ctx,
-                                (int **)&inv_table,
-                                &srcRange,
-                                &table,
-                                &dstRange,
-                                &brightness,
-                                &contrast,
-                                &saturation)) {
-    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
-    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
-
-    if (sws_setColorspaceDetails(anim->img_convert_ctx,
-                                 (int *)inv_table,
-                                 srcRange,
-                                 table,
-                                 dstRange,
-                                 brightness,
-                                 contrast,
-                                 saturation)) {
-      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-    }
-  }
-  else {
-    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-  }
-
   return 0;
 }
 
-/* postprocess the image in anim->pFrame and do color conversion
+/* postprocess the decoded image \a input and do color conversion
  * and deinterlacing stuff.
  *
- * Output is anim->cur_frame_final
+ * Output is \a ibuf
  */
 
-static void ffmpeg_postprocess(struct anim *anim)
+static void ffmpeg_postprocess(struct anim *anim, AVFrame *input, ImBuf *ibuf)
 {
-  AVFrame *input = anim->pFrame;
-  ImBuf *ibuf = anim->cur_frame_final;
   int filter_y = 0;
 
-  if (!anim->pFrameComplete) {
-    return;
-  }
-
   /* This means the data wasn't read properly,
    * this check stops crashing */
   if (input->data[0] == 0 && input->data[1] == 0 && input->data[2] == 0 && input->data[3] == 0) {
@@ -814,9 +903,25 @@ static void ffmpeg_postprocess(struct anim *anim)
          input->data[2],
          input->data[3]);
 
+  if (input->format == anim->hw_pix_fmt) {
+    /* Download the frame to system memory, in a format chosen by the device. */
+    av_frame_unref(anim->pFrameSW);
+    if (av_hwframe_transfer_data(anim->pFrameSW, input, 0) < 0) {
+      fprintf(stderr, "ffmpeg_postprocess: could not download hardware frame\n");
+      return;
+    }
+    input = anim->pFrameSW;
+  }
+
+  if (input->format != anim->img_convert_src_format &&
+      !ffmpeg_sws_context_init(anim, input->format)) {
+    fprintf(stderr, "ffmpeg_postprocess: can't transform color space\n");
+    return;
+  }
+
   if (anim->ib_flags & IB_animdeinterlace) {
     if (av_image_deinterlace(anim->pFrameDeinterlaced,
-                             anim->pFrame,
+                             input,
                              anim->pCodecCtx->pix_fmt,
                              anim->pCodecCtx->width,
                              anim->pCodecCtx->height) < 0) {
@@ -852,9 +957,80 @@ static void ffmpeg_postprocess(struct anim *anim)
   }
 }
 
+static size_t ffmpeg_frame_cache_frame_size(const AVFrame *frame)
+{
+  return (size_t)av_image_get_buffer_size(frame->format, frame->width, frame->height, 1);
+}
+
+static void ffmpeg_frame_cache_remove_oldest(struct anim *anim)
+{
+  AVFrame **frame = &anim->frame_cache[anim->frame_cache_start];
+  anim->frame_cache_size -= ffmpeg_frame_cache_frame_size(*frame);
+  av_frame_free(frame);
+  anim->frame_cache_start = (anim->frame_cache_start + 1) % FFMPEG_FRAME_CACHE_MAX_LEN;
+  anim->frame_cache_len--;
+}
+
+/* Cached frame displayed at given pts, NULL if not cached. */
+static AVFrame *ffmpeg_frame_cache_find(struct anim *anim, const int64_t pts_to_search)
+{
+  for (int i = 0; i < anim->frame_cache_len; i++) {
+    const int index = (anim->frame_cache_start + i) % FFMPEG_FRAME_CACHE_MAX_LEN;
+    AVFrame *frame = anim->frame_cache[index];
+    const int64_t diff = pts_to_search - anim->frame_cache_pts[index];
+    if (diff >= 0 && diff < MAX2(frame->pkt_duration, 1)) {
+      return frame;
+    }
+  }
+  return NULL;
+}
+
+/* Keeps a reference to given decoded frame, so that it doesn't have to be decoded again when
+ * stepping back within the group of pictures. Decoded buffers are reference counted, so this
+ * doesn't copy the frame. */
+static void ffmpeg_frame_cache_add(struct anim *anim, AVFrame *frame, const int64_t pts)
+{
+  /* Hardware frames are allocated from a small pool of surfaces needed by the decoder. */
+  if (frame->format == anim->hw_pix_fmt || pts == AV_NOPTS_VALUE) {
+    return;
+  }
+  /* Frames are decoded again after seeking back to their key frame. */
+  if (ffmpeg_frame_cache_find(anim, pts)) {
+    return;
+  }
+  const size_t frame_size = ffmpeg_frame_cache_frame_size(frame);
+  while (anim->frame_cache_len > 0 &&
+         (anim->frame_cache_len == FFMPEG_FRAME_CACHE_MAX_LEN ||
+          anim->frame_cache_size + frame_size > FFMPEG_FRAME_CACHE_MAX_SIZE)) {
+    ffmpeg_frame_cache_remove_oldest(anim);
+  }
+  if (frame_size > FFMPEG_FRAME_CACHE_MAX_SIZE) {
+    return;
+  }
+
+  AVFrame *cached_frame = av_frame_clone(frame);
+  if (cached_frame == NULL) {
+    return;
+  }
+  const int index = (anim->frame_cache_start + anim->frame_cache_len) %
+                    FFMPEG_FRAME_CACHE_MAX_LEN;
+  anim->frame_cache[index] = cached_frame;
+  anim->frame_cache_pts[index] = pts;
+  anim->frame_cache_len++;
+  anim->frame_cache_size += frame_size;
+}
+
+static void ffmpeg_frame_cache_free(struct anim *anim)
+{
+  while (anim->frame_cache_len > 0) {
+    ffmpeg_frame_cache_remove_oldest(anim);
+  }
+}
+
 static void ffmpeg_decode_store_frame_pts(struct anim *anim)
 {
   anim->cur_pts = av_get_pts_from_frame(anim->pFrame);
+  ffmpeg_frame_cache_add(anim, anim->pFrame, anim->cur_pts);
 
   if (anim->pFrame->key_frame) {
     anim->cur_key_frame_pts = anim->cur_pts;
@@ -1310,6 +1486,44 @@ static int ffmpeg_seek_to_key_frame(struct anim *anim,
   return ret;
 }
 
+/* Allocates an image for a decoded frame of given movie. */
+static ImBuf *ffmpeg_ibuf_alloc(struct anim *anim)
+{
+  /* Certain versions of FFmpeg have a bug in libswscale which ends up in crash
+   * when destination buffer is not properly aligned. For example, this happens
+   * in FFmpeg 4.3.1. It got fixed later on, but for compatibility reasons is
+   * still best to avoid crash.
+   *
+   * This is achieved by using own allocation call rather than relying on
+   * IMB_allocImBuf() to do so since the IMB_allocImBuf() is not guaranteed
+   * to perform aligned allocation.
+   *
+   * In theory this could give better performance, since SIMD operations on
+   * aligned data are usually faster.
+   *
+   * Note that even though sometimes vertical flip is required it does not
+   * affect on alignment of data passed to sws_scale because if the X dimension
+   * is not 32 byte aligned special intermediate buffer is allocated.
+   *
+   * The issue was reported to FFmpeg under ticket #8747 in the FFmpeg tracker
+   * and is fixed in the newer versions than 4.3.1. */
+
+  const AVPixFmtDescriptor *pix_fmt_descriptor = av_pix_fmt_desc_get(anim->pCodecCtx->pix_fmt);
+
+  int planes = R_IMF_PLANES_RGBA;
+  if ((pix_fmt_descriptor->flags & AV_PIX_FMT_FLAG_ALPHA) == 0) {
+    planes = R_IMF_PLANES_RGB;
+  }
+
+  ImBuf *ibuf = IMB_allocImBuf(anim->x, anim->y, planes, 0);
+  ibuf->rect = MEM_mallocN_aligned((size_t)4 * anim->x * anim->y, 32, "ffmpeg ibuf");
+  ibuf->mall |= IB_rect;
+
+  ibuf->rect_colorspace = colormanage_colorspace_get_named(anim->colorspace);
+
+  return ibuf;
+}
+
 static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Type tc)
 {
   if (anim == NULL) {
@@ -1348,47 +1562,28 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
     av_log(anim->pFormatCtx, AV_LOG_DEBUG, "FETCH: no seek necessary, just continue...\n");
     ffmpeg_decode_video_frame(anim);
   }
-  else if (ffmpeg_seek_to_key_frame(anim, position, tc_index, pts_to_search) >= 0) {
-    ffmpeg_decode_video_frame_scan(anim, pts_to_search);
+  else {
+    AVFrame *cached_frame = ffmpeg_frame_cache_find(anim, pts_to_search);
+    if (cached_frame) {
+      /* The decoder state is left untouched, so that sequential decoding can continue from where
+       * it is. The cached frame is not stored as the current frame for the same reason. */
+      av_log(anim->pFormatCtx, AV_LOG_DEBUG, "FETCH: found in decoded frames cache\n");
+      ImBuf *ibuf = ffmpeg_ibuf_alloc(anim);
+      ffmpeg_postprocess(anim, cached_frame, ibuf);
+      return ibuf;
+    }
+    if (ffmpeg_seek_to_key_frame(anim, position, tc_index, pts_to_search) >= 0) {
+      ffmpeg_decode_video_frame_scan(anim, pts_to_search);
+    }
   }
 
   IMB_freeImBuf(anim->cur_frame_final);
+  anim->cur_frame_final = ffmpeg_ibuf_alloc(anim);
 
-  /* Certain versions of FFmpeg have a bug in libswscale which ends up in crash
-   * when destination buffer is not properly aligned. For example, this happens
-   * in FFmpeg 4.3.1. It got fixed later on, but for compatibility reasons is
-   * still best to avoid crash.
-   *
-   * This is achieved by using own allocation call rather than relying on
-   * IMB_allocImBuf() to do so since the IMB_allocImBuf() is not guaranteed
-   * to perform aligned allocation.
-   *
-   * In theory this could give better performance, since SIMD operations on
-   * aligned data are usually faster.
-   *
-   * Note that even though sometimes vertical flip is required it does not
-   * affect on alignment of data passed to sws_scale because if the X dimension
-   * is not 32 byte aligned special intermediate buffer is allocated.
-   *
-   * The issue was reported to FFmpeg under ticket #8747 in the FFmpeg tracker
-   * and is fixed in the newer versions than 4.3.1. */
-
-  const AVPixFmtDescriptor *pix_fmt_descriptor = av_pix_fmt_desc_get(anim->pCodecCtx->pix_fmt);
-
-  int planes = R_IMF_PLANES_RGBA;
-  if ((pix_fmt_descriptor->flags & AV_PIX_FMT_FLAG_ALPHA) == 0) {
-    planes = R_IMF_PLANES_RGB;
+  if (anim->pFrameComplete) {
+    ffmpeg_postprocess(anim, anim->pFrame, anim->cur_frame_final);
   }
 
-  anim->cur_frame_final = IMB_allocImBuf(anim->x, anim->y, planes, 0);
-  anim->cur_frame_final->rect = MEM_mallocN_aligned(
-      (size_t)4 * anim->x * anim->y, 32, "ffmpeg ibuf");
-  anim->cur_frame_final->mall |= IB_rect;
-
-  anim->cur_frame_final->rect_colorspace = colormanage_colorspace_get_named(anim->colorspace);
-
-  ffmpeg_postprocess(anim);
-
   anim->cur_position = position;
 
   IMB_refImBuf(anim->cur_frame_final);
@@ -1407,9 +1602,12 @@ static void free_anim_ffmpeg(struct anim *anim)
     avformat_close_input(&anim->pFormatCtx);
     av_packet_free(&anim->cur_packet);
 
+    ffmpeg_frame_cache_free(anim);
     av_frame_free(&anim->pFrame);
+    av_frame_free(&anim->pFrameSW);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
+    av_buffer_unref(&anim->hw_device_ctx);
 
     sws_freeContext(anim->img_convert_ctx);
     IMB_freeImBuf(anim->cur_frame_final);
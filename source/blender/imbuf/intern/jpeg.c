@@ -39,7 +39,11 @@ static void skip_input_data(j_decompress_ptr cinfo, long num_bytes);
 static void term_source(j_decompress_ptr cinfo);
 static void memory_source(j_decompress_ptr cinfo, const unsigned char *buffer, size_t size);
 static boolean handle_app1(j_decompress_ptr cinfo);
-static ImBuf *ibJpegImageFromCinfo(struct jpeg_decompress_struct *cinfo, int flags);
+static ImBuf *ibJpegImageFromCinfo(struct jpeg_decompress_struct *cinfo,
+                                   int flags,
+                                   int max_size,
+                                   size_t *r_width,
+                                   size_t *r_height);
 
 static const uchar jpeg_default_quality = 75;
 static uchar ibuf_quality;
@@ -246,7 +250,16 @@ static boolean handle_app1(j_decompress_ptr cinfo)
   return true;
 }
 
-static ImBuf *ibJpegImageFromCinfo(struct jpeg_decompress_struct *cinfo, int flags)
+/**
+ * \param max_size: When larger than zero, the image is scaled down while decoding, as long as
+ * it stays at least this large. The size of the full image is returned in \a r_width and
+ * \a r_height.
+ */
+static ImBuf *ibJpegImageFromCinfo(struct jpeg_decompress_struct *cinfo,
+                                   int flags,
+                                   int max_size,
+                                   size_t *r_width,
+                                   size_t *r_height)
 {
   JSAMPARRAY row_pointer;
   JSAMPLE *buffer = NULL;
@@ -272,6 +285,26 @@ static ImBuf *ibJpegImageFromCinfo(struct jpeg_decompress_struct *cinfo, int fla
       cinfo->out_color_space = JCS_CMYK;
     }
 
+    if (r_width) {
+      *r_width = x;
+    }
+    if (r_height) {
+      *r_height = y;
+    }
+
+    if (max_size > 0) {
+      /* The decoder can scale down by 1/2, 1/4 and 1/8, which skips most of the work of
+       * decoding the full image. */
+      cinfo->scale_num = 1;
+      cinfo->scale_denom = 8;
+      while (cinfo->scale_denom > 1 && MAX2(x, y) < max_size * (int)cinfo->scale_denom) {
+        cinfo->scale_denom /= 2;
+      }
+      jpeg_calc_output_dimensions(cinfo);
+      x = cinfo->output_width;
+      y = cinfo->output_height;
+    }
+
     jpeg_start_decompress(cinfo);
 
     if (flags & IB_test) {
@@ -449,11 +482,51 @@ ImBuf *imb_load_jpeg(const unsigned char *buffer,
   jpeg_create_decompress(cinfo);
   memory_source(cinfo, buffer, size);
 
-  ibuf = ibJpegImageFromCinfo(cinfo, flags);
+  ibuf = ibJpegImageFromCinfo(cinfo, flags, 0, NULL, NULL);
 
   return ibuf;
 }
 
+struct ImBuf *imb_thumbnail_jpeg(const char *filepath,
+                                 const int flags,
+                                 const size_t max_thumb_size,
+                                 char colorspace[IM_MAX_SPACE],
+                                 size_t *r_width,
+                                 size_t *r_height)
+{
+  struct jpeg_decompress_struct _cinfo, *cinfo = &_cinfo;
+  struct my_error_mgr jerr;
+  FILE *infile;
+
+  if ((infile = BLI_fopen(filepath, "rb")) == NULL) {
+    fprintf(stderr, "can't open %s\n", filepath);
+    return NULL;
+  }
+
+  colorspace_set_default_role(colorspace, IM_MAX_SPACE, COLOR_ROLE_DEFAULT_BYTE);
+
+  cinfo->err = jpeg_std_error(&jerr.pub);
+  jerr.pub.error_exit = jpeg_error;
+
+  /* Establish the setjmp return context for my_error_exit to use. */
+  if (setjmp(jerr.setjmp_buffer)) {
+    /* If we get here, the JPEG code has signaled an error.
+     * We need to clean up the JPEG object, close the input file, and return.
+     */
+    jpeg_destroy_decompress(cinfo);
+    fclose(infile);
+    return NULL;
+  }
+
+  jpeg_create_decompress(cinfo);
+  jpeg_stdio_src(cinfo, infile);
+
+  ImBuf *ibuf = ibJpegImageFromCinfo(cinfo, flags, (int)max_thumb_size, r_width, r_height);
+
+  fclose(infile);
+  return ibuf;
+}
+
 static void write_jpeg(struct jpeg_compress_struct *cinfo, struct ImBuf *ibuf)
 {
   JSAMPLE *buffer = NULL;
@@ -602,7 +675,9 @@ static int init_jpeg(FILE *outfile, struct jpeg_compress_struct *cinfo, struct I
 
   /* own settings */
 
-  cinfo->dct_method = JDCT_FLOAT;
+  /* The integer DCT is as accurate as the floating point one for 8 bit images, and unlike it the
+   * SIMD versions of libjpeg-turbo are used on all platforms. */
+  cinfo->dct_method = JDCT_ISLOW;
   jpeg_set_quality(cinfo, quality, true);
 
   return 0;
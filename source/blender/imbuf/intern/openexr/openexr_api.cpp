@@ -1206,6 +1206,20 @@ void IMB_exrtile_write_channels(
   }
 }
 
+/** Set the values of all channels in a part to zero. */
+static void imb_exr_clear_part_channels(ExrHandle *data, const int part)
+{
+  const size_t pixels_num = size_t(data->width) * size_t(data->height);
+  LISTBASE_FOREACH (ExrChannel *, echan, &data->channels) {
+    if (echan->m->part_number != part || echan->rect == nullptr) {
+      continue;
+    }
+    for (size_t i = 0; i < pixels_num; i++) {
+      echan->rect[i * echan->xstride] = 0.0f;
+    }
+  }
+}
+
 void IMB_exr_read_channels(void *handle)
 {
   ExrHandle *data = (ExrHandle *)handle;
@@ -1226,12 +1240,28 @@ void IMB_exr_read_channels(void *handle)
       "name",
       "internal_name");
 
+  /* The buffers of the channels have the size of the data window of the first part. */
+  const Box2i full_dw = data->ifile->header(0).dataWindow();
+
   for (int i = 0; i < numparts; i++) {
     /* Read part header. */
     InputPart in(*data->ifile, i);
     Header header = in.header();
     Box2i dw = header.dataWindow();
 
+    /* Parts with a smaller data window only fill a region of the buffers, the rest is cleared.
+     * Parts that don't fit in the buffers can't be read. */
+    const bool is_full_window = dw == full_dw;
+    const bool is_inside_window = dw.min.x >= full_dw.min.x && dw.min.y >= full_dw.min.y &&
+                                  dw.max.x <= full_dw.max.x && dw.max.y <= full_dw.max.y;
+    if (!is_full_window) {
+      imb_exr_clear_part_channels(data, i);
+    }
+    if (!is_inside_window) {
+      printf("warning, data window of part %d is outside of the first part\n", i);
+      continue;
+    }
+
     /* Insert all matching channel into frame-buffer. */
     FrameBuffer frameBuffer;
     ExrChannel *echan;
@@ -1254,14 +1284,14 @@ void IMB_exr_read_channels(void *handle)
 
         if (!flip) {
           /* Inverse correct first pixel for data-window coordinates. */
-          rect -= echan->xstride * (dw.min.x - dw.min.y * data->width);
+          rect -= echan->xstride * (full_dw.min.x - full_dw.min.y * data->width);
           /* Move to last scan-line to flip to Blender convention. */
           rect += echan->xstride * (data->height - 1) * data->width;
           ystride = -ystride;
         }
         else {
           /* Inverse correct first pixel for data-window coordinates. */
-          rect -= echan->xstride * (dw.min.x + dw.min.y * data->width);
+          rect -= echan->xstride * (full_dw.min.x + full_dw.min.y * data->width);
         }
 
         frameBuffer.insert(echan->m->internal_name,
@@ -1280,6 +1310,10 @@ void IMB_exr_read_channels(void *handle)
     }
     catch (const std::exception &exc) {
       std::cerr << "OpenEXR-readPixels: ERROR: " << exc.what() << std::endl;
+      /* Buffers allocated for reading aren't initialized. */
+      for (int part = i; part < numparts; part++) {
+        imb_exr_clear_part_channels(data, part);
+      }
       break;
     }
   }
@@ -1613,8 +1647,12 @@ static bool imb_exr_multilayer_parse_channels_from_file(ExrHandle *data)
   for (ExrLayer *lay = (ExrLayer *)data->layers.first; lay; lay = lay->next) {
     for (ExrPass *pass = (ExrPass *)lay->passes.first; pass; pass = pass->next) {
       if (pass->totchan) {
-        pass->rect = (float *)MEM_callocN(
-            data->width * data->height * pass->totchan * sizeof(float), "pass rect");
+        /* Not initialized, for large files clearing all passes takes a significant part of the
+         * loading time. Values that aren't read are cleared below and in
+         * #IMB_exr_read_channels. */
+        const size_t rect_size = size_t(data->width) * size_t(data->height) * pass->totchan *
+                                 sizeof(float);
+        pass->rect = (float *)MEM_mallocN(rect_size, "pass rect");
         if (pass->totchan == 1) {
           ExrChannel *echan = pass->chan[0];
           echan->rect = pass->rect;
@@ -1666,6 +1704,17 @@ static bool imb_exr_multilayer_parse_channels_from_file(ExrHandle *data)
             }
           }
         }
+
+        /* The lookup doesn't necessarily assign every element of a pixel to a channel. */
+        bool is_element_used[EXR_PASS_MAXCHAN] = {false};
+        for (int a = 0; a < pass->totchan; a++) {
+          is_element_used[pass->chan[a]->rect - pass->rect] = true;
+        }
+        if (!std::all_of(is_element_used, is_element_used + pass->totchan, [](bool used) {
+              return used;
+            })) {
+          memset(pass->rect, 0, rect_size);
+        }
       }
     }
   }
@@ -401,13 +401,15 @@ bool imb_savepng(struct ImBuf *ibuf, const char *filepath, int flags)
     png_init_io(png_ptr, fp);
   }
 
-#if 0
-  png_set_filter(png_ptr,
-                 0,
-                 PNG_FILTER_NONE | PNG_FILTER_VALUE_NONE | PNG_FILTER_SUB | PNG_FILTER_VALUE_SUB |
-                     PNG_FILTER_UP | PNG_FILTER_VALUE_UP | PNG_FILTER_AVG | PNG_FILTER_VALUE_AVG |
-                     PNG_FILTER_PAETH | PNG_FILTER_VALUE_PAETH | PNG_ALL_FILTERS);
-#endif
+  /* By default every filter is tried for every row, which takes more time than the compression
+   * itself at low levels. Without compression filtering is no use, and the sub filter alone gives
+   * most of the size reduction for rendered images. */
+  if (compression == 0) {
+    png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_NONE);
+  }
+  else if (compression <= 2) {
+    png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_SUB);
+  }
 
   png_set_compression_level(png_ptr, compression);
 
@@ -22,6 +22,7 @@
 #include "IMB_filetype.h"
 #include "IMB_imbuf.h"
 #include "IMB_imbuf_types.h"
+#include "IMB_thumbs.h"
 #include "imbuf.h"
 
 #include "IMB_colormanagement.h"
@@ -234,6 +235,36 @@ ImBuf *IMB_loadiffname(const char *filepath, int flags, char colorspace[IM_MAX_S
   return ibuf;
 }
 
+ImBuf *IMB_thumb_load_image(const char *filepath,
+                            const size_t max_thumb_size,
+                            size_t *r_width,
+                            size_t *r_height)
+{
+  ImBuf *ibuf = NULL;
+  const int flags = IB_rect | IB_metadata;
+
+  const ImFileType *type = IMB_file_type_from_ftype(IMB_ispic_type(filepath));
+  if (type != NULL && type->load_filepath_thumbnail != NULL) {
+    char effective_colorspace[IM_MAX_SPACE] = "";
+    ibuf = type->load_filepath_thumbnail(
+        filepath, flags, max_thumb_size, effective_colorspace, r_width, r_height);
+    if (ibuf) {
+      imb_handle_alpha(ibuf, flags, NULL, effective_colorspace);
+    }
+  }
+
+  if (ibuf == NULL) {
+    /* Fall back to loading the full resolution image. */
+    ibuf = IMB_loadiffname(filepath, flags, NULL);
+    if (ibuf) {
+      *r_width = ibuf->x;
+      *r_height = ibuf->y;
+    }
+  }
+
+  return ibuf;
+}
+
 ImBuf *IMB_testiffname(const char *filepath, int flags)
 {
   ImBuf *ibuf;
@@ -324,6 +324,7 @@ static ImBuf *thumb_create_ex(const char *file_path,
   short tsize = 128;
   short ex, ey;
   float scaledx, scaledy;
+  size_t width = 0, height = 0;
   BLI_stat_t info;
 
   switch (size) {
@@ -368,7 +369,7 @@ static ImBuf *thumb_create_ex(const char *file_path,
         if (img == NULL) {
           switch (source) {
             case THB_SOURCE_IMAGE:
-              img = IMB_loadiffname(file_path, IB_rect | IB_metadata, NULL);
+              img = IMB_thumb_load_image(file_path, tsize, &width, &height);
               break;
             case THB_SOURCE_BLEND:
               img = IMB_thumb_load_blend(file_path, blen_group, blen_id);
@@ -385,8 +386,13 @@ static ImBuf *thumb_create_ex(const char *file_path,
           if (BLI_stat(file_path, &info) != -1) {
             BLI_snprintf(mtime, sizeof(mtime), "%ld", (long int)info.st_mtime);
           }
-          BLI_snprintf(cwidth, sizeof(cwidth), "%d", img->x);
-          BLI_snprintf(cheight, sizeof(cheight), "%d", img->y);
+          /* Images can be loaded at a reduced resolution, store the size of the full image. */
+          if (width == 0 || height == 0) {
+            width = img->x;
+            height = img->y;
+          }
+          BLI_snprintf(cwidth, sizeof(cwidth), "%zu", width);
+          BLI_snprintf(cheight, sizeof(cheight), "%zu", height);
         }
       }
       else if (THB_SOURCE_MOVIE == source) {
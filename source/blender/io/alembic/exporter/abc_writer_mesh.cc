@@ -8,8 +8,10 @@
 #include "abc_hierarchy_iterator.h"
 #include "intern/abc_axis_conversion.h"
 
+#include "BLI_array.hh"
 #include "BLI_assert.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 
 #include "BKE_attribute.h"
 #include "BKE_customdata.h"
@@ -378,9 +380,11 @@ bool ABCGenericMeshWriter::get_velocities(struct Mesh *mesh, std::vector<Imath::
   vels.clear();
   vels.resize(totverts);
 
-  for (int i = 0; i < totverts; i++) {
-    copy_yup_from_zup(vels[i].getValue(), mesh_velocities[i]);
-  }
+  threading::parallel_for(IndexRange(totverts), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      copy_yup_from_zup(vels[i].getValue(), mesh_velocities[i]);
+    }
+  });
 
   return true;
 }
@@ -392,24 +396,28 @@ void ABCGenericMeshWriter::get_geo_groups(Object *object,
   const int num_poly = mesh->totpoly;
   MPoly *polygons = mesh->mpoly;
 
+  /* Look up the group of every material slot once, not for every polygon. */
+  Array<std::vector<int32_t> *> slot_groups(object->totcol, nullptr);
+  for (const int mnr : slot_groups.index_range()) {
+    if (Material *mat = BKE_object_material_get(object, mnr + 1)) {
+      slot_groups[mnr] = &geo_groups[args_.hierarchy_iterator->get_id_name(&mat->id)];
+    }
+  }
+
   for (int i = 0; i < num_poly; i++) {
     MPoly &current_poly = polygons[i];
     short mnr = current_poly.mat_nr;
 
-    Material *mat = BKE_object_material_get(object, mnr + 1);
-
-    if (!mat) {
+    if (mnr < 0 || mnr >= slot_groups.size() || !slot_groups[mnr]) {
       continue;
     }
 
-    std::string name = args_.hierarchy_iterator->get_id_name(&mat->id);
-
-    if (geo_groups.find(name) == geo_groups.end()) {
-      std::vector<int32_t> faceArray;
-      geo_groups[name] = faceArray;
-    }
+    slot_groups[mnr]->push_back(i);
+  }
 
-    geo_groups[name].push_back(i);
+  /* Only keep the groups of materials that are used by polygons. */
+  for (auto it = geo_groups.begin(); it != geo_groups.end();) {
+    it = it->second.empty() ? geo_groups.erase(it) : std::next(it);
   }
 
   if (geo_groups.empty()) {
@@ -429,6 +437,22 @@ void ABCGenericMeshWriter::get_geo_groups(Object *object,
 
 /* NOTE: Alembic's polygon winding order is clockwise, to match with Renderman. */
 
+/**
+ * The start of every polygon in the arrays of loop data, which are in order of the polygons. The
+ * extra last element is the size of these arrays.
+ */
+static Array<int> get_poly_offsets(const Mesh *mesh)
+{
+  Array<int> offsets(mesh->totpoly + 1);
+  int offset = 0;
+  for (const int i : IndexRange(mesh->totpoly)) {
+    offsets[i] = offset;
+    offset += mesh->mpoly[i].totloop;
+  }
+  offsets.last() = offset;
+  return offsets;
+}
+
 static void get_vertices(struct Mesh *mesh, std::vector<Imath::V3f> &points)
 {
   points.clear();
@@ -436,9 +460,11 @@ static void get_vertices(struct Mesh *mesh, std::vector<Imath::V3f> &points)
 
   MVert *verts = mesh->mvert;
 
-  for (int i = 0, e = mesh->totvert; i < e; i++) {
-    copy_yup_from_zup(points[i].getValue(), verts[i].co);
-  }
+  threading::parallel_for(IndexRange(mesh->totvert), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      copy_yup_from_zup(points[i].getValue(), verts[i].co);
+    }
+  });
 }
 
 static void get_topology(struct Mesh *mesh,
@@ -447,29 +473,38 @@ static void get_topology(struct Mesh *mesh,
                          bool &r_has_flat_shaded_poly)
 {
   const int num_poly = mesh->totpoly;
-  const int num_loops = mesh->totloop;
   MLoop *mloop = mesh->mloop;
   MPoly *mpoly = mesh->mpoly;
-  r_has_flat_shaded_poly = false;
+  const Array<int> poly_offsets = get_poly_offsets(mesh);
 
   poly_verts.clear();
   loop_counts.clear();
-  poly_verts.reserve(num_loops);
-  loop_counts.reserve(num_poly);
+  poly_verts.resize(poly_offsets.last());
+  loop_counts.resize(num_poly);
 
   /* NOTE: data needs to be written in the reverse order. */
-  for (int i = 0; i < num_poly; i++) {
-    MPoly &poly = mpoly[i];
-    loop_counts.push_back(poly.totloop);
-
-    r_has_flat_shaded_poly |= (poly.flag & ME_SMOOTH) == 0;
-
-    MLoop *loop = mloop + poly.loopstart + (poly.totloop - 1);
-
-    for (int j = 0; j < poly.totloop; j++, loop--) {
-      poly_verts.push_back(loop->v);
-    }
-  }
+  r_has_flat_shaded_poly = threading::parallel_reduce(
+      IndexRange(num_poly),
+      1024,
+      false,
+      [&](const IndexRange range, const bool init) {
+        bool has_flat_shaded_poly = init;
+        for (const int i : range) {
+          MPoly &poly = mpoly[i];
+          loop_counts[i] = poly.totloop;
+
+          has_flat_shaded_poly |= (poly.flag & ME_SMOOTH) == 0;
+
+          MLoop *loop = mloop + poly.loopstart + (poly.totloop - 1);
+          int32_t *verts = poly_verts.data() + poly_offsets[i];
+
+          for (int j = 0; j < poly.totloop; j++, loop--) {
+            verts[j] = loop->v;
+          }
+        }
+        return has_flat_shaded_poly;
+      },
+      [](const bool a, const bool b) { return a || b; });
 }
 
 static void get_edge_creases(struct Mesh *mesh,
@@ -538,17 +573,21 @@ static void get_loop_normals(struct Mesh *mesh,
   const float(*lnors)[3] = static_cast<float(*)[3]>(CustomData_get_layer(&mesh->ldata, CD_NORMAL));
   BLI_assert_msg(lnors != nullptr, "BKE_mesh_calc_normals_split() should have computed CD_NORMAL");
 
-  normals.resize(mesh->totloop);
+  const Array<int> poly_offsets = get_poly_offsets(mesh);
+  normals.resize(poly_offsets.last());
 
   /* NOTE: data needs to be written in the reverse order. */
-  int abc_index = 0;
-  MPoly *mp = mesh->mpoly;
-  for (int i = 0, e = mesh->totpoly; i < e; i++, mp++) {
-    for (int j = mp->totloop - 1; j >= 0; j--, abc_index++) {
-      int blender_index = mp->loopstart + j;
-      copy_yup_from_zup(normals[abc_index].getValue(), lnors[blender_index]);
+  const MPoly *mpoly = mesh->mpoly;
+  threading::parallel_for(IndexRange(mesh->totpoly), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const MPoly *mp = &mpoly[i];
+      int abc_index = poly_offsets[i];
+      for (int j = mp->totloop - 1; j >= 0; j--, abc_index++) {
+        int blender_index = mp->loopstart + j;
+        copy_yup_from_zup(normals[abc_index].getValue(), lnors[blender_index]);
+      }
     }
-  }
+  });
 }
 
 ABCMeshWriter::ABCMeshWriter(const ABCWriterConstructorArgs &args) : ABCGenericMeshWriter(args)
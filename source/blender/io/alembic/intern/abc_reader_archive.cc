@@ -13,11 +13,13 @@
 
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_threads.h"
 
 #ifdef WIN32
 #  include "utfconv.h"
 #endif
 
+#include <algorithm>
 #include <fstream>
 
 using Alembic::Abc::ErrorHandler;
@@ -108,16 +110,26 @@ ArchiveReader::ArchiveReader(struct Main *bmain, const char *filename)
   BLI_strncpy(abs_filename, filename, FILE_MAX);
   BLI_path_abs(abs_filename, BKE_main_blendfile_path(bmain));
 
+  /* More streams don't help much, since the reads end up waiting for the disk anyway. Each
+   * stream uses a file handle, which is limited on some platforms. */
+  const int streams_num = std::min(BLI_system_thread_count(), 8);
+  for (int i = 0; i < streams_num; i++) {
+    std::unique_ptr<std::ifstream> infile = std::make_unique<std::ifstream>();
 #ifdef WIN32
-  UTF16_ENCODE(abs_filename);
-  std::wstring wstr(abs_filename_16);
-  m_infile.open(wstr.c_str(), std::ios::in | std::ios::binary);
-  UTF16_UN_ENCODE(abs_filename);
+    UTF16_ENCODE(abs_filename);
+    std::wstring wstr(abs_filename_16);
+    infile->open(wstr.c_str(), std::ios::in | std::ios::binary);
+    UTF16_UN_ENCODE(abs_filename);
 #else
-  m_infile.open(abs_filename, std::ios::in | std::ios::binary);
+    infile->open(abs_filename, std::ios::in | std::ios::binary);
 #endif
-
-  m_streams.push_back(&m_infile);
+    if (!infile->is_open() && !m_streams.empty()) {
+      /* Continue with the streams that could be opened. */
+      break;
+    }
+    m_streams.push_back(infile.get());
+    m_infiles.push_back(std::move(infile));
+  }
 
   m_archive = open_archive(abs_filename, m_streams);
 }
@@ -10,6 +10,7 @@
 #include <Alembic/AbcCoreOgawa/All.h>
 
 #include <fstream>
+#include <memory>
 
 struct Main;
 
@@ -22,7 +23,12 @@ namespace blender::io::alembic {
 
 class ArchiveReader {
   Alembic::Abc::IArchive m_archive;
-  std::ifstream m_infile;
+  /**
+   * Ogawa reads from one stream at a time, so several streams for the same file are opened.
+   * That way samples for different objects can be read concurrently, which happens when the
+   * objects using the cache are evaluated in parallel.
+   */
+  std::vector<std::unique_ptr<std::ifstream>> m_infiles;
   std::vector<std::istream *> m_streams;
 
   std::vector<ArchiveReader *> m_readers;
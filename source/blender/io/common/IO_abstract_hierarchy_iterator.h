@@ -260,8 +260,7 @@ class AbstractHierarchyIterator {
                                       const ExportGraph::key_type &graph_index) const;
 
   void determine_export_paths(const HierarchyContext *parent_context);
-  void determine_duplication_references(const HierarchyContext *parent_context,
-                                        std::string indent);
+  void determine_duplication_references(const HierarchyContext *parent_context);
 
   /* These three functions create writers and call their write() method. */
   void make_writers(const HierarchyContext *parent_context);
@@ -6,8 +6,9 @@
 #include <climits>
 #include <cstdio>
 #include <iostream>
-#include <sstream>
+#include <set>
 #include <string>
+#include <vector>
 
 #include "BKE_anim_data.h"
 #include "BKE_duplilist.h"
@@ -182,7 +183,7 @@ void AbstractHierarchyIterator::iterate_and_write()
   connect_loose_objects();
   export_graph_prune();
   determine_export_paths(HierarchyContext::root());
-  determine_duplication_references(HierarchyContext::root(), "");
+  determine_duplication_references(HierarchyContext::root());
   make_writers(HierarchyContext::root());
   export_graph_clear();
 }
@@ -286,7 +287,6 @@ void AbstractHierarchyIterator::export_graph_construct()
       DupliParentFinder dupli_parent_finder;
 
       LISTBASE_FOREACH (DupliObject *, dupli_object, lb) {
-        PersistentID persistent_id(dupli_object);
         if (!should_visit_dupli_object(dupli_object)) {
           continue;
         }
@@ -311,22 +311,27 @@ void AbstractHierarchyIterator::connect_loose_objects()
   /* Find those objects whose parent is not part of the export graph; these
    * objects would be skipped when traversing the graph as a hierarchy.
    * These objects will have to be re-attached to some parent object in order to
-   * fit into the hierarchy. */
-  ExportGraph loose_objects_graph = export_graph_;
+   * fit into the hierarchy. Only the keys are collected, copying the graph would copy the
+   * children of every object. */
+  std::set<ObjectIdentifier> child_oids;
   for (const ExportGraph::value_type &map_iter : export_graph_) {
     for (const HierarchyContext *child : map_iter.second) {
       /* An object that is marked as a child of another object is not considered 'loose'. */
-      ObjectIdentifier child_oid = ObjectIdentifier::for_hierarchy_context(child);
-      loose_objects_graph.erase(child_oid);
+      child_oids.insert(ObjectIdentifier::for_hierarchy_context(child));
     }
   }
   /* The root of the hierarchy is always found, so it's never considered 'loose'. */
-  loose_objects_graph.erase(ObjectIdentifier::for_graph_root());
+  child_oids.insert(ObjectIdentifier::for_graph_root());
+
+  std::vector<Object *> loose_objects;
+  for (const ExportGraph::value_type &map_iter : export_graph_) {
+    if (child_oids.find(map_iter.first) == child_oids.end()) {
+      loose_objects.push_back(map_iter.first.object);
+    }
+  }
 
   /* Iterate over the loose objects and connect them to their export parent. */
-  for (const ExportGraph::value_type &map_iter : loose_objects_graph) {
-    const ObjectIdentifier &graph_key = map_iter.first;
-    Object *object = graph_key.object;
+  for (Object *object : loose_objects) {
 
     while (true) {
       /* Loose objects will all be real objects, as duplicated objects always have
@@ -451,10 +456,8 @@ void AbstractHierarchyIterator::visit_dupli_object(DupliObject *dupli_object,
   copy_m4_m4(context->matrix_world, dupli_object->mat);
 
   /* Construct export name for the dupli-instance. */
-  std::stringstream export_name_stream;
-  export_name_stream << get_object_name(context->object) << "-"
-                     << context->persistent_id.as_object_name_suffix();
-  context->export_name = make_valid_name(export_name_stream.str());
+  context->export_name = make_valid_name(get_object_name(context->object) + "-" +
+                                         context->persistent_id.as_object_name_suffix());
 
   ExportGraph::key_type graph_index = determine_graph_index_dupli(
       context, dupli_object, dupli_parent_finder);
@@ -519,11 +522,11 @@ void AbstractHierarchyIterator::determine_export_paths(const HierarchyContext *p
 }
 
 void AbstractHierarchyIterator::determine_duplication_references(
-    const HierarchyContext *parent_context, std::string indent)
+    const HierarchyContext *parent_context)
 {
-  ExportChildren children = graph_children(parent_context);
-
-  for (HierarchyContext *context : children) {
+  /* Looking up the children of a child may insert into the graph, which doesn't invalidate
+   * iterators of the std::map and std::set, so the children don't have to be copied. */
+  for (HierarchyContext *context : graph_children(parent_context)) {
     if (context->duplicator != nullptr) {
       ID *source_id = &context->object->id;
       const ExportPathMap::const_iterator &it = duplisource_export_path_.find(source_id);
@@ -551,7 +554,7 @@ void AbstractHierarchyIterator::determine_duplication_references(
       }
     }
 
-    determine_duplication_references(context, indent + "  ");
+    determine_duplication_references(context);
   }
 }
 
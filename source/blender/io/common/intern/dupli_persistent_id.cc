@@ -6,7 +6,6 @@
 #include <climits>
 #include <cstring>
 #include <ostream>
-#include <sstream>
 
 namespace blender::io {
 
@@ -71,7 +70,7 @@ PersistentID PersistentID::instancer_pid() const
 
 std::string PersistentID::as_object_name_suffix() const
 {
-  std::stringstream stream;
+  std::string suffix;
 
   /* Find one past the last index. */
   int index;
@@ -82,13 +81,13 @@ std::string PersistentID::as_object_name_suffix() const
   /* Iterate backward to construct the string. */
   --index;
   for (; index >= 0; --index) {
-    stream << persistent_id_[index];
+    suffix += std::to_string(persistent_id_[index]);
     if (index > 0) {
-      stream << "-";
+      suffix += '-';
     }
   }
 
-  return stream.str();
+  return suffix;
 }
 
 bool operator<(const PersistentID &persistent_id_a, const PersistentID &persistent_id_b)
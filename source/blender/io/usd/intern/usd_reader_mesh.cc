@@ -192,17 +192,22 @@ void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
 {
   Mesh *mesh = (Mesh *)object_->data;
 
-  is_initial_load_ = true;
-  Mesh *read_mesh = this->read_mesh(
-      mesh, motionSampleTime, import_params_.mesh_read_flag, nullptr);
-
-  is_initial_load_ = false;
-  if (read_mesh != mesh) {
-    /* FIXME: after 2.80; `mesh->flag` isn't copied by #BKE_mesh_nomain_to_mesh() */
-    /* read_mesh can be freed by BKE_mesh_nomain_to_mesh(), so get the flag before that happens. */
-    short autosmooth = (read_mesh->flag & ME_AUTOSMOOTH);
-    BKE_mesh_nomain_to_mesh(read_mesh, mesh, object_, &CD_MASK_MESH, true);
-    mesh->flag |= autosmooth;
+  /* On demand, the mesh stays empty and the cache modifier reads the geometry. Only the material
+   * slots are created from the face sets. */
+  if (!import_params_.read_meshes_on_demand) {
+    is_initial_load_ = true;
+    Mesh *read_mesh = this->read_mesh(
+        mesh, motionSampleTime, import_params_.mesh_read_flag, nullptr);
+
+    is_initial_load_ = false;
+    if (read_mesh != mesh) {
+      /* FIXME: after 2.80; `mesh->flag` isn't copied by #BKE_mesh_nomain_to_mesh() */
+      /* read_mesh can be freed by BKE_mesh_nomain_to_mesh(), so get the flag before that
+       * happens. */
+      short autosmooth = (read_mesh->flag & ME_AUTOSMOOTH);
+      BKE_mesh_nomain_to_mesh(read_mesh, mesh, object_, &CD_MASK_MESH, true);
+      mesh->flag |= autosmooth;
+    }
   }
 
   readFaceSetsSample(bmain, mesh, motionSampleTime);
@@ -211,7 +216,7 @@ void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
     is_time_varying_ = true;
   }
 
-  if (is_time_varying_) {
+  if (is_time_varying_ || import_params_.read_meshes_on_demand) {
     add_cache_modifier();
   }
 
@@ -691,7 +696,7 @@ void USDMeshReader::read_mesh_sample(ImportSettings *settings,
 
 void USDMeshReader::assign_facesets_to_mpoly(double motionSampleTime,
                                              MPoly *mpoly,
-                                             const int /* totpoly */,
+                                             const int totpoly,
                                              std::map<pxr::SdfPath, int> *r_mat_map)
 {
   if (r_mat_map == nullptr) {
@@ -736,6 +741,10 @@ void USDMeshReader::assign_facesets_to_mpoly(double motionSampleTime,
       indicesAttribute.Get(&indices, motionSampleTime);
 
       for (int i = 0; i < indices.size(); i++) {
+        /* The mesh is empty when it is read on demand. */
+        if (indices[i] >= totpoly) {
+          continue;
+        }
         MPoly &poly = mpoly[indices[i]];
         poly.mat_nr = mat_idx;
       }
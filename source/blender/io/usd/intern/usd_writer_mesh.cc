@@ -7,8 +7,10 @@
 #include <pxr/usd/usdShade/material.h>
 #include <pxr/usd/usdShade/materialBindingAPI.h>
 
+#include "BLI_array.hh"
 #include "BLI_assert.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 
 #include "BKE_attribute.h"
 #include "BKE_customdata.h"
@@ -102,6 +104,8 @@ struct USDMeshData {
   pxr::VtFloatArray corner_sharpnesses;
 };
 
+static void get_face_groups(const Mesh *mesh, USDMeshData &usd_mesh_data);
+
 void USDGenericMeshWriter::write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh)
 {
   pxr::UsdTimeCode timecode = get_export_time_code();
@@ -146,13 +150,15 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   write_visibility(context, timecode, usd_mesh);
 
   USDMeshData usd_mesh_data;
-  get_geometry_data(mesh, usd_mesh_data);
 
   if (usd_export_context_.export_params.use_instancing && context.is_instance()) {
     if (!mark_as_instance(context, usd_mesh.GetPrim())) {
       return;
     }
 
+    /* The geometry is referenced, only the face groups are needed for the materials. */
+    get_face_groups(mesh, usd_mesh_data);
+
     /* The material path will be of the form </_materials/{material name}>, which is outside the
      * sub-tree pointed to by ref_path. As a result, the referenced data is not allowed to point
      * out of its own sub-tree. It does work when we override the material with exactly the same
@@ -164,6 +170,8 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
     return;
   }
 
+  get_geometry_data(mesh, usd_mesh_data);
+
   pxr::UsdAttribute attr_points = usd_mesh.CreatePointsAttr(pxr::VtValue(), true);
   pxr::UsdAttribute attr_face_vertex_counts = usd_mesh.CreateFaceVertexCountsAttr(pxr::VtValue(),
                                                                                   true);
@@ -241,37 +249,68 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   }
 }
 
+/**
+ * The start of every face in the face-varying arrays, which are in order of the faces. The extra
+ * last element is the size of these arrays.
+ */
+static Array<int> get_face_offsets(const Mesh *mesh)
+{
+  Array<int> offsets(mesh->totpoly + 1);
+  int offset = 0;
+  for (const int i : IndexRange(mesh->totpoly)) {
+    offsets[i] = offset;
+    offset += mesh->mpoly[i].totloop;
+  }
+  offsets.last() = offset;
+  return offsets;
+}
+
 static void get_vertices(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
-  usd_mesh_data.points.reserve(mesh->totvert);
+  usd_mesh_data.points.resize(mesh->totvert);
 
+  /* Get the pointer once, #pxr::VtArray checks for shared data on every mutable access. */
+  pxr::GfVec3f *points = usd_mesh_data.points.data();
   const MVert *verts = mesh->mvert;
-  for (int i = 0; i < mesh->totvert; ++i) {
-    usd_mesh_data.points.push_back(pxr::GfVec3f(verts[i].co));
-  }
+  threading::parallel_for(IndexRange(mesh->totvert), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      points[i] = pxr::GfVec3f(verts[i].co);
+    }
+  });
 }
 
 static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
+{
+  const Array<int> face_offsets = get_face_offsets(mesh);
+  usd_mesh_data.face_vertex_counts.resize(mesh->totpoly);
+  usd_mesh_data.face_indices.resize(face_offsets.last());
+
+  int *face_vertex_counts = usd_mesh_data.face_vertex_counts.data();
+  int *face_indices = usd_mesh_data.face_indices.data();
+  const MLoop *mloop = mesh->mloop;
+  const MPoly *mpoly = mesh->mpoly;
+  threading::parallel_for(IndexRange(mesh->totpoly), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const MLoop *loop = mloop + mpoly[i].loopstart;
+      face_vertex_counts[i] = mpoly[i].totloop;
+      for (const int j : IndexRange(mpoly[i].totloop)) {
+        face_indices[face_offsets[i] + j] = loop[j].v;
+      }
+    }
+  });
+}
+
+static void get_face_groups(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
   /* Only construct face groups (a.k.a. geometry subsets) when we need them for material
    * assignments. */
-  bool construct_face_groups = mesh->totcol > 1;
-
-  usd_mesh_data.face_vertex_counts.reserve(mesh->totpoly);
-  usd_mesh_data.face_indices.reserve(mesh->totloop);
-
-  MLoop *mloop = mesh->mloop;
-  MPoly *mpoly = mesh->mpoly;
-  for (int i = 0; i < mesh->totpoly; ++i, ++mpoly) {
-    MLoop *loop = mloop + mpoly->loopstart;
-    usd_mesh_data.face_vertex_counts.push_back(mpoly->totloop);
-    for (int j = 0; j < mpoly->totloop; ++j, ++loop) {
-      usd_mesh_data.face_indices.push_back(loop->v);
-    }
+  if (mesh->totcol <= 1) {
+    return;
+  }
 
-    if (construct_face_groups) {
-      usd_mesh_data.face_groups[mpoly->mat_nr].push_back(i);
-    }
+  const MPoly *mpoly = mesh->mpoly;
+  for (int i = 0; i < mesh->totpoly; ++i) {
+    usd_mesh_data.face_groups[mpoly[i].mat_nr].push_back(i);
   }
 }
 
@@ -322,6 +361,7 @@ void USDGenericMeshWriter::get_geometry_data(const Mesh *mesh, USDMeshData &usd_
 {
   get_vertices(mesh, usd_mesh_data);
   get_loops_polys(mesh, usd_mesh_data);
+  get_face_groups(mesh, usd_mesh_data);
   get_edge_creases(mesh, usd_mesh_data);
   get_vert_creases(mesh, usd_mesh_data);
 }
@@ -394,36 +434,45 @@ void USDGenericMeshWriter::write_normals(const Mesh *mesh, pxr::UsdGeomMesh usd_
   const float(*lnors)[3] = static_cast<float(*)[3]>(CustomData_get_layer(&mesh->ldata, CD_NORMAL));
 
   pxr::VtVec3fArray loop_normals;
-  loop_normals.reserve(mesh->totloop);
 
   if (lnors != nullptr) {
     /* Export custom loop normals. */
-    for (int loop_idx = 0, totloop = mesh->totloop; loop_idx < totloop; ++loop_idx) {
-      loop_normals.push_back(pxr::GfVec3f(lnors[loop_idx]));
-    }
+    loop_normals.resize(mesh->totloop);
+    pxr::GfVec3f *normals = loop_normals.data();
+    threading::parallel_for(IndexRange(mesh->totloop), 4096, [&](const IndexRange range) {
+      for (const int loop_idx : range) {
+        normals[loop_idx] = pxr::GfVec3f(lnors[loop_idx]);
+      }
+    });
   }
   else {
     /* Compute the loop normals based on the 'smooth' flag. */
     const float(*vert_normals)[3] = BKE_mesh_vertex_normals_ensure(mesh);
     const float(*face_normals)[3] = BKE_mesh_poly_normals_ensure(mesh);
-    MPoly *mpoly = mesh->mpoly;
-    for (int poly_idx = 0, totpoly = mesh->totpoly; poly_idx < totpoly; ++poly_idx, ++mpoly) {
-      MLoop *mloop = mesh->mloop + mpoly->loopstart;
-
-      if ((mpoly->flag & ME_SMOOTH) == 0) {
-        /* Flat shaded, use common normal for all verts. */
-        pxr::GfVec3f pxr_normal(face_normals[poly_idx]);
-        for (int loop_idx = 0; loop_idx < mpoly->totloop; ++loop_idx) {
-          loop_normals.push_back(pxr_normal);
+    const Array<int> face_offsets = get_face_offsets(mesh);
+    loop_normals.resize(face_offsets.last());
+    pxr::GfVec3f *normals = loop_normals.data();
+    const MPoly *mpoly = mesh->mpoly;
+    threading::parallel_for(IndexRange(mesh->totpoly), 1024, [&](const IndexRange range) {
+      for (const int poly_idx : range) {
+        pxr::GfVec3f *poly_normals = normals + face_offsets[poly_idx];
+
+        if ((mpoly[poly_idx].flag & ME_SMOOTH) == 0) {
+          /* Flat shaded, use common normal for all verts. */
+          pxr::GfVec3f pxr_normal(face_normals[poly_idx]);
+          for (const int loop_idx : IndexRange(mpoly[poly_idx].totloop)) {
+            poly_normals[loop_idx] = pxr_normal;
+          }
         }
-      }
-      else {
-        /* Smooth shaded, use individual vert normals. */
-        for (int loop_idx = 0; loop_idx < mpoly->totloop; ++loop_idx, ++mloop) {
-          loop_normals.push_back(pxr::GfVec3f(vert_normals[mloop->v]));
+        else {
+          /* Smooth shaded, use individual vert normals. */
+          const MLoop *mloop = mesh->mloop + mpoly[poly_idx].loopstart;
+          for (const int loop_idx : IndexRange(mpoly[poly_idx].totloop)) {
+            poly_normals[loop_idx] = pxr::GfVec3f(vert_normals[mloop[loop_idx].v]);
+          }
         }
       }
-    }
+    });
   }
 
   pxr::UsdAttribute attr_normals = usd_mesh.CreateNormalsAttr(pxr::VtValue(), true);
@@ -45,6 +45,8 @@ struct USDImportParams {
   bool import_materials;
   bool import_meshes;
   bool import_volumes;
+  /** Read mesh geometry when the objects are evaluated, instead of on import. */
+  bool read_meshes_on_demand;
   char *prim_path_mask;
   bool import_subdiv;
   bool import_instance_proxies;
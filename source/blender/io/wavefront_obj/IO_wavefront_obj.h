@@ -77,6 +77,20 @@ struct OBJExportParams {
   bool smooth_groups_bitflags;
 };
 
+struct OBJImportParams {
+  /** Full path to the source OBJ file to import. */
+  char filepath[FILE_MAX];
+  eTransformAxisForward forward_axis;
+  eTransformAxisUp up_axis;
+};
+
+/**
+ * Perform the full import process.
+ * Import also changes the selection & the active object; callers
+ * need to update the UI accordingly.
+ */
+void OBJ_import(bContext *C, const struct OBJImportParams *import_params);
+
 void OBJ_export(bContext *C, const struct OBJExportParams *export_params);
 
 #ifdef __cplusplus
@@ -6,15 +6,19 @@
 
 #pragma once
 
+#include <cmath>
 #include <cstdio>
+#include <cstring>
 #include <string>
 #include <system_error>
 #include <type_traits>
 #include <vector>
 
+#include "BLI_assert.h"
 #include "BLI_compiler_attrs.h"
 #include "BLI_fileops.h"
 #include "BLI_string_ref.hh"
+#include "BLI_utildefines.h"
 #include "BLI_utility_mixins.hh"
 
 namespace blender::io::obj {
@@ -263,6 +267,96 @@ constexpr FormattingSyntax syntax_elem_to_formatting(const eMTLSyntaxElement key
 #  pragma GCC diagnostic pop
 #endif
 
+/**
+ * Format a float like `printf("%.Nf")` with the given precision, which is much faster.
+ * The result is exactly the same, including the rounding of the decimal value to the nearest one
+ * (ties to even).
+ * \return The end of the written characters, or null when the value is not supported (very large
+ * values, infinity and NaN), in that case a more general formatting function has to be used.
+ */
+inline char *format_float_fixed(char *dst, const float value, const int precision)
+{
+  BLI_assert(precision >= 0 && precision <= 6);
+  static const uint64_t powers_of_ten[7] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+  if (!(std::abs(value) < 1e9f)) {
+    return nullptr;
+  }
+
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  const int exponent_bits = (bits >> 23) & 0xff;
+  const uint64_t fraction_bits = bits & 0x7fffff;
+  /* The value is exactly `mantissa * 2^exponent`. */
+  const uint64_t mantissa = exponent_bits ? (fraction_bits | (1 << 23)) : fraction_bits;
+  const int exponent = (exponent_bits ? exponent_bits : 1) - 127 - 23;
+
+  /* Compute `round(value * 10^precision)` exactly. The product of the mantissa and the power of
+   * ten fits into 64 bits. */
+  const uint64_t scale = powers_of_ten[precision];
+  const uint64_t scaled_mantissa = mantissa * scale;
+  uint64_t scaled_value;
+  if (exponent >= 0) {
+    scaled_value = scaled_mantissa << exponent;
+  }
+  else if (-exponent >= 64) {
+    /* Smaller than 0.5, since the scaled mantissa is smaller than 2^63. */
+    scaled_value = 0;
+  }
+  else {
+    const int shift = -exponent;
+    scaled_value = scaled_mantissa >> shift;
+    const uint64_t remainder = scaled_mantissa & ((uint64_t(1) << shift) - 1);
+    const uint64_t half = uint64_t(1) << (shift - 1);
+    if (remainder > half || (remainder == half && (scaled_value & 1))) {
+      scaled_value++;
+    }
+  }
+
+  if (bits >> 31) {
+    *dst++ = '-';
+  }
+  uint64_t integer_part = scaled_value / scale;
+  uint64_t fractional_part = scaled_value % scale;
+  char digits[24];
+  int digits_num = 0;
+  do {
+    digits[digits_num++] = char('0' + integer_part % 10);
+    integer_part /= 10;
+  } while (integer_part != 0);
+  while (digits_num > 0) {
+    *dst++ = digits[--digits_num];
+  }
+  if (precision > 0) {
+    *dst++ = '.';
+    for (int i = precision - 1; i >= 0; i--) {
+      dst[i] = char('0' + fractional_part % 10);
+      fractional_part /= 10;
+    }
+    dst += precision;
+  }
+  return dst;
+}
+
+/** Format an integer like `printf("%d")`. \return The end of the written characters. */
+inline char *format_int(char *dst, const int value)
+{
+  uint32_t abs_value = uint32_t(value);
+  if (value < 0) {
+    *dst++ = '-';
+    abs_value = 0u - abs_value;
+  }
+  char digits[12];
+  int digits_num = 0;
+  do {
+    digits[digits_num++] = char('0' + abs_value % 10);
+    abs_value /= 10;
+  } while (abs_value != 0);
+  while (digits_num > 0) {
+    *dst++ = digits[--digits_num];
+  }
+  return dst;
+}
+
 /**
  * File format and syntax agnostic file buffer writer.
  * All writes are done into an internal chunked memory buffer
@@ -324,10 +418,105 @@ class FormatHandler : NonCopyable, NonMovable {
                           (sizeof...(T) == fmt_nargs_valid.total_args),
                       "Types of all arguments and the number of arguments should match what the "
                       "formatting specifies.");
+    if constexpr (filetype == eFileType::OBJ) {
+      /* The most common elements in large files are formatted without `snprintf`. */
+      if (write_fast<key>(args...)) {
+        return;
+      }
+    }
     write_impl(fmt_nargs_valid.fmt, std::forward<T>(args)...);
   }
 
  private:
+  /**
+   * Formatting of vertex data and indices without `snprintf`.
+   * \return False when the element or the values are not supported and the generic formatting
+   * has to be used.
+   */
+  template<eOBJSyntaxElement key, typename... T> bool write_fast(const T &...args)
+  {
+    constexpr bool is_float_element = ELEM(key,
+                                           eOBJSyntaxElement::vertex_coords,
+                                           eOBJSyntaxElement::uv_vertex_coords,
+                                           eOBJSyntaxElement::normal);
+    constexpr bool is_int_element = ELEM(key,
+                                         eOBJSyntaxElement::vertex_uv_normal_indices,
+                                         eOBJSyntaxElement::vertex_normal_indices,
+                                         eOBJSyntaxElement::vertex_uv_indices,
+                                         eOBJSyntaxElement::vertex_indices,
+                                         eOBJSyntaxElement::edge);
+    if constexpr (is_float_element && (... && std::is_same_v<T, float>)) {
+      /* Enough for three values of the largest supported magnitude. */
+      char buf[64];
+      char *p = buf;
+      const char *prefix = key == eOBJSyntaxElement::vertex_coords ? "v" :
+                           key == eOBJSyntaxElement::uv_vertex_coords ? "vt" :
+                                                                        "vn";
+      const int precision = key == eOBJSyntaxElement::normal ? 4 : 6;
+      while (*prefix) {
+        *p++ = *prefix++;
+      }
+      for (const float value : {args...}) {
+        *p++ = ' ';
+        p = format_float_fixed(p, value, precision);
+        if (p == nullptr) {
+          return false;
+        }
+      }
+      *p++ = '\n';
+      append_chars(buf, p - buf);
+      return true;
+    }
+    else if constexpr (is_int_element && (... && std::is_same_v<T, int>)) {
+      char buf[64];
+      char *p = buf;
+      /* Separators before each value. */
+      const char *const *separators;
+      static const char *const uv_normal_separators[3] = {" ", "/", "/"};
+      static const char *const normal_separators[2] = {" ", "//"};
+      static const char *const uv_separators[2] = {" ", "/"};
+      static const char *const single_separators[1] = {" "};
+      static const char *const edge_separators[2] = {"l ", " "};
+      if constexpr (key == eOBJSyntaxElement::vertex_uv_normal_indices) {
+        separators = uv_normal_separators;
+      }
+      else if constexpr (key == eOBJSyntaxElement::vertex_normal_indices) {
+        separators = normal_separators;
+      }
+      else if constexpr (key == eOBJSyntaxElement::vertex_uv_indices) {
+        separators = uv_separators;
+      }
+      else if constexpr (key == eOBJSyntaxElement::vertex_indices) {
+        separators = single_separators;
+      }
+      else {
+        separators = edge_separators;
+      }
+      int i = 0;
+      for (const int value : {args...}) {
+        for (const char *c = separators[i++]; *c; c++) {
+          *p++ = *c;
+        }
+        p = format_int(p, value);
+      }
+      if constexpr (key == eOBJSyntaxElement::edge) {
+        *p++ = '\n';
+      }
+      append_chars(buf, p - buf);
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+
+  void append_chars(const char *chars, const size_t len)
+  {
+    ensure_space(len);
+    VectorChar &bb = blocks_.back();
+    bb.insert(bb.end(), chars, chars + len);
+  }
+
   /* Remove this after upgrading to C++20. */
   template<typename T> using remove_cvref_t = std::remove_cv_t<std::remove_reference_t<T>>;
 
@@ -0,0 +1,808 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup obj
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+
+#ifndef WIN32
+#  include <unistd.h>
+#else
+#  include <io.h>
+#endif
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_array.hh"
+#include "BLI_fileops.h"
+#include "BLI_mmap.h"
+#include "BLI_task.hh"
+
+#include "obj_import_file_reader.hh"
+
+namespace blender::io::obj {
+
+static bool is_whitespace(const char c)
+{
+  return ELEM(c, ' ', '\t', '\r', '\v', '\f');
+}
+
+static bool is_digit(const char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+static const char *skip_whitespace(const char *p, const char *end)
+{
+  while (p < end && is_whitespace(*p)) {
+    p++;
+  }
+  return p;
+}
+
+const char *parse_int(const char *p, const char *end, int &r_value)
+{
+  p = skip_whitespace(p, end);
+  const char *start = p;
+  bool negative = false;
+  if (p < end && ELEM(*p, '-', '+')) {
+    negative = *p == '-';
+    p++;
+  }
+  const char *digits_start = p;
+  int64_t value = 0;
+  while (p < end && is_digit(*p)) {
+    /* Saturate instead of overflowing, the index is out of range anyway. */
+    if (value <= INT32_MAX) {
+      value = value * 10 + (*p - '0');
+    }
+    p++;
+  }
+  if (p == digits_start) {
+    return start;
+  }
+  value = std::min<int64_t>(value, INT32_MAX);
+  r_value = int(negative ? -value : value);
+  return p;
+}
+
+/** Handles everything that is not supported by the fast paths, like `nan` and `inf`. */
+static const char *parse_float_fallback(const char *p, const char *end, float &r_value)
+{
+  char buf[64];
+  const int64_t len = std::min<int64_t>(end - p, sizeof(buf) - 1);
+  memcpy(buf, p, len);
+  buf[len] = '\0';
+  char *number_end;
+  const double value = strtod(buf, &number_end);
+  if (number_end == buf) {
+    return p;
+  }
+  r_value = float(value);
+  return p + (number_end - buf);
+}
+
+const char *parse_float(const char *p, const char *end, float &r_value)
+{
+  static const float float_powers_of_ten[11] = {
+      1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+  static const double double_powers_of_ten[23] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                                  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                                  1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                                  1e18, 1e19, 1e20, 1e21, 1e22};
+
+  p = skip_whitespace(p, end);
+  const char *start = p;
+  bool negative = false;
+  if (p < end && ELEM(*p, '-', '+')) {
+    negative = *p == '-';
+    p++;
+  }
+
+  /* The value is `mantissa * 10^exponent`. */
+  uint64_t mantissa = 0;
+  int exponent = 0;
+  int significant_digits = 0;
+  bool has_digits = false;
+  bool is_truncated = false;
+  while (p < end && is_digit(*p)) {
+    has_digits = true;
+    if (significant_digits < 19) {
+      mantissa = mantissa * 10 + uint64_t(*p - '0');
+      significant_digits += mantissa != 0;
+    }
+    else {
+      exponent++;
+      is_truncated = true;
+    }
+    p++;
+  }
+  if (p < end && *p == '.') {
+    p++;
+    while (p < end && is_digit(*p)) {
+      has_digits = true;
+      if (significant_digits < 19) {
+        mantissa = mantissa * 10 + uint64_t(*p - '0');
+        significant_digits += mantissa != 0;
+        exponent--;
+      }
+      else {
+        is_truncated = true;
+      }
+      p++;
+    }
+  }
+  if (!has_digits) {
+    return parse_float_fallback(start, end, r_value);
+  }
+  if (p < end && ELEM(*p, 'e', 'E')) {
+    const char *q = p + 1;
+    bool exponent_negative = false;
+    if (q < end && ELEM(*q, '-', '+')) {
+      exponent_negative = *q == '-';
+      q++;
+    }
+    if (q < end && is_digit(*q)) {
+      int exponent_value = 0;
+      while (q < end && is_digit(*q)) {
+        if (exponent_value < 10000) {
+          exponent_value = exponent_value * 10 + (*q - '0');
+        }
+        q++;
+      }
+      exponent += exponent_negative ? -exponent_value : exponent_value;
+      p = q;
+    }
+  }
+
+  float value;
+  if (mantissa == 0) {
+    value = 0.0f;
+  }
+  else if (is_truncated) {
+    return parse_float_fallback(start, end, r_value);
+  }
+  else if (mantissa <= (1 << 24) && exponent >= -10 && exponent <= 10) {
+    /* Both operands are exact, so the result is correctly rounded. */
+    value = exponent < 0 ? float(mantissa) / float_powers_of_ten[-exponent] :
+                           float(mantissa) * float_powers_of_ten[exponent];
+  }
+  else if (mantissa < (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+    value = float(exponent < 0 ? double(mantissa) / double_powers_of_ten[-exponent] :
+                                 double(mantissa) * double_powers_of_ten[exponent]);
+  }
+  else {
+    return parse_float_fallback(start, end, r_value);
+  }
+  r_value = negative ? -value : value;
+  return p;
+}
+
+/**
+ * Whether the line that ends at \a line_end (a new-line character) is continued on the next line,
+ * which is done with a backslash at the end of the line.
+ */
+static bool is_line_continued(const char *line_start, const char *line_end)
+{
+  const char *p = line_end;
+  if (p > line_start && p[-1] == '\r') {
+    p--;
+  }
+  return p > line_start && p[-1] == '\\';
+}
+
+static const char *find_line_end(const char *p, const char *end)
+{
+  const char *line_end = static_cast<const char *>(memchr(p, '\n', end - p));
+  return line_end ? line_end : end;
+}
+
+/**
+ * Call \a fn with the start and end of every line, without the new-line character.
+ * Continued lines are joined into a temporary buffer.
+ */
+template<typename Fn> static void foreach_line(const char *p, const char *end, const Fn &fn)
+{
+  std::string joined_line;
+  while (p < end) {
+    const char *line_end = find_line_end(p, end);
+    if (line_end == end || !is_line_continued(p, line_end)) {
+      fn(p, line_end);
+      p = line_end == end ? end : line_end + 1;
+      continue;
+    }
+    joined_line.clear();
+    while (line_end < end && is_line_continued(p, line_end)) {
+      const char *content_end = line_end;
+      if (content_end[-1] == '\r') {
+        content_end--;
+      }
+      /* Skip the backslash. */
+      content_end--;
+      joined_line.append(p, content_end);
+      joined_line += ' ';
+      p = line_end + 1;
+      line_end = find_line_end(p, end);
+    }
+    joined_line.append(p, line_end);
+    p = line_end == end ? end : line_end + 1;
+    fn(joined_line.data(), joined_line.data() + joined_line.size());
+  }
+}
+
+enum class eOBJLineType {
+  Ignored,
+  Vertex,
+  UVVertex,
+  VertexNormal,
+  Face,
+  Edge,
+  Object,
+  Material,
+  Smooth,
+};
+
+/** Find the type of the line from its keyword, \a p is moved to the position after it. */
+static eOBJLineType classify_line(const char *&p, const char *end)
+{
+  p = skip_whitespace(p, end);
+  const char *keyword_start = p;
+  while (p < end && !is_whitespace(*p)) {
+    p++;
+  }
+  const StringRef keyword(keyword_start, p);
+  if (keyword == "v") {
+    return eOBJLineType::Vertex;
+  }
+  if (keyword == "vt") {
+    return eOBJLineType::UVVertex;
+  }
+  if (keyword == "vn") {
+    return eOBJLineType::VertexNormal;
+  }
+  if (keyword == "f") {
+    return eOBJLineType::Face;
+  }
+  if (keyword == "l") {
+    return eOBJLineType::Edge;
+  }
+  if (keyword == "o") {
+    return eOBJLineType::Object;
+  }
+  if (keyword == "usemtl") {
+    return eOBJLineType::Material;
+  }
+  if (keyword == "s") {
+    return eOBJLineType::Smooth;
+  }
+  /* Comments, groups, `mtllib` and unsupported elements. */
+  return eOBJLineType::Ignored;
+}
+
+/** The text after the keyword without surrounding white-space. */
+static std::string line_argument(const char *p, const char *end)
+{
+  p = skip_whitespace(p, end);
+  while (end > p && is_whitespace(end[-1])) {
+    end--;
+  }
+  return std::string(p, end);
+}
+
+struct ElementCounts {
+  int vertices = 0;
+  int uv_vertices = 0;
+  int vertex_normals = 0;
+};
+
+/** Polygons and edges of a part of a chunk that belongs to a single geometry. */
+struct ChunkSegment {
+  /**
+   * Whether the segment starts with an `o` statement. Otherwise it continues the geometry of the
+   * previous segment.
+   */
+  bool starts_geometry = false;
+  std::string geometry_name;
+  /** Material indices of the polygons index into this, until the segments are merged. */
+  Vector<std::string> material_names;
+  Vector<PolyElem> face_elements;
+  /** Corner indices of the polygons are relative to this segment until they are merged. */
+  Vector<PolyCorner> face_corners;
+  Vector<int2> edges;
+  int vertex_index_min = INT32_MAX;
+  int vertex_index_max = -1;
+  /** Range of the vertices that are defined within this segment. */
+  int defined_vertices_start = 0;
+  int defined_vertices_end = 0;
+  bool has_uv_vertices = false;
+  bool has_vertex_normals = false;
+  /**
+   * The material and smooth shading state is set by statements that might be in a previous
+   * chunk. It is only known after the chunks are merged for this number of leading polygons.
+   */
+  int faces_with_inherited_material = 0;
+  int faces_with_inherited_smooth = 0;
+};
+
+struct ChunkResult {
+  Vector<ChunkSegment> segments;
+  /** State that is used by the chunks after this one. */
+  bool sets_material = false;
+  std::string material_name;
+  bool sets_smooth = false;
+  bool shaded_smooth = false;
+  int invalid_elements_num = 0;
+};
+
+/**
+ * Convert a one-based or negative (relative) index from the file to a zero-based index.
+ * \param defined_num: Number of elements that are defined before the index is used.
+ * \return -1 when the index is out of range.
+ */
+static int resolve_index(const int index, const int defined_num, const int total_num)
+{
+  int result = -1;
+  if (index > 0) {
+    result = index - 1;
+  }
+  else if (index < 0) {
+    result = defined_num + index;
+  }
+  return (result >= 0 && result < total_num) ? result : -1;
+}
+
+class ChunkParser {
+ private:
+  GlobalVertices &global_vertices_;
+  ChunkResult &result_;
+  /** Global number of elements defined before the current line. */
+  ElementCounts defined_;
+  ChunkSegment *segment_;
+  bool material_known_ = false;
+  bool smooth_known_ = false;
+  bool shaded_smooth_ = false;
+  std::string material_name_;
+  /** Index of #material_name_ in the current segment, or -2 when it has not been added yet. */
+  int segment_material_index_ = -2;
+
+ public:
+  ChunkParser(GlobalVertices &global_vertices,
+              ChunkResult &r_result,
+              const ElementCounts &defined_before)
+      : global_vertices_(global_vertices), result_(r_result), defined_(defined_before)
+  {
+    result_.segments.append_as();
+    segment_ = &result_.segments.last();
+    segment_->defined_vertices_start = defined_.vertices;
+    segment_->defined_vertices_end = defined_.vertices;
+  }
+
+  void parse(const char *start, const char *end)
+  {
+    foreach_line(start, end, [&](const char *p, const char *line_end) {
+      switch (classify_line(p, line_end)) {
+        case eOBJLineType::Vertex: {
+          float3 &vert = global_vertices_.vertices[defined_.vertices++];
+          vert = float3(0.0f);
+          p = parse_float(p, line_end, vert.x);
+          p = parse_float(p, line_end, vert.y);
+          parse_float(p, line_end, vert.z);
+          segment_->defined_vertices_end = defined_.vertices;
+          break;
+        }
+        case eOBJLineType::UVVertex: {
+          float2 &uv = global_vertices_.uv_vertices[defined_.uv_vertices++];
+          uv = float2(0.0f);
+          p = parse_float(p, line_end, uv.x);
+          parse_float(p, line_end, uv.y);
+          break;
+        }
+        case eOBJLineType::VertexNormal: {
+          float3 &normal = global_vertices_.vertex_normals[defined_.vertex_normals++];
+          normal = float3(0.0f);
+          p = parse_float(p, line_end, normal.x);
+          p = parse_float(p, line_end, normal.y);
+          parse_float(p, line_end, normal.z);
+          break;
+        }
+        case eOBJLineType::Face:
+          parse_face(p, line_end);
+          break;
+        case eOBJLineType::Edge:
+          parse_edges(p, line_end);
+          break;
+        case eOBJLineType::Object:
+          result_.segments.append_as();
+    segment_ = &result_.segments.last();
+          segment_->starts_geometry = true;
+          segment_->geometry_name = line_argument(p, line_end);
+          segment_->defined_vertices_start = defined_.vertices;
+          segment_->defined_vertices_end = defined_.vertices;
+          segment_material_index_ = -2;
+          break;
+        case eOBJLineType::Material:
+          material_name_ = line_argument(p, line_end);
+          material_known_ = true;
+          segment_material_index_ = -2;
+          result_.sets_material = true;
+          result_.material_name = material_name_;
+          break;
+        case eOBJLineType::Smooth: {
+          const std::string value = line_argument(p, line_end);
+          shaded_smooth_ = !ELEM(value, "off", "0");
+          smooth_known_ = true;
+          result_.sets_smooth = true;
+          result_.shaded_smooth = shaded_smooth_;
+          break;
+        }
+        case eOBJLineType::Ignored:
+          break;
+      }
+    });
+  }
+
+ private:
+  int current_material_index()
+  {
+    if (!material_known_) {
+      return -1;
+    }
+    if (segment_material_index_ == -2) {
+      segment_material_index_ = segment_->material_names.first_index_of_try(material_name_);
+      if (segment_material_index_ == -1) {
+        segment_material_index_ = segment_->material_names.append_and_get_index(material_name_);
+      }
+    }
+    return segment_material_index_;
+  }
+
+  void use_vertex(const int vert_index)
+  {
+    segment_->vertex_index_min = std::min(segment_->vertex_index_min, vert_index);
+    segment_->vertex_index_max = std::max(segment_->vertex_index_max, vert_index);
+  }
+
+  void parse_face(const char *p, const char *end)
+  {
+    Vector<PolyCorner> &corners = segment_->face_corners;
+    const int start_index = corners.size();
+    const int vertices_num = global_vertices_.vertices.size();
+    const int uv_vertices_num = global_vertices_.uv_vertices.size();
+    const int vertex_normals_num = global_vertices_.vertex_normals.size();
+    bool is_valid = true;
+    bool has_uv = false;
+    bool has_normal = false;
+    while (true) {
+      p = skip_whitespace(p, end);
+      if (p == end) {
+        break;
+      }
+      int index;
+      const char *number_end = parse_int(p, end, index);
+      if (number_end == p) {
+        is_valid = false;
+        break;
+      }
+      p = number_end;
+      PolyCorner corner;
+      corner.vert_index = resolve_index(index, defined_.vertices, vertices_num);
+      is_valid &= corner.vert_index != -1;
+      if (p < end && *p == '/') {
+        p++;
+        if (p < end && *p != '/') {
+          number_end = parse_int(p, end, index);
+          corner.uv_vert_index = number_end == p ?
+                                     -1 :
+                                     resolve_index(index, defined_.uv_vertices, uv_vertices_num);
+          is_valid &= corner.uv_vert_index != -1;
+          has_uv = true;
+          p = number_end;
+        }
+        if (p < end && *p == '/') {
+          p++;
+          number_end = parse_int(p, end, index);
+          corner.vertex_normal_index = number_end == p ? -1 :
+                                                         resolve_index(index,
+                                                                       defined_.vertex_normals,
+                                                                       vertex_normals_num);
+          is_valid &= corner.vertex_normal_index != -1;
+          has_normal = true;
+          p = number_end;
+        }
+      }
+      corners.append(corner);
+    }
+
+    const int corner_count = corners.size() - start_index;
+    if (!is_valid || corner_count < 3) {
+      corners.resize(start_index);
+      result_.invalid_elements_num++;
+      return;
+    }
+    for (const int i : IndexRange(start_index, corner_count)) {
+      use_vertex(corners[i].vert_index);
+    }
+
+    segment_->face_elements.append_as();
+    PolyElem &face = segment_->face_elements.last();
+    face.start_index = start_index;
+    face.corner_count = corner_count;
+    face.material_index = current_material_index();
+    face.shaded_smooth = shaded_smooth_;
+    if (!material_known_) {
+      segment_->faces_with_inherited_material++;
+    }
+    if (!smooth_known_) {
+      segment_->faces_with_inherited_smooth++;
+    }
+    segment_->has_uv_vertices |= has_uv;
+    segment_->has_vertex_normals |= has_normal;
+  }
+
+  /** A polyline with two or more vertices, which is imported as loose edges. */
+  void parse_edges(const char *p, const char *end)
+  {
+    Vector<int, 16> indices;
+    const int vertices_num = global_vertices_.vertices.size();
+    while (true) {
+      p = skip_whitespace(p, end);
+      if (p == end) {
+        break;
+      }
+      int index;
+      const char *number_end = parse_int(p, end, index);
+      const int vert_index = number_end == p ?
+                                 -1 :
+                                 resolve_index(index, defined_.vertices, vertices_num);
+      if (vert_index == -1) {
+        result_.invalid_elements_num++;
+        return;
+      }
+      indices.append(vert_index);
+      /* Texture coordinates of the line are not used. */
+      p = number_end;
+      while (p < end && !is_whitespace(*p)) {
+        p++;
+      }
+    }
+    if (indices.size() < 2) {
+      result_.invalid_elements_num++;
+      return;
+    }
+    for (const int i : indices.index_range().drop_back(1)) {
+      if (indices[i] != indices[i + 1]) {
+        segment_->edges.append({indices[i], indices[i + 1]});
+        use_vertex(indices[i]);
+        use_vertex(indices[i + 1]);
+      }
+    }
+  }
+};
+
+static int ensure_geometry_material(Geometry &geometry, const std::string &name)
+{
+  const int index = geometry.material_names.first_index_of_try(name);
+  return index == -1 ? geometry.material_names.append_and_get_index(name) : index;
+}
+
+/** State that is carried over from one chunk to the next. */
+struct MergeState {
+  bool has_material = false;
+  std::string material_name;
+  bool shaded_smooth = false;
+};
+
+static void merge_segment(Geometry &geometry, ChunkSegment &segment, const MergeState &state)
+{
+  /* The inherited material is used by the first polygons, add it first to keep the order. */
+  const int inherited_material = (state.has_material &&
+                                  segment.faces_with_inherited_material > 0) ?
+                                     ensure_geometry_material(geometry, state.material_name) :
+                                     -1;
+  Array<int> material_map(segment.material_names.size());
+  for (const int i : segment.material_names.index_range()) {
+    material_map[i] = ensure_geometry_material(geometry, segment.material_names[i]);
+  }
+
+  const int face_offset = geometry.face_elements.size();
+  const int corner_offset = geometry.face_corners.size();
+  if (face_offset == 0 && corner_offset == 0) {
+    geometry.face_elements = std::move(segment.face_elements);
+    geometry.face_corners = std::move(segment.face_corners);
+  }
+  else {
+    geometry.face_elements.extend(segment.face_elements);
+    geometry.face_corners.extend(segment.face_corners);
+  }
+  if (geometry.edges.is_empty()) {
+    geometry.edges = std::move(segment.edges);
+  }
+  else {
+    geometry.edges.extend(segment.edges);
+  }
+
+  MutableSpan<PolyElem> faces = geometry.face_elements.as_mutable_span().drop_front(face_offset);
+  threading::parallel_for(faces.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      PolyElem &face = faces[i];
+      face.start_index += corner_offset;
+      if (i < segment.faces_with_inherited_material) {
+        face.material_index = inherited_material;
+      }
+      else if (face.material_index != -1) {
+        face.material_index = material_map[face.material_index];
+      }
+      if (i < segment.faces_with_inherited_smooth) {
+        face.shaded_smooth = state.shaded_smooth;
+      }
+    }
+  });
+
+  geometry.vertex_index_min = std::min(geometry.vertex_index_min, segment.vertex_index_min);
+  geometry.vertex_index_max = std::max(geometry.vertex_index_max, segment.vertex_index_max);
+  geometry.has_uv_vertices |= segment.has_uv_vertices;
+  geometry.has_vertex_normals |= segment.has_vertex_normals;
+}
+
+void parse_obj_buffer(StringRef buffer,
+                      StringRefNull default_geometry_name,
+                      OBJParseResult &r_result,
+                      const int64_t chunk_size)
+{
+  const char *data = buffer.data();
+  const char *data_end = data + buffer.size();
+
+  /* Split the buffer at line boundaries. */
+  Vector<const char *> chunk_starts = {data};
+  while (data_end - chunk_starts.last() > chunk_size) {
+    const char *p = chunk_starts.last() + chunk_size;
+    const char *line_end = find_line_end(p, data_end);
+    while (line_end < data_end && is_line_continued(data, line_end)) {
+      line_end = find_line_end(line_end + 1, data_end);
+    }
+    if (line_end + 1 >= data_end) {
+      break;
+    }
+    chunk_starts.append(line_end + 1);
+  }
+  const int chunks_num = chunk_starts.size();
+  chunk_starts.append(data_end);
+
+  /* Count the vertex elements to know where the vertices of every chunk are stored. */
+  Array<ElementCounts> chunk_offsets(chunks_num + 1);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    for (const int chunk : range) {
+      ElementCounts counts;
+      foreach_line(chunk_starts[chunk], chunk_starts[chunk + 1], [&](const char *p, const char *end) {
+        switch (classify_line(p, end)) {
+          case eOBJLineType::Vertex:
+            counts.vertices++;
+            break;
+          case eOBJLineType::UVVertex:
+            counts.uv_vertices++;
+            break;
+          case eOBJLineType::VertexNormal:
+            counts.vertex_normals++;
+            break;
+          default:
+            break;
+        }
+      });
+      chunk_offsets[chunk + 1] = counts;
+    }
+  });
+  for (const int chunk : IndexRange(chunks_num)) {
+    chunk_offsets[chunk + 1].vertices += chunk_offsets[chunk].vertices;
+    chunk_offsets[chunk + 1].uv_vertices += chunk_offsets[chunk].uv_vertices;
+    chunk_offsets[chunk + 1].vertex_normals += chunk_offsets[chunk].vertex_normals;
+  }
+
+  GlobalVertices &global_vertices = r_result.global_vertices;
+  global_vertices.vertices.resize(chunk_offsets.last().vertices);
+  global_vertices.uv_vertices.resize(chunk_offsets.last().uv_vertices);
+  global_vertices.vertex_normals.resize(chunk_offsets.last().vertex_normals);
+
+  Array<ChunkResult> chunk_results(chunks_num);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    for (const int chunk : range) {
+      ChunkParser parser{global_vertices, chunk_results[chunk], chunk_offsets[chunk]};
+      parser.parse(chunk_starts[chunk], chunk_starts[chunk + 1]);
+    }
+  });
+
+  /* Merge the segments of all chunks into geometries, in the order of the file. */
+  Vector<std::unique_ptr<Geometry>> geometries;
+  Vector<IndexRange> defined_vertex_ranges;
+  MergeState state;
+  for (ChunkResult &chunk_result : chunk_results) {
+    for (ChunkSegment &segment : chunk_result.segments) {
+      if (segment.starts_geometry || geometries.is_empty()) {
+        std::unique_ptr<Geometry> geometry = std::make_unique<Geometry>();
+        geometry->geometry_name = segment.starts_geometry ? segment.geometry_name :
+                                                            std::string(default_geometry_name);
+        geometries.append(std::move(geometry));
+        defined_vertex_ranges.append(IndexRange(segment.defined_vertices_start, 0));
+      }
+      merge_segment(*geometries.last(), segment, state);
+      IndexRange &defined_range = defined_vertex_ranges.last();
+      defined_range = IndexRange(defined_range.start(),
+                                 segment.defined_vertices_end - defined_range.start());
+    }
+    if (chunk_result.sets_material) {
+      state.has_material = true;
+      state.material_name = std::move(chunk_result.material_name);
+    }
+    if (chunk_result.sets_smooth) {
+      state.shaded_smooth = chunk_result.shaded_smooth;
+    }
+    r_result.invalid_elements_num += chunk_result.invalid_elements_num;
+    chunk_result.segments.clear_and_make_inline();
+  }
+
+  bool has_elements = false;
+  for (const std::unique_ptr<Geometry> &geometry : geometries) {
+    has_elements |= !geometry->face_elements.is_empty() || !geometry->edges.is_empty();
+  }
+  for (const int i : geometries.index_range()) {
+    std::unique_ptr<Geometry> &geometry = geometries[i];
+    if (!has_elements) {
+      /* Files with only vertices (point clouds) get all the vertices that are defined in the
+       * section of every geometry. */
+      if (!defined_vertex_ranges[i].is_empty()) {
+        geometry->vertex_index_min = defined_vertex_ranges[i].first();
+        geometry->vertex_index_max = defined_vertex_ranges[i].last();
+        r_result.geometries.append(std::move(geometry));
+      }
+    }
+    else if (!geometry->face_elements.is_empty() || !geometry->edges.is_empty()) {
+      r_result.geometries.append(std::move(geometry));
+    }
+  }
+}
+
+bool parse_obj_file(const char *filepath,
+                    StringRefNull default_geometry_name,
+                    OBJParseResult &r_result)
+{
+  const int file = BLI_open(filepath, O_BINARY | O_RDONLY, 0);
+  if (file == -1) {
+    return false;
+  }
+  const size_t size = BLI_file_descriptor_size(file);
+  if (size == size_t(-1)) {
+    close(file);
+    return false;
+  }
+  if (size == 0) {
+    close(file);
+    return true;
+  }
+
+  bool success = true;
+  BLI_mmap_file *mmap_file = BLI_mmap_open(file);
+  if (mmap_file != nullptr) {
+    const char *data = static_cast<const char *>(BLI_mmap_get_pointer(mmap_file));
+    parse_obj_buffer(StringRef(data, size), default_geometry_name, r_result);
+    /* Reading from the mapping does not fail, but the data that is read is zeroed instead. */
+    success = !BLI_mmap_any_io_error(mmap_file);
+    BLI_mmap_free(mmap_file);
+    close(file);
+    return success;
+  }
+  close(file);
+
+  size_t buffer_size;
+  void *buffer = BLI_file_read_binary_as_mem(filepath, 0, &buffer_size);
+  if (buffer == nullptr) {
+    return false;
+  }
+  parse_obj_buffer(
+      StringRef(static_cast<const char *>(buffer), buffer_size), default_geometry_name, r_result);
+  MEM_freeN(buffer);
+  return success;
+}
+
+}  // namespace blender::io::obj
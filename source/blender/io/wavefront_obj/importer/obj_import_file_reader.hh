@@ -0,0 +1,62 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup obj
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "BLI_string_ref.hh"
+#include "BLI_vector.hh"
+
+#include "obj_import_objects.hh"
+
+namespace blender::io::obj {
+
+/**
+ * Parse a floating point number, leading white-space is skipped.
+ * Numbers with a small number of significant digits (which is what OBJ files are mostly made of)
+ * are converted without `strtod`.
+ * \return The position after the number, or \a p if there is no number at \a p.
+ */
+const char *parse_float(const char *p, const char *end, float &r_value);
+
+/**
+ * Parse a decimal integer with an optional sign, leading white-space is skipped.
+ * \return The position after the number, or \a p if there is no number at \a p.
+ */
+const char *parse_int(const char *p, const char *end, int &r_value);
+
+struct OBJParseResult {
+  GlobalVertices global_vertices;
+  Vector<std::unique_ptr<Geometry>> geometries;
+  /** Polygons and edges that were skipped because they reference vertices that don't exist. */
+  int invalid_elements_num = 0;
+};
+
+/**
+ * Parse the contents of an OBJ file.
+ *
+ * The buffer is split into chunks of whole lines that are parsed in parallel. Since OBJ files
+ * refer to vertices by their global position in the file, there is a quick first pass counting the
+ * vertices of every chunk, so that the vertices can be written to their final position directly.
+ *
+ * \param default_geometry_name: Name for the polygons that appear before any `o` statement.
+ * \param chunk_size: Approximate size of the chunks in bytes, only changed for tests.
+ */
+void parse_obj_buffer(StringRef buffer,
+                      StringRefNull default_geometry_name,
+                      OBJParseResult &r_result,
+                      int64_t chunk_size = 1 << 20);
+
+/**
+ * Read a file with a memory mapping (or into memory when that fails) and parse it.
+ * \return False when the file can't be read.
+ */
+bool parse_obj_file(const char *filepath,
+                    StringRefNull default_geometry_name,
+                    OBJParseResult &r_result);
+
+}  // namespace blender::io::obj
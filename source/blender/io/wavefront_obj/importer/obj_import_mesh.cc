@@ -0,0 +1,242 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup obj
+ */
+
+#include <algorithm>
+
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+
+#include "BKE_customdata.h"
+#include "BKE_mesh.h"
+
+#include "BLI_math_vector.h"
+#include "BLI_task.hh"
+
+#include "obj_import_mesh.hh"
+
+namespace blender::io::obj {
+
+static bool poly_has_repeated_vertices(const Span<PolyCorner> corners)
+{
+  if (corners.size() <= 16) {
+    for (const int i : corners.index_range()) {
+      for (const int j : corners.index_range().drop_front(i + 1)) {
+        if (corners[i].vert_index == corners[j].vert_index) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+  Vector<int, 64> indices;
+  for (const PolyCorner &corner : corners) {
+    indices.append(corner.vert_index);
+  }
+  std::sort(indices.begin(), indices.end());
+  return std::adjacent_find(indices.begin(), indices.end()) != indices.end();
+}
+
+void MeshFromGeometry::find_valid_polys()
+{
+  const Span<PolyElem> faces = mesh_geometry_.face_elements;
+  const Span<PolyCorner> corners = mesh_geometry_.face_corners;
+  Array<bool> is_valid(faces.size());
+  threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      is_valid[i] = !poly_has_repeated_vertices(
+          corners.slice(faces[i].start_index, faces[i].corner_count));
+    }
+  });
+
+  poly_map_.reinitialize(faces.size());
+  Vector<int> loop_starts;
+  loop_starts.reserve(faces.size());
+  int loop_index = 0;
+  for (const int i : faces.index_range()) {
+    if (is_valid[i]) {
+      poly_map_[i] = loop_starts.append_and_get_index(loop_index);
+      loop_index += faces[i].corner_count;
+    }
+    else {
+      poly_map_[i] = -1;
+    }
+  }
+  poly_loop_starts_ = loop_starts.as_span();
+  tot_loops_ = loop_index;
+}
+
+void MeshFromGeometry::create_vertex_map()
+{
+  const int index_offset = mesh_geometry_.vertex_index_min;
+  const int range_size = mesh_geometry_.vertex_index_max - index_offset + 1;
+  const bool use_all_vertices = mesh_geometry_.face_elements.is_empty() &&
+                                mesh_geometry_.edges.is_empty();
+  vertex_map_.reinitialize(std::max(range_size, 0));
+  vertex_map_.fill(use_all_vertices ? 0 : -1);
+
+  const Span<PolyElem> faces = mesh_geometry_.face_elements;
+  const Span<PolyCorner> corners = mesh_geometry_.face_corners;
+  for (const int i : faces.index_range()) {
+    if (poly_map_[i] == -1) {
+      continue;
+    }
+    for (const PolyCorner &corner : corners.slice(faces[i].start_index, faces[i].corner_count)) {
+      vertex_map_[corner.vert_index - index_offset] = 0;
+    }
+  }
+  for (const int2 &edge : mesh_geometry_.edges) {
+    vertex_map_[edge[0] - index_offset] = 0;
+    vertex_map_[edge[1] - index_offset] = 0;
+  }
+
+  /* Used vertices keep their order from the file. */
+  int vert_index = 0;
+  for (int &index : vertex_map_) {
+    if (index != -1) {
+      index = vert_index++;
+    }
+  }
+  tot_verts_ = vert_index;
+}
+
+void MeshFromGeometry::create_vertices(Mesh *mesh)
+{
+  const int index_offset = mesh_geometry_.vertex_index_min;
+  const Span<float3> vertices = global_vertices_.vertices;
+  MutableSpan<MVert> mverts{mesh->mvert, mesh->totvert};
+  threading::parallel_for(vertex_map_.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (vertex_map_[i] != -1) {
+        copy_v3_v3(mverts[vertex_map_[i]].co, vertices[index_offset + i]);
+      }
+    }
+  });
+}
+
+void MeshFromGeometry::create_polys_loops(Mesh *mesh)
+{
+  const int index_offset = mesh_geometry_.vertex_index_min;
+  const Span<PolyElem> faces = mesh_geometry_.face_elements;
+  const Span<PolyCorner> corners = mesh_geometry_.face_corners;
+  /* Custom normals are only used by smooth shaded polygons. */
+  const bool use_smooth = mesh_geometry_.has_vertex_normals;
+  MutableSpan<MPoly> mpolys{mesh->mpoly, mesh->totpoly};
+  MutableSpan<MLoop> mloops{mesh->mloop, mesh->totloop};
+  threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int poly_index = poly_map_[i];
+      if (poly_index == -1) {
+        continue;
+      }
+      const PolyElem &face = faces[i];
+      MPoly &mpoly = mpolys[poly_index];
+      mpoly.loopstart = poly_loop_starts_[poly_index];
+      mpoly.totloop = face.corner_count;
+      mpoly.mat_nr = std::max(face.material_index, 0);
+      mpoly.flag = (use_smooth || face.shaded_smooth) ? ME_SMOOTH : 0;
+      for (const int j : IndexRange(face.corner_count)) {
+        const int vert_index = corners[face.start_index + j].vert_index;
+        mloops[mpoly.loopstart + j].v = vertex_map_[vert_index - index_offset];
+      }
+    }
+  });
+}
+
+void MeshFromGeometry::create_edges(Mesh *mesh)
+{
+  const int index_offset = mesh_geometry_.vertex_index_min;
+  MutableSpan<MEdge> medges{mesh->medge, mesh->totedge};
+  for (const int i : mesh_geometry_.edges.index_range()) {
+    const int2 &edge = mesh_geometry_.edges[i];
+    medges[i].v1 = vertex_map_[edge[0] - index_offset];
+    medges[i].v2 = vertex_map_[edge[1] - index_offset];
+    medges[i].flag = ME_EDGEDRAW | ME_EDGERENDER;
+  }
+  /* Add the edges of the polygons, the loose edges are kept. */
+  BKE_mesh_calc_edges(mesh, true, false);
+  BKE_mesh_calc_edges_loose(mesh);
+}
+
+void MeshFromGeometry::create_uv_verts(Mesh *mesh)
+{
+  const Span<PolyElem> faces = mesh_geometry_.face_elements;
+  const Span<PolyCorner> corners = mesh_geometry_.face_corners;
+  const Span<float2> uv_vertices = global_vertices_.uv_vertices;
+  MLoopUV *mluv_dst = static_cast<MLoopUV *>(CustomData_add_layer_named(
+      &mesh->ldata, CD_MLOOPUV, CD_CALLOC, nullptr, tot_loops_, "UVMap"));
+  threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int poly_index = poly_map_[i];
+      if (poly_index == -1) {
+        continue;
+      }
+      const PolyElem &face = faces[i];
+      const int loop_start = poly_loop_starts_[poly_index];
+      for (const int j : IndexRange(face.corner_count)) {
+        const int uv_index = corners[face.start_index + j].uv_vert_index;
+        if (uv_index != -1) {
+          copy_v2_v2(mluv_dst[loop_start + j].uv, uv_vertices[uv_index]);
+        }
+      }
+    }
+  });
+}
+
+void MeshFromGeometry::create_normals(Mesh *mesh)
+{
+  const Span<PolyElem> faces = mesh_geometry_.face_elements;
+  const Span<PolyCorner> corners = mesh_geometry_.face_corners;
+  const Span<float3> vertex_normals = global_vertices_.vertex_normals;
+  /* Zero vectors keep the automatically computed normal. */
+  Array<float3> loop_normals(tot_loops_, float3(0.0f));
+  threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int poly_index = poly_map_[i];
+      if (poly_index == -1) {
+        continue;
+      }
+      const PolyElem &face = faces[i];
+      const int loop_start = poly_loop_starts_[poly_index];
+      for (const int j : IndexRange(face.corner_count)) {
+        const int normal_index = corners[face.start_index + j].vertex_normal_index;
+        if (normal_index != -1) {
+          normalize_v3_v3(loop_normals[loop_start + j], vertex_normals[normal_index]);
+        }
+      }
+    }
+  });
+  mesh->flag |= ME_AUTOSMOOTH;
+  mesh->smoothresh = float(M_PI);
+  BKE_mesh_set_custom_normals(mesh, reinterpret_cast<float(*)[3]>(loop_normals.data()));
+}
+
+Mesh *MeshFromGeometry::create_mesh()
+{
+  find_valid_polys();
+  create_vertex_map();
+
+  const int tot_polys = poly_loop_starts_.size();
+  Mesh *mesh = BKE_mesh_new_nomain(
+      tot_verts_, mesh_geometry_.edges.size(), 0, tot_loops_, tot_polys);
+
+  create_vertices(mesh);
+  create_polys_loops(mesh);
+  create_edges(mesh);
+  if (mesh_geometry_.has_uv_vertices && tot_loops_ > 0) {
+    create_uv_verts(mesh);
+  }
+  if (mesh_geometry_.has_vertex_normals && tot_loops_ > 0) {
+    create_normals(mesh);
+  }
+  return mesh;
+}
+
+int MeshFromGeometry::invalid_polys_num() const
+{
+  return mesh_geometry_.face_elements.size() - poly_loop_starts_.size();
+}
+
+}  // namespace blender::io::obj
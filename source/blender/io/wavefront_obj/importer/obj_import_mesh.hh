@@ -0,0 +1,63 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup obj
+ */
+
+#pragma once
+
+#include "BLI_array.hh"
+#include "BLI_utility_mixins.hh"
+
+#include "obj_import_objects.hh"
+
+struct Mesh;
+
+namespace blender::io::obj {
+
+/**
+ * Create a #Mesh from the polygons of a #Geometry. The mesh arrays are filled directly, without
+ * a conversion from #BMesh.
+ */
+class MeshFromGeometry : NonMovable, NonCopyable {
+ private:
+  const Geometry &mesh_geometry_;
+  const GlobalVertices &global_vertices_;
+  /**
+   * Index of the mesh vertex for every global vertex in the range that is used by the geometry,
+   * or -1 for vertices that are not used.
+   */
+  Array<int> vertex_map_;
+  /** Mesh polygon index for every #PolyElem, or -1 when the polygon is skipped. */
+  Array<int> poly_map_;
+  /** First mesh loop of every mesh polygon. */
+  Array<int> poly_loop_starts_;
+  int tot_verts_ = 0;
+  int tot_loops_ = 0;
+
+ public:
+  MeshFromGeometry(const Geometry &mesh_geometry, const GlobalVertices &global_vertices)
+      : mesh_geometry_(mesh_geometry), global_vertices_(global_vertices)
+  {
+  }
+
+  /**
+   * Create a mesh that is not in #Main. This does not access global data, so meshes of different
+   * geometries can be created in parallel.
+   */
+  Mesh *create_mesh();
+
+  /** Number of polygons that are skipped, because they use the same vertex more than once. */
+  int invalid_polys_num() const;
+
+ private:
+  void find_valid_polys();
+  void create_vertex_map();
+  void create_vertices(Mesh *mesh);
+  void create_polys_loops(Mesh *mesh);
+  void create_edges(Mesh *mesh);
+  void create_uv_verts(Mesh *mesh);
+  void create_normals(Mesh *mesh);
+};
+
+}  // namespace blender::io::obj
@@ -0,0 +1,63 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup obj
+ */
+
+#pragma once
+
+#include <string>
+
+#include "BLI_math_vec_types.hh"
+#include "BLI_vector.hh"
+
+namespace blender::io::obj {
+
+/**
+ * All vertex data of an OBJ file. Polygons of all objects in the file index into these arrays.
+ */
+struct GlobalVertices {
+  Vector<float3> vertices;
+  Vector<float2> uv_vertices;
+  Vector<float3> vertex_normals;
+};
+
+/**
+ * One corner of a polygon. The indices are zero-based and index into #GlobalVertices.
+ * Optional indices are -1 when they are not given in the file.
+ */
+struct PolyCorner {
+  int vert_index;
+  int uv_vert_index = -1;
+  int vertex_normal_index = -1;
+};
+
+struct PolyElem {
+  /** Index of the first corner in #Geometry::face_corners. */
+  int start_index = 0;
+  int corner_count = 0;
+  /** Index into #Geometry::material_names, or -1 when no material is used. */
+  int material_index = -1;
+  bool shaded_smooth = false;
+};
+
+/**
+ * A mesh object that is created from the file, defined by the polygons and edges between two
+ * `o` statements.
+ */
+struct Geometry {
+  std::string geometry_name;
+  /** Names of the materials used by the polygons, in the order of first use. */
+  Vector<std::string> material_names;
+  Vector<PolyElem> face_elements;
+  Vector<PolyCorner> face_corners;
+  /** Loose edges from `l` statements, as indices into #GlobalVertices::vertices. */
+  Vector<int2> edges;
+  /** Range of the vertex indices that are used by the polygons and edges. */
+  int vertex_index_min = INT32_MAX;
+  int vertex_index_max = -1;
+  bool has_uv_vertices = false;
+  bool has_vertex_normals = false;
+};
+
+}  // namespace blender::io::obj
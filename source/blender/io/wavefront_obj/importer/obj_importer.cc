@@ -0,0 +1,153 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup obj
+ */
+
+#include <iostream>
+
+#include "BKE_collection.h"
+#include "BKE_customdata.h"
+#include "BKE_layer.h"
+#include "BKE_lib_id.h"
+#include "BKE_material.h"
+#include "BKE_mesh.h"
+#include "BKE_object.h"
+
+#include "BLI_array.hh"
+#include "BLI_math_matrix.h"
+#include "BLI_math_rotation.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_task.hh"
+
+#include "DEG_depsgraph.h"
+#include "DEG_depsgraph_build.h"
+
+#include "DNA_collection_types.h"
+#include "DNA_material_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "obj_import_file_reader.hh"
+#include "obj_import_mesh.hh"
+#include "obj_importer.hh"
+
+namespace blender::io::obj {
+
+static Material *find_or_create_material(Main *bmain, const std::string &name)
+{
+  Material *material = reinterpret_cast<Material *>(
+      BKE_libblock_find_name(bmain, ID_MA, name.c_str()));
+  if (material != nullptr) {
+    return material;
+  }
+  material = BKE_material_add(bmain, name.c_str());
+  /* The user is added when the material is assigned. */
+  id_us_min(&material->id);
+  return material;
+}
+
+static Object *create_geometry_object(Main *bmain,
+                                      const Geometry &geometry,
+                                      Mesh *mesh_src,
+                                      const OBJImportParams &import_params)
+{
+  const char *name = geometry.geometry_name.c_str();
+  Object *obj = BKE_object_add_only_object(bmain, OB_MESH, name);
+  Mesh *mesh = BKE_mesh_add(bmain, name);
+  obj->data = mesh;
+  BKE_mesh_nomain_to_mesh(mesh_src, mesh, obj, &CD_MASK_EVERYTHING, true);
+  if (geometry.has_vertex_normals) {
+    mesh->flag |= ME_AUTOSMOOTH;
+    mesh->smoothresh = float(M_PI);
+  }
+
+  for (const std::string &material_name : geometry.material_names) {
+    Material *material = find_or_create_material(bmain, material_name);
+    BKE_object_material_slot_add(bmain, obj);
+    BKE_object_material_assign(bmain, obj, material, obj->totcol, BKE_MAT_ASSIGN_USERPREF);
+  }
+
+  /* Convert from the axes of the file to the Blender default (+Y forward, +Z up). */
+  float axes_transform[3][3];
+  unit_m3(axes_transform);
+  mat3_from_axis_conversion(OBJ_AXIS_Y_FORWARD,
+                            OBJ_AXIS_Z_UP,
+                            import_params.forward_axis,
+                            import_params.up_axis,
+                            axes_transform);
+  float obmat[4][4];
+  unit_m4(obmat);
+  copy_m4_m3(obmat, axes_transform);
+  BKE_object_apply_mat4(obj, obmat, true, false);
+  return obj;
+}
+
+void importer_main(Main *bmain,
+                   Scene *scene,
+                   ViewLayer *view_layer,
+                   const OBJImportParams &import_params)
+{
+  char default_geometry_name[FILE_MAX];
+  BLI_strncpy(default_geometry_name,
+              BLI_path_basename(import_params.filepath),
+              sizeof(default_geometry_name));
+  BLI_path_extension_replace(default_geometry_name, sizeof(default_geometry_name), "");
+
+  OBJParseResult parse_result;
+  if (!parse_obj_file(import_params.filepath, default_geometry_name, parse_result)) {
+    std::cerr << "Cannot read from OBJ file: '" << import_params.filepath << "'" << std::endl;
+    return;
+  }
+
+  /* Building the meshes does not need access to #Main, so do it for all geometries in
+   * parallel. */
+  const Span<std::unique_ptr<Geometry>> geometries = parse_result.geometries;
+  Array<Mesh *> meshes(geometries.size());
+  Array<int> invalid_polys_num(geometries.size());
+  threading::parallel_for(geometries.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      MeshFromGeometry mesh_from_geometry{*geometries[i], parse_result.global_vertices};
+      meshes[i] = mesh_from_geometry.create_mesh();
+      invalid_polys_num[i] = mesh_from_geometry.invalid_polys_num();
+    }
+  });
+
+  int invalid_elements_num = parse_result.invalid_elements_num;
+  for (const int num : invalid_polys_num) {
+    invalid_elements_num += num;
+  }
+  if (invalid_elements_num > 0) {
+    std::cerr << "OBJ import: skipped " << invalid_elements_num
+              << " invalid polygons and lines in '" << import_params.filepath << "'"
+              << std::endl;
+  }
+
+  BKE_view_layer_base_deselect_all(view_layer);
+  LayerCollection *lc = BKE_layer_collection_get_active(view_layer);
+  for (const int i : geometries.index_range()) {
+    Object *obj = create_geometry_object(bmain, *geometries[i], meshes[i], import_params);
+    BKE_collection_object_add(bmain, lc->collection, obj);
+    Base *base = BKE_view_layer_base_find(view_layer, obj);
+    BKE_view_layer_base_select_and_set_active(view_layer, base);
+
+    DEG_id_tag_update(&lc->collection->id, ID_RECALC_COPY_ON_WRITE);
+    DEG_id_tag_update_ex(bmain,
+                         &obj->id,
+                         ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY | ID_RECALC_ANIMATION |
+                             ID_RECALC_BASE_FLAGS);
+  }
+
+  DEG_id_tag_update(&scene->id, ID_RECALC_BASE_FLAGS);
+  DEG_relations_tag_update(bmain);
+}
+
+void importer_main(bContext *C, const OBJImportParams &import_params)
+{
+  importer_main(
+      CTX_data_main(C), CTX_data_scene(C), CTX_data_view_layer(C), import_params);
+}
+
+}  // namespace blender::io::obj
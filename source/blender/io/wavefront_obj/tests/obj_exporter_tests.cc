@@ -238,6 +238,68 @@ TEST(obj_exporter_writer, mtllib)
   BLI_delete(out_file_path.c_str(), false, false);
 }
 
+TEST(obj_exporter_writer, format_handler_numbers)
+{
+  /* The common elements are formatted without `printf`, the result has to be exactly the same. */
+  const float values[] = {0.0f,         -0.0f,         1.0f,         -1.0f,          0.5f,
+                          0.0000005f,   -0.0000005f,   0.0000015f,   0.00005f,       0.12345f,
+                          0.9999996f,   -0.9999996f,   123.456789f,  1e-30f,         -1e-40f,
+                          99999.99f,    16777216.0f,   999999999.0f, 1e10f,          -3e20f,
+                          INFINITY,     NAN,           5e-7f,        2.5e-5f,        1.00005f};
+  const int indices[] = {0, 1, -1, 9, 10, 123456789, INT32_MAX, INT32_MIN};
+  FormatHandler<eFileType::OBJ> h;
+  std::string expected;
+  char buf[256];
+  for (const float a : values) {
+    for (const float b : values) {
+      h.write<eOBJSyntaxElement::vertex_coords>(a, b, a);
+      snprintf(buf, sizeof(buf), "v %f %f %f\n", a, b, a);
+      expected += buf;
+      h.write<eOBJSyntaxElement::uv_vertex_coords>(a, b);
+      snprintf(buf, sizeof(buf), "vt %f %f\n", a, b);
+      expected += buf;
+      h.write<eOBJSyntaxElement::normal>(b, a, b);
+      snprintf(buf, sizeof(buf), "vn %.4f %.4f %.4f\n", b, a, b);
+      expected += buf;
+    }
+  }
+  /* Pseudo-random values from a large range of magnitudes. */
+  uint32_t state = 1;
+  for (int i = 0; i < 100000; i++) {
+    state = state * 1664525u + 1013904223u;
+    const float value = float(state) / float(1 << (state % 31)) * ((state & 1) ? -1.0f : 1.0f);
+    h.write<eOBJSyntaxElement::normal>(value, value, value);
+    snprintf(buf, sizeof(buf), "vn %.4f %.4f %.4f\n", value, value, value);
+    expected += buf;
+  }
+  for (const int a : indices) {
+    for (const int b : indices) {
+      h.write<eOBJSyntaxElement::poly_element_begin>();
+      h.write<eOBJSyntaxElement::vertex_uv_normal_indices>(a, b, a);
+      h.write<eOBJSyntaxElement::vertex_normal_indices>(a, b);
+      h.write<eOBJSyntaxElement::vertex_uv_indices>(b, a);
+      h.write<eOBJSyntaxElement::vertex_indices>(a);
+      h.write<eOBJSyntaxElement::poly_element_end>();
+      h.write<eOBJSyntaxElement::edge>(a, b);
+      snprintf(buf,
+               sizeof(buf),
+               "f %d/%d/%d %d//%d %d/%d %d\nl %d %d\n",
+               a,
+               b,
+               a,
+               a,
+               b,
+               b,
+               a,
+               a,
+               a,
+               b);
+      expected += buf;
+    }
+  }
+  ASSERT_EQ(h.get_as_string(), expected);
+}
+
 TEST(obj_exporter_writer, format_handler_buffer_chunking)
 {
   /* Use a tiny buffer chunk size, so that the test below ends up creating several blocks. */
@@ -0,0 +1,193 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include "testing/testing.h"
+
+#include "obj_import_file_reader.hh"
+
+namespace blender::io::obj {
+
+static void parse(StringRef text, OBJParseResult &r_result, const int64_t chunk_size = 1 << 20)
+{
+  parse_obj_buffer(text, "default", r_result, chunk_size);
+}
+
+TEST(obj_importer, parse_float)
+{
+  const char *numbers[] = {"0",
+                           "-0",
+                           "1",
+                           "+1.5",
+                           "-0.000001",
+                           "0.1",
+                           "123456.789",
+                           "3.14159265358979323846264338327950288",
+                           "1e10",
+                           "1.5E-3",
+                           "-2.5e+2",
+                           "0.000000000000000000000000000000000001",
+                           "16777217",
+                           "1.00000005960464477539",
+                           "340282346638528859811704183484516925440"};
+  for (const char *number : numbers) {
+    float value = -1.0f;
+    const char *end = number + strlen(number);
+    EXPECT_EQ(parse_float(number, end, value), end) << number;
+    EXPECT_EQ(value, strtof(number, nullptr)) << number;
+  }
+
+  float value = 5.0f;
+  const char *text = "  abc";
+  EXPECT_EQ(parse_float(text, text + 5, value), text + 2);
+  EXPECT_EQ(value, 5.0f);
+  text = "2.5/7";
+  EXPECT_EQ(parse_float(text, text + 5, value), text + 3);
+  EXPECT_EQ(value, 2.5f);
+}
+
+TEST(obj_importer, parse_int)
+{
+  int value = 0;
+  const char *text = " -12/3";
+  EXPECT_EQ(parse_int(text, text + 6, value), text + 4);
+  EXPECT_EQ(value, -12);
+  text = "/3";
+  EXPECT_EQ(parse_int(text, text + 2, value), text);
+  EXPECT_EQ(value, -12);
+}
+
+TEST(obj_importer, parse_geometries)
+{
+  const char *text = R"(# comment
+mtllib cube.mtl
+v 1 2 3
+v -1.5 0.25 1e2
+v 0 0 0
+v 1 1 1
+vt 0.5 0.5
+vn 0 0 1
+f 1 2 3
+o Second
+usemtl Red
+s 1
+f 1/1/1 2/1/1 3/1/1 4/1/1
+f -1//1 -2//1 -3//1
+usemtl Blue
+s off
+f 1 2 \
+  4
+o Empty
+o Lines
+l 1 2 3
+f 1 5 2
+)";
+  OBJParseResult result;
+  parse(text, result);
+  const GlobalVertices &vertices = result.global_vertices;
+  ASSERT_EQ(vertices.vertices.size(), 4);
+  EXPECT_EQ(vertices.vertices[1], float3(-1.5f, 0.25f, 100.0f));
+  ASSERT_EQ(vertices.uv_vertices.size(), 1);
+  EXPECT_EQ(vertices.uv_vertices[0], float2(0.5f, 0.5f));
+  ASSERT_EQ(vertices.vertex_normals.size(), 1);
+  EXPECT_EQ(result.invalid_elements_num, 1);
+
+  ASSERT_EQ(result.geometries.size(), 3);
+  const Geometry &first = *result.geometries[0];
+  EXPECT_EQ(first.geometry_name, "default");
+  ASSERT_EQ(first.face_elements.size(), 1);
+  EXPECT_EQ(first.face_elements[0].material_index, -1);
+  EXPECT_FALSE(first.has_uv_vertices);
+
+  const Geometry &second = *result.geometries[1];
+  EXPECT_EQ(second.geometry_name, "Second");
+  ASSERT_EQ(second.material_names.size(), 2);
+  EXPECT_EQ(second.material_names[0], "Red");
+  EXPECT_EQ(second.material_names[1], "Blue");
+  ASSERT_EQ(second.face_elements.size(), 3);
+  EXPECT_EQ(second.face_elements[0].corner_count, 4);
+  EXPECT_EQ(second.face_elements[0].material_index, 0);
+  EXPECT_TRUE(second.face_elements[0].shaded_smooth);
+  EXPECT_EQ(second.face_elements[1].start_index, 4);
+  EXPECT_EQ(second.face_elements[2].material_index, 1);
+  EXPECT_FALSE(second.face_elements[2].shaded_smooth);
+  EXPECT_EQ(second.face_elements[2].corner_count, 3);
+  EXPECT_TRUE(second.has_uv_vertices);
+  EXPECT_TRUE(second.has_vertex_normals);
+  /* Relative indices. */
+  EXPECT_EQ(second.face_corners[4].vert_index, 3);
+  EXPECT_EQ(second.face_corners[6].vert_index, 1);
+  EXPECT_EQ(second.face_corners[6].uv_vert_index, -1);
+  EXPECT_EQ(second.face_corners[6].vertex_normal_index, 0);
+  EXPECT_EQ(second.face_corners[9].vert_index, 3);
+
+  const Geometry &lines = *result.geometries[2];
+  EXPECT_EQ(lines.geometry_name, "Lines");
+  EXPECT_TRUE(lines.face_elements.is_empty());
+  ASSERT_EQ(lines.edges.size(), 2);
+  EXPECT_EQ(lines.edges[1], int2(1, 2));
+  EXPECT_EQ(lines.vertex_index_min, 0);
+  EXPECT_EQ(lines.vertex_index_max, 2);
+}
+
+TEST(obj_importer, parse_chunks)
+{
+  /* The result has to be the same, independent of how the file is split into chunks. */
+  std::string text = "usemtl A\n";
+  for (int i = 0; i < 100; i++) {
+    text += "v " + std::to_string(i) + " 0 0\n";
+    if (i % 7 == 0) {
+      text += "o Object" + std::to_string(i) + "\n";
+    }
+    if (i % 5 == 0) {
+      text += "usemtl M" + std::to_string(i / 10) + "\n";
+    }
+    if (i % 3 == 0) {
+      text += i % 2 ? "s 1\n" : "s off\n";
+    }
+    if (i >= 2) {
+      text += "f -1 -2 -3\n";
+    }
+  }
+
+  OBJParseResult expected;
+  parse(text, expected);
+  for (const int chunk_size : {1, 7, 50, 333}) {
+    OBJParseResult result;
+    parse(text, result, chunk_size);
+    EXPECT_EQ(result.global_vertices.vertices.as_span(),
+              expected.global_vertices.vertices.as_span());
+    ASSERT_EQ(result.geometries.size(), expected.geometries.size());
+    for (const int i : expected.geometries.index_range()) {
+      const Geometry &a = *result.geometries[i];
+      const Geometry &b = *expected.geometries[i];
+      EXPECT_EQ(a.geometry_name, b.geometry_name);
+      EXPECT_EQ(a.material_names.as_span(), b.material_names.as_span());
+      ASSERT_EQ(a.face_elements.size(), b.face_elements.size());
+      for (const int face : a.face_elements.index_range()) {
+        EXPECT_EQ(a.face_elements[face].start_index, b.face_elements[face].start_index);
+        EXPECT_EQ(a.face_elements[face].material_index, b.face_elements[face].material_index);
+        EXPECT_EQ(a.face_elements[face].shaded_smooth, b.face_elements[face].shaded_smooth);
+      }
+      ASSERT_EQ(a.face_corners.size(), b.face_corners.size());
+      for (const int corner : a.face_corners.index_range()) {
+        EXPECT_EQ(a.face_corners[corner].vert_index, b.face_corners[corner].vert_index);
+      }
+    }
+  }
+}
+
+TEST(obj_importer, parse_point_cloud)
+{
+  OBJParseResult result;
+  parse("v 0 0 0\nv 1 0 0\no Points\nv 2 0 0\r\nv 3 0 0\r\n", result);
+  ASSERT_EQ(result.geometries.size(), 2);
+  EXPECT_EQ(result.geometries[0]->vertex_index_min, 0);
+  EXPECT_EQ(result.geometries[0]->vertex_index_max, 1);
+  EXPECT_EQ(result.geometries[1]->geometry_name, "Points");
+  EXPECT_EQ(result.geometries[1]->vertex_index_min, 2);
+  EXPECT_EQ(result.geometries[1]->vertex_index_max, 3);
+}
+
+}  // namespace blender::io::obj
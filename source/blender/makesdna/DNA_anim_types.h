@@ -627,6 +627,13 @@ typedef struct FCurve {
   float color[3];
 
   float prev_norm_factor, prev_offset;
+
+  /**
+   * Index of the keyframe ending the segment used by the last evaluation, used as a hint for the
+   * next evaluation (not thread-safe, it is always validated before it is used).
+   */
+  int eval_segment_index;
+  char _pad2[4];
 } FCurve;
 
 /* user-editable flags/settings */
@@ -87,6 +87,9 @@ struct DNA_ReconstructInfo;
 /**
  * Pre-process information about how structs in \a newsdna can be reconstructed from structs in
  * \a oldsdna. This information is then used to speedup #DNA_struct_reconstruct.
+ *
+ * \note The information for a struct is only generated when it is reconstructed first, so
+ * #DNA_struct_reconstruct must not be called from multiple threads with the same info.
  */
 struct DNA_ReconstructInfo *DNA_reconstruct_info_create(const struct SDNA *oldsdna,
                                                         const struct SDNA *newsdna,
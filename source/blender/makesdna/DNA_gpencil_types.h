@@ -240,7 +240,9 @@ typedef struct bGPDstroke_Runtime {
 
   /** Original stroke (used to dereference evaluated data) */
   struct bGPDstroke *gps_orig;
-  void *_pad2;
+  /** Index of the stroke in its frame, set before deform modifiers are evaluated. */
+  int stroke_index;
+  char _pad2[4];
 } bGPDstroke_Runtime;
 
 /* Grease-Pencil Annotations - 'Stroke'
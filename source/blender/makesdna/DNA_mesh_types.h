@@ -29,7 +29,9 @@ struct MLoopUV;
 struct MPoly;
 struct MVert;
 struct Material;
+struct LoopSplitFanCache;
 struct Mesh;
+struct MeshTopologyMaps;
 struct SubdivCCG;
 
 #
@@ -73,6 +75,9 @@ typedef struct Mesh_Runtime {
   /** Needed to ensure some thread-safety during render data pre-processing. */
   void *render_mutex;
 
+  /** Protects lazy creation of the #topology_maps and access to #loop_split_fans. */
+  void *topology_mutex;
+
   /** Lazily initialized SoA data from the #edit_mesh field in #Mesh. */
   struct EditMeshData *edit_data;
 
@@ -91,6 +96,18 @@ typedef struct Mesh_Runtime {
   /** Cache of non-manifold boundary data for Shrinkwrap Target Project. */
   struct ShrinkwrapBoundaryData *shrinkwrap_data;
 
+  /**
+   * Cache of vertex, edge and loop adjacency maps, shared by all users of the mesh.
+   * Defined in `mesh_runtime.c`, freed with the other geometry caches.
+   */
+  struct MeshTopologyMaps *topology_maps;
+
+  /**
+   * Smooth fans of the split normals, reused by evaluated meshes sharing this mesh topology.
+   * Defined in `mesh_normals.cc`, freed with the other geometry caches.
+   */
+  struct LoopSplitFanCache *loop_split_fans;
+
   /** Needed in case we need to lazily initialize the mesh. */
   CustomData_MeshMasks cd_mask_extra;
 
@@ -15,6 +15,7 @@
     .multi = 0.0f, \
     .object = NULL, \
     .defgrp_name = "", \
+    .cache_memory_limit = 1024, \
   }
 
 /* Default to 2 duplicates distributed along the x-axis by an offset of 1 object width. */
@@ -560,7 +561,9 @@
   }
 
 #define _DNA_DEFAULT_NodesModifierData \
-  { 0 }
+  { \
+    .cache_memory_limit = 4096, \
+  }
 
 #define _DNA_DEFAULT_SkinModifierData \
   { \
@@ -763,14 +763,30 @@ typedef struct ArmatureModifierData {
 
   /** #eArmature_DeformFlag use instead of #bArmature.deformflag. */
   short deformflag, multi;
-  char _pad2[4];
+  /** #ArmatureModifierFlag. */
+  short flag;
+  char _pad2[2];
   struct Object *object;
   /** Stored input of previous modifier, for vertex-group blending. */
   float (*vert_coords_prev)[3];
+  /**
+   * Deformed positions per frame, only used when #MOD_ARMATURE_CACHE_FRAMES is enabled.
+   * Only stored on the original modifier.
+   */
+  void *runtime_frame_cache;
   /** MAX_VGROUP_NAME. */
   char defgrp_name[64];
+  /** Size of the cached frames in megabytes, zero means no limit. */
+  int cache_memory_limit;
+  char _pad3[4];
 } ArmatureModifierData;
 
+/** #ArmatureModifierData.flag */
+typedef enum ArmatureModifierFlag {
+  /** Keep the deformed positions of every frame, to play them back without deforming again. */
+  MOD_ARMATURE_CACHE_FRAMES = (1 << 0),
+} ArmatureModifierFlag;
+
 enum {
   MOD_HOOK_UNIFORM_SPACE = (1 << 0),
   MOD_HOOK_INVERT_VGROUP = (1 << 1),
@@ -2292,9 +2308,32 @@ typedef struct NodesModifierData {
    * This can be used to help the user to debug a node tree.
    */
   void *runtime_eval_log;
-  void *_pad1;
+  /**
+   * Results of individual nodes from the previous evaluation, only used when
+   * #MOD_NODES_CACHE_NODE_RESULTS is enabled. Only stored on the original modifier.
+   */
+  void *runtime_result_cache;
+  /**
+   * Evaluated geometry per frame, only used when #MOD_NODES_CACHE_FRAMES is enabled.
+   * Only stored on the original modifier.
+   */
+  void *runtime_frame_cache;
+  /** #NodesModifierFlag. */
+  int flag;
+  /** Size of the cached frames kept in memory in megabytes, zero means no limit. */
+  int cache_memory_limit;
+  /** Directory to write cached frames to, only keep them in memory when empty. FILE_MAX. */
+  char cache_directory[1024];
 } NodesModifierData;
 
+/** #NodesModifierData.flag */
+typedef enum NodesModifierFlag {
+  /** Keep node results between evaluations to avoid recomputing nodes whose inputs are the same. */
+  MOD_NODES_CACHE_NODE_RESULTS = (1 << 0),
+  /** Keep the evaluated geometry of every frame, to play it back without evaluating again. */
+  MOD_NODES_CACHE_FRAMES = (1 << 1),
+} NodesModifierFlag;
+
 typedef struct MeshToVolumeModifierData {
   ModifierData modifier;
 
@@ -543,6 +543,10 @@ typedef struct bNodeTree {
    * Only available in base node trees (e.g. scene->node_tree)
    */
   struct bNodeInstanceHash *previews;
+  /* Statistics of the latest execution by node instance (#bNodeExecutionStats), runtime only.
+   * Only available in base node trees, like previews.
+   */
+  struct bNodeInstanceHash *execution_stats;
   /* Defines the node tree instance to use for the "active" context,
    * in case multiple different editors are used and make context ambiguous.
    */
@@ -595,6 +599,7 @@ typedef struct bNodeTree {
 
 /* tree is localized copy, free when deleting node groups */
 /* #define NTREE_IS_LOCALIZED           (1 << 5) */
+#define NTREE_COM_GPU (1 << 6) /* render supported operations on the GPU */
 
 /* tree->execution_mode */
 typedef enum eNodeTreeExecutionMode {
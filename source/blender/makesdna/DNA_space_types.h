@@ -606,6 +606,12 @@ typedef struct SpaceSeqRuntime {
   struct rctf last_thumbnail_area;
   /** Stores lists of most recently displayed thumbnails. */
   struct GHash *last_displayed_thumbnails;
+  /**
+   * The buffer that was displayed last with the GLSL display transform and its texture, which
+   * can be reused as long as the buffer is displayed. The buffer is referenced.
+   */
+  struct ImBuf *display_texture_ibuf;
+  struct GPUTexture *display_texture;
 } SpaceSeqRuntime;
 
 /** Sequencer. */
@@ -1119,10 +1119,22 @@ typedef struct DNA_ReconstructInfo {
   const SDNA *newsdna;
   const char *compare_flags;
 
+  /**
+   * The steps are only created when a struct is reconstructed for the first time, because files
+   * only contain a fraction of all struct types. A step count of -1 means the steps have not
+   * been created yet.
+   */
   int *step_counts;
   ReconstructStep **steps;
+
+  /** Index in `newsdna->structs` for every struct in `oldsdna`, -2 when not looked up yet. */
+  int *new_struct_nr_from_old;
 } DNA_ReconstructInfo;
 
+static const ReconstructStep *reconstruct_steps_ensure(const DNA_ReconstructInfo *reconstruct_info,
+                                                       int new_struct_nr,
+                                                       int *r_step_count);
+
 static void reconstruct_structs(const DNA_ReconstructInfo *reconstruct_info,
                                 const int blocks,
                                 const int old_struct_nr,
@@ -1144,8 +1156,9 @@ static void reconstruct_struct(const DNA_ReconstructInfo *reconstruct_info,
                                const char *old_block,
                                char *new_block)
 {
-  const ReconstructStep *steps = reconstruct_info->steps[new_struct_nr];
-  const int step_count = reconstruct_info->step_counts[new_struct_nr];
+  int step_count;
+  const ReconstructStep *steps = reconstruct_steps_ensure(
+      reconstruct_info, new_struct_nr, &step_count);
 
   /* Execute all preprocessed steps. */
   for (int a = 0; a < step_count; a++) {
@@ -1220,9 +1233,13 @@ void *DNA_struct_reconstruct(const DNA_ReconstructInfo *reconstruct_info,
   const SDNA *oldsdna = reconstruct_info->oldsdna;
   const SDNA *newsdna = reconstruct_info->newsdna;
 
-  const SDNA_Struct *old_struct = oldsdna->structs[old_struct_nr];
-  const char *type_name = oldsdna->types[old_struct->type];
-  const int new_struct_nr = DNA_struct_find_nr(newsdna, type_name);
+  int new_struct_nr = reconstruct_info->new_struct_nr_from_old[old_struct_nr];
+  if (new_struct_nr == -2) {
+    const SDNA_Struct *old_struct = oldsdna->structs[old_struct_nr];
+    const char *type_name = oldsdna->types[old_struct->type];
+    new_struct_nr = DNA_struct_find_nr(newsdna, type_name);
+    reconstruct_info->new_struct_nr_from_old[old_struct_nr] = new_struct_nr;
+  }
 
   if (new_struct_nr == -1) {
     return NULL;
@@ -1509,6 +1526,52 @@ static int compress_reconstruct_steps(ReconstructStep *steps, const int old_step
   return new_step_count;
 }
 
+/** Generate the reconstruct steps for a struct if that was not done yet. */
+static const ReconstructStep *reconstruct_steps_ensure(const DNA_ReconstructInfo *reconstruct_info,
+                                                       const int new_struct_nr,
+                                                       int *r_step_count)
+{
+  if (reconstruct_info->step_counts[new_struct_nr] != -1) {
+    *r_step_count = reconstruct_info->step_counts[new_struct_nr];
+    return reconstruct_info->steps[new_struct_nr];
+  }
+
+  const SDNA *oldsdna = reconstruct_info->oldsdna;
+  const SDNA *newsdna = reconstruct_info->newsdna;
+  const SDNA_Struct *new_struct = newsdna->structs[new_struct_nr];
+  const char *new_struct_name = newsdna->types[new_struct->type];
+  const int old_struct_nr = DNA_struct_find_nr(oldsdna, new_struct_name);
+  if (old_struct_nr < 0) {
+    reconstruct_info->steps[new_struct_nr] = NULL;
+    reconstruct_info->step_counts[new_struct_nr] = 0;
+    *r_step_count = 0;
+    return NULL;
+  }
+  const SDNA_Struct *old_struct = oldsdna->structs[old_struct_nr];
+  ReconstructStep *steps = create_reconstruct_steps_for_struct(
+      oldsdna, newsdna, reconstruct_info->compare_flags, old_struct, new_struct);
+
+  /* Comment the line below to skip the compression for debugging purposes. */
+  const int steps_len = compress_reconstruct_steps(steps, new_struct->members_len);
+
+  reconstruct_info->steps[new_struct_nr] = steps;
+  reconstruct_info->step_counts[new_struct_nr] = steps_len;
+
+/* This is useful when debugging the reconstruct steps. */
+#if 0
+  printf("%s: \n", new_struct_name);
+  for (int a = 0; a < steps_len; a++) {
+    printf("  ");
+    print_reconstruct_step(&steps[a], oldsdna, newsdna);
+    printf("\n");
+  }
+#endif
+  UNUSED_VARS(print_reconstruct_step);
+
+  *r_step_count = steps_len;
+  return steps;
+}
+
 DNA_ReconstructInfo *DNA_reconstruct_info_create(const SDNA *oldsdna,
                                                  const SDNA *newsdna,
                                                  const char *compare_flags)
@@ -1518,39 +1581,17 @@ DNA_ReconstructInfo *DNA_reconstruct_info_create(const SDNA *oldsdna,
   reconstruct_info->newsdna = newsdna;
   reconstruct_info->compare_flags = compare_flags;
   reconstruct_info->step_counts = MEM_malloc_arrayN(newsdna->structs_len, sizeof(int), __func__);
-  reconstruct_info->steps = MEM_malloc_arrayN(
+  reconstruct_info->steps = MEM_calloc_arrayN(
       newsdna->structs_len, sizeof(ReconstructStep *), __func__);
+  reconstruct_info->new_struct_nr_from_old = MEM_malloc_arrayN(
+      oldsdna->structs_len, sizeof(int), __func__);
 
-  /* Generate reconstruct steps for all structs. */
+  /* The reconstruct steps are generated when they are used first. */
   for (int new_struct_nr = 0; new_struct_nr < newsdna->structs_len; new_struct_nr++) {
-    const SDNA_Struct *new_struct = newsdna->structs[new_struct_nr];
-    const char *new_struct_name = newsdna->types[new_struct->type];
-    const int old_struct_nr = DNA_struct_find_nr(oldsdna, new_struct_name);
-    if (old_struct_nr < 0) {
-      reconstruct_info->steps[new_struct_nr] = NULL;
-      reconstruct_info->step_counts[new_struct_nr] = 0;
-      continue;
-    }
-    const SDNA_Struct *old_struct = oldsdna->structs[old_struct_nr];
-    ReconstructStep *steps = create_reconstruct_steps_for_struct(
-        oldsdna, newsdna, compare_flags, old_struct, new_struct);
-
-    /* Comment the line below to skip the compression for debugging purposes. */
-    const int steps_len = compress_reconstruct_steps(steps, new_struct->members_len);
-
-    reconstruct_info->steps[new_struct_nr] = steps;
-    reconstruct_info->step_counts[new_struct_nr] = steps_len;
-
-/* This is useful when debugging the reconstruct steps. */
-#if 0
-    printf("%s: \n", new_struct_name);
-    for (int a = 0; a < steps_len; a++) {
-      printf("  ");
-      print_reconstruct_step(&steps[a], oldsdna, newsdna);
-      printf("\n");
-    }
-#endif
-    UNUSED_VARS(print_reconstruct_step);
+    reconstruct_info->step_counts[new_struct_nr] = -1;
+  }
+  for (int old_struct_nr = 0; old_struct_nr < oldsdna->structs_len; old_struct_nr++) {
+    reconstruct_info->new_struct_nr_from_old[old_struct_nr] = -2;
   }
 
   return reconstruct_info;
@@ -1565,6 +1606,7 @@ void DNA_reconstruct_info_free(DNA_ReconstructInfo *reconstruct_info)
   }
   MEM_freeN(reconstruct_info->steps);
   MEM_freeN(reconstruct_info->step_counts);
+  MEM_freeN(reconstruct_info->new_struct_nr_from_old);
   MEM_freeN(reconstruct_info);
 }
 
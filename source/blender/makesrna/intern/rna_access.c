@@ -4355,6 +4355,17 @@ static int rna_raw_access(ReportList *reports,
 
         size = RNA_raw_type_sizeof(out.type) * arraylen;
 
+        /* The items only contain this property, copy everything at once. */
+        if (out.stride == size) {
+          if (set) {
+            memcpy(outp, inp, (size_t)size * out.len);
+          }
+          else {
+            memcpy(inp, outp, (size_t)size * out.len);
+          }
+          return 1;
+        }
+
         for (a = 0; a < out.len; a++) {
           if (set) {
             memcpy(outp, inp, size);
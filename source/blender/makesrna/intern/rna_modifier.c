@@ -732,7 +732,8 @@ static char *rna_Modifier_path(PointerRNA *ptr)
 
 static void rna_Modifier_update(Main *UNUSED(bmain), Scene *UNUSED(scene), PointerRNA *ptr)
 {
-  DEG_id_tag_update(ptr->owner_id, ID_RECALC_GEOMETRY);
+  /* Modifier settings don't change the object data, so its evaluated copy can be kept. */
+  DEG_id_tag_update_object_settings(ptr->owner_id, ID_RECALC_GEOMETRY);
   WM_main_add_notifier(NC_OBJECT | ND_MODIFIER, ptr->owner_id);
 }
 
@@ -2541,6 +2542,28 @@ static void rna_def_modifier_armature(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Invert", "Invert vertex group influence");
   RNA_def_property_update(prop, 0, "rna_Modifier_update");
 
+  prop = RNA_def_property(srna, "use_cache_frames", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", MOD_ARMATURE_CACHE_FRAMES);
+  RNA_def_property_ui_text(prop,
+                           "Cache Frames",
+                           "Keep the deformed positions of every frame, to play them back without "
+                           "deforming again. Positions are stored with 16 bits precision within "
+                           "the bounds of the frame. The cache is cleared when the modifier is "
+                           "evaluated again on the same frame, e.g. after a change");
+  RNA_def_property_update(prop, 0, "rna_Modifier_update");
+
+  /* Changing the size doesn't change the result, so it doesn't tag an update (which would clear
+   * the cache). It is read from the original modifier on the next evaluation. */
+  prop = RNA_def_property(srna, "cache_memory_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "cache_memory_limit");
+  RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE);
+  RNA_def_property_range(prop, 0, INT_MAX);
+  RNA_def_property_ui_range(prop, 0, 65536, 256, -1);
+  RNA_def_property_ui_text(prop,
+                           "Cache Memory Limit",
+                           "Size in megabytes of the cached frames, the least recently used "
+                           "frames are removed when it is exceeded (0 means no limit)");
+
   RNA_define_lib_overridable(false);
 }
 
@@ -6940,6 +6963,46 @@ static void rna_def_modifier_nodes(BlenderRNA *brna)
   RNA_def_property_flag(prop, PROP_EDITABLE);
   RNA_def_property_update(prop, 0, "rna_NodesModifier_node_group_update");
 
+  prop = RNA_def_property(srna, "use_cache_node_results", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", MOD_NODES_CACHE_NODE_RESULTS);
+  RNA_def_property_ui_text(prop,
+                           "Cache Node Results",
+                           "Keep the results of nodes between evaluations, so that only nodes "
+                           "whose inputs changed have to be computed again (uses more memory)");
+  RNA_def_property_update(prop, 0, "rna_Modifier_update");
+
+  prop = RNA_def_property(srna, "use_cache_frames", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", MOD_NODES_CACHE_FRAMES);
+  RNA_def_property_ui_text(prop,
+                           "Cache Frames",
+                           "Keep the resulting geometry of every frame, to play it back without "
+                           "evaluating the node group again. The cache is cleared when the "
+                           "modifier is evaluated again on the same frame, e.g. after a change");
+  RNA_def_property_update(prop, 0, "rna_Modifier_update");
+
+  /* Changing the cache location or size doesn't change the result, so these don't tag an update
+   * (which would clear the cache). They are read from the original modifier on the next
+   * evaluation. */
+  prop = RNA_def_property(srna, "cache_directory", PROP_STRING, PROP_DIRPATH);
+  RNA_def_property_string_sdna(prop, NULL, "cache_directory");
+  RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE);
+  RNA_def_property_ui_text(prop,
+                           "Cache Directory",
+                           "Directory to write cached frames to in the background, frames that "
+                           "already exist in it are used. When empty, frames are only kept in "
+                           "memory. Meshes, point clouds and curves without materials are written");
+
+  prop = RNA_def_property(srna, "cache_memory_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "cache_memory_limit");
+  RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE);
+  RNA_def_property_range(prop, 0, INT_MAX);
+  RNA_def_property_ui_range(prop, 0, 65536, 256, -1);
+  RNA_def_property_ui_text(prop,
+                           "Cache Memory Limit",
+                           "Size in megabytes of the frames that are kept in memory, frames that "
+                           "were written to the cache directory are read again when needed "
+                           "(0 means no limit)");
+
   RNA_define_lib_overridable(false);
 }
 
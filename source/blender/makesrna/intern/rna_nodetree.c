@@ -2575,6 +2575,27 @@ static void rna_Node_dimensions_get(PointerRNA *ptr, float *value)
   value[1] = node->totr.ymax - node->totr.ymin;
 }
 
+static const bNodeExecutionStats *rna_Node_execution_stats(PointerRNA *ptr)
+{
+  bNodeTree *ntree = (bNodeTree *)ptr->owner_id;
+  bNode *node = ptr->data;
+  /* Statistics are only stored in base trees, for their own nodes keyed from the base key. */
+  return BKE_node_execution_stats_get(ntree,
+                                      BKE_node_instance_key(NODE_INSTANCE_KEY_BASE, ntree, node));
+}
+
+static float rna_Node_execution_time_get(PointerRNA *ptr)
+{
+  const bNodeExecutionStats *stats = rna_Node_execution_stats(ptr);
+  return stats ? stats->time_us / 1000.0f : 0.0f;
+}
+
+static int rna_Node_execution_memory_get(PointerRNA *ptr)
+{
+  const bNodeExecutionStats *stats = rna_Node_execution_stats(ptr);
+  return stats ? (int)MIN2(stats->mem_size / 1024, (uint64_t)INT_MAX) : 0;
+}
+
 /* ******** Node Socket ******** */
 
 static void rna_NodeSocket_draw(
@@ -11781,6 +11802,24 @@ static void rna_def_node(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Dimensions", "Absolute bounding box dimensions of the node");
   RNA_def_property_clear_flag(prop, PROP_EDITABLE);
 
+  prop = RNA_def_property(srna, "execution_time", PROP_FLOAT, PROP_NONE);
+  RNA_def_property_float_funcs(prop, "rna_Node_execution_time_get", NULL, NULL);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_ui_text(prop,
+                           "Execution Time",
+                           "Time in milliseconds spent executing the node in the latest "
+                           "compositor execution, for nodes of a scene compositing node tree. "
+                           "Group nodes include the time of their sub-nodes");
+
+  prop = RNA_def_property(srna, "execution_memory", PROP_INT, PROP_NONE);
+  RNA_def_property_int_funcs(prop, "rna_Node_execution_memory_get", NULL, NULL);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_ui_text(prop,
+                           "Execution Memory",
+                           "Memory in kilobytes of the node results in the latest compositor "
+                           "execution, for nodes of a scene compositing node tree. Group nodes "
+                           "include the memory of their sub-nodes");
+
   prop = RNA_def_property(srna, "name", PROP_STRING, PROP_NONE);
   RNA_def_property_ui_text(prop, "Name", "Unique node identifier");
   RNA_def_struct_name_property(srna, prop);
@@ -12418,6 +12457,13 @@ static void rna_def_composite_nodetree(BlenderRNA *brna)
   RNA_def_property_boolean_sdna(prop, NULL, "flag", NTREE_COM_OPENCL);
   RNA_def_property_ui_text(prop, "OpenCL", "Enable GPU calculations");
 
+  prop = RNA_def_property(srna, "use_gpu", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", NTREE_COM_GPU);
+  RNA_def_property_ui_text(prop,
+                           "GPU",
+                           "Render supported operations on the GPU, keeping their results in GPU "
+                           "memory (Full Frame execution mode only)");
+
   prop = RNA_def_property(srna, "use_groupnode_buffer", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "flag", NTREE_COM_GROUPNODE_BUFFER);
   RNA_def_property_ui_text(prop, "Buffer Groups", "Enable buffering of group nodes");
@@ -969,6 +969,14 @@ static void rna_def_render_engine(BlenderRNA *brna)
   RNA_def_property_ui_text(
       prop, "Use Alembic Procedural", "Support loading Alembic data at render time");
 
+  prop = RNA_def_property(srna, "bl_use_shared_scene_data", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "type->flag", RE_USE_SHARED_SCENE_DATA);
+  RNA_def_property_flag(prop, PROP_REGISTER_OPTIONAL);
+  RNA_def_property_ui_text(prop,
+                           "Use Shared Scene Data",
+                           "Keep the dependency graph between view layers of the same frame, "
+                           "so the engine can reuse its scene data for all of them");
+
   RNA_define_verify_sdna(1);
 }
 
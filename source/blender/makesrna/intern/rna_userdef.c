@@ -5524,6 +5524,13 @@ static void rna_def_userdef_system(BlenderRNA *brna)
   RNA_def_property_enum_sdna(prop, NULL, "sequencer_proxy_setup");
   RNA_def_property_ui_text(prop, "Proxy Setup", "When and how proxies are created");
 
+  prop = RNA_def_property(srna, "use_hardware_video_decoding", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", USER_FFMPEG_HW_DECODING);
+  RNA_def_property_ui_text(prop,
+                           "Hardware Video Decoding",
+                           "Decode movies with the GPU video decoder when supported by the "
+                           "codec and the system, only affects movies opened afterwards");
+
   prop = RNA_def_property(srna, "scrollback", PROP_INT, PROP_UNSIGNED);
   RNA_def_property_int_sdna(prop, NULL, "scrollback");
   RNA_def_property_range(prop, 32, 32768);
@@ -5619,6 +5626,15 @@ static void rna_def_userdef_system(BlenderRNA *brna)
       "Time since last access of a GL texture in seconds after which it is freed "
       "(set to 0 to keep textures allocated)");
 
+  prop = RNA_def_property(srna, "texture_memory_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "texture_memory_limit");
+  RNA_def_property_range(prop, 0, INT_MAX);
+  RNA_def_property_ui_range(prop, 0, 65536, 256, -1);
+  RNA_def_property_ui_text(prop,
+                           "Texture Memory Limit",
+                           "Graphics memory in megabytes that image textures can use before the "
+                           "least recently used ones are freed (set to 0 for no limit)");
+
   prop = RNA_def_property(srna, "texture_collection_rate", PROP_INT, PROP_NONE);
   RNA_def_property_int_sdna(prop, NULL, "texcollectrate");
   RNA_def_property_range(prop, 1, 3600);
@@ -6372,6 +6388,21 @@ static void rna_def_userdef_experimental(BlenderRNA *brna)
       "Undo Legacy",
       "Use legacy undo (slower than the new default one, but may be more stable in some cases)");
 
+  prop = RNA_def_property(srna, "use_undo_skip_unchanged_ids", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_undo_skip_unchanged_ids", 1);
+  RNA_def_property_ui_text(prop,
+                           "Undo Skip Unchanged Data",
+                           "Reuse the undo memory of objects, meshes and materials that have not "
+                           "been changed since the previous undo step instead of storing them "
+                           "again (faster undo pushes in large scenes)");
+
+  prop = RNA_def_property(srna, "use_undo_compression", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_undo_compression", 1);
+  RNA_def_property_ui_text(prop,
+                           "Undo Compression",
+                           "Compress the memory of older global undo steps, to allow keeping more "
+                           "steps within the undo memory limit");
+
   prop = RNA_def_property(srna, "override_auto_resync", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_negative_sdna(prop, NULL, "no_override_auto_resync", 1);
   RNA_def_property_ui_text(
@@ -7,7 +7,9 @@
 
 #include <string.h>
 
+#include "BLI_ghash.h"
 #include "BLI_listbase.h"
+#include "BLI_math_vector.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -66,8 +68,205 @@ static void copyData(const ModifierData *md, ModifierData *target, const int fla
 
   BKE_modifier_copydata_generic(md, target, flag);
   tamd->vert_coords_prev = NULL;
+  tamd->runtime_frame_cache = NULL;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Frame Cache
+ *
+ * Deformed positions of every frame, so that playing back animation that was played before
+ * doesn't deform the mesh again. Positions are quantized to 16 bits per axis within the bounds
+ * of the frame, which halves the memory and is well below the display precision.
+ *
+ * There is no way to know which inputs changed, so like the point cache, the cache is outdated
+ * when the modifier is evaluated again on the same frame, e.g. after editing the pose.
+ * \{ */
+
+#define FRAME_CACHE_QUANTIZE_MAX 65535.0f
+
+typedef struct ArmatureCacheFrame {
+  float min[3];
+  float step[3];
+  int verts_num;
+  uint64_t last_used;
+  ushort (*co)[3];
+} ArmatureCacheFrame;
+
+typedef struct ArmatureFrameCache {
+  /** #ArmatureCacheFrame by frame number. */
+  GHash *frames;
+  size_t memory_size;
+  uint64_t use_counter;
+  int last_evaluated_frame;
+  bool has_last_evaluated_frame;
+} ArmatureFrameCache;
+
+static size_t cache_frame_size(const ArmatureCacheFrame *cache_frame)
+{
+  return sizeof(*cache_frame) + sizeof(*cache_frame->co) * (size_t)cache_frame->verts_num;
+}
+
+static void cache_frame_free(void *cache_frame_v)
+{
+  ArmatureCacheFrame *cache_frame = cache_frame_v;
+  MEM_freeN(cache_frame->co);
+  MEM_freeN(cache_frame);
+}
+
+static void frame_cache_clear(ArmatureFrameCache *frame_cache)
+{
+  BLI_ghash_clear(frame_cache->frames, NULL, cache_frame_free);
+  frame_cache->memory_size = 0;
+}
+
+static void frame_cache_free(ArmatureModifierData *amd)
+{
+  ArmatureFrameCache *frame_cache = amd->runtime_frame_cache;
+  if (frame_cache != NULL) {
+    BLI_ghash_free(frame_cache->frames, NULL, cache_frame_free);
+    MEM_freeN(frame_cache);
+    amd->runtime_frame_cache = NULL;
+  }
+}
+
+/**
+ * Like the geometry nodes frame cache, the cache is stored on the original modifier and only used
+ * for the active depsgraph. Sub-frames (e.g. for motion blur) are not cached.
+ */
+static ArmatureFrameCache *frame_cache_get(ArmatureModifierData *amd,
+                                           const ModifierEvalContext *ctx,
+                                           int *r_frame)
+{
+  if (!DEG_is_active(ctx->depsgraph)) {
+    return NULL;
+  }
+  ArmatureModifierData *amd_orig = (ArmatureModifierData *)BKE_modifier_get_original(
+      ctx->object, &amd->modifier);
+  if (amd_orig == NULL) {
+    return NULL;
+  }
+  if (!(amd->flag & MOD_ARMATURE_CACHE_FRAMES)) {
+    frame_cache_free(amd_orig);
+    return NULL;
+  }
+  const float ctime = DEG_get_ctime(ctx->depsgraph);
+  if (ctime != floorf(ctime)) {
+    return NULL;
+  }
+  if (amd_orig->runtime_frame_cache == NULL) {
+    ArmatureFrameCache *frame_cache = MEM_callocN(sizeof(*frame_cache), __func__);
+    frame_cache->frames = BLI_ghash_int_new(__func__);
+    amd_orig->runtime_frame_cache = frame_cache;
+  }
+  ArmatureFrameCache *frame_cache = amd_orig->runtime_frame_cache;
+
+  const int frame = (int)ctime;
+  if (frame_cache->has_last_evaluated_frame && frame_cache->last_evaluated_frame == frame) {
+    frame_cache_clear(frame_cache);
+  }
+  frame_cache->last_evaluated_frame = frame;
+  frame_cache->has_last_evaluated_frame = true;
+
+  *r_frame = frame;
+  return frame_cache;
+}
+
+static bool frame_cache_lookup(ArmatureFrameCache *frame_cache,
+                               const int frame,
+                               float (*vert_coords)[3],
+                               const int verts_num)
+{
+  ArmatureCacheFrame *cache_frame = BLI_ghash_lookup(frame_cache->frames, POINTER_FROM_INT(frame));
+  if (cache_frame == NULL) {
+    return false;
+  }
+  if (cache_frame->verts_num != verts_num) {
+    /* The topology changed, so all frames are outdated. */
+    frame_cache_clear(frame_cache);
+    return false;
+  }
+  cache_frame->last_used = ++frame_cache->use_counter;
+
+  for (int i = 0; i < verts_num; i++) {
+    for (int axis = 0; axis < 3; axis++) {
+      vert_coords[i][axis] = cache_frame->min[axis] +
+                             (float)cache_frame->co[i][axis] * cache_frame->step[axis];
+    }
+  }
+  return true;
+}
+
+static void frame_cache_free_over_limit(ArmatureFrameCache *frame_cache,
+                                        const size_t memory_limit,
+                                        const int frame_to_keep)
+{
+  while (frame_cache->memory_size > memory_limit) {
+    int oldest_frame = frame_to_keep;
+    uint64_t oldest_use = UINT64_MAX;
+    GHashIterator gh_iter;
+    GHASH_ITER (gh_iter, frame_cache->frames) {
+      const int frame = POINTER_AS_INT(BLI_ghashIterator_getKey(&gh_iter));
+      const ArmatureCacheFrame *cache_frame = BLI_ghashIterator_getValue(&gh_iter);
+      if (frame != frame_to_keep && cache_frame->last_used < oldest_use) {
+        oldest_frame = frame;
+        oldest_use = cache_frame->last_used;
+      }
+    }
+    if (oldest_frame == frame_to_keep) {
+      break;
+    }
+    ArmatureCacheFrame *cache_frame = BLI_ghash_popkey(
+        frame_cache->frames, POINTER_FROM_INT(oldest_frame), NULL);
+    frame_cache->memory_size -= cache_frame_size(cache_frame);
+    cache_frame_free(cache_frame);
+  }
+}
+
+static void frame_cache_add(ArmatureFrameCache *frame_cache,
+                            const size_t memory_limit,
+                            const int frame,
+                            const float (*vert_coords)[3],
+                            const int verts_num)
+{
+  ArmatureCacheFrame *cache_frame = MEM_callocN(sizeof(*cache_frame), __func__);
+  cache_frame->verts_num = verts_num;
+  cache_frame->last_used = ++frame_cache->use_counter;
+  cache_frame->co = MEM_malloc_arrayN((size_t)verts_num, sizeof(*cache_frame->co), __func__);
+
+  float max[3];
+  INIT_MINMAX(cache_frame->min, max);
+  for (int i = 0; i < verts_num; i++) {
+    minmax_v3v3_v3(cache_frame->min, max, vert_coords[i]);
+  }
+  float scale[3];
+  for (int axis = 0; axis < 3; axis++) {
+    const float extent = (verts_num > 0) ? max[axis] - cache_frame->min[axis] : 0.0f;
+    cache_frame->step[axis] = extent / FRAME_CACHE_QUANTIZE_MAX;
+    scale[axis] = (extent > 0.0f) ? FRAME_CACHE_QUANTIZE_MAX / extent : 0.0f;
+  }
+  for (int i = 0; i < verts_num; i++) {
+    for (int axis = 0; axis < 3; axis++) {
+      const float value = (vert_coords[i][axis] - cache_frame->min[axis]) * scale[axis] + 0.5f;
+      cache_frame->co[i][axis] = (ushort)clamp_f(value, 0.0f, FRAME_CACHE_QUANTIZE_MAX);
+    }
+  }
+
+  void **cache_frame_p;
+  if (BLI_ghash_ensure_p(frame_cache->frames, POINTER_FROM_INT(frame), &cache_frame_p)) {
+    ArmatureCacheFrame *cache_frame_old = *cache_frame_p;
+    frame_cache->memory_size -= cache_frame_size(cache_frame_old);
+    cache_frame_free(cache_frame_old);
+  }
+  *cache_frame_p = cache_frame;
+  frame_cache->memory_size += cache_frame_size(cache_frame);
+
+  if (memory_limit != 0) {
+    frame_cache_free_over_limit(frame_cache, memory_limit, frame);
+  }
+}
+
+/** \} */
+
 static void requiredDataMask(Object *UNUSED(ob),
                              ModifierData *UNUSED(md),
                              CustomData_MeshMasks *r_cddata_masks)
@@ -128,15 +327,14 @@ static void updateDepsgraph(ModifierData *md, const ModifierUpdateDepsgraphConte
   DEG_add_modifier_to_transform_relation(ctx->node, "Armature Modifier");
 }
 
-static void deformVerts(ModifierData *md,
-                        const ModifierEvalContext *ctx,
-                        Mesh *mesh,
-                        float (*vertexCos)[3],
-                        int numVerts)
+static void armature_deform_verts(ArmatureModifierData *amd,
+                                  const ModifierEvalContext *ctx,
+                                  Mesh *mesh,
+                                  float (*vertexCos)[3],
+                                  int numVerts)
 {
-  ArmatureModifierData *amd = (ArmatureModifierData *)md;
-
-  MOD_previous_vcos_store(md, vertexCos); /* if next modifier needs original vertices */
+  /* if next modifier needs original vertices */
+  MOD_previous_vcos_store(&amd->modifier, vertexCos);
 
   BKE_armature_deform_coords_with_mesh(amd->object,
                                        ctx->object,
@@ -152,6 +350,38 @@ static void deformVerts(ModifierData *md,
   MEM_SAFE_FREE(amd->vert_coords_prev);
 }
 
+static void deformVerts(ModifierData *md,
+                        const ModifierEvalContext *ctx,
+                        Mesh *mesh,
+                        float (*vertexCos)[3],
+                        int numVerts)
+{
+  ArmatureModifierData *amd = (ArmatureModifierData *)md;
+
+  int cache_frame = 0;
+  ArmatureFrameCache *frame_cache = frame_cache_get(amd, ctx, &cache_frame);
+  if (frame_cache != NULL) {
+    MOD_previous_vcos_store(md, vertexCos); /* if next modifier needs original vertices */
+    if (frame_cache_lookup(frame_cache, cache_frame, vertexCos, numVerts)) {
+      MEM_SAFE_FREE(amd->vert_coords_prev);
+      return;
+    }
+  }
+
+  armature_deform_verts(amd, ctx, mesh, vertexCos, numVerts);
+
+  if (frame_cache != NULL) {
+    /* The memory limit doesn't tag an update, so read it from the original. */
+    const ArmatureModifierData *amd_orig = (const ArmatureModifierData *)
+        BKE_modifier_get_original(ctx->object, md);
+    frame_cache_add(frame_cache,
+                    (size_t)amd_orig->cache_memory_limit * 1024 * 1024,
+                    cache_frame,
+                    (const float(*)[3])vertexCos,
+                    numVerts);
+  }
+}
+
 static void deformVertsEM(ModifierData *md,
                           const ModifierEvalContext *ctx,
                           struct BMEditMesh *em,
@@ -159,13 +389,14 @@ static void deformVertsEM(ModifierData *md,
                           float (*vertexCos)[3],
                           int numVerts)
 {
+  ArmatureModifierData *amd = (ArmatureModifierData *)md;
+
+  /* The frame cache isn't used in edit-mode, where the mesh changes all the time. */
   if (mesh != NULL) {
-    deformVerts(md, ctx, mesh, vertexCos, numVerts);
+    armature_deform_verts(amd, ctx, mesh, vertexCos, numVerts);
     return;
   }
 
-  ArmatureModifierData *amd = (ArmatureModifierData *)md;
-
   MOD_previous_vcos_store(md, vertexCos); /* if next modifier needs original vertices */
 
   BKE_armature_deform_coords_with_editmesh(amd->object,
@@ -249,6 +480,12 @@ static void panel_draw(const bContext *UNUSED(C), Panel *panel)
   uiItemR(col, ptr, "use_vertex_groups", 0, IFACE_("Vertex Groups"), ICON_NONE);
   uiItemR(col, ptr, "use_bone_envelopes", 0, IFACE_("Bone Envelopes"), ICON_NONE);
 
+  col = uiLayoutColumn(layout, false);
+  uiItemR(col, ptr, "use_cache_frames", 0, NULL, ICON_NONE);
+  if (RNA_boolean_get(ptr, "use_cache_frames")) {
+    uiItemR(col, ptr, "cache_memory_limit", 0, NULL, ICON_NONE);
+  }
+
   modifier_panel_end(layout, ptr);
 }
 
@@ -262,6 +499,14 @@ static void blendRead(BlendDataReader *UNUSED(reader), ModifierData *md)
   ArmatureModifierData *amd = (ArmatureModifierData *)md;
 
   amd->vert_coords_prev = NULL;
+  amd->runtime_frame_cache = NULL;
+}
+
+static void freeData(ModifierData *md)
+{
+  ArmatureModifierData *amd = (ArmatureModifierData *)md;
+
+  frame_cache_free(amd);
 }
 
 ModifierTypeInfo modifierType_Armature = {
@@ -285,7 +530,7 @@ ModifierTypeInfo modifierType_Armature = {
 
     /* initData */ initData,
     /* requiredDataMask */ requiredDataMask,
-    /* freeData */ NULL,
+    /* freeData */ freeData,
     /* isDisabled */ isDisabled,
     /* updateDepsgraph */ updateDepsgraph,
     /* dependsOnTime */ NULL,
@@ -11,8 +11,12 @@
 
 #include "BLI_array.hh"
 #include "BLI_float4x4.hh"
+#include "BLI_map.hh"
 #include "BLI_math_geom.h"
 #include "BLI_math_matrix.h"
+#include "BLI_math_vector.h"
+#include "BLI_sort.h"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "BLT_translation.h"
@@ -25,8 +29,10 @@
 #include "DNA_scene_types.h"
 #include "DNA_screen_types.h"
 
+#include "BKE_bvhutils.h"
 #include "BKE_collection.h"
 #include "BKE_context.h"
+#include "BKE_customdata.h"
 #include "BKE_global.h" /* only to check G.debug */
 #include "BKE_lib_id.h"
 #include "BKE_lib_query.h"
@@ -62,6 +68,9 @@
 
 using blender::Array;
 using blender::float4x4;
+using blender::IndexRange;
+using blender::Map;
+using blender::Span;
 using blender::Vector;
 
 static void initData(ModifierData *md)
@@ -260,13 +269,18 @@ static BMesh *BMD_mesh_bm_create(
   return bm;
 }
 
+/**
+ * \param ray_hits_fn: Optional, see #BM_mesh_intersect.
+ */
 static void BMD_mesh_intersection(BMesh *bm,
                                   ModifierData *md,
                                   const ModifierEvalContext *ctx,
                                   Mesh *mesh_operand_ob,
                                   Object *object,
                                   Object *operand_ob,
-                                  bool is_flip)
+                                  bool is_flip,
+                                  int (*ray_hits_fn)(const float co[3], int side, void *user_data),
+                                  void *ray_hits_data)
 {
 #ifdef DEBUG_TIME
   SCOPED_TIMER(__func__)
@@ -359,7 +373,8 @@ static void BMD_mesh_intersection(BMesh *bm,
                     looptris,
                     looptris_tot,
                     bm_face_isect_pair,
-                    nullptr,
+                    ray_hits_fn,
+                    ray_hits_data,
                     false,
                     use_separate,
                     use_dissolve,
@@ -372,6 +387,449 @@ static void BMD_mesh_intersection(BMesh *bm,
   MEM_freeN(looptris);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Boolean Region
+ *
+ * When the operand only overlaps a small part of a large mesh (e.g. while dragging a cutter
+ * over it), only the faces near the operand are converted to BMesh and intersected. Faces whose
+ * bounds don't overlap the operand can't be cut and are copied to the result directly.
+ *
+ * Islands of the operand still have to be classified as inside or outside of the whole mesh,
+ * they are ray-cast against the BVH tree of the whole mesh, which is kept in its runtime cache.
+ * \{ */
+
+/** Smaller meshes are fast enough to intersect as a whole. */
+#define BOOLEAN_REGION_MIN_POLYS 1024
+
+/** Vertex layer with the index (plus one) of boundary vertices in the original mesh. */
+#define BOOLEAN_REGION_VERT_LAYER "__boolean_region_vert"
+
+struct BooleanRegion {
+  /** Polygons with bounds overlapping the operand, which are intersected. */
+  Array<bool> poly_is_near;
+  /** Vertices and edges of polygons that aren't near, or loose elements. */
+  Array<bool> vert_is_far;
+  Array<bool> edge_is_far;
+  /** Far vertices which are also used by near polygons. */
+  Array<bool> vert_is_boundary;
+  int near_polys_num;
+};
+
+static bool boolean_region_calc(const Mesh *mesh,
+                                Object *object,
+                                const Mesh *mesh_operand,
+                                Object *operand_ob,
+                                const float double_threshold,
+                                BooleanRegion &region)
+{
+  if (mesh->totpoly < BOOLEAN_REGION_MIN_POLYS) {
+    return false;
+  }
+
+  /* Bounds of the operand in the space of the mesh. */
+  float imat[4][4];
+  float omat[4][4];
+  invert_m4_m4(imat, object->obmat);
+  mul_m4_m4m4(omat, imat, operand_ob->obmat);
+
+  float min[3], max[3];
+  INIT_MINMAX(min, max);
+  for (const int i : IndexRange(mesh_operand->totvert)) {
+    float co[3];
+    mul_v3_m4v3(co, omat, mesh_operand->mvert[i].co);
+    minmax_v3v3_v3(min, max, co);
+  }
+  /* Pad by more than the margin used by #BM_mesh_intersect, and by the precision of the
+   * coordinates, so that faces outside of the bounds are certainly not cut. */
+  const float pad = max_ff(double_threshold * 40.0f,
+                           (len_v3v3(min, max) + max_ff(len_v3(min), len_v3(max))) * 1e-5f);
+  const float pad_v[3] = {pad, pad, pad};
+  sub_v3_v3(min, pad_v);
+  add_v3_v3(max, pad_v);
+
+  region.poly_is_near.reinitialize(mesh->totpoly);
+  const Span<MVert> verts(mesh->mvert, mesh->totvert);
+  const Span<MLoop> loops(mesh->mloop, mesh->totloop);
+  const Span<MPoly> polys(mesh->mpoly, mesh->totpoly);
+  blender::threading::parallel_for(polys.index_range(), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      const MPoly &poly = polys[i];
+      float poly_min[3], poly_max[3];
+      INIT_MINMAX(poly_min, poly_max);
+      for (const MLoop &loop : loops.slice(poly.loopstart, poly.totloop)) {
+        minmax_v3v3_v3(poly_min, poly_max, verts[loop.v].co);
+      }
+      region.poly_is_near[i] = isect_aabb_aabb_v3(min, max, poly_min, poly_max);
+    }
+  });
+
+  region.near_polys_num = 0;
+  for (const bool is_near : region.poly_is_near) {
+    region.near_polys_num += is_near;
+  }
+  /* When nothing is near, operand islands inside of the mesh still have to be kept, the full
+   * boolean handles that. When most of the mesh is near, there is nothing to gain. */
+  if (region.near_polys_num == 0 || region.near_polys_num > mesh->totpoly / 2) {
+    return false;
+  }
+
+  Array<bool> vert_is_near(mesh->totvert, false);
+  Array<bool> edge_is_near(mesh->totedge, false);
+  region.vert_is_far.reinitialize(mesh->totvert);
+  region.edge_is_far.reinitialize(mesh->totedge);
+  region.vert_is_far.fill(false);
+  region.edge_is_far.fill(false);
+  for (const int i : polys.index_range()) {
+    const MPoly &poly = polys[i];
+    Array<bool> &vert_used = region.poly_is_near[i] ? vert_is_near : region.vert_is_far;
+    Array<bool> &edge_used = region.poly_is_near[i] ? edge_is_near : region.edge_is_far;
+    for (const MLoop &loop : loops.slice(poly.loopstart, poly.totloop)) {
+      vert_used[loop.v] = true;
+      edge_used[loop.e] = true;
+    }
+  }
+  region.vert_is_boundary.reinitialize(mesh->totvert);
+  for (const int i : verts.index_range()) {
+    region.vert_is_boundary[i] = region.vert_is_far[i] && vert_is_near[i];
+    /* Loose vertices are kept as they are. */
+    region.vert_is_far[i] = region.vert_is_far[i] || !vert_is_near[i];
+  }
+  for (const int i : IndexRange(mesh->totedge)) {
+    region.edge_is_far[i] = region.edge_is_far[i] || !edge_is_near[i];
+  }
+  return true;
+}
+
+/**
+ * Copy elements of \a src to consecutive elements of \a dst starting at \a dst_start,
+ * copying runs of consecutive indices at once.
+ */
+static void boolean_region_copy_data(const CustomData *src,
+                                     CustomData *dst,
+                                     const Span<int> src_indices,
+                                     const int dst_start,
+                                     const bool same_layers)
+{
+  int run_start = 0;
+  for (const int i : src_indices.index_range()) {
+    const bool run_ends = (i + 1 == src_indices.size()) ||
+                          (src_indices[i + 1] != src_indices[i] + 1);
+    if (run_ends) {
+      const int count = i + 1 - run_start;
+      if (same_layers) {
+        CustomData_copy_data(src, dst, src_indices[run_start], dst_start + run_start, count);
+      }
+      else {
+        CustomData_copy_data_named(
+            src, dst, src_indices[run_start], dst_start + run_start, count);
+      }
+      run_start = i + 1;
+    }
+  }
+}
+
+/**
+ * Create a mesh with the near polygons of \a mesh, with a #BOOLEAN_REGION_VERT_LAYER layer
+ * to find the boundary vertices in the result.
+ */
+static Mesh *boolean_region_mesh_create(const Mesh *mesh, const BooleanRegion &region)
+{
+  Array<int> vert_map(mesh->totvert, -1);
+  Array<int> edge_map(mesh->totedge, -1);
+  Vector<int> verts;
+  Vector<int> edges;
+  Vector<int> loops;
+  Vector<int> polys;
+  polys.reserve(region.near_polys_num);
+  for (const int i : IndexRange(mesh->totpoly)) {
+    if (!region.poly_is_near[i]) {
+      continue;
+    }
+    const MPoly &poly = mesh->mpoly[i];
+    polys.append(i);
+    for (const int loop_i : IndexRange(poly.loopstart, poly.totloop)) {
+      const MLoop &loop = mesh->mloop[loop_i];
+      loops.append(loop_i);
+      if (vert_map[loop.v] == -1) {
+        vert_map[loop.v] = verts.append_and_get_index(loop.v);
+      }
+      if (edge_map[loop.e] == -1) {
+        edge_map[loop.e] = edges.append_and_get_index(loop.e);
+      }
+    }
+  }
+
+  Mesh *result = BKE_mesh_new_nomain_from_template(
+      mesh, verts.size(), edges.size(), 0, loops.size(), polys.size());
+  boolean_region_copy_data(&mesh->vdata, &result->vdata, verts, 0, true);
+  boolean_region_copy_data(&mesh->edata, &result->edata, edges, 0, true);
+  boolean_region_copy_data(&mesh->ldata, &result->ldata, loops, 0, true);
+  boolean_region_copy_data(&mesh->pdata, &result->pdata, polys, 0, true);
+
+  for (MEdge &edge : blender::MutableSpan(result->medge, result->totedge)) {
+    edge.v1 = vert_map[edge.v1];
+    edge.v2 = vert_map[edge.v2];
+  }
+  for (MLoop &loop : blender::MutableSpan(result->mloop, result->totloop)) {
+    loop.v = vert_map[loop.v];
+    loop.e = edge_map[loop.e];
+  }
+  int loopstart = 0;
+  for (MPoly &poly : blender::MutableSpan(result->mpoly, result->totpoly)) {
+    poly.loopstart = loopstart;
+    loopstart += poly.totloop;
+  }
+
+  int *boundary_verts = (int *)CustomData_add_layer_named(&result->vdata,
+                                                          CD_PROP_INT32,
+                                                          CD_CALLOC,
+                                                          nullptr,
+                                                          result->totvert,
+                                                          BOOLEAN_REGION_VERT_LAYER);
+  for (const int i : verts.index_range()) {
+    if (region.vert_is_boundary[verts[i]]) {
+      boundary_verts[i] = verts[i] + 1;
+    }
+  }
+
+  BKE_mesh_normals_tag_dirty(result);
+  return result;
+}
+
+/**
+ * Join the far elements of \a mesh with the intersected near polygons in \a result_near,
+ * merging the boundary vertices and edges.
+ */
+static Mesh *boolean_region_mesh_join(const Mesh *mesh,
+                                      const BooleanRegion &region,
+                                      Mesh *result_near)
+{
+  const int layer_index = CustomData_get_named_layer_index(
+      &result_near->vdata, CD_PROP_INT32, BOOLEAN_REGION_VERT_LAYER);
+  Array<int> boundary_verts(result_near->totvert, 0);
+  if (layer_index != -1) {
+    boundary_verts.as_mutable_span().copy_from(
+        Span((const int *)result_near->vdata.layers[layer_index].data, result_near->totvert));
+    CustomData_free_layer(&result_near->vdata, CD_PROP_INT32, result_near->totvert, layer_index);
+  }
+
+  /* Far elements come first, then the near elements that aren't merged with them. */
+  Vector<int> far_verts;
+  Array<int> vert_map(mesh->totvert, -1);
+  for (const int i : IndexRange(mesh->totvert)) {
+    if (region.vert_is_far[i]) {
+      vert_map[i] = far_verts.append_and_get_index(i);
+    }
+  }
+  Vector<int> near_verts;
+  Array<int> near_vert_map(result_near->totvert);
+  for (const int i : IndexRange(result_near->totvert)) {
+    const int orig_vert = boundary_verts[i] - 1;
+    if (orig_vert != -1 && region.vert_is_boundary[orig_vert]) {
+      near_vert_map[i] = vert_map[orig_vert];
+    }
+    else {
+      near_vert_map[i] = far_verts.size() + near_verts.append_and_get_index(i);
+    }
+  }
+
+  /* Edges between boundary vertices may exist on both sides. */
+  Vector<int> far_edges;
+  Array<int> edge_map(mesh->totedge, -1);
+  Map<std::pair<int, int>, int> boundary_edges;
+  for (const int i : IndexRange(mesh->totedge)) {
+    if (!region.edge_is_far[i]) {
+      continue;
+    }
+    const MEdge &edge = mesh->medge[i];
+    edge_map[i] = far_edges.append_and_get_index(i);
+    if (region.vert_is_boundary[edge.v1] && region.vert_is_boundary[edge.v2]) {
+      const int v1 = vert_map[edge.v1];
+      const int v2 = vert_map[edge.v2];
+      boundary_edges.add({std::min(v1, v2), std::max(v1, v2)}, edge_map[i]);
+    }
+  }
+  Vector<int> near_edges;
+  Array<int> near_edge_map(result_near->totedge);
+  for (const int i : IndexRange(result_near->totedge)) {
+    const MEdge &edge = result_near->medge[i];
+    const int v1 = near_vert_map[edge.v1];
+    const int v2 = near_vert_map[edge.v2];
+    const int far_edge = boundary_edges.lookup_default({std::min(v1, v2), std::max(v1, v2)}, -1);
+    near_edge_map[i] = (far_edge != -1) ? far_edge :
+                                          far_edges.size() + near_edges.append_and_get_index(i);
+  }
+
+  Vector<int> far_polys;
+  Vector<int> far_loops;
+  for (const int i : IndexRange(mesh->totpoly)) {
+    if (!region.poly_is_near[i]) {
+      const MPoly &poly = mesh->mpoly[i];
+      far_polys.append(i);
+      for (const int loop_i : IndexRange(poly.loopstart, poly.totloop)) {
+        far_loops.append(loop_i);
+      }
+    }
+  }
+
+  const int verts_num = far_verts.size() + near_verts.size();
+  const int edges_num = far_edges.size() + near_edges.size();
+  const int loops_num = far_loops.size() + result_near->totloop;
+  const int polys_num = far_polys.size() + result_near->totpoly;
+  Mesh *result = BKE_mesh_new_nomain_from_template(
+      result_near, verts_num, edges_num, 0, loops_num, polys_num);
+
+  boolean_region_copy_data(&mesh->vdata, &result->vdata, far_verts, 0, false);
+  boolean_region_copy_data(&mesh->edata, &result->edata, far_edges, 0, false);
+  boolean_region_copy_data(&mesh->ldata, &result->ldata, far_loops, 0, false);
+  boolean_region_copy_data(&mesh->pdata, &result->pdata, far_polys, 0, false);
+
+  boolean_region_copy_data(
+      &result_near->vdata, &result->vdata, near_verts, far_verts.size(), true);
+  boolean_region_copy_data(
+      &result_near->edata, &result->edata, near_edges, far_edges.size(), true);
+  CustomData_copy_data(
+      &result_near->ldata, &result->ldata, 0, far_loops.size(), result_near->totloop);
+  CustomData_copy_data(
+      &result_near->pdata, &result->pdata, 0, far_polys.size(), result_near->totpoly);
+
+  for (const int i : IndexRange(edges_num)) {
+    MEdge &edge = result->medge[i];
+    const bool is_far = i < far_edges.size();
+    edge.v1 = is_far ? vert_map[edge.v1] : near_vert_map[edge.v1];
+    edge.v2 = is_far ? vert_map[edge.v2] : near_vert_map[edge.v2];
+  }
+  for (const int i : IndexRange(loops_num)) {
+    MLoop &loop = result->mloop[i];
+    const bool is_far = i < far_loops.size();
+    loop.v = is_far ? vert_map[loop.v] : near_vert_map[loop.v];
+    loop.e = is_far ? edge_map[loop.e] : near_edge_map[loop.e];
+  }
+  int loopstart = 0;
+  for (MPoly &poly : blender::MutableSpan(result->mpoly, result->totpoly)) {
+    poly.loopstart = loopstart;
+    loopstart += poly.totloop;
+  }
+
+  BKE_mesh_normals_tag_dirty(result);
+  return result;
+}
+
+struct BooleanRegionRayCast {
+  BVHTreeFromMesh treedata;
+  Vector<float> depths;
+};
+
+static void boolean_region_raycast_cb(void *userdata,
+                                      int index,
+                                      const BVHTreeRay *ray,
+                                      BVHTreeRayHit *UNUSED(hit))
+{
+  BooleanRegionRayCast *ray_cast = (BooleanRegionRayCast *)userdata;
+  const BVHTreeFromMesh &treedata = ray_cast->treedata;
+  const MLoopTri &looptri = treedata.looptri[index];
+  const float *v0 = treedata.vert[treedata.loop[looptri.tri[0]].v].co;
+  const float *v1 = treedata.vert[treedata.loop[looptri.tri[1]].v].co;
+  const float *v2 = treedata.vert[treedata.loop[looptri.tri[2]].v].co;
+  float dist;
+  if (isect_ray_tri_epsilon_v3(
+          ray->origin, ray->direction, v0, v1, v2, &dist, nullptr, FLT_EPSILON) &&
+      dist >= 0.0f) {
+    ray_cast->depths.append(dist);
+  }
+}
+
+/**
+ * Count the hits with the whole mesh instead of its near polygons, like
+ * `isect_bvhtree_point_v3` in `bmesh_intersect.c`.
+ */
+static int boolean_region_ray_hits(const float co[3], const int side, void *user_data)
+{
+  /* Side 1 is the operand, which is complete in the BMesh. */
+  if (side != 0) {
+    return -1;
+  }
+  BooleanRegionRayCast *ray_cast = (BooleanRegionRayCast *)user_data;
+  const float dir[3] = {1.0f, 0.0f, 0.0f};
+  BVHTreeRayHit hit = {0};
+  hit.index = -1;
+  hit.dist = BVH_RAYCAST_DIST_MAX;
+
+  ray_cast->depths.clear();
+  BLI_bvhtree_ray_cast(
+      ray_cast->treedata.tree, co, dir, 0.0f, &hit, boolean_region_raycast_cb, ray_cast);
+  if (ray_cast->depths.size() < 2) {
+    return ray_cast->depths.size();
+  }
+
+  const float eps = FLT_EPSILON * 10;
+  std::sort(ray_cast->depths.begin(), ray_cast->depths.end());
+  int hits = 1;
+  float depth_last = ray_cast->depths[0];
+  for (const float depth : ray_cast->depths.as_span().drop_front(1)) {
+    if (depth - depth_last > eps) {
+      depth_last = depth;
+      hits++;
+    }
+  }
+  return hits;
+}
+
+/**
+ * Intersect only the part of \a mesh near the operand, see #BooleanRegion.
+ * \return Null when it's not worth it, then the whole mesh should be intersected.
+ */
+static Mesh *boolean_region_exec(ModifierData *md,
+                                 const ModifierEvalContext *ctx,
+                                 Mesh *mesh,
+                                 Object *object,
+                                 Mesh *mesh_operand_ob,
+                                 Object *operand_ob)
+{
+  BooleanModifierData *bmd = (BooleanModifierData *)md;
+  if ((G.debug & G_DEBUG) && (bmd->bm_flag & eBooleanModifierBMeshFlag_BMesh_Separate)) {
+    /* Separated faces would be merged back. */
+    return nullptr;
+  }
+
+  BooleanRegion region;
+  if (!boolean_region_calc(
+          mesh, object, mesh_operand_ob, operand_ob, bmd->double_threshold, region)) {
+    return nullptr;
+  }
+
+  BooleanRegionRayCast ray_cast;
+  BKE_bvhtree_from_mesh_get(&ray_cast.treedata, mesh, BVHTREE_FROM_LOOPTRI, 2);
+  if (ray_cast.treedata.tree == nullptr) {
+    free_bvhtree_from_mesh(&ray_cast.treedata);
+    return nullptr;
+  }
+
+  Mesh *mesh_near = boolean_region_mesh_create(mesh, region);
+
+  bool is_flip;
+  BMesh *bm = BMD_mesh_bm_create(mesh_near, object, mesh_operand_ob, operand_ob, &is_flip);
+  BMD_mesh_intersection(bm,
+                        md,
+                        ctx,
+                        mesh_operand_ob,
+                        object,
+                        operand_ob,
+                        is_flip,
+                        boolean_region_ray_hits,
+                        &ray_cast);
+  Mesh *result_near = BKE_mesh_from_bmesh_for_eval_nomain(bm, nullptr, mesh_near);
+  BM_mesh_free(bm);
+  BKE_id_free(nullptr, mesh_near);
+  free_bvhtree_from_mesh(&ray_cast.treedata);
+
+  Mesh *result = boolean_region_mesh_join(mesh, region, result_near);
+  BKE_id_free(nullptr, result_near);
+  return result;
+}
+
+/** \} */
+
 #ifdef WITH_GMP
 
 /* Get a mapping from material slot numbers in the src_ob to slot numbers in the dst_ob.
@@ -491,11 +949,16 @@ static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *
        * Returning mesh is depended on modifiers operation (sergey) */
       result = get_quick_mesh(object, mesh, operand_ob, mesh_operand_ob, bmd->operation);
 
+      if (result == nullptr) {
+        result = boolean_region_exec(md, ctx, mesh, object, mesh_operand_ob, operand_ob);
+      }
+
       if (result == nullptr) {
         bool is_flip;
         BMesh *bm = BMD_mesh_bm_create(mesh, object, mesh_operand_ob, operand_ob, &is_flip);
 
-        BMD_mesh_intersection(bm, md, ctx, mesh_operand_ob, object, operand_ob, is_flip);
+        BMD_mesh_intersection(
+            bm, md, ctx, mesh_operand_ob, object, operand_ob, is_flip, nullptr, nullptr);
 
         result = BKE_mesh_from_bmesh_for_eval_nomain(bm, nullptr, mesh);
 
@@ -526,7 +989,8 @@ static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *
           bool is_flip;
           BMesh *bm = BMD_mesh_bm_create(mesh, object, mesh_operand_ob, operand_ob, &is_flip);
 
-          BMD_mesh_intersection(bm, md, ctx, mesh_operand_ob, object, operand_ob, is_flip);
+          BMD_mesh_intersection(
+              bm, md, ctx, mesh_operand_ob, object, operand_ob, is_flip, nullptr, nullptr);
 
           /* Needed for multiple objects to work. */
           BMeshToMeshParams bmesh_to_mesh_params{};
@@ -15,6 +15,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math_vec_types.hh"
 #include "BLI_multi_value_map.hh"
+#include "BLI_path_util.h"
 #include "BLI_set.hh"
 #include "BLI_string.h"
 #include "BLI_string_search.h"
@@ -36,6 +37,7 @@
 
 #include "BKE_attribute_math.hh"
 #include "BKE_customdata.h"
+#include "BKE_geometry_cache.hh"
 #include "BKE_geometry_set_instances.hh"
 #include "BKE_global.h"
 #include "BKE_idprop.h"
@@ -106,11 +108,13 @@ using blender::Span;
 using blender::StringRef;
 using blender::StringRefNull;
 using blender::Vector;
+using blender::bke::GeometryFrameCache;
 using blender::bke::OutputAttribute;
 using blender::fn::Field;
 using blender::fn::GField;
 using blender::fn::ValueOrField;
 using blender::fn::ValueOrFieldCPPType;
+using blender::modifiers::geometry_nodes::NodeResultCache;
 using blender::nodes::FieldInferencingInterface;
 using blender::nodes::GeoNodeExecParams;
 using blender::nodes::InputSocketFieldType;
@@ -914,12 +918,95 @@ static void find_sockets_to_preview(NodesModifierData *nmd,
   }
 }
 
+static void clear_result_cache(NodesModifierData *nmd)
+{
+  if (nmd->runtime_result_cache != nullptr) {
+    delete static_cast<NodeResultCache *>(nmd->runtime_result_cache);
+    nmd->runtime_result_cache = nullptr;
+  }
+}
+
 static void clear_runtime_data(NodesModifierData *nmd)
 {
   if (nmd->runtime_eval_log != nullptr) {
     delete (geo_log::ModifierLog *)nmd->runtime_eval_log;
     nmd->runtime_eval_log = nullptr;
   }
+  clear_result_cache(nmd);
+}
+
+/**
+ * The cache is stored on the original modifier, so that it survives copy-on-write updates of the
+ * evaluated modifier. It is only used for the active depsgraph, which avoids modifying the
+ * original data from e.g. a render depsgraph.
+ */
+static NodeResultCache *get_result_cache(NodesModifierData *nmd, const ModifierEvalContext *ctx)
+{
+  if (!DEG_is_active(ctx->depsgraph)) {
+    return nullptr;
+  }
+  NodesModifierData *nmd_orig = (NodesModifierData *)BKE_modifier_get_original(ctx->object,
+                                                                               &nmd->modifier);
+  if (!(nmd->flag & MOD_NODES_CACHE_NODE_RESULTS)) {
+    clear_result_cache(nmd_orig);
+    return nullptr;
+  }
+  if (nmd_orig->runtime_result_cache == nullptr) {
+    nmd_orig->runtime_result_cache = new NodeResultCache();
+  }
+  return static_cast<NodeResultCache *>(nmd_orig->runtime_result_cache);
+}
+
+static void clear_frame_cache(NodesModifierData *nmd)
+{
+  if (nmd->runtime_frame_cache != nullptr) {
+    delete static_cast<GeometryFrameCache *>(nmd->runtime_frame_cache);
+    nmd->runtime_frame_cache = nullptr;
+  }
+}
+
+/**
+ * Like the node result cache, the frame cache is stored on the original modifier and only used
+ * for the active depsgraph. Sub-frames (e.g. for motion blur) are not cached.
+ */
+static GeometryFrameCache *get_frame_cache(NodesModifierData *nmd,
+                                           const ModifierEvalContext *ctx,
+                                           int *r_frame)
+{
+  if (!DEG_is_active(ctx->depsgraph)) {
+    return nullptr;
+  }
+  NodesModifierData *nmd_orig = (NodesModifierData *)BKE_modifier_get_original(ctx->object,
+                                                                               &nmd->modifier);
+  if (!(nmd->flag & MOD_NODES_CACHE_FRAMES)) {
+    clear_frame_cache(nmd_orig);
+    return nullptr;
+  }
+  const float ctime = DEG_get_ctime(ctx->depsgraph);
+  if (ctime != floorf(ctime)) {
+    return nullptr;
+  }
+  if (nmd_orig->runtime_frame_cache == nullptr) {
+    nmd_orig->runtime_frame_cache = new GeometryFrameCache();
+  }
+  GeometryFrameCache *frame_cache = static_cast<GeometryFrameCache *>(
+      nmd_orig->runtime_frame_cache);
+
+  /* These settings don't tag an update, so read them from the original. */
+  frame_cache->set_memory_limit(int64_t(nmd_orig->cache_memory_limit) * 1024 * 1024);
+  char directory[FILE_MAX] = "";
+  if (nmd_orig->cache_directory[0] != '\0') {
+    STRNCPY(directory, nmd_orig->cache_directory);
+    BLI_path_abs(directory, BKE_modifier_path_relbase_from_global(ctx->object));
+  }
+  char file_prefix[MAX_ID_NAME + MAX_NAME];
+  BLI_snprintf(
+      file_prefix, sizeof(file_prefix), "%s_%s", ctx->object->id.name + 2, nmd->modifier.name);
+  BLI_filename_make_safe(file_prefix);
+  frame_cache->set_disk_directory(directory, file_prefix);
+
+  *r_frame = int(ctime);
+  return frame_cache;
 }
 
 struct OutputAttributeInfo {
@@ -1138,7 +1225,14 @@ static GeometrySet compute_geometry(const DerivedNodeTree &tree,
   eval_params.depsgraph = ctx->depsgraph;
   eval_params.self_object = ctx->object;
   eval_params.geo_logger = geo_logger.has_value() ? &*geo_logger : nullptr;
+  eval_params.result_cache = get_result_cache(nmd, ctx);
+  if (eval_params.result_cache != nullptr) {
+    eval_params.result_cache->begin_evaluation();
+  }
   blender::modifiers::geometry_nodes::evaluate_geometry_nodes(eval_params);
+  if (eval_params.result_cache != nullptr) {
+    eval_params.result_cache->end_evaluation();
+  }
 
   GeometrySet output_geometry_set = std::move(*eval_params.r_output_values[0].get<GeometrySet>());
 
@@ -1249,6 +1343,16 @@ static void modifyGeometry(ModifierData *md,
     return;
   }
 
+  int cache_frame = 0;
+  GeometryFrameCache *frame_cache = get_frame_cache(nmd, ctx, &cache_frame);
+  if (frame_cache != nullptr) {
+    frame_cache->tag_evaluation(cache_frame);
+    if (std::optional<GeometrySet> cached_geometry = frame_cache->lookup(cache_frame)) {
+      geometry_set = std::move(*cached_geometry);
+      return;
+    }
+  }
+
   bool use_orig_index_verts = false;
   bool use_orig_index_edges = false;
   bool use_orig_index_polys = false;
@@ -1259,8 +1363,11 @@ static void modifyGeometry(ModifierData *md,
     use_orig_index_polys = CustomData_has_layer(&mesh.pdata, CD_ORIGINDEX);
   }
 
-  geometry_set = compute_geometry(
-      tree, input_nodes, output_node, std::move(geometry_set), nmd, ctx);
+  {
+    MEM_CategoryScope mem_category_scope(MEM_CATEGORY_GEOMETRY);
+    geometry_set = compute_geometry(
+        tree, input_nodes, output_node, std::move(geometry_set), nmd, ctx);
+  }
 
   if (geometry_set.has_mesh()) {
     /* Add #CD_ORIGINDEX layers if they don't exist already. This is required because the
@@ -1277,6 +1384,10 @@ static void modifyGeometry(ModifierData *md,
       CustomData_add_layer(&mesh.pdata, CD_ORIGINDEX, CD_DEFAULT, nullptr, mesh.totpoly);
     }
   }
+
+  if (frame_cache != nullptr) {
+    frame_cache->add(cache_frame, geometry_set);
+  }
 }
 
 static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *mesh)
@@ -1608,6 +1719,13 @@ static void panel_draw(const bContext *C, Panel *panel)
     }
   }
 
+  uiItemR(layout, ptr, "use_cache_node_results", 0, nullptr, ICON_NONE);
+  uiItemR(layout, ptr, "use_cache_frames", 0, nullptr, ICON_NONE);
+  if (nmd->flag & MOD_NODES_CACHE_FRAMES) {
+    uiItemR(layout, ptr, "cache_directory", 0, nullptr, ICON_NONE);
+    uiItemR(layout, ptr, "cache_memory_limit", 0, nullptr, ICON_NONE);
+  }
+
   /* Draw node warnings. */
   if (nmd->runtime_eval_log != nullptr) {
     const geo_log::ModifierLog &log = *static_cast<geo_log::ModifierLog *>(nmd->runtime_eval_log);
@@ -1674,6 +1792,8 @@ static void blendRead(BlendDataReader *reader, ModifierData *md)
   BLO_read_data_address(reader, &nmd->settings.properties);
   IDP_BlendDataRead(reader, &nmd->settings.properties);
   nmd->runtime_eval_log = nullptr;
+  nmd->runtime_result_cache = nullptr;
+  nmd->runtime_frame_cache = nullptr;
 }
 
 static void copyData(const ModifierData *md, ModifierData *target, const int flag)
@@ -1684,6 +1804,8 @@ static void copyData(const ModifierData *md, ModifierData *target, const int fla
   BKE_modifier_copydata_generic(md, target, flag);
 
   tnmd->runtime_eval_log = nullptr;
+  tnmd->runtime_result_cache = nullptr;
+  tnmd->runtime_frame_cache = nullptr;
 
   if (nmd->settings.properties != nullptr) {
     tnmd->settings.properties = IDP_CopyProperty_ex(nmd->settings.properties, flag);
@@ -1699,6 +1821,7 @@ static void freeData(ModifierData *md)
   }
 
   clear_runtime_data(nmd);
+  clear_frame_cache(nmd);
 }
 
 static void requiredDataMask(Object *UNUSED(ob),
@@ -0,0 +1,135 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup modifiers
+ */
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_cpp_type.hh"
+
+#include "MOD_nodes_cache.hh"
+
+namespace blender::modifiers::geometry_nodes {
+
+static GMutablePointer copy_value_for_cache(const GPointer value)
+{
+  const CPPType &type = *value.type();
+  void *buffer = MEM_mallocN_aligned(type.size(), type.alignment(), __func__);
+  type.copy_construct(value.get(), buffer);
+  return {type, buffer};
+}
+
+static void free_cached_value(GMutablePointer value)
+{
+  if (value.get() == nullptr) {
+    return;
+  }
+  value.destruct();
+  MEM_freeN(value.get());
+}
+
+NodeResultCache::Entry::~Entry()
+{
+  for (GMutablePointer value : this->inputs) {
+    free_cached_value(value);
+  }
+  for (GMutablePointer value : this->outputs) {
+    free_cached_value(value);
+  }
+}
+
+void NodeResultCache::begin_evaluation()
+{
+  std::lock_guard lock{mutex_};
+  evaluation_counter_++;
+}
+
+void NodeResultCache::end_evaluation()
+{
+  std::lock_guard lock{mutex_};
+  Vector<uint64_t> keys_to_remove;
+  for (auto item : entries_.items()) {
+    if (item.value->last_used_evaluation != evaluation_counter_) {
+      keys_to_remove.append(item.key);
+    }
+  }
+  for (const uint64_t key : keys_to_remove) {
+    entries_.remove_contained(key);
+  }
+}
+
+static bool cached_inputs_match(Span<GMutablePointer> cached_inputs, Span<GPointer> inputs)
+{
+  if (cached_inputs.size() != inputs.size()) {
+    return false;
+  }
+  for (const int i : inputs.index_range()) {
+    const CPPType &type = *inputs[i].type();
+    if (*cached_inputs[i].type() != type) {
+      return false;
+    }
+    if (!type.is_equal_or_false(cached_inputs[i].get(), inputs[i].get())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool NodeResultCache::lookup(const uint64_t node_key,
+                             const uint64_t properties_hash,
+                             Span<GPointer> inputs,
+                             Span<int> outputs_to_load,
+                             FunctionRef<void(int output_index, GPointer value)> output_fn)
+{
+  std::lock_guard lock{mutex_};
+  const std::unique_ptr<Entry> *entry_ptr = entries_.lookup_ptr(node_key);
+  if (entry_ptr == nullptr) {
+    return false;
+  }
+  Entry &entry = **entry_ptr;
+  if (entry.properties_hash != properties_hash) {
+    return false;
+  }
+  if (!cached_inputs_match(entry.inputs, inputs)) {
+    return false;
+  }
+  for (const int output_index : outputs_to_load) {
+    if (entry.outputs[output_index].get() == nullptr) {
+      /* The output was not used when the entry was added. */
+      return false;
+    }
+  }
+  for (const int output_index : outputs_to_load) {
+    output_fn(output_index, entry.outputs[output_index]);
+  }
+  entry.last_used_evaluation = evaluation_counter_;
+  return true;
+}
+
+void NodeResultCache::add(const uint64_t node_key,
+                          const uint64_t properties_hash,
+                          Span<GPointer> inputs,
+                          Span<GPointer> outputs)
+{
+  std::unique_ptr<Entry> entry = std::make_unique<Entry>();
+  entry->properties_hash = properties_hash;
+  for (const GPointer value : inputs) {
+    entry->inputs.append(copy_value_for_cache(value));
+  }
+  for (const GPointer value : outputs) {
+    entry->outputs.append(value.get() == nullptr ? GMutablePointer() :
+                                                   copy_value_for_cache(value));
+  }
+
+  std::lock_guard lock{mutex_};
+  entry->last_used_evaluation = evaluation_counter_;
+  entries_.add_overwrite(node_key, std::move(entry));
+}
+
+int64_t NodeResultCache::size() const
+{
+  return entries_.size();
+}
+
+}  // namespace blender::modifiers::geometry_nodes
@@ -0,0 +1,82 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup modifiers
+ *
+ * Cache for the results of individual nodes that is kept alive between evaluations of the same
+ * geometry nodes modifier. When only some inputs of a modifier change, nodes whose inputs are
+ * still the same as in the previous evaluation don't have to be executed again.
+ *
+ * Only nodes whose inputs are all simple values (no fields, no geometry and no data-blocks) can be
+ * cached, because only those inputs can be compared cheaply and reliably.
+ */
+
+#include <mutex>
+
+#include "BLI_function_ref.hh"
+#include "BLI_generic_pointer.hh"
+#include "BLI_map.hh"
+#include "BLI_vector.hh"
+
+namespace blender::modifiers::geometry_nodes {
+
+class NodeResultCache : NonCopyable, NonMovable {
+ private:
+  struct Entry {
+    /** Hash of the node type and its properties that are not exposed as sockets. */
+    uint64_t properties_hash;
+    /** Copies of the input values that the outputs were computed with. */
+    Vector<GMutablePointer> inputs;
+    /** Copies of the computed outputs, indexed by socket index. Null for outputs that were not
+     * computed in the evaluation that created this entry. */
+    Vector<GMutablePointer> outputs;
+    /** Used to remove entries that are not used anymore. */
+    int last_used_evaluation;
+
+    ~Entry();
+  };
+
+  std::mutex mutex_;
+  /** The key is a hash of the path of the node in the (nested) node groups. */
+  Map<uint64_t, std::unique_ptr<Entry>> entries_;
+  int evaluation_counter_ = 0;
+
+ public:
+  /**
+   * Has to be called before and after every evaluation of the modifier. Entries that have not been
+   * used in the last evaluation are removed, so that the cache does not grow indefinitely when the
+   * node tree changes.
+   */
+  void begin_evaluation();
+  void end_evaluation();
+
+  /**
+   * Look up the outputs of a node that has been computed with the same inputs before.
+   * \param outputs_to_load: Indices of the outputs that are needed.
+   * \param output_fn: Called with the cached value for every requested output. The value should be
+   *   copied, it is still owned by the cache.
+   * \return False when there is no matching entry that contains all requested outputs. In that
+   *   case #output_fn is not called.
+   */
+  bool lookup(uint64_t node_key,
+              uint64_t properties_hash,
+              Span<GPointer> inputs,
+              Span<int> outputs_to_load,
+              FunctionRef<void(int output_index, GPointer value)> output_fn);
+
+  /**
+   * Remember the outputs that have been computed for the given inputs. The values are copied.
+   * \param outputs: Indexed by socket index, may contain null pointers for outputs that have not
+   *   been computed.
+   */
+  void add(uint64_t node_key,
+           uint64_t properties_hash,
+           Span<GPointer> inputs,
+           Span<GPointer> outputs);
+
+  int64_t size() const;
+};
+
+}  // namespace blender::modifiers::geometry_nodes
@@ -2,6 +2,8 @@
 
 #include "MOD_nodes_evaluator.hh"
 
+#include "MEM_guardedalloc.h"
+
 #include "BKE_type_conversions.hh"
 
 #include "NOD_geometry_exec.hh"
@@ -17,6 +19,7 @@
 
 #include "BLI_enumerable_thread_specific.hh"
 #include "BLI_generic_value_map.hh"
+#include "BLI_hash_mm2a.h"
 #include "BLI_stack.hh"
 #include "BLI_task.h"
 #include "BLI_task.hh"
@@ -413,6 +416,12 @@ class NodeParamsProvider : public nodes::GeoNodeExecParamsProvider {
   NodeTaskRunState *run_state_;
 
  public:
+  /**
+   * When not empty, a copy of every output value is stored here (indexed by socket index), so that
+   * it can be added to the #NodeResultCache after the node has been executed.
+   */
+  MutableSpan<GMutablePointer> outputs_to_cache;
+
   NodeParamsProvider(GeometryNodesEvaluator &evaluator,
                      DNode dnode,
                      NodeState &node_state,
@@ -515,8 +524,12 @@ class GeometryNodesEvaluator {
       NodeState &node_state = *allocator.construct<NodeState>().release();
       node_states_.add_new({node, &node_state});
 
-      /* Push all linked origins on the stack. */
+      /* Push all linked origins on the stack. Nodes that are only linked to unavailable inputs
+       * can never be used, so they don't need a state. */
       for (const InputSocketRef *input_ref : node->inputs()) {
+        if (!input_ref->is_available()) {
+          continue;
+        }
         const DInputSocket input{node.context(), input_ref};
         input.foreach_origin_socket(
             [&](const DSocket origin) { nodes_to_check.push(origin.node()); });
@@ -961,6 +974,10 @@ class GeometryNodesEvaluator {
 
     /* Use the geometry node execute callback if it exists. */
     if (bnode.typeinfo->geometry_node_execute != nullptr) {
+      if (params_.result_cache != nullptr && this->node_is_cacheable(node, node_state)) {
+        this->execute_geometry_node_with_cache(node, node_state, run_state);
+        return;
+      }
       this->execute_geometry_node(node, node_state, run_state);
       return;
     }
@@ -975,12 +992,166 @@ class GeometryNodesEvaluator {
     this->execute_unknown_node(node, node_state, run_state);
   }
 
-  void execute_geometry_node(const DNode node, NodeState &node_state, NodeTaskRunState *run_state)
+  /**
+   * Nodes can only be cached when all their inputs are simple values that can be compared with the
+   * inputs of a previous evaluation. Nodes without inputs are not cached, because they typically
+   * depend on the context (e.g. the current frame).
+   */
+  bool node_is_cacheable(const DNode node, NodeState &node_state)
+  {
+    const bNode &bnode = *node->bnode();
+    if (node_supports_laziness(node)) {
+      return false;
+    }
+    if (bnode.id != nullptr) {
+      /* The node depends on data outside of the node tree. */
+      return false;
+    }
+    bool has_data_input = false;
+    for (const int i : node->inputs().index_range()) {
+      InputState &input_state = node_state.inputs[i];
+      if (input_state.type == nullptr) {
+        continue;
+      }
+      const InputSocketRef &socket_ref = node->input(i);
+      if (socket_ref.is_multi_input_socket()) {
+        return false;
+      }
+      if (!ELEM(socket_ref.typeinfo()->type,
+                SOCK_FLOAT,
+                SOCK_INT,
+                SOCK_BOOLEAN,
+                SOCK_VECTOR,
+                SOCK_RGBA,
+                SOCK_STRING)) {
+        return false;
+      }
+      const ValueOrFieldCPPType &field_cpp_type = static_cast<const ValueOrFieldCPPType &>(
+          *input_state.type);
+      if (!field_cpp_type.base_type().is_equality_comparable()) {
+        return false;
+      }
+      if (field_cpp_type.is_field(input_state.value.single->value)) {
+        return false;
+      }
+      has_data_input = true;
+    }
+    return has_data_input;
+  }
+
+  static uint64_t get_node_cache_key(const DNode node)
+  {
+    /* Node names are unique within a node tree, so the names of the node and of the group nodes it
+     * is nested in identify it in a stable way, even when the node tree is copied. */
+    uint64_t hash = get_default_hash(StringRef(node->bnode()->name));
+    for (const DTreeContext *context = node.context(); context->parent_node() != nullptr;
+         context = context->parent_context()) {
+      hash = get_default_hash_2(hash, StringRef(context->parent_node()->bnode()->name));
+    }
+    return hash;
+  }
+
+  static uint64_t get_node_properties_hash(const bNode &bnode)
+  {
+    uint64_t hash = get_default_hash_4(
+        StringRef(bnode.idname), bnode.custom1, bnode.custom2, bnode.custom3);
+    hash = get_default_hash_2(hash, bnode.custom4);
+    if (bnode.storage != nullptr) {
+      /* Node storage is always allocated with guarded-alloc and doesn't contain pointers for the
+       * nodes that can be cached. */
+      const size_t storage_size = MEM_allocN_len(bnode.storage);
+      hash = get_default_hash_2(
+          hash, BLI_hash_mm2((const unsigned char *)bnode.storage, storage_size, 0));
+    }
+    return hash;
+  }
+
+  void execute_geometry_node_with_cache(const DNode node,
+                                        NodeState &node_state,
+                                        NodeTaskRunState *run_state)
+  {
+    NodeResultCache &cache = *params_.result_cache;
+    LinearAllocator<> &allocator = local_allocators_.local();
+    const uint64_t node_key = get_node_cache_key(node);
+    const uint64_t properties_hash = get_node_properties_hash(*node->bnode());
+
+    /* Copy the input values, because the node might consume them during execution. */
+    Vector<GMutablePointer, 16> input_values;
+    for (InputState &input_state : node_state.inputs) {
+      if (input_state.type == nullptr) {
+        continue;
+      }
+      const ValueOrFieldCPPType &field_cpp_type = static_cast<const ValueOrFieldCPPType &>(
+          *input_state.type);
+      const CPPType &base_type = field_cpp_type.base_type();
+      void *buffer = allocator.allocate(base_type.size(), base_type.alignment());
+      base_type.copy_construct(field_cpp_type.get_value_ptr(input_state.value.single->value),
+                               buffer);
+      input_values.append({base_type, buffer});
+    }
+    Vector<GPointer, 16> input_pointers(input_values.as_span());
+
+    Vector<int, 16> outputs_to_load;
+    for (const int i : node->outputs().index_range()) {
+      const OutputState &output_state = node_state.outputs[i];
+      if (output_state.has_been_computed) {
+        continue;
+      }
+      if (output_state.output_usage_for_execution == ValueUsage::Unused) {
+        continue;
+      }
+      outputs_to_load.append(i);
+    }
+
+    /* Values are forwarded after the lookup, because forwarding should not happen while the cache
+     * is locked. */
+    Vector<GMutablePointer, 16> cached_outputs;
+    const bool found = cache.lookup(
+        node_key,
+        properties_hash,
+        input_pointers,
+        outputs_to_load,
+        [&](const int UNUSED(output_index), const GPointer cached_value) {
+          const CPPType &type = *cached_value.type();
+          void *buffer = allocator.allocate(type.size(), type.alignment());
+          type.copy_construct(cached_value.get(), buffer);
+          cached_outputs.append({type, buffer});
+        });
+
+    if (found) {
+      for (const int i : outputs_to_load.index_range()) {
+        const int output_index = outputs_to_load[i];
+        this->forward_output(node.output(output_index), cached_outputs[i], run_state);
+        node_state.outputs[output_index].has_been_computed = true;
+      }
+    }
+    else {
+      Array<GMutablePointer, 16> output_values(node->outputs().size());
+      this->execute_geometry_node(node, node_state, run_state, output_values);
+      Vector<GPointer, 16> output_pointers(output_values.as_span());
+      cache.add(node_key, properties_hash, input_pointers, output_pointers);
+      for (GMutablePointer value : output_values) {
+        if (value.get() != nullptr) {
+          value.destruct();
+        }
+      }
+    }
+
+    for (GMutablePointer value : input_values) {
+      value.destruct();
+    }
+  }
+
+  void execute_geometry_node(const DNode node,
+                             NodeState &node_state,
+                             NodeTaskRunState *run_state,
+                             MutableSpan<GMutablePointer> outputs_to_cache = {})
   {
     using Clock = std::chrono::steady_clock;
     const bNode &bnode = *node->bnode();
 
     NodeParamsProvider params_provider{*this, node, node_state, run_state};
+    params_provider.outputs_to_cache = outputs_to_cache;
     GeoNodeExecParams params{params_provider};
     Clock::time_point begin = Clock::now();
     bnode.typeinfo->geometry_node_execute(params);
@@ -1356,25 +1527,61 @@ class GeometryNodesEvaluator {
     });
   }
 
-  void send_output_unused_notification(const DOutputSocket socket, NodeTaskRunState *run_state)
+  /**
+   * Notify the origin nodes that some of their outputs lost a potential user. When an entire
+   * branch becomes unused (e.g. the disabled side of a Switch node), this propagates through all
+   * nodes of that branch. To avoid deep recursion in long chains of nodes, the notifications are
+   * processed iteratively.
+   */
+  void send_output_unused_notifications(Span<DOutputSocket> sockets, NodeTaskRunState *run_state)
   {
-    const DNode node = socket.node();
-    NodeState &node_state = this->get_node_state(node);
+    Stack<DOutputSocket> sockets_to_notify;
+    sockets_to_notify.push_multiple(sockets);
+    while (!sockets_to_notify.is_empty()) {
+      const DOutputSocket socket = sockets_to_notify.pop();
+      const DNode node = socket.node();
+      NodeState &node_state = this->get_node_state(node);
+      LockedNode locked_node{node, node_state};
+
+      node_state.mutex.lock();
+      threading::isolate_task([&] { this->handle_output_unused(locked_node, socket); });
+      node_state.mutex.unlock();
+
+      /* Making an output unused never makes other sockets required. */
+      BLI_assert(locked_node.delayed_required_outputs.is_empty());
+      sockets_to_notify.push_multiple(locked_node.delayed_unused_outputs);
+      this->schedule_delayed_nodes(locked_node.delayed_scheduled_nodes, run_state);
+    }
+  }
+
+  void handle_output_unused(LockedNode &locked_node, const DOutputSocket socket)
+  {
+    NodeState &node_state = locked_node.node_state;
     OutputState &output_state = node_state.outputs[socket->index()];
 
-    this->with_locked_node(node, node_state, run_state, [&](LockedNode &locked_node) {
-      output_state.potential_users -= 1;
-      if (output_state.potential_users == 0) {
-        /* The socket might be required even though the output is not used by other sockets. That
-         * can happen when the socket is forced to be computed. */
-        if (output_state.output_usage != ValueUsage::Required) {
-          /* The output socket has no users anymore. */
-          output_state.output_usage = ValueUsage::Unused;
-          /* Schedule the origin node in case it wants to set its inputs as unused as well. */
-          this->schedule_node(locked_node);
-        }
-      }
-    });
+    output_state.potential_users -= 1;
+    if (output_state.potential_users > 0) {
+      return;
+    }
+    /* The socket might be required even though the output is not used by other sockets. That
+     * can happen when the socket is forced to be computed. */
+    if (output_state.output_usage == ValueUsage::Required) {
+      return;
+    }
+    /* The output socket has no users anymore. */
+    output_state.output_usage = ValueUsage::Unused;
+
+    if (node_state.schedule_state == NodeScheduleState::NotScheduled) {
+      /* A node that is not scheduled would not compute anything when it runs now, because it has
+       * no output that became required. Therefore it can be finished right away, which also sets
+       * its inputs as unused. This avoids a round trip through the task pool for every node in an
+       * unused branch. */
+      this->finish_node_if_possible(locked_node);
+    }
+    else {
+      /* Schedule the origin node in case it wants to set its inputs as unused as well. */
+      this->schedule_node(locked_node);
+    }
   }
 
   void add_node_to_task_pool(const DNode node)
@@ -1722,10 +1929,15 @@ class GeometryNodesEvaluator {
     for (const DOutputSocket &socket : locked_node.delayed_required_outputs) {
       this->send_output_required_notification(socket, run_state);
     }
-    for (const DOutputSocket &socket : locked_node.delayed_unused_outputs) {
-      this->send_output_unused_notification(socket, run_state);
+    if (!locked_node.delayed_unused_outputs.is_empty()) {
+      this->send_output_unused_notifications(locked_node.delayed_unused_outputs, run_state);
     }
-    for (const DNode &node_to_schedule : locked_node.delayed_scheduled_nodes) {
+    this->schedule_delayed_nodes(locked_node.delayed_scheduled_nodes, run_state);
+  }
+
+  void schedule_delayed_nodes(Span<DNode> nodes_to_schedule, NodeTaskRunState *run_state)
+  {
+    for (const DNode &node_to_schedule : nodes_to_schedule) {
       if (run_state != nullptr && !run_state->next_node_to_run) {
         /* Execute the node on the same thread after the current node finished. */
         /* Currently, this assumes that it is always best to run the first node that is scheduled
@@ -1839,6 +2051,13 @@ void NodeParamsProvider::set_output(StringRef identifier, GMutablePointer value)
 
   OutputState &output_state = node_state_.outputs[socket->index()];
   BLI_assert(!output_state.has_been_computed);
+  if (!outputs_to_cache.is_empty()) {
+    const CPPType &type = *value.type();
+    LinearAllocator<> &allocator = evaluator_.local_allocators_.local();
+    void *buffer = allocator.allocate(type.size(), type.alignment());
+    type.copy_construct(value.get(), buffer);
+    outputs_to_cache[socket->index()] = {type, buffer};
+  }
   evaluator_.forward_output(socket, value, run_state_);
   output_state.has_been_computed = true;
 }
@@ -172,6 +172,10 @@ static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *
   if (resolution.mode == VOLUME_TO_MESH_RESOLUTION_MODE_VOXEL_SIZE) {
     resolution.settings.voxel_size = vmmd->voxel_size;
   }
+  if (!blender::bke::volume_to_mesh_resolution_simplify(
+          resolution, BKE_volume_simplify_factor(ctx->depsgraph))) {
+    return create_empty_mesh(input_mesh);
+  }
 
   Mesh *mesh = blender::bke::volume_to_mesh(
       *transformed_grid, resolution, vmmd->threshold, vmmd->adaptivity);
@@ -117,6 +117,7 @@ static void local_merge(Main *bmain, bNodeTree *localtree, bNodeTree *ntree)
 
   /* move over the compbufs and previews */
   BKE_node_preview_merge_tree(ntree, localtree, true);
+  BKE_node_execution_stats_merge_tree(ntree, localtree);
 
   for (lnode = (bNode *)localtree->nodes.first; lnode; lnode = lnode->next) {
     if (bNode *orig_node = nodeFindNodebyName(ntree, lnode->name)) {
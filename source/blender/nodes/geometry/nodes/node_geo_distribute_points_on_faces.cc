@@ -1,6 +1,5 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
-#include "BLI_kdtree.h"
 #include "BLI_noise.hh"
 #include "BLI_rand.hh"
 #include "BLI_task.hh"
@@ -17,6 +16,8 @@
 #include "BKE_mesh_sample.hh"
 #include "BKE_pointcloud.h"
 
+#include "GEO_point_grid.hh"
+
 #include "UI_interface.h"
 #include "UI_resources.h"
 
@@ -90,7 +91,9 @@ static void sample_mesh_surface(const Mesh &mesh,
   const Span<MLoopTri> looptris{BKE_mesh_runtime_looptri_ensure(&mesh),
                                 BKE_mesh_runtime_looptri_len(&mesh)};
 
-  for (const int looptri_index : looptris.index_range()) {
+  /* Every triangle has its own random number generator, which is seeded again when the points
+   * are created, so that the triangles are sampled in parallel with the same result. */
+  const auto sample_looptri = [&](const int looptri_index, const auto &fn) {
     const MLoopTri &looptri = looptris[looptri_index];
     const int v0_loop = looptri.tri[0];
     const int v1_loop = looptri.tri[1];
@@ -116,64 +119,81 @@ static void sample_mesh_surface(const Mesh &mesh,
 
     const int point_amount = looptri_rng.round_probabilistic(area * base_density *
                                                              looptri_density_factor);
-
-    for (int i = 0; i < point_amount; i++) {
-      const float3 bary_coord = looptri_rng.get_barycentric_coordinates();
-      float3 point_pos;
-      interp_v3_v3v3v3(point_pos, v0_pos, v1_pos, v2_pos, bary_coord);
-      r_positions.append(point_pos);
-      r_bary_coords.append(bary_coord);
-      r_looptri_indices.append(looptri_index);
+    fn(point_amount, looptri_rng, v0_pos, v1_pos, v2_pos);
+  };
+
+  Array<int> offsets(looptris.size() + 1);
+  threading::parallel_for(looptris.index_range(), 1024, [&](const IndexRange range) {
+    for (const int looptri_index : range) {
+      sample_looptri(looptri_index,
+                     [&](const int point_amount,
+                         RandomNumberGenerator &UNUSED(rng),
+                         const float3 &UNUSED(v0_pos),
+                         const float3 &UNUSED(v1_pos),
+                         const float3 &UNUSED(v2_pos)) { offsets[looptri_index] = point_amount; });
     }
+  });
+  int offset = 0;
+  for (const int looptri_index : looptris.index_range()) {
+    const int point_amount = offsets[looptri_index];
+    offsets[looptri_index] = offset;
+    offset += point_amount;
   }
-}
-
-BLI_NOINLINE static KDTree_3d *build_kdtree(Span<float3> positions)
-{
-  KDTree_3d *kdtree = BLI_kdtree_3d_new(positions.size());
-
-  int i_point = 0;
-  for (const float3 position : positions) {
-    BLI_kdtree_3d_insert(kdtree, i_point, position);
-    i_point++;
-  }
-
-  BLI_kdtree_3d_balance(kdtree);
-  return kdtree;
+  offsets.last() = offset;
+
+  r_positions.resize(offset);
+  r_bary_coords.resize(offset);
+  r_looptri_indices.resize(offset);
+  threading::parallel_for(looptris.index_range(), 1024, [&](const IndexRange range) {
+    for (const int looptri_index : range) {
+      sample_looptri(looptri_index,
+                     [&](const int point_amount,
+                         RandomNumberGenerator &rng,
+                         const float3 &v0_pos,
+                         const float3 &v1_pos,
+                         const float3 &v2_pos) {
+                       BLI_assert(offsets[looptri_index] + point_amount ==
+                                  offsets[looptri_index + 1]);
+                       for (const int i : IndexRange(offsets[looptri_index], point_amount)) {
+                         const float3 bary_coord = rng.get_barycentric_coordinates();
+                         interp_v3_v3v3v3(r_positions[i], v0_pos, v1_pos, v2_pos, bary_coord);
+                         r_bary_coords[i] = bary_coord;
+                         r_looptri_indices[i] = looptri_index;
+                       }
+                     });
+    }
+  });
 }
 
 BLI_NOINLINE static void update_elimination_mask_for_close_points(
     Span<float3> positions, const float minimum_distance, MutableSpan<bool> elimination_mask)
 {
-  if (minimum_distance <= 0.0f) {
+  if (minimum_distance <= 0.0f || positions.is_empty()) {
     return;
   }
 
-  KDTree_3d *kdtree = build_kdtree(positions);
-  BLI_SCOPED_DEFER([&]() { BLI_kdtree_3d_free(kdtree); });
+  /* The grid is built in parallel, the elimination itself depends on the points that were kept
+   * before, so it has to happen in order. */
+  const geometry::PointGrid grid(positions, IndexMask(positions.size()), minimum_distance);
+  const float minimum_distance_sq = square_f(minimum_distance);
 
+  Vector<int, 27> neighbor_cells;
   for (const int i : positions.index_range()) {
     if (elimination_mask[i]) {
       continue;
     }
 
-    struct CallbackData {
-      int index;
-      MutableSpan<bool> elimination_mask;
-    } callback_data = {i, elimination_mask};
-
-    BLI_kdtree_3d_range_search_cb(
-        kdtree,
-        positions[i],
-        minimum_distance,
-        [](void *user_data, int index, const float *UNUSED(co), float UNUSED(dist_sq)) {
-          CallbackData &callback_data = *static_cast<CallbackData *>(user_data);
-          if (index != callback_data.index) {
-            callback_data.elimination_mask[index] = true;
-          }
-          return true;
-        },
-        &callback_data);
+    grid.neighbor_cells(grid.point_cell(i), neighbor_cells);
+    for (const int cell : neighbor_cells) {
+      for (const int other : grid.cell_points(cell)) {
+        if (other == i) {
+          continue;
+        }
+        if (len_squared_v3v3(positions[i], positions[other]) <= minimum_distance_sq) {
+          elimination_mask[other] = true;
+        }
+      }
+    }
   }
 }
 
@@ -186,30 +206,33 @@ BLI_NOINLINE static void update_elimination_mask_based_on_density_factors(
 {
   const Span<MLoopTri> looptris{BKE_mesh_runtime_looptri_ensure(&mesh),
                                 BKE_mesh_runtime_looptri_len(&mesh)};
-  for (const int i : bary_coords.index_range()) {
-    if (elimination_mask[i]) {
-      continue;
-    }
+  threading::parallel_for(bary_coords.index_range(), 2048, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (elimination_mask[i]) {
+        continue;
+      }
 
-    const MLoopTri &looptri = looptris[looptri_indices[i]];
-    const float3 bary_coord = bary_coords[i];
+      const MLoopTri &looptri = looptris[looptri_indices[i]];
+      const float3 bary_coord = bary_coords[i];
 
-    const int v0_loop = looptri.tri[0];
-    const int v1_loop = looptri.tri[1];
-    const int v2_loop = looptri.tri[2];
+      const int v0_loop = looptri.tri[0];
+      const int v1_loop = looptri.tri[1];
+      const int v2_loop = looptri.tri[2];
 
-    const float v0_density_factor = std::max(0.0f, density_factors[v0_loop]);
-    const float v1_density_factor = std::max(0.0f, density_factors[v1_loop]);
-    const float v2_density_factor = std::max(0.0f, density_factors[v2_loop]);
+      const float v0_density_factor = std::max(0.0f, density_factors[v0_loop]);
+      const float v1_density_factor = std::max(0.0f, density_factors[v1_loop]);
+      const float v2_density_factor = std::max(0.0f, density_factors[v2_loop]);
 
-    const float probablity = v0_density_factor * bary_coord.x + v1_density_factor * bary_coord.y +
-                             v2_density_factor * bary_coord.z;
+      const float probablity = v0_density_factor * bary_coord.x +
+                               v1_density_factor * bary_coord.y +
+                               v2_density_factor * bary_coord.z;
 
-    const float hash = noise::hash_float_to_float(bary_coord);
-    if (hash > probablity) {
-      elimination_mask[i] = true;
+      const float hash = noise::hash_float_to_float(bary_coord);
+      if (hash > probablity) {
+        elimination_mask[i] = true;
+      }
     }
-  }
+  });
 }
 
 BLI_NOINLINE static void eliminate_points_based_on_mask(const Span<bool> elimination_mask,
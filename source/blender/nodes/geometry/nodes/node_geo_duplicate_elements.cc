@@ -79,16 +79,33 @@ static IndexRange range_for_offsets_index(const Span<int> offsets, const int ind
   return {offsets[index], offsets[index + 1] - offsets[index]};
 }
 
+/**
+ * Turn the counts at the start of \a r_offsets into the start of every range.
+ * The last element is set to the total size, which is also returned.
+ */
+static int accumulate_counts_in_place(MutableSpan<int> r_offsets)
+{
+  int offset = 0;
+  for (const int i : r_offsets.index_range().drop_back(1)) {
+    const int count = r_offsets[i];
+    r_offsets[i] = offset;
+    offset += count;
+  }
+  r_offsets.last() = offset;
+  return offset;
+}
+
 static Array<int> accumulate_counts_to_offsets(const IndexMask selection,
                                                const VArray<int> &counts)
 {
   Array<int> offsets(selection.size() + 1);
-  int dst_points_size = 0;
-  for (const int i_point : selection.index_range()) {
-    offsets[i_point] = dst_points_size;
-    dst_points_size += std::max(counts[selection[i_point]], 0);
-  }
-  offsets.last() = dst_points_size;
+  /* Retrieving the counts from the virtual array is much slower than the sum itself. */
+  threading::parallel_for(selection.index_range(), 4096, [&](IndexRange range) {
+    for (const int i_point : range) {
+      offsets[i_point] = std::max(counts[selection[i_point]], 0);
+    }
+  });
+  accumulate_counts_in_place(offsets);
   return offsets;
 }
 
@@ -147,13 +164,15 @@ static void create_duplicate_index_attribute(GeometryComponent &component,
   OutputAttribute_Typed<int> copy_attribute = component.attribute_try_get_for_output_only<int>(
       attributes.duplicate_index.get(), output_domain);
   MutableSpan<int> duplicate_indices = copy_attribute.as_span();
-  for (const int i : IndexRange(selection.size())) {
-    const IndexRange range = range_for_offsets_index(offsets, i);
-    MutableSpan<int> indices = duplicate_indices.slice(range);
-    for (const int i : indices.index_range()) {
-      indices[i] = i;
+  threading::parallel_for(IndexRange(selection.size()), 1024, [&](IndexRange range) {
+    for (const int i_selection : range) {
+      const IndexRange dst_range = range_for_offsets_index(offsets, i_selection);
+      MutableSpan<int> indices = duplicate_indices.slice(dst_range);
+      for (const int i : indices.index_range()) {
+        indices[i] = i;
+      }
     }
-  }
+  });
   copy_attribute.save();
 }
 
@@ -356,17 +375,15 @@ static void duplicate_curves(GeometrySet &geometry_set,
   Array<int> curve_offsets(selection.size() + 1);
   Array<int> point_offsets(selection.size() + 1);
 
-  int dst_curves_size = 0;
-  int dst_points_size = 0;
-  for (const int i_curve : selection.index_range()) {
-    const int count = std::max(counts[selection[i_curve]], 0);
-    curve_offsets[i_curve] = dst_curves_size;
-    point_offsets[i_curve] = dst_points_size;
-    dst_curves_size += count;
-    dst_points_size += count * curves.range_for_curve(selection[i_curve]).size();
-  }
-  curve_offsets.last() = dst_curves_size;
-  point_offsets.last() = dst_points_size;
+  threading::parallel_for(selection.index_range(), 4096, [&](IndexRange range) {
+    for (const int i_curve : range) {
+      const int count = std::max(counts[selection[i_curve]], 0);
+      curve_offsets[i_curve] = count;
+      point_offsets[i_curve] = count * curves.range_for_curve(selection[i_curve]).size();
+    }
+  });
+  const int dst_curves_size = accumulate_counts_in_place(curve_offsets);
+  const int dst_points_size = accumulate_counts_in_place(point_offsets);
 
   Curves *new_curves_id = bke::curves_new_nomain(dst_points_size, dst_curves_size);
   bke::CurvesGeometry &new_curves = bke::CurvesGeometry::wrap(new_curves_id->geometry);
@@ -470,13 +487,10 @@ static void copy_face_attributes_without_id(GeometrySet &geometry_set,
 /**
  * Copy the stable ids to the first duplicate and create new ids based on a hash of the original id
  * and the duplicate number. This function is used for points when duplicating the face domain.
- *
- * This function could be threaded in the future, but since it is only 1 attribute and the
- * `face->edge->vert` mapping would mean creating a 1/1 mapping to allow for it, is it worth it?
  */
-static void copy_stable_id_faces(const Mesh &mesh,
-                                 const IndexMask selection,
+static void copy_stable_id_faces(const IndexMask selection,
                                  const Span<int> poly_offsets,
+                                 const Span<int> loop_offsets,
                                  const Span<int> vert_mapping,
                                  const MeshComponent &src_component,
                                  MeshComponent &dst_component)
@@ -494,26 +508,26 @@ static void copy_stable_id_faces(const Mesh &mesh,
   VArray_Span<int> src{src_attribute.varray.typed<int>()};
   MutableSpan<int> dst = dst_attribute.as_span<int>();
 
-  Span<MPoly> polys(mesh.mpoly, mesh.totpoly);
-  int loop_index = 0;
-  for (const int i_poly : selection.index_range()) {
-    const IndexRange range = range_for_offsets_index(poly_offsets, i_poly);
-    if (range.size() == 0) {
-      continue;
-    }
-    const MPoly &source = polys[i_poly];
-    for ([[maybe_unused]] const int i_duplicate : IndexRange(range.size())) {
-      for ([[maybe_unused]] const int i_loops : IndexRange(source.totloop)) {
-        if (i_duplicate == 0) {
-          dst[loop_index] = src[vert_mapping[loop_index]];
-        }
-        else {
-          dst[loop_index] = noise::hash(src[vert_mapping[loop_index]], i_duplicate);
+  threading::parallel_for(selection.index_range(), 512, [&](IndexRange range) {
+    for (const int i_selection : range) {
+      const IndexRange poly_range = range_for_offsets_index(poly_offsets, i_selection);
+      if (poly_range.size() == 0) {
+        continue;
+      }
+      const IndexRange loop_range = range_for_offsets_index(loop_offsets, i_selection);
+      const int poly_size = loop_range.size() / poly_range.size();
+      for (const int i_duplicate : IndexRange(poly_range.size())) {
+        for (const int loop_index : loop_range.slice(i_duplicate * poly_size, poly_size)) {
+          if (i_duplicate == 0) {
+            dst[loop_index] = src[vert_mapping[loop_index]];
+          }
+          else {
+            dst[loop_index] = noise::hash(src[vert_mapping[loop_index]], i_duplicate);
+          }
         }
-        loop_index++;
       }
     }
-  }
+  });
 
   dst_attribute.save();
 }
@@ -544,16 +558,18 @@ static void duplicate_faces(GeometrySet &geometry_set,
   const IndexMask selection = evaluator.get_evaluated_selection_as_mask();
   const VArray<int> counts = evaluator.get_evaluated<int>(0);
 
-  int total_polys = 0;
-  int total_loops = 0;
+  /* The offsets of the duplicates of every selected face in the result polygons and loops. */
   Array<int> offsets(selection.size() + 1);
-  for (const int i_selection : selection.index_range()) {
-    const int count = std::max(counts[selection[i_selection]], 0);
-    offsets[i_selection] = total_polys;
-    total_polys += count;
-    total_loops += count * polys[selection[i_selection]].totloop;
-  }
-  offsets[selection.size()] = total_polys;
+  Array<int> loop_offsets(selection.size() + 1);
+  threading::parallel_for(selection.index_range(), 4096, [&](IndexRange range) {
+    for (const int i_selection : range) {
+      const int count = std::max(counts[selection[i_selection]], 0);
+      offsets[i_selection] = count;
+      loop_offsets[i_selection] = count * polys[selection[i_selection]].totloop;
+    }
+  });
+  const int total_polys = accumulate_counts_in_place(offsets);
+  const int total_loops = accumulate_counts_in_place(loop_offsets);
 
   Mesh *new_mesh = BKE_mesh_new_nomain(total_loops, total_loops, 0, total_loops, total_polys);
   MutableSpan<MVert> new_verts(new_mesh->mvert, new_mesh->totvert);
@@ -565,36 +581,36 @@ static void duplicate_faces(GeometrySet &geometry_set,
   Array<int> edge_mapping(new_edges.size());
   Array<int> loop_mapping(new_loops.size());
 
-  int poly_index = 0;
-  int loop_index = 0;
-  for (const int i_selection : selection.index_range()) {
-    const IndexRange poly_range = range_for_offsets_index(offsets, i_selection);
-
-    const MPoly &source = polys[selection[i_selection]];
-    for ([[maybe_unused]] const int i_duplicate : IndexRange(poly_range.size())) {
-      new_poly[poly_index] = source;
-      new_poly[poly_index].loopstart = loop_index;
-      for (const int i_loops : IndexRange(source.totloop)) {
-        const MLoop &current_loop = loops[source.loopstart + i_loops];
-        loop_mapping[loop_index] = source.loopstart + i_loops;
-        new_verts[loop_index] = verts[current_loop.v];
-        vert_mapping[loop_index] = current_loop.v;
-        new_edges[loop_index] = edges[current_loop.e];
-        edge_mapping[loop_index] = current_loop.e;
-        new_edges[loop_index].v1 = loop_index;
-        if (i_loops + 1 != source.totloop) {
-          new_edges[loop_index].v2 = loop_index + 1;
-        }
-        else {
-          new_edges[loop_index].v2 = new_poly[poly_index].loopstart;
+  threading::parallel_for(selection.index_range(), 512, [&](IndexRange range) {
+    for (const int i_selection : range) {
+      const IndexRange poly_range = range_for_offsets_index(offsets, i_selection);
+
+      const MPoly &source = polys[selection[i_selection]];
+      int loop_index = loop_offsets[i_selection];
+      for (const int poly_index : poly_range) {
+        new_poly[poly_index] = source;
+        new_poly[poly_index].loopstart = loop_index;
+        for (const int i_loops : IndexRange(source.totloop)) {
+          const MLoop &current_loop = loops[source.loopstart + i_loops];
+          loop_mapping[loop_index] = source.loopstart + i_loops;
+          new_verts[loop_index] = verts[current_loop.v];
+          vert_mapping[loop_index] = current_loop.v;
+          new_edges[loop_index] = edges[current_loop.e];
+          edge_mapping[loop_index] = current_loop.e;
+          new_edges[loop_index].v1 = loop_index;
+          if (i_loops + 1 != source.totloop) {
+            new_edges[loop_index].v2 = loop_index + 1;
+          }
+          else {
+            new_edges[loop_index].v2 = new_poly[poly_index].loopstart;
+          }
+          new_loops[loop_index].v = loop_index;
+          new_loops[loop_index].e = loop_index;
+          loop_index++;
         }
-        new_loops[loop_index].v = loop_index;
-        new_loops[loop_index].e = loop_index;
-        loop_index++;
       }
-      poly_index++;
     }
-  }
+  });
 
   MeshComponent dst_component;
   dst_component.replace(new_mesh, GeometryOwnershipType::Editable);
@@ -607,7 +623,8 @@ static void duplicate_faces(GeometrySet &geometry_set,
                                   src_component,
                                   dst_component);
 
-  copy_stable_id_faces(mesh, selection, offsets, vert_mapping, src_component, dst_component);
+  copy_stable_id_faces(
+      selection, offsets, loop_offsets, vert_mapping, src_component, dst_component);
 
   if (attributes.duplicate_index) {
     create_duplicate_index_attribute(
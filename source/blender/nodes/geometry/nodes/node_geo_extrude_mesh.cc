@@ -2,7 +2,6 @@
 
 #include "BLI_disjoint_set.hh"
 #include "BLI_task.hh"
-#include "BLI_vector_set.hh"
 
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
@@ -175,9 +174,11 @@ static MPoly new_poly(const int loopstart, const int totloop)
 template<typename T> void copy_with_indices(MutableSpan<T> dst, Span<T> src, Span<int> indices)
 {
   BLI_assert(dst.size() == indices.size());
-  for (const int i : dst.index_range()) {
-    dst[i] = src[indices[i]];
-  }
+  threading::parallel_for(dst.index_range(), 512, [&](const IndexRange range) {
+    for (const int i : range) {
+      dst[i] = src[indices[i]];
+    }
+  });
 }
 
 template<typename T> void copy_with_mask(MutableSpan<T> dst, Span<T> src, IndexMask mask)
@@ -208,18 +209,124 @@ void copy_with_mixing(MutableSpan<T> dst, Span<T> src, GetMixIndicesFn get_mix_i
   });
 }
 
-static Array<Vector<int>> create_vert_to_edge_map(const int vert_size,
-                                                  Span<MEdge> edges,
-                                                  const int vert_offset = 0)
+/**
+ * The indices of the elements connected to every element of another domain, stored in two flat
+ * arrays instead of a separate allocation for every element.
+ */
+struct GroupedIndices {
+  /** The start of every group in #indices, with an extra element for the end of the last group. */
+  Array<int> offsets;
+  Array<int> indices;
+
+  Span<int> operator[](const int group) const
+  {
+    return indices.as_span().slice(offsets[group], offsets[group + 1] - offsets[group]);
+  }
+};
+
+/**
+ * Allocate the groups, with the number of indices in every group given by \a counts.
+ * Return the start of every group, to keep track of the next index to fill in.
+ */
+static Array<int> grouped_indices_init(GroupedIndices &groups, const Span<int> counts)
+{
+  groups.offsets.reinitialize(counts.size() + 1);
+  int offset = 0;
+  for (const int i : counts.index_range()) {
+    groups.offsets[i] = offset;
+    offset += counts[i];
+  }
+  groups.offsets.last() = offset;
+  groups.indices.reinitialize(offset);
+  return groups.offsets.as_span().drop_back(1);
+}
+
+static GroupedIndices create_vert_to_edge_map(const int vert_size,
+                                              Span<MEdge> edges,
+                                              const int vert_offset = 0)
 {
-  Array<Vector<int>> vert_to_edge_map(vert_size);
+  Array<int> counts(vert_size, 0);
+  for (const MEdge &edge : edges) {
+    counts[edge.v1 - vert_offset]++;
+    counts[edge.v2 - vert_offset]++;
+  }
+  GroupedIndices vert_to_edge_map;
+  Array<int> cursors = grouped_indices_init(vert_to_edge_map, counts);
   for (const int i : edges.index_range()) {
-    vert_to_edge_map[edges[i].v1 - vert_offset].append(i);
-    vert_to_edge_map[edges[i].v2 - vert_offset].append(i);
+    vert_to_edge_map.indices[cursors[edges[i].v1 - vert_offset]++] = i;
+    vert_to_edge_map.indices[cursors[edges[i].v2 - vert_offset]++] = i;
   }
   return vert_to_edge_map;
 }
 
+/**
+ * Unique indices in the order they were added, like a #VectorSet, but with a map from every index
+ * in the domain to its position. That avoids hashing, and lookups are cheap enough to do once for
+ * every element of the mesh.
+ */
+class OrderedIndexSet {
+ private:
+  Vector<int> indices_;
+  Array<int> positions_;
+
+ public:
+  OrderedIndexSet(const int domain_size) : positions_(domain_size, -1)
+  {
+  }
+
+  void add(const int index)
+  {
+    if (positions_[index] == -1) {
+      positions_[index] = indices_.size();
+      indices_.append(index);
+    }
+  }
+
+  void add_new(const int index)
+  {
+    BLI_assert(positions_[index] == -1);
+    positions_[index] = indices_.size();
+    indices_.append(index);
+  }
+
+  int index_of(const int index) const
+  {
+    BLI_assert(positions_[index] != -1);
+    return positions_[index];
+  }
+
+  /** Return -1 if the index hasn't been added. */
+  int index_of_try(const int index) const
+  {
+    return positions_[index];
+  }
+
+  int operator[](const int64_t i) const
+  {
+    return indices_[i];
+  }
+
+  int64_t size() const
+  {
+    return indices_.size();
+  }
+
+  IndexRange index_range() const
+  {
+    return indices_.index_range();
+  }
+
+  Span<int> as_span() const
+  {
+    return indices_;
+  }
+
+  operator Span<int>() const
+  {
+    return indices_;
+  }
+};
+
 static void extrude_mesh_vertices(MeshComponent &component,
                                   const Field<bool> &selection_field,
                                   const Field<float3> &offset_field,
@@ -238,7 +345,8 @@ static void extrude_mesh_vertices(MeshComponent &component,
   const VArray<float3> offsets = evaluator.get_evaluated<float3>(0);
 
   /* This allows parallelizing attribute mixing for new edges. */
-  Array<Vector<int>> vert_to_edge_map = create_vert_to_edge_map(orig_vert_size, mesh_edges(mesh));
+  const GroupedIndices vert_to_edge_map = create_vert_to_edge_map(orig_vert_size,
+                                                                  mesh_edges(mesh));
 
   expand_mesh(mesh, selection.size(), selection.size(), 0, 0);
 
@@ -248,9 +356,12 @@ static void extrude_mesh_vertices(MeshComponent &component,
   MutableSpan<MVert> new_verts = mesh_verts(mesh).slice(new_vert_range);
   MutableSpan<MEdge> new_edges = mesh_edges(mesh).slice(new_edge_range);
 
-  for (const int i_selection : selection.index_range()) {
-    new_edges[i_selection] = new_loose_edge(selection[i_selection], new_vert_range[i_selection]);
-  }
+  threading::parallel_for(selection.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i_selection : range) {
+      new_edges[i_selection] = new_loose_edge(selection[i_selection],
+                                              new_vert_range[i_selection]);
+    }
+  });
 
   component.attribute_foreach([&](const AttributeIDRef &id, const AttributeMetaData meta_data) {
     if (!ELEM(meta_data.domain, ATTR_DOMAIN_POINT, ATTR_DOMAIN_EDGE)) {
@@ -270,7 +381,7 @@ static void extrude_mesh_vertices(MeshComponent &component,
         case ATTR_DOMAIN_EDGE: {
           /* New edge values are mixed from of all the edges connected to the source vertex. */
           copy_with_mixing(data.slice(new_edge_range), data.as_span(), [&](const int i) {
-            return vert_to_edge_map[selection[i]].as_span();
+            return vert_to_edge_map[selection[i]];
           });
           break;
         }
@@ -304,16 +415,21 @@ static void extrude_mesh_vertices(MeshComponent &component,
   BKE_mesh_runtime_clear_cache(&mesh);
 }
 
-static Array<Vector<int, 2>> mesh_calculate_polys_of_edge(const Mesh &mesh)
+static GroupedIndices mesh_calculate_polys_of_edge(const Mesh &mesh)
 {
   Span<MPoly> polys = mesh_polys(mesh);
   Span<MLoop> loops = mesh_loops(mesh);
-  Array<Vector<int, 2>> polys_of_edge(mesh.totedge);
 
+  Array<int> counts(mesh.totedge, 0);
+  for (const MLoop &loop : loops) {
+    counts[loop.e]++;
+  }
+  GroupedIndices polys_of_edge;
+  Array<int> cursors = grouped_indices_init(polys_of_edge, counts);
   for (const int i_poly : polys.index_range()) {
     const MPoly &poly = polys[i_poly];
     for (const MLoop &loop : loops.slice(poly.loopstart, poly.totloop)) {
-      polys_of_edge[loop.e].append(i_poly);
+      polys_of_edge.indices[cursors[loop.e]++] = i_poly;
     }
   }
 
@@ -362,12 +478,11 @@ static void fill_quad_consistent_direction(Span<MLoop> other_poly_loops,
 }
 
 template<typename T>
-static VectorSet<int> vert_indices_from_edges(const Mesh &mesh, const Span<T> edge_indices)
+static OrderedIndexSet vert_indices_from_edges(const Mesh &mesh, const Span<T> edge_indices)
 {
   static_assert(is_same_any_v<T, int, int64_t>);
 
-  VectorSet<int> vert_indices;
-  vert_indices.reserve(edge_indices.size());
+  OrderedIndexSet vert_indices(mesh.totvert);
   for (const T i_edge : edge_indices) {
     const MEdge &edge = mesh.medge[i_edge];
     vert_indices.add(edge.v1);
@@ -398,7 +513,7 @@ static void extrude_mesh_edges(MeshComponent &component,
     return;
   }
 
-  const Array<Vector<int, 2>> edge_to_poly_map = mesh_calculate_polys_of_edge(mesh);
+  const GroupedIndices edge_to_poly_map = mesh_calculate_polys_of_edge(mesh);
 
   /* Find the offsets on the vertex domain for translation. This must be done before the mesh's
    * custom data layers are reallocated, in case the virtual array references on of them. */
@@ -415,7 +530,8 @@ static void extrude_mesh_edges(MeshComponent &component,
     mixer.finalize();
   }
 
-  const VectorSet<int> new_vert_indices = vert_indices_from_edges(mesh, edge_selection.indices());
+  const OrderedIndexSet new_vert_indices = vert_indices_from_edges(mesh,
+                                                                   edge_selection.indices());
 
   const IndexRange new_vert_range{orig_vert_size, new_vert_indices.size()};
   /* The extruded edges connect the original and duplicate edges. */
@@ -441,56 +557,65 @@ static void extrude_mesh_edges(MeshComponent &component,
   MutableSpan<MLoop> loops = mesh_loops(mesh);
   MutableSpan<MLoop> new_loops = loops.slice(new_loop_range);
 
-  for (const int i : connect_edges.index_range()) {
-    connect_edges[i] = new_edge(new_vert_indices[i], new_vert_range[i]);
-  }
-
-  for (const int i : duplicate_edges.index_range()) {
-    const MEdge &orig_edge = mesh.medge[edge_selection[i]];
-    const int i_new_vert_1 = new_vert_indices.index_of(orig_edge.v1);
-    const int i_new_vert_2 = new_vert_indices.index_of(orig_edge.v2);
-    duplicate_edges[i] = new_edge(new_vert_range[i_new_vert_1], new_vert_range[i_new_vert_2]);
-  }
-
-  for (const int i : new_polys.index_range()) {
-    new_polys[i] = new_poly(new_loop_range[i * 4], 4);
-  }
-
-  for (const int i : edge_selection.index_range()) {
-    const int orig_edge_index = edge_selection[i];
+  threading::parallel_for(connect_edges.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      connect_edges[i] = new_edge(new_vert_indices[i], new_vert_range[i]);
+    }
+  });
 
-    const MEdge &duplicate_edge = duplicate_edges[i];
-    const int new_vert_1 = duplicate_edge.v1;
-    const int new_vert_2 = duplicate_edge.v2;
-    const int extrude_index_1 = new_vert_1 - orig_vert_size;
-    const int extrude_index_2 = new_vert_2 - orig_vert_size;
+  threading::parallel_for(duplicate_edges.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const MEdge &orig_edge = mesh.medge[edge_selection[i]];
+      const int i_new_vert_1 = new_vert_indices.index_of(orig_edge.v1);
+      const int i_new_vert_2 = new_vert_indices.index_of(orig_edge.v2);
+      duplicate_edges[i] = new_edge(new_vert_range[i_new_vert_1], new_vert_range[i_new_vert_2]);
+    }
+  });
 
-    Span<int> connected_polys = edge_to_poly_map[orig_edge_index];
+  threading::parallel_for(new_polys.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      new_polys[i] = new_poly(new_loop_range[i * 4], 4);
+    }
+  });
 
-    /* When there was a single polygon connected to the new polygon, we can use the old one to keep
-     * the face direction consistent. When there is more than one connected edge, the new face
-     * direction is totally arbitrary and the only goal for the behavior is to be deterministic. */
-    Span<MLoop> connected_poly_loops = {};
-    if (connected_polys.size() == 1) {
-      const MPoly &connected_poly = polys[connected_polys.first()];
-      connected_poly_loops = loops.slice(connected_poly.loopstart, connected_poly.totloop);
+  threading::parallel_for(edge_selection.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int orig_edge_index = edge_selection[i];
+
+      const MEdge &duplicate_edge = duplicate_edges[i];
+      const int new_vert_1 = duplicate_edge.v1;
+      const int new_vert_2 = duplicate_edge.v2;
+      const int extrude_index_1 = new_vert_1 - orig_vert_size;
+      const int extrude_index_2 = new_vert_2 - orig_vert_size;
+
+      Span<int> connected_polys = edge_to_poly_map[orig_edge_index];
+
+      /* When there was a single polygon connected to the new polygon, we can use the old one to
+       * keep the face direction consistent. When there is more than one connected edge, the new
+       * face direction is totally arbitrary and the only goal for the behavior is to be
+       * deterministic. */
+      Span<MLoop> connected_poly_loops = {};
+      if (connected_polys.size() == 1) {
+        const MPoly &connected_poly = polys[connected_polys.first()];
+        connected_poly_loops = loops.slice(connected_poly.loopstart, connected_poly.totloop);
+      }
+      fill_quad_consistent_direction(connected_poly_loops,
+                                     new_loops.slice(4 * i, 4),
+                                     new_vert_indices[extrude_index_1],
+                                     new_vert_indices[extrude_index_2],
+                                     new_vert_1,
+                                     new_vert_2,
+                                     orig_edge_index,
+                                     connect_edge_range[extrude_index_1],
+                                     duplicate_edge_range[i],
+                                     connect_edge_range[extrude_index_2]);
     }
-    fill_quad_consistent_direction(connected_poly_loops,
-                                   new_loops.slice(4 * i, 4),
-                                   new_vert_indices[extrude_index_1],
-                                   new_vert_indices[extrude_index_2],
-                                   new_vert_1,
-                                   new_vert_2,
-                                   orig_edge_index,
-                                   connect_edge_range[extrude_index_1],
-                                   duplicate_edge_range[i],
-                                   connect_edge_range[extrude_index_2]);
-  }
+  });
 
   /* Create a map of indices in the extruded vertices array to all of the indices of edges
    * in the duplicate edges array that connect to that vertex. This can be used to simplify the
    * mixing of attribute data for the connecting edges. */
-  const Array<Vector<int>> new_vert_to_duplicate_edge_map = create_vert_to_edge_map(
+  const GroupedIndices new_vert_to_duplicate_edge_map = create_vert_to_edge_map(
       new_vert_range.size(), duplicate_edges, orig_vert_size);
 
   component.attribute_foreach([&](const AttributeIDRef &id, const AttributeMetaData meta_data) {
@@ -517,7 +642,7 @@ static void extrude_mesh_edges(MeshComponent &component,
           /* Edges connected to original vertices mix values of selected connected edges. */
           MutableSpan<T> connect_data = data.slice(connect_edge_range);
           copy_with_mixing(connect_data, duplicate_data.as_span(), [&](const int i_new_vert) {
-            return new_vert_to_duplicate_edge_map[i_new_vert].as_span();
+            return new_vert_to_duplicate_edge_map[i_new_vert];
           });
           break;
         }
@@ -525,7 +650,7 @@ static void extrude_mesh_edges(MeshComponent &component,
           /* Attribute values for new faces are a mix of the values of faces connected to the its
            * original edge.  */
           copy_with_mixing(data.slice(new_poly_range), data.as_span(), [&](const int i) {
-            return edge_to_poly_map[edge_selection[i]].as_span();
+            return edge_to_poly_map[edge_selection[i]];
           });
 
           break;
@@ -654,9 +779,11 @@ static void extrude_mesh_face_regions(MeshComponent &component,
   }
 
   Array<bool> poly_selection_array(orig_polys.size(), false);
-  for (const int i_poly : poly_selection) {
-    poly_selection_array[i_poly] = true;
-  }
+  threading::parallel_for(poly_selection.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i_poly : poly_selection.slice(range)) {
+      poly_selection_array[i_poly] = true;
+    }
+  });
 
   /* Mix the offsets from the face domain to the vertex domain. Evaluate on the face domain above
    * in order to be consistent with the selection, and to use the face normals rather than vertex
@@ -676,22 +803,20 @@ static void extrude_mesh_face_regions(MeshComponent &component,
   }
 
   /* All of the faces (selected and deselected) connected to each edge. */
-  const Array<Vector<int, 2>> edge_to_poly_map = mesh_calculate_polys_of_edge(mesh);
+  const GroupedIndices edge_to_poly_map = mesh_calculate_polys_of_edge(mesh);
 
-  /* All vertices that are connected to the selected polygons.
-   * Start the size at one vert per poly to reduce unnecessary reallocation. */
-  VectorSet<int> all_selected_verts;
-  all_selected_verts.reserve(orig_polys.size());
+  /* All vertices that are connected to the selected polygons. */
+  Array<bool> all_selected_verts(orig_vert_size, false);
   for (const int i_poly : poly_selection) {
     const MPoly &poly = orig_polys[i_poly];
     for (const MLoop &loop : orig_loops.slice(poly.loopstart, poly.totloop)) {
-      all_selected_verts.add(loop.v);
+      all_selected_verts[loop.v] = true;
     }
   }
 
   /* Edges inside of an extruded region that are also attached to deselected edges. They must be
    * duplicated in order to leave the old edge attached to the unchanged deselected faces. */
-  VectorSet<int> new_inner_edge_indices;
+  OrderedIndexSet new_inner_edge_indices(orig_edges.size());
   /* Edges inside of an extruded region. Their vertices should be translated
    * with the offset, but the edges themselves should not be duplicated. */
   Vector<int> inner_edge_indices;
@@ -699,50 +824,68 @@ static void extrude_mesh_face_regions(MeshComponent &component,
   Vector<int> edge_extruded_face_indices;
   /* Edges on the outside of selected regions, either because there are no
    * other connected faces, or because all of the other faces aren't selected. */
-  VectorSet<int> boundary_edge_indices;
-  for (const int i_edge : orig_edges.index_range()) {
-    Span<int> polys = edge_to_poly_map[i_edge];
-
-    int i_selected_poly = -1;
-    int deselected_poly_count = 0;
-    int selected_poly_count = 0;
-    for (const int i_other_poly : polys) {
-      if (poly_selection_array[i_other_poly]) {
-        selected_poly_count++;
-        i_selected_poly = i_other_poly;
+  OrderedIndexSet boundary_edge_indices(orig_edges.size());
+
+  /* Find the selected polygon connected to every edge in parallel, or -1 if there is none or
+   * more than one. Inner edges use -2 and -3 to tell whether they are also attached to
+   * deselected faces. The edges are added to the lists in order of their indices below. */
+  enum { EDGE_NOT_SELECTED = -1, EDGE_INNER = -2, EDGE_NEW_INNER = -3 };
+  Array<int> edge_selected_polys(orig_edges.size());
+  threading::parallel_for(orig_edges.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i_edge : range) {
+      int i_selected_poly = -1;
+      int deselected_poly_count = 0;
+      int selected_poly_count = 0;
+      for (const int i_other_poly : edge_to_poly_map[i_edge]) {
+        if (poly_selection_array[i_other_poly]) {
+          selected_poly_count++;
+          i_selected_poly = i_other_poly;
+        }
+        else {
+          deselected_poly_count++;
+        }
+      }
+
+      if (selected_poly_count == 1) {
+        edge_selected_polys[i_edge] = i_selected_poly;
+      }
+      else if (selected_poly_count > 1) {
+        edge_selected_polys[i_edge] = deselected_poly_count > 0 ? EDGE_NEW_INNER : EDGE_INNER;
       }
       else {
-        deselected_poly_count++;
+        edge_selected_polys[i_edge] = EDGE_NOT_SELECTED;
       }
     }
+  });
 
-    if (selected_poly_count == 1) {
+  for (const int i_edge : orig_edges.index_range()) {
+    const int i_selected_poly = edge_selected_polys[i_edge];
+    if (i_selected_poly >= 0) {
       /* If there is only one selected polygon connected to the edge,
        * the edge should be extruded to form a "side face". */
       boundary_edge_indices.add_new(i_edge);
       edge_extruded_face_indices.append(i_selected_poly);
     }
-    else if (selected_poly_count > 1) {
-      /* The edge is inside an extruded region of faces. */
-      if (deselected_poly_count > 0) {
-        /* Add edges that are also connected to deselected edges to a separate list. */
-        new_inner_edge_indices.add_new(i_edge);
-      }
-      else {
-        /* Otherwise, just keep track of edges inside the region so that
-         * we can reattach them to duplicated vertices if necessary. */
-        inner_edge_indices.append(i_edge);
-      }
+    else if (i_selected_poly == EDGE_NEW_INNER) {
+      /* The edge is inside an extruded region of faces. Add edges that are also connected to
+       * deselected edges to a separate list. */
+      new_inner_edge_indices.add_new(i_edge);
+    }
+    else if (i_selected_poly == EDGE_INNER) {
+      /* Otherwise, just keep track of edges inside the region so that
+       * we can reattach them to duplicated vertices if necessary. */
+      inner_edge_indices.append(i_edge);
     }
   }
 
-  VectorSet<int> new_vert_indices = vert_indices_from_edges(mesh, boundary_edge_indices.as_span());
+  OrderedIndexSet new_vert_indices = vert_indices_from_edges(mesh,
+                                                             boundary_edge_indices.as_span());
   /* Before adding the rest of the new vertices from the new inner edges, store the number
    * of new vertices from the boundary edges, since this is the number of connecting edges. */
   const int extruded_vert_size = new_vert_indices.size();
 
   /* The vertices attached to duplicate inner edges also have to be duplicated. */
-  for (const int i_edge : new_inner_edge_indices) {
+  for (const int i_edge : new_inner_edge_indices.as_span()) {
     const MEdge &edge = mesh.medge[i_edge];
     new_vert_indices.add(edge.v1);
     new_vert_indices.add(edge.v2);
@@ -777,91 +920,105 @@ static void extrude_mesh_face_regions(MeshComponent &component,
   MutableSpan<MLoop> new_loops = loops.slice(side_loop_range);
 
   /* Initialize the edges that form the sides of the extrusion. */
-  for (const int i : connect_edges.index_range()) {
-    connect_edges[i] = new_edge(new_vert_indices[i], new_vert_range[i]);
-  }
+  threading::parallel_for(connect_edges.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      connect_edges[i] = new_edge(new_vert_indices[i], new_vert_range[i]);
+    }
+  });
 
   /* Initialize the edges that form the top of the extrusion. */
-  for (const int i : boundary_edges.index_range()) {
-    const MEdge &orig_edge = edges[boundary_edge_indices[i]];
-    const int i_new_vert_1 = new_vert_indices.index_of(orig_edge.v1);
-    const int i_new_vert_2 = new_vert_indices.index_of(orig_edge.v2);
-    boundary_edges[i] = new_edge(new_vert_range[i_new_vert_1], new_vert_range[i_new_vert_2]);
-  }
+  threading::parallel_for(boundary_edges.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const MEdge &orig_edge = edges[boundary_edge_indices[i]];
+      const int i_new_vert_1 = new_vert_indices.index_of(orig_edge.v1);
+      const int i_new_vert_2 = new_vert_indices.index_of(orig_edge.v2);
+      boundary_edges[i] = new_edge(new_vert_range[i_new_vert_1], new_vert_range[i_new_vert_2]);
+    }
+  });
 
   /* Initialize the new edges inside of extrude regions. */
-  for (const int i : new_inner_edge_indices.index_range()) {
-    const MEdge &orig_edge = edges[new_inner_edge_indices[i]];
-    const int i_new_vert_1 = new_vert_indices.index_of(orig_edge.v1);
-    const int i_new_vert_2 = new_vert_indices.index_of(orig_edge.v2);
-    new_inner_edges[i] = new_edge(new_vert_range[i_new_vert_1], new_vert_range[i_new_vert_2]);
-  }
+  threading::parallel_for(new_inner_edges.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const MEdge &orig_edge = edges[new_inner_edge_indices[i]];
+      const int i_new_vert_1 = new_vert_indices.index_of(orig_edge.v1);
+      const int i_new_vert_2 = new_vert_indices.index_of(orig_edge.v2);
+      new_inner_edges[i] = new_edge(new_vert_range[i_new_vert_1], new_vert_range[i_new_vert_2]);
+    }
+  });
 
   /* Initialize the new side polygons. */
-  for (const int i : new_polys.index_range()) {
-    new_polys[i] = new_poly(side_loop_range[i * 4], 4);
-  }
+  threading::parallel_for(new_polys.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      new_polys[i] = new_poly(side_loop_range[i * 4], 4);
+    }
+  });
 
   /* Connect original edges inside face regions to any new vertices, if necessary. */
-  for (const int i : inner_edge_indices) {
-    MEdge &edge = edges[i];
-    const int i_new_vert_1 = new_vert_indices.index_of_try(edge.v1);
-    const int i_new_vert_2 = new_vert_indices.index_of_try(edge.v2);
-    if (i_new_vert_1 != -1) {
-      edge.v1 = new_vert_range[i_new_vert_1];
-    }
-    if (i_new_vert_2 != -1) {
-      edge.v2 = new_vert_range[i_new_vert_2];
+  threading::parallel_for(inner_edge_indices.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : inner_edge_indices.as_span().slice(range)) {
+      MEdge &edge = edges[i];
+      const int i_new_vert_1 = new_vert_indices.index_of_try(edge.v1);
+      const int i_new_vert_2 = new_vert_indices.index_of_try(edge.v2);
+      if (i_new_vert_1 != -1) {
+        edge.v1 = new_vert_range[i_new_vert_1];
+      }
+      if (i_new_vert_2 != -1) {
+        edge.v2 = new_vert_range[i_new_vert_2];
+      }
     }
-  }
+  });
 
   /* Connect the selected faces to the extruded or duplicated edges and the new vertices. */
-  for (const int i_poly : poly_selection) {
-    const MPoly &poly = polys[i_poly];
-    for (MLoop &loop : loops.slice(poly.loopstart, poly.totloop)) {
-      const int i_new_vert = new_vert_indices.index_of_try(loop.v);
-      if (i_new_vert != -1) {
-        loop.v = new_vert_range[i_new_vert];
-      }
-      const int i_boundary_edge = boundary_edge_indices.index_of_try(loop.e);
-      if (i_boundary_edge != -1) {
-        loop.e = boundary_edge_range[i_boundary_edge];
-        /* Skip the next check, an edge cannot be both a boundary edge and an inner edge. */
-        continue;
-      }
-      const int i_new_inner_edge = new_inner_edge_indices.index_of_try(loop.e);
-      if (i_new_inner_edge != -1) {
-        loop.e = new_inner_edge_range[i_new_inner_edge];
+  threading::parallel_for(poly_selection.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i_poly : poly_selection.slice(range)) {
+      const MPoly &poly = polys[i_poly];
+      for (MLoop &loop : loops.slice(poly.loopstart, poly.totloop)) {
+        const int i_new_vert = new_vert_indices.index_of_try(loop.v);
+        if (i_new_vert != -1) {
+          loop.v = new_vert_range[i_new_vert];
+        }
+        const int i_boundary_edge = boundary_edge_indices.index_of_try(loop.e);
+        if (i_boundary_edge != -1) {
+          loop.e = boundary_edge_range[i_boundary_edge];
+          /* Skip the next check, an edge cannot be both a boundary edge and an inner edge. */
+          continue;
+        }
+        const int i_new_inner_edge = new_inner_edge_indices.index_of_try(loop.e);
+        if (i_new_inner_edge != -1) {
+          loop.e = new_inner_edge_range[i_new_inner_edge];
+        }
       }
     }
-  }
+  });
 
   /* Create the faces on the sides of extruded regions. */
-  for (const int i : boundary_edge_indices.index_range()) {
-    const MEdge &boundary_edge = boundary_edges[i];
-    const int new_vert_1 = boundary_edge.v1;
-    const int new_vert_2 = boundary_edge.v2;
-    const int extrude_index_1 = new_vert_1 - orig_vert_size;
-    const int extrude_index_2 = new_vert_2 - orig_vert_size;
-
-    const MPoly &extrude_poly = polys[edge_extruded_face_indices[i]];
-
-    fill_quad_consistent_direction(loops.slice(extrude_poly.loopstart, extrude_poly.totloop),
-                                   new_loops.slice(4 * i, 4),
-                                   new_vert_1,
-                                   new_vert_2,
-                                   new_vert_indices[extrude_index_1],
-                                   new_vert_indices[extrude_index_2],
-                                   boundary_edge_range[i],
-                                   connect_edge_range[extrude_index_1],
-                                   boundary_edge_indices[i],
-                                   connect_edge_range[extrude_index_2]);
-  }
+  threading::parallel_for(boundary_edge_indices.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const MEdge &boundary_edge = boundary_edges[i];
+      const int new_vert_1 = boundary_edge.v1;
+      const int new_vert_2 = boundary_edge.v2;
+      const int extrude_index_1 = new_vert_1 - orig_vert_size;
+      const int extrude_index_2 = new_vert_2 - orig_vert_size;
+
+      const MPoly &extrude_poly = polys[edge_extruded_face_indices[i]];
+
+      fill_quad_consistent_direction(loops.slice(extrude_poly.loopstart, extrude_poly.totloop),
+                                     new_loops.slice(4 * i, 4),
+                                     new_vert_1,
+                                     new_vert_2,
+                                     new_vert_indices[extrude_index_1],
+                                     new_vert_indices[extrude_index_2],
+                                     boundary_edge_range[i],
+                                     connect_edge_range[extrude_index_1],
+                                     boundary_edge_indices[i],
+                                     connect_edge_range[extrude_index_2]);
+    }
+  });
 
   /* Create a map of indices in the extruded vertices array to all of the indices of edges
    * in the duplicate edges array that connect to that vertex. This can be used to simplify the
    * mixing of attribute data for the connecting edges. */
-  const Array<Vector<int>> new_vert_to_duplicate_edge_map = create_vert_to_edge_map(
+  const GroupedIndices new_vert_to_duplicate_edge_map = create_vert_to_edge_map(
       new_vert_range.size(), boundary_edges, orig_vert_size);
 
   component.attribute_foreach([&](const AttributeIDRef &id, const AttributeMetaData meta_data) {
@@ -892,7 +1049,7 @@ static void extrude_mesh_face_regions(MeshComponent &component,
           /* Edges connected to original vertices mix values of selected connected edges. */
           MutableSpan<T> connect_data = data.slice(connect_edge_range);
           copy_with_mixing(connect_data, boundary_data.as_span(), [&](const int i) {
-            return new_vert_to_duplicate_edge_map[i].as_span();
+            return new_vert_to_duplicate_edge_map[i];
           });
           break;
         }
@@ -962,25 +1119,29 @@ static void extrude_mesh_face_regions(MeshComponent &component,
    * still need an offset, but it was reused on the inside of a region of extruded faces. */
   if (poly_offsets.is_single()) {
     const float3 offset = poly_offsets.get_internal_single();
-    threading::parallel_for(
-        IndexRange(all_selected_verts.size()), 1024, [&](const IndexRange range) {
-          for (const int i_orig : all_selected_verts.as_span().slice(range)) {
-            const int i_new = new_vert_indices.index_of_try(i_orig);
-            MVert &vert = mesh_verts(mesh)[(i_new == -1) ? i_orig : new_vert_range[i_new]];
-            add_v3_v3(vert.co, offset);
-          }
-        });
+    threading::parallel_for(IndexRange(orig_vert_size), 1024, [&](const IndexRange range) {
+      for (const int i_orig : range) {
+        if (!all_selected_verts[i_orig]) {
+          continue;
+        }
+        const int i_new = new_vert_indices.index_of_try(i_orig);
+        MVert &vert = mesh_verts(mesh)[(i_new == -1) ? i_orig : new_vert_range[i_new]];
+        add_v3_v3(vert.co, offset);
+      }
+    });
   }
   else {
-    threading::parallel_for(
-        IndexRange(all_selected_verts.size()), 1024, [&](const IndexRange range) {
-          for (const int i_orig : all_selected_verts.as_span().slice(range)) {
-            const int i_new = new_vert_indices.index_of_try(i_orig);
-            const float3 offset = vert_offsets[i_orig];
-            MVert &vert = mesh_verts(mesh)[(i_new == -1) ? i_orig : new_vert_range[i_new]];
-            add_v3_v3(vert.co, offset);
-          }
-        });
+    threading::parallel_for(IndexRange(orig_vert_size), 1024, [&](const IndexRange range) {
+      for (const int i_orig : range) {
+        if (!all_selected_verts[i_orig]) {
+          continue;
+        }
+        const int i_new = new_vert_indices.index_of_try(i_orig);
+        const float3 offset = vert_offsets[i_orig];
+        MVert &vert = mesh_verts(mesh)[(i_new == -1) ? i_orig : new_vert_range[i_new]];
+        add_v3_v3(vert.co, offset);
+      }
+    });
   }
 
   if (attribute_outputs.top_id) {
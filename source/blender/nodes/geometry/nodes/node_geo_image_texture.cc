@@ -117,9 +117,29 @@ class ImageFieldsFunction : public fn::MultiFunction {
     if (px < 0 || py < 0 || px >= ibuf->x || py >= ibuf->y) {
       return float4(0.0f, 0.0f, 0.0f, 0.0f);
     }
+    return image_pixel_lookup_unchecked(ibuf, px, py);
+  }
+
+  static float4 image_pixel_lookup_unchecked(const ImBuf *ibuf, const int px, const int py)
+  {
     return ((const float4 *)ibuf->rect_float)[px + py * ibuf->x];
   }
 
+  /**
+   * Only the clip extension can produce pixel coordinates outside of the image, with the other
+   * modes the coordinates are wrapped or clamped already.
+   */
+  template<int extension>
+  static float4 image_pixel_lookup_for_extension(const ImBuf *ibuf, const int px, const int py)
+  {
+    if constexpr (extension == SHD_IMAGE_EXTENSION_CLIP) {
+      return image_pixel_lookup(ibuf, px, py);
+    }
+    else {
+      return image_pixel_lookup_unchecked(ibuf, px, py);
+    }
+  }
+
   static float frac(const float x, int *ix)
   {
     const int i = (int)x - ((x < 0.0f) ? 1 : 0);
@@ -127,10 +147,8 @@ class ImageFieldsFunction : public fn::MultiFunction {
     return x - (float)i;
   }
 
-  static float4 image_cubic_texture_lookup(const ImBuf *ibuf,
-                                           const float px,
-                                           const float py,
-                                           const int extension)
+  template<int extension>
+  static float4 image_cubic_texture_lookup(const ImBuf *ibuf, const float px, const float py)
   {
     const int width = ibuf->x;
     const int height = ibuf->y;
@@ -139,40 +157,33 @@ class ImageFieldsFunction : public fn::MultiFunction {
     const float ty = frac(py * (float)height - 0.5f, &piy);
     int ppix, ppiy, nnix, nniy;
 
-    switch (extension) {
-      case SHD_IMAGE_EXTENSION_REPEAT: {
-        pix = wrap_periodic(pix, width);
-        piy = wrap_periodic(piy, height);
-        ppix = wrap_periodic(pix - 1, width);
-        ppiy = wrap_periodic(piy - 1, height);
-        nix = wrap_periodic(pix + 1, width);
-        niy = wrap_periodic(piy + 1, height);
-        nnix = wrap_periodic(pix + 2, width);
-        nniy = wrap_periodic(piy + 2, height);
-        break;
-      }
-      case SHD_IMAGE_EXTENSION_CLIP: {
-        ppix = pix - 1;
-        ppiy = piy - 1;
-        nix = pix + 1;
-        niy = piy + 1;
-        nnix = pix + 2;
-        nniy = piy + 2;
-        break;
-      }
-      case SHD_IMAGE_EXTENSION_EXTEND: {
-        ppix = wrap_clamp(pix - 1, width);
-        ppiy = wrap_clamp(piy - 1, height);
-        nix = wrap_clamp(pix + 1, width);
-        niy = wrap_clamp(piy + 1, height);
-        nnix = wrap_clamp(pix + 2, width);
-        nniy = wrap_clamp(piy + 2, height);
-        pix = wrap_clamp(pix, width);
-        piy = wrap_clamp(piy, height);
-        break;
-      }
-      default:
-        return float4(0.0f, 0.0f, 0.0f, 0.0f);
+    if constexpr (extension == SHD_IMAGE_EXTENSION_REPEAT) {
+      pix = wrap_periodic(pix, width);
+      piy = wrap_periodic(piy, height);
+      ppix = wrap_periodic(pix - 1, width);
+      ppiy = wrap_periodic(piy - 1, height);
+      nix = wrap_periodic(pix + 1, width);
+      niy = wrap_periodic(piy + 1, height);
+      nnix = wrap_periodic(pix + 2, width);
+      nniy = wrap_periodic(piy + 2, height);
+    }
+    else if constexpr (extension == SHD_IMAGE_EXTENSION_CLIP) {
+      ppix = pix - 1;
+      ppiy = piy - 1;
+      nix = pix + 1;
+      niy = piy + 1;
+      nnix = pix + 2;
+      nniy = piy + 2;
+    }
+    else {
+      ppix = wrap_clamp(pix - 1, width);
+      ppiy = wrap_clamp(piy - 1, height);
+      nix = wrap_clamp(pix + 1, width);
+      niy = wrap_clamp(piy + 1, height);
+      nnix = wrap_clamp(pix + 2, width);
+      nniy = wrap_clamp(piy + 2, height);
+      pix = wrap_clamp(pix, width);
+      piy = wrap_clamp(piy, height);
     }
 
     const int xc[4] = {ppix, pix, nix, nnix};
@@ -189,28 +200,27 @@ class ImageFieldsFunction : public fn::MultiFunction {
     v[2] = ((-0.5f * ty + 0.5f) * ty + 0.5f) * ty + (1.0f / 6.0f);
     v[3] = (1.0f / 6.0f) * ty * ty * ty;
 
-    return (v[0] * (u[0] * (image_pixel_lookup(ibuf, xc[0], yc[0])) +
-                    u[1] * (image_pixel_lookup(ibuf, xc[1], yc[0])) +
-                    u[2] * (image_pixel_lookup(ibuf, xc[2], yc[0])) +
-                    u[3] * (image_pixel_lookup(ibuf, xc[3], yc[0])))) +
-           (v[1] * (u[0] * (image_pixel_lookup(ibuf, xc[0], yc[1])) +
-                    u[1] * (image_pixel_lookup(ibuf, xc[1], yc[1])) +
-                    u[2] * (image_pixel_lookup(ibuf, xc[2], yc[1])) +
-                    u[3] * (image_pixel_lookup(ibuf, xc[3], yc[1])))) +
-           (v[2] * (u[0] * (image_pixel_lookup(ibuf, xc[0], yc[2])) +
-                    u[1] * (image_pixel_lookup(ibuf, xc[1], yc[2])) +
-                    u[2] * (image_pixel_lookup(ibuf, xc[2], yc[2])) +
-                    u[3] * (image_pixel_lookup(ibuf, xc[3], yc[2])))) +
-           (v[3] * (u[0] * (image_pixel_lookup(ibuf, xc[0], yc[3])) +
-                    u[1] * (image_pixel_lookup(ibuf, xc[1], yc[3])) +
-                    u[2] * (image_pixel_lookup(ibuf, xc[2], yc[3])) +
-                    u[3] * (image_pixel_lookup(ibuf, xc[3], yc[3]))));
+    constexpr auto lookup = image_pixel_lookup_for_extension<extension>;
+    return (v[0] * (u[0] * (lookup(ibuf, xc[0], yc[0])) +
+                    u[1] * (lookup(ibuf, xc[1], yc[0])) +
+                    u[2] * (lookup(ibuf, xc[2], yc[0])) +
+                    u[3] * (lookup(ibuf, xc[3], yc[0])))) +
+           (v[1] * (u[0] * (lookup(ibuf, xc[0], yc[1])) +
+                    u[1] * (lookup(ibuf, xc[1], yc[1])) +
+                    u[2] * (lookup(ibuf, xc[2], yc[1])) +
+                    u[3] * (lookup(ibuf, xc[3], yc[1])))) +
+           (v[2] * (u[0] * (lookup(ibuf, xc[0], yc[2])) +
+                    u[1] * (lookup(ibuf, xc[1], yc[2])) +
+                    u[2] * (lookup(ibuf, xc[2], yc[2])) +
+                    u[3] * (lookup(ibuf, xc[3], yc[2])))) +
+           (v[3] * (u[0] * (lookup(ibuf, xc[0], yc[3])) +
+                    u[1] * (lookup(ibuf, xc[1], yc[3])) +
+                    u[2] * (lookup(ibuf, xc[2], yc[3])) +
+                    u[3] * (lookup(ibuf, xc[3], yc[3]))));
   }
 
-  static float4 image_linear_texture_lookup(const ImBuf *ibuf,
-                                            const float px,
-                                            const float py,
-                                            const int extension)
+  template<int extension>
+  static float4 image_linear_texture_lookup(const ImBuf *ibuf, const float px, const float py)
   {
     const int width = ibuf->x;
     const int height = ibuf->y;
@@ -218,41 +228,33 @@ class ImageFieldsFunction : public fn::MultiFunction {
     const float nfx = frac(px * (float)width - 0.5f, &pix);
     const float nfy = frac(py * (float)height - 0.5f, &piy);
 
-    switch (extension) {
-      case SHD_IMAGE_EXTENSION_CLIP: {
-        nix = pix + 1;
-        niy = piy + 1;
-        break;
-      }
-      case SHD_IMAGE_EXTENSION_EXTEND: {
-        nix = wrap_clamp(pix + 1, width);
-        niy = wrap_clamp(piy + 1, height);
-        pix = wrap_clamp(pix, width);
-        piy = wrap_clamp(piy, height);
-        break;
-      }
-      default:
-      case SHD_IMAGE_EXTENSION_REPEAT:
-        pix = wrap_periodic(pix, width);
-        piy = wrap_periodic(piy, height);
-        nix = wrap_periodic(pix + 1, width);
-        niy = wrap_periodic(piy + 1, height);
-        break;
+    if constexpr (extension == SHD_IMAGE_EXTENSION_CLIP) {
+      nix = pix + 1;
+      niy = piy + 1;
+    }
+    else if constexpr (extension == SHD_IMAGE_EXTENSION_EXTEND) {
+      nix = wrap_clamp(pix + 1, width);
+      niy = wrap_clamp(piy + 1, height);
+      pix = wrap_clamp(pix, width);
+      piy = wrap_clamp(piy, height);
+    }
+    else {
+      pix = wrap_periodic(pix, width);
+      piy = wrap_periodic(piy, height);
+      nix = wrap_periodic(pix + 1, width);
+      niy = wrap_periodic(piy + 1, height);
     }
 
     const float ptx = 1.0f - nfx;
     const float pty = 1.0f - nfy;
 
-    return image_pixel_lookup(ibuf, pix, piy) * ptx * pty +
-           image_pixel_lookup(ibuf, nix, piy) * nfx * pty +
-           image_pixel_lookup(ibuf, pix, niy) * ptx * nfy +
-           image_pixel_lookup(ibuf, nix, niy) * nfx * nfy;
+    constexpr auto lookup = image_pixel_lookup_for_extension<extension>;
+    return lookup(ibuf, pix, piy) * ptx * pty + lookup(ibuf, nix, piy) * nfx * pty +
+           lookup(ibuf, pix, niy) * ptx * nfy + lookup(ibuf, nix, niy) * nfx * nfy;
   }
 
-  static float4 image_closest_texture_lookup(const ImBuf *ibuf,
-                                             const float px,
-                                             const float py,
-                                             const int extension)
+  template<int extension>
+  static float4 image_closest_texture_lookup(const ImBuf *ibuf, const float px, const float py)
   {
     const int width = ibuf->x;
     const int height = ibuf->y;
@@ -260,28 +262,61 @@ class ImageFieldsFunction : public fn::MultiFunction {
     const float tx = frac(px * (float)width, &ix);
     const float ty = frac(py * (float)height, &iy);
 
-    switch (extension) {
-      case SHD_IMAGE_EXTENSION_REPEAT: {
-        ix = wrap_periodic(ix, width);
-        iy = wrap_periodic(iy, height);
-        return image_pixel_lookup(ibuf, ix, iy);
-      }
-      case SHD_IMAGE_EXTENSION_CLIP: {
+    if constexpr (extension == SHD_IMAGE_EXTENSION_REPEAT) {
+      ix = wrap_periodic(ix, width);
+      iy = wrap_periodic(iy, height);
+      return image_pixel_lookup_unchecked(ibuf, ix, iy);
+    }
+    else {
+      if constexpr (extension == SHD_IMAGE_EXTENSION_CLIP) {
         if (tx < 0.0f || ty < 0.0f || tx > 1.0f || ty > 1.0f) {
           return float4(0.0f, 0.0f, 0.0f, 0.0f);
         }
         if (ix < 0 || iy < 0 || ix > width || iy > height) {
           return float4(0.0f, 0.0f, 0.0f, 0.0f);
         }
-        ATTR_FALLTHROUGH;
       }
-      case SHD_IMAGE_EXTENSION_EXTEND: {
-        ix = wrap_clamp(ix, width);
-        iy = wrap_clamp(iy, height);
-        return image_pixel_lookup(ibuf, ix, iy);
-      }
-      default:
-        return float4(0.0f, 0.0f, 0.0f, 0.0f);
+      ix = wrap_clamp(ix, width);
+      iy = wrap_clamp(iy, height);
+      return image_pixel_lookup_unchecked(ibuf, ix, iy);
+    }
+  }
+
+  /**
+   * Sample the image for all indices in the mask, with the interpolation and extension modes
+   * known at compile time, so that the per-sample code doesn't have to branch on them.
+   */
+  template<int extension>
+  void sample_image(const IndexMask mask,
+                    const VArray<float3> &vectors,
+                    MutableSpan<float4> r_color) const
+  {
+    const ImBuf *ibuf = image_buffer_;
+    const auto sample = [&](auto lookup_fn) {
+      devirtualize_varray(vectors, [&](const auto positions) {
+        for (const int64_t i : mask) {
+          const float3 p = positions[i];
+          r_color[i] = lookup_fn(p.x, p.y);
+        }
+      });
+    };
+    switch (interpolation_) {
+      case SHD_INTERP_LINEAR:
+        sample([&](const float px, const float py) {
+          return image_linear_texture_lookup<extension>(ibuf, px, py);
+        });
+        break;
+      case SHD_INTERP_CLOSEST:
+        sample([&](const float px, const float py) {
+          return image_closest_texture_lookup<extension>(ibuf, px, py);
+        });
+        break;
+      case SHD_INTERP_CUBIC:
+      case SHD_INTERP_SMART:
+        sample([&](const float px, const float py) {
+          return image_cubic_texture_lookup<extension>(ibuf, px, py);
+        });
+        break;
     }
   }
 
@@ -295,24 +330,19 @@ class ImageFieldsFunction : public fn::MultiFunction {
     MutableSpan<float4> color_data{(float4 *)r_color.data(), r_color.size()};
 
     /* Sample image texture. */
-    switch (interpolation_) {
-      case SHD_INTERP_LINEAR:
-        for (const int64_t i : mask) {
-          const float3 p = vectors[i];
-          color_data[i] = image_linear_texture_lookup(image_buffer_, p.x, p.y, extension_);
-        }
+    switch (extension_) {
+      case SHD_IMAGE_EXTENSION_REPEAT:
+        this->sample_image<SHD_IMAGE_EXTENSION_REPEAT>(mask, vectors, color_data);
         break;
-      case SHD_INTERP_CLOSEST:
-        for (const int64_t i : mask) {
-          const float3 p = vectors[i];
-          color_data[i] = image_closest_texture_lookup(image_buffer_, p.x, p.y, extension_);
-        }
+      case SHD_IMAGE_EXTENSION_CLIP:
+        this->sample_image<SHD_IMAGE_EXTENSION_CLIP>(mask, vectors, color_data);
         break;
-      case SHD_INTERP_CUBIC:
-      case SHD_INTERP_SMART:
+      case SHD_IMAGE_EXTENSION_EXTEND:
+        this->sample_image<SHD_IMAGE_EXTENSION_EXTEND>(mask, vectors, color_data);
+        break;
+      default:
         for (const int64_t i : mask) {
-          const float3 p = vectors[i];
-          color_data[i] = image_cubic_texture_lookup(image_buffer_, p.x, p.y, extension_);
+          color_data[i] = float4(0.0f, 0.0f, 0.0f, 0.0f);
         }
         break;
     }
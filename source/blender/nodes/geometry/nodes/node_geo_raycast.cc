@@ -2,6 +2,8 @@
 
 #include "DNA_mesh_types.h"
 
+#include "BLI_task.hh"
+
 #include "BKE_attribute_math.hh"
 #include "BKE_bvhutils.h"
 #include "BKE_mesh_sample.hh"
@@ -149,54 +151,64 @@ static void raycast_to_mesh(IndexMask mask,
   /* We shouldn't be rebuilding the BVH tree when calling this function in parallel. */
   BLI_assert(tree_data.cached);
 
-  for (const int i : mask) {
-    const float ray_length = ray_lengths[i];
-    const float3 ray_origin = ray_origins[i];
-    const float3 ray_direction = math::normalize(ray_directions[i]);
-
-    BVHTreeRayHit hit;
-    hit.index = -1;
-    hit.dist = ray_length;
-    if (BLI_bvhtree_ray_cast(tree_data.tree,
-                             ray_origin,
-                             ray_direction,
-                             0.0f,
-                             &hit,
-                             tree_data.raycast_callback,
-                             &tree_data) != -1) {
+  /* Gather the rays, so that they are cast in a single batch. */
+  Array<float3> origins(mask.size());
+  Array<float3> directions(mask.size());
+  Array<BVHTreeRayHit> hits(mask.size());
+  threading::parallel_for(mask.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int index = mask[i];
+      origins[i] = ray_origins[index];
+      directions[i] = math::normalize(ray_directions[index]);
+      hits[i].index = -1;
+      hits[i].dist = ray_lengths[index];
+    }
+  });
+
+  BKE_bvhtree_from_mesh_ray_cast_batch(&tree_data,
+                                       reinterpret_cast<const float(*)[3]>(origins.data()),
+                                       reinterpret_cast<const float(*)[3]>(directions.data()),
+                                       int(mask.size()),
+                                       0.0f,
+                                       hits.data());
+
+  for (const int i : mask.index_range()) {
+    const int index = mask[i];
+    const BVHTreeRayHit &hit = hits[i];
+    if (hit.index != -1) {
       hit_count++;
       if (!r_hit.is_empty()) {
-        r_hit[i] = hit.index >= 0;
+        r_hit[index] = hit.index >= 0;
       }
       if (!r_hit_indices.is_empty()) {
         /* The caller must be able to handle invalid indices anyway, so don't clamp this value. */
-        r_hit_indices[i] = hit.index;
+        r_hit_indices[index] = hit.index;
       }
       if (!r_hit_positions.is_empty()) {
-        r_hit_positions[i] = hit.co;
+        r_hit_positions[index] = hit.co;
       }
       if (!r_hit_normals.is_empty()) {
-        r_hit_normals[i] = hit.no;
+        r_hit_normals[index] = hit.no;
       }
       if (!r_hit_distances.is_empty()) {
-        r_hit_distances[i] = hit.dist;
+        r_hit_distances[index] = hit.dist;
       }
     }
     else {
       if (!r_hit.is_empty()) {
-        r_hit[i] = false;
+        r_hit[index] = false;
       }
       if (!r_hit_indices.is_empty()) {
-        r_hit_indices[i] = -1;
+        r_hit_indices[index] = -1;
       }
       if (!r_hit_positions.is_empty()) {
-        r_hit_positions[i] = float3(0.0f, 0.0f, 0.0f);
+        r_hit_positions[index] = float3(0.0f, 0.0f, 0.0f);
       }
       if (!r_hit_normals.is_empty()) {
-        r_hit_normals[i] = float3(0.0f, 0.0f, 0.0f);
+        r_hit_normals[index] = float3(0.0f, 0.0f, 0.0f);
       }
       if (!r_hit_distances.is_empty()) {
-        r_hit_distances[i] = ray_length;
+        r_hit_distances[index] = ray_lengths[index];
       }
     }
   }
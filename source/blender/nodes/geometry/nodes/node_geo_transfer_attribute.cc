@@ -135,6 +135,25 @@ static void node_gather_link_searches(GatherLinkSearchOpParams &params)
   }
 }
 
+/**
+ * Gather the positions of the mask, so that they can be queried in a single batch.
+ */
+static void prepare_nearest_batch(const VArray<float3> &positions,
+                                  const IndexMask mask,
+                                  Array<float3> &r_query_positions,
+                                  Array<BVHTreeNearest> &r_nearest)
+{
+  r_query_positions.reinitialize(mask.size());
+  r_nearest.reinitialize(mask.size());
+  threading::parallel_for(mask.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      r_query_positions[i] = positions[mask[i]];
+      r_nearest[i].index = -1;
+      r_nearest[i].dist_sq = FLT_MAX;
+    }
+  });
+}
+
 static void get_closest_in_bvhtree(BVHTreeFromMesh &tree_data,
                                    const VArray<float3> &positions,
                                    const IndexMask mask,
@@ -146,20 +165,25 @@ static void get_closest_in_bvhtree(BVHTreeFromMesh &tree_data,
   BLI_assert(positions.size() >= r_distances_sq.size());
   BLI_assert(positions.size() >= r_positions.size());
 
-  for (const int i : mask) {
-    BVHTreeNearest nearest;
-    nearest.dist_sq = FLT_MAX;
-    const float3 position = positions[i];
-    BLI_bvhtree_find_nearest(
-        tree_data.tree, position, &nearest, tree_data.nearest_callback, &tree_data);
+  Array<float3> query_positions;
+  Array<BVHTreeNearest> nearest;
+  prepare_nearest_batch(positions, mask, query_positions, nearest);
+  BKE_bvhtree_from_mesh_find_nearest_batch(
+      &tree_data,
+      reinterpret_cast<const float(*)[3]>(query_positions.data()),
+      int(mask.size()),
+      nearest.data());
+
+  for (const int i : mask.index_range()) {
+    const int index = mask[i];
     if (!r_indices.is_empty()) {
-      r_indices[i] = nearest.index;
+      r_indices[index] = nearest[i].index;
     }
     if (!r_distances_sq.is_empty()) {
-      r_distances_sq[i] = nearest.dist_sq;
+      r_distances_sq[index] = nearest[i].dist_sq;
     }
     if (!r_positions.is_empty()) {
-      r_positions[i] = nearest.co;
+      r_positions[index] = nearest[i].co;
     }
   }
 }
@@ -176,15 +200,20 @@ static void get_closest_pointcloud_points(const PointCloud &pointcloud,
   BVHTreeFromPointCloud tree_data;
   BKE_bvhtree_from_pointcloud_get(&tree_data, &pointcloud, 2);
 
-  for (const int i : mask) {
-    BVHTreeNearest nearest;
-    nearest.dist_sq = FLT_MAX;
-    const float3 position = positions[i];
-    BLI_bvhtree_find_nearest(
-        tree_data.tree, position, &nearest, tree_data.nearest_callback, &tree_data);
-    r_indices[i] = nearest.index;
+  Array<float3> query_positions;
+  Array<BVHTreeNearest> nearest;
+  prepare_nearest_batch(positions, mask, query_positions, nearest);
+  BKE_bvhtree_from_pointcloud_find_nearest_batch(
+      &tree_data,
+      reinterpret_cast<const float(*)[3]>(query_positions.data()),
+      int(mask.size()),
+      nearest.data());
+
+  for (const int i : mask.index_range()) {
+    const int index = mask[i];
+    r_indices[index] = nearest[i].index;
     if (!r_distances_sq.is_empty()) {
-      r_distances_sq[i] = nearest.dist_sq;
+      r_distances_sq[index] = nearest[i].dist_sq;
     }
   }
 
@@ -308,9 +337,11 @@ void copy_with_indices(const VArray<T> &src,
   if (src.is_empty()) {
     return;
   }
-  for (const int i : mask) {
-    dst[i] = src[indices[i]];
-  }
+  devirtualize_varray(src, [&](const auto &src) {
+    for (const int i : mask) {
+      dst[i] = src[indices[i]];
+    }
+  });
 }
 
 template<typename T>
@@ -323,11 +354,13 @@ void copy_with_indices_clamped(const VArray<T> &src,
     return;
   }
   const int max_index = src.size() - 1;
-  threading::parallel_for(mask.index_range(), 4096, [&](IndexRange range) {
-    for (const int i : range) {
-      const int index = mask[i];
-      dst[index] = src[std::clamp(indices[index], 0, max_index)];
-    }
+  devirtualize_varray2(src, indices, [&](const auto &src, const auto &indices) {
+    threading::parallel_for(mask.index_range(), 4096, [&](IndexRange range) {
+      for (const int i : range) {
+        const int index = mask[i];
+        dst[index] = src[std::clamp(indices[index], 0, max_index)];
+      }
+    });
   });
 }
 
@@ -344,14 +377,16 @@ void copy_with_indices_and_comparison(const VArray<T> &src_1,
   if (src_1.is_empty() || src_2.is_empty()) {
     return;
   }
-  for (const int i : mask) {
-    if (distances_1[i] < distances_2[i]) {
-      dst[i] = src_1[indices_1[i]];
-    }
-    else {
-      dst[i] = src_2[indices_2[i]];
+  devirtualize_varray2(src_1, src_2, [&](const auto &src_1, const auto &src_2) {
+    for (const int i : mask) {
+      if (distances_1[i] < distances_2[i]) {
+        dst[i] = src_1[indices_1[i]];
+      }
+      else {
+        dst[i] = src_2[indices_2[i]];
+      }
     }
-  }
+  });
 }
 
 static bool component_is_available(const GeometrySet &geometry,
@@ -8,6 +8,8 @@
 
 #include "node_geometry_util.hh"
 
+#include "BLI_task.hh"
+
 #include "BKE_lib_id.h"
 #include "BKE_material.h"
 #include "BKE_mesh.h"
@@ -98,10 +100,13 @@ static Mesh *create_mesh_from_volume_grids(Span<openvdb::GridBase::ConstPtr> gri
                                            const float adaptivity,
                                            const bke::VolumeToMeshResolution &resolution)
 {
+  /* The conversion of every grid is multi-threaded as well, but it has serial parts. */
   Array<bke::OpenVDBMeshData> mesh_data(grids.size());
-  for (const int i : grids.index_range()) {
-    mesh_data[i] = bke::volume_to_mesh_data(*grids[i], resolution, threshold, adaptivity);
-  }
+  threading::parallel_for(grids.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      mesh_data[i] = bke::volume_to_mesh_data(*grids[i], resolution, threshold, adaptivity);
+    }
+  });
 
   int vert_offset = 0;
   int poly_offset = 0;
@@ -125,18 +130,20 @@ static Mesh *create_mesh_from_volume_grids(Span<openvdb::GridBase::ConstPtr> gri
   MutableSpan<MLoop> loops{mesh->mloop, mesh->totloop};
   MutableSpan<MPoly> polys{mesh->mpoly, mesh->totpoly};
 
-  for (const int i : grids.index_range()) {
-    const bke::OpenVDBMeshData &data = mesh_data[i];
-    bke::fill_mesh_from_openvdb_data(data.verts,
-                                     data.tris,
-                                     data.quads,
-                                     vert_offsets[i],
-                                     poly_offsets[i],
-                                     loop_offsets[i],
-                                     verts,
-                                     polys,
-                                     loops);
-  }
+  threading::parallel_for(grids.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      const bke::OpenVDBMeshData &data = mesh_data[i];
+      bke::fill_mesh_from_openvdb_data(data.verts,
+                                       data.tris,
+                                       data.quads,
+                                       vert_offsets[i],
+                                       poly_offsets[i],
+                                       loop_offsets[i],
+                                       verts,
+                                       polys,
+                                       loops);
+    }
+  });
 
   BKE_mesh_calc_edges(mesh, false, false);
   BKE_mesh_normals_tag_dirty(mesh);
@@ -151,7 +158,11 @@ static Mesh *create_mesh_from_volume(GeometrySet &geometry_set, GeoNodeExecParam
     return nullptr;
   }
 
-  const bke::VolumeToMeshResolution resolution = get_resolution_param(params);
+  bke::VolumeToMeshResolution resolution = get_resolution_param(params);
+  if (!bke::volume_to_mesh_resolution_simplify(resolution,
+                                               BKE_volume_simplify_factor(params.depsgraph()))) {
+    return nullptr;
+  }
   const Main *bmain = DEG_get_bmain(params.depsgraph());
   BKE_volume_load(volume, bmain);
 
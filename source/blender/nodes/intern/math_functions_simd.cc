@@ -0,0 +1,311 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup nodes
+ *
+ * Multi-functions for the most common float and vector math operations that are vectorized
+ * explicitly. Those operations are cheap per element, so the overhead of the generic
+ * multi-function builders is significant when they are evaluated on large contiguous arrays.
+ *
+ * The kernels work on flat float arrays. That way the same code handles `float` and `float3`,
+ * because the operations are all component-wise.
+ */
+
+#include "BLI_math_base_safe.h"
+#include "BLI_math_vec_types.hh"
+#include "BLI_simd.h"
+
+#include "FN_multi_function.hh"
+
+#include "NOD_math_functions.hh"
+
+namespace blender::nodes {
+
+/**
+ * Chunk of floats that is processed by one iteration of the vectorized loop. It is a multiple of
+ * the SIMD width and of the number of components of a #float3.
+ */
+static constexpr int flat_chunk_size = 12;
+
+/**
+ * Either a contiguous array of floats, or a value that is the same for every element. In the
+ * latter case, the value is repeated to fill #flat_chunk_size floats, so that it can be loaded
+ * like a contiguous array.
+ */
+struct FlatInput {
+  const float *data = nullptr;
+  float pattern[flat_chunk_size];
+  bool is_single = false;
+
+  template<typename T> static FlatInput from_varray(const VArray<T> &varray, IndexRange range)
+  {
+    constexpr int components = sizeof(T) / sizeof(float);
+    FlatInput input;
+    if (varray.is_single()) {
+      const T value = varray.get_internal_single();
+      const float *value_components = reinterpret_cast<const float *>(&value);
+      for (const int i : IndexRange(flat_chunk_size)) {
+        input.pattern[i] = value_components[i % components];
+      }
+      input.is_single = true;
+    }
+    else {
+      input.data = reinterpret_cast<const float *>(varray.get_internal_span().data() +
+                                                   range.start());
+    }
+    return input;
+  }
+
+  const float *chunk(const int64_t offset) const
+  {
+    return is_single ? pattern : data + offset;
+  }
+
+  float get(const int64_t offset) const
+  {
+    return is_single ? pattern[offset % flat_chunk_size] : data[offset];
+  }
+};
+
+template<typename Op>
+static void compute_flat(const FlatInput &a,
+                         const FlatInput &b,
+                         float *r_result,
+                         const int64_t size)
+{
+  int64_t offset = 0;
+#ifdef BLI_HAVE_SSE2
+  for (; offset + flat_chunk_size <= size; offset += flat_chunk_size) {
+    const float *a_chunk = a.chunk(offset);
+    const float *b_chunk = b.chunk(offset);
+    float *result_chunk = r_result + offset;
+    for (int i = 0; i < flat_chunk_size; i += 4) {
+      const __m128 a_values = _mm_loadu_ps(a_chunk + i);
+      const __m128 b_values = _mm_loadu_ps(b_chunk + i);
+      _mm_storeu_ps(result_chunk + i, Op::simd(a_values, b_values));
+    }
+  }
+#endif
+  for (; offset < size; offset++) {
+    r_result[offset] = Op::scalar(a.get(offset), b.get(offset));
+  }
+}
+
+template<typename T, typename Op> static T compute_element(const T &a, const T &b)
+{
+  constexpr int components = sizeof(T) / sizeof(float);
+  T result;
+  const float *a_components = reinterpret_cast<const float *>(&a);
+  const float *b_components = reinterpret_cast<const float *>(&b);
+  float *result_components = reinterpret_cast<float *>(&result);
+  for (int i = 0; i < components; i++) {
+    result_components[i] = Op::scalar(a_components[i], b_components[i]);
+  }
+  return result;
+}
+
+/**
+ * A multi-function with two inputs and one output of the same type (`float` or `float3`) that
+ * applies #Op to every component.
+ */
+template<typename T, typename Op> class SIMDMathFunction : public fn::MultiFunction {
+ private:
+  static_assert(std::is_trivial_v<T> && sizeof(T) % sizeof(float) == 0);
+  fn::MFSignature signature_;
+
+ public:
+  SIMDMathFunction(const char *name)
+  {
+    fn::MFSignatureBuilder signature{name};
+    signature.single_input<T>("A");
+    signature.single_input<T>("B");
+    signature.single_output<T>("Result");
+    signature_ = signature.build();
+    this->set_signature(&signature_);
+  }
+
+  void call(IndexMask mask, fn::MFParams params, fn::MFContext UNUSED(context)) const override
+  {
+    const VArray<T> &a = params.readonly_single_input<T>(0, "A");
+    const VArray<T> &b = params.readonly_single_input<T>(1, "B");
+    MutableSpan<T> results = params.uninitialized_single_output<T>(2, "Result");
+
+    if (mask.is_range() && (a.is_single() || a.is_span()) && (b.is_single() || b.is_span())) {
+      const IndexRange range = mask.as_range();
+      constexpr int components = sizeof(T) / sizeof(float);
+      compute_flat<Op>(FlatInput::from_varray(a, range),
+                       FlatInput::from_varray(b, range),
+                       reinterpret_cast<float *>(results.data() + range.start()),
+                       range.size() * components);
+      return;
+    }
+
+    /* Masks with gaps and other virtual arrays use the generic code path. */
+    devirtualize_varray2(a, b, [&](const auto &a, const auto &b) {
+      mask.foreach_index(
+          [&](const int64_t i) { results[i] = compute_element<T, Op>(a[i], b[i]); });
+    });
+  }
+};
+
+/* The scalar versions must give exactly the same results as the functions that are used for the
+ * operations in #NOD_math_functions.hh, including the handling of NaN. */
+
+struct AddOp {
+  static float scalar(const float a, const float b)
+  {
+    return a + b;
+  }
+#ifdef BLI_HAVE_SSE2
+  static __m128 simd(const __m128 a, const __m128 b)
+  {
+    return _mm_add_ps(a, b);
+  }
+#endif
+};
+
+struct SubtractOp {
+  static float scalar(const float a, const float b)
+  {
+    return a - b;
+  }
+#ifdef BLI_HAVE_SSE2
+  static __m128 simd(const __m128 a, const __m128 b)
+  {
+    return _mm_sub_ps(a, b);
+  }
+#endif
+};
+
+struct MultiplyOp {
+  static float scalar(const float a, const float b)
+  {
+    return a * b;
+  }
+#ifdef BLI_HAVE_SSE2
+  static __m128 simd(const __m128 a, const __m128 b)
+  {
+    return _mm_mul_ps(a, b);
+  }
+#endif
+};
+
+struct SafeDivideOp {
+  static float scalar(const float a, const float b)
+  {
+    return safe_divide(a, b);
+  }
+#ifdef BLI_HAVE_SSE2
+  static __m128 simd(const __m128 a, const __m128 b)
+  {
+    /* Lanes that are divided by zero are set to zero afterwards. */
+    const __m128 is_nonzero = _mm_cmpneq_ps(b, _mm_setzero_ps());
+    return _mm_and_ps(_mm_div_ps(a, b), is_nonzero);
+  }
+#endif
+};
+
+/** Same as `std::min(a, b)`. */
+struct StdMinOp {
+  static float scalar(const float a, const float b)
+  {
+    return std::min(a, b);
+  }
+#ifdef BLI_HAVE_SSE2
+  static __m128 simd(const __m128 a, const __m128 b)
+  {
+    return _mm_min_ps(b, a);
+  }
+#endif
+};
+
+/** Same as `std::max(a, b)`. */
+struct StdMaxOp {
+  static float scalar(const float a, const float b)
+  {
+    return std::max(a, b);
+  }
+#ifdef BLI_HAVE_SSE2
+  static __m128 simd(const __m128 a, const __m128 b)
+  {
+    return _mm_max_ps(b, a);
+  }
+#endif
+};
+
+/** Same as #blender::math::min for vectors. */
+struct VectorMinOp {
+  static float scalar(const float a, const float b)
+  {
+    return a < b ? a : b;
+  }
+#ifdef BLI_HAVE_SSE2
+  static __m128 simd(const __m128 a, const __m128 b)
+  {
+    return _mm_min_ps(a, b);
+  }
+#endif
+};
+
+/** Same as #blender::math::max for vectors. */
+struct VectorMaxOp {
+  static float scalar(const float a, const float b)
+  {
+    return a > b ? a : b;
+  }
+#ifdef BLI_HAVE_SSE2
+  static __m128 simd(const __m128 a, const __m128 b)
+  {
+    return _mm_max_ps(a, b);
+  }
+#endif
+};
+
+template<typename T, typename Op>
+static const fn::MultiFunction *get_simd_fn(const FloatMathOperationInfo *info)
+{
+  static SIMDMathFunction<T, Op> fn{info->title_case_name.c_str()};
+  return &fn;
+}
+
+const fn::MultiFunction *get_float_math_fl_fl_to_fl_simd_fn(const int operation)
+{
+  const FloatMathOperationInfo *info = get_float_math_operation_info(operation);
+  switch (operation) {
+    case NODE_MATH_ADD:
+      return get_simd_fn<float, AddOp>(info);
+    case NODE_MATH_SUBTRACT:
+      return get_simd_fn<float, SubtractOp>(info);
+    case NODE_MATH_MULTIPLY:
+      return get_simd_fn<float, MultiplyOp>(info);
+    case NODE_MATH_DIVIDE:
+      return get_simd_fn<float, SafeDivideOp>(info);
+    case NODE_MATH_MINIMUM:
+      return get_simd_fn<float, StdMinOp>(info);
+    case NODE_MATH_MAXIMUM:
+      return get_simd_fn<float, StdMaxOp>(info);
+  }
+  return nullptr;
+}
+
+const fn::MultiFunction *get_float3_math_fl3_fl3_to_fl3_simd_fn(const int operation)
+{
+  const FloatMathOperationInfo *info = get_float3_math_operation_info(operation);
+  switch (operation) {
+    case NODE_VECTOR_MATH_ADD:
+      return get_simd_fn<float3, AddOp>(info);
+    case NODE_VECTOR_MATH_SUBTRACT:
+      return get_simd_fn<float3, SubtractOp>(info);
+    case NODE_VECTOR_MATH_MULTIPLY:
+      return get_simd_fn<float3, MultiplyOp>(info);
+    case NODE_VECTOR_MATH_DIVIDE:
+      return get_simd_fn<float3, SafeDivideOp>(info);
+    case NODE_VECTOR_MATH_MINIMUM:
+      return get_simd_fn<float3, VectorMinOp>(info);
+    case NODE_VECTOR_MATH_MAXIMUM:
+      return get_simd_fn<float3, VectorMaxOp>(info);
+  }
+  return nullptr;
+}
+
+}  // namespace blender::nodes
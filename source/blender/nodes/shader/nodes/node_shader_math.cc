@@ -104,7 +104,10 @@ static int gpu_shader_math(GPUMaterial *mat,
 static const fn::MultiFunction *get_base_multi_function(bNode &node)
 {
   const int mode = node.custom1;
-  const fn::MultiFunction *base_fn = nullptr;
+  const fn::MultiFunction *base_fn = get_float_math_fl_fl_to_fl_simd_fn(mode);
+  if (base_fn != nullptr) {
+    return base_fn;
+  }
 
   try_dispatch_float_math_fl_to_fl(mode, [&](auto function, const FloatMathOperationInfo &info) {
     static fn::CustomMF_SI_SO<float, float> fn{info.title_case_name.c_str(), function};
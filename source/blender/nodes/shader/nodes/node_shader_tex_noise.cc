@@ -177,6 +177,17 @@ class NoiseFunction : public fn::MultiFunction {
       }
       case 3: {
         const VArray<float3> &vector = params.readonly_single_input<float3>(0, "Vector");
+        if (detail.is_single() && roughness.is_single() && distortion.is_single()) {
+          this->call_batched_3d(mask,
+                                vector,
+                                scale,
+                                detail.get_internal_single(),
+                                roughness.get_internal_single(),
+                                distortion.get_internal_single(),
+                                r_factor,
+                                r_color);
+          break;
+        }
         if (compute_factor) {
           for (int64_t i : mask) {
             const float3 position = vector[i] * scale[i];
@@ -223,6 +234,47 @@ class NoiseFunction : public fn::MultiFunction {
     }
   }
 
+  /**
+   * Use the batched noise functions, which are vectorized, when the noise parameters are the
+   * same for all elements. The positions are gathered into a buffer in chunks.
+   */
+  static void call_batched_3d(const IndexMask mask,
+                              const VArray<float3> &vector,
+                              const VArray<float> &scale,
+                              const float detail,
+                              const float roughness,
+                              const float distortion,
+                              MutableSpan<float> r_factor,
+                              MutableSpan<ColorGeometry4f> r_color)
+  {
+    constexpr int64_t chunk_size = 256;
+    float3 positions_buffer[chunk_size];
+    float factor_buffer[chunk_size];
+    float3 color_buffer[chunk_size];
+    for (int64_t start = 0; start < mask.size(); start += chunk_size) {
+      const IndexMask chunk = mask.slice(start, std::min(chunk_size, mask.size() - start));
+      MutableSpan<float3> positions(positions_buffer, chunk.size());
+      for (const int64_t i : chunk.index_range()) {
+        positions[i] = vector[chunk[i]] * scale[chunk[i]];
+      }
+      if (!r_factor.is_empty()) {
+        MutableSpan<float> factors(factor_buffer, chunk.size());
+        noise::perlin_fractal_distorted(positions, detail, roughness, distortion, factors);
+        for (const int64_t i : chunk.index_range()) {
+          r_factor[chunk[i]] = factors[i];
+        }
+      }
+      if (!r_color.is_empty()) {
+        MutableSpan<float3> colors(color_buffer, chunk.size());
+        noise::perlin_float3_fractal_distorted(positions, detail, roughness, distortion, colors);
+        for (const int64_t i : chunk.index_range()) {
+          const float3 &c = colors[i];
+          r_color[chunk[i]] = ColorGeometry4f(c[0], c[1], c[2], 1.0f);
+        }
+      }
+    }
+  }
+
   ExecutionHints get_execution_hints() const override
   {
     ExecutionHints hints;
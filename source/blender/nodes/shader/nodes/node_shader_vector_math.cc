@@ -229,7 +229,10 @@ static const fn::MultiFunction *get_multi_function(bNode &node)
 {
   NodeVectorMathOperation operation = NodeVectorMathOperation(node.custom1);
 
-  const fn::MultiFunction *multi_fn = nullptr;
+  const fn::MultiFunction *multi_fn = get_float3_math_fl3_fl3_to_fl3_simd_fn(operation);
+  if (multi_fn != nullptr) {
+    return multi_fn;
+  }
 
   try_dispatch_float_math_fl3_fl3_to_fl3(operation,
                                          [&](auto function, const FloatMathOperationInfo &info) {
@@ -31,6 +31,8 @@
 #include "bpy_app_icons.h"
 #include "bpy_app_timers.h"
 
+#include "MEM_guardedalloc.h"
+
 #include "BLI_utildefines.h"
 
 #include "BKE_appdir.h"
@@ -336,6 +338,20 @@ static PyObject *bpy_app_preview_render_size_get(PyObject *UNUSED(self), void *c
   return PyLong_FromLong((long)UI_icon_preview_to_render_size(POINTER_AS_INT(closure)));
 }
 
+PyDoc_STRVAR(bpy_app_memory_usage_doc,
+             "Dictionary of the memory in use in bytes by category, "
+             "allocations of other subsystems are accounted to 'Unknown' (read-only)");
+static PyObject *bpy_app_memory_usage_get(PyObject *UNUSED(self), void *UNUSED(closure))
+{
+  PyObject *dict = PyDict_New();
+  for (int i = 0; i < MEM_CATEGORY_NUM; i++) {
+    PyObject *value = PyLong_FromSize_t(MEM_get_memory_in_use_by_category(i));
+    PyDict_SetItemString(dict, MEM_category_name(i), value);
+    Py_DECREF(value);
+  }
+  return dict;
+}
+
 static PyObject *bpy_app_autoexec_fail_message_get(PyObject *UNUSED(self), void *UNUSED(closure))
 {
   return PyC_UnicodeFromByte(G.autoexec_fail);
@@ -405,6 +421,11 @@ static PyGetSetDef bpy_app_getsets[] = {
      bpy_app_debug_doc,
      (void *)G_DEBUG_SIMDATA},
     {"debug_io", bpy_app_debug_get, bpy_app_debug_set, bpy_app_debug_doc, (void *)G_DEBUG_IO},
+    {"debug_draw_trace",
+     bpy_app_debug_get,
+     bpy_app_debug_set,
+     bpy_app_debug_doc,
+     (void *)G_DEBUG_DRAW_TRACE},
 
     {"use_event_simulate",
      bpy_app_global_flag_get,
@@ -445,6 +466,7 @@ static PyGetSetDef bpy_app_getsets[] = {
      NULL,
      (void *)G_FLAG_SCRIPT_AUTOEXEC_FAIL_QUIET},
     {"autoexec_fail_message", bpy_app_autoexec_fail_message_get, NULL, NULL, NULL},
+    {"memory_usage", bpy_app_memory_usage_get, NULL, bpy_app_memory_usage_doc, NULL},
     {NULL, NULL, NULL, NULL, NULL},
 };
 
@@ -5365,6 +5365,103 @@ static PyObject *pyrna_prop_collection_foreach_set(BPy_PropertyRNA *self, PyObje
   return foreach_getset(self, args, 1);
 }
 
+static const char *foreach_view_format(RawPropertyType raw_type, bool attr_signed)
+{
+  switch (raw_type) {
+    case PROP_RAW_CHAR:
+      return attr_signed ? "b" : "B";
+    case PROP_RAW_SHORT:
+      return attr_signed ? "h" : "H";
+    case PROP_RAW_INT:
+      return attr_signed ? "i" : "I";
+    case PROP_RAW_BOOLEAN:
+      return "?";
+    case PROP_RAW_FLOAT:
+      return "f";
+    case PROP_RAW_DOUBLE:
+      return "d";
+    case PROP_RAW_UNSET:
+      break;
+  }
+  return NULL;
+}
+
+PyDoc_STRVAR(
+    pyrna_prop_collection_foreach_view_doc,
+    ".. method:: foreach_view(attr)\n"
+    "\n"
+    "   Direct access to an attribute of all items in a collection, without copying.\n"
+    "   Unlike :class:`foreach_get` only collections that store their items in a contiguous "
+    "array are supported (e.g. mesh vertices or attribute data).\n"
+    "\n"
+    "   The view references Blender's memory directly, it must not be used after the data has "
+    "been changed in any other way (e.g. adding or removing items, or undo).\n"
+    "   Writing to the view doesn't tag the data as changed, updates have to be triggered "
+    "explicitly afterwards (e.g. with :class:`Mesh.update` or :class:`ID.update_tag`).\n"
+    "\n"
+    "   :arg attr: Name of the attribute of the collection items.\n"
+    "   :type attr: string\n"
+    "   :return: A writable view with one row per item, that can be used with numpy.\n"
+    "   :rtype: memoryview\n");
+static PyObject *pyrna_prop_collection_foreach_view(BPy_PropertyRNA *self, PyObject *args)
+{
+  const char *attr;
+
+  PYRNA_PROP_CHECK_OBJ(self);
+
+  if (!PyArg_ParseTuple(args, "s:foreach_view", &attr)) {
+    return NULL;
+  }
+
+  PointerRNA itemptr_base;
+  RNA_pointer_create(NULL, RNA_property_pointer_type(&self->ptr, self->prop), NULL, &itemptr_base);
+  PropertyRNA *itemprop = RNA_struct_find_property(&itemptr_base, attr);
+  if (itemprop == NULL) {
+    PyErr_Format(PyExc_AttributeError,
+                 "foreach_view '%.200s.%200s[...]' elements have no attribute '%.200s'",
+                 RNA_struct_identifier(self->ptr.type),
+                 RNA_property_identifier(self->prop),
+                 attr);
+    return NULL;
+  }
+
+  RawArray raw_array;
+  const char *format = foreach_view_format(RNA_property_raw_type(itemprop),
+                                           RNA_property_subtype(itemprop) != PROP_UNSIGNED);
+  if (format == NULL || (RNA_property_flag(itemprop) & PROP_DYNAMIC) ||
+      !RNA_property_collection_raw_array(&self->ptr, self->prop, itemprop, &raw_array)) {
+    PyErr_Format(PyExc_TypeError,
+                 "foreach_view '%.200s.%200s[...].%200s' can't be accessed directly, "
+                 "use foreach_get/set instead",
+                 RNA_struct_identifier(self->ptr.type),
+                 RNA_property_identifier(self->prop),
+                 attr);
+    return NULL;
+  }
+
+  /* Empty collections don't have an array. */
+  static char empty_array[sizeof(double)];
+  const int itemsize = RNA_raw_type_sizeof(RNA_property_raw_type(itemprop));
+  const int attr_tot = RNA_property_array_length(&itemptr_base, itemprop);
+
+  /* The shape and strides are copied by the memory-view. */
+  Py_ssize_t shape[2] = {raw_array.len, attr_tot};
+  Py_ssize_t strides[2] = {raw_array.stride, itemsize};
+
+  Py_buffer view = {NULL};
+  view.buf = raw_array.array ? raw_array.array : empty_array;
+  view.obj = NULL;
+  view.len = (Py_ssize_t)raw_array.len * MAX2(attr_tot, 1) * itemsize;
+  view.itemsize = itemsize;
+  view.readonly = 0;
+  view.ndim = (attr_tot == 0) ? 1 : 2;
+  view.format = (char *)format;
+  view.shape = shape;
+  view.strides = strides;
+
+  return PyMemoryView_FromBuffer(&view);
+}
+
 static PyObject *pyprop_array_foreach_getset(BPy_PropertyArrayRNA *self,
                                              PyObject *args,
                                              const bool do_set)
@@ -5714,6 +5811,10 @@ static struct PyMethodDef pyrna_prop_collection_methods[] = {
      (PyCFunction)pyrna_prop_collection_foreach_set,
      METH_VARARGS,
      pyrna_prop_collection_foreach_set_doc},
+    {"foreach_view",
+     (PyCFunction)pyrna_prop_collection_foreach_view,
+     METH_VARARGS,
+     pyrna_prop_collection_foreach_view_doc},
 
     {"keys", (PyCFunction)pyrna_prop_collection_keys, METH_NOARGS, pyrna_prop_collection_keys_doc},
     {"items",
@@ -52,6 +52,7 @@ extern "C" {
 #define RE_USE_CUSTOM_FREESTYLE 1024
 #define RE_USE_NO_IMAGE_SAVE 2048
 #define RE_USE_ALEMBIC_PROCEDURAL 4096
+#define RE_USE_SHARED_SCENE_DATA 8192
 
 /* RenderEngine.flag */
 #define RE_ENGINE_ANIMATION 1
@@ -61,6 +62,7 @@ extern "C" {
 #define RE_ENGINE_RENDERING 16
 #define RE_ENGINE_HIGHLIGHT_TILES 32
 #define RE_ENGINE_CAN_DRAW 64
+#define RE_ENGINE_SHARE_DEPSGRAPH 128
 
 extern ListBase R_engines;
 
@@ -52,6 +52,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
@@ -705,6 +706,63 @@ static void bake_differentials(BakeDataZSpan *bd,
   }
 }
 
+typedef struct BakePopulateData {
+  BakePixel *pixel_array;
+  const BakeTargets *targets;
+  const MLoopTri *looptri;
+  int tottri;
+  const MPoly *mpoly;
+  const MLoopUV *mloopuv;
+} BakePopulateData;
+
+/**
+ * Rasterize the triangles of one image. The images cover distinct parts of the pixel array, so
+ * they can be done in parallel, every image still writes its triangles in order.
+ */
+static void bake_pixels_populate_image(void *__restrict userdata,
+                                       const int image_id,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BakePopulateData *data = userdata;
+  const BakeTargets *targets = data->targets;
+
+  ZSpan zspan;
+  BakeDataZSpan bd;
+  bd.pixel_array = data->pixel_array;
+  bd.bk_image = &targets->images[image_id];
+  bd.zspan = &zspan;
+
+  zbuf_alloc_span(&zspan, bd.bk_image->width, bd.bk_image->height);
+
+  for (int i = 0; i < data->tottri; i++) {
+    const MLoopTri *lt = &data->looptri[i];
+    const MPoly *mp = &data->mpoly[lt->poly];
+    float vec[3][2];
+
+    if (targets->material_to_image[mp->mat_nr] != image_id) {
+      continue;
+    }
+
+    bd.primitive_id = i;
+
+    for (int a = 0; a < 3; a++) {
+      const float *uv = data->mloopuv[lt->tri[a]].uv;
+
+      /* NOTE(campbell): workaround for pixel aligned UVs which are common and can screw up our
+       * intersection tests where a pixel gets in between 2 faces or the middle of a quad,
+       * camera aligned quads also have this problem but they are less common.
+       * Add a small offset to the UVs, fixes bug T18685. */
+      vec[a][0] = uv[0] * (float)bd.bk_image->width - (0.5f + 0.001f);
+      vec[a][1] = uv[1] * (float)bd.bk_image->height - (0.5f + 0.002f);
+    }
+
+    bake_differentials(&bd, vec[0], vec[1], vec[2]);
+    zspan_scanconvert(&zspan, (void *)&bd, vec[0], vec[1], vec[2], store_bake_pixel);
+  }
+
+  zbuf_free_span(&zspan);
+}
+
 void RE_bake_pixels_populate(Mesh *me,
                              BakePixel pixel_array[],
                              const size_t num_pixels,
@@ -724,60 +782,32 @@ void RE_bake_pixels_populate(Mesh *me,
     return;
   }
 
-  BakeDataZSpan bd;
-  bd.pixel_array = pixel_array;
-  bd.zspan = MEM_callocN(sizeof(ZSpan) * targets->num_images, "bake zspan");
-
   /* initialize all pixel arrays so we know which ones are 'blank' */
   for (int i = 0; i < num_pixels; i++) {
     pixel_array[i].primitive_id = -1;
     pixel_array[i].object_id = 0;
   }
 
-  for (int i = 0; i < targets->num_images; i++) {
-    zbuf_alloc_span(&bd.zspan[i], targets->images[i].width, targets->images[i].height);
-  }
-
   const int tottri = poly_to_tri_count(me->totpoly, me->totloop);
   MLoopTri *looptri = MEM_mallocN(sizeof(*looptri) * tottri, __func__);
 
   BKE_mesh_recalc_looptri(me->mloop, me->mpoly, me->mvert, me->totloop, me->totpoly, looptri);
 
-  for (int i = 0; i < tottri; i++) {
-    const MLoopTri *lt = &looptri[i];
-    const MPoly *mp = &me->mpoly[lt->poly];
-    float vec[3][2];
-    int mat_nr = mp->mat_nr;
-    int image_id = targets->material_to_image[mat_nr];
-
-    if (image_id < 0) {
-      continue;
-    }
+  BakePopulateData data;
+  data.pixel_array = pixel_array;
+  data.targets = targets;
+  data.looptri = looptri;
+  data.tottri = tottri;
+  data.mpoly = me->mpoly;
+  data.mloopuv = mloopuv;
 
-    bd.bk_image = &targets->images[image_id];
-    bd.primitive_id = i;
-
-    for (int a = 0; a < 3; a++) {
-      const float *uv = mloopuv[lt->tri[a]].uv;
-
-      /* NOTE(campbell): workaround for pixel aligned UVs which are common and can screw up our
-       * intersection tests where a pixel gets in between 2 faces or the middle of a quad,
-       * camera aligned quads also have this problem but they are less common.
-       * Add a small offset to the UVs, fixes bug T18685. */
-      vec[a][0] = uv[0] * (float)bd.bk_image->width - (0.5f + 0.001f);
-      vec[a][1] = uv[1] * (float)bd.bk_image->height - (0.5f + 0.002f);
-    }
-
-    bake_differentials(&bd, vec[0], vec[1], vec[2]);
-    zspan_scanconvert(&bd.zspan[image_id], (void *)&bd, vec[0], vec[1], vec[2], store_bake_pixel);
-  }
-
-  for (int i = 0; i < targets->num_images; i++) {
-    zbuf_free_span(&bd.zspan[i]);
-  }
+  /* Baking to many images is common with UDIM tiles. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (targets->num_images > 1);
+  BLI_task_parallel_range(0, targets->num_images, &data, bake_pixels_populate_image, &settings);
 
   MEM_freeN(looptri);
-  MEM_freeN(bd.zspan);
 }
 
 /* ******************** NORMALS ************************ */
@@ -822,122 +852,147 @@ static void normal_compress(float out[3],
   }
 }
 
-void RE_bake_normal_world_to_tangent(const BakePixel pixel_array[],
-                                     const size_t num_pixels,
-                                     const int depth,
-                                     float result[],
-                                     Mesh *me,
-                                     const eBakeNormalSwizzle normal_swizzle[3],
-                                     float mat[4][4])
+typedef struct BakeNormalTangentData {
+  const BakePixel *pixel_array;
+  int depth;
+  float *result;
+  const TriTessFace *triangles;
+  const eBakeNormalSwizzle *normal_swizzle;
+  float (*mat)[4];
+} BakeNormalTangentData;
+
+static void bake_normal_world_to_tangent_pixel(void *__restrict userdata,
+                                               const int i,
+                                               const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  size_t i;
+  const BakeNormalTangentData *data = userdata;
+  const TriTessFace *triangle;
+  float tangents[3][3];
+  float normals[3][3];
+  float signs[3];
+  int j;
 
-  TriTessFace *triangles;
+  float tangent[3];
+  float normal[3];
+  float binormal[3];
+  float sign;
+  float u, v, w;
 
-  Mesh *me_eval = BKE_mesh_copy_for_eval(me, false);
+  float tsm[3][3]; /* tangent space matrix */
+  float itsm[3][3];
 
-  triangles = mesh_calc_tri_tessface(me, true, me_eval);
+  size_t offset;
+  float nor[3]; /* texture normal */
 
-  BLI_assert(num_pixels >= 3);
-
-  for (i = 0; i < num_pixels; i++) {
-    TriTessFace *triangle;
-    float tangents[3][3];
-    float normals[3][3];
-    float signs[3];
-    int j;
-
-    float tangent[3];
-    float normal[3];
-    float binormal[3];
-    float sign;
-    float u, v, w;
+  bool is_smooth;
 
-    float tsm[3][3]; /* tangent space matrix */
-    float itsm[3][3];
+  int primitive_id = data->pixel_array[i].primitive_id;
 
-    size_t offset;
-    float nor[3]; /* texture normal */
+  offset = (size_t)i * data->depth;
 
-    bool is_smooth;
+  if (primitive_id == -1) {
+    if (data->depth == 4) {
+      copy_v4_fl4(&data->result[offset], 0.5f, 0.5f, 1.0f, 1.0f);
+    }
+    else {
+      copy_v3_fl3(&data->result[offset], 0.5f, 0.5f, 1.0f);
+    }
+    return;
+  }
 
-    int primitive_id = pixel_array[i].primitive_id;
+  triangle = &data->triangles[primitive_id];
+  is_smooth = triangle->is_smooth;
 
-    offset = i * depth;
+  for (j = 0; j < 3; j++) {
+    const TSpace *ts;
 
-    if (primitive_id == -1) {
-      if (depth == 4) {
-        copy_v4_fl4(&result[offset], 0.5f, 0.5f, 1.0f, 1.0f);
+    if (is_smooth) {
+      if (triangle->loop_normal[j]) {
+        copy_v3_v3(normals[j], triangle->loop_normal[j]);
       }
       else {
-        copy_v3_fl3(&result[offset], 0.5f, 0.5f, 1.0f);
+        copy_v3_v3(normals[j], triangle->vert_normals[j]);
       }
-      continue;
     }
 
-    triangle = &triangles[primitive_id];
-    is_smooth = triangle->is_smooth;
+    ts = triangle->tspace[j];
+    copy_v3_v3(tangents[j], ts->tangent);
+    signs[j] = ts->sign;
+  }
 
-    for (j = 0; j < 3; j++) {
-      const TSpace *ts;
+  u = data->pixel_array[i].uv[0];
+  v = data->pixel_array[i].uv[1];
+  w = 1.0f - u - v;
 
-      if (is_smooth) {
-        if (triangle->loop_normal[j]) {
-          copy_v3_v3(normals[j], triangle->loop_normal[j]);
-        }
-        else {
-          copy_v3_v3(normals[j], triangle->vert_normals[j]);
-        }
-      }
+  /* normal */
+  if (is_smooth) {
+    interp_barycentric_tri_v3(normals, u, v, normal);
+  }
+  else {
+    copy_v3_v3(normal, triangle->normal);
+  }
 
-      ts = triangle->tspace[j];
-      copy_v3_v3(tangents[j], ts->tangent);
-      signs[j] = ts->sign;
-    }
+  /* tangent */
+  interp_barycentric_tri_v3(tangents, u, v, tangent);
 
-    u = pixel_array[i].uv[0];
-    v = pixel_array[i].uv[1];
-    w = 1.0f - u - v;
+  /* sign */
+  /* The sign is the same at all face vertices for any non degenerate face.
+   * Just in case we clamp the interpolated value though. */
+  sign = (signs[0] * u + signs[1] * v + signs[2] * w) < 0 ? (-1.0f) : 1.0f;
 
-    /* normal */
-    if (is_smooth) {
-      interp_barycentric_tri_v3(normals, u, v, normal);
-    }
-    else {
-      copy_v3_v3(normal, triangle->normal);
-    }
+  /* binormal */
+  /* `B = sign * cross(N, T)` */
+  cross_v3_v3v3(binormal, normal, tangent);
+  mul_v3_fl(binormal, sign);
 
-    /* tangent */
-    interp_barycentric_tri_v3(tangents, u, v, tangent);
+  /* populate tangent space matrix */
+  copy_v3_v3(tsm[0], tangent);
+  copy_v3_v3(tsm[1], binormal);
+  copy_v3_v3(tsm[2], normal);
 
-    /* sign */
-    /* The sign is the same at all face vertices for any non degenerate face.
-     * Just in case we clamp the interpolated value though. */
-    sign = (signs[0] * u + signs[1] * v + signs[2] * w) < 0 ? (-1.0f) : 1.0f;
+  /* texture values */
+  copy_v3_v3(nor, &data->result[offset]);
 
-    /* binormal */
-    /* `B = sign * cross(N, T)` */
-    cross_v3_v3v3(binormal, normal, tangent);
-    mul_v3_fl(binormal, sign);
+  /* converts from world space to local space */
+  mul_transposed_mat3_m4_v3(data->mat, nor);
 
-    /* populate tangent space matrix */
-    copy_v3_v3(tsm[0], tangent);
-    copy_v3_v3(tsm[1], binormal);
-    copy_v3_v3(tsm[2], normal);
+  invert_m3_m3(itsm, tsm);
+  mul_m3_v3(itsm, nor);
+  normalize_v3(nor);
 
-    /* texture values */
-    copy_v3_v3(nor, &result[offset]);
+  /* save back the values */
+  normal_compress(&data->result[offset], nor, data->normal_swizzle);
+}
 
-    /* converts from world space to local space */
-    mul_transposed_mat3_m4_v3(mat, nor);
+void RE_bake_normal_world_to_tangent(const BakePixel pixel_array[],
+                                     const size_t num_pixels,
+                                     const int depth,
+                                     float result[],
+                                     Mesh *me,
+                                     const eBakeNormalSwizzle normal_swizzle[3],
+                                     float mat[4][4])
+{
+  TriTessFace *triangles;
 
-    invert_m3_m3(itsm, tsm);
-    mul_m3_v3(itsm, nor);
-    normalize_v3(nor);
+  Mesh *me_eval = BKE_mesh_copy_for_eval(me, false);
 
-    /* save back the values */
-    normal_compress(&result[offset], nor, normal_swizzle);
-  }
+  triangles = mesh_calc_tri_tessface(me, true, me_eval);
+
+  BLI_assert(num_pixels >= 3);
+
+  BakeNormalTangentData data;
+  data.pixel_array = pixel_array;
+  data.depth = depth;
+  data.result = result;
+  data.triangles = triangles;
+  data.normal_swizzle = normal_swizzle;
+  data.mat = mat;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 4096;
+  BLI_task_parallel_range(
+      0, (int)num_pixels, &data, bake_normal_world_to_tangent_pixel, &settings);
 
   /* garbage collection */
   MEM_freeN(triangles);
@@ -678,6 +678,14 @@ static bool engine_keep_depsgraph(RenderEngine *engine)
   return (engine->re->r.mode & R_PERSISTENT_DATA) || (engine->type->flag & RE_USE_GPU_CONTEXT);
 }
 
+static bool engine_keep_depsgraph_for_next_view_layer(RenderEngine *engine)
+{
+  /* Engines which support shared scene data keep the depsgraph between the view layers of the
+   * same frame, so that their copy of the scene only needs to be updated for what differs between
+   * the view layers. */
+  return engine_keep_depsgraph(engine) || (engine->flag & RE_ENGINE_SHARE_DEPSGRAPH);
+}
+
 /* Depsgraph */
 static void engine_depsgraph_init(RenderEngine *engine, ViewLayer *view_layer)
 {
@@ -740,7 +748,7 @@ static void engine_depsgraph_init(RenderEngine *engine, ViewLayer *view_layer)
 static void engine_depsgraph_exit(RenderEngine *engine)
 {
   if (engine->depsgraph) {
-    if (engine_keep_depsgraph(engine)) {
+    if (engine_keep_depsgraph_for_next_view_layer(engine)) {
       /* Clear recalc flags since the engine should have handled the updates for the currently
        * rendered framed by now. */
       DEG_ids_clear_recalc(engine->depsgraph, false);
@@ -1017,7 +1025,21 @@ bool RE_engine_render(Render *re, bool do_all)
   bool delay_grease_pencil = false;
 
   if (type->render) {
+    int num_view_layers_to_render = 0;
+    FOREACH_VIEW_LAYER_TO_RENDER_BEGIN (re, view_layer_iter) {
+      num_view_layers_to_render++;
+    }
+    FOREACH_VIEW_LAYER_TO_RENDER_END;
+
     FOREACH_VIEW_LAYER_TO_RENDER_BEGIN (re, view_layer_iter) {
+      /* Share the depsgraph with the next view layer, the last one frees it as usual. */
+      if ((type->flag & RE_USE_SHARED_SCENE_DATA) && --num_view_layers_to_render > 0) {
+        engine->flag |= RE_ENGINE_SHARE_DEPSGRAPH;
+      }
+      else {
+        engine->flag &= ~RE_ENGINE_SHARE_DEPSGRAPH;
+      }
+
       engine_render_view_layer(re, engine, view_layer_iter, true, true);
 
       /* If render passes are not allocated the render engine deferred final pixels write for
@@ -1030,6 +1052,8 @@ bool RE_engine_render(Render *re, bool do_all)
       }
     }
     FOREACH_VIEW_LAYER_TO_RENDER_END;
+
+    engine->flag &= ~RE_ENGINE_SHARE_DEPSGRAPH;
   }
 
   if (type->render_frame_finish) {
@@ -1122,7 +1146,7 @@ void RE_engine_free_blender_memory(RenderEngine *engine)
    *
    * TODO(sergey): Find better solution for this.
    */
-  if (engine->has_grease_pencil || engine_keep_depsgraph(engine)) {
+  if (engine->has_grease_pencil || engine_keep_depsgraph_for_next_view_layer(engine)) {
     return;
   }
   engine_depsgraph_free(engine);
@@ -31,6 +31,7 @@
 #include "BLI_path_util.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_timecode.h"
 
@@ -155,12 +156,15 @@ static void render_callback_exec_id(Render *re, Main *bmain, ID *id, eCbEvent ev
 /** \name Allocation & Free
  * \{ */
 
+struct RenderWriteQueue;
+
 static int do_write_image_or_movie(Render *re,
                                    Main *bmain,
                                    Scene *scene,
                                    bMovieHandle *mh,
                                    const int totvideos,
-                                   const char *name_override);
+                                   const char *name_override,
+                                   struct RenderWriteQueue *write_queue);
 
 /* default callbacks, set in each new render */
 static void result_nothing(void *UNUSED(arg), RenderResult *UNUSED(rr))
@@ -1412,6 +1416,7 @@ static void do_render_full_pipeline(Render *re)
   BKE_image_all_free_anim_ibufs(re->main, re->r.cfra);
   SEQ_cache_cleanup(re->scene);
 
+  const eMEM_Category mem_category = MEM_category_set(MEM_CATEGORY_RENDER);
   if (RE_engine_render(re, true)) {
     /* in this case external render overrides all */
   }
@@ -1428,6 +1433,7 @@ static void do_render_full_pipeline(Render *re)
   else {
     do_render_compositor(re);
   }
+  MEM_category_set(mem_category);
 
   re->i.lastframetime = PIL_check_seconds_timer() - re->i.starttime;
 
@@ -1849,7 +1855,7 @@ void RE_RenderFrame(Render *re,
                                      NULL);
 
         /* reports only used for Movie */
-        do_write_image_or_movie(re, bmain, scene, NULL, 0, name);
+        do_write_image_or_movie(re, bmain, scene, NULL, 0, name, NULL);
       }
     }
 
@@ -2027,12 +2033,151 @@ bool RE_WriteRenderViewsMovie(ReportList *reports,
   return ok;
 }
 
+/**
+ * Animation frames are written to image files in a background thread, so that the next frame is
+ * evaluated and rendered while the previous frame is encoded and written. Movie frames are still
+ * appended from the render thread, they have to be written in order.
+ */
+
+/** The number of frames that can be waiting to be written while the next frame renders. */
+#define RENDER_WRITE_QUEUE_MAX 2
+
+typedef struct RenderWriteTask {
+  struct RenderWriteTask *next, *prev;
+  /** Copy of the views (and layers for EXR) of the frame, freed once it's written. */
+  RenderResult *rr;
+  /** Copy of the scene, so that the writing uses the settings of the frame like `r.cfra`. */
+  Scene tmp_scene;
+  char name[FILE_MAX];
+  /** Reports of the writing, moved to the render reports from the render thread. */
+  ReportList reports;
+  bool ok;
+  /** Protected by #RenderWriteQueue.mutex. */
+  bool done;
+} RenderWriteTask;
+
+typedef struct RenderWriteQueue {
+  TaskPool *pool;
+  /** Scheduled tasks in order of the frames, only accessed from the render thread. */
+  ListBase tasks;
+  ThreadMutex mutex;
+  ThreadCondition condition;
+} RenderWriteQueue;
+
+static void render_write_task_run(TaskPool *__restrict pool, void *taskdata)
+{
+  RenderWriteQueue *queue = BLI_task_pool_user_data(pool);
+  RenderWriteTask *task = taskdata;
+
+  task->ok = BKE_image_render_write(&task->reports, task->rr, &task->tmp_scene, true, task->name);
+  RE_FreeRenderResult(task->rr);
+  task->rr = NULL;
+
+  BLI_mutex_lock(&queue->mutex);
+  task->done = true;
+  BLI_condition_notify_all(&queue->condition);
+  BLI_mutex_unlock(&queue->mutex);
+}
+
+static void render_write_queue_init(RenderWriteQueue *queue)
+{
+  /* Serial, the encoders of formats like EXR are multi-threaded already, and the queue is
+   * bounded by the frames that are waiting anyway. */
+  queue->pool = BLI_task_pool_create_background_serial(queue, TASK_PRIORITY_LOW);
+  BLI_listbase_clear(&queue->tasks);
+  BLI_mutex_init(&queue->mutex);
+  BLI_condition_init(&queue->condition);
+}
+
+static void render_write_queue_push(RenderWriteQueue *queue,
+                                    RenderResult *rres,
+                                    const Scene *scene,
+                                    const char *name)
+{
+  RenderWriteTask *task = MEM_callocN(sizeof(RenderWriteTask), __func__);
+
+  /* The views of the acquired result point to the buffers of the render, which are reused for
+   * the next frame. The layers are only written to EXR files, don't copy them otherwise. */
+  RenderResult rr_write = *rres;
+  if (!ELEM(scene->r.im_format.imtype, R_IMF_IMTYPE_OPENEXR, R_IMF_IMTYPE_MULTILAYER)) {
+    BLI_listbase_clear(&rr_write.layers);
+  }
+  task->rr = RE_DuplicateRenderResult(&rr_write);
+  memcpy(&task->tmp_scene, scene, sizeof(task->tmp_scene));
+  BLI_strncpy(task->name, name, sizeof(task->name));
+  BKE_reports_init(&task->reports, RPT_STORE);
+
+  BLI_addtail(&queue->tasks, task);
+  BLI_task_pool_push(queue->pool, render_write_task_run, task, false, NULL);
+}
+
+/**
+ * Finish the written frames in order, waiting until at most \a max_pending frames are left to
+ * be written. The #BKE_CB_EVT_RENDER_WRITE callbacks run here, once the file of a frame exists.
+ *
+ * \return false when writing a frame failed.
+ */
+static bool render_write_queue_flush(Render *re,
+                                     Scene *scene,
+                                     RenderWriteQueue *queue,
+                                     const int max_pending)
+{
+  bool ok = true;
+  RenderWriteTask *task;
+
+  while ((task = queue->tasks.first)) {
+    BLI_mutex_lock(&queue->mutex);
+    while (!task->done &&
+           BLI_listbase_count_at_most(&queue->tasks, max_pending + 1) > max_pending) {
+      BLI_condition_wait(&queue->condition, &queue->mutex);
+    }
+    const bool done = task->done;
+    BLI_mutex_unlock(&queue->mutex);
+
+    if (!done) {
+      break;
+    }
+
+    BLI_remlink(&queue->tasks, task);
+    LISTBASE_FOREACH (Report *, report, &task->reports.list) {
+      BKE_report(re->reports, report->type, report->message);
+    }
+    BKE_reports_clear(&task->reports);
+
+    ok &= task->ok;
+    if (ok) {
+      /* Callbacks get the frame that was written, the scene may be at a later frame already. */
+      const int cfra = scene->r.cfra;
+      scene->r.cfra = task->tmp_scene.r.cfra;
+      render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_WRITE);
+      scene->r.cfra = cfra;
+    }
+    MEM_freeN(task);
+  }
+
+  return ok;
+}
+
+static bool render_write_queue_free(Render *re, Scene *scene, RenderWriteQueue *queue)
+{
+  BLI_task_pool_work_and_wait(queue->pool);
+  const bool ok = render_write_queue_flush(re, scene, queue, 0);
+  BLI_assert(BLI_listbase_is_empty(&queue->tasks));
+
+  BLI_task_pool_free(queue->pool);
+  BLI_mutex_end(&queue->mutex);
+  BLI_condition_end(&queue->condition);
+
+  return ok;
+}
+
 static int do_write_image_or_movie(Render *re,
                                    Main *bmain,
                                    Scene *scene,
                                    bMovieHandle *mh,
                                    const int totvideos,
-                                   const char *name_override)
+                                   const char *name_override,
+                                   RenderWriteQueue *write_queue)
 {
   char name[FILE_MAX];
   RenderResult rres;
@@ -2068,7 +2213,12 @@ static int do_write_image_or_movie(Render *re,
       }
 
       /* write images as individual images or stereo */
-      ok = BKE_image_render_write(re->reports, &rres, scene, true, name);
+      if (write_queue) {
+        render_write_queue_push(write_queue, &rres, scene, name);
+      }
+      else {
+        ok = BKE_image_render_write(re->reports, &rres, scene, true, name);
+      }
     }
 
     RE_ReleaseResultImageViews(re, &rres);
@@ -2211,6 +2361,13 @@ void RE_RenderAnim(Render *re,
     }
   }
 
+  RenderWriteQueue write_queue_data;
+  RenderWriteQueue *write_queue = NULL;
+  if (!is_movie && do_write_file) {
+    write_queue = &write_queue_data;
+    render_write_queue_init(write_queue);
+  }
+
   /* Ugly global still... is to prevent renderwin events and signal subdivision-surface etc
    * to make full resolution is also set by caller renderwin.c */
   G.is_rendering = true;
@@ -2337,7 +2494,11 @@ void RE_RenderAnim(Render *re,
 
       if (re->test_break(re->tbh) == 0) {
         if (!G.is_break) {
-          if (!do_write_image_or_movie(re, bmain, scene, mh, totvideos, NULL)) {
+          if (!do_write_image_or_movie(re, bmain, scene, mh, totvideos, NULL, write_queue)) {
+            G.is_break = true;
+          }
+          else if (write_queue &&
+                   !render_write_queue_flush(re, scene, write_queue, RENDER_WRITE_QUEUE_MAX)) {
             G.is_break = true;
           }
         }
@@ -2349,6 +2510,9 @@ void RE_RenderAnim(Render *re,
       if (G.is_break == true) {
         /* remove touched file */
         if (is_movie == false && do_write_file) {
+          /* The touched file may still be written. */
+          BLI_task_pool_work_and_wait(write_queue->pool);
+
           if (rd.mode & R_TOUCH) {
             if (!is_multiview_name) {
               if ((BLI_file_size(name) == 0)) {
@@ -2382,11 +2546,19 @@ void RE_RenderAnim(Render *re,
       if (G.is_break == false) {
         /* keep after file save */
         render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_POST);
-        render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_WRITE);
+        if (write_queue == NULL) {
+          render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_WRITE);
+        }
       }
     }
   }
 
+  if (write_queue) {
+    if (!render_write_queue_free(re, scene, write_queue)) {
+      G.is_break = true;
+    }
+  }
+
   /* end movie */
   if (is_movie && do_write_file) {
     re_movie_free_all(re, mh, totvideos);
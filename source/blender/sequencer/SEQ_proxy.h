@@ -33,6 +33,11 @@ void SEQ_proxy_rebuild(struct SeqIndexBuildContext *context,
                        short *do_update,
                        float *progress);
 void SEQ_proxy_rebuild_finish(struct SeqIndexBuildContext *context, bool stop);
+/**
+ * Proxies of movie strips only use the decoder and encoder of the strip, so they can be built
+ * concurrently with other strips.
+ */
+bool SEQ_proxy_rebuild_supports_threads(const struct SeqIndexBuildContext *context);
 void SEQ_proxy_set(struct Sequence *seq, bool value);
 bool SEQ_can_use_proxy(const struct SeqRenderData *context, struct Sequence *seq, int psize);
 int SEQ_rendersize_to_proxysize(int render_size);
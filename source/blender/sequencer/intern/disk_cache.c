@@ -51,7 +51,8 @@
  * For each cached non-temp image, image data and supplementary info are written to HDD.
  * Multiple(DCACHE_IMAGES_PER_FILE) images share the same file.
  * Each of these files contains header DiskCacheHeader followed by image data.
- * Zlib compression with user definable level can be used to compress image data(per image)
+ * Zstd compression with user definable level can be used to compress image data(per image),
+ * using multiple threads for large images.
  * Images are written in order in which they are rendered.
  * Overwriting of individual entry is not possible.
  * Stored images are deleted by invalidation, or when size of all files exceeds maximum
@@ -427,8 +428,12 @@ static size_t deflate_imbuf_to_file(ImBuf *ibuf,
 
   /* Apply compression if wanted, otherwise just write directly to the file. */
   if (level > 0) {
-    return BLI_file_zstd_from_mem_at_pos(
-        data, header_entry->size_raw, file, header_entry->offset, level);
+    return BLI_file_zstd_from_mem_at_pos(data,
+                                         header_entry->size_raw,
+                                         file,
+                                         header_entry->offset,
+                                         level,
+                                         BLI_system_thread_count());
   }
 
   fseek(file, header_entry->offset, SEEK_SET);
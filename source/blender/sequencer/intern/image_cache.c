@@ -5,9 +5,11 @@
  * \ingroup bke
  */
 
+#include <math.h>
 #include <memory.h>
 #include <stddef.h>
 #include <time.h>
+#include <zstd.h>
 
 #include "MEM_guardedalloc.h"
 
@@ -65,9 +67,16 @@
  * entries one by one in reverse order to their creation.
  *
  * User can exclude caching of some images. Such entries will have is_temp_cache set.
+ *
+ * Compression: When a final frame is recycled, its image is compressed in place instead of being
+ * freed, only its source images are freed. Compressed frames use up to a quarter of the memory
+ * cache limit, the ones farthest from the current frame are freed first. They are decompressed
+ * when requested again, so entries are looked up in RAM, then compressed RAM, then disk cache.
  */
 
 #define THUMB_CACHE_LIMIT 5000
+/* Fast compression, final frames are compressed while rendering. */
+#define SEQ_CACHE_COMPRESSION_LEVEL 1
 
 typedef struct SeqCache {
   Main *bmain;
@@ -78,11 +87,25 @@ typedef struct SeqCache {
   struct SeqCacheKey *last_key;
   struct SeqDiskCache *disk_cache;
   int thumbnail_count;
+  /* Memory used by compressed images. */
+  size_t compressed_size;
 } SeqCache;
 
+typedef struct SeqCacheCompressedImage {
+  void *data;
+  size_t size_compressed;
+  size_t size_raw;
+  int x, y;
+  unsigned char planes;
+  bool is_float;
+  struct ColorSpace *colorspace;
+} SeqCacheCompressedImage;
+
 typedef struct SeqCacheItem {
   struct SeqCache *cache_owner;
   struct ImBuf *ibuf;
+  /* Compressed final frame, set instead of ibuf. */
+  struct SeqCacheCompressedImage *compressed;
 } SeqCacheItem;
 
 static ThreadMutex cache_create_lock = BLI_MUTEX_INITIALIZER;
@@ -180,12 +203,93 @@ static size_t seq_cache_get_mem_total(void)
   return ((size_t)U.memcachelimit) * 1024 * 1024;
 }
 
+/* Part of the memory cache limit which can be used by compressed images. */
+static size_t seq_cache_get_compressed_mem_total(void)
+{
+  return seq_cache_get_mem_total() / 4;
+}
+
 static void seq_cache_keyfree(void *val)
 {
   SeqCacheKey *key = val;
   BLI_mempool_free(key->cache_owner->keys_pool, key);
 }
 
+static void seq_cache_compressed_image_free(SeqCache *cache, SeqCacheCompressedImage *image)
+{
+  cache->compressed_size -= image->size_compressed;
+  MEM_freeN(image->data);
+  MEM_freeN(image);
+}
+
+/**
+ * Compresses the image of given item in place. Returns false if the image can't be compressed
+ * or if compression wouldn't free most of its memory.
+ */
+static bool seq_cache_compress_item(SeqCache *cache, SeqCacheItem *item)
+{
+  ImBuf *ibuf = item->ibuf;
+  const bool is_float = ibuf->rect == NULL;
+  void *data = is_float ? (void *)ibuf->rect_float : (void *)ibuf->rect;
+  if (data == NULL || (is_float && ibuf->channels != 4)) {
+    return false;
+  }
+
+  const size_t size_raw = (size_t)ibuf->x * ibuf->y * (is_float ? sizeof(float[4]) : 4);
+  const size_t size_bound = ZSTD_compressBound(size_raw);
+  void *compressed_data = MEM_mallocN(size_bound, "SeqCacheCompressedImage data");
+
+  ZSTD_CCtx *ctx = ZSTD_createCCtx();
+  ZSTD_CCtx_setParameter(ctx, ZSTD_c_compressionLevel, SEQ_CACHE_COMPRESSION_LEVEL);
+  /* Fails without multi-threading support, compression is then done on the calling thread. */
+  ZSTD_CCtx_setParameter(ctx, ZSTD_c_nbWorkers, BLI_system_thread_count());
+  const size_t size_compressed = ZSTD_compress2(
+      ctx, compressed_data, size_bound, data, size_raw);
+  ZSTD_freeCCtx(ctx);
+
+  if (ZSTD_isError(size_compressed) || size_compressed > size_raw / 4 * 3) {
+    MEM_freeN(compressed_data);
+    return false;
+  }
+
+  SeqCacheCompressedImage *image = MEM_mallocN(sizeof(SeqCacheCompressedImage), __func__);
+  image->data = MEM_reallocN(compressed_data, size_compressed);
+  image->size_compressed = size_compressed;
+  image->size_raw = size_raw;
+  image->x = ibuf->x;
+  image->y = ibuf->y;
+  image->planes = ibuf->planes;
+  image->is_float = is_float;
+  image->colorspace = is_float ? ibuf->float_colorspace : ibuf->rect_colorspace;
+
+  IMB_freeImBuf(item->ibuf);
+  item->ibuf = NULL;
+  item->compressed = image;
+  cache->compressed_size += size_compressed;
+  return true;
+}
+
+static ImBuf *seq_cache_decompress_image(const SeqCacheCompressedImage *image)
+{
+  ImBuf *ibuf = IMB_allocImBuf(
+      image->x, image->y, image->planes, image->is_float ? IB_rectfloat : IB_rect);
+  void *data = image->is_float ? (void *)ibuf->rect_float : (void *)ibuf->rect;
+
+  const size_t size = ZSTD_decompress(data, image->size_raw, image->data, image->size_compressed);
+  if (ZSTD_isError(size) || size != image->size_raw) {
+    IMB_freeImBuf(ibuf);
+    return NULL;
+  }
+
+  if (image->is_float) {
+    ibuf->float_colorspace = image->colorspace;
+  }
+  else {
+    ibuf->rect_colorspace = image->colorspace;
+  }
+  return ibuf;
+}
+
 static void seq_cache_valfree(void *val)
 {
   SeqCacheItem *item = (SeqCacheItem *)val;
@@ -194,6 +298,10 @@ static void seq_cache_valfree(void *val)
     IMB_freeImBuf(item->ibuf);
   }
 
+  if (item->compressed) {
+    seq_cache_compressed_image_free(item->cache_owner, item->compressed);
+  }
+
   BLI_mempool_free(item->cache_owner->items_pool, item);
 }
 
@@ -220,6 +328,7 @@ static void seq_cache_put_ex(Scene *scene, SeqCacheKey *key, ImBuf *ibuf)
   item = BLI_mempool_alloc(cache->items_pool);
   item->cache_owner = cache;
   item->ibuf = ibuf;
+  item->compressed = NULL;
 
   const int stored_types_flag = get_stored_types_flag(scene, key);
 
@@ -257,6 +366,15 @@ static ImBuf *seq_cache_get_ex(SeqCache *cache, SeqCacheKey *key)
 {
   SeqCacheItem *item = BLI_ghash_lookup(cache->hash, key);
 
+  /* Decompressed image is kept uncompressed until the item is recycled again. */
+  if (item && item->compressed) {
+    item->ibuf = seq_cache_decompress_image(item->compressed);
+    if (item->ibuf) {
+      seq_cache_compressed_image_free(cache, item->compressed);
+      item->compressed = NULL;
+    }
+  }
+
   if (item && item->ibuf) {
     IMB_refImBuf(item->ibuf);
 
@@ -402,14 +520,14 @@ static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
     BLI_ghashIterator_step(&gh_iter);
 
     /* This shouldn't happen, but better be safe than sorry. */
-    if (!item->ibuf) {
+    if (!item->ibuf && !item->compressed) {
       seq_cache_recycle_linked(scene, key);
       /* Can not continue iterating after linked remove. */
       BLI_ghashIterator_init(&gh_iter, cache->hash);
       continue;
     }
 
-    if (key->is_temp_cache || key->link_next != NULL) {
+    if (key->is_temp_cache || key->link_next != NULL || item->compressed) {
       continue;
     }
 
@@ -438,6 +556,62 @@ static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
   return finalkey;
 }
 
+/* Free compressed image farthest from current frame. */
+static bool seq_cache_free_farthest_compressed_item(Scene *scene)
+{
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+  SeqCacheKey *farthest_key = NULL;
+  float farthest_distance = -1.0f;
+
+  GHashIterator gh_iter;
+  GHASH_ITER (gh_iter, cache->hash) {
+    SeqCacheKey *key = BLI_ghashIterator_getKey(&gh_iter);
+    SeqCacheItem *item = BLI_ghashIterator_getValue(&gh_iter);
+    if (item->compressed == NULL) {
+      continue;
+    }
+
+    const float distance = fabsf(key->timeline_frame - scene->r.cfra);
+    if (distance > farthest_distance) {
+      farthest_distance = distance;
+      farthest_key = key;
+    }
+  }
+
+  if (farthest_key == NULL) {
+    return false;
+  }
+
+  BLI_ghash_remove(cache->hash, farthest_key, seq_cache_keyfree, seq_cache_valfree);
+  return true;
+}
+
+/**
+ * Free final frame and its source images. The final image is compressed instead, if it can be.
+ */
+static void seq_cache_recycle_or_compress_linked(Scene *scene, SeqCacheKey *finalkey)
+{
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+  SeqCacheItem *item = BLI_ghash_lookup(cache->hash, finalkey);
+
+  if (finalkey->type != SEQ_CACHE_STORE_FINAL_OUT || !seq_cache_compress_item(cache, item)) {
+    seq_cache_recycle_linked(scene, finalkey);
+    return;
+  }
+
+  /* Unlink compressed item, so only its source images are freed. */
+  SeqCacheKey *prev = finalkey->link_prev;
+  finalkey->link_prev = NULL;
+  if (prev && BLI_ghash_haskey(cache->hash, prev) && prev->link_next == finalkey) {
+    prev->link_next = NULL;
+    seq_cache_recycle_linked(scene, prev);
+  }
+
+  while (cache->compressed_size > seq_cache_get_compressed_mem_total()) {
+    seq_cache_free_farthest_compressed_item(scene);
+  }
+}
+
 bool seq_cache_recycle_item(Scene *scene)
 {
   SeqCache *cache = seq_cache_get_from_scene(scene);
@@ -451,9 +625,9 @@ bool seq_cache_recycle_item(Scene *scene)
     SeqCacheKey *finalkey = seq_cache_get_item_for_removal(scene);
 
     if (finalkey) {
-      seq_cache_recycle_linked(scene, finalkey);
+      seq_cache_recycle_or_compress_linked(scene, finalkey);
     }
-    else {
+    else if (!seq_cache_free_farthest_compressed_item(scene)) {
       seq_cache_unlock(scene);
       return false;
     }
@@ -549,6 +549,11 @@ void SEQ_proxy_rebuild(SeqIndexBuildContext *context,
   }
 }
 
+bool SEQ_proxy_rebuild_supports_threads(const SeqIndexBuildContext *context)
+{
+  return context->seq->type == SEQ_TYPE_MOVIE;
+}
+
 void SEQ_proxy_rebuild_finish(SeqIndexBuildContext *context, bool stop)
 {
   if (context->index_context) {
@@ -9,10 +9,15 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "atomic_ops.h"
+
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
+#include "BLI_task.h"
 #include "BLI_timecode.h"
 
+#include "PIL_time.h"
+
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
 
@@ -40,22 +45,120 @@ static void proxy_freejob(void *pjv)
   MEM_freeN(pj);
 }
 
+typedef struct ProxyTask {
+  struct SeqIndexBuildContext *context;
+  short *stop;
+  short do_update;
+  float progress;
+  int32_t done;
+} ProxyTask;
+
+static void proxy_task_run(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  ProxyTask *task = taskdata;
+  SEQ_proxy_rebuild(task->context, task->stop, &task->do_update, &task->progress);
+  atomic_fetch_and_or_int32(&task->done, 1);
+}
+
+/**
+ * Report the average progress of all strips. Returns true when all tasks are done.
+ */
+static bool proxy_tasks_progress_update(ProxyTask *tasks,
+                                        const int tasks_num,
+                                        short *do_update,
+                                        float *progress)
+{
+  bool all_done = true;
+  float progress_sum = 0.0f;
+  for (int i = 0; i < tasks_num; i++) {
+    ProxyTask *task = &tasks[i];
+    const bool done = atomic_fetch_and_or_int32(&task->done, 0) != 0;
+    progress_sum += done ? 1.0f : task->progress;
+    if (task->do_update) {
+      task->do_update = false;
+      *do_update = true;
+    }
+    all_done &= done;
+  }
+  const float next_progress = progress_sum / tasks_num;
+  if (*progress != next_progress) {
+    *progress = next_progress;
+    *do_update = true;
+  }
+  return all_done;
+}
+
+/**
+ * Build the proxies of the strips from \a first to the end of the queue.
+ * Returns the last link that was handled.
+ */
+static LinkData *proxy_rebuild_queue_from(LinkData *first,
+                                          short *stop,
+                                          short *do_update,
+                                          float *progress)
+{
+  LinkData *link, *last = first;
+
+  int tasks_num = 0;
+  for (link = first; link; link = link->next) {
+    tasks_num++;
+  }
+  ProxyTask *tasks = MEM_calloc_arrayN(tasks_num, sizeof(ProxyTask), __func__);
+
+  /* Movie strips decode and encode with their own FFmpeg contexts, so they are built
+   * concurrently in the background. Other strips use the sequencer render pipeline and are
+   * built one after another by this thread in the meantime. */
+  TaskPool *task_pool = BLI_task_pool_create_background(NULL, TASK_PRIORITY_LOW);
+  int i = 0;
+  for (link = first; i < tasks_num; link = link->next, i++) {
+    ProxyTask *task = &tasks[i];
+    task->context = link->data;
+    task->stop = stop;
+    if (SEQ_proxy_rebuild_supports_threads(task->context)) {
+      BLI_task_pool_push(task_pool, proxy_task_run, task, false, NULL);
+    }
+    last = link;
+  }
+
+  for (i = 0; i < tasks_num; i++) {
+    ProxyTask *task = &tasks[i];
+    if (SEQ_proxy_rebuild_supports_threads(task->context)) {
+      continue;
+    }
+    if (*stop) {
+      task->done = 1;
+      continue;
+    }
+    proxy_task_run(task_pool, task);
+    proxy_tasks_progress_update(tasks, tasks_num, do_update, progress);
+  }
+
+  while (!proxy_tasks_progress_update(tasks, tasks_num, do_update, progress)) {
+    PIL_sleep_ms(50);
+  }
+  BLI_task_pool_work_and_wait(task_pool);
+  BLI_task_pool_free(task_pool);
+  MEM_freeN(tasks);
+
+  return last;
+}
+
 /* Only this runs inside thread. */
 static void proxy_startjob(void *pjv, short *stop, short *do_update, float *progress)
 {
   ProxyJob *pj = pjv;
-  LinkData *link;
-
-  for (link = pj->queue.first; link; link = link->next) {
-    struct SeqIndexBuildContext *context = link->data;
 
-    SEQ_proxy_rebuild(context, stop, do_update, progress);
+  /* Strips can be added to the queue while the job is running, they are built afterwards. */
+  LinkData *first = pj->queue.first;
+  while (first) {
+    LinkData *last = proxy_rebuild_queue_from(first, stop, do_update, progress);
 
     if (*stop) {
       pj->stop = 1;
       fprintf(stderr, "Canceling proxy rebuild on users request...\n");
       break;
     }
+    first = last->next;
   }
 }
 
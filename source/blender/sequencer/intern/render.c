@@ -22,6 +22,7 @@
 #include "BLI_listbase.h"
 #include "BLI_path_util.h"
 #include "BLI_rect.h"
+#include "BLI_task.h"
 
 #include "BKE_anim_data.h"
 #include "BKE_animsys.h"
@@ -1807,6 +1808,73 @@ static ImBuf *seq_render_strip_stack_apply_effect(
   return out;
 }
 
+/* Strips which only read their own data, so they can be rendered concurrently. Scene strips
+ * render other scenes, effect and meta strips render other strips. */
+static bool seq_can_render_strip_in_parallel(Sequence *seq)
+{
+  return ELEM(seq->type, SEQ_TYPE_IMAGE, SEQ_TYPE_MOVIE) &&
+         seq_get_early_out_for_blend_mode(seq) == EARLY_DO_EFFECT;
+}
+
+typedef struct RenderStripsParallelData {
+  const SeqRenderData *context;
+  const SeqRenderState *state;
+  Sequence **seq_arr;
+  float timeline_frame;
+  ImBuf **r_ibufs;
+} RenderStripsParallelData;
+
+static void seq_render_strip_parallel_fn(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  RenderStripsParallelData *data = userdata;
+  Sequence *seq = data->seq_arr[i];
+  if (seq_can_render_strip_in_parallel(seq)) {
+    /* Don't share the render state between threads, it is only modified by scene strips. */
+    SeqRenderState state = *data->state;
+    data->r_ibufs[i] = seq_render_strip(data->context, &state, seq, data->timeline_frame);
+  }
+}
+
+/**
+ * Renders the strips of the stack from \a start to \a count that are blended, in parallel.
+ * Decoding, modifiers and transform are done per strip, only blending has to follow the stack
+ * order. \a r_ibufs is left NULL for strips which aren't rendered, the caller renders them
+ * serially when needed.
+ */
+static void seq_render_strip_stack_parallel(const SeqRenderData *context,
+                                            const SeqRenderState *state,
+                                            Sequence **seq_arr,
+                                            const int start,
+                                            const int count,
+                                            float timeline_frame,
+                                            ImBuf **r_ibufs)
+{
+  int num_parallel = 0;
+  for (int i = start; i < count; i++) {
+    r_ibufs[i] = NULL;
+    if (seq_can_render_strip_in_parallel(seq_arr[i])) {
+      num_parallel++;
+    }
+  }
+  if (num_parallel < 2) {
+    return;
+  }
+
+  RenderStripsParallelData data = {
+      .context = context,
+      .state = state,
+      .seq_arr = seq_arr,
+      .timeline_frame = timeline_frame,
+      .r_ibufs = r_ibufs,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(start, count, &data, seq_render_strip_parallel_fn, &settings);
+}
+
 static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
                                      SeqRenderState *state,
                                      ListBase *seqbasep,
@@ -1885,12 +1953,16 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
   }
 
   i++;
+  ImBuf *ibuf_arr[MAXSEQ + 1];
+  seq_render_strip_stack_parallel(context, state, seq_arr, i, count, timeline_frame, ibuf_arr);
+
   for (; i < count; i++) {
     Sequence *seq = seq_arr[i];
 
     if (seq_get_early_out_for_blend_mode(seq) == EARLY_DO_EFFECT) {
       ImBuf *ibuf1 = out;
-      ImBuf *ibuf2 = seq_render_strip(context, state, seq, timeline_frame);
+      ImBuf *ibuf2 = ibuf_arr[i] ? ibuf_arr[i] :
+                                   seq_render_strip(context, state, seq, timeline_frame);
 
       out = seq_render_strip_stack_apply_effect(context, seq, timeline_frame, ibuf1, ibuf2);
 
@@ -709,25 +709,33 @@ static void cloth_calc_force(
     float(*winvec)[3] = (float(*)[3])MEM_callocN(sizeof(float[3]) * mvert_num * 2,
                                                  "effector forces");
     float(*forcevec)[3] = is_not_hair ? winvec + mvert_num : winvec;
+    float(*positions)[3] = (float(*)[3])MEM_mallocN(sizeof(float[6]) * mvert_num, __func__);
+    float(*velocities)[3] = positions + mvert_num;
+    EffectedPoint *epoints = (EffectedPoint *)MEM_mallocN(sizeof(EffectedPoint) * mvert_num,
+                                                          __func__);
 
     for (i = 0; i < cloth->mvert_num; i++) {
-      float x[3], v[3];
-      EffectedPoint epoint;
-
-      SIM_mass_spring_get_motion_state(data, i, x, v);
-      pd_point_from_loc(scene, x, v, i, &epoint);
-      BKE_effectors_apply(effectors,
-                          nullptr,
-                          clmd->sim_parms->effector_weights,
-                          &epoint,
-                          forcevec[i],
-                          winvec[i],
-                          nullptr);
+      SIM_mass_spring_get_motion_state(data, i, positions[i], velocities[i]);
+      pd_point_from_loc(scene, positions[i], velocities[i], i, &epoints[i]);
+    }
+
+    BKE_effectors_apply_array(effectors,
+                              nullptr,
+                              clmd->sim_parms->effector_weights,
+                              epoints,
+                              cloth->mvert_num,
+                              forcevec,
+                              winvec,
+                              nullptr);
 
+    for (i = 0; i < cloth->mvert_num; i++) {
       has_wind = has_wind || !is_zero_v3(winvec[i]);
       has_force = has_force || !is_zero_v3(forcevec[i]);
     }
 
+    MEM_freeN(epoints);
+    MEM_freeN(positions);
+
     /* Hair has only edges. */
     if (is_not_hair) {
       for (i = 0; i < cloth->primitive_num; i++) {
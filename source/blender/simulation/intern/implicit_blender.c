@@ -18,6 +18,7 @@
 #  include "DNA_texture_types.h"
 
 #  include "BLI_math.h"
+#  include "BLI_task.h"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_cloth.h"
@@ -30,9 +31,11 @@
 #    pragma GCC diagnostic ignored "-Wtype-limits"
 #  endif
 
-#  ifdef _OPENMP
-#    define CLOTH_OPENMP_LIMIT 512
-#  endif
+/* Minimum number of vertices to solve in parallel. */
+#  define CLOTH_PARALLEL_LIMIT 512
+/* Number of vertices of a long vector that are processed by one task. The chunks are fixed so
+ * that reductions sum in the same order, independent of the number of threads. */
+#  define LFVECTOR_CHUNK_SIZE 1024
 
 //#define DEBUG_TIME
 
@@ -176,20 +179,84 @@ DO_INLINE void submul_lfvectorS(float (*to)[3],
     VECSUBMUL(to[i], fLongVector[i], scalar);
   }
 }
+typedef struct LfVectorTaskData {
+  float (*to)[3];
+  float (*fLongVectorA)[3];
+  float (*fLongVectorB)[3];
+  float bS;
+  unsigned int verts;
+  /* Result of every chunk for reductions. */
+  float *chunk_sums;
+} LfVectorTaskData;
+
+BLI_INLINE void lfvector_chunk_range(const LfVectorTaskData *data,
+                                     const int chunk,
+                                     unsigned int *r_start,
+                                     unsigned int *r_end)
+{
+  *r_start = (unsigned int)chunk * LFVECTOR_CHUNK_SIZE;
+  *r_end = min_uu(*r_start + LFVECTOR_CHUNK_SIZE, data->verts);
+}
+
+static void lfvector_parallel_chunks(LfVectorTaskData *data, TaskParallelRangeFunc func)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(
+      0, (int)divide_ceil_u(data->verts, LFVECTOR_CHUNK_SIZE), data, func, &settings);
+}
+
+static void dot_lfvector_chunk(void *__restrict userdata,
+                               const int chunk,
+                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  LfVectorTaskData *data = (LfVectorTaskData *)userdata;
+  unsigned int start, end;
+  lfvector_chunk_range(data, chunk, &start, &end);
+
+  float temp = 0.0f;
+  for (unsigned int i = start; i < end; i++) {
+    temp += dot_v3v3(data->fLongVectorA[i], data->fLongVectorB[i]);
+  }
+  data->chunk_sums[chunk] = temp;
+}
+
 /* dot product for big vector */
 DO_INLINE float dot_lfvector(float (*fLongVectorA)[3],
                              float (*fLongVectorB)[3],
                              unsigned int verts)
 {
-  long i = 0;
-  float temp = 0.0;
-  /* XXX brecht, disabled this for now (first schedule line was already disabled),
-   * due to non-commutative nature of floating point ops this makes the sim give
-   * different results each time you run it!
-   * schedule(guided, 2) */
-  //#pragma omp parallel for reduction(+: temp) if (verts > CLOTH_OPENMP_LIMIT)
-  for (i = 0; i < (long)verts; i++) {
-    temp += dot_v3v3(fLongVectorA[i], fLongVectorB[i]);
+  const unsigned int chunks_num = divide_ceil_u(verts, LFVECTOR_CHUNK_SIZE);
+  float temp = 0.0f;
+
+  if (chunks_num <= 1) {
+    for (unsigned int i = 0; i < verts; i++) {
+      temp += dot_v3v3(fLongVectorA[i], fLongVectorB[i]);
+    }
+    return temp;
+  }
+
+  /* Floating point addition isn't associative, so the chunk results are summed in order instead
+   * of reducing them per thread, otherwise the sim gives different results each time it runs. */
+  float chunk_sums_stack[64];
+  float *chunk_sums = chunks_num <= ARRAY_SIZE(chunk_sums_stack) ?
+                          chunk_sums_stack :
+                          MEM_mallocN(sizeof(float) * chunks_num, __func__);
+
+  LfVectorTaskData data = {
+      .fLongVectorA = fLongVectorA,
+      .fLongVectorB = fLongVectorB,
+      .verts = verts,
+      .chunk_sums = chunk_sums,
+  };
+  lfvector_parallel_chunks(&data, dot_lfvector_chunk);
+
+  for (unsigned int i = 0; i < chunks_num; i++) {
+    temp += chunk_sums[i];
+  }
+  if (chunk_sums != chunk_sums_stack) {
+    MEM_freeN(chunk_sums);
   }
   return temp;
 }
@@ -205,6 +272,19 @@ DO_INLINE void add_lfvector_lfvector(float (*to)[3],
     add_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]);
   }
 }
+static void add_lfvector_lfvectorS_chunk(void *__restrict userdata,
+                                         const int chunk,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  LfVectorTaskData *data = (LfVectorTaskData *)userdata;
+  unsigned int start, end;
+  lfvector_chunk_range(data, chunk, &start, &end);
+
+  for (unsigned int i = start; i < end; i++) {
+    VECADDS(data->to[i], data->fLongVectorA[i], data->fLongVectorB[i], data->bS);
+  }
+}
+
 /* `A = B + C * float` -> for big vector. */
 DO_INLINE void add_lfvector_lfvectorS(float (*to)[3],
                                       float (*fLongVectorA)[3],
@@ -212,9 +292,19 @@ DO_INLINE void add_lfvector_lfvectorS(float (*to)[3],
                                       float bS,
                                       unsigned int verts)
 {
-  unsigned int i = 0;
+  if (verts > CLOTH_PARALLEL_LIMIT) {
+    LfVectorTaskData data = {
+        .to = to,
+        .fLongVectorA = fLongVectorA,
+        .fLongVectorB = fLongVectorB,
+        .bS = bS,
+        .verts = verts,
+    };
+    lfvector_parallel_chunks(&data, add_lfvector_lfvectorS_chunk);
+    return;
+  }
 
-  for (i = 0; i < verts; i++) {
+  for (unsigned int i = 0; i < verts; i++) {
     VECADDS(to[i], fLongVectorA[i], fLongVectorB[i], bS);
   }
 }
@@ -256,6 +346,18 @@ DO_INLINE void sub_lfvector_lfvector(float (*to)[3],
     sub_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]);
   }
 }
+/* Component-wise `A = B * C` -> for big vector. */
+DO_INLINE void mul_lfvector_lfvector(float (*to)[3],
+                                     float (*fLongVectorA)[3],
+                                     float (*fLongVectorB)[3],
+                                     unsigned int verts)
+{
+  unsigned int i = 0;
+
+  for (i = 0; i < verts; i++) {
+    mul_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]);
+  }
+}
 ///////////////////////////
 // 3x3 matrix
 ///////////////////////////
@@ -571,6 +673,20 @@ DO_INLINE void cp_bfmatrix(fmatrix3x3 *to, fmatrix3x3 *from)
   memcpy(to, from, sizeof(fmatrix3x3) * (from[0].vcount + from[0].scount));
 }
 
+/* Inverse of the diagonal of a big matrix, for Jacobi preconditioning. */
+DO_INLINE void jacobi_lfvector(float (*to)[3], const fmatrix3x3 *matrix)
+{
+  unsigned int i = 0;
+
+  for (i = 0; i < matrix[0].vcount; i++) {
+    for (int j = 0; j < 3; j++) {
+      const float diag = matrix[i].m[j][j];
+      /* The diagonal is positive for any vertex with mass, fall back to no preconditioning. */
+      to[i][j] = diag > FLT_EPSILON ? 1.0f / diag : 1.0f;
+    }
+  }
+}
+
 /* init big matrix */
 /* slow in parallel */
 DO_INLINE void init_bfmatrix(fmatrix3x3 *matrix, float m3[3][3])
@@ -597,35 +713,114 @@ DO_INLINE void initdiag_bfmatrix(fmatrix3x3 *matrix, float m3[3][3])
   }
 }
 
-/* SPARSE SYMMETRIC multiply big matrix with long vector. */
-/* STATUS: verified */
-DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector *fLongVector)
+/**
+ * Off-diagonal blocks of a big matrix grouped by vertex, so that every vertex of a
+ * multiplication can be computed independently. Only depends on the rows and columns of the
+ * blocks, so it is shared by all matrices with the same structure.
+ */
+typedef struct fmatrixRows {
+  /* First entry of every vertex, the last item is the total number of entries. */
+  unsigned int *offsets;
+  /* Block index shifted by one, the lowest bit is set when the block is in the column of the
+   * vertex, i.e. the block is used transposed. */
+  unsigned int *entries;
+} fmatrixRows;
+
+DO_INLINE void create_bfmatrix_rows(fmatrixRows *rows, unsigned int verts, unsigned int springs)
 {
-  unsigned int vcount = from[0].vcount;
-  lfVector *temp = create_lfvector(vcount);
-
-  zero_lfvector(to, vcount);
-
-#  pragma omp parallel sections if (vcount > CLOTH_OPENMP_LIMIT)
-  {
-#  pragma omp section
-    {
-      for (unsigned int i = from[0].vcount; i < from[0].vcount + from[0].scount; i++) {
-        /* This is the lower triangle of the sparse matrix,
-         * therefore multiplication occurs with transposed submatrices. */
-        muladd_fmatrixT_fvector(to[from[i].c], from[i].m, fLongVector[from[i].r]);
-      }
+  rows->offsets = (unsigned int *)MEM_mallocN(sizeof(unsigned int) * (verts + 1),
+                                              "cloth_implicit_alloc_rows");
+  rows->entries = (unsigned int *)MEM_mallocN(sizeof(unsigned int) * max_uu(springs, 1) * 2,
+                                              "cloth_implicit_alloc_rows");
+}
+
+DO_INLINE void del_bfmatrix_rows(fmatrixRows *rows)
+{
+  MEM_SAFE_FREE(rows->offsets);
+  MEM_SAFE_FREE(rows->entries);
+}
+
+/* Group the first \a num_blocks off-diagonal blocks of \a matrix by vertex,
+ * the remaining blocks are expected to be zero. */
+DO_INLINE void build_bfmatrix_rows(fmatrixRows *rows, const fmatrix3x3 *matrix, int num_blocks)
+{
+  const unsigned int vcount = matrix[0].vcount;
+  const unsigned int blocks_end = vcount + (unsigned int)num_blocks;
+  unsigned int *offsets = rows->offsets;
+  unsigned int total = 0;
+
+  memset(offsets, 0, sizeof(*offsets) * (vcount + 1));
+  for (unsigned int i = vcount; i < blocks_end; i++) {
+    offsets[matrix[i].r]++;
+    offsets[matrix[i].c]++;
+  }
+  /* Offsets of the end of every vertex, moved to the start while filling in the entries. */
+  for (unsigned int v = 0; v < vcount; v++) {
+    total += offsets[v];
+    offsets[v] = total;
+  }
+  offsets[vcount] = total;
+  /* Fill in reverse, so that the entries of every vertex are sorted by block. */
+  for (unsigned int i = blocks_end; i-- > vcount;) {
+    rows->entries[--offsets[matrix[i].c]] = (i << 1) | 1;
+    rows->entries[--offsets[matrix[i].r]] = (i << 1);
+  }
+}
+
+typedef struct BFMatrixMulData {
+  float (*to)[3];
+  const fmatrix3x3 *from;
+  const fmatrixRows *rows;
+  float (*fLongVector)[3];
+} BFMatrixMulData;
+
+static void mul_bfmatrix_lfvector_vert(void *__restrict userdata,
+                                       const int v,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BFMatrixMulData *data = (const BFMatrixMulData *)userdata;
+  const fmatrix3x3 *from = data->from;
+  const fmatrixRows *rows = data->rows;
+  float(*fLongVector)[3] = data->fLongVector;
+  float *to = data->to[v];
+
+  zero_v3(to);
+  muladd_fmatrix_fvector(to, from[v].m, fLongVector[v]);
+
+  for (unsigned int j = rows->offsets[v]; j < rows->offsets[v + 1]; j++) {
+    const fmatrix3x3 *block = &from[rows->entries[j] >> 1];
+    if (rows->entries[j] & 1) {
+      /* This is the lower triangle of the sparse matrix,
+       * therefore multiplication occurs with transposed submatrices. */
+      muladd_fmatrixT_fvector(to, block->m, fLongVector[block->r]);
     }
-#  pragma omp section
-    {
-      for (unsigned int i = 0; i < from[0].vcount + from[0].scount; i++) {
-        muladd_fmatrix_fvector(temp[from[i].r], from[i].m, fLongVector[from[i].c]);
-      }
+    else {
+      muladd_fmatrix_fvector(to, block->m, fLongVector[block->c]);
     }
   }
-  add_lfvector_lfvector(to, to, temp, from[0].vcount);
+}
 
-  del_lfvector(temp);
+/* SPARSE SYMMETRIC multiply big matrix with long vector. */
+/* STATUS: verified */
+DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3],
+                                     fmatrix3x3 *from,
+                                     const fmatrixRows *rows,
+                                     lfVector *fLongVector)
+{
+  unsigned int vcount = from[0].vcount;
+
+  BFMatrixMulData data = {
+      .to = to,
+      .from = from,
+      .rows = rows,
+      .fLongVector = fLongVector,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = vcount > CLOTH_PARALLEL_LIMIT;
+  settings.min_iter_per_thread = 256;
+  BLI_task_parallel_range(0, (int)vcount, &data, mul_bfmatrix_lfvector_vert, &settings);
 }
 
 /* SPARSE SYMMETRIC sub big matrix with big matrix. */
@@ -663,6 +858,8 @@ typedef struct Implicit_Data {
   lfVector *B;   /* B for A*dV = B */
   fmatrix3x3 *A; /* A for A*dV = B */
 
+  fmatrixRows rows;     /* off-diagonal blocks of A, dFdV and dFdX per vertex */
+
   lfVector *dV;         /* velocity change (solution of A*dV = B) */
   lfVector *z;          /* target velocity in constrained directions */
   fmatrix3x3 *S;        /* filtering matrix for constraints */
@@ -691,6 +888,7 @@ Implicit_Data *SIM_mass_spring_solver_create(int numverts, int numsprings)
   id->B = create_lfvector(numverts);
   id->dV = create_lfvector(numverts);
   id->z = create_lfvector(numverts);
+  create_bfmatrix_rows(&id->rows, numverts, numsprings);
 
   initdiag_bfmatrix(id->bigI, I);
 
@@ -717,6 +915,7 @@ void SIM_mass_spring_solver_free(Implicit_Data *id)
   del_lfvector(id->B);
   del_lfvector(id->dV);
   del_lfvector(id->z);
+  del_bfmatrix_rows(&id->rows);
 
   MEM_freeN(id);
 }
@@ -755,10 +954,39 @@ BLI_INLINE void root_to_world_m3(Implicit_Data *data,
 
 /* ================================ */
 
+typedef struct FilterData {
+  lfVector *V;
+  fmatrix3x3 *S;
+} FilterData;
+
+static void filter_chunk(void *__restrict userdata,
+                         const int chunk,
+                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const FilterData *data = (const FilterData *)userdata;
+  const unsigned int start = (unsigned int)chunk * LFVECTOR_CHUNK_SIZE;
+  const unsigned int end = min_uu(start + LFVECTOR_CHUNK_SIZE, data->S[0].vcount);
+
+  for (unsigned int i = start; i < end; i++) {
+    mul_m3_v3(data->S[i].m, data->V[data->S[i].r]);
+  }
+}
+
 DO_INLINE void filter(lfVector *V, fmatrix3x3 *S)
 {
   unsigned int i = 0;
 
+  if (S[0].vcount > CLOTH_PARALLEL_LIMIT) {
+    /* Diagonal blocks only, so every vertex is filtered independently. */
+    FilterData data = {V, S};
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1;
+    BLI_task_parallel_range(
+        0, (int)divide_ceil_u(S[0].vcount, LFVECTOR_CHUNK_SIZE), &data, filter_chunk, &settings);
+    return;
+  }
+
   for (i = 0; i < S[0].vcount; i++) {
     mul_m3_v3(S[i].m, V[S[i].r]);
   }
@@ -836,6 +1064,7 @@ static int cg_filtered(lfVector *ldV, fmatrix3x3 *lA, lfVector *lB, lfVector *z,
 
 static int cg_filtered(lfVector *ldV,
                        fmatrix3x3 *lA,
+                       const fmatrixRows *rows,
                        lfVector *lB,
                        lfVector *z,
                        fmatrix3x3 *S,
@@ -852,23 +1081,29 @@ static int cg_filtered(lfVector *ldV,
   lfVector *c = create_lfvector(numverts);
   lfVector *q = create_lfvector(numverts);
   lfVector *s = create_lfvector(numverts);
+  lfVector *Pinv = create_lfvector(numverts);
   float bnorm2, delta_new, delta_old, delta_target, alpha;
 
+  /* Jacobi preconditioner, the inverse of the diagonal of A. Stiff springs and heavy vertices
+   * make the diagonal vary a lot over the cloth, scaling it out reduces the iterations. */
+  jacobi_lfvector(Pinv, lA);
+
   cp_lfvector(ldV, z, numverts);
 
-  /* d0 = filter(B)^T * P * filter(B) */
+  /* d0 = filter(B)^T * P^-1 * filter(B) */
   cp_lfvector(fB, lB, numverts);
   filter(fB, S);
-  bnorm2 = dot_lfvector(fB, fB, numverts);
+  mul_lfvector_lfvector(AdV, Pinv, fB, numverts);
+  bnorm2 = dot_lfvector(fB, AdV, numverts);
   delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
 
   /* r = filter(B - A * dV) */
-  mul_bfmatrix_lfvector(AdV, lA, ldV);
+  mul_bfmatrix_lfvector(AdV, lA, rows, ldV);
   sub_lfvector_lfvector(r, lB, AdV, numverts);
   filter(r, S);
 
   /* c = filter(P^-1 * r) */
-  cp_lfvector(c, r, numverts);
+  mul_lfvector_lfvector(c, Pinv, r, numverts);
   filter(c, S);
 
   /* delta = r^T * c */
@@ -886,7 +1121,7 @@ static int cg_filtered(lfVector *ldV,
 #  endif
 
   while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
-    mul_bfmatrix_lfvector(q, lA, c);
+    mul_bfmatrix_lfvector(q, lA, rows, c);
     filter(q, S);
 
     alpha = delta_new / dot_lfvector(c, q, numverts);
@@ -896,7 +1131,7 @@ static int cg_filtered(lfVector *ldV,
     add_lfvector_lfvectorS(r, r, q, -alpha, numverts);
 
     /* s = P^-1 * r */
-    cp_lfvector(s, r, numverts);
+    mul_lfvector_lfvector(s, Pinv, r, numverts);
     delta_old = delta_new;
     delta_new = dot_lfvector(r, s, numverts);
 
@@ -918,6 +1153,7 @@ static int cg_filtered(lfVector *ldV,
   del_lfvector(c);
   del_lfvector(q);
   del_lfvector(s);
+  del_lfvector(Pinv);
   // printf("W/O conjgrad_loopcount: %d\n", conjgrad_loopcount);
 
   result->status = conjgrad_loopcount < conjgrad_looplimit ? SIM_SOLVER_SUCCESS :
@@ -1146,7 +1382,10 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 
   subadd_bfmatrixS_bfmatrixS(data->A, data->dFdV, dt, data->dFdX, (dt * dt));
 
-  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->V);
+  /* A, dFdV and dFdX share the same blocks. */
+  build_bfmatrix_rows(&data->rows, data->A, data->num_blocks);
+
+  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, &data->rows, data->V);
 
   add_lfvectorS_lfvectorS(data->B, data->F, dt, dFdXmV, (dt * dt), numverts);
 
@@ -1155,7 +1394,7 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 #  endif
 
   /* Conjugate gradient algorithm to solve Ax=b. */
-  cg_filtered(data->dV, data->A, data->B, data->z, data->S, result);
+  cg_filtered(data->dV, data->A, &data->rows, data->B, data->z, data->S, result);
 
   // cg_filtered_pre(id->dV, id->A, id->B, id->z, id->S, id->P, id->Pinv, id->bigI);
 
@@ -1918,17 +1918,73 @@ static void wm_autosave_location(char *filepath)
   BLI_join_dirfile(filepath, FILE_MAX, BKE_tempdir_base(), path);
 }
 
+/**
+ * What has been written by the last auto-save, so that the next one only has to write the parts
+ * of the file that changed. Only accessed by the auto-save job, there is never more than one.
+ */
+static MemFileWrittenState *wm_autosave_written_state = NULL;
+
+typedef struct AutosaveJob {
+  /** Copy of the undo memfile, owned by the job. */
+  MemFile *memfile;
+  char filepath[FILE_MAX];
+} AutosaveJob;
+
+static void wm_autosave_job_startjob(void *customdata,
+                                     short *UNUSED(stop),
+                                     short *UNUSED(do_update),
+                                     float *UNUSED(progress))
+{
+  AutosaveJob *job = customdata;
+  /* Not stopped early, a partially written autosave file is useless. */
+  BLO_memfile_write_file_incremental(job->memfile, job->filepath, &wm_autosave_written_state);
+}
+
+static void wm_autosave_job_free(void *customdata)
+{
+  AutosaveJob *job = customdata;
+  BLO_memfile_free(job->memfile);
+  MEM_freeN(job->memfile);
+  MEM_freeN(job);
+}
+
+/**
+ * Write the undo memfile from a job, so that the UI doesn't freeze while the file is written.
+ * Only copying the memfile happens on the main thread, the undo stack may change while the job
+ * is running.
+ */
+static void wm_autosave_write_memfile_job(wmWindowManager *wm,
+                                          const MemFile *memfile,
+                                          const char *filepath)
+{
+  AutosaveJob *job = MEM_mallocN(sizeof(AutosaveJob), __func__);
+  job->memfile = BLO_memfile_duplicate(memfile);
+  BLI_strncpy(job->filepath, filepath, sizeof(job->filepath));
+
+  wmJob *wm_job = WM_jobs_get(wm, wm->winactive, wm, "Auto Save", 0, WM_JOB_TYPE_AUTOSAVE);
+  WM_jobs_customdata_set(wm_job, job, wm_autosave_job_free);
+  /* The timer is needed to free the job when it is done. */
+  WM_jobs_timer(wm_job, 0.1, 0, 0);
+  WM_jobs_callbacks(wm_job, wm_autosave_job_startjob, NULL, NULL, NULL);
+  WM_jobs_start(wm, wm_job);
+}
+
 static void wm_autosave_write(Main *bmain, wmWindowManager *wm)
 {
   char filepath[FILE_MAX];
 
+  if (WM_jobs_test(wm, wm, WM_JOB_TYPE_AUTOSAVE)) {
+    /* The previous auto-save is still being written, skip this one. */
+    return;
+  }
+
   wm_autosave_location(filepath);
 
   /* Fast save of last undo-buffer, now with UI. */
   const bool use_memfile = (U.uiflag & USER_GLOBALUNDO) != 0;
   MemFile *memfile = use_memfile ? ED_undosys_stack_memfile_get_active(wm->undo_stack) : NULL;
   if (memfile != NULL) {
-    BLO_memfile_write_file(memfile, filepath);
+    wm_autosave_write_memfile_job(wm, memfile, filepath);
   }
   else {
     if (use_memfile) {
@@ -2001,6 +2057,9 @@ void wm_autosave_delete(void)
 {
   char filename[FILE_MAX];
 
+  BLO_memfile_written_state_free(wm_autosave_written_state);
+  wm_autosave_written_state = NULL;
+
   wm_autosave_location(filename);
 
   if (BLI_exists(filename)) {
@@ -350,7 +350,10 @@ void WM_init(bContext *C, int argc, const char **argv)
   BKE_material_copybuf_clear();
   ED_render_clear_mtex_copybuf();
 
-  wm_history_file_read();
+  /* Background mode never updates the history, it's only used for the UI. */
+  if (!G.background) {
+    wm_history_file_read();
+  }
 
   BLI_strncpy(G.lib, BKE_main_blendfile_path_from_global(), sizeof(G.lib));
 
@@ -572,6 +575,9 @@ void WM_exit_ex(bContext *C, const bool do_python)
 
   if (opengl_is_init) {
     DRW_opengl_context_enable_ex(false);
+#ifdef WITH_COMPOSITOR
+    COM_free_gpu_shaders();
+#endif
     GPU_pass_cache_free();
     GPU_exit();
     DRW_opengl_context_disable_ex(false);
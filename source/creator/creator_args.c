@@ -502,6 +502,7 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_args_print_arg_doc(ba, "--frame-jump");
   BLI_args_print_arg_doc(ba, "--render-output");
   BLI_args_print_arg_doc(ba, "--engine");
+  BLI_args_print_arg_doc(ba, "--persistent-data");
   BLI_args_print_arg_doc(ba, "--threads");
 
   printf("\n");
@@ -578,6 +579,7 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_args_print_arg_doc(ba, "--debug-ghost");
   BLI_args_print_arg_doc(ba, "--debug-gpu");
   BLI_args_print_arg_doc(ba, "--debug-gpu-force-workarounds");
+  BLI_args_print_arg_doc(ba, "--debug-draw-trace");
   BLI_args_print_arg_doc(ba, "--debug-wm");
 #  ifdef WITH_XR_OPENXR
   BLI_args_print_arg_doc(ba, "--debug-xr");
@@ -980,6 +982,9 @@ static const char arg_handle_debug_mode_generic_set_doc_depsgraph_pretty[] =
 static const char arg_handle_debug_mode_generic_set_doc_depsgraph_uuid[] =
     "\n\t"
     "Verify validness of session-wide identifiers assigned to ID datablocks.";
+static const char arg_handle_debug_mode_generic_set_doc_draw_trace[] =
+    "\n\t"
+    "Write the timings of every drawn viewport frame to a trace file in the temporary directory.";
 static const char arg_handle_debug_mode_generic_set_doc_gpu_force_workarounds[] =
     "\n\t"
     "Enable workarounds for typical GPU issues and disable all GPU extensions.";
@@ -1550,6 +1555,39 @@ static int arg_handle_extension_set(int argc, const char **argv, void *data)
   return 0;
 }
 
+static const char arg_handle_persistent_data_set_doc[] =
+    "<bool>\n"
+    "\tSet option to keep render data between frames, to avoid syncing the whole scene for\n"
+    "\tevery frame when rendering multiple frames in one process with '-f' or '-a'.";
+static int arg_handle_persistent_data_set(int argc, const char **argv, void *data)
+{
+  bContext *C = data;
+  if (argc > 1) {
+    Scene *scene = CTX_data_scene(C);
+    if (scene) {
+      if (argv[1][0] == '0') {
+        scene->r.mode &= ~R_PERSISTENT_DATA;
+        DEG_id_tag_update(&scene->id, ID_RECALC_COPY_ON_WRITE);
+      }
+      else if (argv[1][0] == '1') {
+        scene->r.mode |= R_PERSISTENT_DATA;
+        DEG_id_tag_update(&scene->id, ID_RECALC_COPY_ON_WRITE);
+      }
+      else {
+        printf("\nError: Use '--persistent-data 1 / --persistent-data 0'.\n");
+      }
+    }
+    else {
+      printf(
+          "\nError: no blend loaded. "
+          "order the arguments so '--persistent-data' is after the blend is loaded.\n");
+    }
+    return 1;
+  }
+  printf("\nError: you must specify a value after '--persistent-data'.\n");
+  return 0;
+}
+
 static const char arg_handle_render_frame_doc[] =
     "<frame>\n"
     "\tRender frame <frame> and save it.\n"
@@ -2200,6 +2238,11 @@ void main_args_setup(bContext *C, bArgs *ba)
                "--debug-gpu-force-workarounds",
                CB_EX(arg_handle_debug_mode_generic_set, gpu_force_workarounds),
                (void *)G_DEBUG_GPU_FORCE_WORKAROUNDS);
+  BLI_args_add(ba,
+               NULL,
+               "--debug-draw-trace",
+               CB_EX(arg_handle_debug_mode_generic_set, draw_trace),
+               (void *)G_DEBUG_DRAW_TRACE);
   BLI_args_add(ba, NULL, "--debug-exit-on-error", CB(arg_handle_debug_exit_on_error), NULL);
 
   BLI_args_add(ba, NULL, "--verbose", CB(arg_handle_verbosity_set), NULL);
@@ -2242,6 +2285,7 @@ void main_args_setup(bContext *C, bArgs *ba)
 
   BLI_args_add(ba, "-o", "--render-output", CB(arg_handle_output_set), C);
   BLI_args_add(ba, "-E", "--engine", CB(arg_handle_engine_set), C);
+  BLI_args_add(ba, NULL, "--persistent-data", CB(arg_handle_persistent_data_set), C);
 
   BLI_args_add(ba, "-F", "--render-format", CB(arg_handle_image_type_set), C);
   BLI_args_add(ba, "-x", "--use-extension", CB(arg_handle_extension_set), C);
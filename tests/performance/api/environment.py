@@ -241,6 +241,9 @@ class TestEnvironment:
                       f'result = {modulename}.{functionname}(args)\n'
                       f'result = base64.b64encode(pickle.dumps(result))\n'
                       f'print("{output_prefix}" + result.decode())\n')
+        if foreground:
+            # Scripts don't end the session when the window is open.
+            expression += 'import bpy\nbpy.ops.wm.quit_blender()\n'
 
         expr_args = blender_args + ['--python-expr', expression]
         lines = self.call_blender(expr_args, foreground=foreground)
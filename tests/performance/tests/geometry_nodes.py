@@ -0,0 +1,195 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+# Geometry nodes trees are built from Python, so that the same trees can be evaluated by every
+# Blender version that supports their nodes, without depending on benchmark files.
+
+
+def _link(tree, from_node, from_socket, to_node, to_socket):
+    tree.links.new(from_node.outputs[from_socket], to_node.inputs[to_socket])
+
+
+def _new_tree(name):
+    import bpy
+
+    tree = bpy.data.node_groups.new(name, 'GeometryNodeTree')
+    tree.inputs.new('NodeSocketGeometry', "Geometry")
+    tree.outputs.new('NodeSocketGeometry', "Geometry")
+    tree.nodes.new('NodeGroupInput')
+    output = tree.nodes.new('NodeGroupOutput')
+    return tree, output
+
+
+def _new_grid(tree, vertices):
+    grid = tree.nodes.new('GeometryNodeMeshGrid')
+    grid.inputs["Size X"].default_value = 10.0
+    grid.inputs["Size Y"].default_value = 10.0
+    grid.inputs["Vertices X"].default_value = vertices
+    grid.inputs["Vertices Y"].default_value = vertices
+    return grid
+
+
+def _build_scatter(scale):
+    # Scatter instances on a surface and realize them.
+    tree, output = _new_tree("Scatter")
+    grid = _new_grid(tree, 100)
+    distribute = tree.nodes.new('GeometryNodeDistributePointsOnFaces')
+    distribute.inputs["Density"].default_value = 100.0 * scale
+    sphere = tree.nodes.new('GeometryNodeMeshIcoSphere')
+    sphere.inputs["Radius"].default_value = 0.01
+    sphere.inputs["Subdivisions"].default_value = 2
+    instance = tree.nodes.new('GeometryNodeInstanceOnPoints')
+    realize = tree.nodes.new('GeometryNodeRealizeInstances')
+    _link(tree, grid, "Mesh", distribute, "Mesh")
+    _link(tree, distribute, "Points", instance, "Points")
+    _link(tree, sphere, "Mesh", instance, "Instance")
+    _link(tree, instance, "Instances", realize, "Geometry")
+    _link(tree, realize, "Geometry", output, "Geometry")
+    return tree
+
+
+def _build_procedural_modeling(scale):
+    # Displace a grid with noise, extrude its faces and subdivide the result.
+    tree, output = _new_tree("Procedural Modeling")
+    grid = _new_grid(tree, int(100 * scale ** 0.5))
+    position = tree.nodes.new('GeometryNodeInputPosition')
+    noise = tree.nodes.new('ShaderNodeTexNoise')
+    set_position = tree.nodes.new('GeometryNodeSetPosition')
+    extrude = tree.nodes.new('GeometryNodeExtrudeMesh')
+    subdivide = tree.nodes.new('GeometryNodeSubdivideMesh')
+    subdivide.inputs["Level"].default_value = 2
+    _link(tree, position, "Position", noise, "Vector")
+    _link(tree, grid, "Mesh", set_position, "Geometry")
+    _link(tree, noise, "Color", set_position, "Offset")
+    _link(tree, set_position, "Geometry", extrude, "Mesh")
+    _link(tree, extrude, "Mesh", subdivide, "Mesh")
+    _link(tree, subdivide, "Mesh", output, "Geometry")
+    return tree
+
+
+def _build_curves(scale):
+    # Instance curves on points, resample them and sweep a profile along them.
+    tree, output = _new_tree("Curves")
+    grid = _new_grid(tree, int(30 * scale ** 0.5))
+    circle = tree.nodes.new('GeometryNodeCurvePrimitiveCircle')
+    circle.inputs["Radius"].default_value = 0.1
+    instance = tree.nodes.new('GeometryNodeInstanceOnPoints')
+    realize = tree.nodes.new('GeometryNodeRealizeInstances')
+    resample = tree.nodes.new('GeometryNodeResampleCurve')
+    resample.inputs["Count"].default_value = 64
+    profile = tree.nodes.new('GeometryNodeCurvePrimitiveCircle')
+    profile.inputs["Radius"].default_value = 0.01
+    profile.inputs["Resolution"].default_value = 8
+    curve_to_mesh = tree.nodes.new('GeometryNodeCurveToMesh')
+    _link(tree, grid, "Mesh", instance, "Points")
+    _link(tree, circle, "Curve", instance, "Instance")
+    _link(tree, instance, "Instances", realize, "Geometry")
+    _link(tree, realize, "Geometry", resample, "Curve")
+    _link(tree, resample, "Curve", curve_to_mesh, "Curve")
+    _link(tree, profile, "Curve", curve_to_mesh, "Profile Curve")
+    _link(tree, curve_to_mesh, "Mesh", output, "Geometry")
+    return tree
+
+
+def _build_attribute_math(scale):
+    # Chain of field math on the positions of a dense grid.
+    tree, output = _new_tree("Attribute Math")
+    grid = _new_grid(tree, int(300 * scale ** 0.5))
+    position = tree.nodes.new('GeometryNodeInputPosition')
+    set_position = tree.nodes.new('GeometryNodeSetPosition')
+    socket = position.outputs["Position"]
+    for operation in ('SINE', 'MULTIPLY', 'ADD', 'FRACTION', 'NORMALIZE', 'SCALE'):
+        math = tree.nodes.new('ShaderNodeVectorMath')
+        math.operation = operation
+        tree.links.new(socket, math.inputs[0])
+        tree.links.new(position.outputs["Position"], math.inputs[1])
+        math.inputs[3].default_value = 0.5
+        socket = math.outputs["Vector"]
+    length = tree.nodes.new('ShaderNodeVectorMath')
+    length.operation = 'LENGTH'
+    tree.links.new(socket, length.inputs[0])
+    power = tree.nodes.new('ShaderNodeMath')
+    power.operation = 'POWER'
+    tree.links.new(length.outputs["Value"], power.inputs[0])
+    power.inputs[1].default_value = 1.5
+    offset = tree.nodes.new('ShaderNodeVectorMath')
+    offset.operation = 'SCALE'
+    tree.links.new(socket, offset.inputs[0])
+    tree.links.new(power.outputs["Value"], offset.inputs[3])
+    _link(tree, grid, "Mesh", set_position, "Geometry")
+    tree.links.new(offset.outputs["Vector"], set_position.inputs["Offset"])
+    _link(tree, set_position, "Geometry", output, "Geometry")
+    return tree
+
+
+TREES = {
+    'scatter': _build_scatter,
+    'procedural_modeling': _build_procedural_modeling,
+    'curves': _build_curves,
+    'attribute_math': _build_attribute_math,
+}
+
+SCALES = {
+    'small': 1.0,
+    'large': 16.0,
+}
+
+
+def _run(args):
+    import bpy
+    import time
+
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+    scene = bpy.context.scene
+
+    tree = TREES[args['tree']](args['scale'])
+    mesh = bpy.data.meshes.new("Mesh")
+    ob = bpy.data.objects.new("Object", mesh)
+    scene.collection.objects.link(ob)
+    modifier = ob.modifiers.new("Nodes", 'NODES')
+    modifier.node_group = tree
+
+    # Evaluate once to build the depsgraph and warm up caches.
+    bpy.context.evaluated_depsgraph_get()
+
+    start_time = time.time()
+    elapsed_time = 0.0
+    num_runs = 0
+    while elapsed_time < 5.0 or num_runs < 3:
+        ob.update_tag()
+        bpy.context.evaluated_depsgraph_get()
+        num_runs += 1
+        elapsed_time = time.time() - start_time
+
+    result = {'time': elapsed_time / num_runs}
+    return result
+
+
+class GeometryNodesTest(api.Test):
+    def __init__(self, tree, scale):
+        self.tree = tree
+        self.scale = scale
+
+    def name(self):
+        return f"{self.tree}_{self.scale}"
+
+    def category(self):
+        return "geometry_nodes"
+
+    def run(self, env, device_id):
+        args = {'tree': self.tree, 'scale': SCALES[self.scale]}
+        result, _ = env.run_in_blender(_run, args)
+        if not result:
+            return result
+
+        # Evaluate again on a single thread, to track how well the evaluation scales.
+        result_single, _ = env.run_in_blender(_run, args, ['--threads', '1'])
+        if result_single:
+            result['time_single_thread'] = result_single['time']
+            result['thread_scaling'] = result_single['time'] / result['time']
+        return result
+
+
+def generate(env):
+    return [GeometryNodesTest(tree, scale) for tree in TREES.keys() for scale in SCALES.keys()]
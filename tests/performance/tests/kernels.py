@@ -0,0 +1,145 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+# Tests for low level kernels on generated data, so that they do not depend on benchmark files
+# and regressions in them are not hidden by the rest of a scene. The random number generators
+# are seeded to make the datasets the same for every run.
+
+
+def _random_points(num_points, seed):
+    import random
+    from mathutils import Vector
+
+    rng = random.Random(seed)
+    return [Vector((rng.random(), rng.random(), rng.random())) for _ in range(num_points)]
+
+
+def _grid_mesh(name, subdivisions, size, offset):
+    import bmesh
+    import bpy
+
+    bm = bmesh.new()
+    bmesh.ops.create_grid(bm, x_segments=subdivisions, y_segments=subdivisions, size=size)
+    bmesh.ops.translate(bm, vec=offset, verts=bm.verts)
+    mesh = bpy.data.meshes.new(name)
+    bm.to_mesh(mesh)
+    bm.free()
+    return mesh
+
+
+def _sphere_object(name, subdivisions, offset):
+    import bmesh
+    import bpy
+
+    bm = bmesh.new()
+    bmesh.ops.create_icosphere(bm, subdivisions=subdivisions, radius=1.0)
+    bmesh.ops.translate(bm, vec=offset, verts=bm.verts)
+    mesh = bpy.data.meshes.new(name)
+    bm.to_mesh(mesh)
+    bm.free()
+    ob = bpy.data.objects.new(name, mesh)
+    bpy.context.scene.collection.objects.link(ob)
+    return ob
+
+
+def _kdtree_setup():
+    return {'points': _random_points(200000, 0), 'queries': _random_points(20000, 1)}
+
+
+def _kdtree_run(data):
+    from mathutils.kdtree import KDTree
+
+    points = data['points']
+    kd = KDTree(len(points))
+    for i, co in enumerate(points):
+        kd.insert(co, i)
+    kd.balance()
+    for co in data['queries']:
+        kd.find_n(co, 8)
+
+
+def _bvhtree_overlap_setup():
+    from mathutils.bvhtree import BVHTree
+
+    mesh_a = _grid_mesh("A", 400, 1.0, (0.0, 0.0, 0.0))
+    mesh_b = _grid_mesh("B", 400, 1.0, (0.001, 0.001, 0.0))
+    return {
+        'trees': [BVHTree.FromPolygons([v.co for v in mesh.vertices],
+                                       [p.vertices for p in mesh.polygons])
+                  for mesh in (mesh_a, mesh_b)]
+    }
+
+
+def _bvhtree_overlap_run(data):
+    tree_a, tree_b = data['trees']
+    tree_a.overlap(tree_b)
+
+
+def _mesh_boolean_setup():
+    ob_a = _sphere_object("A", 5, (0.0, 0.0, 0.0))
+    ob_b = _sphere_object("B", 5, (0.5, 0.25, 0.125))
+    modifier = ob_a.modifiers.new("Boolean", 'BOOLEAN')
+    modifier.solver = 'EXACT'
+    modifier.object = ob_b
+    return {'object': ob_a}
+
+
+def _mesh_boolean_run(data):
+    import bpy
+
+    ob = data['object']
+    ob.data.update()
+    depsgraph = bpy.context.evaluated_depsgraph_get()
+    ob.evaluated_get(depsgraph)
+
+
+KERNELS = {
+    'kdtree_find_n': (_kdtree_setup, _kdtree_run),
+    'bvhtree_overlap': (_bvhtree_overlap_setup, _bvhtree_overlap_run),
+    'mesh_boolean_exact': (_mesh_boolean_setup, _mesh_boolean_run),
+}
+
+
+def _run(args):
+    import bpy
+    import time
+
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+
+    setup_fn, run_fn = KERNELS[args['kernel']]
+    data = setup_fn()
+
+    # Run once to warm up caches, then as often as fits in the time budget.
+    run_fn(data)
+
+    start_time = time.time()
+    elapsed_time = 0.0
+    num_runs = 0
+    while elapsed_time < 5.0 or num_runs < 3:
+        run_fn(data)
+        num_runs += 1
+        elapsed_time = time.time() - start_time
+
+    result = {'time': elapsed_time / num_runs}
+    return result
+
+
+class KernelTest(api.Test):
+    def __init__(self, kernel):
+        self.kernel = kernel
+
+    def name(self):
+        return self.kernel
+
+    def category(self):
+        return "kernels"
+
+    def run(self, env, device_id):
+        args = {'kernel': self.kernel}
+        result, _ = env.run_in_blender(_run, args)
+        return result
+
+
+def generate(env):
+    return [KernelTest(kernel) for kernel in KERNELS.keys()]
@@ -0,0 +1,130 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+import os
+
+
+# Viewport configurations to benchmark: shading type, render engine and overlays.
+CONFIGS = {
+    'eevee': ('RENDERED', 'BLENDER_EEVEE', False),
+    'workbench': ('SOLID', 'BLENDER_WORKBENCH', False),
+    'overlays': ('SOLID', 'BLENDER_WORKBENCH', True),
+}
+
+
+def _run(args):
+    import bpy
+    import gpu
+    import json
+    import os
+    import time
+
+    shading_type, engine, show_overlays = args['config']
+    num_frames = args['num_frames']
+
+    # Find a 3D viewport to draw offscreen.
+    space = region = None
+    for area in bpy.context.screen.areas:
+        if area.type == 'VIEW_3D':
+            space = area.spaces.active
+            region = next(region for region in area.regions if region.type == 'WINDOW')
+            break
+    if space is None:
+        raise Exception("No 3D viewport found in the file")
+
+    scene = bpy.context.scene
+    view_layer = bpy.context.view_layer
+    scene.render.engine = engine
+    space.shading.type = shading_type
+    space.overlay.show_overlays = show_overlays
+
+    rv3d = space.region_3d
+    width = region.width
+    height = region.height
+    offscreen = gpu.types.GPUOffScreen(width, height)
+
+    def draw():
+        offscreen.draw_view3d(scene,
+                              view_layer,
+                              space,
+                              region,
+                              rv3d.view_matrix,
+                              rv3d.window_matrix,
+                              do_color_management=True)
+        # Reading back waits for the GPU to be done with the frame.
+        with offscreen.bind():
+            fb = gpu.state.active_framebuffer_get()
+            fb.read_color(0, 0, 1, 1, 4, 0, 'UBYTE')
+
+    # Warm up caches and shaders.
+    frame_start = scene.frame_start
+    frame_end = min(scene.frame_end, frame_start + num_frames - 1)
+    scene.frame_set(frame_start)
+    draw()
+    draw()
+
+    depsgraph_times = []
+    draw_times = []
+    for frame in range(frame_start, frame_end + 1):
+        start_time = time.perf_counter()
+        scene.frame_set(frame)
+        depsgraph_time = time.perf_counter()
+        draw()
+        end_time = time.perf_counter()
+
+        depsgraph_times.append(depsgraph_time - start_time)
+        draw_times.append(end_time - depsgraph_time)
+
+    offscreen.free()
+
+    # Every offscreen draw appends one frame to the draw trace, see `--debug-draw-trace`.
+    tempdir_base = os.path.dirname(os.path.normpath(bpy.app.tempdir))
+    trace_filepath = os.path.join(tempdir_base, 'blender_draw_trace.jsonl')
+    with open(trace_filepath) as f:
+        frames = [json.loads(line) for line in f][-len(draw_times):]
+
+    extraction_times = []
+    populate_times = []
+    for trace in frames:
+        batch_cache_ms = sum(batch_cache['ms'] for batch_cache in trace['batch_cache'])
+        extraction_times.append((batch_cache_ms + trace['batch_cache_wait_ms']) / 1000.0)
+        populate_times.append(sum(engine['cache_populate_ms']
+                                  for engine in trace['engines']) / 1000.0)
+
+    num_frames = len(draw_times)
+    result = {
+        'time': (sum(depsgraph_times) + sum(draw_times)) / num_frames,
+        'depsgraph_time': sum(depsgraph_times) / num_frames,
+        'draw_time': sum(draw_times) / num_frames,
+        'extraction_time': sum(extraction_times) / num_frames,
+        'populate_time': sum(populate_times) / num_frames,
+    }
+    return result
+
+
+class ViewportTest(api.Test):
+    def __init__(self, filepath, config_name):
+        self.filepath = filepath
+        self.config_name = config_name
+
+    def name(self):
+        return f'{self.filepath.stem}_{self.config_name}'
+
+    def category(self):
+        return "viewport"
+
+    def run(self, env, device_id):
+        args = {'config': CONFIGS[self.config_name], 'num_frames': 50}
+        # Drawing requires a window and GPU context.
+        result, _ = env.run_in_blender(_run,
+                                       args,
+                                       ['--debug-draw-trace', self.filepath],
+                                       foreground=True)
+        return result
+
+
+def generate(env):
+    filepaths = env.find_blend_files('viewport/*')
+    return [ViewportTest(filepath, config_name)
+            for filepath in filepaths
+            for config_name in CONFIGS]
@@ -195,6 +195,37 @@ class TestPropArrayMultiDimensional(unittest.TestCase):
         del id_type.temp
 
 
+class TestPropCollectionView(unittest.TestCase):
+    def setUp(self):
+        self.mesh = bpy.data.meshes.new("TestPropCollectionView")
+        self.mesh.vertices.add(4)
+
+    def tearDown(self):
+        bpy.data.meshes.remove(self.mesh)
+
+    def test_foreach_view_strided(self):
+        co = np.asarray(self.mesh.vertices.foreach_view("co"))
+        self.assertEqual(co.shape, (4, 3))
+        self.assertEqual(co.dtype, np.float32)
+
+        co[:] = np.arange(12, dtype=np.float32).reshape(4, 3)
+        result = np.zeros(12, dtype=np.float32)
+        self.mesh.vertices.foreach_get("co", result)
+        self.assertEqual(tuple(result), tuple(range(12)))
+
+    def test_foreach_view_attribute(self):
+        attribute = self.mesh.attributes.new("test", 'FLOAT', 'POINT')
+        values = np.asarray(attribute.data.foreach_view("value"))
+        self.assertEqual(values.shape, (4,))
+
+        values[:] = (1.0, 2.0, 3.0, 4.0)
+        self.assertEqual(tuple(item.value for item in attribute.data), (1.0, 2.0, 3.0, 4.0))
+
+    def test_foreach_view_invalid(self):
+        with self.assertRaises(AttributeError):
+            self.mesh.vertices.foreach_view("does_not_exist")
+
+
 if __name__ == '__main__':
     import sys
     sys.argv = [__file__] + (sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else [])